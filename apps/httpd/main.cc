@@ -25,6 +25,9 @@
 #include <seastar/http/file_handler.hh>
 #include <seastar/core/seastar.hh>
 #include <seastar/core/reactor.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/memory.hh>
+#include <boost/range/irange.hpp>
 #include "demo.json.hh"
 #include <seastar/http/api_docs.hh>
 #include <seastar/core/thread.hh>
@@ -48,6 +51,29 @@ public:
     }
 };
 
+// Serves the sampled allocation profile of all shards in collapsed-stack
+// format, ready to be fed to flamegraph.pl. See
+// memory::set_sampled_memory_profiling_rate().
+class memory_profile_handl : public httpd::handler_base {
+public:
+    virtual future<std::unique_ptr<reply> > handle(const sstring& path,
+            std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+        return do_with(std::move(rep), sstring(), [] (std::unique_ptr<reply>& rep, sstring& profile) {
+            return do_for_each(boost::irange(0u, smp::count), [&profile] (unsigned shard) {
+                return smp::submit_to(shard, [] {
+                    return memory::sampled_memory_profile();
+                }).then([&profile] (sstring shard_profile) {
+                    profile += shard_profile;
+                });
+            }).then([&rep, &profile] {
+                rep->_content = std::move(profile);
+                rep->done("txt");
+                return std::move(rep);
+            });
+        });
+    }
+};
+
 void set_routes(routes& r) {
     function_handler* h1 = new function_handler([](const_req req) {
         return "hello";
@@ -59,6 +85,7 @@ void set_routes(routes& r) {
     r.add(operation_type::GET, url("/jf"), h2);
     r.add(operation_type::GET, url("/file").remainder("path"),
             new directory_handler("/"));
+    r.add(operation_type::GET, url("/memory_profile"), new memory_profile_handl());
     demo_json::hello_world.set(r, [] (const_req req) {
         demo_json::my_object obj;
         obj.var1 = req.param.at("var1");
@@ -105,6 +132,11 @@ int main(int ac, char** av) {
                 }).get();
             }
 
+            // cheap enough to leave on; exported on /memory_profile
+            smp::invoke_on_all([] {
+                memory::set_sampled_memory_profiling_rate(1 << 20);
+            }).get();
+
             uint16_t port = config["port"].as<uint16_t>();
             auto server = new http_server_control();
             auto rb = make_shared<api_registry_builder>("apps/httpd/");
@@ -28,6 +28,7 @@
 #include <seastar/core/align.hh>
 #include <seastar/core/timer.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/print.hh>
 #include <seastar/core/loop.hh>
 #include <seastar/core/with_scheduling_group.hh>
@@ -35,29 +36,23 @@
 #include <vector>
 #include <boost/range/irange.hpp>
 #include <boost/algorithm/string.hpp>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/max.hpp>
-#include <boost/accumulators/statistics/mean.hpp>
-#include <boost/accumulators/statistics/p_square_quantile.hpp>
-#include <boost/accumulators/statistics/extended_p_square.hpp>
-#include <boost/accumulators/statistics/extended_p_square_quantile.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <boost/array.hpp>
 #include <iomanip>
 #include <random>
 #include <yaml-cpp/yaml.h>
+#include "../lib/latency_histogram.hh"
 
 using namespace seastar;
 using namespace std::chrono_literals;
-using namespace boost::accumulators;
 
 static auto random_seed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 static std::default_random_engine random_generator(random_seed);
 
 class context;
 enum class request_type { seqread, seqwrite, randread, randwrite, append, cpu };
+enum class arrival_distribution { uniform, poisson };
 
 namespace std {
 
@@ -92,6 +87,12 @@ public:
 
 struct shard_info {
     unsigned parallelism = 10;
+    // requests per second per shard. When non-zero the job runs open-loop:
+    // requests are issued at their scheduled arrival times regardless of
+    // completions, so queueing delay shows up in the measured latency
+    // instead of throttling the load (avoiding coordinated omission).
+    unsigned rps = 0;
+    arrival_distribution arrival = arrival_distribution::uniform;
     unsigned shares = 10;
     uint64_t request_size = 4 << 10;
     std::chrono::duration<float> think_time = 0ms;
@@ -116,16 +117,20 @@ struct job_config {
     // of the disk's cache
     uint64_t file_size;
     uint64_t offset_in_bdev;
+    // requests issued while warming up or draining are not accounted, so the
+    // results cover only the steady-state window between the two
+    std::chrono::duration<float> warmup = 0s;
+    std::chrono::duration<float> drain = 0s;
     std::unique_ptr<class_data> gen_class_data();
 };
 
 std::array<double, 4> quantiles = { 0.5, 0.95, 0.99, 0.999};
 static bool keep_files = false;
 
+using seastar_apps_lib::latency_histogram;
+
 class class_data {
 protected:
-    using accumulator_type = accumulator_set<double, stats<tag::extended_p_square_quantile(quadratic), tag::mean, tag::max>>;
-
     job_config _config;
     uint64_t _alignment;
     uint64_t _last_pos = 0;
@@ -138,7 +143,11 @@ protected:
     std::chrono::duration<float> _total_duration;
 
     std::chrono::steady_clock::time_point _start = {};
-    accumulator_type _latencies;
+    std::chrono::steady_clock::time_point _measure_start = {};
+    std::chrono::steady_clock::time_point _measure_stop = {};
+    std::chrono::steady_clock::time_point _next_arrival = {};
+    latency_histogram _latencies;
+    std::exponential_distribution<double> _interarrival{1.0};
     uint64_t _requests = 0;
     std::uniform_int_distribution<uint32_t> _pos_distribution;
     file _file;
@@ -152,34 +161,85 @@ public:
         , _alignment(_config.shard_info.request_size >= 4096 ? 4096 : 512)
         , _iop(engine().register_one_priority_class(format("test-class-{:d}", idgen()), _config.shard_info.shares))
         , _sg(cfg.shard_info.scheduling_group)
-        , _latencies(extended_p_square_probabilities = quantiles)
         , _pos_distribution(0,  _config.file_size / _config.shard_info.request_size)
     {}
 
     virtual ~class_data() = default;
 
-    future<> issue_requests(std::chrono::steady_clock::time_point stop) {
+    future<> issue_requests(std::chrono::seconds duration) {
         _start = std::chrono::steady_clock::now();
+        _measure_start = _start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(_config.warmup);
+        _measure_stop = _measure_start + duration;
+        auto stop = _measure_stop + std::chrono::duration_cast<std::chrono::steady_clock::duration>(_config.drain);
+        auto issue = rps() != 0 ? &class_data::issue_requests_open_loop : &class_data::issue_requests_closed_loop;
+        return (this->*issue)(stop).then([this] {
+            _total_duration = _measure_stop - _measure_start;
+        });
+    }
+
+private:
+    future<> issue_requests_closed_loop(std::chrono::steady_clock::time_point stop) {
         return with_scheduling_group(_sg, [this, stop] {
             return parallel_for_each(boost::irange(0u, parallelism()), [this, stop] (auto dummy) mutable {
                 auto bufptr = allocate_aligned_buffer<char>(this->req_size(), _alignment);
                 auto buf = bufptr.get();
-                return do_until([stop] { return std::chrono::steady_clock::now() > stop; }, [this, buf, stop] () mutable {
+                return do_until([stop] { return std::chrono::steady_clock::now() > stop; }, [this, buf] () mutable {
                     auto start = std::chrono::steady_clock::now();
-                    return issue_request(buf).then([this, start, stop] (auto size) {
+                    return issue_request(buf).then([this, start] (auto size) {
                         auto now = std::chrono::steady_clock::now();
-                        if (now < stop) {
+                        if (start >= _measure_start && now < _measure_stop) {
                             this->add_result(size, std::chrono::duration_cast<std::chrono::microseconds>(now - start));
                         }
                         return think();
                     });
                 }).finally([bufptr = std::move(bufptr)] {});
             });
-        }).then([this] {
-            _total_duration = std::chrono::steady_clock::now() - _start;
         });
     }
 
+    std::chrono::steady_clock::duration next_interarrival() {
+        auto mean = 1000000.0 / rps();
+        auto us = _config.shard_info.arrival == arrival_distribution::poisson ? _interarrival(random_generator) * mean : mean;
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::micro>(us));
+    }
+
+    // Issues requests at their scheduled arrival times, without waiting for
+    // the previous ones to complete, and measures latency from the scheduled
+    // time -- a request that sat in a queue behind a slow one is charged for
+    // the wait.
+    future<> issue_requests_open_loop(std::chrono::steady_clock::time_point stop) {
+        _next_arrival = _start;
+        return with_scheduling_group(_sg, [this, stop] {
+            return do_with(gate(), [this, stop] (gate& g) {
+                return do_until([this, stop] { return _next_arrival > stop; }, [this, &g] () mutable {
+                    auto sched = _next_arrival;
+                    _next_arrival += next_interarrival();
+                    auto now = std::chrono::steady_clock::now();
+                    auto f = sched > now ? seastar::sleep(std::chrono::duration_cast<std::chrono::microseconds>(sched - now)) : make_ready_future<>();
+                    return f.then([this, &g, sched] {
+                        auto bufptr = allocate_aligned_buffer<char>(this->req_size(), _alignment);
+                        auto buf = bufptr.get();
+                        // do not wait for the completion: the arrival process
+                        // must not be slowed down by the service process
+                        (void)with_gate(g, [this, buf, sched] {
+                            return issue_request(buf).then([this, sched] (auto size) {
+                                auto now = std::chrono::steady_clock::now();
+                                if (sched >= _measure_start && now < _measure_stop) {
+                                    this->add_result(size, std::chrono::duration_cast<std::chrono::microseconds>(now - sched));
+                                }
+                            });
+                        }).finally([bufptr = std::move(bufptr)] {});
+                        return make_ready_future<>();
+                    });
+                }).then([&g] {
+                    return g.close();
+                });
+            });
+        });
+    }
+
+public:
+
     future<> think() {
         if (_config.shard_info.think_time > 0us) {
             return seastar::sleep(std::chrono::duration_cast<std::chrono::microseconds>(_config.shard_info.think_time));
@@ -244,6 +304,10 @@ protected:
         return _config.shard_info.parallelism;
     }
 
+    unsigned rps() const {
+        return _config.shard_info.rps;
+    }
+
     unsigned shares() const {
         return _config.shard_info.shares;
     }
@@ -261,15 +325,15 @@ protected:
     }
 
     uint64_t max_latency() const {
-        return max(_latencies);
+        return _latencies.max();
     }
 
     uint64_t average_latency() const {
-        return mean(_latencies);
+        return _latencies.mean();
     }
 
     uint64_t quantile_latency(double q) const {
-        return quantile(_latencies, quantile_probability = q);
+        return _latencies.quantile(q);
     }
 
     uint64_t requests() const noexcept {
@@ -299,7 +363,7 @@ protected:
 
     void add_result(size_t data, std::chrono::microseconds latency) {
         _data += data;
-        _latencies(latency.count());
+        _latencies.record(latency.count());
         _requests++;
     }
 
@@ -540,12 +604,34 @@ struct convert<request_type> {
     }
 };
 
+template<>
+struct convert<arrival_distribution> {
+    static bool decode(const Node& node, arrival_distribution& ad) {
+        static std::unordered_map<std::string, arrival_distribution> mappings = {
+            { "uniform", arrival_distribution::uniform },
+            { "poisson", arrival_distribution::poisson },
+        };
+        auto str = node.as<std::string>();
+        if (!mappings.count(str)) {
+            return false;
+        }
+        ad = mappings[str];
+        return true;
+    }
+};
+
 template<>
 struct convert<shard_info> {
     static bool decode(const Node& node, shard_info& sl) {
         if (node["parallelism"]) {
             sl.parallelism = node["parallelism"].as<unsigned>();
         }
+        if (node["rps"]) {
+            sl.rps = node["rps"].as<unsigned>();
+        }
+        if (node["arrival"]) {
+            sl.arrival = node["arrival"].as<arrival_distribution>();
+        }
         if (node["shares"]) {
             sl.shares = node["shares"].as<unsigned>();
         }
@@ -589,6 +675,12 @@ struct convert<job_config> {
         if (node["shard_info"]) {
             cl.shard_info = node["shard_info"].as<shard_info>();
         }
+        if (node["warmup"]) {
+            cl.warmup = node["warmup"].as<duration_time>().time;
+        }
+        if (node["drain"]) {
+            cl.drain = node["drain"].as<duration_time>().time;
+        }
         if (node["options"]) {
             cl.options = node["options"].as<options>();
         }
@@ -633,7 +725,7 @@ public:
 
     future<> issue_requests() {
         return parallel_for_each(_cl.begin(), _cl.end(), [this] (std::unique_ptr<class_data>& cl) {
-            return cl->issue_requests(std::chrono::steady_clock::now() + _duration).finally([this] {
+            return cl->issue_requests(_duration).finally([this] {
                 _finished.signal(1);
             });
         });
@@ -209,6 +209,11 @@ struct row_stats {
     float stdev_percents() const {
         return points > 0 ? stdev * 100.0 / average : 0.0;
     }
+
+    // half-width of the 95% confidence interval around the average, in percents
+    float confidence_percents() const {
+        return (points > 1 && average > 0) ? 1.96 * stdev / std::sqrt(points) * 100.0 / average : 0.0;
+    }
 };
 
 template <typename T>
@@ -527,20 +532,16 @@ public:
        });
     }
 
-    future<row_stats> get_serial_rates() {
-        row_stats ret = get_row_stats_for<unsigned>(serial_rates);
-        serial_rates.clear();
-        return make_ready_future<row_stats>(ret);
+    future<std::vector<unsigned>> take_serial_rates() {
+        return make_ready_future<std::vector<unsigned>>(std::exchange(serial_rates, {}));
     }
 
-    future<row_stats> get_sharded_worst_rates() {
+    future<std::vector<unsigned>> take_sharded_worst_rates() {
         return sharded_rates.map_reduce0([] (std::vector<unsigned>& rates) {
-            row_stats ret = get_row_stats_for<unsigned>(rates);
-            rates.clear();
-            return ret;
-        }, row_stats{0, 0.0, 0.0},
-        [] (const row_stats& res, row_stats lres) {
-            return res.stdev < lres.stdev ? lres : res;
+            return std::exchange(rates, {});
+        }, std::vector<unsigned>(),
+        [] (std::vector<unsigned> res, std::vector<unsigned> lres) {
+            return get_row_stats_for(res).stdev < get_row_stats_for(lres).stdev ? std::move(lres) : std::move(res);
         });
     }
 
@@ -626,6 +627,89 @@ void write_property_file(sstring conf_file, std::vector<disk_descriptor> disk_de
     string_to_file(conf_file, sstring(out.c_str(), out.size()));
 }
 
+// One evaluated disk property: the fitted value (bytes/s or IOPS, depending
+// on the property) together with the raw per-second measurement points it was
+// derived from, so a later run can judge how trustworthy the value still is.
+struct measured_property {
+    double value = 0;
+    std::vector<unsigned> rates;
+
+    row_stats stats() const {
+        return get_row_stats_for(rates);
+    }
+};
+
+// On-disk cache of raw measurement points, keyed by mountpoint and property
+// name. With a cache present a full sweep is only needed for properties whose
+// quick confirmation pass disagrees with the stored points; everything else
+// is reused, which turns a multi-minute re-evaluation into seconds.
+class measurement_cache {
+    sstring _path;
+    std::unordered_map<std::string, std::unordered_map<std::string, measured_property>> _mountpoints;
+public:
+    explicit measurement_cache(sstring path) : _path(std::move(path)) {
+        if (!fs::exists(fs::path(std::string(_path)))) {
+            return;
+        }
+        try {
+            auto doc = YAML::LoadFile(std::string(_path));
+            for (auto&& mp : doc["mountpoints"]) {
+                auto& properties = _mountpoints[mp["mountpoint"].as<std::string>()];
+                for (auto&& prop : mp["properties"]) {
+                    measured_property m;
+                    m.value = prop["value"].as<double>();
+                    m.rates = prop["rates"].as<std::vector<unsigned>>();
+                    properties[prop["name"].as<std::string>()] = std::move(m);
+                }
+            }
+        } catch (...) {
+            iotune_logger.warn("Could not parse measurement cache at {}: {}. Re-evaluating from scratch.",
+                    _path, std::current_exception());
+            _mountpoints.clear();
+        }
+    }
+
+    measured_property* find(const std::string& mountpoint, const std::string& property) {
+        auto mp = _mountpoints.find(mountpoint);
+        if (mp == _mountpoints.end()) {
+            return nullptr;
+        }
+        auto prop = mp->second.find(property);
+        return prop != mp->second.end() ? &prop->second : nullptr;
+    }
+
+    void store(const std::string& mountpoint, const std::string& property, measured_property m) {
+        _mountpoints[mountpoint][property] = std::move(m);
+    }
+
+    void save() {
+        YAML::Emitter out;
+        out << YAML::BeginMap;
+        out << YAML::Key << "mountpoints";
+        out << YAML::BeginSeq;
+        for (auto& [mountpoint, properties] : _mountpoints) {
+            out << YAML::BeginMap;
+            out << YAML::Key << "mountpoint" << YAML::Value << mountpoint;
+            out << YAML::Key << "properties";
+            out << YAML::BeginSeq;
+            for (auto& [name, m] : properties) {
+                out << YAML::BeginMap;
+                out << YAML::Key << "name" << YAML::Value << name;
+                out << YAML::Key << "value" << YAML::Value << m.value;
+                out << YAML::Key << "rates" << YAML::Value << YAML::Flow << m.rates;
+                out << YAML::EndMap;
+            }
+            out << YAML::EndSeq;
+            out << YAML::EndMap;
+        }
+        out << YAML::EndSeq;
+        out << YAML::EndMap;
+        out << YAML::Newline;
+
+        string_to_file(_path, sstring(out.c_str(), out.size()));
+    }
+};
+
 // Returns the mountpoint of a path. It works by walking backwards from the canonical path
 // (absolute, with symlinks resolved), until we find a point that crosses a device ID.
 fs::path mountpoint_of(sstring filename) {
@@ -663,6 +747,8 @@ int main(int ac, char** av) {
         ("format", bpo::value<sstring>()->default_value("seastar"), "Configuration file format (seastar | envfile)")
         ("fs-check", bpo::bool_switch(&fs_check), "perform FS check only")
         ("accuracy", bpo::value<unsigned>()->default_value(3), "acceptable deviation of measurements (percents)")
+        ("cache-file", bpo::value<sstring>(), "path of a measurement cache; cached results are validated with a quick confirmation pass and only properties that changed are re-measured")
+        ("confirmation-duration", bpo::value<unsigned>()->default_value(2), "time, in seconds, of the quick pass used to validate cached measurements")
     ;
 
     return app.run(ac, av, [&] {
@@ -672,6 +758,12 @@ int main(int ac, char** av) {
             auto format = configuration["format"].as<sstring>();
             auto duration = std::chrono::duration<double>(configuration["duration"].as<unsigned>() * 1s);
             auto accuracy = configuration["accuracy"].as<unsigned>();
+            auto confirmation_duration = std::chrono::duration<double>(configuration["confirmation-duration"].as<unsigned>() * 1s);
+
+            std::optional<measurement_cache> cache;
+            if (configuration.count("cache-file")) {
+                cache.emplace(configuration["cache-file"].as<sstring>());
+            }
 
             std::vector<disk_descriptor> disk_descriptors;
             std::unordered_map<sstring, sstring> mountpoint_map;
@@ -735,52 +827,98 @@ int main(int ac, char** av) {
                 row_stats rates;
                 auto accuracy_msg = [accuracy, &rates] {
                     auto stdev = rates.stdev_percents();
-                    return (accuracy == 0 || stdev > accuracy) ? fmt::format(" (deviation {}%)", int(round(stdev))) : std::string("");
+                    auto msg = fmt::format(" ±{:.1f}% (95% CI)", rates.confidence_percents());
+                    if (accuracy == 0 || stdev > accuracy) {
+                        msg += fmt::format(" (deviation {}%)", int(round(stdev)));
+                    }
+                    return msg;
+                };
+
+                // Measures one disk property. With a measurement cache, a cached value
+                // is first validated with a quick pass: if the observed rate falls
+                // within the tolerance implied by the stored points, the cached value
+                // is kept (and the new points merged in); only properties that drifted
+                // get the full-duration sweep again.
+                auto evaluate = [&] (const std::string& property, std::chrono::duration<double> full_duration, auto&& measure) {
+                    auto* cached = cache ? cache->find(mountpoint, property) : nullptr;
+                    if (cached && cached->value > 0) {
+                        auto probe = measure(confirmation_duration);
+                        auto deviation = std::abs(probe.value - cached->value) * 100.0 / cached->value;
+                        auto tolerance = std::max<double>(accuracy ? accuracy : 3.0, 2.0 * cached->stats().confidence_percents());
+                        if (deviation <= tolerance) {
+                            cached->rates.insert(cached->rates.end(), probe.rates.begin(), probe.rates.end());
+                            rates = cached->stats();
+                            return cached->value;
+                        }
+                        iotune_logger.info("Cached {} for {} drifted by {:.1f}% (tolerance {:.1f}%), re-measuring",
+                                property, mountpoint, deviation, tolerance);
+                    }
+                    auto m = measure(full_duration);
+                    auto value = m.value;
+                    rates = m.stats();
+                    if (cache) {
+                        cache->store(mountpoint, property, std::move(m));
+                    }
+                    return value;
                 };
 
                 iotune_tests.create_data_file().get();
 
                 fmt::print("Starting Evaluation. This may take a while...\n");
+                size_t sequential_buffer_size = 1 << 20;
+
                 fmt::print("Measuring sequential write bandwidth: ");
                 std::cout.flush();
-                io_rates write_bw;
-                size_t sequential_buffer_size = 1 << 20;
-                for (unsigned shard = 0; shard < smp::count; ++shard) {
-                    write_bw += iotune_tests.write_sequential_data(shard, sequential_buffer_size, duration * 0.70 / smp::count).get0();
-                }
-                write_bw.bytes_per_sec /= smp::count;
-                rates = iotune_tests.get_serial_rates().get0();
-                fmt::print("{} MB/s{}\n", uint64_t(write_bw.bytes_per_sec / (1024 * 1024)), accuracy_msg());
+                auto write_bw = evaluate("sequential_write_bandwidth", duration * 0.70, [&] (std::chrono::duration<double> d) {
+                    io_rates bw;
+                    for (unsigned shard = 0; shard < smp::count; ++shard) {
+                        bw += iotune_tests.write_sequential_data(shard, sequential_buffer_size, d / smp::count).get0();
+                    }
+                    return measured_property{bw.bytes_per_sec / smp::count, iotune_tests.take_serial_rates().get0()};
+                });
+                fmt::print("{} MB/s{}\n", uint64_t(write_bw / (1024 * 1024)), accuracy_msg());
 
                 fmt::print("Measuring sequential read bandwidth: ");
                 std::cout.flush();
-                auto read_bw = iotune_tests.read_sequential_data(0, sequential_buffer_size, duration * 0.1).get0();
-                rates = iotune_tests.get_serial_rates().get0();
-                fmt::print("{} MB/s{}\n", uint64_t(read_bw.bytes_per_sec / (1024 * 1024)), accuracy_msg());
+                auto read_bw = evaluate("sequential_read_bandwidth", duration * 0.1, [&] (std::chrono::duration<double> d) {
+                    auto bw = iotune_tests.read_sequential_data(0, sequential_buffer_size, d).get0();
+                    return measured_property{bw.bytes_per_sec, iotune_tests.take_serial_rates().get0()};
+                });
+                fmt::print("{} MB/s{}\n", uint64_t(read_bw / (1024 * 1024)), accuracy_msg());
 
                 fmt::print("Measuring random write IOPS: ");
                 std::cout.flush();
-                auto write_iops = iotune_tests.write_random_data(test_directory.minimum_io_size(), duration * 0.1).get0();
-                rates = iotune_tests.get_sharded_worst_rates().get0();
-                fmt::print("{} IOPS{}\n", uint64_t(write_iops.iops), accuracy_msg());
+                auto write_iops = evaluate("random_write_iops", duration * 0.1, [&] (std::chrono::duration<double> d) {
+                    auto iops = iotune_tests.write_random_data(test_directory.minimum_io_size(), d).get0();
+                    return measured_property{iops.iops, iotune_tests.take_sharded_worst_rates().get0()};
+                });
+                fmt::print("{} IOPS{}\n", uint64_t(write_iops), accuracy_msg());
 
                 fmt::print("Measuring random read IOPS: ");
                 std::cout.flush();
-                auto read_iops = iotune_tests.read_random_data(test_directory.minimum_io_size(), duration * 0.1).get0();
-                rates = iotune_tests.get_sharded_worst_rates().get0();
-                fmt::print("{} IOPS{}\n", uint64_t(read_iops.iops), accuracy_msg());
+                auto read_iops = evaluate("random_read_iops", duration * 0.1, [&] (std::chrono::duration<double> d) {
+                    auto iops = iotune_tests.read_random_data(test_directory.minimum_io_size(), d).get0();
+                    return measured_property{iops.iops, iotune_tests.take_sharded_worst_rates().get0()};
+                });
+                fmt::print("{} IOPS{}\n", uint64_t(read_iops), accuracy_msg());
 
                 struct disk_descriptor desc;
                 desc.mountpoint = mountpoint;
-                desc.read_iops = read_iops.iops;
-                desc.read_bw = read_bw.bytes_per_sec;
-                desc.write_iops = write_iops.iops;
-                desc.write_bw = write_bw.bytes_per_sec;
+                desc.read_iops = read_iops;
+                desc.read_bw = read_bw;
+                desc.write_iops = write_iops;
+                desc.write_bw = write_bw;
                 disk_descriptors.push_back(std::move(desc));
             }
 
-            auto file = "properties file";
+            auto file = "measurement cache";
             try {
+                if (cache) {
+                    fmt::print("Writing measurement cache to {}\n", configuration["cache-file"].as<sstring>());
+                    cache->save();
+                }
+
+                file = "properties file";
                 if (configuration.count("properties-file")) {
                     fmt::print("Writing result to {}\n", configuration["properties-file"].as<sstring>());
                     write_property_file(configuration["properties-file"].as<sstring>(), disk_descriptors);
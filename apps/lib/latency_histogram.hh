@@ -0,0 +1,112 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Copyright (C) 2020 Cloudius Systems, Ltd.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace seastar_apps_lib {
+
+// HDR-style histogram of latencies, in microseconds. Values are spread over
+// power-of-two buckets with 64 linear sub-buckets each, so any quantile is
+// resolved with ~1.6% relative error however many samples were recorded --
+// unlike streaming quantile estimators, the tail percentiles stay exact
+// enough to compare p99.9 between runs.
+class latency_histogram {
+    static constexpr unsigned sub_bucket_bits = 6;
+    std::vector<uint64_t> _counts;
+    uint64_t _count = 0;
+    uint64_t _sum = 0;
+    uint64_t _max = 0;
+
+    static unsigned index_of(uint64_t value) {
+        if (value < (1ull << sub_bucket_bits)) {
+            return value;
+        }
+        unsigned bucket = (63 - __builtin_clzll(value)) - sub_bucket_bits + 1;
+        return (bucket << sub_bucket_bits) + (value >> bucket);
+    }
+
+    static uint64_t value_of(unsigned index) {
+        unsigned bucket = index >> sub_bucket_bits;
+        if (bucket == 0) {
+            return index;
+        }
+        uint64_t sub = index & ((1u << sub_bucket_bits) - 1);
+        // middle of the range the index covers
+        return (sub << bucket) + (1ull << (bucket - 1));
+    }
+
+public:
+    void record(uint64_t value) {
+        auto index = index_of(value);
+        if (index >= _counts.size()) {
+            _counts.resize(index + 1);
+        }
+        _counts[index]++;
+        _count++;
+        _sum += value;
+        _max = std::max(_max, value);
+    }
+
+    // fold another histogram into this one; buckets are identical on all
+    // instances, so merged quantiles are as exact as locally recorded ones
+    void merge(const latency_histogram& other) {
+        if (other._counts.size() > _counts.size()) {
+            _counts.resize(other._counts.size());
+        }
+        for (unsigned i = 0; i < other._counts.size(); i++) {
+            _counts[i] += other._counts[i];
+        }
+        _count += other._count;
+        _sum += other._sum;
+        _max = std::max(_max, other._max);
+    }
+
+    uint64_t quantile(double q) const {
+        uint64_t target = std::min<uint64_t>(_count * q, _count ? _count - 1 : 0);
+        uint64_t seen = 0;
+        for (unsigned i = 0; i < _counts.size(); i++) {
+            seen += _counts[i];
+            if (seen > target) {
+                return std::min(value_of(i), _max);
+            }
+        }
+        return _max;
+    }
+
+    uint64_t count() const {
+        return _count;
+    }
+
+    uint64_t mean() const {
+        return _count ? _sum / _count : 0;
+    }
+
+    uint64_t max() const {
+        return _max;
+    }
+};
+
+}
@@ -38,8 +38,12 @@
 #include <seastar/core/distributed.hh>
 #include <seastar/core/vector-data-sink.hh>
 #include <seastar/core/bitops.hh>
+#include <seastar/core/do_with.hh>
+#include <seastar/core/prefetch.hh>
 #include <seastar/core/slab.hh>
 #include <seastar/core/align.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/print.hh>
 #include <seastar/net/api.hh>
 #include <seastar/net/packet-data-source.hh>
@@ -47,6 +51,7 @@
 #include <seastar/util/log.hh>
 #include "ascii.hh"
 #include "memcached.hh"
+#include <unordered_map>
 #include <unistd.h>
 
 #define PLATFORM "seastar"
@@ -315,6 +320,12 @@ struct cache_stats {
     size_t _resize_failure {};
     size_t _size {};
     size_t _reclaims{};
+    size_t _ext_spills {};
+    size_t _ext_spills_dropped {};
+    size_t _ext_hits {};
+    size_t _ext_misses {};
+    size_t _ext_compactions {};
+    size_t _ext_bytes_written {};
 
     void operator+=(const cache_stats& o) {
         _get_hits += o._get_hits;
@@ -336,6 +347,12 @@ struct cache_stats {
         _resize_failure += o._resize_failure;
         _size += o._size;
         _reclaims += o._reclaims;
+        _ext_spills += o._ext_spills;
+        _ext_spills_dropped += o._ext_spills_dropped;
+        _ext_hits += o._ext_hits;
+        _ext_misses += o._ext_misses;
+        _ext_compactions += o._ext_compactions;
+        _ext_bytes_written += o._ext_bytes_written;
     }
 };
 
@@ -366,6 +383,391 @@ struct item_insertion_data {
     expiration expiry;
 };
 
+//
+// Flash-backed secondary store for large values: items evicted from the
+// in-memory cache spill into a per-shard log-structured file, with only a
+// small (offset, length) index entry per key kept in memory. The log is
+// divided into fixed-size segments; when free segments run low, the
+// emptiest sealed segment is either recycled outright or compacted in the
+// background by relocating its live records to the head of the log.
+// Spills pass through a bytes-per-second admission budget, so an eviction
+// storm cannot saturate the disk with writes.
+//
+class external_store {
+public:
+    struct config {
+        sstring path; // file backing the log
+        uint64_t total_size = 1 * GB;
+        uint64_t segment_size = 8 * MB;
+        uint32_t value_threshold = 4 * KB; // spill values at least this big
+        uint64_t write_rate = 64 * MB; // admission budget, bytes per second
+    };
+
+    // Flat record of a spilled item: item_key is not no-throw movable, so
+    // it cannot travel inside a future; the key is rebuilt on promotion.
+    struct spilled_item {
+        sstring key;
+        sstring ascii_prefix;
+        sstring data;
+        expiration expiry;
+        item::version_type version;
+    };
+
+    struct ext_stats {
+        size_t _spills {};
+        size_t _spills_dropped {};
+        size_t _hits {};
+        size_t _misses {};
+        size_t _compactions {};
+        size_t _segment_drops {};
+        size_t _bytes_written {};
+    };
+private:
+    struct entry {
+        uint64_t offset;
+        uint32_t size;  // record bytes
+        uint32_t alloc; // record bytes aligned up to the write alignment
+    };
+
+    struct record_header {
+        item::version_type version;
+        int64_t expiry; // expiration::time_point ticks
+        uint32_t value_size;
+        uint8_t key_size;
+        uint8_t ascii_prefix_size;
+    };
+
+    config _cfg;
+    file _file;
+    uint64_t _write_alignment = 4096;
+    uint64_t _memory_alignment = 4096;
+    std::unordered_map<sstring, entry> _index;
+    std::vector<uint64_t> _segment_live_bytes;
+    std::vector<uint64_t> _free_segments;
+    uint64_t _append_segment = 0;
+    uint64_t _append_pos = 0;
+    uint64_t _write_budget = 0;
+    std::optional<uint64_t> _compacting_segment;
+    timer<clock_type> _budget_timer;
+    seastar::gate _gate;
+    ext_stats _stats;
+private:
+    uint64_t segment_of(const entry& e) const {
+        return e.offset / _cfg.segment_size;
+    }
+
+    void release_entry(const entry& e) {
+        _segment_live_bytes[segment_of(e)] -= e.alloc;
+    }
+
+    void insert_entry(sstring key, entry e) {
+        auto i = _index.find(key);
+        if (i != _index.end()) {
+            // the key was spilled again while this write was in flight.
+            release_entry(i->second);
+            i->second = e;
+        } else {
+            _index.emplace(std::move(key), e);
+        }
+    }
+
+    // Reserve @alloc bytes of log space, sealing the current append segment
+    // if it cannot fit them.
+    uint64_t reserve(uint32_t alloc) {
+        auto segment_end = (_append_segment + 1) * _cfg.segment_size;
+        if (_append_pos + alloc > segment_end) {
+            switch_append_segment();
+        }
+        auto offset = _append_pos;
+        _append_pos += alloc;
+        _segment_live_bytes[_append_segment] += alloc;
+        return offset;
+    }
+
+    void switch_append_segment() {
+        uint64_t seg;
+        if (!_free_segments.empty()) {
+            seg = _free_segments.back();
+            _free_segments.pop_back();
+        } else {
+            // out of space: sacrifice the emptiest sealed segment. This is
+            // a cache, so dropping its remaining entries only costs misses.
+            seg = emptiest_sealed_segment();
+            drop_segment(seg);
+            _stats._segment_drops++;
+        }
+        _append_segment = seg;
+        _append_pos = seg * _cfg.segment_size;
+        maybe_compact();
+    }
+
+    uint64_t emptiest_sealed_segment() {
+        auto best = _append_segment;
+        auto best_live = std::numeric_limits<uint64_t>::max();
+        for (uint64_t seg = 0; seg < _segment_live_bytes.size(); seg++) {
+            if (seg == _append_segment || seg == _compacting_segment ||
+                    std::find(_free_segments.begin(), _free_segments.end(), seg) != _free_segments.end()) {
+                continue;
+            }
+            if (_segment_live_bytes[seg] < best_live) {
+                best = seg;
+                best_live = _segment_live_bytes[seg];
+            }
+        }
+        return best;
+    }
+
+    void drop_segment(uint64_t seg) {
+        for (auto i = _index.begin(); i != _index.end();) {
+            if (segment_of(i->second) == seg) {
+                i = _index.erase(i);
+            } else {
+                ++i;
+            }
+        }
+        _segment_live_bytes[seg] = 0;
+    }
+
+    void maybe_compact() {
+        if (_compacting_segment || _free_segments.size() >= 2 || _gate.is_closed()) {
+            return;
+        }
+        auto seg = emptiest_sealed_segment();
+        if (seg == _append_segment) {
+            return; // nothing to pick from
+        }
+        if (_segment_live_bytes[seg] == 0) {
+            _free_segments.push_back(seg);
+            return;
+        }
+        if (_segment_live_bytes[seg] > _cfg.segment_size / 2) {
+            return; // too full to be worth the write amplification
+        }
+        _compacting_segment = seg;
+        (void)with_gate(_gate, [this, seg] {
+            return compact_segment(seg).then_wrapped([this] (future<> f) {
+                f.ignore_ready_future();
+                _stats._compactions++;
+                _compacting_segment = std::nullopt;
+            });
+        });
+    }
+
+    future<> compact_segment(uint64_t seg) {
+        // relocating appends the live records at the current write position,
+        // so the whole segment comes back as free space.
+        std::vector<std::pair<sstring, entry>> live;
+        for (auto& [key, e] : _index) {
+            if (segment_of(e) == seg) {
+                live.emplace_back(key, e);
+            }
+        }
+        return do_with(std::move(live), [this] (auto& live) {
+            return do_for_each(live, [this] (std::pair<sstring, entry>& key_and_entry) {
+                return relocate(std::move(key_and_entry.first), key_and_entry.second);
+            });
+        }).then([this, seg] {
+            drop_segment(seg); // anything that could not move is forfeited
+            _free_segments.push_back(seg);
+        });
+    }
+
+    future<> relocate(sstring key, entry e) {
+        auto buf = temporary_buffer<char>::aligned(_memory_alignment, e.alloc);
+        auto f = _file.dma_read(e.offset, buf.get_write(), e.alloc);
+        return f.then([this, key = std::move(key), e, buf = std::move(buf)] (size_t read) mutable {
+            auto i = _index.find(key);
+            if (read < e.size || i == _index.end() || i->second.offset != e.offset) {
+                return make_ready_future<>(); // the entry died while we were reading
+            }
+            entry moved{reserve(e.alloc), e.size, e.alloc};
+            _stats._bytes_written += e.alloc;
+            auto data = buf.get();
+            return _file.dma_write(moved.offset, data, e.alloc).then_wrapped(
+                    [this, key = std::move(key), e, moved] (future<size_t> f) {
+                try {
+                    if (f.get0() >= moved.size) {
+                        auto i = _index.find(key);
+                        if (i != _index.end() && i->second.offset == e.offset) {
+                            release_entry(e);
+                            i->second = moved;
+                            return;
+                        }
+                    }
+                } catch (...) {
+                }
+                release_entry(moved);
+            }).finally([buf = std::move(buf)] {});
+        });
+    }
+
+    std::optional<spilled_item> parse_record(temporary_buffer<char> buf, entry e, const sstring& key, size_t read) {
+        if (read < e.size) {
+            _stats._misses++;
+            return std::nullopt;
+        }
+        record_header hdr;
+        memcpy(&hdr, buf.get(), sizeof(hdr));
+        auto p = buf.get() + sizeof(hdr);
+        if (sizeof(hdr) + hdr.key_size + hdr.ascii_prefix_size + hdr.value_size != e.size
+                || key.size() != hdr.key_size || memcmp(p, key.data(), hdr.key_size) != 0) {
+            // the record was overwritten while the read was in flight
+            _stats._misses++;
+            return std::nullopt;
+        }
+        expiration expiry;
+        expiry._time = expiration::time_point(expiration::duration(hdr.expiry));
+        if (expiry.ever_expires() && expiry.to_time_point() <= clock_type::now()) {
+            _stats._misses++;
+            return std::nullopt;
+        }
+        _stats._hits++;
+        return spilled_item{
+            .key = key,
+            .ascii_prefix = sstring(p + hdr.key_size, hdr.ascii_prefix_size),
+            .data = sstring(p + hdr.key_size + hdr.ascii_prefix_size, hdr.value_size),
+            .expiry = expiry,
+            .version = hdr.version
+        };
+    }
+public:
+    explicit external_store(config cfg)
+        : _cfg(std::move(cfg))
+    {
+        _budget_timer.set_callback([this] {
+            _write_budget = _cfg.write_rate; // refill the admission budget
+        });
+    }
+
+    future<> start() {
+        assert(_cfg.total_size >= 2 * _cfg.segment_size);
+        return open_file_dma(_cfg.path, open_flags::rw | open_flags::create | open_flags::truncate).then([this] (file f) {
+            _file = std::move(f);
+            _write_alignment = std::max(_file.disk_write_dma_alignment(), _file.disk_read_dma_alignment());
+            _memory_alignment = _file.memory_dma_alignment();
+            auto nr_segments = _cfg.total_size / _cfg.segment_size;
+            _segment_live_bytes.resize(nr_segments);
+            for (uint64_t seg = 1; seg < nr_segments; seg++) {
+                _free_segments.push_back(seg);
+            }
+            _write_budget = _cfg.write_rate;
+            _budget_timer.arm_periodic(std::chrono::seconds(1));
+        });
+    }
+
+    future<> stop() {
+        _budget_timer.cancel();
+        return _gate.close().then([this] {
+            return _file ? _file.close() : make_ready_future<>();
+        });
+    }
+
+    // Called from the in-memory cache's eviction path: copies the item out
+    // synchronously and appends it to the log in the background.
+    void spill(item& item_ref) {
+        if (!_file || item_ref.value_size() < _cfg.value_threshold || _gate.is_closed()) {
+            return;
+        }
+        auto timeout = item_ref.get_timeout();
+        if (timeout != never_expire_timepoint && timeout <= clock_type::now()) {
+            return; // already expired; nothing worth keeping
+        }
+        auto record_size = sizeof(record_header) + item_ref.key_size()
+            + item_ref.ascii_prefix_size() + item_ref.value_size();
+        auto alloc = align_up<uint64_t>(record_size, _write_alignment);
+        if (alloc > _cfg.segment_size) {
+            return;
+        }
+        if (alloc > _write_budget) {
+            _stats._spills_dropped++;
+            return;
+        }
+        _write_budget -= alloc;
+
+        auto buf = temporary_buffer<char>::aligned(_memory_alignment, alloc);
+        auto p = buf.get_write();
+        record_header hdr;
+        hdr.version = item_ref.version();
+        hdr.expiry = timeout.time_since_epoch().count();
+        hdr.value_size = item_ref.value_size();
+        hdr.key_size = item_ref.key_size();
+        hdr.ascii_prefix_size = item_ref.ascii_prefix_size();
+        memcpy(p, &hdr, sizeof(hdr));
+        p += sizeof(hdr);
+        memcpy(p, item_ref.key().data(), item_ref.key_size());
+        p += item_ref.key_size();
+        memcpy(p, item_ref.ascii_prefix().data(), item_ref.ascii_prefix_size());
+        p += item_ref.ascii_prefix_size();
+        memcpy(p, item_ref.value().data(), item_ref.value_size());
+        p += item_ref.value_size();
+        memset(p, 0, buf.get_write() + alloc - p);
+
+        entry e{reserve(alloc), uint32_t(record_size), uint32_t(alloc)};
+        _stats._spills++;
+        _stats._bytes_written += alloc;
+        (void)with_gate(_gate, [this, e, buf = std::move(buf),
+                key = sstring(item_ref.key().data(), item_ref.key_size())] () mutable {
+            auto data = buf.get();
+            return _file.dma_write(e.offset, data, e.alloc).then_wrapped(
+                    [this, e, key = std::move(key)] (future<size_t> f) {
+                try {
+                    if (f.get0() >= e.size) {
+                        // only now can reads find the record.
+                        insert_entry(std::move(key), e);
+                        return;
+                    }
+                } catch (...) {
+                }
+                release_entry(e);
+            }).finally([buf = std::move(buf)] {});
+        });
+    }
+
+    future<std::optional<spilled_item>> get(const item_key& key) {
+        auto i = _index.find(key.key());
+        if (i == _index.end() || _gate.is_closed()) {
+            _stats._misses++;
+            return make_ready_future<std::optional<spilled_item>>(std::nullopt);
+        }
+        // the caller promotes the item back into memory; drop the flash copy.
+        auto e = i->second;
+        release_entry(e);
+        _index.erase(i);
+        return with_gate(_gate, [this, e, key = key.key()] {
+            auto buf = temporary_buffer<char>::aligned(_memory_alignment, e.alloc);
+            auto f = _file.dma_read(e.offset, buf.get_write(), e.alloc);
+            return f.then([this, e, key = std::move(key), buf = std::move(buf)] (size_t read) mutable {
+                return parse_record(std::move(buf), e, key, read);
+            });
+        });
+    }
+
+    bool invalidate(const item_key& key) {
+        auto i = _index.find(key.key());
+        if (i == _index.end()) {
+            return false;
+        }
+        release_entry(i->second);
+        _index.erase(i);
+        return true;
+    }
+
+    void invalidate_all() {
+        _index.clear();
+        std::fill(_segment_live_bytes.begin(), _segment_live_bytes.end(), 0);
+        _free_segments.clear();
+        for (uint64_t seg = 0; seg < _segment_live_bytes.size(); seg++) {
+            if (seg != _append_segment) {
+                _free_segments.push_back(seg);
+            }
+        }
+    }
+
+    const ext_stats& stats() const {
+        return _stats;
+    }
+};
+
 class cache {
 private:
     using cache_type = bi::unordered_set<item,
@@ -384,6 +786,7 @@ private:
     clock_type::duration _wc_to_clock_type_delta;
     cache_stats _stats;
     timer<clock_type> _flush_timer;
+    std::unique_ptr<external_store> _ext; // engaged when --extstore-path is given
 private:
     size_t item_size(item& item_ref) {
         constexpr size_t field_alignment = alignof(void*);
@@ -461,6 +864,9 @@ private:
         auto& old_item = *i;
         uint64_t old_item_version = old_item._version;
 
+        if (_ext) {
+            _ext->invalidate(insertion.key); // a spilled copy of the key is now stale
+        }
         erase(old_item);
 
         size_t size = item_size(insertion);
@@ -479,10 +885,13 @@ private:
 
     template <typename Origin>
     inline
-    void add_new(item_insertion_data& insertion) {
+    cache_iterator add_new(item_insertion_data& insertion, item::version_type version = 1) {
+        if (_ext) {
+            _ext->invalidate(insertion.key); // a spilled copy of the key is now stale
+        }
         size_t size = item_size(insertion);
         auto new_item = slab->create(size, Origin::move_if_local(insertion.key), Origin::move_if_local(insertion.ascii_prefix),
-            Origin::move_if_local(insertion.data), insertion.expiry);
+            Origin::move_if_local(insertion.data), insertion.expiry, version);
         intrusive_ptr_add_ref(new_item);
         auto& item_ref = *new_item;
         _cache.insert(item_ref);
@@ -491,6 +900,35 @@ private:
         }
         _stats._bytes += size;
         maybe_rehash();
+        return _cache.iterator_to(item_ref);
+    }
+
+    // Re-inserts an item fetched back from the external store. A regular
+    // set may have raced the flash read; in that case the fresher in-memory
+    // item wins and the spilled copy is forgotten.
+    item_ptr add_spilled(external_store::spilled_item& spilled) {
+        item_insertion_data insertion {
+            .key = item_key(std::move(spilled.key)),
+            .ascii_prefix = std::move(spilled.ascii_prefix),
+            .data = std::move(spilled.data),
+            .expiry = spilled.expiry
+        };
+        auto i = find(insertion.key);
+        if (i == _cache.end()) {
+            i = add_new<local_origin_tag>(insertion, spilled.version);
+        }
+        return item_ptr(&*i);
+    }
+
+    future<item_ptr> get_spilled(const item_key& key) {
+        return _ext->get(key).then([this] (std::optional<external_store::spilled_item> spilled) {
+            if (!spilled) {
+                _stats._get_misses++;
+                return item_ptr();
+            }
+            _stats._get_hits++;
+            return add_spilled(*spilled);
+        });
     }
 
     void maybe_rehash() {
@@ -522,7 +960,13 @@ public:
 
         // initialize per-thread slab allocator.
         slab_holder = std::make_unique<slab_allocator<item>>(default_slab_growth_factor, per_cpu_slab_size, slab_page_size,
-                [this](item& item_ref) { erase<true, true, false>(item_ref); _stats._evicted++; });
+                [this](item& item_ref) {
+                    if (_ext) {
+                        _ext->spill(item_ref);
+                    }
+                    erase<true, true, false>(item_ref);
+                    _stats._evicted++;
+                });
         slab = slab_holder.get();
 #ifdef __DEBUG__
         static bool print_slab_classes = true;
@@ -539,6 +983,9 @@ public:
 
     void flush_all() {
         _flush_timer.cancel();
+        if (_ext) {
+            _ext->invalidate_all();
+        }
         _cache.erase_and_dispose(_cache.begin(), _cache.end(), [this] (item* it) {
             erase<false, true>(*it);
         });
@@ -589,7 +1036,13 @@ public:
 
     bool remove(const item_key& key) {
         auto i = find(key);
+        // drop the spilled copy too, or the key would come back from flash.
+        bool spilled = _ext && _ext->invalidate(key);
         if (i == _cache.end()) {
+            if (spilled) {
+                _stats._delete_hits++;
+                return true;
+            }
             _stats._delete_misses++;
             return false;
         }
@@ -599,15 +1052,57 @@ public:
         return true;
     }
 
-    item_ptr get(const item_key& key) {
+    future<item_ptr> get(const item_key& key) {
         auto i = find(key);
-        if (i == _cache.end()) {
+        if (i != _cache.end()) {
+            _stats._get_hits++;
+            auto& item_ref = *i;
+            return make_ready_future<item_ptr>(item_ptr(&item_ref));
+        }
+        if (!_ext) {
             _stats._get_misses++;
-            return nullptr;
+            return make_ready_future<item_ptr>();
         }
-        _stats._get_hits++;
-        auto& item_ref = *i;
-        return item_ptr(&item_ref);
+        return get_spilled(key);
+    }
+
+    // Batched lookup for multi-key "get" requests. The hash buckets of the
+    // whole batch are prefetched up front, so the probes that follow overlap
+    // their cache misses instead of stalling on memory once per key.
+    future<std::vector<item_ptr>> get_many(std::vector<const item_key*> keys) {
+        auto bucket_mask = _cache.bucket_count() - 1;
+        for (auto key : keys) {
+            prefetch(_buckets.data() + (key->hash() & bucket_mask));
+        }
+        struct multi_get_state {
+            std::vector<const item_key*> keys;
+            std::vector<item_ptr> items;
+            std::vector<size_t> ext_misses;
+        };
+        return do_with(multi_get_state{std::move(keys)}, [this] (multi_get_state& state) {
+            state.items.resize(state.keys.size());
+            for (size_t i = 0; i < state.keys.size(); i++) {
+                auto it = find(*state.keys[i]);
+                if (it != _cache.end()) {
+                    _stats._get_hits++;
+                    state.items[i] = item_ptr(&*it);
+                } else if (_ext) {
+                    state.ext_misses.push_back(i);
+                } else {
+                    _stats._get_misses++;
+                }
+            }
+            if (state.ext_misses.empty()) {
+                return make_ready_future<std::vector<item_ptr>>(std::move(state.items));
+            }
+            return parallel_for_each(state.ext_misses, [this, &state] (size_t i) {
+                return get_spilled(*state.keys[i]).then([&state, i] (item_ptr it) {
+                    state.items[i] = std::move(it);
+                });
+            }).then([&state] {
+                return make_ready_future<std::vector<item_ptr>>(std::move(state.items));
+            });
+        });
     }
 
     template <typename Origin = local_origin_tag>
@@ -637,6 +1132,15 @@ public:
 
     cache_stats stats() {
         _stats._size = size();
+        if (_ext) {
+            auto& ext = _ext->stats();
+            _stats._ext_spills = ext._spills;
+            _stats._ext_spills_dropped = ext._spills_dropped;
+            _stats._ext_hits = ext._hits;
+            _stats._ext_misses = ext._misses;
+            _stats._ext_compactions = ext._compactions;
+            _stats._ext_bytes_written = ext._bytes_written;
+        }
         return _stats;
     }
 
@@ -727,7 +1231,17 @@ public:
         return {this_shard_id(), make_foreign(make_lw_shared<std::string>(ss.str()))};
     }
 
-    future<> stop() { return make_ready_future<>(); }
+    future<> start_external_store(external_store::config cfg) {
+        _ext = std::make_unique<external_store>(std::move(cfg));
+        return _ext->start();
+    }
+
+    future<> stop() {
+        if (_ext) {
+            return _ext->stop();
+        }
+        return make_ready_future<>();
+    }
     clock_type::duration get_wc_to_clock_type_delta() { return _wc_to_clock_type_delta; }
 };
 
@@ -791,6 +1305,41 @@ public:
         return _peers.invoke_on(cpu, &cache::get, std::ref(key));
     }
 
+    // The caller must keep @keys live until the resulting future resolves.
+    // Performs one batched lookup per owning shard instead of a cross-shard
+    // call per key; items are returned in the same order as @keys.
+    future<std::vector<item_ptr>> get_many(const std::vector<item_key>& keys) {
+        struct multi_get_state {
+            std::vector<std::vector<const item_key*>> keys_per_cpu;
+            std::vector<std::vector<size_t>> positions_per_cpu;
+            std::vector<item_ptr> items;
+        };
+        return do_with(multi_get_state(), [this, &keys] (multi_get_state& state) {
+            state.keys_per_cpu.resize(smp::count);
+            state.positions_per_cpu.resize(smp::count);
+            state.items.resize(keys.size());
+            for (size_t i = 0; i < keys.size(); i++) {
+                auto cpu = get_cpu(keys[i]);
+                state.keys_per_cpu[cpu].push_back(&keys[i]);
+                state.positions_per_cpu[cpu].push_back(i);
+            }
+            return parallel_for_each(smp::all_cpus(), [this, &state] (unsigned cpu) {
+                if (state.keys_per_cpu[cpu].empty()) {
+                    return make_ready_future<>();
+                }
+                return _peers.invoke_on(cpu, &cache::get_many, std::move(state.keys_per_cpu[cpu]))
+                        .then([&state, cpu] (std::vector<item_ptr> items) {
+                    auto& positions = state.positions_per_cpu[cpu];
+                    for (size_t i = 0; i < items.size(); i++) {
+                        state.items[positions[i]] = std::move(items[i]);
+                    }
+                });
+            }).then([&state] {
+                return make_ready_future<std::vector<item_ptr>>(std::move(state.items));
+            });
+        });
+    }
+
     // The caller must keep @insertion live until the resulting future resolves.
     future<cas_result> cas(item_insertion_data& insertion, item::version_type version) {
         auto cpu = get_cpu(insertion.key);
@@ -870,7 +1419,6 @@ private:
     memcache_ascii_parser _parser;
     item_key _item_key;
     item_insertion_data _insertion;
-    std::vector<item_ptr> _items;
 private:
     static constexpr const char *msg_crlf = "\r\n";
     static constexpr const char *msg_error = "ERROR\r\n";
@@ -919,15 +1467,10 @@ private:
                 return out.write(std::move(msg));
             });
         } else {
-            _items.clear();
-            return parallel_for_each(_parser._keys.begin(), _parser._keys.end(), [this] (const auto& key) {
-                return _cache.get(key).then([this] (auto item) {
-                    _items.emplace_back(std::move(item));
-                });
-            }).then([this, &out] () {
+            return _cache.get_many(_parser._keys).then([&out] (std::vector<item_ptr> items) {
                 scattered_message<char> msg;
-                for (auto& item : _items) {
-                    append_item<WithVersion>(msg, std::move(item));
+                for (auto& item : items) {
+                    this_type::append_item<WithVersion>(msg, std::move(item));
                 }
                 msg.append_static(msg_end);
                 return out.write(std::move(msg));
@@ -1020,6 +1563,18 @@ private:
                             return print_stat(out, "evictions", v);
                         }).then([&out, v = all_cache_stats._bytes] {
                             return print_stat(out, "bytes", v);
+                        }).then([&out, v = all_cache_stats._ext_spills] {
+                            return print_stat(out, "seastar.extstore_spills", v);
+                        }).then([&out, v = all_cache_stats._ext_spills_dropped] {
+                            return print_stat(out, "seastar.extstore_spills_dropped", v);
+                        }).then([&out, v = all_cache_stats._ext_hits] {
+                            return print_stat(out, "seastar.extstore_hits", v);
+                        }).then([&out, v = all_cache_stats._ext_misses] {
+                            return print_stat(out, "seastar.extstore_misses", v);
+                        }).then([&out, v = all_cache_stats._ext_compactions] {
+                            return print_stat(out, "seastar.extstore_compactions", v);
+                        }).then([&out, v = all_cache_stats._ext_bytes_written] {
+                            return print_stat(out, "seastar.extstore_bytes_written", v);
                         }).then([&out] {
                             return out.write(msg_end);
                         });
@@ -1041,169 +1596,171 @@ public:
         };
     }
 
-    future<> handle(input_stream<char>& in, output_stream<char>& out) {
-        _parser.init();
-        return in.consume(_parser).then([this, &out] () -> future<> {
-            switch (_parser._state) {
-                case memcache_ascii_parser::state::eof:
-                    return make_ready_future<>();
-
-                case memcache_ascii_parser::state::error:
-                    return out.write(msg_error);
-
-                case memcache_ascii_parser::state::cmd_set:
-                {
-                    _system_stats.local()._cmd_set++;
-                    prepare_insertion();
-                    auto f = _cache.set(_insertion);
-                    if (_parser._noreply) {
-                        return std::move(f).discard_result();
-                    }
-                    return std::move(f).then([&out] (...) {
-                        return out.write(msg_stored);
-                    });
+private:
+    future<> run_command(output_stream<char>& out) {
+        switch (_parser._state) {
+            case memcache_ascii_parser::state::eof:
+                return make_ready_future<>();
+
+            case memcache_ascii_parser::state::error:
+                return out.write(msg_error);
+
+            case memcache_ascii_parser::state::cmd_set:
+            {
+                _system_stats.local()._cmd_set++;
+                prepare_insertion();
+                auto f = _cache.set(_insertion);
+                if (_parser._noreply) {
+                    return std::move(f).discard_result();
                 }
+                return std::move(f).then([&out] (...) {
+                    return out.write(msg_stored);
+                });
+            }
 
-                case memcache_ascii_parser::state::cmd_cas:
-                {
-                    _system_stats.local()._cmd_set++;
-                    prepare_insertion();
-                    auto f = _cache.cas(_insertion, _parser._version);
-                    if (_parser._noreply) {
-                        return std::move(f).discard_result();
-                    }
-                    return std::move(f).then([&out] (auto result) {
-                        switch (result) {
-                            case cas_result::stored:
-                                return out.write(msg_stored);
-                            case cas_result::not_found:
-                                return out.write(msg_not_found);
-                            case cas_result::bad_version:
-                                return out.write(msg_exists);
-                            default:
-                                std::abort();
-                        }
-                    });
+            case memcache_ascii_parser::state::cmd_cas:
+            {
+                _system_stats.local()._cmd_set++;
+                prepare_insertion();
+                auto f = _cache.cas(_insertion, _parser._version);
+                if (_parser._noreply) {
+                    return std::move(f).discard_result();
                 }
-
-                case memcache_ascii_parser::state::cmd_add:
-                {
-                    _system_stats.local()._cmd_set++;
-                    prepare_insertion();
-                    auto f = _cache.add(_insertion);
-                    if (_parser._noreply) {
-                        return std::move(f).discard_result();
+                return std::move(f).then([&out] (auto result) {
+                    switch (result) {
+                        case cas_result::stored:
+                            return out.write(msg_stored);
+                        case cas_result::not_found:
+                            return out.write(msg_not_found);
+                        case cas_result::bad_version:
+                            return out.write(msg_exists);
+                        default:
+                            std::abort();
                     }
-                    return std::move(f).then([&out] (bool added) {
-                        return out.write(added ? msg_stored : msg_not_stored);
-                    });
+                });
+            }
+
+            case memcache_ascii_parser::state::cmd_add:
+            {
+                _system_stats.local()._cmd_set++;
+                prepare_insertion();
+                auto f = _cache.add(_insertion);
+                if (_parser._noreply) {
+                    return std::move(f).discard_result();
                 }
+                return std::move(f).then([&out] (bool added) {
+                    return out.write(added ? msg_stored : msg_not_stored);
+                });
+            }
 
-                case memcache_ascii_parser::state::cmd_replace:
-                {
-                    _system_stats.local()._cmd_set++;
-                    prepare_insertion();
-                    auto f = _cache.replace(_insertion);
-                    if (_parser._noreply) {
-                        return std::move(f).discard_result();
-                    }
-                    return std::move(f).then([&out] (auto replaced) {
-                        return out.write(replaced ? msg_stored : msg_not_stored);
-                    });
+            case memcache_ascii_parser::state::cmd_replace:
+            {
+                _system_stats.local()._cmd_set++;
+                prepare_insertion();
+                auto f = _cache.replace(_insertion);
+                if (_parser._noreply) {
+                    return std::move(f).discard_result();
                 }
+                return std::move(f).then([&out] (auto replaced) {
+                    return out.write(replaced ? msg_stored : msg_not_stored);
+                });
+            }
+
+            case memcache_ascii_parser::state::cmd_get:
+                return handle_get<false>(out);
 
-                case memcache_ascii_parser::state::cmd_get:
-                    return handle_get<false>(out);
+            case memcache_ascii_parser::state::cmd_gets:
+                return handle_get<true>(out);
 
-                case memcache_ascii_parser::state::cmd_gets:
-                    return handle_get<true>(out);
+            case memcache_ascii_parser::state::cmd_delete:
+            {
+                auto f = _cache.remove(_parser._key);
+                if (_parser._noreply) {
+                    return std::move(f).discard_result();
+                }
+                return std::move(f).then([&out] (bool removed) {
+                    return out.write(removed ? msg_deleted : msg_not_found);
+                });
+            }
 
-                case memcache_ascii_parser::state::cmd_delete:
-                {
-                    auto f = _cache.remove(_parser._key);
+            case memcache_ascii_parser::state::cmd_flush_all:
+            {
+                _system_stats.local()._cmd_flush++;
+                if (_parser._expiration) {
+                    auto f = _cache.flush_at(_parser._expiration);
                     if (_parser._noreply) {
-                        return std::move(f).discard_result();
+                        return f;
                     }
-                    return std::move(f).then([&out] (bool removed) {
-                        return out.write(removed ? msg_deleted : msg_not_found);
+                    return std::move(f).then([&out] {
+                        return out.write(msg_ok);
                     });
-                }
-
-                case memcache_ascii_parser::state::cmd_flush_all:
-                {
-                    _system_stats.local()._cmd_flush++;
-                    if (_parser._expiration) {
-                        auto f = _cache.flush_at(_parser._expiration);
-                        if (_parser._noreply) {
-                            return f;
-                        }
-                        return std::move(f).then([&out] {
-                            return out.write(msg_ok);
-                        });
-                    } else {
-                        auto f = _cache.flush_all();
-                        if (_parser._noreply) {
-                            return f;
-                        }
-                        return std::move(f).then([&out] {
-                            return out.write(msg_ok);
-                        });
+                } else {
+                    auto f = _cache.flush_all();
+                    if (_parser._noreply) {
+                        return f;
                     }
+                    return std::move(f).then([&out] {
+                        return out.write(msg_ok);
+                    });
                 }
+            }
 
-                case memcache_ascii_parser::state::cmd_version:
-                    return out.write(msg_version);
+            case memcache_ascii_parser::state::cmd_version:
+                return out.write(msg_version);
 
-                case memcache_ascii_parser::state::cmd_stats:
-                    return print_stats(out);
+            case memcache_ascii_parser::state::cmd_stats:
+                return print_stats(out);
 
-                case memcache_ascii_parser::state::cmd_stats_hash:
-                    return _cache.print_hash_stats(out);
+            case memcache_ascii_parser::state::cmd_stats_hash:
+                return _cache.print_hash_stats(out);
 
-                case memcache_ascii_parser::state::cmd_incr:
-                {
-                    auto f = _cache.incr(_parser._key, _parser._u64);
-                    if (_parser._noreply) {
-                        return std::move(f).discard_result();
+            case memcache_ascii_parser::state::cmd_incr:
+            {
+                auto f = _cache.incr(_parser._key, _parser._u64);
+                if (_parser._noreply) {
+                    return std::move(f).discard_result();
+                }
+                return std::move(f).then([&out] (auto result) {
+                    auto item = std::move(result.first);
+                    if (!item) {
+                        return out.write(msg_not_found);
                     }
-                    return std::move(f).then([&out] (auto result) {
-                        auto item = std::move(result.first);
-                        if (!item) {
-                            return out.write(msg_not_found);
-                        }
-                        auto incremented = result.second;
-                        if (!incremented) {
-                            return out.write(msg_error_non_numeric_value);
-                        }
-                        return out.write(item->value().data(), item->value_size()).then([&out] {
-                            return out.write(msg_crlf);
-                        });
+                    auto incremented = result.second;
+                    if (!incremented) {
+                        return out.write(msg_error_non_numeric_value);
+                    }
+                    return out.write(item->value().data(), item->value_size()).then([&out] {
+                        return out.write(msg_crlf);
                     });
-                }
+                });
+            }
 
-                case memcache_ascii_parser::state::cmd_decr:
-                {
-                    auto f = _cache.decr(_parser._key, _parser._u64);
-                    if (_parser._noreply) {
-                        return std::move(f).discard_result();
+            case memcache_ascii_parser::state::cmd_decr:
+            {
+                auto f = _cache.decr(_parser._key, _parser._u64);
+                if (_parser._noreply) {
+                    return std::move(f).discard_result();
+                }
+                return std::move(f).then([&out] (auto result) {
+                    auto item = std::move(result.first);
+                    if (!item) {
+                        return out.write(msg_not_found);
                     }
-                    return std::move(f).then([&out] (auto result) {
-                        auto item = std::move(result.first);
-                        if (!item) {
-                            return out.write(msg_not_found);
-                        }
-                        auto decremented = result.second;
-                        if (!decremented) {
-                            return out.write(msg_error_non_numeric_value);
-                        }
-                        return out.write(item->value().data(), item->value_size()).then([&out] {
-                            return out.write(msg_crlf);
-                        });
+                    auto decremented = result.second;
+                    if (!decremented) {
+                        return out.write(msg_error_non_numeric_value);
+                    }
+                    return out.write(item->value().data(), item->value_size()).then([&out] {
+                        return out.write(msg_crlf);
                     });
-                }
-            };
-            std::abort();
-        }).then_wrapped([this, &out] (auto&& f) -> future<> {
+                });
+            }
+        };
+        std::abort();
+    }
+
+    future<> finish_command(output_stream<char>& out) {
+        return run_command(out).then_wrapped([this, &out] (auto&& f) -> future<> {
             // FIXME: then_wrapped() being scheduled even though no exception was triggered has a
             // performance cost of about 2.6%. Not using it means maintainability penalty.
             try {
@@ -1216,7 +1773,308 @@ public:
             }
             return make_ready_future<>();
         });
+    }
+public:
+    future<> handle(input_stream<char>& in, output_stream<char>& out) {
+        _parser.init();
+        return in.consume(_parser).then([this, &out] {
+            return finish_command(out);
+        });
+    }
+
+    // Variant used after the server peeked at the first byte of a command
+    // for protocol detection: @prefix is fed to the parser ahead of the
+    // rest of the stream.
+    future<> handle(temporary_buffer<char> prefix, input_stream<char>& in, output_stream<char>& out) {
+        _parser.init();
+        return _parser(std::move(prefix)).then([this, &in, &out] (auto&& remainder) {
+            if (remainder) {
+                return finish_command(out);
+            }
+            return in.consume(_parser).then([this, &out] {
+                return finish_command(out);
+            });
+        });
+    }
+};
+
+//
+// Binary protocol: requests and responses are framed by a fixed 24-byte
+// header, which is read and written directly without going through the
+// ragel machine. The quiet opcode variants suppress uninteresting
+// responses, so clients can pipeline whole batches of requests and
+// correlate the responses by the echoed opaque field.
+//
+class binary_protocol {
+public:
+    static constexpr uint8_t request_magic = 0x80;
+    static constexpr uint8_t response_magic = 0x81;
+private:
+    enum class opcode : uint8_t {
+        get = 0x00,
+        set = 0x01,
+        add = 0x02,
+        replace = 0x03,
+        del = 0x04,
+        quit = 0x07,
+        getq = 0x09,
+        noop = 0x0a,
+        version = 0x0b,
+        getk = 0x0c,
+        getkq = 0x0d,
+        setq = 0x11,
+    };
+
+    enum class status : uint16_t {
+        ok = 0x0000,
+        key_not_found = 0x0001,
+        key_exists = 0x0002,
+        invalid_arguments = 0x0004,
+        not_stored = 0x0005,
+        unknown_command = 0x0081,
+        out_of_memory = 0x0082,
     };
+
+    struct header {
+        uint8_t _magic;
+        uint8_t _opcode;
+        packed<uint16_t> _key_length;
+        uint8_t _extras_length;
+        uint8_t _data_type;
+        packed<uint16_t> _status; // vbucket id in requests
+        packed<uint32_t> _body_length;
+        packed<uint32_t> _opaque;
+        packed<uint64_t> _cas;
+
+        template<typename Adjuster>
+        auto adjust_endianness(Adjuster a) {
+            return a(_key_length, _status, _body_length, _opaque, _cas);
+        }
+    } __attribute__((packed));
+
+    sharded_cache& _cache;
+    distributed<system_stats>& _system_stats;
+    item_key _item_key;
+    item_insertion_data _insertion;
+    bool _quit = false;
+private:
+    static uint32_t item_flags(item& item_ref) {
+        // ascii_prefix is " <flags> <bytes>"; recover the numeric flags.
+        auto prefix = item_ref.ascii_prefix();
+        uint32_t flags = 0;
+        for (auto i = 1u; i < prefix.size() && prefix[i] != ' '; i++) {
+            flags = flags * 10 + (prefix[i] - '0');
+        }
+        return flags;
+    }
+
+    future<> respond(output_stream<char>& out, opcode op, status st, uint32_t opaque,
+            uint64_t cas = 0, sstring extras = {}, sstring key = {}, sstring value = {}) {
+        header hdr;
+        hdr._magic = response_magic;
+        hdr._opcode = static_cast<uint8_t>(op);
+        hdr._key_length = uint16_t(key.size());
+        hdr._extras_length = uint8_t(extras.size());
+        hdr._data_type = 0;
+        hdr._status = static_cast<uint16_t>(st);
+        hdr._body_length = uint32_t(extras.size() + key.size() + value.size());
+        hdr._opaque = opaque;
+        hdr._cas = cas;
+        hdr = hton(hdr);
+        scattered_message<char> msg;
+        msg.append(sstring(reinterpret_cast<const char*>(&hdr), sizeof(hdr)));
+        if (!extras.empty()) {
+            msg.append(std::move(extras));
+        }
+        if (!key.empty()) {
+            msg.append(std::move(key));
+        }
+        if (!value.empty()) {
+            msg.append(std::move(value));
+        }
+        return out.write(std::move(msg));
+    }
+
+    future<> respond_item(output_stream<char>& out, opcode op, uint32_t opaque,
+            sstring extras, sstring key, item_ptr item) {
+        header hdr;
+        hdr._magic = response_magic;
+        hdr._opcode = static_cast<uint8_t>(op);
+        hdr._key_length = uint16_t(key.size());
+        hdr._extras_length = uint8_t(extras.size());
+        hdr._data_type = 0;
+        hdr._status = static_cast<uint16_t>(status::ok);
+        hdr._body_length = uint32_t(extras.size() + key.size() + item->value_size());
+        hdr._opaque = opaque;
+        hdr._cas = item->version();
+        hdr = hton(hdr);
+        scattered_message<char> msg;
+        msg.append(sstring(reinterpret_cast<const char*>(&hdr), sizeof(hdr)));
+        msg.append(std::move(extras));
+        if (!key.empty()) {
+            msg.append(std::move(key));
+        }
+        msg.append_static(item->value());
+        msg.on_delete([item = std::move(item)] {});
+        return out.write(std::move(msg));
+    }
+
+    future<> handle_get(const header& hdr, sstring key, output_stream<char>& out) {
+        _system_stats.local()._cmd_get++;
+        auto op = opcode(hdr._opcode);
+        bool quiet = op == opcode::getq || op == opcode::getkq;
+        bool with_key = op == opcode::getk || op == opcode::getkq;
+        uint32_t opaque = hdr._opaque;
+        _item_key = item_key(std::move(key));
+        return _cache.get(_item_key).then([this, &out, op, quiet, with_key, opaque] (item_ptr item) {
+            if (!item) {
+                if (quiet) {
+                    // quiet misses are simply not answered, which is what
+                    // makes pipelined multi-get cheap for sparse hits.
+                    return make_ready_future<>();
+                }
+                return respond(out, op, status::key_not_found, opaque, 0, sstring(),
+                    with_key ? sstring(_item_key.key()) : sstring());
+            }
+            auto flags = hton(item_flags(*item));
+            sstring extras(reinterpret_cast<const char*>(&flags), sizeof(flags));
+            return respond_item(out, op, opaque, std::move(extras),
+                with_key ? sstring(_item_key.key()) : sstring(), std::move(item));
+        });
+    }
+
+    future<> handle_store(const header& hdr, temporary_buffer<char> body, output_stream<char>& out) {
+        auto op = opcode(hdr._opcode);
+        bool quiet = op == opcode::setq;
+        uint32_t opaque = hdr._opaque;
+        if (hdr._extras_length != 8) {
+            return respond(out, op, status::invalid_arguments, opaque);
+        }
+        _system_stats.local()._cmd_set++;
+        uint32_t flags;
+        uint32_t expiration_time;
+        std::copy_n(body.get(), sizeof(flags), reinterpret_cast<char*>(&flags));
+        std::copy_n(body.get() + sizeof(flags), sizeof(expiration_time), reinterpret_cast<char*>(&expiration_time));
+        flags = ntoh(flags);
+        expiration_time = ntoh(expiration_time);
+        uint16_t key_length = hdr._key_length;
+        auto value_size = uint32_t(hdr._body_length) - hdr._extras_length - key_length;
+        auto value = body.get() + hdr._extras_length + key_length;
+        _insertion = item_insertion_data{
+            .key = item_key(sstring(body.get() + hdr._extras_length, key_length)),
+            .ascii_prefix = make_sstring(" ", to_sstring(flags), " ", to_sstring(value_size)),
+            .data = sstring(value, value_size),
+            .expiry = expiration(_cache.get_wc_to_clock_type_delta(), expiration_time)
+        };
+        switch (op) {
+        case opcode::set:
+        case opcode::setq:
+            return _cache.set(_insertion).then([this, &out, op, quiet, opaque] (bool) {
+                if (quiet) {
+                    return make_ready_future<>();
+                }
+                return respond(out, op, status::ok, opaque);
+            });
+        case opcode::add:
+            return _cache.add(_insertion).then([this, &out, op, opaque] (bool added) {
+                return respond(out, op, added ? status::ok : status::key_exists, opaque);
+            });
+        default: // opcode::replace
+            return _cache.replace(_insertion).then([this, &out, op, opaque] (bool replaced) {
+                return respond(out, op, replaced ? status::ok : status::key_not_found, opaque);
+            });
+        }
+    }
+
+    future<> handle_delete(const header& hdr, sstring key, output_stream<char>& out) {
+        auto op = opcode(hdr._opcode);
+        uint32_t opaque = hdr._opaque;
+        _item_key = item_key(std::move(key));
+        return _cache.remove(_item_key).then([this, &out, op, opaque] (bool removed) {
+            return respond(out, op, removed ? status::ok : status::key_not_found, opaque);
+        });
+    }
+
+    future<> handle_request(header hdr, input_stream<char>& in, output_stream<char>& out) {
+        return in.read_exactly(hdr._body_length).then([this, hdr, &out] (temporary_buffer<char> body) {
+            if (body.size() < uint32_t(hdr._body_length)
+                    || hdr._extras_length + uint32_t(hdr._key_length) > body.size()) {
+                _quit = true; // framing error (or eof mid-request); drop the connection
+                return make_ready_future<>();
+            }
+            sstring key(body.get() + hdr._extras_length, uint16_t(hdr._key_length));
+            uint32_t opaque = hdr._opaque;
+            switch (opcode(hdr._opcode)) {
+            case opcode::get:
+            case opcode::getq:
+            case opcode::getk:
+            case opcode::getkq:
+                return handle_get(hdr, std::move(key), out);
+            case opcode::set:
+            case opcode::setq:
+            case opcode::add:
+            case opcode::replace:
+                return handle_store(hdr, std::move(body), out);
+            case opcode::del:
+                return handle_delete(hdr, std::move(key), out);
+            case opcode::noop:
+                return respond(out, opcode::noop, status::ok, opaque);
+            case opcode::version:
+                return respond(out, opcode::version, status::ok, opaque, 0, sstring(), sstring(),
+                    VERSION_STRING);
+            case opcode::quit:
+                _quit = true;
+                return respond(out, opcode::quit, status::ok, opaque);
+            default:
+                return respond(out, opcode(hdr._opcode), status::unknown_command, opaque);
+            }
+        }).then_wrapped([this, hdr, &out] (auto&& f) -> future<> {
+            try {
+                f.get();
+            } catch (std::bad_alloc& e) {
+                return respond(out, opcode(hdr._opcode), status::out_of_memory, hdr._opaque);
+            }
+            return make_ready_future<>();
+        });
+    }
+public:
+    binary_protocol(sharded_cache& cache, distributed<system_stats>& system_stats)
+        : _cache(cache)
+        , _system_stats(system_stats)
+    {}
+
+    bool quit_requested() const {
+        return _quit;
+    }
+
+    future<> handle(input_stream<char>& in, output_stream<char>& out) {
+        return in.read_exactly(sizeof(header)).then([this, &in, &out] (temporary_buffer<char> buf) {
+            if (buf.size() < sizeof(header)) {
+                return make_ready_future<>(); // eof
+            }
+            header hdr;
+            std::copy_n(buf.get(), sizeof(hdr), reinterpret_cast<char*>(&hdr));
+            if (hdr._magic != request_magic) {
+                _quit = true;
+                return make_ready_future<>();
+            }
+            return handle_request(ntoh(hdr), in, out);
+        });
+    }
+
+    // Entry point used when the server already consumed the magic byte of
+    // the request while telling the protocols apart.
+    future<> handle_after_magic(input_stream<char>& in, output_stream<char>& out) {
+        return in.read_exactly(sizeof(header) - 1).then([this, &in, &out] (temporary_buffer<char> buf) {
+            if (buf.size() < sizeof(header) - 1) {
+                return make_ready_future<>();
+            }
+            header hdr;
+            hdr._magic = request_magic;
+            std::copy_n(buf.get(), sizeof(hdr) - 1, reinterpret_cast<char*>(&hdr) + 1);
+            return handle_request(ntoh(hdr), in, out);
+        });
+    }
 };
 
 class udp_server {
@@ -1341,6 +2199,8 @@ private:
         input_stream<char> _in;
         output_stream<char> _out;
         ascii_protocol _proto;
+        binary_protocol _binary_proto;
+        std::optional<bool> _is_binary; // engaged when the first byte of the first command arrived
         distributed<system_stats>& _system_stats;
         connection(connected_socket&& socket, socket_address addr, sharded_cache& c, distributed<system_stats>& system_stats)
             : _socket(std::move(socket))
@@ -1348,6 +2208,7 @@ private:
             , _in(_socket.input())
             , _out(_socket.output())
             , _proto(c, system_stats)
+            , _binary_proto(c, system_stats)
             , _system_stats(system_stats)
         {
             _system_stats.local()._curr_connections++;
@@ -1356,6 +2217,29 @@ private:
         ~connection() {
             _system_stats.local()._curr_connections--;
         }
+
+        bool should_close() {
+            return _in.eof() || _binary_proto.quit_requested();
+        }
+
+        // Dispatch one command: the fixed-header binary framing is told
+        // apart from ascii commands by the first byte of the connection.
+        future<> handle() {
+            if (_is_binary) {
+                return *_is_binary ? _binary_proto.handle(_in, _out) : _proto.handle(_in, _out);
+            }
+            return _in.read_exactly(1).then([this] (temporary_buffer<char> first) {
+                if (first.empty()) {
+                    return make_ready_future<>(); // eof
+                }
+                if (static_cast<uint8_t>(first[0]) == binary_protocol::request_magic) {
+                    _is_binary = true;
+                    return _binary_proto.handle_after_magic(_in, _out);
+                }
+                _is_binary = false;
+                return _proto.handle(std::move(first), _in, _out);
+            });
+        }
     };
 public:
     tcp_server(sharded_cache& cache, distributed<system_stats>& system_stats, uint16_t port = 11211)
@@ -1374,8 +2258,8 @@ public:
                 connected_socket fd = std::move(ar.connection);
                 socket_address addr = std::move(ar.remote_address);
                 auto conn = make_lw_shared<connection>(std::move(fd), addr, _cache, _system_stats);
-                (void)do_until([conn] { return conn->_in.eof(); }, [conn] {
-                    return conn->_proto.handle(conn->_in, conn->_out).then([conn] {
+                (void)do_until([conn] { return conn->should_close(); }, [conn] {
+                    return conn->handle().then([conn] {
                         return conn->_out.flush();
                     });
                 }).finally([conn] {
@@ -1444,6 +2328,14 @@ int main(int ac, char** av) {
              "Print basic statistics periodically (every second)")
         ("port", bpo::value<uint16_t>()->default_value(11211),
              "Specify UDP and TCP ports for memcached server to listen on")
+        ("extstore-path", bpo::value<std::string>()->default_value(""),
+             "Spill large evicted values to a log-structured file at this path (one file per shard; empty disables)")
+        ("extstore-size", bpo::value<uint64_t>()->default_value(1024),
+             "Per-shard capacity of the external store (value in megabytes)")
+        ("extstore-value-threshold", bpo::value<uint32_t>()->default_value(4096),
+             "Only values at least this big (in bytes) are spilled to the external store")
+        ("extstore-write-rate", bpo::value<uint64_t>()->default_value(64),
+             "Admission budget for spills (value in megabytes per second)")
         ;
 
     return app.run_deprecated(ac, av, [&] {
@@ -1456,7 +2348,23 @@ int main(int ac, char** av) {
         uint16_t port = config["port"].as<uint16_t>();
         uint64_t per_cpu_slab_size = config["max-slab-size"].as<uint64_t>() * MB;
         uint64_t slab_page_size = config["slab-page-size"].as<uint64_t>() * MB;
-        return cache_peers.start(std::move(per_cpu_slab_size), std::move(slab_page_size)).then([&system_stats] {
+        return cache_peers.start(std::move(per_cpu_slab_size), std::move(slab_page_size)).then([&] {
+            auto extstore_path = config["extstore-path"].as<std::string>();
+            if (extstore_path.empty()) {
+                return make_ready_future<>();
+            }
+            memcache::external_store::config cfg;
+            cfg.path = std::move(extstore_path);
+            cfg.total_size = config["extstore-size"].as<uint64_t>() * MB;
+            cfg.value_threshold = config["extstore-value-threshold"].as<uint32_t>();
+            cfg.write_rate = config["extstore-write-rate"].as<uint64_t>() * MB;
+            return cache_peers.invoke_on_all([cfg] (memcache::cache& c) {
+                auto shard_cfg = cfg;
+                // each shard appends to its own file.
+                shard_cfg.path = format("{}.{}", cfg.path, this_shard_id());
+                return c.start_external_store(std::move(shard_cfg));
+            });
+        }).then([&system_stats] {
             return system_stats.start(memcache::clock_type::now());
         }).then([&] {
             std::cout << PLATFORM << " memcached " << VERSION << "\n";
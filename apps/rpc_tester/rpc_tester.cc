@@ -0,0 +1,365 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB
+ */
+
+// Distributed RPC benchmark. Unlike tests/perf/rpc_perf.cc, which runs
+// everything in one process over loopback memory, this tool runs the server
+// and the client as separate processes (usually on separate machines), so
+// serialization, compression and the networking stack are all on the
+// measured path.
+//
+// Server:  rpc_tester --listen 0.0.0.0:9123 [--compress]
+// Client:  rpc_tester --server <addr>:9123 --workload echo|payload|stream
+//                     [--rps N] [--parallelism N] [--payload BYTES]
+//                     [--duration SECS] [--warmup SECS] [--compress]
+//
+// With --rps the client is open-loop: requests are scheduled at a fixed
+// arrival rate and latency is measured from the scheduled arrival time, so
+// a slow server accumulates queueing delay in the reported percentiles
+// instead of silently slowing the load down (no coordinated omission).
+// Without --rps the client is closed-loop with --parallelism requests in
+// flight per shard. Shards connect and prime their connection before any
+// of them starts loading, and the warmup window is excluded from the
+// reported histogram.
+
+#include <chrono>
+#include <random>
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/distributed.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/rpc/lz4_compressor.hh>
+#include <seastar/rpc/rpc.hh>
+#include <seastar/util/defer.hh>
+
+#include "../lib/latency_histogram.hh"
+#include "../lib/stop_signal.hh"
+
+using namespace seastar;
+using namespace std::chrono_literals;
+
+struct serializer {
+};
+
+template <typename T, typename Output>
+inline
+void write_arithmetic_type(Output& out, T v) {
+    static_assert(std::is_arithmetic<T>::value, "must be arithmetic type");
+    return out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T, typename Input>
+inline
+T read_arithmetic_type(Input& in) {
+    static_assert(std::is_arithmetic<T>::value, "must be arithmetic type");
+    T v;
+    in.read(reinterpret_cast<char*>(&v), sizeof(T));
+    return v;
+}
+
+template <typename Output>
+inline void write(serializer, Output& output, uint64_t v) { return write_arithmetic_type(output, v); }
+template <typename Input>
+inline uint64_t read(serializer, Input& input, rpc::type<uint64_t>) { return read_arithmetic_type<uint64_t>(input); }
+
+template <typename Output>
+inline void write(serializer, Output& out, const sstring& v) {
+    write_arithmetic_type(out, uint32_t(v.size()));
+    out.write(v.c_str(), v.size());
+}
+
+template <typename Input>
+inline sstring read(serializer, Input& in, rpc::type<sstring>) {
+    auto size = read_arithmetic_type<uint32_t>(in);
+    sstring ret = uninitialized_string(size);
+    in.read(ret.data(), size);
+    return ret;
+}
+
+using rpc_protocol = rpc::protocol<serializer>;
+
+enum class verb : uint32_t {
+    echo = 1,       // uint64_t (uint64_t)
+    payload = 2,    // uint64_t (sstring)
+    stream = 3,     // uint64_t (rpc::sink<sstring>)
+};
+
+static rpc::lz4_compressor::factory lz4_factory;
+
+struct client_config {
+    ipv4_addr server_addr;
+    sstring workload;
+    unsigned duration;
+    unsigned warmup;
+    unsigned rps;           // total target rate, 0 for closed loop
+    unsigned parallelism;   // max in-flight requests per shard
+    size_t payload_size;
+    unsigned stream_frames;
+    bool compress;
+};
+
+class rpc_tester_server {
+    rpc_protocol _proto;
+    std::unique_ptr<rpc_protocol::server> _server;
+public:
+    rpc_tester_server(ipv4_addr addr, bool compress)
+        : _proto(serializer{})
+    {
+        _proto.register_handler(uint32_t(verb::echo), [] (uint64_t v) {
+            return v;
+        });
+        _proto.register_handler(uint32_t(verb::payload), [] (sstring payload) {
+            return uint64_t(payload.size());
+        });
+        _proto.register_handler(uint32_t(verb::stream), [] (rpc::source<sstring> source) {
+            return do_with(uint64_t(0), std::move(source), [] (uint64_t& total, rpc::source<sstring>& source) {
+                return repeat([&total, &source] {
+                    return source().then([&total] (auto data) {
+                        if (!data) {
+                            return stop_iteration::yes;
+                        }
+                        total += std::get<0>(*data).size();
+                        return stop_iteration::no;
+                    });
+                }).then([&total] {
+                    return total;
+                });
+            });
+        });
+        rpc::server_options so;
+        if (compress) {
+            so.compressor_factory = &lz4_factory;
+        }
+        _server = std::make_unique<rpc_protocol::server>(_proto, so, addr, rpc::resource_limits());
+    }
+
+    future<> stop() {
+        return _server->stop();
+    }
+};
+
+class rpc_tester_client {
+    client_config _cfg;
+    rpc_protocol _proto;
+    std::unique_ptr<rpc_protocol::client> _client;
+    sstring _payload;
+    uint64_t _seq = 0;
+    semaphore _parallelism;
+    gate _requests;
+    seastar_apps_lib::latency_histogram _latencies;
+public:
+    rpc_tester_client(client_config cfg)
+        : _cfg(std::move(cfg))
+        , _proto(serializer{})
+        , _payload(uninitialized_string(_cfg.payload_size))
+        , _parallelism(_cfg.parallelism)
+    {
+        // incompressible by default; compression wins belong to a separate
+        // run with a crafted payload, not to every --compress measurement
+        auto seed = std::chrono::steady_clock::now().time_since_epoch().count();
+        std::default_random_engine eng(seed);
+        auto dist = std::uniform_int_distribution<char>();
+        std::generate(_payload.begin(), _payload.end(), [&] { return dist(eng); });
+        rpc::client_options co;
+        if (_cfg.compress) {
+            co.compressor_factory = &lz4_factory;
+        }
+        _client = std::make_unique<rpc_protocol::client>(_proto, co, _cfg.server_addr);
+    }
+
+    // Establish the connection and warm the path before any shard starts
+    // loading, so the measured window does not include connection setup.
+    future<> prime() {
+        auto echo = _proto.make_client<uint64_t (uint64_t)>(uint32_t(verb::echo));
+        return echo(*_client, 0).discard_result();
+    }
+
+    future<> run() {
+        return seastar::async([this] {
+            auto interval = _cfg.rps
+                ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                      std::chrono::duration<double>(double(smp::count) / _cfg.rps))
+                : std::chrono::steady_clock::duration(0);
+            auto start = std::chrono::steady_clock::now();
+            auto measure_from = start + std::chrono::seconds(_cfg.warmup);
+            auto end = measure_from + std::chrono::seconds(_cfg.duration);
+            auto next = start;
+            while (std::chrono::steady_clock::now() < end) {
+                if (_cfg.rps) {
+                    // open loop: the request is due at `next` whether or not
+                    // the server kept up, and is timed from that point
+                    auto now = std::chrono::steady_clock::now();
+                    if (next > now) {
+                        sleep(next - now).get();
+                    }
+                } else {
+                    next = std::chrono::steady_clock::now();
+                }
+                auto scheduled = next;
+                next += interval;
+                get_units(_parallelism, 1).get();
+                auto g = _requests.hold();
+                (void)issue().then_wrapped([this, scheduled, measure_from, g = std::move(g)] (future<> f) {
+                    _parallelism.signal();
+                    if (f.failed()) {
+                        fmt::print("request error: {}\n", f.get_exception());
+                        return;
+                    }
+                    auto now = std::chrono::steady_clock::now();
+                    if (scheduled >= measure_from) {
+                        _latencies.record(std::chrono::duration_cast<std::chrono::microseconds>(now - scheduled).count());
+                    }
+                });
+            }
+            _requests.close().get();
+        });
+    }
+
+    seastar_apps_lib::latency_histogram latencies() const {
+        return _latencies;
+    }
+
+    future<> stop() {
+        return _client->stop();
+    }
+
+private:
+    future<> issue() {
+        if (_cfg.workload == "echo") {
+            auto echo = _proto.make_client<uint64_t (uint64_t)>(uint32_t(verb::echo));
+            return echo(*_client, _seq++).discard_result();
+        } else if (_cfg.workload == "payload") {
+            auto payload = _proto.make_client<uint64_t (sstring)>(uint32_t(verb::payload));
+            return payload(*_client, _payload).discard_result();
+        } else {
+            return issue_stream();
+        }
+    }
+
+    future<> issue_stream() {
+        return _client->make_stream_sink<serializer, sstring>().then([this] (rpc::sink<sstring> sink) {
+            auto call = _proto.make_client<uint64_t (rpc::sink<sstring>)>(uint32_t(verb::stream));
+            auto done = call(*_client, sink);
+            return do_with(std::move(sink), [this] (rpc::sink<sstring>& sink) {
+                return do_until([this, n = _cfg.stream_frames] () mutable { return n-- == 0; }, [this, &sink] {
+                    return sink(_payload);
+                }).then([&sink] {
+                    return sink.flush();
+                }).finally([&sink] {
+                    return sink.close();
+                });
+            }).then([done = std::move(done)] () mutable {
+                return done.discard_result();
+            });
+        });
+    }
+};
+
+static future<int> run_server(ipv4_addr addr, bool compress) {
+    return seastar::async([addr, compress] {
+        seastar_apps_lib::stop_signal stop_signal;
+        distributed<rpc_tester_server> servers;
+        servers.start(addr, compress).get();
+        fmt::print("rpc_tester: serving on {}\n", addr);
+        stop_signal.wait().get();
+        servers.stop().get();
+        return 0;
+    });
+}
+
+static future<int> run_client(client_config cfg) {
+    return seastar::async([cfg = std::move(cfg)] {
+        distributed<rpc_tester_client> clients;
+        clients.start(cfg).get();
+        auto stop = defer([&clients] { clients.stop().get(); });
+
+        clients.invoke_on_all(&rpc_tester_client::prime).get();
+        auto started = std::chrono::steady_clock::now();
+        clients.invoke_on_all(&rpc_tester_client::run).get();
+        auto elapsed = std::chrono::steady_clock::now() - started;
+
+        auto latencies = clients.map_reduce0([] (const rpc_tester_client& c) { return c.latencies(); },
+                seastar_apps_lib::latency_histogram(),
+                [] (seastar_apps_lib::latency_histogram a, const seastar_apps_lib::latency_histogram& b) {
+                    a.merge(b);
+                    return a;
+                }).get0();
+
+        auto measured_secs = std::chrono::duration<double>(elapsed).count() - cfg.warmup;
+        fmt::print("workload: {}{}\n", cfg.workload, cfg.compress ? " (compressed)" : "");
+        fmt::print("requests: {}\n", latencies.count());
+        fmt::print("achieved rps: {:.0f}\n", latencies.count() / measured_secs);
+        fmt::print("latency (usec): mean {} p50 {} p95 {} p99 {} p999 {} max {}\n",
+                latencies.mean(), latencies.quantile(0.5), latencies.quantile(0.95),
+                latencies.quantile(0.99), latencies.quantile(0.999), latencies.max());
+        return 0;
+    });
+}
+
+namespace bpo = boost::program_options;
+
+int main(int ac, char** av) {
+    app_template app;
+
+    app.add_options()
+        ("listen", bpo::value<std::string>(), "run as a server, listening on this address")
+        ("server", bpo::value<std::string>(), "run as a client against this server address")
+        ("workload", bpo::value<std::string>()->default_value("echo"), "echo (small calls), payload or stream")
+        ("duration", bpo::value<unsigned>()->default_value(10), "measured duration, in seconds")
+        ("warmup", bpo::value<unsigned>()->default_value(2), "warmup window excluded from results, in seconds")
+        ("rps", bpo::value<unsigned>()->default_value(0), "open-loop arrival rate, 0 for closed loop")
+        ("parallelism", bpo::value<unsigned>()->default_value(100), "max in-flight requests per shard")
+        ("payload", bpo::value<size_t>()->default_value(4096), "payload size for payload/stream workloads, in bytes")
+        ("stream-frames", bpo::value<unsigned>()->default_value(64), "frames sent per stream request")
+        ("compress", "negotiate LZ4 compression");
+
+    return app.run(ac, av, [&app] () -> future<int> {
+        auto& config = app.configuration();
+        auto compress = config.count("compress") != 0;
+
+        if (config.count("listen")) {
+            return run_server(ipv4_addr{config["listen"].as<std::string>()}, compress);
+        }
+        if (!config.count("server")) {
+            fmt::print("Error: either --listen or --server is required\n");
+            return make_ready_future<int>(1);
+        }
+
+        client_config cfg;
+        cfg.server_addr = ipv4_addr{config["server"].as<std::string>()};
+        cfg.workload = config["workload"].as<std::string>();
+        cfg.duration = config["duration"].as<unsigned>();
+        cfg.warmup = config["warmup"].as<unsigned>();
+        cfg.rps = config["rps"].as<unsigned>();
+        cfg.parallelism = config["parallelism"].as<unsigned>();
+        cfg.payload_size = config["payload"].as<size_t>();
+        cfg.stream_frames = config["stream-frames"].as<unsigned>();
+        cfg.compress = compress;
+        if (cfg.workload != "echo" && cfg.workload != "payload" && cfg.workload != "stream") {
+            fmt::print("Error: unknown workload '{}'\n", cfg.workload);
+            return make_ready_future<int>(1);
+        }
+        return run_client(std::move(cfg));
+    });
+}
@@ -19,213 +19,385 @@
  * Copyright (C) 2015 Cloudius Systems, Ltd.
  */
 
+// HTTP load generator.
+//
+//   seawreck --server <addr>:<port> [--conn N] [--rps N]
+//            [--duration SECS] [--warmup SECS] [--reqs-per-conn N]
+//            [--script FILE] [--tls] [--cacert PEM]
+//
+// With --rps requests are scheduled open-loop at the given aggregate
+// arrival rate; latency is taken from the scheduled send time, so when
+// the server falls behind the queueing delay lands in the percentiles
+// rather than quietly throttling the generator. Without --rps the run
+// is closed-loop with --conn requests in flight.
+//
+// --reqs-per-conn N retires each connection after N requests and dials
+// a fresh one, to exercise accept/handshake churn; 0 keeps connections
+// alive for the whole run.
+//
+// --script FILE picks each request from a weighted mix, one entry per
+// line: "<weight> <method> <path>" (weight may be omitted and defaults
+// to 1; blank lines and lines starting with # are skipped). The default
+// mix is "GET /".
+//
+// Responses must be Content-Length delimited; a response without one is
+// read to connection close and that connection is retired.
+
 #include <seastar/http/response_parser.hh>
 #include <seastar/net/api.hh>
+#include <seastar/net/tls.hh>
 #include <seastar/core/seastar.hh>
-#include <seastar/core/print.hh>
 #include <seastar/core/app-template.hh>
 #include <seastar/core/distributed.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/defer.hh>
+#include "../lib/latency_histogram.hh"
 #include <chrono>
+#include <fstream>
+#include <random>
+#include <sstream>
 
 using namespace seastar;
 
-template <typename... Args>
-void http_debug(const char* fmt, Args&&... args) {
-#if HTTP_DEBUG
-    print(fmt, std::forward<Args>(args)...);
-#endif
-}
+struct request_spec {
+    double weight;
+    sstring method;
+    sstring path;
+};
+
+struct client_config {
+    std::string server;     // host:port, also the Host header value
+    unsigned duration;
+    unsigned warmup;
+    unsigned rps;           // total target rate, 0 for closed loop
+    unsigned conn_per_core;
+    unsigned reqs_per_conn; // retire a connection after this many, 0 for never
+    std::vector<request_spec> specs;
+    bool tls;
+    sstring cacert;         // trust file for --tls, empty for system trust
+};
 
 class http_client {
+public:
+    class connection;
 private:
-    unsigned _duration;
-    unsigned _conn_per_core;
-    unsigned _reqs_per_conn;
-    std::vector<connected_socket> _sockets;
-    semaphore _conn_connected{0};
-    semaphore _conn_finished{0};
-    timer<> _run_timer;
-    bool _timer_based;
-    bool _timer_done{false};
-    uint64_t _total_reqs{0};
+    client_config _cfg;
+    socket_address _addr;
+    sstring _tls_host;      // server name for certificate validation
+    shared_ptr<tls::certificate_credentials> _creds;
+    std::vector<sstring> _texts;
+    std::discrete_distribution<unsigned> _pick;
+    std::default_random_engine _eng;
+    std::vector<std::unique_ptr<connection>> _idle;
+    unsigned _open = 0;
+    semaphore _parallelism;
+    gate _requests;
+    seastar_apps_lib::latency_histogram _latencies;
+    uint64_t _errors = 0;
 public:
-    http_client(unsigned duration, unsigned total_conn, unsigned reqs_per_conn)
-        : _duration(duration)
-        , _conn_per_core(total_conn / smp::count)
-        , _reqs_per_conn(reqs_per_conn)
-        , _run_timer([this] { _timer_done = true; })
-        , _timer_based(reqs_per_conn == 0) {
-    }
-
     class connection {
-    private:
         connected_socket _fd;
         input_stream<char> _read_buf;
         output_stream<char> _write_buf;
         http_response_parser _parser;
-        http_client* _http_client;
-        uint64_t _nr_done{0};
+        uint64_t _nr_done = 0;
+        bool _reusable = true;
     public:
-        connection(connected_socket&& fd, http_client* client)
+        explicit connection(connected_socket&& fd)
             : _fd(std::move(fd))
             , _read_buf(_fd.input())
-            , _write_buf(_fd.output())
-            , _http_client(client){
+            , _write_buf(_fd.output()) {
         }
 
-        uint64_t nr_done() {
+        uint64_t nr_done() const {
             return _nr_done;
         }
 
-        future<> do_req() {
-            return _write_buf.write("GET / HTTP/1.1\r\nHost: 127.0.0.1:10000\r\n\r\n").then([this] {
+        bool reusable() const {
+            return _reusable;
+        }
+
+        future<> do_req(const sstring& text) {
+            return _write_buf.write(text.data(), text.size()).then([this] {
                 return _write_buf.flush();
             }).then([this] {
                 _parser.init();
-                return _read_buf.consume(_parser).then([this] {
-                    // Read HTTP response header first
-                    if (_parser.eof()) {
-                        return make_ready_future<>();
-                    }
-                    auto _rsp = _parser.get_parsed_response();
-                    auto it = _rsp->_headers.find("Content-Length");
-                    if (it == _rsp->_headers.end()) {
-                        fmt::print("Error: HTTP response does not contain: Content-Length\n");
-                        return make_ready_future<>();
-                    }
-                    auto content_len = std::stoi(it->second);
-                    http_debug("Content-Length = %d\n", content_len);
-                    // Read HTTP response body
-                    return _read_buf.read_exactly(content_len).then([this] (temporary_buffer<char> buf) {
+                return _read_buf.consume(_parser);
+            }).then([this] {
+                if (_parser.eof()) {
+                    _reusable = false;
+                    return make_exception_future<>(std::runtime_error("server closed connection"));
+                }
+                auto rsp = _parser.get_parsed_response();
+                auto conn = rsp->_headers.find("Connection");
+                if (conn != rsp->_headers.end() && conn->second == "close") {
+                    _reusable = false;
+                }
+                auto it = rsp->_headers.find("Content-Length");
+                if (it == rsp->_headers.end()) {
+                    // read to connection close, the only other framing we know
+                    _reusable = false;
+                    return do_until([this] { return _read_buf.eof(); }, [this] {
+                        return _read_buf.read().discard_result();
+                    }).then([this] {
                         _nr_done++;
-                        http_debug("%s\n", buf.get());
-                        if (_http_client->done(_nr_done)) {
-                            return make_ready_future();
-                        } else {
-                            return do_req();
-                        }
                     });
+                }
+                return _read_buf.read_exactly(std::stoi(it->second)).then([this] (temporary_buffer<char>) {
+                    _nr_done++;
                 });
             });
         }
-    };
 
-    future<uint64_t> total_reqs() {
-        fmt::print("Requests on cpu {:2d}: {:d}\n", this_shard_id(), _total_reqs);
-        return make_ready_future<uint64_t>(_total_reqs);
-    }
+        future<> close() {
+            return _write_buf.close();
+        }
+    };
 
-    bool done(uint64_t nr_done) {
-        if (_timer_based) {
-            return _timer_done;
-        } else {
-            return nr_done >= _reqs_per_conn;
+    explicit http_client(client_config cfg)
+        : _cfg(std::move(cfg))
+        , _addr(ipv4_addr(_cfg.server))
+        , _tls_host(_cfg.server.substr(0, _cfg.server.find(':')))
+        , _parallelism(_cfg.conn_per_core)
+        , _eng(std::chrono::steady_clock::now().time_since_epoch().count() + this_shard_id())
+    {
+        std::vector<double> weights;
+        for (auto& spec : _cfg.specs) {
+            _texts.push_back(spec.method + " " + spec.path + " HTTP/1.1\r\nHost: " + _cfg.server + "\r\n\r\n");
+            weights.push_back(spec.weight);
         }
+        _pick = std::discrete_distribution<unsigned>(weights.begin(), weights.end());
     }
 
-    future<> connect(ipv4_addr server_addr) {
-        // Establish all the TCP connections first
-        for (unsigned i = 0; i < _conn_per_core; i++) {
-            // Connect in the background, signal _conn_connected when done.
-            (void)seastar::connect(make_ipv4_address(server_addr)).then([this] (connected_socket fd) {
-                _sockets.push_back(std::move(fd));
-                http_debug("Established connection %6d on cpu %3d\n", _conn_connected.current(), this_shard_id());
-                _conn_connected.signal();
-            }).or_terminate();
-        }
-        return _conn_connected.wait(_conn_per_core);
+    // Build credentials and dial every connection before any shard starts
+    // loading, so the measured window starts with the pool warm.
+    future<> prime() {
+        return seastar::async([this] {
+            if (_cfg.tls) {
+                _creds = ::make_shared<tls::certificate_credentials>();
+                if (_cfg.cacert.empty()) {
+                    _creds->set_system_trust().get();
+                } else {
+                    _creds->set_x509_trust_file(_cfg.cacert, tls::x509_crt_format::PEM).get();
+                }
+            }
+            for (unsigned i = 0; i < _cfg.conn_per_core; i++) {
+                _idle.push_back(make_connection().get0());
+                _open++;
+            }
+        });
     }
 
     future<> run() {
-        // All connected, start HTTP request
-        http_debug("Established all %6d tcp connections on cpu %3d\n", _conn_per_core, this_shard_id());
-        if (_timer_based) {
-            _run_timer.arm(std::chrono::seconds(_duration));
-        }
-        for (auto&& fd : _sockets) {
-            auto conn = new connection(std::move(fd), this);
-            // Run in the background, signal _conn_finished when done.
-            (void)conn->do_req().then_wrapped([this, conn] (auto&& f) {
-                http_debug("Finished connection %6d on cpu %3d\n", _conn_finished.current(), this_shard_id());
-                _total_reqs += conn->nr_done();
-                _conn_finished.signal();
-                delete conn;
-                // FIXME: should _conn_finished.signal be called only after this?
-                // nothing seems to synchronize with this background work.
-                try {
-                    f.get();
-                } catch (std::exception& ex) {
-                    fmt::print("http request error: {}\n", ex.what());
+        return seastar::async([this] {
+            auto interval = _cfg.rps
+                ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                      std::chrono::duration<double>(double(smp::count) / _cfg.rps))
+                : std::chrono::steady_clock::duration(0);
+            auto start = std::chrono::steady_clock::now();
+            auto measure_from = start + std::chrono::seconds(_cfg.warmup);
+            auto end = measure_from + std::chrono::seconds(_cfg.duration);
+            auto next = start;
+            while (std::chrono::steady_clock::now() < end) {
+                if (_cfg.rps) {
+                    auto now = std::chrono::steady_clock::now();
+                    if (next > now) {
+                        sleep(next - now).get();
+                    }
+                } else {
+                    next = std::chrono::steady_clock::now();
                 }
-            });
-        }
+                auto scheduled = next;
+                next += interval;
+                get_units(_parallelism, 1).get();
+                auto g = _requests.hold();
+                (void)issue().then_wrapped([this, scheduled, measure_from, g = std::move(g)] (future<> f) {
+                    _parallelism.signal();
+                    if (f.failed()) {
+                        f.ignore_ready_future();
+                        _errors++;
+                        return;
+                    }
+                    auto now = std::chrono::steady_clock::now();
+                    if (scheduled >= measure_from) {
+                        _latencies.record(std::chrono::duration_cast<std::chrono::microseconds>(now - scheduled).count());
+                    }
+                });
+            }
+            _requests.close().get();
+        });
+    }
 
-        // All finished
-        return _conn_finished.wait(_conn_per_core);
+    seastar_apps_lib::latency_histogram latencies() const {
+        return _latencies;
     }
+
+    future<uint64_t> errors() {
+        return make_ready_future<uint64_t>(_errors);
+    }
+
     future<> stop() {
-        return make_ready_future();
+        return do_for_each(_idle, [] (std::unique_ptr<connection>& con) {
+            return con->close();
+        }).then([this] {
+            _idle.clear();
+        });
+    }
+
+private:
+    future<std::unique_ptr<connection>> make_connection() {
+        auto fd = _cfg.tls
+            ? tls::connect(_creds, _addr, _tls_host)
+            : seastar::connect(_addr);
+        return fd.then([] (connected_socket fd) {
+            return std::make_unique<connection>(std::move(fd));
+        });
+    }
+
+    future<> issue() {
+        const sstring& text = _texts[_pick(_eng)];
+        return get_connection().then([this, &text] (std::unique_ptr<connection> con) {
+            auto c = con.get();
+            return c->do_req(text).then_wrapped([this, con = std::move(con)] (future<> f) mutable {
+                bool churn = _cfg.reqs_per_conn && con->nr_done() >= _cfg.reqs_per_conn;
+                if (!f.failed() && con->reusable() && !churn) {
+                    _idle.push_back(std::move(con));
+                } else {
+                    // retire it; the next request dials a replacement
+                    --_open;
+                    auto c = con.get();
+                    (void)c->close().then_wrapped([con = std::move(con)] (future<> f) {
+                        f.ignore_ready_future();
+                    });
+                }
+                return f;
+            });
+        });
+    }
+
+    future<std::unique_ptr<connection>> get_connection() {
+        // _parallelism caps borrowers at the pool size, so when the idle
+        // list is empty a slot for a new connection is always available
+        if (!_idle.empty()) {
+            auto con = std::move(_idle.back());
+            _idle.pop_back();
+            return make_ready_future<std::unique_ptr<connection>>(std::move(con));
+        }
+        ++_open;
+        return make_connection().handle_exception([this] (std::exception_ptr ex) {
+            --_open;
+            return make_exception_future<std::unique_ptr<connection>>(std::move(ex));
+        });
     }
 };
 
+static std::vector<request_spec> parse_script(const std::string& path) {
+    std::vector<request_spec> specs;
+    std::ifstream f(path);
+    if (!f) {
+        throw std::runtime_error("cannot open script file: " + path);
+    }
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream parts(line);
+        double weight = 1;
+        std::string method, url;
+        // the weight is optional; a line may start with the method
+        if (isdigit(line[0])) {
+            parts >> weight;
+        }
+        if (!(parts >> method >> url) || weight <= 0) {
+            throw std::runtime_error("bad script line: " + line);
+        }
+        specs.push_back(request_spec{weight, sstring(method), sstring(url)});
+    }
+    if (specs.empty()) {
+        throw std::runtime_error("script file has no requests: " + path);
+    }
+    return specs;
+}
+
 namespace bpo = boost::program_options;
 
 int main(int ac, char** av) {
-    app_template::config app_cfg;
-    app_cfg.auto_handle_sigint_sigterm = false;
-    app_template app(std::move(app_cfg));
+    app_template app;
 
     app.add_options()
-        ("server,s", bpo::value<std::string>()->default_value("192.168.66.100:10000"), "Server address")
+        ("server,s", bpo::value<std::string>()->default_value("192.168.66.100:10000"), "server address")
         ("conn,c", bpo::value<unsigned>()->default_value(100), "total connections")
-        ("reqs,r", bpo::value<unsigned>()->default_value(0), "reqs per connection")
-        ("duration,d", bpo::value<unsigned>()->default_value(10), "duration of the test in seconds)");
+        ("rps", bpo::value<unsigned>()->default_value(0), "open-loop arrival rate, 0 for closed loop")
+        ("duration,d", bpo::value<unsigned>()->default_value(10), "measured duration, in seconds")
+        ("warmup", bpo::value<unsigned>()->default_value(2), "warmup window excluded from results, in seconds")
+        ("reqs-per-conn,r", bpo::value<unsigned>()->default_value(0), "reconnect after this many requests on a connection, 0 to keep connections")
+        ("script", bpo::value<std::string>(), "file with a weighted request mix, default is GET /")
+        ("tls", "connect over TLS")
+        ("cacert", bpo::value<std::string>()->default_value(""), "trust certificates from this PEM file instead of the system trust");
 
     return app.run(ac, av, [&app] () -> future<int> {
-        auto& config = app.configuration();
-        auto server = config["server"].as<std::string>();
-        auto reqs_per_conn = config["reqs"].as<unsigned>();
-        auto total_conn= config["conn"].as<unsigned>();
-        auto duration = config["duration"].as<unsigned>();
-
-        if (total_conn % smp::count != 0) {
-            fmt::print("Error: conn needs to be n * cpu_nr\n");
-            return make_ready_future<int>(-1);
-        }
+        return seastar::async([&app] {
+            auto& config = app.configuration();
+            client_config cfg;
+            cfg.server = config["server"].as<std::string>();
+            cfg.duration = config["duration"].as<unsigned>();
+            cfg.warmup = config["warmup"].as<unsigned>();
+            cfg.rps = config["rps"].as<unsigned>();
+            cfg.reqs_per_conn = config["reqs-per-conn"].as<unsigned>();
+            cfg.tls = config.count("tls");
+            cfg.cacert = config["cacert"].as<std::string>();
+            auto total_conn = config["conn"].as<unsigned>();
+            if (total_conn % smp::count != 0) {
+                fmt::print("Error: conn needs to be n * cpu_nr\n");
+                return -1;
+            }
+            cfg.conn_per_core = total_conn / smp::count;
+            if (config.count("script")) {
+                cfg.specs = parse_script(config["script"].as<std::string>());
+            } else {
+                cfg.specs.push_back(request_spec{1, "GET", "/"});
+            }
+
+            distributed<http_client> clients;
+            clients.start(cfg).get();
+            auto stop = defer([&clients] () noexcept { clients.stop().get(); });
+
+            fmt::print("========== seawreck ============\n");
+            fmt::print("Server: {}{}\n", cfg.server, cfg.tls ? " (TLS)" : "");
+            fmt::print("Connections: {:d}{}\n", total_conn,
+                    cfg.reqs_per_conn ? fmt::format(", retired every {} requests", cfg.reqs_per_conn) : std::string());
+            fmt::print("Load: {}\n", cfg.rps ? fmt::format("open loop, {} req/s", cfg.rps) : std::string("closed loop"));
+
+            clients.invoke_on_all(&http_client::prime).get();
+            auto started = std::chrono::steady_clock::now();
+            clients.invoke_on_all(&http_client::run).get();
+            auto elapsed = std::chrono::steady_clock::now() - started;
+
+            auto latencies = clients.map_reduce0([] (const http_client& c) { return c.latencies(); },
+                    seastar_apps_lib::latency_histogram(),
+                    [] (seastar_apps_lib::latency_histogram a, const seastar_apps_lib::latency_histogram& b) {
+                        a.merge(b);
+                        return a;
+                    }).get0();
+            auto errors = clients.map_reduce(adder<uint64_t>(), &http_client::errors).get0();
 
-        auto http_clients = new distributed<http_client>;
-
-        // Start http requests on all the cores
-        auto started = steady_clock_type::now();
-        fmt::print("========== http_client ============\n");
-        fmt::print("Server: {}\n", server);
-        fmt::print("Connections: {:d}\n", total_conn);
-        fmt::print("Requests/connection: {}\n", reqs_per_conn == 0 ? "dynamic (timer based)" : std::to_string(reqs_per_conn));
-        return http_clients->start(std::move(duration), std::move(total_conn), std::move(reqs_per_conn)).then([http_clients, server] {
-            return http_clients->invoke_on_all(&http_client::connect, ipv4_addr{server});
-        }).then([http_clients] {
-            return http_clients->invoke_on_all(&http_client::run);
-        }).then([http_clients] {
-            return http_clients->map_reduce(adder<uint64_t>(), &http_client::total_reqs);
-        }).then([http_clients, started] (auto total_reqs) {
-           // All the http requests are finished
-           auto finished = steady_clock_type::now();
-           auto elapsed = finished - started;
-           auto secs = static_cast<double>(elapsed.count() / 1000000000.0);
-           fmt::print("Total cpus: {:d}\n", smp::count);
-           fmt::print("Total requests: {:d}\n", total_reqs);
-           fmt::print("Total time: {:f}\n", secs);
-           fmt::print("Requests/sec: {:f}\n", static_cast<double>(total_reqs) / secs);
-           fmt::print("==========     done     ============\n");
-           return http_clients->stop().then([http_clients] {
-               // FIXME: If we call engine().exit(0) here to exit when
-               // requests are done. The tcp connection will not be closed
-               // properly, becasue we exit too earily and the FIN packets are
-               // not exchanged.
-                delete http_clients;
-                return make_ready_future<int>(0);
-           });
+            auto measured_secs = std::chrono::duration<double>(elapsed).count() - cfg.warmup;
+            fmt::print("Total cpus: {:d}\n", smp::count);
+            fmt::print("Total requests: {:d}\n", latencies.count());
+            if (errors) {
+                fmt::print("Errors: {:d}\n", errors);
+            }
+            fmt::print("Requests/sec: {:.0f}\n", latencies.count() / measured_secs);
+            fmt::print("Latency (usec): mean {} p50 {} p95 {} p99 {} p999 {} max {}\n",
+                    latencies.mean(), latencies.quantile(0.5), latencies.quantile(0.95),
+                    latencies.quantile(0.99), latencies.quantile(0.999), latencies.max());
+            fmt::print("==========   done   ============\n");
+            return 0;
         });
     });
 }
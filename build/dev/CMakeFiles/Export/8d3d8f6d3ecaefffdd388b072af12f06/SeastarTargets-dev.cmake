@@ -0,0 +1,39 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Dev".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "Seastar::seastar" for configuration "Dev"
+set_property(TARGET Seastar::seastar APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Seastar::seastar PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEV "CXX"
+  IMPORTED_LOCATION_DEV "${_IMPORT_PREFIX}/lib/libseastar.a"
+  )
+
+list(APPEND _cmake_import_check_targets Seastar::seastar )
+list(APPEND _cmake_import_check_files_for_Seastar::seastar "${_IMPORT_PREFIX}/lib/libseastar.a" )
+
+# Import target "Seastar::seastar_testing" for configuration "Dev"
+set_property(TARGET Seastar::seastar_testing APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Seastar::seastar_testing PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEV "CXX"
+  IMPORTED_LOCATION_DEV "${_IMPORT_PREFIX}/lib/libseastar_testing.a"
+  )
+
+list(APPEND _cmake_import_check_targets Seastar::seastar_testing )
+list(APPEND _cmake_import_check_files_for_Seastar::seastar_testing "${_IMPORT_PREFIX}/lib/libseastar_testing.a" )
+
+# Import target "Seastar::seastar_perf_testing" for configuration "Dev"
+set_property(TARGET Seastar::seastar_perf_testing APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Seastar::seastar_perf_testing PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEV "CXX"
+  IMPORTED_LOCATION_DEV "${_IMPORT_PREFIX}/lib/libseastar_perf_testing.a"
+  )
+
+list(APPEND _cmake_import_check_targets Seastar::seastar_perf_testing )
+list(APPEND _cmake_import_check_files_for_Seastar::seastar_perf_testing "${_IMPORT_PREFIX}/lib/libseastar_perf_testing.a" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
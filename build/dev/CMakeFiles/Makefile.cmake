@@ -0,0 +1,395 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/miniconda/lib/cmake/fmt/fmt-config-version.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-config.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-targets-release.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-targets.cmake"
+  "/root/repo/CMakeLists.txt"
+  "/root/repo/apps/CMakeLists.txt"
+  "/root/repo/apps/httpd/CMakeLists.txt"
+  "/root/repo/apps/io_tester/CMakeLists.txt"
+  "/root/repo/apps/iotune/CMakeLists.txt"
+  "/root/repo/apps/memcached/CMakeLists.txt"
+  "/root/repo/apps/memcached/tests/CMakeLists.txt"
+  "/root/repo/apps/rpc_tester/CMakeLists.txt"
+  "/root/repo/apps/seawreck/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "pkgconfig/seastar-install.pc.in"
+  "pkgconfig/seastar-testing-install.pc.in"
+  "pkgconfig/seastar-testing.pc.in"
+  "pkgconfig/seastar.pc.in"
+  "/root/repo/cmake/FindConcepts.cmake"
+  "/root/repo/cmake/FindGnuTLS.cmake"
+  "/root/repo/cmake/FindLinuxMembarrier.cmake"
+  "/root/repo/cmake/FindProtobuf.cmake"
+  "/root/repo/cmake/FindPthreadSetName.cmake"
+  "/root/repo/cmake/FindSanitizers.cmake"
+  "/root/repo/cmake/FindStdAtomic.cmake"
+  "/root/repo/cmake/Findc-ares.cmake"
+  "/root/repo/cmake/Findcryptopp.cmake"
+  "/root/repo/cmake/Finddpdk.cmake"
+  "/root/repo/cmake/Findhwloc.cmake"
+  "/root/repo/cmake/Findlksctp-tools.cmake"
+  "/root/repo/cmake/Findlz4.cmake"
+  "/root/repo/cmake/Findnumactl.cmake"
+  "/root/repo/cmake/Findragel.cmake"
+  "/root/repo/cmake/Findrt.cmake"
+  "/root/repo/cmake/Findyaml-cpp.cmake"
+  "/root/repo/cmake/Findzstd.cmake"
+  "/root/repo/cmake/SeastarConfig.cmake.in"
+  "/root/repo/cmake/SeastarDependencies.cmake"
+  "/root/repo/cmake/code_tests/rt_test.cc"
+  "/root/repo/demos/CMakeLists.txt"
+  "/root/repo/doc/CMakeLists.txt"
+  "/root/repo/doc/Doxyfile.in"
+  "/root/repo/doc/DoxygenLayout.xml"
+  "/root/repo/pkgconfig/seastar-testing.pc.in"
+  "/root/repo/pkgconfig/seastar.pc.in"
+  "/root/repo/tests/CMakeLists.txt"
+  "/root/repo/tests/perf/CMakeLists.txt"
+  "/root/repo/tests/unit/CMakeLists.txt"
+  "/root/repo/tests/unit/cert.cfg.in"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-ExactVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePushCheckState.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CPack.cmake"
+  "/usr/share/cmake-3.25/Modules/CPackComponent.cmake"
+  "/usr/share/cmake-3.25/Modules/CTest.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestUseLaunchers.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckSymbolExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/DartConfiguration.tcl.in"
+  "/usr/share/cmake-3.25/Modules/FindBoost.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/SelectLibraryConfigurations.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  "/usr/share/cmake-3.25/Templates/CPackConfig.cmake.in"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "DartConfiguration.tcl"
+  "pkgconfig/seastar-install.pc.in"
+  "pkgconfig/seastar-testing-install.pc.in"
+  "pkgconfig/seastar.pc.in"
+  "pkgconfig/seastar-testing.pc.in"
+  "SeastarConfigVersion.cmake"
+  "SeastarConfig.cmake"
+  "CPackConfig.cmake"
+  "CPackSourceConfig.cmake"
+  "seastar.pc"
+  "seastar-testing.pc"
+  "seastar-install.pc"
+  "seastar-testing-install.pc"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/perf/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/unit/test.cfg"
+  "tests/unit/other.cfg"
+  "tests/unit/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "doc/Doxyfile"
+  "doc/DoxygenLayout.xml"
+  "doc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/httpd/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/io_tester/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/iotune/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/memcached/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/memcached/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/rpc_tester/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/seawreck/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/seastar_http_chunk_parsers.dir/DependInfo.cmake"
+  "CMakeFiles/seastar_http_request_parser.dir/DependInfo.cmake"
+  "CMakeFiles/seastar_http_response_parser.dir/DependInfo.cmake"
+  "CMakeFiles/seastar_proto_metrics2.dir/DependInfo.cmake"
+  "CMakeFiles/seastar.dir/DependInfo.cmake"
+  "CMakeFiles/Experimental.dir/DependInfo.cmake"
+  "CMakeFiles/Nightly.dir/DependInfo.cmake"
+  "CMakeFiles/Continuous.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyMemoryCheck.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyStart.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyUpdate.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyConfigure.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyBuild.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyTest.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyCoverage.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyMemCheck.dir/DependInfo.cmake"
+  "CMakeFiles/NightlySubmit.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalStart.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalUpdate.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalConfigure.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalBuild.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalTest.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalCoverage.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalMemCheck.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalSubmit.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousStart.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousUpdate.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousConfigure.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousBuild.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousTest.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousCoverage.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousMemCheck.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousSubmit.dir/DependInfo.cmake"
+  "CMakeFiles/seastar_testing.dir/DependInfo.cmake"
+  "CMakeFiles/seastar_perf_testing.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/perf_tests.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_allocator.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_checksum.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_coroutine.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_fstream.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_fair_queue.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_flat_btree.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_future_util.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_http.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_rpc.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_smp.dir/DependInfo.cmake"
+  "tests/perf/CMakeFiles/test_perf_tcp.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/unit_tests.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_abort_source.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_abort_source_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_alloc.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_alloc_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_allocator.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_allocator_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_alien.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_alien_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_arena.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_arena_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_cpu_profiler.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_cpu_profiler_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_checked_ptr.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_checked_ptr_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_chunked_fifo.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_chunked_fifo_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_chunked_vector.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_chunked_vector_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_chunk_parsers.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_chunk_parsers_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_circular_buffer.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_circular_buffer_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_circular_buffer_fixed_capacity.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_circular_buffer_fixed_capacity_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_connect.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_connect_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_content_source.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_content_source_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_coroutines.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_coroutines_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_defer.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_defer_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_deleter.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_deleter_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_directory.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_directory_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_distributed.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_distributed_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_dns.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_dns_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_execution_stage.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_execution_stage_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_expiring_fifo.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_expiring_fifo_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_flat_btree.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_flat_btree_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_io_queue.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_io_queue_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_egress.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_egress_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_fair_queue.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_fair_queue_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_file_io.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_file_io_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_file_utils.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_file_utils_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_foreign_ptr.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_foreign_ptr_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_fsnotifier.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_fsnotifier_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_fstream.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_fstream_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_futures.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_futures_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_sharded.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_sharded_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_shared_snapshot.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_shared_snapshot_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_httpd.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_httpd_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_ipv6.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_ipv6_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_network_interface.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_network_interface_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_json_formatter.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_json_formatter_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_json_parser.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_json_parser_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_locking.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_locking_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_lowres_clock.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_lowres_clock_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_metrics.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_metrics_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_net_config.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_net_config_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_noncopyable_function.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_noncopyable_function_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_output_stream.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_output_stream_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_packet.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_packet_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_program_options.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_program_options_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_queue.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_queue_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_request_parser.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_request_parser_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_rpc.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_rpc_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_rx_buffer_pool.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_rx_buffer_pool_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_semaphore.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_semaphore_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_shared_ptr.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_shared_ptr_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_shm_stack.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_shm_stack_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_signal.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_signal_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_simple_stream.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_simple_stream_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_smp.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_smp_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_socket.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_socket_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_spsc_channel.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_spsc_channel_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_sstring.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_sstring_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_stall_detector.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_stall_detector_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_stream_reader.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_stream_reader_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_task_pool.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_task_pool_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_thread.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_thread_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_tracer.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_tracer_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_tsc_clock.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_tsc_clock_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_scheduling_group.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_scheduling_group_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_thread_context_switch.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_thread_context_switch_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_timer.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_timer_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_timer_set.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_timer_set_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_timer_wheel.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_timer_wheel_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_uname.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_uname_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/testcrt.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/othercrt.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/tls_files.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_tls.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_tls_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_tuple_utils.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_tuple_utils_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_unix_domain.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_unix_domain_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_unwind.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_unwind_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_weak_ptr.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_weak_ptr_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_work_stealing.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_work_stealing_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_log.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_log_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_log_buf.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_log_buf_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_exception_logging.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_exception_logging_run.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_closeable.dir/DependInfo.cmake"
+  "tests/unit/CMakeFiles/test_unit_closeable_run.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demos.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_block_discard.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_coroutines.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_echo.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_ip.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_line_count.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_l3.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_rpc.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_scheduling_group.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_tcp.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_tcp_sctp_client.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_tcp_sctp_server.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_tls_echo_server.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_tls_simple_client.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_udp_client.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_udp_server.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_udp_zero_copy.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_sharded_parameter.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_file.dir/DependInfo.cmake"
+  "demos/CMakeFiles/demo_tutorial_examples.dir/DependInfo.cmake"
+  "doc/CMakeFiles/doc_api.dir/DependInfo.cmake"
+  "doc/CMakeFiles/doc_tutorial_html.dir/DependInfo.cmake"
+  "doc/CMakeFiles/doc_tutorial_html_split.dir/DependInfo.cmake"
+  "doc/CMakeFiles/doc_tutorial_pdf.dir/DependInfo.cmake"
+  "doc/CMakeFiles/docs.dir/DependInfo.cmake"
+  "apps/CMakeFiles/apps.dir/DependInfo.cmake"
+  "apps/httpd/CMakeFiles/app_httpd_swagger.dir/DependInfo.cmake"
+  "apps/httpd/CMakeFiles/app_httpd.dir/DependInfo.cmake"
+  "apps/io_tester/CMakeFiles/app_io_tester.dir/DependInfo.cmake"
+  "apps/iotune/CMakeFiles/app_iotune.dir/DependInfo.cmake"
+  "apps/memcached/CMakeFiles/app_memcached_ascii.dir/DependInfo.cmake"
+  "apps/memcached/CMakeFiles/app_memcached.dir/DependInfo.cmake"
+  "apps/memcached/tests/CMakeFiles/app_memcached_test_memcached_run.dir/DependInfo.cmake"
+  "apps/memcached/tests/CMakeFiles/app_memcached_test_ascii.dir/DependInfo.cmake"
+  "apps/memcached/tests/CMakeFiles/app_memcached_test_ascii_run.dir/DependInfo.cmake"
+  "apps/rpc_tester/CMakeFiles/app_rpc_tester.dir/DependInfo.cmake"
+  "apps/seawreck/CMakeFiles/app_seawreck.dir/DependInfo.cmake"
+  )
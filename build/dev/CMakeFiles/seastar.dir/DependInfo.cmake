@@ -0,0 +1,119 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/build/dev/gen/src/proto/metrics2.pb.cc" "CMakeFiles/seastar.dir/gen/src/proto/metrics2.pb.cc.o" "gcc" "CMakeFiles/seastar.dir/gen/src/proto/metrics2.pb.cc.o.d"
+  "/root/repo/src/core/alien.cc" "CMakeFiles/seastar.dir/src/core/alien.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/alien.cc.o.d"
+  "/root/repo/src/core/app-template.cc" "CMakeFiles/seastar.dir/src/core/app-template.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/app-template.cc.o.d"
+  "/root/repo/src/core/condition-variable.cc" "CMakeFiles/seastar.dir/src/core/condition-variable.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/condition-variable.cc.o.d"
+  "/root/repo/src/core/cpu_profiler.cc" "CMakeFiles/seastar.dir/src/core/cpu_profiler.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/cpu_profiler.cc.o.d"
+  "/root/repo/src/core/dpdk_rte.cc" "CMakeFiles/seastar.dir/src/core/dpdk_rte.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/dpdk_rte.cc.o.d"
+  "/root/repo/src/core/exception_hacks.cc" "CMakeFiles/seastar.dir/src/core/exception_hacks.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/exception_hacks.cc.o.d"
+  "/root/repo/src/core/execution_stage.cc" "CMakeFiles/seastar.dir/src/core/execution_stage.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/execution_stage.cc.o.d"
+  "/root/repo/src/core/fair_queue.cc" "CMakeFiles/seastar.dir/src/core/fair_queue.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/fair_queue.cc.o.d"
+  "/root/repo/src/core/file.cc" "CMakeFiles/seastar.dir/src/core/file.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/file.cc.o.d"
+  "/root/repo/src/core/fsnotify.cc" "CMakeFiles/seastar.dir/src/core/fsnotify.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/fsnotify.cc.o.d"
+  "/root/repo/src/core/fsqual.cc" "CMakeFiles/seastar.dir/src/core/fsqual.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/fsqual.cc.o.d"
+  "/root/repo/src/core/fstream.cc" "CMakeFiles/seastar.dir/src/core/fstream.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/fstream.cc.o.d"
+  "/root/repo/src/core/future-util.cc" "CMakeFiles/seastar.dir/src/core/future-util.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/future-util.cc.o.d"
+  "/root/repo/src/core/future.cc" "CMakeFiles/seastar.dir/src/core/future.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/future.cc.o.d"
+  "/root/repo/src/core/hugepage_text.cc" "CMakeFiles/seastar.dir/src/core/hugepage_text.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/hugepage_text.cc.o.d"
+  "/root/repo/src/core/io_queue.cc" "CMakeFiles/seastar.dir/src/core/io_queue.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/io_queue.cc.o.d"
+  "/root/repo/src/core/linux-aio.cc" "CMakeFiles/seastar.dir/src/core/linux-aio.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/linux-aio.cc.o.d"
+  "/root/repo/src/core/memory.cc" "CMakeFiles/seastar.dir/src/core/memory.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/memory.cc.o.d"
+  "/root/repo/src/core/metrics.cc" "CMakeFiles/seastar.dir/src/core/metrics.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/metrics.cc.o.d"
+  "/root/repo/src/core/on_internal_error.cc" "CMakeFiles/seastar.dir/src/core/on_internal_error.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/on_internal_error.cc.o.d"
+  "/root/repo/src/core/perf_counters.cc" "CMakeFiles/seastar.dir/src/core/perf_counters.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/perf_counters.cc.o.d"
+  "/root/repo/src/core/posix.cc" "CMakeFiles/seastar.dir/src/core/posix.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/posix.cc.o.d"
+  "/root/repo/src/core/prometheus.cc" "CMakeFiles/seastar.dir/src/core/prometheus.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/prometheus.cc.o.d"
+  "/root/repo/src/core/reactor.cc" "CMakeFiles/seastar.dir/src/core/reactor.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/reactor.cc.o.d"
+  "/root/repo/src/core/reactor_backend.cc" "CMakeFiles/seastar.dir/src/core/reactor_backend.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/reactor_backend.cc.o.d"
+  "/root/repo/src/core/resource.cc" "CMakeFiles/seastar.dir/src/core/resource.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/resource.cc.o.d"
+  "/root/repo/src/core/scollectd.cc" "CMakeFiles/seastar.dir/src/core/scollectd.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/scollectd.cc.o.d"
+  "/root/repo/src/core/semaphore.cc" "CMakeFiles/seastar.dir/src/core/semaphore.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/semaphore.cc.o.d"
+  "/root/repo/src/core/sharded.cc" "CMakeFiles/seastar.dir/src/core/sharded.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/sharded.cc.o.d"
+  "/root/repo/src/core/smp.cc" "CMakeFiles/seastar.dir/src/core/smp.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/smp.cc.o.d"
+  "/root/repo/src/core/sstring.cc" "CMakeFiles/seastar.dir/src/core/sstring.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/sstring.cc.o.d"
+  "/root/repo/src/core/systemwide_memory_barrier.cc" "CMakeFiles/seastar.dir/src/core/systemwide_memory_barrier.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/systemwide_memory_barrier.cc.o.d"
+  "/root/repo/src/core/thread.cc" "CMakeFiles/seastar.dir/src/core/thread.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/thread.cc.o.d"
+  "/root/repo/src/core/thread_pool.cc" "CMakeFiles/seastar.dir/src/core/thread_pool.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/thread_pool.cc.o.d"
+  "/root/repo/src/core/tracer.cc" "CMakeFiles/seastar.dir/src/core/tracer.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/tracer.cc.o.d"
+  "/root/repo/src/core/tsc_clock.cc" "CMakeFiles/seastar.dir/src/core/tsc_clock.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/tsc_clock.cc.o.d"
+  "/root/repo/src/core/uname.cc" "CMakeFiles/seastar.dir/src/core/uname.cc.o" "gcc" "CMakeFiles/seastar.dir/src/core/uname.cc.o.d"
+  "/root/repo/src/http/api_docs.cc" "CMakeFiles/seastar.dir/src/http/api_docs.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/api_docs.cc.o.d"
+  "/root/repo/src/http/client.cc" "CMakeFiles/seastar.dir/src/http/client.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/client.cc.o.d"
+  "/root/repo/src/http/common.cc" "CMakeFiles/seastar.dir/src/http/common.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/common.cc.o.d"
+  "/root/repo/src/http/file_handler.cc" "CMakeFiles/seastar.dir/src/http/file_handler.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/file_handler.cc.o.d"
+  "/root/repo/src/http/http2.cc" "CMakeFiles/seastar.dir/src/http/http2.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/http2.cc.o.d"
+  "/root/repo/src/http/httpd.cc" "CMakeFiles/seastar.dir/src/http/httpd.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/httpd.cc.o.d"
+  "/root/repo/src/http/json_path.cc" "CMakeFiles/seastar.dir/src/http/json_path.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/json_path.cc.o.d"
+  "/root/repo/src/http/matcher.cc" "CMakeFiles/seastar.dir/src/http/matcher.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/matcher.cc.o.d"
+  "/root/repo/src/http/mime_types.cc" "CMakeFiles/seastar.dir/src/http/mime_types.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/mime_types.cc.o.d"
+  "/root/repo/src/http/parser_scan.cc" "CMakeFiles/seastar.dir/src/http/parser_scan.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/parser_scan.cc.o.d"
+  "/root/repo/src/http/reply.cc" "CMakeFiles/seastar.dir/src/http/reply.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/reply.cc.o.d"
+  "/root/repo/src/http/routes.cc" "CMakeFiles/seastar.dir/src/http/routes.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/routes.cc.o.d"
+  "/root/repo/src/http/short_streams.cc" "CMakeFiles/seastar.dir/src/http/short_streams.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/short_streams.cc.o.d"
+  "/root/repo/src/http/transformers.cc" "CMakeFiles/seastar.dir/src/http/transformers.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/transformers.cc.o.d"
+  "/root/repo/src/http/websocket.cc" "CMakeFiles/seastar.dir/src/http/websocket.cc.o" "gcc" "CMakeFiles/seastar.dir/src/http/websocket.cc.o.d"
+  "/root/repo/src/json/formatter.cc" "CMakeFiles/seastar.dir/src/json/formatter.cc.o" "gcc" "CMakeFiles/seastar.dir/src/json/formatter.cc.o.d"
+  "/root/repo/src/json/generator.cc" "CMakeFiles/seastar.dir/src/json/generator.cc.o" "gcc" "CMakeFiles/seastar.dir/src/json/generator.cc.o.d"
+  "/root/repo/src/json/json_elements.cc" "CMakeFiles/seastar.dir/src/json/json_elements.cc.o" "gcc" "CMakeFiles/seastar.dir/src/json/json_elements.cc.o.d"
+  "/root/repo/src/json/parser.cc" "CMakeFiles/seastar.dir/src/json/parser.cc.o" "gcc" "CMakeFiles/seastar.dir/src/json/parser.cc.o.d"
+  "/root/repo/src/net/arp.cc" "CMakeFiles/seastar.dir/src/net/arp.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/arp.cc.o.d"
+  "/root/repo/src/net/config.cc" "CMakeFiles/seastar.dir/src/net/config.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/config.cc.o.d"
+  "/root/repo/src/net/dhcp.cc" "CMakeFiles/seastar.dir/src/net/dhcp.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/dhcp.cc.o.d"
+  "/root/repo/src/net/dns.cc" "CMakeFiles/seastar.dir/src/net/dns.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/dns.cc.o.d"
+  "/root/repo/src/net/dpdk.cc" "CMakeFiles/seastar.dir/src/net/dpdk.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/dpdk.cc.o.d"
+  "/root/repo/src/net/egress.cc" "CMakeFiles/seastar.dir/src/net/egress.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/egress.cc.o.d"
+  "/root/repo/src/net/ethernet.cc" "CMakeFiles/seastar.dir/src/net/ethernet.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/ethernet.cc.o.d"
+  "/root/repo/src/net/inet_address.cc" "CMakeFiles/seastar.dir/src/net/inet_address.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/inet_address.cc.o.d"
+  "/root/repo/src/net/ip.cc" "CMakeFiles/seastar.dir/src/net/ip.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/ip.cc.o.d"
+  "/root/repo/src/net/ip_checksum.cc" "CMakeFiles/seastar.dir/src/net/ip_checksum.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/ip_checksum.cc.o.d"
+  "/root/repo/src/net/native-stack.cc" "CMakeFiles/seastar.dir/src/net/native-stack.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/native-stack.cc.o.d"
+  "/root/repo/src/net/net.cc" "CMakeFiles/seastar.dir/src/net/net.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/net.cc.o.d"
+  "/root/repo/src/net/packet.cc" "CMakeFiles/seastar.dir/src/net/packet.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/packet.cc.o.d"
+  "/root/repo/src/net/posix-stack.cc" "CMakeFiles/seastar.dir/src/net/posix-stack.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/posix-stack.cc.o.d"
+  "/root/repo/src/net/proxy.cc" "CMakeFiles/seastar.dir/src/net/proxy.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/proxy.cc.o.d"
+  "/root/repo/src/net/shm-stack.cc" "CMakeFiles/seastar.dir/src/net/shm-stack.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/shm-stack.cc.o.d"
+  "/root/repo/src/net/socket_address.cc" "CMakeFiles/seastar.dir/src/net/socket_address.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/socket_address.cc.o.d"
+  "/root/repo/src/net/stack.cc" "CMakeFiles/seastar.dir/src/net/stack.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/stack.cc.o.d"
+  "/root/repo/src/net/tcp.cc" "CMakeFiles/seastar.dir/src/net/tcp.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/tcp.cc.o.d"
+  "/root/repo/src/net/tls.cc" "CMakeFiles/seastar.dir/src/net/tls.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/tls.cc.o.d"
+  "/root/repo/src/net/udp.cc" "CMakeFiles/seastar.dir/src/net/udp.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/udp.cc.o.d"
+  "/root/repo/src/net/unix_address.cc" "CMakeFiles/seastar.dir/src/net/unix_address.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/unix_address.cc.o.d"
+  "/root/repo/src/net/vhost-user.cc" "CMakeFiles/seastar.dir/src/net/vhost-user.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/vhost-user.cc.o.d"
+  "/root/repo/src/net/virtio.cc" "CMakeFiles/seastar.dir/src/net/virtio.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/virtio.cc.o.d"
+  "/root/repo/src/net/xdp.cc" "CMakeFiles/seastar.dir/src/net/xdp.cc.o" "gcc" "CMakeFiles/seastar.dir/src/net/xdp.cc.o.d"
+  "/root/repo/src/rpc/lz4_compressor.cc" "CMakeFiles/seastar.dir/src/rpc/lz4_compressor.cc.o" "gcc" "CMakeFiles/seastar.dir/src/rpc/lz4_compressor.cc.o.d"
+  "/root/repo/src/rpc/lz4_fragmented_compressor.cc" "CMakeFiles/seastar.dir/src/rpc/lz4_fragmented_compressor.cc.o" "gcc" "CMakeFiles/seastar.dir/src/rpc/lz4_fragmented_compressor.cc.o.d"
+  "/root/repo/src/rpc/rpc.cc" "CMakeFiles/seastar.dir/src/rpc/rpc.cc.o" "gcc" "CMakeFiles/seastar.dir/src/rpc/rpc.cc.o.d"
+  "/root/repo/src/rpc/zstd_compressor.cc" "CMakeFiles/seastar.dir/src/rpc/zstd_compressor.cc.o" "gcc" "CMakeFiles/seastar.dir/src/rpc/zstd_compressor.cc.o.d"
+  "/root/repo/src/util/alloc_failure_injector.cc" "CMakeFiles/seastar.dir/src/util/alloc_failure_injector.cc.o" "gcc" "CMakeFiles/seastar.dir/src/util/alloc_failure_injector.cc.o.d"
+  "/root/repo/src/util/backtrace.cc" "CMakeFiles/seastar.dir/src/util/backtrace.cc.o" "gcc" "CMakeFiles/seastar.dir/src/util/backtrace.cc.o.d"
+  "/root/repo/src/util/conversions.cc" "CMakeFiles/seastar.dir/src/util/conversions.cc.o" "gcc" "CMakeFiles/seastar.dir/src/util/conversions.cc.o.d"
+  "/root/repo/src/util/exceptions.cc" "CMakeFiles/seastar.dir/src/util/exceptions.cc.o" "gcc" "CMakeFiles/seastar.dir/src/util/exceptions.cc.o.d"
+  "/root/repo/src/util/file.cc" "CMakeFiles/seastar.dir/src/util/file.cc.o" "gcc" "CMakeFiles/seastar.dir/src/util/file.cc.o.d"
+  "/root/repo/src/util/log.cc" "CMakeFiles/seastar.dir/src/util/log.cc.o" "gcc" "CMakeFiles/seastar.dir/src/util/log.cc.o.d"
+  "/root/repo/src/util/program-options.cc" "CMakeFiles/seastar.dir/src/util/program-options.cc.o" "gcc" "CMakeFiles/seastar.dir/src/util/program-options.cc.o.d"
+  "/root/repo/src/util/read_first_line.cc" "CMakeFiles/seastar.dir/src/util/read_first_line.cc.o" "gcc" "CMakeFiles/seastar.dir/src/util/read_first_line.cc.o.d"
+  "/root/repo/src/util/tmp_file.cc" "CMakeFiles/seastar.dir/src/util/tmp_file.cc.o" "gcc" "CMakeFiles/seastar.dir/src/util/tmp_file.cc.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/build/dev/gen/src/proto/metrics2.pb.cc" "/root/repo/build/dev/gen/src/proto/metrics2.pb.h"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,203 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/seastar.dir/gen/src/proto/metrics2.pb.cc.o"
+  "CMakeFiles/seastar.dir/gen/src/proto/metrics2.pb.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/alien.cc.o"
+  "CMakeFiles/seastar.dir/src/core/alien.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/app-template.cc.o"
+  "CMakeFiles/seastar.dir/src/core/app-template.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/condition-variable.cc.o"
+  "CMakeFiles/seastar.dir/src/core/condition-variable.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/cpu_profiler.cc.o"
+  "CMakeFiles/seastar.dir/src/core/cpu_profiler.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/dpdk_rte.cc.o"
+  "CMakeFiles/seastar.dir/src/core/dpdk_rte.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/exception_hacks.cc.o"
+  "CMakeFiles/seastar.dir/src/core/exception_hacks.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/execution_stage.cc.o"
+  "CMakeFiles/seastar.dir/src/core/execution_stage.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/fair_queue.cc.o"
+  "CMakeFiles/seastar.dir/src/core/fair_queue.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/file.cc.o"
+  "CMakeFiles/seastar.dir/src/core/file.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/fsnotify.cc.o"
+  "CMakeFiles/seastar.dir/src/core/fsnotify.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/fsqual.cc.o"
+  "CMakeFiles/seastar.dir/src/core/fsqual.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/fstream.cc.o"
+  "CMakeFiles/seastar.dir/src/core/fstream.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/future-util.cc.o"
+  "CMakeFiles/seastar.dir/src/core/future-util.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/future.cc.o"
+  "CMakeFiles/seastar.dir/src/core/future.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/hugepage_text.cc.o"
+  "CMakeFiles/seastar.dir/src/core/hugepage_text.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/io_queue.cc.o"
+  "CMakeFiles/seastar.dir/src/core/io_queue.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/linux-aio.cc.o"
+  "CMakeFiles/seastar.dir/src/core/linux-aio.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/memory.cc.o"
+  "CMakeFiles/seastar.dir/src/core/memory.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/metrics.cc.o"
+  "CMakeFiles/seastar.dir/src/core/metrics.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/on_internal_error.cc.o"
+  "CMakeFiles/seastar.dir/src/core/on_internal_error.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/perf_counters.cc.o"
+  "CMakeFiles/seastar.dir/src/core/perf_counters.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/posix.cc.o"
+  "CMakeFiles/seastar.dir/src/core/posix.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/prometheus.cc.o"
+  "CMakeFiles/seastar.dir/src/core/prometheus.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/reactor.cc.o"
+  "CMakeFiles/seastar.dir/src/core/reactor.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/reactor_backend.cc.o"
+  "CMakeFiles/seastar.dir/src/core/reactor_backend.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/resource.cc.o"
+  "CMakeFiles/seastar.dir/src/core/resource.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/scollectd.cc.o"
+  "CMakeFiles/seastar.dir/src/core/scollectd.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/semaphore.cc.o"
+  "CMakeFiles/seastar.dir/src/core/semaphore.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/sharded.cc.o"
+  "CMakeFiles/seastar.dir/src/core/sharded.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/smp.cc.o"
+  "CMakeFiles/seastar.dir/src/core/smp.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/sstring.cc.o"
+  "CMakeFiles/seastar.dir/src/core/sstring.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/systemwide_memory_barrier.cc.o"
+  "CMakeFiles/seastar.dir/src/core/systemwide_memory_barrier.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/thread.cc.o"
+  "CMakeFiles/seastar.dir/src/core/thread.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/thread_pool.cc.o"
+  "CMakeFiles/seastar.dir/src/core/thread_pool.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/tracer.cc.o"
+  "CMakeFiles/seastar.dir/src/core/tracer.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/tsc_clock.cc.o"
+  "CMakeFiles/seastar.dir/src/core/tsc_clock.cc.o.d"
+  "CMakeFiles/seastar.dir/src/core/uname.cc.o"
+  "CMakeFiles/seastar.dir/src/core/uname.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/api_docs.cc.o"
+  "CMakeFiles/seastar.dir/src/http/api_docs.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/client.cc.o"
+  "CMakeFiles/seastar.dir/src/http/client.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/common.cc.o"
+  "CMakeFiles/seastar.dir/src/http/common.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/file_handler.cc.o"
+  "CMakeFiles/seastar.dir/src/http/file_handler.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/http2.cc.o"
+  "CMakeFiles/seastar.dir/src/http/http2.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/httpd.cc.o"
+  "CMakeFiles/seastar.dir/src/http/httpd.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/json_path.cc.o"
+  "CMakeFiles/seastar.dir/src/http/json_path.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/matcher.cc.o"
+  "CMakeFiles/seastar.dir/src/http/matcher.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/mime_types.cc.o"
+  "CMakeFiles/seastar.dir/src/http/mime_types.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/parser_scan.cc.o"
+  "CMakeFiles/seastar.dir/src/http/parser_scan.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/reply.cc.o"
+  "CMakeFiles/seastar.dir/src/http/reply.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/routes.cc.o"
+  "CMakeFiles/seastar.dir/src/http/routes.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/short_streams.cc.o"
+  "CMakeFiles/seastar.dir/src/http/short_streams.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/transformers.cc.o"
+  "CMakeFiles/seastar.dir/src/http/transformers.cc.o.d"
+  "CMakeFiles/seastar.dir/src/http/websocket.cc.o"
+  "CMakeFiles/seastar.dir/src/http/websocket.cc.o.d"
+  "CMakeFiles/seastar.dir/src/json/formatter.cc.o"
+  "CMakeFiles/seastar.dir/src/json/formatter.cc.o.d"
+  "CMakeFiles/seastar.dir/src/json/generator.cc.o"
+  "CMakeFiles/seastar.dir/src/json/generator.cc.o.d"
+  "CMakeFiles/seastar.dir/src/json/json_elements.cc.o"
+  "CMakeFiles/seastar.dir/src/json/json_elements.cc.o.d"
+  "CMakeFiles/seastar.dir/src/json/parser.cc.o"
+  "CMakeFiles/seastar.dir/src/json/parser.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/arp.cc.o"
+  "CMakeFiles/seastar.dir/src/net/arp.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/config.cc.o"
+  "CMakeFiles/seastar.dir/src/net/config.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/dhcp.cc.o"
+  "CMakeFiles/seastar.dir/src/net/dhcp.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/dns.cc.o"
+  "CMakeFiles/seastar.dir/src/net/dns.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/dpdk.cc.o"
+  "CMakeFiles/seastar.dir/src/net/dpdk.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/egress.cc.o"
+  "CMakeFiles/seastar.dir/src/net/egress.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/ethernet.cc.o"
+  "CMakeFiles/seastar.dir/src/net/ethernet.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/inet_address.cc.o"
+  "CMakeFiles/seastar.dir/src/net/inet_address.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/ip.cc.o"
+  "CMakeFiles/seastar.dir/src/net/ip.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/ip_checksum.cc.o"
+  "CMakeFiles/seastar.dir/src/net/ip_checksum.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/native-stack.cc.o"
+  "CMakeFiles/seastar.dir/src/net/native-stack.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/net.cc.o"
+  "CMakeFiles/seastar.dir/src/net/net.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/packet.cc.o"
+  "CMakeFiles/seastar.dir/src/net/packet.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/posix-stack.cc.o"
+  "CMakeFiles/seastar.dir/src/net/posix-stack.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/proxy.cc.o"
+  "CMakeFiles/seastar.dir/src/net/proxy.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/shm-stack.cc.o"
+  "CMakeFiles/seastar.dir/src/net/shm-stack.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/socket_address.cc.o"
+  "CMakeFiles/seastar.dir/src/net/socket_address.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/stack.cc.o"
+  "CMakeFiles/seastar.dir/src/net/stack.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/tcp.cc.o"
+  "CMakeFiles/seastar.dir/src/net/tcp.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/tls.cc.o"
+  "CMakeFiles/seastar.dir/src/net/tls.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/udp.cc.o"
+  "CMakeFiles/seastar.dir/src/net/udp.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/unix_address.cc.o"
+  "CMakeFiles/seastar.dir/src/net/unix_address.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/vhost-user.cc.o"
+  "CMakeFiles/seastar.dir/src/net/vhost-user.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/virtio.cc.o"
+  "CMakeFiles/seastar.dir/src/net/virtio.cc.o.d"
+  "CMakeFiles/seastar.dir/src/net/xdp.cc.o"
+  "CMakeFiles/seastar.dir/src/net/xdp.cc.o.d"
+  "CMakeFiles/seastar.dir/src/rpc/lz4_compressor.cc.o"
+  "CMakeFiles/seastar.dir/src/rpc/lz4_compressor.cc.o.d"
+  "CMakeFiles/seastar.dir/src/rpc/lz4_fragmented_compressor.cc.o"
+  "CMakeFiles/seastar.dir/src/rpc/lz4_fragmented_compressor.cc.o.d"
+  "CMakeFiles/seastar.dir/src/rpc/rpc.cc.o"
+  "CMakeFiles/seastar.dir/src/rpc/rpc.cc.o.d"
+  "CMakeFiles/seastar.dir/src/rpc/zstd_compressor.cc.o"
+  "CMakeFiles/seastar.dir/src/rpc/zstd_compressor.cc.o.d"
+  "CMakeFiles/seastar.dir/src/util/alloc_failure_injector.cc.o"
+  "CMakeFiles/seastar.dir/src/util/alloc_failure_injector.cc.o.d"
+  "CMakeFiles/seastar.dir/src/util/backtrace.cc.o"
+  "CMakeFiles/seastar.dir/src/util/backtrace.cc.o.d"
+  "CMakeFiles/seastar.dir/src/util/conversions.cc.o"
+  "CMakeFiles/seastar.dir/src/util/conversions.cc.o.d"
+  "CMakeFiles/seastar.dir/src/util/exceptions.cc.o"
+  "CMakeFiles/seastar.dir/src/util/exceptions.cc.o.d"
+  "CMakeFiles/seastar.dir/src/util/file.cc.o"
+  "CMakeFiles/seastar.dir/src/util/file.cc.o.d"
+  "CMakeFiles/seastar.dir/src/util/log.cc.o"
+  "CMakeFiles/seastar.dir/src/util/log.cc.o.d"
+  "CMakeFiles/seastar.dir/src/util/program-options.cc.o"
+  "CMakeFiles/seastar.dir/src/util/program-options.cc.o.d"
+  "CMakeFiles/seastar.dir/src/util/read_first_line.cc.o"
+  "CMakeFiles/seastar.dir/src/util/read_first_line.cc.o.d"
+  "CMakeFiles/seastar.dir/src/util/tmp_file.cc.o"
+  "CMakeFiles/seastar.dir/src/util/tmp_file.cc.o.d"
+  "gen/include/seastar/http/chunk_parsers.hh"
+  "gen/include/seastar/http/request_parser.hh"
+  "gen/src/proto/metrics2.pb.cc"
+  "gen/src/proto/metrics2.pb.h"
+  "libseastar.a"
+  "libseastar.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/seastar.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/seastar_http_chunk_parsers"
+  "gen/include/seastar/http/chunk_parsers.hh"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/seastar_http_chunk_parsers.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
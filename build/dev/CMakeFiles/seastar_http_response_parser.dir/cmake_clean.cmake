@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/seastar_http_response_parser"
+  "gen/include/seastar/http/response_parser.hh"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/seastar_http_response_parser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/testing/random.cc" "CMakeFiles/seastar_perf_testing.dir/src/testing/random.cc.o" "gcc" "CMakeFiles/seastar_perf_testing.dir/src/testing/random.cc.o.d"
+  "/root/repo/tests/perf/perf_tests.cc" "CMakeFiles/seastar_perf_testing.dir/tests/perf/perf_tests.cc.o" "gcc" "CMakeFiles/seastar_perf_testing.dir/tests/perf/perf_tests.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/build/dev/CMakeFiles/seastar.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/seastar_perf_testing.dir/src/testing/random.cc.o"
+  "CMakeFiles/seastar_perf_testing.dir/src/testing/random.cc.o.d"
+  "CMakeFiles/seastar_perf_testing.dir/tests/perf/perf_tests.cc.o"
+  "CMakeFiles/seastar_perf_testing.dir/tests/perf/perf_tests.cc.o.d"
+  "libseastar_perf_testing.a"
+  "libseastar_perf_testing.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/seastar_perf_testing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
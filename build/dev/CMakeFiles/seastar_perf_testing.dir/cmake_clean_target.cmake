@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libseastar_perf_testing.a"
+)
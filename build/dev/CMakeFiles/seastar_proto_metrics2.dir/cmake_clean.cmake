@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/seastar_proto_metrics2"
+  "gen/src/proto/metrics2.pb.cc"
+  "gen/src/proto/metrics2.pb.h"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/seastar_proto_metrics2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
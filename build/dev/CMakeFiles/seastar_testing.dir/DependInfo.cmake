@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/testing/entry_point.cc" "CMakeFiles/seastar_testing.dir/src/testing/entry_point.cc.o" "gcc" "CMakeFiles/seastar_testing.dir/src/testing/entry_point.cc.o.d"
+  "/root/repo/src/testing/random.cc" "CMakeFiles/seastar_testing.dir/src/testing/random.cc.o" "gcc" "CMakeFiles/seastar_testing.dir/src/testing/random.cc.o.d"
+  "/root/repo/src/testing/seastar_test.cc" "CMakeFiles/seastar_testing.dir/src/testing/seastar_test.cc.o" "gcc" "CMakeFiles/seastar_testing.dir/src/testing/seastar_test.cc.o.d"
+  "/root/repo/src/testing/test_runner.cc" "CMakeFiles/seastar_testing.dir/src/testing/test_runner.cc.o" "gcc" "CMakeFiles/seastar_testing.dir/src/testing/test_runner.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/build/dev/CMakeFiles/seastar.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/seastar_testing.dir/src/testing/entry_point.cc.o"
+  "CMakeFiles/seastar_testing.dir/src/testing/entry_point.cc.o.d"
+  "CMakeFiles/seastar_testing.dir/src/testing/random.cc.o"
+  "CMakeFiles/seastar_testing.dir/src/testing/random.cc.o.d"
+  "CMakeFiles/seastar_testing.dir/src/testing/seastar_test.cc.o"
+  "CMakeFiles/seastar_testing.dir/src/testing/seastar_test.cc.o.d"
+  "CMakeFiles/seastar_testing.dir/src/testing/test_runner.cc.o"
+  "CMakeFiles/seastar_testing.dir/src/testing/test_runner.cc.o.d"
+  "libseastar_testing.a"
+  "libseastar_testing.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/seastar_testing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/apps
+# Build directory: /root/repo/build/dev/apps
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("httpd")
+subdirs("io_tester")
+subdirs("iotune")
+subdirs("memcached")
+subdirs("rpc_tester")
+subdirs("seawreck")
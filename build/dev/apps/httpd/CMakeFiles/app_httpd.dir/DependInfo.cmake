@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/build/dev/apps/httpd/demo.json.cc" "apps/httpd/CMakeFiles/app_httpd.dir/demo.json.cc.o" "gcc" "apps/httpd/CMakeFiles/app_httpd.dir/demo.json.cc.o.d"
+  "/root/repo/apps/httpd/main.cc" "apps/httpd/CMakeFiles/app_httpd.dir/main.cc.o" "gcc" "apps/httpd/CMakeFiles/app_httpd.dir/main.cc.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/build/dev/apps/httpd/demo.json.cc" "/root/repo/build/dev/apps/httpd/demo.json.hh"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/build/dev/CMakeFiles/seastar.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/app_httpd.dir/demo.json.cc.o"
+  "CMakeFiles/app_httpd.dir/demo.json.cc.o.d"
+  "CMakeFiles/app_httpd.dir/main.cc.o"
+  "CMakeFiles/app_httpd.dir/main.cc.o.d"
+  "demo.json.cc"
+  "demo.json.hh"
+  "httpd"
+  "httpd.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/app_httpd.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/app_httpd_swagger"
+  "demo.json.cc"
+  "demo.json.hh"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/app_httpd_swagger.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,199 @@
+/*
+* Copyright (C) 2014 Cloudius Systems, Ltd.
+*
+* This work is open source software, licensed under the terms of the
+* BSD license as described in the LICENSE f in the top-level directory.
+*
+*  This is an Auto-Generated-code  
+*  Changes you do in this file will be erased on next code generation
+*/
+
+#ifndef __JSON_AUTO_GENERATED_demo_json
+#define __JSON_AUTO_GENERATED_demo_json
+
+#include <seastar/core/sstring.hh>
+#include <seastar/json/json_elements.hh>
+#include <seastar/http/json_path.hh>
+
+#include <iostream>
+#include <boost/range/irange.hpp>
+
+namespace seastar {
+
+namespace httpd {
+
+namespace demo_json {
+
+/**
+ * Demonstrate an object
+ */
+struct my_object : public json::json_base {
+    /**
+     * The first parameter in the path
+     */
+  json::json_element< sstring > var1;
+
+    /**
+     * The second parameter in the path
+     */
+  json::json_element< sstring > var2;
+
+    /**
+     * Demonstrate an enum returned, note this is not the same enum type of the request
+     */
+  enum class my_object_enum_var {  VAL1,   VAL2,   VAL3, NUM_ITEMS};
+  struct enum_var_wrapper : public json::jsonable  {
+        enum_var_wrapper() = default;
+        virtual std::string to_json() const {
+            switch(v) {
+              case my_object_enum_var::VAL1: return "\"VAL1\"";
+      case my_object_enum_var::VAL2: return "\"VAL2\"";
+      case my_object_enum_var::VAL3: return "\"VAL3\"";
+      default: return "\"Unknown\"";
+        }
+     }
+    template<class T>
+    enum_var_wrapper (const T& _v) {
+    switch(_v) {
+          case T::VAL1: v = my_object_enum_var::VAL1; break;
+      case T::VAL2: v = my_object_enum_var::VAL2; break;
+      case T::VAL3: v = my_object_enum_var::VAL3; break;
+      default: v = my_object_enum_var::NUM_ITEMS;
+        }
+    }
+    template<class T>
+    operator T() const {
+        switch(v) {
+          case my_object_enum_var::VAL1: return T::VAL1;
+      case my_object_enum_var::VAL2: return T::VAL2;
+      case my_object_enum_var::VAL3: return T::VAL3;
+      default: return T::VAL1;
+          }
+        }
+        typedef typename std::underlying_type<my_object_enum_var>::type pos_type;
+        enum_var_wrapper& operator++() {
+        v = static_cast<my_object_enum_var>(static_cast<pos_type>(v) + 1);
+            return *this;
+        }
+        enum_var_wrapper & operator++(int) {
+            return ++(*this);
+        }
+        bool operator==(const  enum_var_wrapper& c) const {
+            return v == c.v;
+        }
+        bool operator!=(const enum_var_wrapper& c) const {
+            return v != c.v;
+        }
+        bool operator<=(const enum_var_wrapper& c) const {
+            return static_cast<pos_type>(v) <= static_cast<pos_type>(c.v);
+        }
+        static enum_var_wrapper begin() {
+            return enum_var_wrapper (my_object_enum_var::VAL1);
+        }
+        static enum_var_wrapper end() {
+            return enum_var_wrapper (my_object_enum_var::NUM_ITEMS);
+        }
+        static boost::integer_range<enum_var_wrapper> all_items() {
+            return boost::irange(begin(), end());
+        }
+        my_object_enum_var v;
+    };
+    
+  json::json_element<enum_var_wrapper> enum_var;
+
+void register_params() {
+  add(&var1,"var1");
+  add(&var2,"var2");
+  add(&enum_var,"enum_var");
+
+}
+my_object() {
+  register_params();
+}
+my_object(const my_object & e) {
+  register_params();
+  var1 = e.var1;
+  var2 = e.var2;
+  enum_var = e.enum_var;
+
+}
+template<class T>
+my_object& operator=(const T& e) {
+  var1 = e.var1;
+  var2 = e.var2;
+  enum_var = e.enum_var;
+
+  return *this;
+}
+my_object& operator=(const my_object& e) {
+  var1 = e.var1;
+  var2 = e.var2;
+  enum_var = e.enum_var;
+
+  return *this;
+}
+template<class T>
+my_object& update(T& e) {
+  e.var1 = var1;
+  e.var2 = var2;
+  e.enum_var = enum_var;
+
+  return *this;
+}
+    /**
+     * A flat writer: the field layout is known here at generation time, so the set fields serialize straight into the generator with no virtual element dispatch and no string temporaries.
+     */
+void append(json::generator& g) const {
+  g.append('{');
+  bool first = true;
+  if (var1._set) {
+    if (!first) {
+      g.append_raw(", ", 2);
+    }
+    first = false;
+    g.append_raw("\"var1\": ", 8);
+    var1.append_value(g);
+  }
+  if (var2._set) {
+    if (!first) {
+      g.append_raw(", ", 2);
+    }
+    first = false;
+    g.append_raw("\"var2\": ", 8);
+    var2.append_value(g);
+  }
+  if (enum_var._set) {
+    if (!first) {
+      g.append_raw(", ", 2);
+    }
+    first = false;
+    g.append_raw("\"enum_var\": ", 12);
+    enum_var.append_value(g);
+  }
+
+  g.append('}');
+}
+virtual std::string to_json() const override {
+  json::generator g;
+  append(g);
+  return std::string(g.str());
+}
+virtual future<> write(output_stream<char>& s) const override {
+  return json::write_flat(*this, s);
+}
+};
+
+
+static const sstring name = "demo";
+    /**
+     * Returns the number of seconds since the system was booted
+     */
+extern const path_description hello_world;
+namespace ns_hello_world{
+enum class query_enum {VAL1, VAL2, VAL3, NUM_ITEMS};
+query_enum str2query_enum(const sstring& str);}
+
+}
+}
+}
+#endif //__JSON_AUTO_GENERATED_HEADERS
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/app_io_tester.dir/io_tester.cc.o"
+  "CMakeFiles/app_io_tester.dir/io_tester.cc.o.d"
+  "io_tester"
+  "io_tester.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/app_io_tester.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
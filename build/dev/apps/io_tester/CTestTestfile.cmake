@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/apps/io_tester
+# Build directory: /root/repo/build/dev/apps/io_tester
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/app_iotune.dir/iotune.cc.o"
+  "CMakeFiles/app_iotune.dir/iotune.cc.o.d"
+  "iotune"
+  "iotune.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/app_iotune.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/apps/iotune
+# Build directory: /root/repo/build/dev/apps/iotune
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/app_memcached.dir/memcache.cc.o"
+  "CMakeFiles/app_memcached.dir/memcache.cc.o.d"
+  "ascii.hh"
+  "memcached"
+  "memcached.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/app_memcached.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/app_memcached_ascii"
+  "ascii.hh"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/app_memcached_ascii.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
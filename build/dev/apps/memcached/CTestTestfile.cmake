@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/apps/memcached
+# Build directory: /root/repo/build/dev/apps/memcached
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("tests")
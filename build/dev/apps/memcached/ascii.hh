@@ -0,0 +1,96 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2014 Cloudius Systems, Ltd.
+ */
+
+#include <seastar/core/ragel.hh>
+#include "memcached.hh"
+#include <memory>
+#include <algorithm>
+#include <functional>
+
+using namespace seastar;
+
+
+
+class memcache_ascii_parser : public ragel_parser_base<memcache_ascii_parser> {
+    /* ragel shim */
+public:
+    enum class state {
+        error,
+        eof,
+        cmd_set,
+        cmd_cas,
+        cmd_add,
+        cmd_replace,
+        cmd_get,
+        cmd_gets,
+        cmd_delete,
+        cmd_flush_all,
+        cmd_version,
+        cmd_stats,
+        cmd_stats_hash,
+        cmd_incr,
+        cmd_decr,
+    };
+    state _state;
+    uint32_t _u32;
+    uint64_t _u64;
+    memcache::item_key _key;
+    sstring _flags_str;
+    uint32_t _expiration;
+    uint32_t _size;
+    sstring _size_str;
+    uint32_t _size_left;
+    uint64_t _version;
+    sstring _blob;
+    bool _noreply;
+    std::vector<memcache::item_key> _keys;
+public:
+    void init() {
+        init_base();
+        _state = state::error;
+        _keys.clear();
+    /* ragel shim */
+    }
+
+    char* parse(char* p, char* pe, char* eof) {
+        sstring_builder::guard g(_builder, p, pe);
+        auto str = [this, &g, &p] { g.mark_end(p); return get_str(); };
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmisleading-indentation"
+#endif
+    /* ragel shim */
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+        if (_state != state::error) {
+            return p;
+        }
+        if (p != pe) {
+            p = pe;
+            return p;
+        }
+        return nullptr;
+    }
+    bool eof() const {
+        return _state == state::eof;
+    }
+};
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/app_memcached_test_ascii.dir/test_ascii_parser.cc.o"
+  "CMakeFiles/app_memcached_test_ascii.dir/test_ascii_parser.cc.o.d"
+  "app_memcached_test_ascii"
+  "app_memcached_test_ascii.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/app_memcached_test_ascii.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
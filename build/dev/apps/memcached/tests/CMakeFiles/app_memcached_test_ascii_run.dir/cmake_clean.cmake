@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/app_memcached_test_ascii_run"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/app_memcached_test_ascii_run.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
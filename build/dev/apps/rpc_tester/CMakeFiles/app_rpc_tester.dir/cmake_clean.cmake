@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/app_rpc_tester.dir/rpc_tester.cc.o"
+  "CMakeFiles/app_rpc_tester.dir/rpc_tester.cc.o.d"
+  "rpc_tester"
+  "rpc_tester.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/app_rpc_tester.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/app_seawreck.dir/seawreck.cc.o"
+  "CMakeFiles/app_seawreck.dir/seawreck.cc.o.d"
+  "seawreck"
+  "seawreck.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/app_seawreck.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
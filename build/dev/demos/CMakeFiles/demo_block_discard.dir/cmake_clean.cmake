@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_block_discard.dir/block_discard_demo.cc.o"
+  "CMakeFiles/demo_block_discard.dir/block_discard_demo.cc.o.d"
+  "block_discard_demo"
+  "block_discard_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_block_discard.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
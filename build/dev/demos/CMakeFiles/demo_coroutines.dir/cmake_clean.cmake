@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_coroutines.dir/coroutines_demo.cc.o"
+  "CMakeFiles/demo_coroutines.dir/coroutines_demo.cc.o.d"
+  "coroutines_demo"
+  "coroutines_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_coroutines.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
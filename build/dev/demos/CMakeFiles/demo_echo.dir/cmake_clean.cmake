@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_echo.dir/echo_demo.cc.o"
+  "CMakeFiles/demo_echo.dir/echo_demo.cc.o.d"
+  "echo_demo"
+  "echo_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_echo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_file.dir/file_demo.cc.o"
+  "CMakeFiles/demo_file.dir/file_demo.cc.o.d"
+  "file_demo"
+  "file_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
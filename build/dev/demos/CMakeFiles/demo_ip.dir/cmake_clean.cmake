@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_ip.dir/ip_demo.cc.o"
+  "CMakeFiles/demo_ip.dir/ip_demo.cc.o.d"
+  "ip_demo"
+  "ip_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_ip.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
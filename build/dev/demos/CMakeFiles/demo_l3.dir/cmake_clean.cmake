@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_l3.dir/l3_demo.cc.o"
+  "CMakeFiles/demo_l3.dir/l3_demo.cc.o.d"
+  "l3_demo"
+  "l3_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_l3.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
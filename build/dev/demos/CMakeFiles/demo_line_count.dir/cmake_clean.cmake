@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_line_count.dir/line_count_demo.cc.o"
+  "CMakeFiles/demo_line_count.dir/line_count_demo.cc.o.d"
+  "line_count_demo"
+  "line_count_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_line_count.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_rpc.dir/rpc_demo.cc.o"
+  "CMakeFiles/demo_rpc.dir/rpc_demo.cc.o.d"
+  "rpc_demo"
+  "rpc_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_rpc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
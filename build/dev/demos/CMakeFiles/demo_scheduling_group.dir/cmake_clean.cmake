@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_scheduling_group.dir/scheduling_group_demo.cc.o"
+  "CMakeFiles/demo_scheduling_group.dir/scheduling_group_demo.cc.o.d"
+  "scheduling_group_demo"
+  "scheduling_group_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_scheduling_group.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_sharded_parameter.dir/sharded_parameter_demo.cc.o"
+  "CMakeFiles/demo_sharded_parameter.dir/sharded_parameter_demo.cc.o.d"
+  "sharded_parameter_demo"
+  "sharded_parameter_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_sharded_parameter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_tcp.dir/tcp_demo.cc.o"
+  "CMakeFiles/demo_tcp.dir/tcp_demo.cc.o.d"
+  "tcp_demo"
+  "tcp_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_tcp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_tcp_sctp_client.dir/tcp_sctp_client_demo.cc.o"
+  "CMakeFiles/demo_tcp_sctp_client.dir/tcp_sctp_client_demo.cc.o.d"
+  "tcp_sctp_client_demo"
+  "tcp_sctp_client_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_tcp_sctp_client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
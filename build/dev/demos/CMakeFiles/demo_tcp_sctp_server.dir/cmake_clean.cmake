@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_tcp_sctp_server.dir/tcp_sctp_server_demo.cc.o"
+  "CMakeFiles/demo_tcp_sctp_server.dir/tcp_sctp_server_demo.cc.o.d"
+  "tcp_sctp_server_demo"
+  "tcp_sctp_server_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_tcp_sctp_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_tls_echo_server.dir/tls_echo_server_demo.cc.o"
+  "CMakeFiles/demo_tls_echo_server.dir/tls_echo_server_demo.cc.o.d"
+  "tls_echo_server_demo"
+  "tls_echo_server_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_tls_echo_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_tls_simple_client.dir/tls_simple_client_demo.cc.o"
+  "CMakeFiles/demo_tls_simple_client.dir/tls_simple_client_demo.cc.o.d"
+  "tls_simple_client_demo"
+  "tls_simple_client_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_tls_simple_client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_tutorial_examples.dir/tutorial_examples.cc.o"
+  "CMakeFiles/demo_tutorial_examples.dir/tutorial_examples.cc.o.d"
+  "tutorial_examples_demo"
+  "tutorial_examples_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_tutorial_examples.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_udp_client.dir/udp_client_demo.cc.o"
+  "CMakeFiles/demo_udp_client.dir/udp_client_demo.cc.o.d"
+  "udp_client_demo"
+  "udp_client_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_udp_client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
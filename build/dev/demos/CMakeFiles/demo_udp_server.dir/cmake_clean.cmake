@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_udp_server.dir/udp_server_demo.cc.o"
+  "CMakeFiles/demo_udp_server.dir/udp_server_demo.cc.o.d"
+  "udp_server_demo"
+  "udp_server_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_udp_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
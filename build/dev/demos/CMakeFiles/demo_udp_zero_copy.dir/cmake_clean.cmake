@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_udp_zero_copy.dir/udp_zero_copy_demo.cc.o"
+  "CMakeFiles/demo_udp_zero_copy.dir/udp_zero_copy_demo.cc.o.d"
+  "udp_zero_copy_demo"
+  "udp_zero_copy_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_udp_zero_copy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/doc_api"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/doc_api.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/doc_tutorial_html_split"
+  "html/split"
+  "html/tutorial.html"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/doc_tutorial_html_split.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/doc_tutorial_pdf"
+  "tutorial.pdf"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/doc_tutorial_pdf.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
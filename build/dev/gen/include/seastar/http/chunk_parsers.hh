@@ -0,0 +1,160 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 Cloudius Systems, Ltd.
+ */
+
+#pragma once
+
+#include <seastar/core/ragel.hh>
+#include <seastar/core/sstring.hh>
+#include <unordered_map>
+
+namespace seastar {
+    /* ragel shim */
+
+
+
+class http_chunk_size_and_ext_parser : public ragel_parser_base<http_chunk_size_and_ext_parser> {
+    /* ragel shim */
+public:
+    enum class state {
+        error,
+        eof,
+        done,
+    };
+    std::unordered_map<sstring, sstring> _extensions;
+    sstring _name;
+    sstring _value;
+    sstring _size;
+    state _state;
+public:
+    void init() {
+        init_base();
+        _extensions = std::unordered_map<sstring, sstring>();
+        _value = "";
+        _size = "";
+        _state = state::eof;
+    /* ragel shim */
+    }
+    char* parse(char* p, char* pe, char* eof) {
+        sstring_builder::guard g(_builder, p, pe);
+        auto str = [this, &g, &p] { g.mark_end(p); return get_str(); };
+        bool done = false;
+        if (p != pe) {
+            _state = state::error;
+        }
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmisleading-indentation"
+#endif
+    /* ragel shim */
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+        if (!done) {
+            if (p == eof) {
+                _state = state::eof;
+            } else if (p != pe) {
+                _state = state::error;
+            } else {
+                p = nullptr;
+            }
+        } else {
+            _state = state::done;
+        }
+        return p;
+    }
+    auto get_parsed_extensions() {
+        return std::move(_extensions);
+    }
+    auto get_size() {
+        return std::move(_size);
+    }
+    bool eof() const {
+        return _state == state::eof;
+    }
+    bool failed() const {
+        return _state == state::error;
+    }
+};
+    /* ragel shim */
+// the headers in the chunk trailer are parsed the same way as in the request_parser.rl
+
+
+class http_chunk_trailer_parser : public ragel_parser_base<http_chunk_trailer_parser> {
+    /* ragel shim */
+public:
+    enum class state {
+        error,
+        eof,
+        done,
+    };
+    std::unordered_map<sstring, sstring> _headers;
+    sstring _field_name;
+    sstring _value;
+    state _state;
+public:
+    void init() {
+        init_base();
+        _headers = std::unordered_map<sstring, sstring>();
+        _field_name = "";
+        _value = "";
+        _state = state::eof;
+    /* ragel shim */
+    }
+    char* parse(char* p, char* pe, char* eof) {
+        sstring_builder::guard g(_builder, p, pe);
+        auto str = [this, &g, &p] { g.mark_end(p); return get_str(); };
+        bool done = false;
+        if (p != pe) {
+            _state = state::error;
+        }
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmisleading-indentation"
+#endif
+    /* ragel shim */
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+        if (!done) {
+            if (p == eof) {
+                _state = state::eof;
+            } else if (p != pe) {
+                _state = state::error;
+            } else {
+                p = nullptr;
+            }
+        } else {
+            _state = state::done;
+        }
+        return p;
+    }
+    auto get_parsed_headers() {
+        return std::move(_headers);
+    }
+    bool eof() const {
+        return _state == state::eof;
+    }
+    bool failed() const {
+        return _state == state::error;
+    }
+};
+
+}
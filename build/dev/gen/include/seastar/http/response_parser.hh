@@ -0,0 +1,89 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2015 Cloudius Systems, Ltd.
+ */
+
+#include <seastar/core/ragel.hh>
+#include <cstdlib>
+#include <memory>
+#include <unordered_map>
+
+namespace seastar {
+
+struct http_response {
+    sstring _version;
+    int _status_code = 0;
+    std::unordered_map<sstring, sstring> _headers;
+    // not filled by the parser; holds the body when a client buffers it
+    sstring _content;
+};
+    /* ragel shim */
+
+
+
+class http_response_parser : public ragel_parser_base<http_response_parser> {
+    /* ragel shim */
+public:
+    enum class state {
+        error,
+        eof,
+        done,
+    };
+    std::unique_ptr<http_response> _rsp;
+    sstring _field_name;
+    sstring _value;
+    state _state;
+public:
+    void init() {
+        init_base();
+        _rsp.reset(new http_response());
+        _state = state::eof;
+    /* ragel shim */
+    }
+    char* parse(char* p, char* pe, char* eof) {
+        sstring_builder::guard g(_builder, p, pe);
+        auto str = [this, &g, &p] { g.mark_end(p); return get_str(); };
+        bool done = false;
+        if (p != pe) {
+            _state = state::error;
+        }
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmisleading-indentation"
+#endif
+    /* ragel shim */
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+        if (!done) {
+            p = nullptr;
+        } else {
+            _state = state::done;
+        }
+        return p;
+    }
+    auto get_parsed_response() {
+        return std::move(_rsp);
+    }
+    bool eof() const {
+        return _state == state::eof;
+    }
+};
+
+}
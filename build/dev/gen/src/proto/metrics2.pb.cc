@@ -0,0 +1,3129 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: metrics2.proto
+
+#include "metrics2.pb.h"
+
+#include <algorithm>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/reflection_ops.h>
+#include <google/protobuf/wire_format.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+
+PROTOBUF_PRAGMA_INIT_SEG
+
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
+
+namespace io {
+namespace prometheus {
+namespace client {
+PROTOBUF_CONSTEXPR LabelPair::LabelPair(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.value_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}} {}
+struct LabelPairDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR LabelPairDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~LabelPairDefaultTypeInternal() {}
+  union {
+    LabelPair _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 LabelPairDefaultTypeInternal _LabelPair_default_instance_;
+PROTOBUF_CONSTEXPR Gauge::Gauge(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.value_)*/0} {}
+struct GaugeDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR GaugeDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~GaugeDefaultTypeInternal() {}
+  union {
+    Gauge _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 GaugeDefaultTypeInternal _Gauge_default_instance_;
+PROTOBUF_CONSTEXPR Counter::Counter(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.value_)*/0} {}
+struct CounterDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR CounterDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~CounterDefaultTypeInternal() {}
+  union {
+    Counter _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 CounterDefaultTypeInternal _Counter_default_instance_;
+PROTOBUF_CONSTEXPR Quantile::Quantile(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.quantile_)*/0
+  , /*decltype(_impl_.value_)*/0} {}
+struct QuantileDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR QuantileDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~QuantileDefaultTypeInternal() {}
+  union {
+    Quantile _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 QuantileDefaultTypeInternal _Quantile_default_instance_;
+PROTOBUF_CONSTEXPR Summary::Summary(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.quantile_)*/{}
+  , /*decltype(_impl_.sample_count_)*/uint64_t{0u}
+  , /*decltype(_impl_.sample_sum_)*/0} {}
+struct SummaryDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR SummaryDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~SummaryDefaultTypeInternal() {}
+  union {
+    Summary _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 SummaryDefaultTypeInternal _Summary_default_instance_;
+PROTOBUF_CONSTEXPR Untyped::Untyped(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.value_)*/0} {}
+struct UntypedDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR UntypedDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~UntypedDefaultTypeInternal() {}
+  union {
+    Untyped _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 UntypedDefaultTypeInternal _Untyped_default_instance_;
+PROTOBUF_CONSTEXPR Histogram::Histogram(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.bucket_)*/{}
+  , /*decltype(_impl_.sample_count_)*/uint64_t{0u}
+  , /*decltype(_impl_.sample_sum_)*/0} {}
+struct HistogramDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR HistogramDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~HistogramDefaultTypeInternal() {}
+  union {
+    Histogram _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 HistogramDefaultTypeInternal _Histogram_default_instance_;
+PROTOBUF_CONSTEXPR Bucket::Bucket(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.cumulative_count_)*/uint64_t{0u}
+  , /*decltype(_impl_.upper_bound_)*/0} {}
+struct BucketDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR BucketDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~BucketDefaultTypeInternal() {}
+  union {
+    Bucket _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 BucketDefaultTypeInternal _Bucket_default_instance_;
+PROTOBUF_CONSTEXPR Metric::Metric(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.label_)*/{}
+  , /*decltype(_impl_.gauge_)*/nullptr
+  , /*decltype(_impl_.counter_)*/nullptr
+  , /*decltype(_impl_.summary_)*/nullptr
+  , /*decltype(_impl_.untyped_)*/nullptr
+  , /*decltype(_impl_.histogram_)*/nullptr
+  , /*decltype(_impl_.timestamp_ms_)*/int64_t{0}} {}
+struct MetricDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR MetricDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~MetricDefaultTypeInternal() {}
+  union {
+    Metric _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 MetricDefaultTypeInternal _Metric_default_instance_;
+PROTOBUF_CONSTEXPR MetricFamily::MetricFamily(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.metric_)*/{}
+  , /*decltype(_impl_.name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.help_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.type_)*/0} {}
+struct MetricFamilyDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR MetricFamilyDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~MetricFamilyDefaultTypeInternal() {}
+  union {
+    MetricFamily _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 MetricFamilyDefaultTypeInternal _MetricFamily_default_instance_;
+}  // namespace client
+}  // namespace prometheus
+}  // namespace io
+static ::_pb::Metadata file_level_metadata_metrics2_2eproto[10];
+static const ::_pb::EnumDescriptor* file_level_enum_descriptors_metrics2_2eproto[1];
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_metrics2_2eproto = nullptr;
+
+const uint32_t TableStruct_metrics2_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::LabelPair, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::LabelPair, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::LabelPair, _impl_.name_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::LabelPair, _impl_.value_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Gauge, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Gauge, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Gauge, _impl_.value_),
+  0,
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Counter, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Counter, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Counter, _impl_.value_),
+  0,
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Quantile, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Quantile, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Quantile, _impl_.quantile_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Quantile, _impl_.value_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Summary, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Summary, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Summary, _impl_.sample_count_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Summary, _impl_.sample_sum_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Summary, _impl_.quantile_),
+  0,
+  1,
+  ~0u,
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Untyped, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Untyped, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Untyped, _impl_.value_),
+  0,
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Histogram, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Histogram, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Histogram, _impl_.sample_count_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Histogram, _impl_.sample_sum_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Histogram, _impl_.bucket_),
+  0,
+  1,
+  ~0u,
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Bucket, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Bucket, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Bucket, _impl_.cumulative_count_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Bucket, _impl_.upper_bound_),
+  0,
+  1,
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Metric, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Metric, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Metric, _impl_.label_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Metric, _impl_.gauge_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Metric, _impl_.counter_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Metric, _impl_.summary_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Metric, _impl_.untyped_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Metric, _impl_.histogram_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::Metric, _impl_.timestamp_ms_),
+  ~0u,
+  0,
+  1,
+  2,
+  3,
+  4,
+  5,
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::MetricFamily, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::MetricFamily, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::MetricFamily, _impl_.name_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::MetricFamily, _impl_.help_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::MetricFamily, _impl_.type_),
+  PROTOBUF_FIELD_OFFSET(::io::prometheus::client::MetricFamily, _impl_.metric_),
+  0,
+  1,
+  2,
+  ~0u,
+};
+static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  { 0, 8, -1, sizeof(::io::prometheus::client::LabelPair)},
+  { 10, 17, -1, sizeof(::io::prometheus::client::Gauge)},
+  { 18, 25, -1, sizeof(::io::prometheus::client::Counter)},
+  { 26, 34, -1, sizeof(::io::prometheus::client::Quantile)},
+  { 36, 45, -1, sizeof(::io::prometheus::client::Summary)},
+  { 48, 55, -1, sizeof(::io::prometheus::client::Untyped)},
+  { 56, 65, -1, sizeof(::io::prometheus::client::Histogram)},
+  { 68, 76, -1, sizeof(::io::prometheus::client::Bucket)},
+  { 78, 91, -1, sizeof(::io::prometheus::client::Metric)},
+  { 98, 108, -1, sizeof(::io::prometheus::client::MetricFamily)},
+};
+
+static const ::_pb::Message* const file_default_instances[] = {
+  &::io::prometheus::client::_LabelPair_default_instance_._instance,
+  &::io::prometheus::client::_Gauge_default_instance_._instance,
+  &::io::prometheus::client::_Counter_default_instance_._instance,
+  &::io::prometheus::client::_Quantile_default_instance_._instance,
+  &::io::prometheus::client::_Summary_default_instance_._instance,
+  &::io::prometheus::client::_Untyped_default_instance_._instance,
+  &::io::prometheus::client::_Histogram_default_instance_._instance,
+  &::io::prometheus::client::_Bucket_default_instance_._instance,
+  &::io::prometheus::client::_Metric_default_instance_._instance,
+  &::io::prometheus::client::_MetricFamily_default_instance_._instance,
+};
+
+const char descriptor_table_protodef_metrics2_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
+  "\n\016metrics2.proto\022\024io.prometheus.client\"("
+  "\n\tLabelPair\022\014\n\004name\030\001 \001(\t\022\r\n\005value\030\002 \001(\t"
+  "\"\026\n\005Gauge\022\r\n\005value\030\001 \001(\001\"\030\n\007Counter\022\r\n\005v"
+  "alue\030\001 \001(\001\"+\n\010Quantile\022\020\n\010quantile\030\001 \001(\001"
+  "\022\r\n\005value\030\002 \001(\001\"e\n\007Summary\022\024\n\014sample_cou"
+  "nt\030\001 \001(\004\022\022\n\nsample_sum\030\002 \001(\001\0220\n\010quantile"
+  "\030\003 \003(\0132\036.io.prometheus.client.Quantile\"\030"
+  "\n\007Untyped\022\r\n\005value\030\001 \001(\001\"c\n\tHistogram\022\024\n"
+  "\014sample_count\030\001 \001(\004\022\022\n\nsample_sum\030\002 \001(\001\022"
+  ",\n\006bucket\030\003 \003(\0132\034.io.prometheus.client.B"
+  "ucket\"7\n\006Bucket\022\030\n\020cumulative_count\030\001 \001("
+  "\004\022\023\n\013upper_bound\030\002 \001(\001\"\276\002\n\006Metric\022.\n\005lab"
+  "el\030\001 \003(\0132\037.io.prometheus.client.LabelPai"
+  "r\022*\n\005gauge\030\002 \001(\0132\033.io.prometheus.client."
+  "Gauge\022.\n\007counter\030\003 \001(\0132\035.io.prometheus.c"
+  "lient.Counter\022.\n\007summary\030\004 \001(\0132\035.io.prom"
+  "etheus.client.Summary\022.\n\007untyped\030\005 \001(\0132\035"
+  ".io.prometheus.client.Untyped\0222\n\thistogr"
+  "am\030\007 \001(\0132\037.io.prometheus.client.Histogra"
+  "m\022\024\n\014timestamp_ms\030\006 \001(\003\"\210\001\n\014MetricFamily"
+  "\022\014\n\004name\030\001 \001(\t\022\014\n\004help\030\002 \001(\t\022.\n\004type\030\003 \001"
+  "(\0162 .io.prometheus.client.MetricType\022,\n\006"
+  "metric\030\004 \003(\0132\034.io.prometheus.client.Metr"
+  "ic*M\n\nMetricType\022\013\n\007COUNTER\020\000\022\t\n\005GAUGE\020\001"
+  "\022\013\n\007SUMMARY\020\002\022\013\n\007UNTYPED\020\003\022\r\n\tHISTOGRAM\020"
+  "\004B\026\n\024io.prometheus.client"
+  ;
+static ::_pbi::once_flag descriptor_table_metrics2_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_metrics2_2eproto = {
+    false, false, 1025, descriptor_table_protodef_metrics2_2eproto,
+    "metrics2.proto",
+    &descriptor_table_metrics2_2eproto_once, nullptr, 0, 10,
+    schemas, file_default_instances, TableStruct_metrics2_2eproto::offsets,
+    file_level_metadata_metrics2_2eproto, file_level_enum_descriptors_metrics2_2eproto,
+    file_level_service_descriptors_metrics2_2eproto,
+};
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_metrics2_2eproto_getter() {
+  return &descriptor_table_metrics2_2eproto;
+}
+
+// Force running AddDescriptors() at dynamic initialization time.
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_metrics2_2eproto(&descriptor_table_metrics2_2eproto);
+namespace io {
+namespace prometheus {
+namespace client {
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* MetricType_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_metrics2_2eproto);
+  return file_level_enum_descriptors_metrics2_2eproto[0];
+}
+bool MetricType_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+    case 4:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+// ===================================================================
+
+class LabelPair::_Internal {
+ public:
+  using HasBits = decltype(std::declval<LabelPair>()._impl_._has_bits_);
+  static void set_has_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_value(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
+
+LabelPair::LabelPair(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:io.prometheus.client.LabelPair)
+}
+LabelPair::LabelPair(const LabelPair& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  LabelPair* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.value_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_name()) {
+    _this->_impl_.name_.Set(from._internal_name(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.value_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.value_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_value()) {
+    _this->_impl_.value_.Set(from._internal_value(), 
+      _this->GetArenaForAllocation());
+  }
+  // @@protoc_insertion_point(copy_constructor:io.prometheus.client.LabelPair)
+}
+
+inline void LabelPair::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.value_){}
+  };
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.value_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.value_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+LabelPair::~LabelPair() {
+  // @@protoc_insertion_point(destructor:io.prometheus.client.LabelPair)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void LabelPair::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.name_.Destroy();
+  _impl_.value_.Destroy();
+}
+
+void LabelPair::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void LabelPair::Clear() {
+// @@protoc_insertion_point(message_clear_start:io.prometheus.client.LabelPair)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.name_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _impl_.value_.ClearNonDefaultToEmpty();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* LabelPair::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional string name = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "io.prometheus.client.LabelPair.name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      // optional string value = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_value();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "io.prometheus.client.LabelPair.value");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* LabelPair::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:io.prometheus.client.LabelPair)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional string name = 1;
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_name().data(), static_cast<int>(this->_internal_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "io.prometheus.client.LabelPair.name");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_name(), target);
+  }
+
+  // optional string value = 2;
+  if (cached_has_bits & 0x00000002u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_value().data(), static_cast<int>(this->_internal_value().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "io.prometheus.client.LabelPair.value");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_value(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:io.prometheus.client.LabelPair)
+  return target;
+}
+
+size_t LabelPair::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:io.prometheus.client.LabelPair)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional string name = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_name());
+    }
+
+    // optional string value = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_value());
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData LabelPair::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    LabelPair::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*LabelPair::GetClassData() const { return &_class_data_; }
+
+
+void LabelPair::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<LabelPair*>(&to_msg);
+  auto& from = static_cast<const LabelPair&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:io.prometheus.client.LabelPair)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_name(from._internal_name());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_set_value(from._internal_value());
+    }
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void LabelPair::CopyFrom(const LabelPair& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:io.prometheus.client.LabelPair)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool LabelPair::IsInitialized() const {
+  return true;
+}
+
+void LabelPair::InternalSwap(LabelPair* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.name_, lhs_arena,
+      &other->_impl_.name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.value_, lhs_arena,
+      &other->_impl_.value_, rhs_arena
+  );
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata LabelPair::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_metrics2_2eproto_getter, &descriptor_table_metrics2_2eproto_once,
+      file_level_metadata_metrics2_2eproto[0]);
+}
+
+// ===================================================================
+
+class Gauge::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Gauge>()._impl_._has_bits_);
+  static void set_has_value(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+};
+
+Gauge::Gauge(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:io.prometheus.client.Gauge)
+}
+Gauge::Gauge(const Gauge& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Gauge* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.value_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.value_ = from._impl_.value_;
+  // @@protoc_insertion_point(copy_constructor:io.prometheus.client.Gauge)
+}
+
+inline void Gauge::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.value_){0}
+  };
+}
+
+Gauge::~Gauge() {
+  // @@protoc_insertion_point(destructor:io.prometheus.client.Gauge)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Gauge::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void Gauge::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Gauge::Clear() {
+// @@protoc_insertion_point(message_clear_start:io.prometheus.client.Gauge)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.value_ = 0;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Gauge::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional double value = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 9)) {
+          _Internal::set_has_value(&has_bits);
+          _impl_.value_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Gauge::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:io.prometheus.client.Gauge)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional double value = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(1, this->_internal_value(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:io.prometheus.client.Gauge)
+  return target;
+}
+
+size_t Gauge::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:io.prometheus.client.Gauge)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // optional double value = 1;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    total_size += 1 + 8;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Gauge::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Gauge::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Gauge::GetClassData() const { return &_class_data_; }
+
+
+void Gauge::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Gauge*>(&to_msg);
+  auto& from = static_cast<const Gauge&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:io.prometheus.client.Gauge)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from._internal_has_value()) {
+    _this->_internal_set_value(from._internal_value());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Gauge::CopyFrom(const Gauge& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:io.prometheus.client.Gauge)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Gauge::IsInitialized() const {
+  return true;
+}
+
+void Gauge::InternalSwap(Gauge* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  swap(_impl_.value_, other->_impl_.value_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Gauge::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_metrics2_2eproto_getter, &descriptor_table_metrics2_2eproto_once,
+      file_level_metadata_metrics2_2eproto[1]);
+}
+
+// ===================================================================
+
+class Counter::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Counter>()._impl_._has_bits_);
+  static void set_has_value(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+};
+
+Counter::Counter(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:io.prometheus.client.Counter)
+}
+Counter::Counter(const Counter& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Counter* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.value_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.value_ = from._impl_.value_;
+  // @@protoc_insertion_point(copy_constructor:io.prometheus.client.Counter)
+}
+
+inline void Counter::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.value_){0}
+  };
+}
+
+Counter::~Counter() {
+  // @@protoc_insertion_point(destructor:io.prometheus.client.Counter)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Counter::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void Counter::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Counter::Clear() {
+// @@protoc_insertion_point(message_clear_start:io.prometheus.client.Counter)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.value_ = 0;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Counter::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional double value = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 9)) {
+          _Internal::set_has_value(&has_bits);
+          _impl_.value_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Counter::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:io.prometheus.client.Counter)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional double value = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(1, this->_internal_value(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:io.prometheus.client.Counter)
+  return target;
+}
+
+size_t Counter::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:io.prometheus.client.Counter)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // optional double value = 1;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    total_size += 1 + 8;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Counter::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Counter::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Counter::GetClassData() const { return &_class_data_; }
+
+
+void Counter::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Counter*>(&to_msg);
+  auto& from = static_cast<const Counter&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:io.prometheus.client.Counter)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from._internal_has_value()) {
+    _this->_internal_set_value(from._internal_value());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Counter::CopyFrom(const Counter& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:io.prometheus.client.Counter)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Counter::IsInitialized() const {
+  return true;
+}
+
+void Counter::InternalSwap(Counter* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  swap(_impl_.value_, other->_impl_.value_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Counter::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_metrics2_2eproto_getter, &descriptor_table_metrics2_2eproto_once,
+      file_level_metadata_metrics2_2eproto[2]);
+}
+
+// ===================================================================
+
+class Quantile::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Quantile>()._impl_._has_bits_);
+  static void set_has_quantile(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_value(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
+
+Quantile::Quantile(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:io.prometheus.client.Quantile)
+}
+Quantile::Quantile(const Quantile& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Quantile* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.quantile_){}
+    , decltype(_impl_.value_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.quantile_, &from._impl_.quantile_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.value_) -
+    reinterpret_cast<char*>(&_impl_.quantile_)) + sizeof(_impl_.value_));
+  // @@protoc_insertion_point(copy_constructor:io.prometheus.client.Quantile)
+}
+
+inline void Quantile::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.quantile_){0}
+    , decltype(_impl_.value_){0}
+  };
+}
+
+Quantile::~Quantile() {
+  // @@protoc_insertion_point(destructor:io.prometheus.client.Quantile)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Quantile::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void Quantile::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Quantile::Clear() {
+// @@protoc_insertion_point(message_clear_start:io.prometheus.client.Quantile)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    ::memset(&_impl_.quantile_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.value_) -
+        reinterpret_cast<char*>(&_impl_.quantile_)) + sizeof(_impl_.value_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Quantile::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional double quantile = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 9)) {
+          _Internal::set_has_quantile(&has_bits);
+          _impl_.quantile_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double value = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_value(&has_bits);
+          _impl_.value_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Quantile::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:io.prometheus.client.Quantile)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional double quantile = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(1, this->_internal_quantile(), target);
+  }
+
+  // optional double value = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_value(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:io.prometheus.client.Quantile)
+  return target;
+}
+
+size_t Quantile::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:io.prometheus.client.Quantile)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional double quantile = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double value = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 8;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Quantile::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Quantile::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Quantile::GetClassData() const { return &_class_data_; }
+
+
+void Quantile::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Quantile*>(&to_msg);
+  auto& from = static_cast<const Quantile&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:io.prometheus.client.Quantile)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.quantile_ = from._impl_.quantile_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.value_ = from._impl_.value_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Quantile::CopyFrom(const Quantile& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:io.prometheus.client.Quantile)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Quantile::IsInitialized() const {
+  return true;
+}
+
+void Quantile::InternalSwap(Quantile* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Quantile, _impl_.value_)
+      + sizeof(Quantile::_impl_.value_)
+      - PROTOBUF_FIELD_OFFSET(Quantile, _impl_.quantile_)>(
+          reinterpret_cast<char*>(&_impl_.quantile_),
+          reinterpret_cast<char*>(&other->_impl_.quantile_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Quantile::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_metrics2_2eproto_getter, &descriptor_table_metrics2_2eproto_once,
+      file_level_metadata_metrics2_2eproto[3]);
+}
+
+// ===================================================================
+
+class Summary::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Summary>()._impl_._has_bits_);
+  static void set_has_sample_count(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_sample_sum(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
+
+Summary::Summary(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:io.prometheus.client.Summary)
+}
+Summary::Summary(const Summary& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Summary* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.quantile_){from._impl_.quantile_}
+    , decltype(_impl_.sample_count_){}
+    , decltype(_impl_.sample_sum_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.sample_count_, &from._impl_.sample_count_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.sample_sum_) -
+    reinterpret_cast<char*>(&_impl_.sample_count_)) + sizeof(_impl_.sample_sum_));
+  // @@protoc_insertion_point(copy_constructor:io.prometheus.client.Summary)
+}
+
+inline void Summary::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.quantile_){arena}
+    , decltype(_impl_.sample_count_){uint64_t{0u}}
+    , decltype(_impl_.sample_sum_){0}
+  };
+}
+
+Summary::~Summary() {
+  // @@protoc_insertion_point(destructor:io.prometheus.client.Summary)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Summary::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.quantile_.~RepeatedPtrField();
+}
+
+void Summary::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Summary::Clear() {
+// @@protoc_insertion_point(message_clear_start:io.prometheus.client.Summary)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.quantile_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    ::memset(&_impl_.sample_count_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.sample_sum_) -
+        reinterpret_cast<char*>(&_impl_.sample_count_)) + sizeof(_impl_.sample_sum_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Summary::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional uint64 sample_count = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_sample_count(&has_bits);
+          _impl_.sample_count_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double sample_sum = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_sample_sum(&has_bits);
+          _impl_.sample_sum_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .io.prometheus.client.Quantile quantile = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_quantile(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<26>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Summary::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:io.prometheus.client.Summary)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional uint64 sample_count = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(1, this->_internal_sample_count(), target);
+  }
+
+  // optional double sample_sum = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_sample_sum(), target);
+  }
+
+  // repeated .io.prometheus.client.Quantile quantile = 3;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_quantile_size()); i < n; i++) {
+    const auto& repfield = this->_internal_quantile(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(3, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:io.prometheus.client.Summary)
+  return target;
+}
+
+size_t Summary::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:io.prometheus.client.Summary)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .io.prometheus.client.Quantile quantile = 3;
+  total_size += 1UL * this->_internal_quantile_size();
+  for (const auto& msg : this->_impl_.quantile_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional uint64 sample_count = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_sample_count());
+    }
+
+    // optional double sample_sum = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 8;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Summary::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Summary::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Summary::GetClassData() const { return &_class_data_; }
+
+
+void Summary::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Summary*>(&to_msg);
+  auto& from = static_cast<const Summary&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:io.prometheus.client.Summary)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.quantile_.MergeFrom(from._impl_.quantile_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.sample_count_ = from._impl_.sample_count_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.sample_sum_ = from._impl_.sample_sum_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Summary::CopyFrom(const Summary& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:io.prometheus.client.Summary)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Summary::IsInitialized() const {
+  return true;
+}
+
+void Summary::InternalSwap(Summary* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.quantile_.InternalSwap(&other->_impl_.quantile_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Summary, _impl_.sample_sum_)
+      + sizeof(Summary::_impl_.sample_sum_)
+      - PROTOBUF_FIELD_OFFSET(Summary, _impl_.sample_count_)>(
+          reinterpret_cast<char*>(&_impl_.sample_count_),
+          reinterpret_cast<char*>(&other->_impl_.sample_count_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Summary::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_metrics2_2eproto_getter, &descriptor_table_metrics2_2eproto_once,
+      file_level_metadata_metrics2_2eproto[4]);
+}
+
+// ===================================================================
+
+class Untyped::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Untyped>()._impl_._has_bits_);
+  static void set_has_value(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+};
+
+Untyped::Untyped(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:io.prometheus.client.Untyped)
+}
+Untyped::Untyped(const Untyped& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Untyped* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.value_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.value_ = from._impl_.value_;
+  // @@protoc_insertion_point(copy_constructor:io.prometheus.client.Untyped)
+}
+
+inline void Untyped::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.value_){0}
+  };
+}
+
+Untyped::~Untyped() {
+  // @@protoc_insertion_point(destructor:io.prometheus.client.Untyped)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Untyped::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void Untyped::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Untyped::Clear() {
+// @@protoc_insertion_point(message_clear_start:io.prometheus.client.Untyped)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.value_ = 0;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Untyped::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional double value = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 9)) {
+          _Internal::set_has_value(&has_bits);
+          _impl_.value_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Untyped::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:io.prometheus.client.Untyped)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional double value = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(1, this->_internal_value(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:io.prometheus.client.Untyped)
+  return target;
+}
+
+size_t Untyped::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:io.prometheus.client.Untyped)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // optional double value = 1;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    total_size += 1 + 8;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Untyped::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Untyped::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Untyped::GetClassData() const { return &_class_data_; }
+
+
+void Untyped::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Untyped*>(&to_msg);
+  auto& from = static_cast<const Untyped&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:io.prometheus.client.Untyped)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from._internal_has_value()) {
+    _this->_internal_set_value(from._internal_value());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Untyped::CopyFrom(const Untyped& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:io.prometheus.client.Untyped)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Untyped::IsInitialized() const {
+  return true;
+}
+
+void Untyped::InternalSwap(Untyped* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  swap(_impl_.value_, other->_impl_.value_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Untyped::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_metrics2_2eproto_getter, &descriptor_table_metrics2_2eproto_once,
+      file_level_metadata_metrics2_2eproto[5]);
+}
+
+// ===================================================================
+
+class Histogram::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Histogram>()._impl_._has_bits_);
+  static void set_has_sample_count(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_sample_sum(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
+
+Histogram::Histogram(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:io.prometheus.client.Histogram)
+}
+Histogram::Histogram(const Histogram& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Histogram* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.bucket_){from._impl_.bucket_}
+    , decltype(_impl_.sample_count_){}
+    , decltype(_impl_.sample_sum_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.sample_count_, &from._impl_.sample_count_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.sample_sum_) -
+    reinterpret_cast<char*>(&_impl_.sample_count_)) + sizeof(_impl_.sample_sum_));
+  // @@protoc_insertion_point(copy_constructor:io.prometheus.client.Histogram)
+}
+
+inline void Histogram::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.bucket_){arena}
+    , decltype(_impl_.sample_count_){uint64_t{0u}}
+    , decltype(_impl_.sample_sum_){0}
+  };
+}
+
+Histogram::~Histogram() {
+  // @@protoc_insertion_point(destructor:io.prometheus.client.Histogram)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Histogram::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.bucket_.~RepeatedPtrField();
+}
+
+void Histogram::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Histogram::Clear() {
+// @@protoc_insertion_point(message_clear_start:io.prometheus.client.Histogram)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.bucket_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    ::memset(&_impl_.sample_count_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.sample_sum_) -
+        reinterpret_cast<char*>(&_impl_.sample_count_)) + sizeof(_impl_.sample_sum_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Histogram::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional uint64 sample_count = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_sample_count(&has_bits);
+          _impl_.sample_count_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double sample_sum = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_sample_sum(&has_bits);
+          _impl_.sample_sum_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .io.prometheus.client.Bucket bucket = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_bucket(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<26>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Histogram::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:io.prometheus.client.Histogram)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional uint64 sample_count = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(1, this->_internal_sample_count(), target);
+  }
+
+  // optional double sample_sum = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_sample_sum(), target);
+  }
+
+  // repeated .io.prometheus.client.Bucket bucket = 3;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_bucket_size()); i < n; i++) {
+    const auto& repfield = this->_internal_bucket(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(3, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:io.prometheus.client.Histogram)
+  return target;
+}
+
+size_t Histogram::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:io.prometheus.client.Histogram)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .io.prometheus.client.Bucket bucket = 3;
+  total_size += 1UL * this->_internal_bucket_size();
+  for (const auto& msg : this->_impl_.bucket_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional uint64 sample_count = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_sample_count());
+    }
+
+    // optional double sample_sum = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 8;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Histogram::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Histogram::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Histogram::GetClassData() const { return &_class_data_; }
+
+
+void Histogram::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Histogram*>(&to_msg);
+  auto& from = static_cast<const Histogram&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:io.prometheus.client.Histogram)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.bucket_.MergeFrom(from._impl_.bucket_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.sample_count_ = from._impl_.sample_count_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.sample_sum_ = from._impl_.sample_sum_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Histogram::CopyFrom(const Histogram& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:io.prometheus.client.Histogram)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Histogram::IsInitialized() const {
+  return true;
+}
+
+void Histogram::InternalSwap(Histogram* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.bucket_.InternalSwap(&other->_impl_.bucket_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Histogram, _impl_.sample_sum_)
+      + sizeof(Histogram::_impl_.sample_sum_)
+      - PROTOBUF_FIELD_OFFSET(Histogram, _impl_.sample_count_)>(
+          reinterpret_cast<char*>(&_impl_.sample_count_),
+          reinterpret_cast<char*>(&other->_impl_.sample_count_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Histogram::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_metrics2_2eproto_getter, &descriptor_table_metrics2_2eproto_once,
+      file_level_metadata_metrics2_2eproto[6]);
+}
+
+// ===================================================================
+
+class Bucket::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Bucket>()._impl_._has_bits_);
+  static void set_has_cumulative_count(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_upper_bound(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
+
+Bucket::Bucket(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:io.prometheus.client.Bucket)
+}
+Bucket::Bucket(const Bucket& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Bucket* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.cumulative_count_){}
+    , decltype(_impl_.upper_bound_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.cumulative_count_, &from._impl_.cumulative_count_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.upper_bound_) -
+    reinterpret_cast<char*>(&_impl_.cumulative_count_)) + sizeof(_impl_.upper_bound_));
+  // @@protoc_insertion_point(copy_constructor:io.prometheus.client.Bucket)
+}
+
+inline void Bucket::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.cumulative_count_){uint64_t{0u}}
+    , decltype(_impl_.upper_bound_){0}
+  };
+}
+
+Bucket::~Bucket() {
+  // @@protoc_insertion_point(destructor:io.prometheus.client.Bucket)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Bucket::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void Bucket::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Bucket::Clear() {
+// @@protoc_insertion_point(message_clear_start:io.prometheus.client.Bucket)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    ::memset(&_impl_.cumulative_count_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.upper_bound_) -
+        reinterpret_cast<char*>(&_impl_.cumulative_count_)) + sizeof(_impl_.upper_bound_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Bucket::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional uint64 cumulative_count = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_cumulative_count(&has_bits);
+          _impl_.cumulative_count_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double upper_bound = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 17)) {
+          _Internal::set_has_upper_bound(&has_bits);
+          _impl_.upper_bound_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Bucket::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:io.prometheus.client.Bucket)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional uint64 cumulative_count = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(1, this->_internal_cumulative_count(), target);
+  }
+
+  // optional double upper_bound = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(2, this->_internal_upper_bound(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:io.prometheus.client.Bucket)
+  return target;
+}
+
+size_t Bucket::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:io.prometheus.client.Bucket)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional uint64 cumulative_count = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_cumulative_count());
+    }
+
+    // optional double upper_bound = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 8;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Bucket::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Bucket::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Bucket::GetClassData() const { return &_class_data_; }
+
+
+void Bucket::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Bucket*>(&to_msg);
+  auto& from = static_cast<const Bucket&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:io.prometheus.client.Bucket)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.cumulative_count_ = from._impl_.cumulative_count_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.upper_bound_ = from._impl_.upper_bound_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Bucket::CopyFrom(const Bucket& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:io.prometheus.client.Bucket)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Bucket::IsInitialized() const {
+  return true;
+}
+
+void Bucket::InternalSwap(Bucket* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Bucket, _impl_.upper_bound_)
+      + sizeof(Bucket::_impl_.upper_bound_)
+      - PROTOBUF_FIELD_OFFSET(Bucket, _impl_.cumulative_count_)>(
+          reinterpret_cast<char*>(&_impl_.cumulative_count_),
+          reinterpret_cast<char*>(&other->_impl_.cumulative_count_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Bucket::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_metrics2_2eproto_getter, &descriptor_table_metrics2_2eproto_once,
+      file_level_metadata_metrics2_2eproto[7]);
+}
+
+// ===================================================================
+
+class Metric::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Metric>()._impl_._has_bits_);
+  static const ::io::prometheus::client::Gauge& gauge(const Metric* msg);
+  static void set_has_gauge(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::io::prometheus::client::Counter& counter(const Metric* msg);
+  static void set_has_counter(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static const ::io::prometheus::client::Summary& summary(const Metric* msg);
+  static void set_has_summary(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static const ::io::prometheus::client::Untyped& untyped(const Metric* msg);
+  static void set_has_untyped(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static const ::io::prometheus::client::Histogram& histogram(const Metric* msg);
+  static void set_has_histogram(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static void set_has_timestamp_ms(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+};
+
+const ::io::prometheus::client::Gauge&
+Metric::_Internal::gauge(const Metric* msg) {
+  return *msg->_impl_.gauge_;
+}
+const ::io::prometheus::client::Counter&
+Metric::_Internal::counter(const Metric* msg) {
+  return *msg->_impl_.counter_;
+}
+const ::io::prometheus::client::Summary&
+Metric::_Internal::summary(const Metric* msg) {
+  return *msg->_impl_.summary_;
+}
+const ::io::prometheus::client::Untyped&
+Metric::_Internal::untyped(const Metric* msg) {
+  return *msg->_impl_.untyped_;
+}
+const ::io::prometheus::client::Histogram&
+Metric::_Internal::histogram(const Metric* msg) {
+  return *msg->_impl_.histogram_;
+}
+Metric::Metric(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:io.prometheus.client.Metric)
+}
+Metric::Metric(const Metric& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Metric* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.label_){from._impl_.label_}
+    , decltype(_impl_.gauge_){nullptr}
+    , decltype(_impl_.counter_){nullptr}
+    , decltype(_impl_.summary_){nullptr}
+    , decltype(_impl_.untyped_){nullptr}
+    , decltype(_impl_.histogram_){nullptr}
+    , decltype(_impl_.timestamp_ms_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  if (from._internal_has_gauge()) {
+    _this->_impl_.gauge_ = new ::io::prometheus::client::Gauge(*from._impl_.gauge_);
+  }
+  if (from._internal_has_counter()) {
+    _this->_impl_.counter_ = new ::io::prometheus::client::Counter(*from._impl_.counter_);
+  }
+  if (from._internal_has_summary()) {
+    _this->_impl_.summary_ = new ::io::prometheus::client::Summary(*from._impl_.summary_);
+  }
+  if (from._internal_has_untyped()) {
+    _this->_impl_.untyped_ = new ::io::prometheus::client::Untyped(*from._impl_.untyped_);
+  }
+  if (from._internal_has_histogram()) {
+    _this->_impl_.histogram_ = new ::io::prometheus::client::Histogram(*from._impl_.histogram_);
+  }
+  _this->_impl_.timestamp_ms_ = from._impl_.timestamp_ms_;
+  // @@protoc_insertion_point(copy_constructor:io.prometheus.client.Metric)
+}
+
+inline void Metric::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.label_){arena}
+    , decltype(_impl_.gauge_){nullptr}
+    , decltype(_impl_.counter_){nullptr}
+    , decltype(_impl_.summary_){nullptr}
+    , decltype(_impl_.untyped_){nullptr}
+    , decltype(_impl_.histogram_){nullptr}
+    , decltype(_impl_.timestamp_ms_){int64_t{0}}
+  };
+}
+
+Metric::~Metric() {
+  // @@protoc_insertion_point(destructor:io.prometheus.client.Metric)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Metric::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.label_.~RepeatedPtrField();
+  if (this != internal_default_instance()) delete _impl_.gauge_;
+  if (this != internal_default_instance()) delete _impl_.counter_;
+  if (this != internal_default_instance()) delete _impl_.summary_;
+  if (this != internal_default_instance()) delete _impl_.untyped_;
+  if (this != internal_default_instance()) delete _impl_.histogram_;
+}
+
+void Metric::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Metric::Clear() {
+// @@protoc_insertion_point(message_clear_start:io.prometheus.client.Metric)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.label_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000001fu) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.gauge_ != nullptr);
+      _impl_.gauge_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.counter_ != nullptr);
+      _impl_.counter_->Clear();
+    }
+    if (cached_has_bits & 0x00000004u) {
+      GOOGLE_DCHECK(_impl_.summary_ != nullptr);
+      _impl_.summary_->Clear();
+    }
+    if (cached_has_bits & 0x00000008u) {
+      GOOGLE_DCHECK(_impl_.untyped_ != nullptr);
+      _impl_.untyped_->Clear();
+    }
+    if (cached_has_bits & 0x00000010u) {
+      GOOGLE_DCHECK(_impl_.histogram_ != nullptr);
+      _impl_.histogram_->Clear();
+    }
+  }
+  _impl_.timestamp_ms_ = int64_t{0};
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Metric::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated .io.prometheus.client.LabelPair label = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_label(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .io.prometheus.client.Gauge gauge = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_gauge(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .io.prometheus.client.Counter counter = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ctx->ParseMessage(_internal_mutable_counter(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .io.prometheus.client.Summary summary = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr = ctx->ParseMessage(_internal_mutable_summary(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .io.prometheus.client.Untyped untyped = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 42)) {
+          ptr = ctx->ParseMessage(_internal_mutable_untyped(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional int64 timestamp_ms = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _Internal::set_has_timestamp_ms(&has_bits);
+          _impl_.timestamp_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .io.prometheus.client.Histogram histogram = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 58)) {
+          ptr = ctx->ParseMessage(_internal_mutable_histogram(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Metric::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:io.prometheus.client.Metric)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .io.prometheus.client.LabelPair label = 1;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_label_size()); i < n; i++) {
+    const auto& repfield = this->_internal_label(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(1, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional .io.prometheus.client.Gauge gauge = 2;
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::gauge(this),
+        _Internal::gauge(this).GetCachedSize(), target, stream);
+  }
+
+  // optional .io.prometheus.client.Counter counter = 3;
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, _Internal::counter(this),
+        _Internal::counter(this).GetCachedSize(), target, stream);
+  }
+
+  // optional .io.prometheus.client.Summary summary = 4;
+  if (cached_has_bits & 0x00000004u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(4, _Internal::summary(this),
+        _Internal::summary(this).GetCachedSize(), target, stream);
+  }
+
+  // optional .io.prometheus.client.Untyped untyped = 5;
+  if (cached_has_bits & 0x00000008u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(5, _Internal::untyped(this),
+        _Internal::untyped(this).GetCachedSize(), target, stream);
+  }
+
+  // optional int64 timestamp_ms = 6;
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(6, this->_internal_timestamp_ms(), target);
+  }
+
+  // optional .io.prometheus.client.Histogram histogram = 7;
+  if (cached_has_bits & 0x00000010u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(7, _Internal::histogram(this),
+        _Internal::histogram(this).GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:io.prometheus.client.Metric)
+  return target;
+}
+
+size_t Metric::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:io.prometheus.client.Metric)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .io.prometheus.client.LabelPair label = 1;
+  total_size += 1UL * this->_internal_label_size();
+  for (const auto& msg : this->_impl_.label_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    // optional .io.prometheus.client.Gauge gauge = 2;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.gauge_);
+    }
+
+    // optional .io.prometheus.client.Counter counter = 3;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.counter_);
+    }
+
+    // optional .io.prometheus.client.Summary summary = 4;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.summary_);
+    }
+
+    // optional .io.prometheus.client.Untyped untyped = 5;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.untyped_);
+    }
+
+    // optional .io.prometheus.client.Histogram histogram = 7;
+    if (cached_has_bits & 0x00000010u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.histogram_);
+    }
+
+    // optional int64 timestamp_ms = 6;
+    if (cached_has_bits & 0x00000020u) {
+      total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_timestamp_ms());
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Metric::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Metric::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Metric::GetClassData() const { return &_class_data_; }
+
+
+void Metric::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Metric*>(&to_msg);
+  auto& from = static_cast<const Metric&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:io.prometheus.client.Metric)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.label_.MergeFrom(from._impl_.label_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_gauge()->::io::prometheus::client::Gauge::MergeFrom(
+          from._internal_gauge());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_counter()->::io::prometheus::client::Counter::MergeFrom(
+          from._internal_counter());
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_mutable_summary()->::io::prometheus::client::Summary::MergeFrom(
+          from._internal_summary());
+    }
+    if (cached_has_bits & 0x00000008u) {
+      _this->_internal_mutable_untyped()->::io::prometheus::client::Untyped::MergeFrom(
+          from._internal_untyped());
+    }
+    if (cached_has_bits & 0x00000010u) {
+      _this->_internal_mutable_histogram()->::io::prometheus::client::Histogram::MergeFrom(
+          from._internal_histogram());
+    }
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.timestamp_ms_ = from._impl_.timestamp_ms_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Metric::CopyFrom(const Metric& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:io.prometheus.client.Metric)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Metric::IsInitialized() const {
+  return true;
+}
+
+void Metric::InternalSwap(Metric* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.label_.InternalSwap(&other->_impl_.label_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Metric, _impl_.timestamp_ms_)
+      + sizeof(Metric::_impl_.timestamp_ms_)
+      - PROTOBUF_FIELD_OFFSET(Metric, _impl_.gauge_)>(
+          reinterpret_cast<char*>(&_impl_.gauge_),
+          reinterpret_cast<char*>(&other->_impl_.gauge_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Metric::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_metrics2_2eproto_getter, &descriptor_table_metrics2_2eproto_once,
+      file_level_metadata_metrics2_2eproto[8]);
+}
+
+// ===================================================================
+
+class MetricFamily::_Internal {
+ public:
+  using HasBits = decltype(std::declval<MetricFamily>()._impl_._has_bits_);
+  static void set_has_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_help(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_type(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+};
+
+MetricFamily::MetricFamily(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:io.prometheus.client.MetricFamily)
+}
+MetricFamily::MetricFamily(const MetricFamily& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  MetricFamily* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.metric_){from._impl_.metric_}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.help_){}
+    , decltype(_impl_.type_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_name()) {
+    _this->_impl_.name_.Set(from._internal_name(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.help_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.help_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_help()) {
+    _this->_impl_.help_.Set(from._internal_help(), 
+      _this->GetArenaForAllocation());
+  }
+  _this->_impl_.type_ = from._impl_.type_;
+  // @@protoc_insertion_point(copy_constructor:io.prometheus.client.MetricFamily)
+}
+
+inline void MetricFamily::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.metric_){arena}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.help_){}
+    , decltype(_impl_.type_){0}
+  };
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.help_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.help_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+MetricFamily::~MetricFamily() {
+  // @@protoc_insertion_point(destructor:io.prometheus.client.MetricFamily)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void MetricFamily::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.metric_.~RepeatedPtrField();
+  _impl_.name_.Destroy();
+  _impl_.help_.Destroy();
+}
+
+void MetricFamily::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void MetricFamily::Clear() {
+// @@protoc_insertion_point(message_clear_start:io.prometheus.client.MetricFamily)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.metric_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.name_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _impl_.help_.ClearNonDefaultToEmpty();
+    }
+  }
+  _impl_.type_ = 0;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* MetricFamily::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional string name = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "io.prometheus.client.MetricFamily.name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      // optional string help = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_help();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "io.prometheus.client.MetricFamily.help");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .io.prometheus.client.MetricType type = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          if (PROTOBUF_PREDICT_TRUE(::io::prometheus::client::MetricType_IsValid(val))) {
+            _internal_set_type(static_cast<::io::prometheus::client::MetricType>(val));
+          } else {
+            ::PROTOBUF_NAMESPACE_ID::internal::WriteVarint(3, val, mutable_unknown_fields());
+          }
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .io.prometheus.client.Metric metric = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_metric(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<34>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* MetricFamily::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:io.prometheus.client.MetricFamily)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional string name = 1;
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_name().data(), static_cast<int>(this->_internal_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "io.prometheus.client.MetricFamily.name");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_name(), target);
+  }
+
+  // optional string help = 2;
+  if (cached_has_bits & 0x00000002u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_help().data(), static_cast<int>(this->_internal_help().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "io.prometheus.client.MetricFamily.help");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_help(), target);
+  }
+
+  // optional .io.prometheus.client.MetricType type = 3;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      3, this->_internal_type(), target);
+  }
+
+  // repeated .io.prometheus.client.Metric metric = 4;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_metric_size()); i < n; i++) {
+    const auto& repfield = this->_internal_metric(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(4, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:io.prometheus.client.MetricFamily)
+  return target;
+}
+
+size_t MetricFamily::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:io.prometheus.client.MetricFamily)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .io.prometheus.client.Metric metric = 4;
+  total_size += 1UL * this->_internal_metric_size();
+  for (const auto& msg : this->_impl_.metric_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    // optional string name = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_name());
+    }
+
+    // optional string help = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_help());
+    }
+
+    // optional .io.prometheus.client.MetricType type = 3;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::EnumSize(this->_internal_type());
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData MetricFamily::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    MetricFamily::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*MetricFamily::GetClassData() const { return &_class_data_; }
+
+
+void MetricFamily::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<MetricFamily*>(&to_msg);
+  auto& from = static_cast<const MetricFamily&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:io.prometheus.client.MetricFamily)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.metric_.MergeFrom(from._impl_.metric_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_name(from._internal_name());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_set_help(from._internal_help());
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.type_ = from._impl_.type_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void MetricFamily::CopyFrom(const MetricFamily& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:io.prometheus.client.MetricFamily)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool MetricFamily::IsInitialized() const {
+  return true;
+}
+
+void MetricFamily::InternalSwap(MetricFamily* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.metric_.InternalSwap(&other->_impl_.metric_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.name_, lhs_arena,
+      &other->_impl_.name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.help_, lhs_arena,
+      &other->_impl_.help_, rhs_arena
+  );
+  swap(_impl_.type_, other->_impl_.type_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata MetricFamily::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_metrics2_2eproto_getter, &descriptor_table_metrics2_2eproto_once,
+      file_level_metadata_metrics2_2eproto[9]);
+}
+
+// @@protoc_insertion_point(namespace_scope)
+}  // namespace client
+}  // namespace prometheus
+}  // namespace io
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::io::prometheus::client::LabelPair*
+Arena::CreateMaybeMessage< ::io::prometheus::client::LabelPair >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::io::prometheus::client::LabelPair >(arena);
+}
+template<> PROTOBUF_NOINLINE ::io::prometheus::client::Gauge*
+Arena::CreateMaybeMessage< ::io::prometheus::client::Gauge >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::io::prometheus::client::Gauge >(arena);
+}
+template<> PROTOBUF_NOINLINE ::io::prometheus::client::Counter*
+Arena::CreateMaybeMessage< ::io::prometheus::client::Counter >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::io::prometheus::client::Counter >(arena);
+}
+template<> PROTOBUF_NOINLINE ::io::prometheus::client::Quantile*
+Arena::CreateMaybeMessage< ::io::prometheus::client::Quantile >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::io::prometheus::client::Quantile >(arena);
+}
+template<> PROTOBUF_NOINLINE ::io::prometheus::client::Summary*
+Arena::CreateMaybeMessage< ::io::prometheus::client::Summary >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::io::prometheus::client::Summary >(arena);
+}
+template<> PROTOBUF_NOINLINE ::io::prometheus::client::Untyped*
+Arena::CreateMaybeMessage< ::io::prometheus::client::Untyped >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::io::prometheus::client::Untyped >(arena);
+}
+template<> PROTOBUF_NOINLINE ::io::prometheus::client::Histogram*
+Arena::CreateMaybeMessage< ::io::prometheus::client::Histogram >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::io::prometheus::client::Histogram >(arena);
+}
+template<> PROTOBUF_NOINLINE ::io::prometheus::client::Bucket*
+Arena::CreateMaybeMessage< ::io::prometheus::client::Bucket >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::io::prometheus::client::Bucket >(arena);
+}
+template<> PROTOBUF_NOINLINE ::io::prometheus::client::Metric*
+Arena::CreateMaybeMessage< ::io::prometheus::client::Metric >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::io::prometheus::client::Metric >(arena);
+}
+template<> PROTOBUF_NOINLINE ::io::prometheus::client::MetricFamily*
+Arena::CreateMaybeMessage< ::io::prometheus::client::MetricFamily >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::io::prometheus::client::MetricFamily >(arena);
+}
+PROTOBUF_NAMESPACE_CLOSE
+
+// @@protoc_insertion_point(global_scope)
+#include <google/protobuf/port_undef.inc>
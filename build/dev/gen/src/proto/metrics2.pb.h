@@ -0,0 +1,3366 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: metrics2.proto
+
+#ifndef GOOGLE_PROTOBUF_INCLUDED_metrics2_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_metrics2_2eproto
+
+#include <limits>
+#include <string>
+
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please update
+#error your headers.
+#endif
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/arenastring.h>
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/metadata_lite.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/generated_enum_reflection.h>
+#include <google/protobuf/unknown_field_set.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_metrics2_2eproto
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
+
+// Internal implementation detail -- do not use these members.
+struct TableStruct_metrics2_2eproto {
+  static const uint32_t offsets[];
+};
+extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_metrics2_2eproto;
+namespace io {
+namespace prometheus {
+namespace client {
+class Bucket;
+struct BucketDefaultTypeInternal;
+extern BucketDefaultTypeInternal _Bucket_default_instance_;
+class Counter;
+struct CounterDefaultTypeInternal;
+extern CounterDefaultTypeInternal _Counter_default_instance_;
+class Gauge;
+struct GaugeDefaultTypeInternal;
+extern GaugeDefaultTypeInternal _Gauge_default_instance_;
+class Histogram;
+struct HistogramDefaultTypeInternal;
+extern HistogramDefaultTypeInternal _Histogram_default_instance_;
+class LabelPair;
+struct LabelPairDefaultTypeInternal;
+extern LabelPairDefaultTypeInternal _LabelPair_default_instance_;
+class Metric;
+struct MetricDefaultTypeInternal;
+extern MetricDefaultTypeInternal _Metric_default_instance_;
+class MetricFamily;
+struct MetricFamilyDefaultTypeInternal;
+extern MetricFamilyDefaultTypeInternal _MetricFamily_default_instance_;
+class Quantile;
+struct QuantileDefaultTypeInternal;
+extern QuantileDefaultTypeInternal _Quantile_default_instance_;
+class Summary;
+struct SummaryDefaultTypeInternal;
+extern SummaryDefaultTypeInternal _Summary_default_instance_;
+class Untyped;
+struct UntypedDefaultTypeInternal;
+extern UntypedDefaultTypeInternal _Untyped_default_instance_;
+}  // namespace client
+}  // namespace prometheus
+}  // namespace io
+PROTOBUF_NAMESPACE_OPEN
+template<> ::io::prometheus::client::Bucket* Arena::CreateMaybeMessage<::io::prometheus::client::Bucket>(Arena*);
+template<> ::io::prometheus::client::Counter* Arena::CreateMaybeMessage<::io::prometheus::client::Counter>(Arena*);
+template<> ::io::prometheus::client::Gauge* Arena::CreateMaybeMessage<::io::prometheus::client::Gauge>(Arena*);
+template<> ::io::prometheus::client::Histogram* Arena::CreateMaybeMessage<::io::prometheus::client::Histogram>(Arena*);
+template<> ::io::prometheus::client::LabelPair* Arena::CreateMaybeMessage<::io::prometheus::client::LabelPair>(Arena*);
+template<> ::io::prometheus::client::Metric* Arena::CreateMaybeMessage<::io::prometheus::client::Metric>(Arena*);
+template<> ::io::prometheus::client::MetricFamily* Arena::CreateMaybeMessage<::io::prometheus::client::MetricFamily>(Arena*);
+template<> ::io::prometheus::client::Quantile* Arena::CreateMaybeMessage<::io::prometheus::client::Quantile>(Arena*);
+template<> ::io::prometheus::client::Summary* Arena::CreateMaybeMessage<::io::prometheus::client::Summary>(Arena*);
+template<> ::io::prometheus::client::Untyped* Arena::CreateMaybeMessage<::io::prometheus::client::Untyped>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+namespace io {
+namespace prometheus {
+namespace client {
+
+enum MetricType : int {
+  COUNTER = 0,
+  GAUGE = 1,
+  SUMMARY = 2,
+  UNTYPED = 3,
+  HISTOGRAM = 4
+};
+bool MetricType_IsValid(int value);
+constexpr MetricType MetricType_MIN = COUNTER;
+constexpr MetricType MetricType_MAX = HISTOGRAM;
+constexpr int MetricType_ARRAYSIZE = MetricType_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* MetricType_descriptor();
+template<typename T>
+inline const std::string& MetricType_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, MetricType>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function MetricType_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    MetricType_descriptor(), enum_t_value);
+}
+inline bool MetricType_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, MetricType* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<MetricType>(
+    MetricType_descriptor(), name, value);
+}
+// ===================================================================
+
+class LabelPair final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:io.prometheus.client.LabelPair) */ {
+ public:
+  inline LabelPair() : LabelPair(nullptr) {}
+  ~LabelPair() override;
+  explicit PROTOBUF_CONSTEXPR LabelPair(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  LabelPair(const LabelPair& from);
+  LabelPair(LabelPair&& from) noexcept
+    : LabelPair() {
+    *this = ::std::move(from);
+  }
+
+  inline LabelPair& operator=(const LabelPair& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline LabelPair& operator=(LabelPair&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const LabelPair& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const LabelPair* internal_default_instance() {
+    return reinterpret_cast<const LabelPair*>(
+               &_LabelPair_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
+
+  friend void swap(LabelPair& a, LabelPair& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(LabelPair* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(LabelPair* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  LabelPair* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<LabelPair>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const LabelPair& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const LabelPair& from) {
+    LabelPair::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(LabelPair* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "io.prometheus.client.LabelPair";
+  }
+  protected:
+  explicit LabelPair(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kNameFieldNumber = 1,
+    kValueFieldNumber = 2,
+  };
+  // optional string name = 1;
+  bool has_name() const;
+  private:
+  bool _internal_has_name() const;
+  public:
+  void clear_name();
+  const std::string& name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* name);
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(const std::string& value);
+  std::string* _internal_mutable_name();
+  public:
+
+  // optional string value = 2;
+  bool has_value() const;
+  private:
+  bool _internal_has_value() const;
+  public:
+  void clear_value();
+  const std::string& value() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_value(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_value();
+  PROTOBUF_NODISCARD std::string* release_value();
+  void set_allocated_value(std::string* value);
+  private:
+  const std::string& _internal_value() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_value(const std::string& value);
+  std::string* _internal_mutable_value();
+  public:
+
+  // @@protoc_insertion_point(class_scope:io.prometheus.client.LabelPair)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr value_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Gauge final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:io.prometheus.client.Gauge) */ {
+ public:
+  inline Gauge() : Gauge(nullptr) {}
+  ~Gauge() override;
+  explicit PROTOBUF_CONSTEXPR Gauge(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Gauge(const Gauge& from);
+  Gauge(Gauge&& from) noexcept
+    : Gauge() {
+    *this = ::std::move(from);
+  }
+
+  inline Gauge& operator=(const Gauge& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Gauge& operator=(Gauge&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Gauge& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Gauge* internal_default_instance() {
+    return reinterpret_cast<const Gauge*>(
+               &_Gauge_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(Gauge& a, Gauge& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Gauge* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Gauge* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Gauge* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Gauge>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Gauge& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Gauge& from) {
+    Gauge::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Gauge* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "io.prometheus.client.Gauge";
+  }
+  protected:
+  explicit Gauge(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kValueFieldNumber = 1,
+  };
+  // optional double value = 1;
+  bool has_value() const;
+  private:
+  bool _internal_has_value() const;
+  public:
+  void clear_value();
+  double value() const;
+  void set_value(double value);
+  private:
+  double _internal_value() const;
+  void _internal_set_value(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:io.prometheus.client.Gauge)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    double value_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Counter final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:io.prometheus.client.Counter) */ {
+ public:
+  inline Counter() : Counter(nullptr) {}
+  ~Counter() override;
+  explicit PROTOBUF_CONSTEXPR Counter(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Counter(const Counter& from);
+  Counter(Counter&& from) noexcept
+    : Counter() {
+    *this = ::std::move(from);
+  }
+
+  inline Counter& operator=(const Counter& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Counter& operator=(Counter&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Counter& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Counter* internal_default_instance() {
+    return reinterpret_cast<const Counter*>(
+               &_Counter_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(Counter& a, Counter& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Counter* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Counter* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Counter* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Counter>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Counter& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Counter& from) {
+    Counter::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Counter* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "io.prometheus.client.Counter";
+  }
+  protected:
+  explicit Counter(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kValueFieldNumber = 1,
+  };
+  // optional double value = 1;
+  bool has_value() const;
+  private:
+  bool _internal_has_value() const;
+  public:
+  void clear_value();
+  double value() const;
+  void set_value(double value);
+  private:
+  double _internal_value() const;
+  void _internal_set_value(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:io.prometheus.client.Counter)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    double value_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Quantile final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:io.prometheus.client.Quantile) */ {
+ public:
+  inline Quantile() : Quantile(nullptr) {}
+  ~Quantile() override;
+  explicit PROTOBUF_CONSTEXPR Quantile(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Quantile(const Quantile& from);
+  Quantile(Quantile&& from) noexcept
+    : Quantile() {
+    *this = ::std::move(from);
+  }
+
+  inline Quantile& operator=(const Quantile& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Quantile& operator=(Quantile&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Quantile& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Quantile* internal_default_instance() {
+    return reinterpret_cast<const Quantile*>(
+               &_Quantile_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    3;
+
+  friend void swap(Quantile& a, Quantile& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Quantile* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Quantile* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Quantile* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Quantile>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Quantile& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Quantile& from) {
+    Quantile::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Quantile* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "io.prometheus.client.Quantile";
+  }
+  protected:
+  explicit Quantile(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kQuantileFieldNumber = 1,
+    kValueFieldNumber = 2,
+  };
+  // optional double quantile = 1;
+  bool has_quantile() const;
+  private:
+  bool _internal_has_quantile() const;
+  public:
+  void clear_quantile();
+  double quantile() const;
+  void set_quantile(double value);
+  private:
+  double _internal_quantile() const;
+  void _internal_set_quantile(double value);
+  public:
+
+  // optional double value = 2;
+  bool has_value() const;
+  private:
+  bool _internal_has_value() const;
+  public:
+  void clear_value();
+  double value() const;
+  void set_value(double value);
+  private:
+  double _internal_value() const;
+  void _internal_set_value(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:io.prometheus.client.Quantile)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    double quantile_;
+    double value_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Summary final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:io.prometheus.client.Summary) */ {
+ public:
+  inline Summary() : Summary(nullptr) {}
+  ~Summary() override;
+  explicit PROTOBUF_CONSTEXPR Summary(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Summary(const Summary& from);
+  Summary(Summary&& from) noexcept
+    : Summary() {
+    *this = ::std::move(from);
+  }
+
+  inline Summary& operator=(const Summary& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Summary& operator=(Summary&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Summary& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Summary* internal_default_instance() {
+    return reinterpret_cast<const Summary*>(
+               &_Summary_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    4;
+
+  friend void swap(Summary& a, Summary& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Summary* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Summary* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Summary* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Summary>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Summary& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Summary& from) {
+    Summary::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Summary* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "io.prometheus.client.Summary";
+  }
+  protected:
+  explicit Summary(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kQuantileFieldNumber = 3,
+    kSampleCountFieldNumber = 1,
+    kSampleSumFieldNumber = 2,
+  };
+  // repeated .io.prometheus.client.Quantile quantile = 3;
+  int quantile_size() const;
+  private:
+  int _internal_quantile_size() const;
+  public:
+  void clear_quantile();
+  ::io::prometheus::client::Quantile* mutable_quantile(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Quantile >*
+      mutable_quantile();
+  private:
+  const ::io::prometheus::client::Quantile& _internal_quantile(int index) const;
+  ::io::prometheus::client::Quantile* _internal_add_quantile();
+  public:
+  const ::io::prometheus::client::Quantile& quantile(int index) const;
+  ::io::prometheus::client::Quantile* add_quantile();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Quantile >&
+      quantile() const;
+
+  // optional uint64 sample_count = 1;
+  bool has_sample_count() const;
+  private:
+  bool _internal_has_sample_count() const;
+  public:
+  void clear_sample_count();
+  uint64_t sample_count() const;
+  void set_sample_count(uint64_t value);
+  private:
+  uint64_t _internal_sample_count() const;
+  void _internal_set_sample_count(uint64_t value);
+  public:
+
+  // optional double sample_sum = 2;
+  bool has_sample_sum() const;
+  private:
+  bool _internal_has_sample_sum() const;
+  public:
+  void clear_sample_sum();
+  double sample_sum() const;
+  void set_sample_sum(double value);
+  private:
+  double _internal_sample_sum() const;
+  void _internal_set_sample_sum(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:io.prometheus.client.Summary)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Quantile > quantile_;
+    uint64_t sample_count_;
+    double sample_sum_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Untyped final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:io.prometheus.client.Untyped) */ {
+ public:
+  inline Untyped() : Untyped(nullptr) {}
+  ~Untyped() override;
+  explicit PROTOBUF_CONSTEXPR Untyped(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Untyped(const Untyped& from);
+  Untyped(Untyped&& from) noexcept
+    : Untyped() {
+    *this = ::std::move(from);
+  }
+
+  inline Untyped& operator=(const Untyped& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Untyped& operator=(Untyped&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Untyped& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Untyped* internal_default_instance() {
+    return reinterpret_cast<const Untyped*>(
+               &_Untyped_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    5;
+
+  friend void swap(Untyped& a, Untyped& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Untyped* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Untyped* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Untyped* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Untyped>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Untyped& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Untyped& from) {
+    Untyped::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Untyped* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "io.prometheus.client.Untyped";
+  }
+  protected:
+  explicit Untyped(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kValueFieldNumber = 1,
+  };
+  // optional double value = 1;
+  bool has_value() const;
+  private:
+  bool _internal_has_value() const;
+  public:
+  void clear_value();
+  double value() const;
+  void set_value(double value);
+  private:
+  double _internal_value() const;
+  void _internal_set_value(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:io.prometheus.client.Untyped)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    double value_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Histogram final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:io.prometheus.client.Histogram) */ {
+ public:
+  inline Histogram() : Histogram(nullptr) {}
+  ~Histogram() override;
+  explicit PROTOBUF_CONSTEXPR Histogram(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Histogram(const Histogram& from);
+  Histogram(Histogram&& from) noexcept
+    : Histogram() {
+    *this = ::std::move(from);
+  }
+
+  inline Histogram& operator=(const Histogram& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Histogram& operator=(Histogram&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Histogram& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Histogram* internal_default_instance() {
+    return reinterpret_cast<const Histogram*>(
+               &_Histogram_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    6;
+
+  friend void swap(Histogram& a, Histogram& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Histogram* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Histogram* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Histogram* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Histogram>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Histogram& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Histogram& from) {
+    Histogram::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Histogram* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "io.prometheus.client.Histogram";
+  }
+  protected:
+  explicit Histogram(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kBucketFieldNumber = 3,
+    kSampleCountFieldNumber = 1,
+    kSampleSumFieldNumber = 2,
+  };
+  // repeated .io.prometheus.client.Bucket bucket = 3;
+  int bucket_size() const;
+  private:
+  int _internal_bucket_size() const;
+  public:
+  void clear_bucket();
+  ::io::prometheus::client::Bucket* mutable_bucket(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Bucket >*
+      mutable_bucket();
+  private:
+  const ::io::prometheus::client::Bucket& _internal_bucket(int index) const;
+  ::io::prometheus::client::Bucket* _internal_add_bucket();
+  public:
+  const ::io::prometheus::client::Bucket& bucket(int index) const;
+  ::io::prometheus::client::Bucket* add_bucket();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Bucket >&
+      bucket() const;
+
+  // optional uint64 sample_count = 1;
+  bool has_sample_count() const;
+  private:
+  bool _internal_has_sample_count() const;
+  public:
+  void clear_sample_count();
+  uint64_t sample_count() const;
+  void set_sample_count(uint64_t value);
+  private:
+  uint64_t _internal_sample_count() const;
+  void _internal_set_sample_count(uint64_t value);
+  public:
+
+  // optional double sample_sum = 2;
+  bool has_sample_sum() const;
+  private:
+  bool _internal_has_sample_sum() const;
+  public:
+  void clear_sample_sum();
+  double sample_sum() const;
+  void set_sample_sum(double value);
+  private:
+  double _internal_sample_sum() const;
+  void _internal_set_sample_sum(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:io.prometheus.client.Histogram)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Bucket > bucket_;
+    uint64_t sample_count_;
+    double sample_sum_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Bucket final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:io.prometheus.client.Bucket) */ {
+ public:
+  inline Bucket() : Bucket(nullptr) {}
+  ~Bucket() override;
+  explicit PROTOBUF_CONSTEXPR Bucket(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Bucket(const Bucket& from);
+  Bucket(Bucket&& from) noexcept
+    : Bucket() {
+    *this = ::std::move(from);
+  }
+
+  inline Bucket& operator=(const Bucket& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Bucket& operator=(Bucket&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Bucket& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Bucket* internal_default_instance() {
+    return reinterpret_cast<const Bucket*>(
+               &_Bucket_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    7;
+
+  friend void swap(Bucket& a, Bucket& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Bucket* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Bucket* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Bucket* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Bucket>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Bucket& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Bucket& from) {
+    Bucket::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Bucket* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "io.prometheus.client.Bucket";
+  }
+  protected:
+  explicit Bucket(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kCumulativeCountFieldNumber = 1,
+    kUpperBoundFieldNumber = 2,
+  };
+  // optional uint64 cumulative_count = 1;
+  bool has_cumulative_count() const;
+  private:
+  bool _internal_has_cumulative_count() const;
+  public:
+  void clear_cumulative_count();
+  uint64_t cumulative_count() const;
+  void set_cumulative_count(uint64_t value);
+  private:
+  uint64_t _internal_cumulative_count() const;
+  void _internal_set_cumulative_count(uint64_t value);
+  public:
+
+  // optional double upper_bound = 2;
+  bool has_upper_bound() const;
+  private:
+  bool _internal_has_upper_bound() const;
+  public:
+  void clear_upper_bound();
+  double upper_bound() const;
+  void set_upper_bound(double value);
+  private:
+  double _internal_upper_bound() const;
+  void _internal_set_upper_bound(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:io.prometheus.client.Bucket)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint64_t cumulative_count_;
+    double upper_bound_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Metric final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:io.prometheus.client.Metric) */ {
+ public:
+  inline Metric() : Metric(nullptr) {}
+  ~Metric() override;
+  explicit PROTOBUF_CONSTEXPR Metric(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Metric(const Metric& from);
+  Metric(Metric&& from) noexcept
+    : Metric() {
+    *this = ::std::move(from);
+  }
+
+  inline Metric& operator=(const Metric& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Metric& operator=(Metric&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Metric& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Metric* internal_default_instance() {
+    return reinterpret_cast<const Metric*>(
+               &_Metric_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    8;
+
+  friend void swap(Metric& a, Metric& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Metric* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Metric* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Metric* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Metric>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Metric& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Metric& from) {
+    Metric::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Metric* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "io.prometheus.client.Metric";
+  }
+  protected:
+  explicit Metric(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kLabelFieldNumber = 1,
+    kGaugeFieldNumber = 2,
+    kCounterFieldNumber = 3,
+    kSummaryFieldNumber = 4,
+    kUntypedFieldNumber = 5,
+    kHistogramFieldNumber = 7,
+    kTimestampMsFieldNumber = 6,
+  };
+  // repeated .io.prometheus.client.LabelPair label = 1;
+  int label_size() const;
+  private:
+  int _internal_label_size() const;
+  public:
+  void clear_label();
+  ::io::prometheus::client::LabelPair* mutable_label(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::LabelPair >*
+      mutable_label();
+  private:
+  const ::io::prometheus::client::LabelPair& _internal_label(int index) const;
+  ::io::prometheus::client::LabelPair* _internal_add_label();
+  public:
+  const ::io::prometheus::client::LabelPair& label(int index) const;
+  ::io::prometheus::client::LabelPair* add_label();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::LabelPair >&
+      label() const;
+
+  // optional .io.prometheus.client.Gauge gauge = 2;
+  bool has_gauge() const;
+  private:
+  bool _internal_has_gauge() const;
+  public:
+  void clear_gauge();
+  const ::io::prometheus::client::Gauge& gauge() const;
+  PROTOBUF_NODISCARD ::io::prometheus::client::Gauge* release_gauge();
+  ::io::prometheus::client::Gauge* mutable_gauge();
+  void set_allocated_gauge(::io::prometheus::client::Gauge* gauge);
+  private:
+  const ::io::prometheus::client::Gauge& _internal_gauge() const;
+  ::io::prometheus::client::Gauge* _internal_mutable_gauge();
+  public:
+  void unsafe_arena_set_allocated_gauge(
+      ::io::prometheus::client::Gauge* gauge);
+  ::io::prometheus::client::Gauge* unsafe_arena_release_gauge();
+
+  // optional .io.prometheus.client.Counter counter = 3;
+  bool has_counter() const;
+  private:
+  bool _internal_has_counter() const;
+  public:
+  void clear_counter();
+  const ::io::prometheus::client::Counter& counter() const;
+  PROTOBUF_NODISCARD ::io::prometheus::client::Counter* release_counter();
+  ::io::prometheus::client::Counter* mutable_counter();
+  void set_allocated_counter(::io::prometheus::client::Counter* counter);
+  private:
+  const ::io::prometheus::client::Counter& _internal_counter() const;
+  ::io::prometheus::client::Counter* _internal_mutable_counter();
+  public:
+  void unsafe_arena_set_allocated_counter(
+      ::io::prometheus::client::Counter* counter);
+  ::io::prometheus::client::Counter* unsafe_arena_release_counter();
+
+  // optional .io.prometheus.client.Summary summary = 4;
+  bool has_summary() const;
+  private:
+  bool _internal_has_summary() const;
+  public:
+  void clear_summary();
+  const ::io::prometheus::client::Summary& summary() const;
+  PROTOBUF_NODISCARD ::io::prometheus::client::Summary* release_summary();
+  ::io::prometheus::client::Summary* mutable_summary();
+  void set_allocated_summary(::io::prometheus::client::Summary* summary);
+  private:
+  const ::io::prometheus::client::Summary& _internal_summary() const;
+  ::io::prometheus::client::Summary* _internal_mutable_summary();
+  public:
+  void unsafe_arena_set_allocated_summary(
+      ::io::prometheus::client::Summary* summary);
+  ::io::prometheus::client::Summary* unsafe_arena_release_summary();
+
+  // optional .io.prometheus.client.Untyped untyped = 5;
+  bool has_untyped() const;
+  private:
+  bool _internal_has_untyped() const;
+  public:
+  void clear_untyped();
+  const ::io::prometheus::client::Untyped& untyped() const;
+  PROTOBUF_NODISCARD ::io::prometheus::client::Untyped* release_untyped();
+  ::io::prometheus::client::Untyped* mutable_untyped();
+  void set_allocated_untyped(::io::prometheus::client::Untyped* untyped);
+  private:
+  const ::io::prometheus::client::Untyped& _internal_untyped() const;
+  ::io::prometheus::client::Untyped* _internal_mutable_untyped();
+  public:
+  void unsafe_arena_set_allocated_untyped(
+      ::io::prometheus::client::Untyped* untyped);
+  ::io::prometheus::client::Untyped* unsafe_arena_release_untyped();
+
+  // optional .io.prometheus.client.Histogram histogram = 7;
+  bool has_histogram() const;
+  private:
+  bool _internal_has_histogram() const;
+  public:
+  void clear_histogram();
+  const ::io::prometheus::client::Histogram& histogram() const;
+  PROTOBUF_NODISCARD ::io::prometheus::client::Histogram* release_histogram();
+  ::io::prometheus::client::Histogram* mutable_histogram();
+  void set_allocated_histogram(::io::prometheus::client::Histogram* histogram);
+  private:
+  const ::io::prometheus::client::Histogram& _internal_histogram() const;
+  ::io::prometheus::client::Histogram* _internal_mutable_histogram();
+  public:
+  void unsafe_arena_set_allocated_histogram(
+      ::io::prometheus::client::Histogram* histogram);
+  ::io::prometheus::client::Histogram* unsafe_arena_release_histogram();
+
+  // optional int64 timestamp_ms = 6;
+  bool has_timestamp_ms() const;
+  private:
+  bool _internal_has_timestamp_ms() const;
+  public:
+  void clear_timestamp_ms();
+  int64_t timestamp_ms() const;
+  void set_timestamp_ms(int64_t value);
+  private:
+  int64_t _internal_timestamp_ms() const;
+  void _internal_set_timestamp_ms(int64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:io.prometheus.client.Metric)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::LabelPair > label_;
+    ::io::prometheus::client::Gauge* gauge_;
+    ::io::prometheus::client::Counter* counter_;
+    ::io::prometheus::client::Summary* summary_;
+    ::io::prometheus::client::Untyped* untyped_;
+    ::io::prometheus::client::Histogram* histogram_;
+    int64_t timestamp_ms_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics2_2eproto;
+};
+// -------------------------------------------------------------------
+
+class MetricFamily final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:io.prometheus.client.MetricFamily) */ {
+ public:
+  inline MetricFamily() : MetricFamily(nullptr) {}
+  ~MetricFamily() override;
+  explicit PROTOBUF_CONSTEXPR MetricFamily(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  MetricFamily(const MetricFamily& from);
+  MetricFamily(MetricFamily&& from) noexcept
+    : MetricFamily() {
+    *this = ::std::move(from);
+  }
+
+  inline MetricFamily& operator=(const MetricFamily& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline MetricFamily& operator=(MetricFamily&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const MetricFamily& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const MetricFamily* internal_default_instance() {
+    return reinterpret_cast<const MetricFamily*>(
+               &_MetricFamily_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    9;
+
+  friend void swap(MetricFamily& a, MetricFamily& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(MetricFamily* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(MetricFamily* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  MetricFamily* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<MetricFamily>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const MetricFamily& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const MetricFamily& from) {
+    MetricFamily::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(MetricFamily* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "io.prometheus.client.MetricFamily";
+  }
+  protected:
+  explicit MetricFamily(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kMetricFieldNumber = 4,
+    kNameFieldNumber = 1,
+    kHelpFieldNumber = 2,
+    kTypeFieldNumber = 3,
+  };
+  // repeated .io.prometheus.client.Metric metric = 4;
+  int metric_size() const;
+  private:
+  int _internal_metric_size() const;
+  public:
+  void clear_metric();
+  ::io::prometheus::client::Metric* mutable_metric(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Metric >*
+      mutable_metric();
+  private:
+  const ::io::prometheus::client::Metric& _internal_metric(int index) const;
+  ::io::prometheus::client::Metric* _internal_add_metric();
+  public:
+  const ::io::prometheus::client::Metric& metric(int index) const;
+  ::io::prometheus::client::Metric* add_metric();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Metric >&
+      metric() const;
+
+  // optional string name = 1;
+  bool has_name() const;
+  private:
+  bool _internal_has_name() const;
+  public:
+  void clear_name();
+  const std::string& name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* name);
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(const std::string& value);
+  std::string* _internal_mutable_name();
+  public:
+
+  // optional string help = 2;
+  bool has_help() const;
+  private:
+  bool _internal_has_help() const;
+  public:
+  void clear_help();
+  const std::string& help() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_help(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_help();
+  PROTOBUF_NODISCARD std::string* release_help();
+  void set_allocated_help(std::string* help);
+  private:
+  const std::string& _internal_help() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_help(const std::string& value);
+  std::string* _internal_mutable_help();
+  public:
+
+  // optional .io.prometheus.client.MetricType type = 3;
+  bool has_type() const;
+  private:
+  bool _internal_has_type() const;
+  public:
+  void clear_type();
+  ::io::prometheus::client::MetricType type() const;
+  void set_type(::io::prometheus::client::MetricType value);
+  private:
+  ::io::prometheus::client::MetricType _internal_type() const;
+  void _internal_set_type(::io::prometheus::client::MetricType value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:io.prometheus.client.MetricFamily)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Metric > metric_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr help_;
+    int type_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics2_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// LabelPair
+
+// optional string name = 1;
+inline bool LabelPair::_internal_has_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool LabelPair::has_name() const {
+  return _internal_has_name();
+}
+inline void LabelPair::clear_name() {
+  _impl_.name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& LabelPair::name() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.LabelPair.name)
+  return _internal_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void LabelPair::set_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:io.prometheus.client.LabelPair.name)
+}
+inline std::string* LabelPair::mutable_name() {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.LabelPair.name)
+  return _s;
+}
+inline const std::string& LabelPair::_internal_name() const {
+  return _impl_.name_.Get();
+}
+inline void LabelPair::_internal_set_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* LabelPair::_internal_mutable_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* LabelPair::release_name() {
+  // @@protoc_insertion_point(field_release:io.prometheus.client.LabelPair.name)
+  if (!_internal_has_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void LabelPair::set_allocated_name(std::string* name) {
+  if (name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.name_.SetAllocated(name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:io.prometheus.client.LabelPair.name)
+}
+
+// optional string value = 2;
+inline bool LabelPair::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool LabelPair::has_value() const {
+  return _internal_has_value();
+}
+inline void LabelPair::clear_value() {
+  _impl_.value_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& LabelPair::value() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.LabelPair.value)
+  return _internal_value();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void LabelPair::set_value(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.value_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:io.prometheus.client.LabelPair.value)
+}
+inline std::string* LabelPair::mutable_value() {
+  std::string* _s = _internal_mutable_value();
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.LabelPair.value)
+  return _s;
+}
+inline const std::string& LabelPair::_internal_value() const {
+  return _impl_.value_.Get();
+}
+inline void LabelPair::_internal_set_value(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.value_.Set(value, GetArenaForAllocation());
+}
+inline std::string* LabelPair::_internal_mutable_value() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.value_.Mutable(GetArenaForAllocation());
+}
+inline std::string* LabelPair::release_value() {
+  // @@protoc_insertion_point(field_release:io.prometheus.client.LabelPair.value)
+  if (!_internal_has_value()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.value_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.value_.IsDefault()) {
+    _impl_.value_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void LabelPair::set_allocated_value(std::string* value) {
+  if (value != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.value_.SetAllocated(value, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.value_.IsDefault()) {
+    _impl_.value_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:io.prometheus.client.LabelPair.value)
+}
+
+// -------------------------------------------------------------------
+
+// Gauge
+
+// optional double value = 1;
+inline bool Gauge::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Gauge::has_value() const {
+  return _internal_has_value();
+}
+inline void Gauge::clear_value() {
+  _impl_.value_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline double Gauge::_internal_value() const {
+  return _impl_.value_;
+}
+inline double Gauge::value() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Gauge.value)
+  return _internal_value();
+}
+inline void Gauge::_internal_set_value(double value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.value_ = value;
+}
+inline void Gauge::set_value(double value) {
+  _internal_set_value(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Gauge.value)
+}
+
+// -------------------------------------------------------------------
+
+// Counter
+
+// optional double value = 1;
+inline bool Counter::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Counter::has_value() const {
+  return _internal_has_value();
+}
+inline void Counter::clear_value() {
+  _impl_.value_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline double Counter::_internal_value() const {
+  return _impl_.value_;
+}
+inline double Counter::value() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Counter.value)
+  return _internal_value();
+}
+inline void Counter::_internal_set_value(double value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.value_ = value;
+}
+inline void Counter::set_value(double value) {
+  _internal_set_value(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Counter.value)
+}
+
+// -------------------------------------------------------------------
+
+// Quantile
+
+// optional double quantile = 1;
+inline bool Quantile::_internal_has_quantile() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Quantile::has_quantile() const {
+  return _internal_has_quantile();
+}
+inline void Quantile::clear_quantile() {
+  _impl_.quantile_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline double Quantile::_internal_quantile() const {
+  return _impl_.quantile_;
+}
+inline double Quantile::quantile() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Quantile.quantile)
+  return _internal_quantile();
+}
+inline void Quantile::_internal_set_quantile(double value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.quantile_ = value;
+}
+inline void Quantile::set_quantile(double value) {
+  _internal_set_quantile(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Quantile.quantile)
+}
+
+// optional double value = 2;
+inline bool Quantile::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool Quantile::has_value() const {
+  return _internal_has_value();
+}
+inline void Quantile::clear_value() {
+  _impl_.value_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline double Quantile::_internal_value() const {
+  return _impl_.value_;
+}
+inline double Quantile::value() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Quantile.value)
+  return _internal_value();
+}
+inline void Quantile::_internal_set_value(double value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.value_ = value;
+}
+inline void Quantile::set_value(double value) {
+  _internal_set_value(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Quantile.value)
+}
+
+// -------------------------------------------------------------------
+
+// Summary
+
+// optional uint64 sample_count = 1;
+inline bool Summary::_internal_has_sample_count() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Summary::has_sample_count() const {
+  return _internal_has_sample_count();
+}
+inline void Summary::clear_sample_count() {
+  _impl_.sample_count_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t Summary::_internal_sample_count() const {
+  return _impl_.sample_count_;
+}
+inline uint64_t Summary::sample_count() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Summary.sample_count)
+  return _internal_sample_count();
+}
+inline void Summary::_internal_set_sample_count(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.sample_count_ = value;
+}
+inline void Summary::set_sample_count(uint64_t value) {
+  _internal_set_sample_count(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Summary.sample_count)
+}
+
+// optional double sample_sum = 2;
+inline bool Summary::_internal_has_sample_sum() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool Summary::has_sample_sum() const {
+  return _internal_has_sample_sum();
+}
+inline void Summary::clear_sample_sum() {
+  _impl_.sample_sum_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline double Summary::_internal_sample_sum() const {
+  return _impl_.sample_sum_;
+}
+inline double Summary::sample_sum() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Summary.sample_sum)
+  return _internal_sample_sum();
+}
+inline void Summary::_internal_set_sample_sum(double value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.sample_sum_ = value;
+}
+inline void Summary::set_sample_sum(double value) {
+  _internal_set_sample_sum(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Summary.sample_sum)
+}
+
+// repeated .io.prometheus.client.Quantile quantile = 3;
+inline int Summary::_internal_quantile_size() const {
+  return _impl_.quantile_.size();
+}
+inline int Summary::quantile_size() const {
+  return _internal_quantile_size();
+}
+inline void Summary::clear_quantile() {
+  _impl_.quantile_.Clear();
+}
+inline ::io::prometheus::client::Quantile* Summary::mutable_quantile(int index) {
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.Summary.quantile)
+  return _impl_.quantile_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Quantile >*
+Summary::mutable_quantile() {
+  // @@protoc_insertion_point(field_mutable_list:io.prometheus.client.Summary.quantile)
+  return &_impl_.quantile_;
+}
+inline const ::io::prometheus::client::Quantile& Summary::_internal_quantile(int index) const {
+  return _impl_.quantile_.Get(index);
+}
+inline const ::io::prometheus::client::Quantile& Summary::quantile(int index) const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Summary.quantile)
+  return _internal_quantile(index);
+}
+inline ::io::prometheus::client::Quantile* Summary::_internal_add_quantile() {
+  return _impl_.quantile_.Add();
+}
+inline ::io::prometheus::client::Quantile* Summary::add_quantile() {
+  ::io::prometheus::client::Quantile* _add = _internal_add_quantile();
+  // @@protoc_insertion_point(field_add:io.prometheus.client.Summary.quantile)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Quantile >&
+Summary::quantile() const {
+  // @@protoc_insertion_point(field_list:io.prometheus.client.Summary.quantile)
+  return _impl_.quantile_;
+}
+
+// -------------------------------------------------------------------
+
+// Untyped
+
+// optional double value = 1;
+inline bool Untyped::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Untyped::has_value() const {
+  return _internal_has_value();
+}
+inline void Untyped::clear_value() {
+  _impl_.value_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline double Untyped::_internal_value() const {
+  return _impl_.value_;
+}
+inline double Untyped::value() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Untyped.value)
+  return _internal_value();
+}
+inline void Untyped::_internal_set_value(double value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.value_ = value;
+}
+inline void Untyped::set_value(double value) {
+  _internal_set_value(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Untyped.value)
+}
+
+// -------------------------------------------------------------------
+
+// Histogram
+
+// optional uint64 sample_count = 1;
+inline bool Histogram::_internal_has_sample_count() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Histogram::has_sample_count() const {
+  return _internal_has_sample_count();
+}
+inline void Histogram::clear_sample_count() {
+  _impl_.sample_count_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t Histogram::_internal_sample_count() const {
+  return _impl_.sample_count_;
+}
+inline uint64_t Histogram::sample_count() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Histogram.sample_count)
+  return _internal_sample_count();
+}
+inline void Histogram::_internal_set_sample_count(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.sample_count_ = value;
+}
+inline void Histogram::set_sample_count(uint64_t value) {
+  _internal_set_sample_count(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Histogram.sample_count)
+}
+
+// optional double sample_sum = 2;
+inline bool Histogram::_internal_has_sample_sum() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool Histogram::has_sample_sum() const {
+  return _internal_has_sample_sum();
+}
+inline void Histogram::clear_sample_sum() {
+  _impl_.sample_sum_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline double Histogram::_internal_sample_sum() const {
+  return _impl_.sample_sum_;
+}
+inline double Histogram::sample_sum() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Histogram.sample_sum)
+  return _internal_sample_sum();
+}
+inline void Histogram::_internal_set_sample_sum(double value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.sample_sum_ = value;
+}
+inline void Histogram::set_sample_sum(double value) {
+  _internal_set_sample_sum(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Histogram.sample_sum)
+}
+
+// repeated .io.prometheus.client.Bucket bucket = 3;
+inline int Histogram::_internal_bucket_size() const {
+  return _impl_.bucket_.size();
+}
+inline int Histogram::bucket_size() const {
+  return _internal_bucket_size();
+}
+inline void Histogram::clear_bucket() {
+  _impl_.bucket_.Clear();
+}
+inline ::io::prometheus::client::Bucket* Histogram::mutable_bucket(int index) {
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.Histogram.bucket)
+  return _impl_.bucket_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Bucket >*
+Histogram::mutable_bucket() {
+  // @@protoc_insertion_point(field_mutable_list:io.prometheus.client.Histogram.bucket)
+  return &_impl_.bucket_;
+}
+inline const ::io::prometheus::client::Bucket& Histogram::_internal_bucket(int index) const {
+  return _impl_.bucket_.Get(index);
+}
+inline const ::io::prometheus::client::Bucket& Histogram::bucket(int index) const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Histogram.bucket)
+  return _internal_bucket(index);
+}
+inline ::io::prometheus::client::Bucket* Histogram::_internal_add_bucket() {
+  return _impl_.bucket_.Add();
+}
+inline ::io::prometheus::client::Bucket* Histogram::add_bucket() {
+  ::io::prometheus::client::Bucket* _add = _internal_add_bucket();
+  // @@protoc_insertion_point(field_add:io.prometheus.client.Histogram.bucket)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Bucket >&
+Histogram::bucket() const {
+  // @@protoc_insertion_point(field_list:io.prometheus.client.Histogram.bucket)
+  return _impl_.bucket_;
+}
+
+// -------------------------------------------------------------------
+
+// Bucket
+
+// optional uint64 cumulative_count = 1;
+inline bool Bucket::_internal_has_cumulative_count() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Bucket::has_cumulative_count() const {
+  return _internal_has_cumulative_count();
+}
+inline void Bucket::clear_cumulative_count() {
+  _impl_.cumulative_count_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t Bucket::_internal_cumulative_count() const {
+  return _impl_.cumulative_count_;
+}
+inline uint64_t Bucket::cumulative_count() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Bucket.cumulative_count)
+  return _internal_cumulative_count();
+}
+inline void Bucket::_internal_set_cumulative_count(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.cumulative_count_ = value;
+}
+inline void Bucket::set_cumulative_count(uint64_t value) {
+  _internal_set_cumulative_count(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Bucket.cumulative_count)
+}
+
+// optional double upper_bound = 2;
+inline bool Bucket::_internal_has_upper_bound() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool Bucket::has_upper_bound() const {
+  return _internal_has_upper_bound();
+}
+inline void Bucket::clear_upper_bound() {
+  _impl_.upper_bound_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline double Bucket::_internal_upper_bound() const {
+  return _impl_.upper_bound_;
+}
+inline double Bucket::upper_bound() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Bucket.upper_bound)
+  return _internal_upper_bound();
+}
+inline void Bucket::_internal_set_upper_bound(double value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.upper_bound_ = value;
+}
+inline void Bucket::set_upper_bound(double value) {
+  _internal_set_upper_bound(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Bucket.upper_bound)
+}
+
+// -------------------------------------------------------------------
+
+// Metric
+
+// repeated .io.prometheus.client.LabelPair label = 1;
+inline int Metric::_internal_label_size() const {
+  return _impl_.label_.size();
+}
+inline int Metric::label_size() const {
+  return _internal_label_size();
+}
+inline void Metric::clear_label() {
+  _impl_.label_.Clear();
+}
+inline ::io::prometheus::client::LabelPair* Metric::mutable_label(int index) {
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.Metric.label)
+  return _impl_.label_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::LabelPair >*
+Metric::mutable_label() {
+  // @@protoc_insertion_point(field_mutable_list:io.prometheus.client.Metric.label)
+  return &_impl_.label_;
+}
+inline const ::io::prometheus::client::LabelPair& Metric::_internal_label(int index) const {
+  return _impl_.label_.Get(index);
+}
+inline const ::io::prometheus::client::LabelPair& Metric::label(int index) const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Metric.label)
+  return _internal_label(index);
+}
+inline ::io::prometheus::client::LabelPair* Metric::_internal_add_label() {
+  return _impl_.label_.Add();
+}
+inline ::io::prometheus::client::LabelPair* Metric::add_label() {
+  ::io::prometheus::client::LabelPair* _add = _internal_add_label();
+  // @@protoc_insertion_point(field_add:io.prometheus.client.Metric.label)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::LabelPair >&
+Metric::label() const {
+  // @@protoc_insertion_point(field_list:io.prometheus.client.Metric.label)
+  return _impl_.label_;
+}
+
+// optional .io.prometheus.client.Gauge gauge = 2;
+inline bool Metric::_internal_has_gauge() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.gauge_ != nullptr);
+  return value;
+}
+inline bool Metric::has_gauge() const {
+  return _internal_has_gauge();
+}
+inline void Metric::clear_gauge() {
+  if (_impl_.gauge_ != nullptr) _impl_.gauge_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const ::io::prometheus::client::Gauge& Metric::_internal_gauge() const {
+  const ::io::prometheus::client::Gauge* p = _impl_.gauge_;
+  return p != nullptr ? *p : reinterpret_cast<const ::io::prometheus::client::Gauge&>(
+      ::io::prometheus::client::_Gauge_default_instance_);
+}
+inline const ::io::prometheus::client::Gauge& Metric::gauge() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Metric.gauge)
+  return _internal_gauge();
+}
+inline void Metric::unsafe_arena_set_allocated_gauge(
+    ::io::prometheus::client::Gauge* gauge) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.gauge_);
+  }
+  _impl_.gauge_ = gauge;
+  if (gauge) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:io.prometheus.client.Metric.gauge)
+}
+inline ::io::prometheus::client::Gauge* Metric::release_gauge() {
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::io::prometheus::client::Gauge* temp = _impl_.gauge_;
+  _impl_.gauge_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::io::prometheus::client::Gauge* Metric::unsafe_arena_release_gauge() {
+  // @@protoc_insertion_point(field_release:io.prometheus.client.Metric.gauge)
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::io::prometheus::client::Gauge* temp = _impl_.gauge_;
+  _impl_.gauge_ = nullptr;
+  return temp;
+}
+inline ::io::prometheus::client::Gauge* Metric::_internal_mutable_gauge() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  if (_impl_.gauge_ == nullptr) {
+    auto* p = CreateMaybeMessage<::io::prometheus::client::Gauge>(GetArenaForAllocation());
+    _impl_.gauge_ = p;
+  }
+  return _impl_.gauge_;
+}
+inline ::io::prometheus::client::Gauge* Metric::mutable_gauge() {
+  ::io::prometheus::client::Gauge* _msg = _internal_mutable_gauge();
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.Metric.gauge)
+  return _msg;
+}
+inline void Metric::set_allocated_gauge(::io::prometheus::client::Gauge* gauge) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.gauge_;
+  }
+  if (gauge) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(gauge);
+    if (message_arena != submessage_arena) {
+      gauge = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, gauge, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.gauge_ = gauge;
+  // @@protoc_insertion_point(field_set_allocated:io.prometheus.client.Metric.gauge)
+}
+
+// optional .io.prometheus.client.Counter counter = 3;
+inline bool Metric::_internal_has_counter() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.counter_ != nullptr);
+  return value;
+}
+inline bool Metric::has_counter() const {
+  return _internal_has_counter();
+}
+inline void Metric::clear_counter() {
+  if (_impl_.counter_ != nullptr) _impl_.counter_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const ::io::prometheus::client::Counter& Metric::_internal_counter() const {
+  const ::io::prometheus::client::Counter* p = _impl_.counter_;
+  return p != nullptr ? *p : reinterpret_cast<const ::io::prometheus::client::Counter&>(
+      ::io::prometheus::client::_Counter_default_instance_);
+}
+inline const ::io::prometheus::client::Counter& Metric::counter() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Metric.counter)
+  return _internal_counter();
+}
+inline void Metric::unsafe_arena_set_allocated_counter(
+    ::io::prometheus::client::Counter* counter) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.counter_);
+  }
+  _impl_.counter_ = counter;
+  if (counter) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:io.prometheus.client.Metric.counter)
+}
+inline ::io::prometheus::client::Counter* Metric::release_counter() {
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::io::prometheus::client::Counter* temp = _impl_.counter_;
+  _impl_.counter_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::io::prometheus::client::Counter* Metric::unsafe_arena_release_counter() {
+  // @@protoc_insertion_point(field_release:io.prometheus.client.Metric.counter)
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::io::prometheus::client::Counter* temp = _impl_.counter_;
+  _impl_.counter_ = nullptr;
+  return temp;
+}
+inline ::io::prometheus::client::Counter* Metric::_internal_mutable_counter() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  if (_impl_.counter_ == nullptr) {
+    auto* p = CreateMaybeMessage<::io::prometheus::client::Counter>(GetArenaForAllocation());
+    _impl_.counter_ = p;
+  }
+  return _impl_.counter_;
+}
+inline ::io::prometheus::client::Counter* Metric::mutable_counter() {
+  ::io::prometheus::client::Counter* _msg = _internal_mutable_counter();
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.Metric.counter)
+  return _msg;
+}
+inline void Metric::set_allocated_counter(::io::prometheus::client::Counter* counter) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.counter_;
+  }
+  if (counter) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(counter);
+    if (message_arena != submessage_arena) {
+      counter = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, counter, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.counter_ = counter;
+  // @@protoc_insertion_point(field_set_allocated:io.prometheus.client.Metric.counter)
+}
+
+// optional .io.prometheus.client.Summary summary = 4;
+inline bool Metric::_internal_has_summary() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.summary_ != nullptr);
+  return value;
+}
+inline bool Metric::has_summary() const {
+  return _internal_has_summary();
+}
+inline void Metric::clear_summary() {
+  if (_impl_.summary_ != nullptr) _impl_.summary_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline const ::io::prometheus::client::Summary& Metric::_internal_summary() const {
+  const ::io::prometheus::client::Summary* p = _impl_.summary_;
+  return p != nullptr ? *p : reinterpret_cast<const ::io::prometheus::client::Summary&>(
+      ::io::prometheus::client::_Summary_default_instance_);
+}
+inline const ::io::prometheus::client::Summary& Metric::summary() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Metric.summary)
+  return _internal_summary();
+}
+inline void Metric::unsafe_arena_set_allocated_summary(
+    ::io::prometheus::client::Summary* summary) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.summary_);
+  }
+  _impl_.summary_ = summary;
+  if (summary) {
+    _impl_._has_bits_[0] |= 0x00000004u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000004u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:io.prometheus.client.Metric.summary)
+}
+inline ::io::prometheus::client::Summary* Metric::release_summary() {
+  _impl_._has_bits_[0] &= ~0x00000004u;
+  ::io::prometheus::client::Summary* temp = _impl_.summary_;
+  _impl_.summary_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::io::prometheus::client::Summary* Metric::unsafe_arena_release_summary() {
+  // @@protoc_insertion_point(field_release:io.prometheus.client.Metric.summary)
+  _impl_._has_bits_[0] &= ~0x00000004u;
+  ::io::prometheus::client::Summary* temp = _impl_.summary_;
+  _impl_.summary_ = nullptr;
+  return temp;
+}
+inline ::io::prometheus::client::Summary* Metric::_internal_mutable_summary() {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  if (_impl_.summary_ == nullptr) {
+    auto* p = CreateMaybeMessage<::io::prometheus::client::Summary>(GetArenaForAllocation());
+    _impl_.summary_ = p;
+  }
+  return _impl_.summary_;
+}
+inline ::io::prometheus::client::Summary* Metric::mutable_summary() {
+  ::io::prometheus::client::Summary* _msg = _internal_mutable_summary();
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.Metric.summary)
+  return _msg;
+}
+inline void Metric::set_allocated_summary(::io::prometheus::client::Summary* summary) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.summary_;
+  }
+  if (summary) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(summary);
+    if (message_arena != submessage_arena) {
+      summary = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, summary, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000004u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000004u;
+  }
+  _impl_.summary_ = summary;
+  // @@protoc_insertion_point(field_set_allocated:io.prometheus.client.Metric.summary)
+}
+
+// optional .io.prometheus.client.Untyped untyped = 5;
+inline bool Metric::_internal_has_untyped() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.untyped_ != nullptr);
+  return value;
+}
+inline bool Metric::has_untyped() const {
+  return _internal_has_untyped();
+}
+inline void Metric::clear_untyped() {
+  if (_impl_.untyped_ != nullptr) _impl_.untyped_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline const ::io::prometheus::client::Untyped& Metric::_internal_untyped() const {
+  const ::io::prometheus::client::Untyped* p = _impl_.untyped_;
+  return p != nullptr ? *p : reinterpret_cast<const ::io::prometheus::client::Untyped&>(
+      ::io::prometheus::client::_Untyped_default_instance_);
+}
+inline const ::io::prometheus::client::Untyped& Metric::untyped() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Metric.untyped)
+  return _internal_untyped();
+}
+inline void Metric::unsafe_arena_set_allocated_untyped(
+    ::io::prometheus::client::Untyped* untyped) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.untyped_);
+  }
+  _impl_.untyped_ = untyped;
+  if (untyped) {
+    _impl_._has_bits_[0] |= 0x00000008u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000008u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:io.prometheus.client.Metric.untyped)
+}
+inline ::io::prometheus::client::Untyped* Metric::release_untyped() {
+  _impl_._has_bits_[0] &= ~0x00000008u;
+  ::io::prometheus::client::Untyped* temp = _impl_.untyped_;
+  _impl_.untyped_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::io::prometheus::client::Untyped* Metric::unsafe_arena_release_untyped() {
+  // @@protoc_insertion_point(field_release:io.prometheus.client.Metric.untyped)
+  _impl_._has_bits_[0] &= ~0x00000008u;
+  ::io::prometheus::client::Untyped* temp = _impl_.untyped_;
+  _impl_.untyped_ = nullptr;
+  return temp;
+}
+inline ::io::prometheus::client::Untyped* Metric::_internal_mutable_untyped() {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  if (_impl_.untyped_ == nullptr) {
+    auto* p = CreateMaybeMessage<::io::prometheus::client::Untyped>(GetArenaForAllocation());
+    _impl_.untyped_ = p;
+  }
+  return _impl_.untyped_;
+}
+inline ::io::prometheus::client::Untyped* Metric::mutable_untyped() {
+  ::io::prometheus::client::Untyped* _msg = _internal_mutable_untyped();
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.Metric.untyped)
+  return _msg;
+}
+inline void Metric::set_allocated_untyped(::io::prometheus::client::Untyped* untyped) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.untyped_;
+  }
+  if (untyped) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(untyped);
+    if (message_arena != submessage_arena) {
+      untyped = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, untyped, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000008u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000008u;
+  }
+  _impl_.untyped_ = untyped;
+  // @@protoc_insertion_point(field_set_allocated:io.prometheus.client.Metric.untyped)
+}
+
+// optional .io.prometheus.client.Histogram histogram = 7;
+inline bool Metric::_internal_has_histogram() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.histogram_ != nullptr);
+  return value;
+}
+inline bool Metric::has_histogram() const {
+  return _internal_has_histogram();
+}
+inline void Metric::clear_histogram() {
+  if (_impl_.histogram_ != nullptr) _impl_.histogram_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline const ::io::prometheus::client::Histogram& Metric::_internal_histogram() const {
+  const ::io::prometheus::client::Histogram* p = _impl_.histogram_;
+  return p != nullptr ? *p : reinterpret_cast<const ::io::prometheus::client::Histogram&>(
+      ::io::prometheus::client::_Histogram_default_instance_);
+}
+inline const ::io::prometheus::client::Histogram& Metric::histogram() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Metric.histogram)
+  return _internal_histogram();
+}
+inline void Metric::unsafe_arena_set_allocated_histogram(
+    ::io::prometheus::client::Histogram* histogram) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.histogram_);
+  }
+  _impl_.histogram_ = histogram;
+  if (histogram) {
+    _impl_._has_bits_[0] |= 0x00000010u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000010u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:io.prometheus.client.Metric.histogram)
+}
+inline ::io::prometheus::client::Histogram* Metric::release_histogram() {
+  _impl_._has_bits_[0] &= ~0x00000010u;
+  ::io::prometheus::client::Histogram* temp = _impl_.histogram_;
+  _impl_.histogram_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::io::prometheus::client::Histogram* Metric::unsafe_arena_release_histogram() {
+  // @@protoc_insertion_point(field_release:io.prometheus.client.Metric.histogram)
+  _impl_._has_bits_[0] &= ~0x00000010u;
+  ::io::prometheus::client::Histogram* temp = _impl_.histogram_;
+  _impl_.histogram_ = nullptr;
+  return temp;
+}
+inline ::io::prometheus::client::Histogram* Metric::_internal_mutable_histogram() {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  if (_impl_.histogram_ == nullptr) {
+    auto* p = CreateMaybeMessage<::io::prometheus::client::Histogram>(GetArenaForAllocation());
+    _impl_.histogram_ = p;
+  }
+  return _impl_.histogram_;
+}
+inline ::io::prometheus::client::Histogram* Metric::mutable_histogram() {
+  ::io::prometheus::client::Histogram* _msg = _internal_mutable_histogram();
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.Metric.histogram)
+  return _msg;
+}
+inline void Metric::set_allocated_histogram(::io::prometheus::client::Histogram* histogram) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.histogram_;
+  }
+  if (histogram) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(histogram);
+    if (message_arena != submessage_arena) {
+      histogram = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, histogram, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000010u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000010u;
+  }
+  _impl_.histogram_ = histogram;
+  // @@protoc_insertion_point(field_set_allocated:io.prometheus.client.Metric.histogram)
+}
+
+// optional int64 timestamp_ms = 6;
+inline bool Metric::_internal_has_timestamp_ms() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
+}
+inline bool Metric::has_timestamp_ms() const {
+  return _internal_has_timestamp_ms();
+}
+inline void Metric::clear_timestamp_ms() {
+  _impl_.timestamp_ms_ = int64_t{0};
+  _impl_._has_bits_[0] &= ~0x00000020u;
+}
+inline int64_t Metric::_internal_timestamp_ms() const {
+  return _impl_.timestamp_ms_;
+}
+inline int64_t Metric::timestamp_ms() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.Metric.timestamp_ms)
+  return _internal_timestamp_ms();
+}
+inline void Metric::_internal_set_timestamp_ms(int64_t value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.timestamp_ms_ = value;
+}
+inline void Metric::set_timestamp_ms(int64_t value) {
+  _internal_set_timestamp_ms(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.Metric.timestamp_ms)
+}
+
+// -------------------------------------------------------------------
+
+// MetricFamily
+
+// optional string name = 1;
+inline bool MetricFamily::_internal_has_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool MetricFamily::has_name() const {
+  return _internal_has_name();
+}
+inline void MetricFamily::clear_name() {
+  _impl_.name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& MetricFamily::name() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.MetricFamily.name)
+  return _internal_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void MetricFamily::set_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:io.prometheus.client.MetricFamily.name)
+}
+inline std::string* MetricFamily::mutable_name() {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.MetricFamily.name)
+  return _s;
+}
+inline const std::string& MetricFamily::_internal_name() const {
+  return _impl_.name_.Get();
+}
+inline void MetricFamily::_internal_set_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* MetricFamily::_internal_mutable_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* MetricFamily::release_name() {
+  // @@protoc_insertion_point(field_release:io.prometheus.client.MetricFamily.name)
+  if (!_internal_has_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void MetricFamily::set_allocated_name(std::string* name) {
+  if (name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.name_.SetAllocated(name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:io.prometheus.client.MetricFamily.name)
+}
+
+// optional string help = 2;
+inline bool MetricFamily::_internal_has_help() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool MetricFamily::has_help() const {
+  return _internal_has_help();
+}
+inline void MetricFamily::clear_help() {
+  _impl_.help_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& MetricFamily::help() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.MetricFamily.help)
+  return _internal_help();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void MetricFamily::set_help(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.help_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:io.prometheus.client.MetricFamily.help)
+}
+inline std::string* MetricFamily::mutable_help() {
+  std::string* _s = _internal_mutable_help();
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.MetricFamily.help)
+  return _s;
+}
+inline const std::string& MetricFamily::_internal_help() const {
+  return _impl_.help_.Get();
+}
+inline void MetricFamily::_internal_set_help(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.help_.Set(value, GetArenaForAllocation());
+}
+inline std::string* MetricFamily::_internal_mutable_help() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.help_.Mutable(GetArenaForAllocation());
+}
+inline std::string* MetricFamily::release_help() {
+  // @@protoc_insertion_point(field_release:io.prometheus.client.MetricFamily.help)
+  if (!_internal_has_help()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.help_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.help_.IsDefault()) {
+    _impl_.help_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void MetricFamily::set_allocated_help(std::string* help) {
+  if (help != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.help_.SetAllocated(help, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.help_.IsDefault()) {
+    _impl_.help_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:io.prometheus.client.MetricFamily.help)
+}
+
+// optional .io.prometheus.client.MetricType type = 3;
+inline bool MetricFamily::_internal_has_type() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool MetricFamily::has_type() const {
+  return _internal_has_type();
+}
+inline void MetricFamily::clear_type() {
+  _impl_.type_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline ::io::prometheus::client::MetricType MetricFamily::_internal_type() const {
+  return static_cast< ::io::prometheus::client::MetricType >(_impl_.type_);
+}
+inline ::io::prometheus::client::MetricType MetricFamily::type() const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.MetricFamily.type)
+  return _internal_type();
+}
+inline void MetricFamily::_internal_set_type(::io::prometheus::client::MetricType value) {
+  assert(::io::prometheus::client::MetricType_IsValid(value));
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.type_ = value;
+}
+inline void MetricFamily::set_type(::io::prometheus::client::MetricType value) {
+  _internal_set_type(value);
+  // @@protoc_insertion_point(field_set:io.prometheus.client.MetricFamily.type)
+}
+
+// repeated .io.prometheus.client.Metric metric = 4;
+inline int MetricFamily::_internal_metric_size() const {
+  return _impl_.metric_.size();
+}
+inline int MetricFamily::metric_size() const {
+  return _internal_metric_size();
+}
+inline void MetricFamily::clear_metric() {
+  _impl_.metric_.Clear();
+}
+inline ::io::prometheus::client::Metric* MetricFamily::mutable_metric(int index) {
+  // @@protoc_insertion_point(field_mutable:io.prometheus.client.MetricFamily.metric)
+  return _impl_.metric_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Metric >*
+MetricFamily::mutable_metric() {
+  // @@protoc_insertion_point(field_mutable_list:io.prometheus.client.MetricFamily.metric)
+  return &_impl_.metric_;
+}
+inline const ::io::prometheus::client::Metric& MetricFamily::_internal_metric(int index) const {
+  return _impl_.metric_.Get(index);
+}
+inline const ::io::prometheus::client::Metric& MetricFamily::metric(int index) const {
+  // @@protoc_insertion_point(field_get:io.prometheus.client.MetricFamily.metric)
+  return _internal_metric(index);
+}
+inline ::io::prometheus::client::Metric* MetricFamily::_internal_add_metric() {
+  return _impl_.metric_.Add();
+}
+inline ::io::prometheus::client::Metric* MetricFamily::add_metric() {
+  ::io::prometheus::client::Metric* _add = _internal_add_metric();
+  // @@protoc_insertion_point(field_add:io.prometheus.client.MetricFamily.metric)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::io::prometheus::client::Metric >&
+MetricFamily::metric() const {
+  // @@protoc_insertion_point(field_list:io.prometheus.client.MetricFamily.metric)
+  return _impl_.metric_;
+}
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace client
+}  // namespace prometheus
+}  // namespace io
+
+PROTOBUF_NAMESPACE_OPEN
+
+template <> struct is_proto_enum< ::io::prometheus::client::MetricType> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::io::prometheus::client::MetricType>() {
+  return ::io::prometheus::client::MetricType_descriptor();
+}
+
+PROTOBUF_NAMESPACE_CLOSE
+
+// @@protoc_insertion_point(global_scope)
+
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_metrics2_2eproto
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_perf_coroutine.dir/coroutine_perf.cc.o"
+  "CMakeFiles/test_perf_coroutine.dir/coroutine_perf.cc.o.d"
+  "coroutine_perf"
+  "coroutine_perf.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_perf_coroutine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
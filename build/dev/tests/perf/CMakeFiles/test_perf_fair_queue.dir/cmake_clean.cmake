@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_perf_fair_queue.dir/fair_queue_perf.cc.o"
+  "CMakeFiles/test_perf_fair_queue.dir/fair_queue_perf.cc.o.d"
+  "fair_queue_perf"
+  "fair_queue_perf.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_perf_fair_queue.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_perf_flat_btree.dir/flat_btree_perf.cc.o"
+  "CMakeFiles/test_perf_flat_btree.dir/flat_btree_perf.cc.o.d"
+  "flat_btree_perf"
+  "flat_btree_perf.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_perf_flat_btree.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
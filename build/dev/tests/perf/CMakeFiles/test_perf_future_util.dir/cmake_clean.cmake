@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_perf_future_util.dir/future_util_perf.cc.o"
+  "CMakeFiles/test_perf_future_util.dir/future_util_perf.cc.o.d"
+  "future_util_perf"
+  "future_util_perf.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_perf_future_util.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_perf_rpc.dir/rpc_perf.cc.o"
+  "CMakeFiles/test_perf_rpc.dir/rpc_perf.cc.o.d"
+  "rpc_perf"
+  "rpc_perf.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_perf_rpc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_perf_smp.dir/smp_perf.cc.o"
+  "CMakeFiles/test_perf_smp.dir/smp_perf.cc.o.d"
+  "smp_perf"
+  "smp_perf.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_perf_smp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_perf_tcp.dir/tcp_perf.cc.o"
+  "CMakeFiles/test_perf_tcp.dir/tcp_perf.cc.o.d"
+  "tcp_perf"
+  "tcp_perf.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_perf_tcp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/othercrt"
+  "caother.key"
+  "caother.pem"
+  "other.crt"
+  "other.csr"
+  "other.key"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/othercrt.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
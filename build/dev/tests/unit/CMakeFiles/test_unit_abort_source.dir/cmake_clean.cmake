@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_abort_source.dir/abort_source_test.cc.o"
+  "CMakeFiles/test_unit_abort_source.dir/abort_source_test.cc.o.d"
+  "abort_source_test"
+  "abort_source_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_abort_source.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
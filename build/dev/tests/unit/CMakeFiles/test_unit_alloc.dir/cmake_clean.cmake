@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_alloc.dir/alloc_test.cc.o"
+  "CMakeFiles/test_unit_alloc.dir/alloc_test.cc.o.d"
+  "alloc_test"
+  "alloc_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_alloc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_arena.dir/arena_test.cc.o"
+  "CMakeFiles/test_unit_arena.dir/arena_test.cc.o.d"
+  "arena_test"
+  "arena_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_arena.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_checked_ptr.dir/checked_ptr_test.cc.o"
+  "CMakeFiles/test_unit_checked_ptr.dir/checked_ptr_test.cc.o.d"
+  "checked_ptr_test"
+  "checked_ptr_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_checked_ptr.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
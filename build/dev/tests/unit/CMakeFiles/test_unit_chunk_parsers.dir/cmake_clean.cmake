@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_chunk_parsers.dir/chunk_parsers_test.cc.o"
+  "CMakeFiles/test_unit_chunk_parsers.dir/chunk_parsers_test.cc.o.d"
+  "chunk_parsers_test"
+  "chunk_parsers_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_chunk_parsers.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
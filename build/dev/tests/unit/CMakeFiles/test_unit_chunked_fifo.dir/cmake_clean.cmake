@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_chunked_fifo.dir/chunked_fifo_test.cc.o"
+  "CMakeFiles/test_unit_chunked_fifo.dir/chunked_fifo_test.cc.o.d"
+  "chunked_fifo_test"
+  "chunked_fifo_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_chunked_fifo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_chunked_vector.dir/chunked_vector_test.cc.o"
+  "CMakeFiles/test_unit_chunked_vector.dir/chunked_vector_test.cc.o.d"
+  "chunked_vector_test"
+  "chunked_vector_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_chunked_vector.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
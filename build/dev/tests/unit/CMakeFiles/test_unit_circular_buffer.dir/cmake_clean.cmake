@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_circular_buffer.dir/circular_buffer_test.cc.o"
+  "CMakeFiles/test_unit_circular_buffer.dir/circular_buffer_test.cc.o.d"
+  "circular_buffer_test"
+  "circular_buffer_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_circular_buffer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
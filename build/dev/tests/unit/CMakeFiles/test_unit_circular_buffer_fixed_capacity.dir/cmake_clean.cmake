@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_circular_buffer_fixed_capacity.dir/circular_buffer_fixed_capacity_test.cc.o"
+  "CMakeFiles/test_unit_circular_buffer_fixed_capacity.dir/circular_buffer_fixed_capacity_test.cc.o.d"
+  "circular_buffer_fixed_capacity_test"
+  "circular_buffer_fixed_capacity_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_circular_buffer_fixed_capacity.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
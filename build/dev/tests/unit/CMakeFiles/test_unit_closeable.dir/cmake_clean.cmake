@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_closeable.dir/closeable_test.cc.o"
+  "CMakeFiles/test_unit_closeable.dir/closeable_test.cc.o.d"
+  "closeable_test"
+  "closeable_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_closeable.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_content_source.dir/content_source_test.cc.o"
+  "CMakeFiles/test_unit_content_source.dir/content_source_test.cc.o.d"
+  "content_source_test"
+  "content_source_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_content_source.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
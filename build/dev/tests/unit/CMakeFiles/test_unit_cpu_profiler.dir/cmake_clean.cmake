@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_cpu_profiler.dir/cpu_profiler_test.cc.o"
+  "CMakeFiles/test_unit_cpu_profiler.dir/cpu_profiler_test.cc.o.d"
+  "cpu_profiler_test"
+  "cpu_profiler_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_cpu_profiler.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_deleter.dir/deleter_test.cc.o"
+  "CMakeFiles/test_unit_deleter.dir/deleter_test.cc.o.d"
+  "deleter_test"
+  "deleter_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_deleter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
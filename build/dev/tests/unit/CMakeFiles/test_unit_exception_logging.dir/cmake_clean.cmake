@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_exception_logging.dir/exception_logging_test.cc.o"
+  "CMakeFiles/test_unit_exception_logging.dir/exception_logging_test.cc.o.d"
+  "exception_logging_test"
+  "exception_logging_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_exception_logging.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
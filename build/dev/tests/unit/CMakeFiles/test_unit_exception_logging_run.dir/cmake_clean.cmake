@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_exception_logging_run"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/test_unit_exception_logging_run.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_execution_stage.dir/execution_stage_test.cc.o"
+  "CMakeFiles/test_unit_execution_stage.dir/execution_stage_test.cc.o.d"
+  "execution_stage_test"
+  "execution_stage_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_execution_stage.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
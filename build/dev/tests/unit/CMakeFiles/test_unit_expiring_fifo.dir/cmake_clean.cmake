@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_expiring_fifo.dir/expiring_fifo_test.cc.o"
+  "CMakeFiles/test_unit_expiring_fifo.dir/expiring_fifo_test.cc.o.d"
+  "expiring_fifo_test"
+  "expiring_fifo_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_expiring_fifo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_fair_queue.dir/fair_queue_test.cc.o"
+  "CMakeFiles/test_unit_fair_queue.dir/fair_queue_test.cc.o.d"
+  "fair_queue_test"
+  "fair_queue_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_fair_queue.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_file_io.dir/file_io_test.cc.o"
+  "CMakeFiles/test_unit_file_io.dir/file_io_test.cc.o.d"
+  "file_io_test"
+  "file_io_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_file_io.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
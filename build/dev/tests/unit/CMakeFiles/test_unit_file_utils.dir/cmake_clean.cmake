@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_file_utils.dir/file_utils_test.cc.o"
+  "CMakeFiles/test_unit_file_utils.dir/file_utils_test.cc.o.d"
+  "file_utils_test"
+  "file_utils_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_file_utils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
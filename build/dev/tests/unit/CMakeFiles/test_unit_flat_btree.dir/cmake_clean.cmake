@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_flat_btree.dir/flat_btree_test.cc.o"
+  "CMakeFiles/test_unit_flat_btree.dir/flat_btree_test.cc.o.d"
+  "flat_btree_test"
+  "flat_btree_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_flat_btree.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_foreign_ptr.dir/foreign_ptr_test.cc.o"
+  "CMakeFiles/test_unit_foreign_ptr.dir/foreign_ptr_test.cc.o.d"
+  "foreign_ptr_test"
+  "foreign_ptr_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_foreign_ptr.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_io_queue.dir/io_queue_test.cc.o"
+  "CMakeFiles/test_unit_io_queue.dir/io_queue_test.cc.o.d"
+  "io_queue_test"
+  "io_queue_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_io_queue.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_ipv6.dir/ipv6_test.cc.o"
+  "CMakeFiles/test_unit_ipv6.dir/ipv6_test.cc.o.d"
+  "ipv6_test"
+  "ipv6_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_ipv6.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
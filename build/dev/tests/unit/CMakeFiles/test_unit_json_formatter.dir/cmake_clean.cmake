@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_json_formatter.dir/json_formatter_test.cc.o"
+  "CMakeFiles/test_unit_json_formatter.dir/json_formatter_test.cc.o.d"
+  "json_formatter_test"
+  "json_formatter_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_json_formatter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
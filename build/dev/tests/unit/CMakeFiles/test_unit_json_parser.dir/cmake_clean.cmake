@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_json_parser.dir/json_parser_test.cc.o"
+  "CMakeFiles/test_unit_json_parser.dir/json_parser_test.cc.o.d"
+  "json_parser_test"
+  "json_parser_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_json_parser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_log_buf.dir/log_buf_test.cc.o"
+  "CMakeFiles/test_unit_log_buf.dir/log_buf_test.cc.o.d"
+  "log_buf_test"
+  "log_buf_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_log_buf.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
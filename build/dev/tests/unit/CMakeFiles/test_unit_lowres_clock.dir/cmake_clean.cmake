@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_lowres_clock.dir/lowres_clock_test.cc.o"
+  "CMakeFiles/test_unit_lowres_clock.dir/lowres_clock_test.cc.o.d"
+  "lowres_clock_test"
+  "lowres_clock_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_lowres_clock.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
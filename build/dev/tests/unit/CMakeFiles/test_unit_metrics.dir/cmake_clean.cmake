@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_metrics.dir/metrics_test.cc.o"
+  "CMakeFiles/test_unit_metrics.dir/metrics_test.cc.o.d"
+  "metrics_test"
+  "metrics_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_metrics.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
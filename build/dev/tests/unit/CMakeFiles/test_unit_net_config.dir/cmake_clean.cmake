@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_net_config.dir/net_config_test.cc.o"
+  "CMakeFiles/test_unit_net_config.dir/net_config_test.cc.o.d"
+  "net_config_test"
+  "net_config_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_net_config.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
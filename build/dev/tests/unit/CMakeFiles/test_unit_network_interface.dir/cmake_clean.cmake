@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_network_interface.dir/network_interface_test.cc.o"
+  "CMakeFiles/test_unit_network_interface.dir/network_interface_test.cc.o.d"
+  "network_interface_test"
+  "network_interface_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_network_interface.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_noncopyable_function.dir/noncopyable_function_test.cc.o"
+  "CMakeFiles/test_unit_noncopyable_function.dir/noncopyable_function_test.cc.o.d"
+  "noncopyable_function_test"
+  "noncopyable_function_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_noncopyable_function.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_program_options.dir/program_options_test.cc.o"
+  "CMakeFiles/test_unit_program_options.dir/program_options_test.cc.o.d"
+  "program_options_test"
+  "program_options_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_program_options.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
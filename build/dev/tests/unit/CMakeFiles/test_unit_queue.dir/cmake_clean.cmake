@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_queue.dir/queue_test.cc.o"
+  "CMakeFiles/test_unit_queue.dir/queue_test.cc.o.d"
+  "queue_test"
+  "queue_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_queue.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_request_parser.dir/request_parser_test.cc.o"
+  "CMakeFiles/test_unit_request_parser.dir/request_parser_test.cc.o.d"
+  "request_parser_test"
+  "request_parser_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_request_parser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
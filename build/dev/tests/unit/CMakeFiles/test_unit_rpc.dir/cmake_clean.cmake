@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_rpc.dir/rpc_test.cc.o"
+  "CMakeFiles/test_unit_rpc.dir/rpc_test.cc.o.d"
+  "rpc_test"
+  "rpc_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_rpc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_rx_buffer_pool.dir/rx_buffer_pool_test.cc.o"
+  "CMakeFiles/test_unit_rx_buffer_pool.dir/rx_buffer_pool_test.cc.o.d"
+  "rx_buffer_pool_test"
+  "rx_buffer_pool_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_rx_buffer_pool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
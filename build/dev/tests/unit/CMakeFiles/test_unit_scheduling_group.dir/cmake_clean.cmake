@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_scheduling_group.dir/scheduling_group_test.cc.o"
+  "CMakeFiles/test_unit_scheduling_group.dir/scheduling_group_test.cc.o.d"
+  "scheduling_group_test"
+  "scheduling_group_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_scheduling_group.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
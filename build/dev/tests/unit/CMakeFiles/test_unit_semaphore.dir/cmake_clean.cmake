@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_semaphore.dir/semaphore_test.cc.o"
+  "CMakeFiles/test_unit_semaphore.dir/semaphore_test.cc.o.d"
+  "semaphore_test"
+  "semaphore_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_semaphore.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_shared_ptr.dir/shared_ptr_test.cc.o"
+  "CMakeFiles/test_unit_shared_ptr.dir/shared_ptr_test.cc.o.d"
+  "shared_ptr_test"
+  "shared_ptr_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_shared_ptr.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_shared_snapshot.dir/shared_snapshot_test.cc.o"
+  "CMakeFiles/test_unit_shared_snapshot.dir/shared_snapshot_test.cc.o.d"
+  "shared_snapshot_test"
+  "shared_snapshot_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_shared_snapshot.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_shm_stack.dir/shm_stack_test.cc.o"
+  "CMakeFiles/test_unit_shm_stack.dir/shm_stack_test.cc.o.d"
+  "shm_stack_test"
+  "shm_stack_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_shm_stack.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_signal.dir/signal_test.cc.o"
+  "CMakeFiles/test_unit_signal.dir/signal_test.cc.o.d"
+  "signal_test"
+  "signal_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_signal.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
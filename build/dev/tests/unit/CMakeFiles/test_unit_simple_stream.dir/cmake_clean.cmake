@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_simple_stream.dir/simple_stream_test.cc.o"
+  "CMakeFiles/test_unit_simple_stream.dir/simple_stream_test.cc.o.d"
+  "simple_stream_test"
+  "simple_stream_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_simple_stream.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_spsc_channel.dir/spsc_channel_test.cc.o"
+  "CMakeFiles/test_unit_spsc_channel.dir/spsc_channel_test.cc.o.d"
+  "spsc_channel_test"
+  "spsc_channel_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_spsc_channel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
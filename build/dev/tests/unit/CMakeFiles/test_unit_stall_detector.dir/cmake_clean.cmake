@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_stall_detector.dir/stall_detector_test.cc.o"
+  "CMakeFiles/test_unit_stall_detector.dir/stall_detector_test.cc.o.d"
+  "stall_detector_test"
+  "stall_detector_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_stall_detector.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
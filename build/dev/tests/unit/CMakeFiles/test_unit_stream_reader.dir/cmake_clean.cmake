@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_stream_reader.dir/stream_reader_test.cc.o"
+  "CMakeFiles/test_unit_stream_reader.dir/stream_reader_test.cc.o.d"
+  "stream_reader_test"
+  "stream_reader_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_stream_reader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_task_pool.dir/task_pool_test.cc.o"
+  "CMakeFiles/test_unit_task_pool.dir/task_pool_test.cc.o.d"
+  "task_pool_test"
+  "task_pool_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_task_pool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
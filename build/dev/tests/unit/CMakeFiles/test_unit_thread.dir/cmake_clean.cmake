@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_thread.dir/thread_test.cc.o"
+  "CMakeFiles/test_unit_thread.dir/thread_test.cc.o.d"
+  "thread_test"
+  "thread_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_thread.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
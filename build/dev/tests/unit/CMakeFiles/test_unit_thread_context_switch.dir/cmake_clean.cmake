@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_thread_context_switch.dir/thread_context_switch_test.cc.o"
+  "CMakeFiles/test_unit_thread_context_switch.dir/thread_context_switch_test.cc.o.d"
+  "thread_context_switch_test"
+  "thread_context_switch_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_thread_context_switch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_timer_set.dir/timer_set_test.cc.o"
+  "CMakeFiles/test_unit_timer_set.dir/timer_set_test.cc.o.d"
+  "timer_set_test"
+  "timer_set_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_timer_set.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_tsc_clock.dir/tsc_clock_test.cc.o"
+  "CMakeFiles/test_unit_tsc_clock.dir/tsc_clock_test.cc.o.d"
+  "tsc_clock_test"
+  "tsc_clock_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_tsc_clock.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_tuple_utils.dir/tuple_utils_test.cc.o"
+  "CMakeFiles/test_unit_tuple_utils.dir/tuple_utils_test.cc.o.d"
+  "tuple_utils_test"
+  "tuple_utils_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_tuple_utils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_unix_domain.dir/unix_domain_test.cc.o"
+  "CMakeFiles/test_unit_unix_domain.dir/unix_domain_test.cc.o.d"
+  "unix_domain_test"
+  "unix_domain_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_unix_domain.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_unwind.dir/unwind_test.cc.o"
+  "CMakeFiles/test_unit_unwind.dir/unwind_test.cc.o.d"
+  "unwind_test"
+  "unwind_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_unwind.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
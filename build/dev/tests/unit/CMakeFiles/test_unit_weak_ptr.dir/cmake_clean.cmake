@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_weak_ptr.dir/weak_ptr_test.cc.o"
+  "CMakeFiles/test_unit_weak_ptr.dir/weak_ptr_test.cc.o.d"
+  "weak_ptr_test"
+  "weak_ptr_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_weak_ptr.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unit_work_stealing.dir/work_stealing_test.cc.o"
+  "CMakeFiles/test_unit_work_stealing.dir/work_stealing_test.cc.o.d"
+  "work_stealing_test"
+  "work_stealing_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unit_work_stealing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
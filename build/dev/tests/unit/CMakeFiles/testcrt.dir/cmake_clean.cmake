@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/testcrt"
+  "catest.key"
+  "catest.pem"
+  "test.crt"
+  "test.csr"
+  "test.key"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/testcrt.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
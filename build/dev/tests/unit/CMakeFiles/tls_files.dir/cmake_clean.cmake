@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tls_files"
+  "tls-ca-bundle.pem"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/tls_files.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
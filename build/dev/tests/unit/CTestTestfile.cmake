@@ -0,0 +1,170 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/unit
+# Build directory: /root/repo/build/dev/tests/unit
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(Seastar.unit.abort_source "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_abort_source_run")
+set_tests_properties(Seastar.unit.abort_source PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;224;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.alloc "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_alloc_run")
+set_tests_properties(Seastar.unit.alloc PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;227;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.allocator "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_allocator_run")
+set_tests_properties(Seastar.unit.allocator PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;240;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.alien "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_alien_run")
+set_tests_properties(Seastar.unit.alien PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;199;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;244;seastar_add_app_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.arena "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_arena_run")
+set_tests_properties(Seastar.unit.arena PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;247;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.cpu_profiler "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_cpu_profiler_run")
+set_tests_properties(Seastar.unit.cpu_profiler PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;251;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.checked_ptr "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_checked_ptr_run")
+set_tests_properties(Seastar.unit.checked_ptr PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;254;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.chunked_fifo "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_chunked_fifo_run")
+set_tests_properties(Seastar.unit.chunked_fifo PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;257;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.chunked_vector "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_chunked_vector_run")
+set_tests_properties(Seastar.unit.chunked_vector PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;260;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.chunk_parsers "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_chunk_parsers_run")
+set_tests_properties(Seastar.unit.chunk_parsers PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;263;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.circular_buffer "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_circular_buffer_run")
+set_tests_properties(Seastar.unit.circular_buffer PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;266;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.circular_buffer_fixed_capacity "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_circular_buffer_fixed_capacity_run")
+set_tests_properties(Seastar.unit.circular_buffer_fixed_capacity PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;269;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.connect "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_connect_run")
+set_tests_properties(Seastar.unit.connect PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;272;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.content_source "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_content_source_run")
+set_tests_properties(Seastar.unit.content_source PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;275;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.coroutines "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_coroutines_run")
+set_tests_properties(Seastar.unit.coroutines PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;278;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.defer "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_defer_run")
+set_tests_properties(Seastar.unit.defer PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;281;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.deleter "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_deleter_run")
+set_tests_properties(Seastar.unit.deleter PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;284;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.directory "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_directory_run")
+set_tests_properties(Seastar.unit.directory PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;199;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;287;seastar_add_app_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.distributed "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_distributed_run")
+set_tests_properties(Seastar.unit.distributed PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;290;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.dns "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_dns_run")
+set_tests_properties(Seastar.unit.dns PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;293;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.execution_stage "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_execution_stage_run")
+set_tests_properties(Seastar.unit.execution_stage PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;296;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.expiring_fifo "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_expiring_fifo_run")
+set_tests_properties(Seastar.unit.expiring_fifo PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;299;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.flat_btree "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_flat_btree_run")
+set_tests_properties(Seastar.unit.flat_btree PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;302;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.io_queue "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_io_queue_run")
+set_tests_properties(Seastar.unit.io_queue PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;305;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.egress "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_egress_run")
+set_tests_properties(Seastar.unit.egress PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;308;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.fair_queue "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_fair_queue_run")
+set_tests_properties(Seastar.unit.fair_queue PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;311;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.file_io "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_file_io_run")
+set_tests_properties(Seastar.unit.file_io PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;314;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.file_utils "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_file_utils_run")
+set_tests_properties(Seastar.unit.file_utils PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;317;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.foreign_ptr "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_foreign_ptr_run")
+set_tests_properties(Seastar.unit.foreign_ptr PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;320;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.fsnotifier "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_fsnotifier_run")
+set_tests_properties(Seastar.unit.fsnotifier PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;323;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.fstream "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_fstream_run")
+set_tests_properties(Seastar.unit.fstream PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;326;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.futures "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_futures_run")
+set_tests_properties(Seastar.unit.futures PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;331;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.sharded "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_sharded_run")
+set_tests_properties(Seastar.unit.sharded PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;334;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.shared_snapshot "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_shared_snapshot_run")
+set_tests_properties(Seastar.unit.shared_snapshot PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;337;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.httpd "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_httpd_run")
+set_tests_properties(Seastar.unit.httpd PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;340;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.ipv6 "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_ipv6_run")
+set_tests_properties(Seastar.unit.ipv6 PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;345;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.network_interface "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_network_interface_run")
+set_tests_properties(Seastar.unit.network_interface PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;348;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.json_formatter "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_json_formatter_run")
+set_tests_properties(Seastar.unit.json_formatter PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;351;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.json_parser "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_json_parser_run")
+set_tests_properties(Seastar.unit.json_parser PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;354;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.locking "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_locking_run")
+set_tests_properties(Seastar.unit.locking PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;357;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.lowres_clock "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_lowres_clock_run")
+set_tests_properties(Seastar.unit.lowres_clock PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;360;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.metrics "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_metrics_run")
+set_tests_properties(Seastar.unit.metrics PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;363;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.net_config "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_net_config_run")
+set_tests_properties(Seastar.unit.net_config PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;366;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.noncopyable_function "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_noncopyable_function_run")
+set_tests_properties(Seastar.unit.noncopyable_function PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;370;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.output_stream "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_output_stream_run")
+set_tests_properties(Seastar.unit.output_stream PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;374;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.packet "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_packet_run")
+set_tests_properties(Seastar.unit.packet PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;377;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.program_options "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_program_options_run")
+set_tests_properties(Seastar.unit.program_options PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;381;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.queue "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_queue_run")
+set_tests_properties(Seastar.unit.queue PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;385;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.request_parser "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_request_parser_run")
+set_tests_properties(Seastar.unit.request_parser PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;388;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.rpc "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_rpc_run")
+set_tests_properties(Seastar.unit.rpc PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;391;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.rx_buffer_pool "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_rx_buffer_pool_run")
+set_tests_properties(Seastar.unit.rx_buffer_pool PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;396;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.semaphore "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_semaphore_run")
+set_tests_properties(Seastar.unit.semaphore PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;400;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.shared_ptr "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_shared_ptr_run")
+set_tests_properties(Seastar.unit.shared_ptr PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;403;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.shm_stack "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_shm_stack_run")
+set_tests_properties(Seastar.unit.shm_stack PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;407;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.signal "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_signal_run")
+set_tests_properties(Seastar.unit.signal PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;410;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.simple_stream "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_simple_stream_run")
+set_tests_properties(Seastar.unit.simple_stream PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;413;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.smp "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_smp_run")
+set_tests_properties(Seastar.unit.smp PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;199;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;422;seastar_add_app_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.socket "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_socket_run")
+set_tests_properties(Seastar.unit.socket PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;199;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;425;seastar_add_app_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.spsc_channel "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_spsc_channel_run")
+set_tests_properties(Seastar.unit.spsc_channel PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;428;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.sstring "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_sstring_run")
+set_tests_properties(Seastar.unit.sstring PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;431;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.stall_detector "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_stall_detector_run")
+set_tests_properties(Seastar.unit.stall_detector PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;435;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.stream_reader "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_stream_reader_run")
+set_tests_properties(Seastar.unit.stream_reader PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;438;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.task_pool "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_task_pool_run")
+set_tests_properties(Seastar.unit.task_pool PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;441;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.thread "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_thread_run")
+set_tests_properties(Seastar.unit.thread PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;445;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.tracer "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_tracer_run")
+set_tests_properties(Seastar.unit.tracer PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;448;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.tsc_clock "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_tsc_clock_run")
+set_tests_properties(Seastar.unit.tsc_clock PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;451;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.scheduling_group "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_scheduling_group_run")
+set_tests_properties(Seastar.unit.scheduling_group PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;454;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.thread_context_switch "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_thread_context_switch_run")
+set_tests_properties(Seastar.unit.thread_context_switch PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;199;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;457;seastar_add_app_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.timer "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_timer_run")
+set_tests_properties(Seastar.unit.timer PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;199;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;460;seastar_add_app_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.timer_set "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_timer_set_run")
+set_tests_properties(Seastar.unit.timer_set PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;463;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.timer_wheel "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_timer_wheel_run")
+set_tests_properties(Seastar.unit.timer_wheel PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;467;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.uname "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_uname_run")
+set_tests_properties(Seastar.unit.uname PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;471;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.tls "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_tls_run")
+set_tests_properties(Seastar.unit.tls PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;600;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.tuple_utils "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_tuple_utils_run")
+set_tests_properties(Seastar.unit.tuple_utils PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;606;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.unix_domain "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_unix_domain_run")
+set_tests_properties(Seastar.unit.unix_domain PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;610;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.unwind "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_unwind_run")
+set_tests_properties(Seastar.unit.unwind PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;613;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.weak_ptr "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_weak_ptr_run")
+set_tests_properties(Seastar.unit.weak_ptr PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;617;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.work_stealing "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_work_stealing_run")
+set_tests_properties(Seastar.unit.work_stealing PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;621;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.log "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_log_run")
+set_tests_properties(Seastar.unit.log PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;624;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.log_buf "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_log_buf_run")
+set_tests_properties(Seastar.unit.log_buf PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;627;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.exception_logging "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_exception_logging_run")
+set_tests_properties(Seastar.unit.exception_logging PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;630;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
+add_test(Seastar.unit.closeable "/usr/bin/cmake" "--build" "/root/repo/build/dev" "--target" "test_unit_closeable_run")
+set_tests_properties(Seastar.unit.closeable PROPERTIES  ENVIRONMENT "ASAN_OPTIONS=disable_coredump=0:abort_on_error=1:detect_stack_use_after_return=1;UBSAN_OPTIONS=halt_on_error=1:abort_on_error=1;BOOST_TEST_CATCH_SYSTEM_ERRORS=no" TIMEOUT "300" _BACKTRACE_TRIPLES "/root/repo/tests/unit/CMakeLists.txt;169;add_test;/root/repo/tests/unit/CMakeLists.txt;634;seastar_add_test;/root/repo/tests/unit/CMakeLists.txt;0;")
@@ -55,6 +55,7 @@ macro (seastar_find_dependencies)
     dpdk # No version information published.
     fmt
     lz4
+    zstd
     # Private and private/public dependencies.
     Concepts
     GnuTLS
@@ -86,6 +87,7 @@ macro (seastar_find_dependencies)
   set (_seastar_dep_args_cryptopp 5.6.5 REQUIRED)
   set (_seastar_dep_args_fmt 5.0.0 REQUIRED)
   set (_seastar_dep_args_lz4 1.7.3 REQUIRED)
+  set (_seastar_dep_args_zstd 1.4.0 REQUIRED)
   set (_seastar_dep_args_GnuTLS 3.3.26 REQUIRED)
   set (_seastar_dep_args_Protobuf 2.5.0 REQUIRED)
   set (_seastar_dep_args_StdAtomic REQUIRED)
@@ -27,19 +27,66 @@ namespace seastar {
 
 namespace internal {
 void* allocate_aligned_buffer_impl(size_t size, size_t align);
+
+// Hooks for the io_uring backend's pre-registered DMA buffer pool (see
+// reactor_backend_uring). When the pool is enabled on this shard, aligned
+// buffers are carved from it so the kernel can skip page pinning on every
+// submission, and frees must be routed back to it.
+extern thread_local void* (*allocate_registered_buffer_hook)(size_t size, size_t align);
+extern thread_local char* registered_buffer_base;
+extern thread_local size_t registered_buffer_size;
+void free_registered_buffer(void* p) noexcept;
+
+// Shard-local pool of pre-aligned 4k..128k buffers used by streaming
+// I/O, so read-ahead and flush chunks don't pay an allocation plus page
+// faults each. Returns nullptr when the size or alignment is not
+// poolable; free_deleter offers eligible buffers back to the pool with
+// try_recycle_aligned_buffer(), which returns false when the buffer
+// should be freed normally instead.
+void* allocate_pooled_aligned_buffer(size_t size, size_t align);
+bool try_recycle_aligned_buffer(void* p) noexcept;
 }
 
 struct free_deleter {
-    void operator()(void* p) { ::free(p); }
+    void operator()(void* p) {
+        auto* c = reinterpret_cast<char*>(p);
+        if (__builtin_expect(c >= internal::registered_buffer_base
+                && c < internal::registered_buffer_base + internal::registered_buffer_size, false)) {
+            internal::free_registered_buffer(p);
+        } else if (!internal::try_recycle_aligned_buffer(p)) {
+            ::free(p);
+        }
+    }
 };
 
 template <typename CharType>
 inline
 std::unique_ptr<CharType[], free_deleter> allocate_aligned_buffer(size_t size, size_t align) {
     static_assert(sizeof(CharType) == 1, "must allocate byte type");
+    if (auto hook = internal::allocate_registered_buffer_hook; __builtin_expect(hook != nullptr, false)) {
+        if (void* ret = hook(size, align)) {
+            return std::unique_ptr<CharType[], free_deleter>(reinterpret_cast<CharType *>(ret));
+        }
+    }
     void* ret = internal::allocate_aligned_buffer_impl(size, align);
     return std::unique_ptr<CharType[], free_deleter>(reinterpret_cast<CharType *>(ret));
 }
 
+/// Allocates an aligned buffer like \ref allocate_aligned_buffer(),
+/// preferring the shard-local pool of pre-aligned buffers; destroying the
+/// handle returns the buffer to the pool. Suited for short-lived DMA
+/// buffers such as file stream chunks.
+template <typename CharType>
+inline
+std::unique_ptr<CharType[], free_deleter> allocate_pooled_aligned_buffer(size_t size, size_t align) {
+    static_assert(sizeof(CharType) == 1, "must allocate byte type");
+    if (!internal::allocate_registered_buffer_hook) {
+        if (void* ret = internal::allocate_pooled_aligned_buffer(size, align)) {
+            return std::unique_ptr<CharType[], free_deleter>(reinterpret_cast<CharType *>(ret));
+        }
+    }
+    return allocate_aligned_buffer<CharType>(size, align);
+}
+
 
 }
@@ -0,0 +1,346 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright 2021 ScyllaDB
+ */
+
+#pragma once
+
+#include <seastar/core/align.hh>
+#include <seastar/core/layered_file.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <algorithm>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+namespace seastar {
+
+/// \addtogroup fileio-module
+/// @{
+
+/// Counters kept by a file created with \ref make_cached_file.
+///
+/// The structure is shared with the caller, which may read the counters at
+/// any time, e.g. to export them as metrics.
+struct cached_file_stats {
+    uint64_t hits = 0;          ///< Reads served entirely from the cache
+    uint64_t misses = 0;        ///< Reads that went to the underlying file
+    uint64_t evictions = 0;     ///< Blocks dropped to keep the size bound
+    uint64_t invalidations = 0; ///< Blocks dropped because they were written to
+    uint64_t cached_bytes = 0;  ///< Bytes currently cached
+};
+
+/// Configuration for \ref make_cached_file.
+struct cached_file_options {
+    /// Maximum bytes of file data kept in the cache. The least recently
+    /// used blocks are evicted when the bound is exceeded.
+    size_t cache_size = 4 << 20;
+    /// Cache block granularity. It is rounded up to the underlying file's
+    /// disk read alignment, so cached blocks can be read with dma.
+    size_t block_size = 4096;
+    /// If engaged, the file keeps its counters in this structure.
+    lw_shared_ptr<cached_file_stats> stats = { };
+};
+
+/// \cond internal
+class cached_file_impl : public layered_file_impl {
+    struct cached_block {
+        uint64_t offset;
+        temporary_buffer<uint8_t> data;
+    };
+    using lru_list = std::list<cached_block>;
+
+    cached_file_options _options;
+    lru_list _lru; // front is the most recently used block
+    std::unordered_map<uint64_t, lru_list::iterator> _blocks;
+    size_t _cached_bytes = 0;
+
+    file_impl& underlying() noexcept {
+        return *get_file_impl(_underlying_file);
+    }
+
+    cached_file_stats* stats() const noexcept {
+        return _options.stats.get();
+    }
+
+    void drop_block(std::unordered_map<uint64_t, lru_list::iterator>::iterator i) noexcept {
+        _cached_bytes -= i->second->data.size();
+        _lru.erase(i->second);
+        _blocks.erase(i);
+    }
+
+    void insert(uint64_t offset, temporary_buffer<uint8_t> data) {
+        auto i = _blocks.find(offset);
+        if (i != _blocks.end()) {
+            drop_block(i);
+        }
+        _lru.push_front(cached_block{offset, std::move(data)});
+        try {
+            _blocks.emplace(offset, _lru.begin());
+        } catch (...) {
+            _lru.pop_front();
+            throw;
+        }
+        _cached_bytes += _lru.front().data.size();
+        while (_cached_bytes > _options.cache_size) {
+            if (auto s = stats()) {
+                s->evictions++;
+            }
+            drop_block(_blocks.find(_lru.back().offset));
+        }
+        if (auto s = stats()) {
+            s->cached_bytes = _cached_bytes;
+        }
+    }
+
+    // Finds the block at the given (block-aligned) offset and marks it
+    // as the most recently used one
+    temporary_buffer<uint8_t>* find(uint64_t offset) noexcept {
+        auto i = _blocks.find(offset);
+        if (i == _blocks.end()) {
+            return nullptr;
+        }
+        _lru.splice(_lru.begin(), _lru, i->second);
+        return &i->second->data;
+    }
+
+    // Serves [offset, offset + len) from the cache, if it is fully there.
+    // A range within a single block shares the cached buffer with the
+    // reader; a range spanning several blocks is assembled into a copy.
+    std::optional<temporary_buffer<uint8_t>> try_read(uint64_t offset, size_t len) {
+        uint64_t start = align_down<uint64_t>(offset, _options.block_size);
+        auto b = find(start);
+        if (b == nullptr) {
+            return std::nullopt;
+        }
+        if (offset - start + len <= b->size()) {
+            return b->share(offset - start, len);
+        }
+
+        temporary_buffer<uint8_t> out(len);
+        uint64_t pos = offset;
+        size_t done = 0;
+        while (done < len) {
+            uint64_t boff = align_down<uint64_t>(pos, _options.block_size);
+            b = find(boff);
+            if (b == nullptr || pos - boff >= b->size()) {
+                return std::nullopt;
+            }
+            size_t nr = std::min<size_t>(b->size() - (pos - boff), len - done);
+            std::copy_n(b->get() + (pos - boff), nr, out.get_write() + done);
+            done += nr;
+            pos += nr;
+        }
+        return out;
+    }
+
+    void invalidate(uint64_t offset, uint64_t len) noexcept {
+        if (len == 0 || _blocks.empty()) {
+            return;
+        }
+        for (uint64_t off = align_down<uint64_t>(offset, _options.block_size); off < offset + len; off += _options.block_size) {
+            auto i = _blocks.find(off);
+            if (i != _blocks.end()) {
+                if (auto s = stats()) {
+                    s->invalidations++;
+                }
+                drop_block(i);
+            }
+        }
+        if (auto s = stats()) {
+            s->cached_bytes = _cached_bytes;
+        }
+    }
+
+    // Drops every block overlapping [offset, eof)
+    void invalidate_from(uint64_t offset) noexcept {
+        for (auto i = _blocks.begin(); i != _blocks.end(); ) {
+            if (i->first + i->second->data.size() > offset) {
+                if (auto s = stats()) {
+                    s->invalidations++;
+                }
+                auto drop = i++;
+                drop_block(drop);
+            } else {
+                ++i;
+            }
+        }
+        if (auto s = stats()) {
+            s->cached_bytes = _cached_bytes;
+        }
+    }
+
+public:
+    cached_file_impl(file underlying, cached_file_options options) noexcept
+            : layered_file_impl(std::move(underlying))
+            , _options(std::move(options)) {
+        _options.block_size = std::max<size_t>(align_up<size_t>(_options.block_size, _disk_read_dma_alignment), _disk_read_dma_alignment);
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, const io_priority_class& pc, io_intent* intent) override {
+        if (auto cached = try_read(offset, range_size)) {
+            if (auto s = stats()) {
+                s->hits++;
+            }
+            return make_ready_future<temporary_buffer<uint8_t>>(std::move(*cached));
+        }
+        if (auto s = stats()) {
+            s->misses++;
+        }
+        uint64_t start = align_down<uint64_t>(offset, _options.block_size);
+        uint64_t end = align_up<uint64_t>(offset + range_size, _options.block_size);
+        return underlying().dma_read_bulk(start, end - start, pc, intent).then(
+                [this, offset, range_size, start] (temporary_buffer<uint8_t> data) {
+            // Cut the buffer into blocks. The slices share it, so
+            // populating the cache makes no copies either.
+            for (uint64_t off = start; off < start + data.size(); off += _options.block_size) {
+                size_t len = std::min<size_t>(_options.block_size, data.size() - (off - start));
+                insert(off, data.share(off - start, len));
+            }
+            if (offset >= start + data.size()) {
+                return temporary_buffer<uint8_t>();
+            }
+            return data.share(offset - start, std::min<size_t>(range_size, data.size() - (offset - start)));
+        });
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, const io_priority_class& pc) override {
+        return dma_read_bulk(offset, range_size, pc, nullptr);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, const io_priority_class& pc, io_intent* intent) override {
+        if (auto cached = try_read(pos, len)) {
+            if (auto s = stats()) {
+                s->hits++;
+            }
+            std::copy_n(cached->get(), cached->size(), reinterpret_cast<uint8_t*>(buffer));
+            return make_ready_future<size_t>(cached->size());
+        }
+        if (auto s = stats()) {
+            s->misses++;
+        }
+        return underlying().read_dma(pos, buffer, len, pc, intent);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, const io_priority_class& pc) override {
+        return read_dma(pos, buffer, len, pc, nullptr);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc, io_intent* intent) override {
+        return underlying().read_dma(pos, std::move(iov), pc, intent);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc) override {
+        return underlying().read_dma(pos, std::move(iov), pc);
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, const io_priority_class& pc, io_intent* intent) override {
+        invalidate(pos, len);
+        return underlying().write_dma(pos, buffer, len, pc, intent);
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, const io_priority_class& pc) override {
+        return write_dma(pos, buffer, len, pc, nullptr);
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc, io_intent* intent) override {
+        size_t len = 0;
+        for (auto& v : iov) {
+            len += v.iov_len;
+        }
+        invalidate(pos, len);
+        return underlying().write_dma(pos, std::move(iov), pc, intent);
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc) override {
+        return write_dma(pos, std::move(iov), pc, nullptr);
+    }
+
+    virtual future<> truncate(uint64_t length) override {
+        invalidate_from(length);
+        return underlying().truncate(length);
+    }
+
+    virtual future<> discard(uint64_t offset, uint64_t length) override {
+        invalidate(offset, length);
+        return underlying().discard(offset, length);
+    }
+
+    virtual future<> allocate(uint64_t position, uint64_t length) override {
+        return underlying().allocate(position, length);
+    }
+
+    virtual future<> flush() override {
+        return underlying().flush();
+    }
+
+    virtual future<struct stat> stat() override {
+        return underlying().stat();
+    }
+
+    virtual future<uint64_t> size() override {
+        return underlying().size();
+    }
+
+    virtual future<> close() override {
+        _blocks.clear();
+        _lru.clear();
+        _cached_bytes = 0;
+        if (auto s = stats()) {
+            s->cached_bytes = 0;
+        }
+        return underlying().close();
+    }
+
+    // The handle refers to the underlying file, so the file it opens on
+    // another shard is not cached -- the cache itself is shard-local.
+    virtual std::unique_ptr<file_handle_impl> dup() override {
+        return underlying().dup();
+    }
+
+    virtual subscription<directory_entry> list_directory(std::function<future<> (directory_entry de)> next) override {
+        return underlying().list_directory(std::move(next));
+    }
+};
+/// \endcond
+
+/// Creates a shard-local caching layer on top of an existing file.
+///
+/// Reads populate a size-bounded block cache with least-recently-used
+/// eviction; repeated reads of cached ranges complete without touching the
+/// disk, and a read within a single cached block shares the cached buffer
+/// with the reader instead of copying it. Writes, truncates and discards
+/// through the returned file invalidate the overlapping blocks. Writes done
+/// behind the wrapper's back (e.g. through a duplicated handle) are not
+/// seen, so all writers of a cached file must go through the same wrapper.
+///
+/// This is useful for O_DIRECT files whose hot blocks, like index pages,
+/// are re-read frequently -- there is no kernel page cache to absorb those
+/// reads.
+///
+/// \param underlying the file to cache; owned by the returned file
+/// \param options cache bounds and counters, see \ref cached_file_options
+/// \return a file serving reads from the cache when possible
+inline file make_cached_file(file underlying, cached_file_options options = {}) {
+    return file(make_shared<cached_file_impl>(std::move(underlying), std::move(options)));
+}
+
+/// @}
+
+}
@@ -0,0 +1,300 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2026 ScyllaDB Ltd.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace seastar {
+
+// A vector-like container that avoids large contiguous allocations.
+//
+// std::vector<> keeps all elements in one contiguous allocation, so a large
+// vector both forces the allocator to find a huge contiguous span and copies
+// every element whenever it grows past its capacity - on a large enough
+// vector that copy alone can stall a shard for milliseconds. chunked_vector
+// stores the elements in fixed-size chunks (max_contiguous_allocation bytes
+// each, 128kB by default) and keeps the chunk pointers in a small table, so
+// the largest contiguous allocation it makes is O(1) in the number of
+// elements while indexed access stays O(1): one division by a constant and
+// two dereferences.
+//
+// Growth never moves elements that live in a full chunk; it just appends
+// chunks. The exceptions are the tail chunk while it is still below full
+// size, which is reallocated exponentially the way a small std::vector
+// would be (call reserve() up front to avoid even that), and the chunk
+// pointer table itself, which is contiguous but smaller than the data by
+// a factor of max_contiguous_allocation / sizeof(T*). Consequently growth
+// invalidates iterators, but references to elements in full chunks remain
+// valid.
+//
+// Compared with chunked_fifo<>, which makes the same allocation guarantee,
+// chunked_vector provides random access and random-access iterators, but
+// only supports pushing and popping at the back.
+//
+// chunked_vector uses uninitialized storage and move constructors rather
+// than move assignments when it relocates a tail chunk, so T must be
+// nothrow move constructible.
+template <typename T, size_t max_contiguous_allocation = 128 * 1024>
+class chunked_vector {
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+            "chunked_vector relocates the tail chunk while it grows");
+public:
+    // Number of elements per full chunk.
+    static constexpr size_t max_chunk_capacity() {
+        return std::max(max_contiguous_allocation / sizeof(T), size_t(1));
+    }
+private:
+    // All chunks except the last hold exactly max_chunk_capacity()
+    // elements' worth of storage; the last may be smaller while the
+    // vector is small.
+    std::vector<T*> _chunks;
+    size_t _size = 0;
+    size_t _capacity = 0;
+
+private:
+    static T* alloc_chunk(size_t n) {
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        } else {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+    }
+    static void free_chunk(T* p) noexcept {
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        } else {
+            ::operator delete(p);
+        }
+    }
+    T* addr(size_t i) const noexcept {
+        return &_chunks[i / max_chunk_capacity()][i % max_chunk_capacity()];
+    }
+    static void migrate(T* begin, T* end, T* result) noexcept {
+        while (begin != end) {
+            new (result++) T(std::move(*begin));
+            begin++->~T();
+        }
+    }
+    // Replaces the partial tail chunk with one of new_cap elements,
+    // moving the live elements over.
+    void grow_tail_chunk(size_t new_cap) {
+        auto tail_cap = _capacity % max_chunk_capacity();
+        auto tail_base = _capacity - tail_cap;
+        auto live = _size > tail_base ? _size - tail_base : 0;
+        auto p = alloc_chunk(new_cap);
+        auto old = _chunks.back();
+        migrate(old, old + live, p);
+        free_chunk(old);
+        _chunks.back() = p;
+        _capacity = tail_base + new_cap;
+    }
+    void make_room(size_t n, bool stop_after_one_chunk) {
+        // If the tail chunk is below full size, grow it first -
+        // exponentially, so that a sequence of push_back()s performs
+        // O(log) reallocations - and all the way to a full chunk if more
+        // chunks will follow, since only the last chunk may be partial.
+        if (auto tail_cap = _capacity % max_chunk_capacity()) {
+            auto tail_base = _capacity - tail_cap;
+            auto want = std::min(n - tail_base, max_chunk_capacity());
+            if (want > tail_cap) {
+                grow_tail_chunk(std::max(want, std::min(tail_cap * 2, max_chunk_capacity())));
+            }
+            if (stop_after_one_chunk) {
+                return;
+            }
+        }
+        if (_capacity < n) {
+            // grow the chunk table up front, so that pushing the freshly
+            // allocated chunks cannot throw and leak them
+            _chunks.reserve(_chunks.size() + (n - _capacity + max_chunk_capacity() - 1) / max_chunk_capacity());
+        }
+        while (_capacity < n) {
+            auto cap = std::min(std::max(n - _capacity, size_t(8)), max_chunk_capacity());
+            _chunks.push_back(alloc_chunk(cap));
+            _capacity += cap;
+            if (stop_after_one_chunk) {
+                break;
+            }
+        }
+    }
+
+public:
+    // Iterators remain valid as long as the vector does not grow or
+    // shrink past the element they point at.
+    template <bool Const>
+    class basic_iterator {
+        T* const* _chunks = nullptr;
+        size_t _i = 0;
+        basic_iterator(T* const* chunks, size_t i) noexcept : _chunks(chunks), _i(i) {}
+        friend class chunked_vector;
+        template <bool>
+        friend class basic_iterator;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        basic_iterator() = default;
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        basic_iterator(const basic_iterator<OtherConst>& o) noexcept
+                : _chunks(o._chunks), _i(o._i) {
+        }
+        reference operator*() const noexcept {
+            return _chunks[_i / max_chunk_capacity()][_i % max_chunk_capacity()];
+        }
+        pointer operator->() const noexcept { return &**this; }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+        basic_iterator& operator++() noexcept { ++_i; return *this; }
+        basic_iterator operator++(int) noexcept { auto it = *this; ++_i; return it; }
+        basic_iterator& operator--() noexcept { --_i; return *this; }
+        basic_iterator operator--(int) noexcept { auto it = *this; --_i; return it; }
+        basic_iterator& operator+=(difference_type n) noexcept { _i += n; return *this; }
+        basic_iterator& operator-=(difference_type n) noexcept { _i -= n; return *this; }
+        basic_iterator operator+(difference_type n) const noexcept { return basic_iterator(_chunks, _i + n); }
+        basic_iterator operator-(difference_type n) const noexcept { return basic_iterator(_chunks, _i - n); }
+        friend basic_iterator operator+(difference_type n, const basic_iterator& it) noexcept { return it + n; }
+        difference_type operator-(const basic_iterator& o) const noexcept { return _i - o._i; }
+        bool operator==(const basic_iterator& o) const noexcept { return _i == o._i; }
+        bool operator!=(const basic_iterator& o) const noexcept { return _i != o._i; }
+        bool operator<(const basic_iterator& o) const noexcept { return _i < o._i; }
+        bool operator>(const basic_iterator& o) const noexcept { return _i > o._i; }
+        bool operator<=(const basic_iterator& o) const noexcept { return _i <= o._i; }
+        bool operator>=(const basic_iterator& o) const noexcept { return _i >= o._i; }
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+public:
+    chunked_vector() = default;
+    explicit chunked_vector(size_t n) {
+        resize(n);
+    }
+    chunked_vector(const chunked_vector& x) {
+        reserve(x.size());
+        for (auto& e : x) {
+            push_back(e);
+        }
+    }
+    chunked_vector(chunked_vector&& x) noexcept
+            : _chunks(std::exchange(x._chunks, {}))
+            , _size(std::exchange(x._size, 0))
+            , _capacity(std::exchange(x._capacity, 0)) {
+    }
+    chunked_vector& operator=(const chunked_vector& x) {
+        if (this != &x) {
+            *this = chunked_vector(x);
+        }
+        return *this;
+    }
+    chunked_vector& operator=(chunked_vector&& x) noexcept {
+        if (this != &x) {
+            this->~chunked_vector();
+            new (this) chunked_vector(std::move(x));
+        }
+        return *this;
+    }
+    ~chunked_vector() {
+        for (size_t i = 0; i < _size; ++i) {
+            addr(i)->~T();
+        }
+        for (auto c : _chunks) {
+            free_chunk(c);
+        }
+    }
+
+    size_t size() const noexcept { return _size; }
+    bool empty() const noexcept { return _size == 0; }
+    size_t capacity() const noexcept { return _capacity; }
+
+    T& operator[](size_t i) noexcept { return *addr(i); }
+    const T& operator[](size_t i) const noexcept { return *addr(i); }
+    T& front() noexcept { return *addr(0); }
+    const T& front() const noexcept { return *addr(0); }
+    T& back() noexcept { return *addr(_size - 1); }
+    const T& back() const noexcept { return *addr(_size - 1); }
+
+    iterator begin() noexcept { return iterator(_chunks.data(), 0); }
+    iterator end() noexcept { return iterator(_chunks.data(), _size); }
+    const_iterator begin() const noexcept { return const_iterator(_chunks.data(), 0); }
+    const_iterator end() const noexcept { return const_iterator(_chunks.data(), _size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Ensures room for n elements without further allocation. Unlike
+    // push_back()-driven growth, a reserved tail chunk is never
+    // reallocated, so after reserve(n) no element moves until the vector
+    // grows past n.
+    void reserve(size_t n) {
+        if (n > _capacity) {
+            make_room(n, false);
+        }
+    }
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (_size == _capacity) {
+            make_room(_size + 1, true);
+        }
+        auto p = addr(_size);
+        new (p) T(std::forward<Args>(args)...);
+        ++_size;
+        return *p;
+    }
+    void push_back(const T& x) {
+        emplace_back(x);
+    }
+    void push_back(T&& x) {
+        emplace_back(std::move(x));
+    }
+    void pop_back() noexcept {
+        addr(--_size)->~T();
+    }
+    void resize(size_t n) {
+        while (_size > n) {
+            pop_back();
+        }
+        reserve(n);
+        while (_size < n) {
+            emplace_back();
+        }
+    }
+    // Destroys all elements. The allocated chunks are kept for reuse.
+    void clear() noexcept {
+        while (_size) {
+            pop_back();
+        }
+    }
+};
+
+}
@@ -23,9 +23,11 @@
 
 #include <seastar/core/transfer.hh>
 #include <seastar/core/bitops.hh>
+#include <seastar/core/memory.hh>
 #include <seastar/util/concepts.hh>
 #include <memory>
 #include <algorithm>
+#include <cstring>
 
 namespace seastar {
 
@@ -54,7 +56,8 @@ namespace seastar {
 ///     * pop_front() will invalidate begin() and
 ///     * pop_back() will invalidate end().
 ///
-/// reserve() may also invalidate all iterators and references.
+/// reserve() and reserve_partial() may also invalidate all iterators
+/// and references.
 template <typename T, typename Alloc = std::allocator<T>>
 class circular_buffer {
     struct impl : Alloc {
@@ -109,6 +112,7 @@ public:
     size_t size() const;
     size_t capacity() const;
     void reserve(size_t);
+    bool reserve_partial(size_t);
     void clear();
     T& operator[](size_t idx) noexcept;
     const T& operator[](size_t idx) const noexcept;
@@ -120,6 +124,7 @@ public:
 private:
     void expand();
     void expand(size_t);
+    bool try_expand_in_place(size_t);
     void maybe_expand(size_t nr = 1);
     size_t mask(size_t idx) const;
 
@@ -314,9 +319,62 @@ circular_buffer<T, Alloc>::expand() {
     expand(std::max<size_t>(_impl.capacity * 2, 1));
 }
 
+/// Makes bounded progress towards reserve(size): grows capacity by at
+/// most one doubling step per call, preferring in-place extension of
+/// the existing storage. Returns true once capacity() >= size. Call
+/// repeatedly, e.g. once per task, to spread the cost of a large
+/// reservation over many tasks instead of moving the whole buffer in
+/// one stall.
+template <typename T, typename Alloc>
+inline
+bool
+circular_buffer<T, Alloc>::reserve_partial(size_t size) {
+    if (capacity() >= size) {
+        return true;
+    }
+    // In-place extension does not move elements, so when the allocator
+    // allows it, take the whole reservation at once.
+    if (!try_expand_in_place(size_t(1) << log2ceil(size))) {
+        expand(std::max<size_t>(_impl.capacity * 2, 1));
+    }
+    return capacity() >= size;
+}
+
+template <typename T, typename Alloc>
+bool
+circular_buffer<T, Alloc>::try_expand_in_place(size_t new_cap) {
+    // The wrapped part of the buffer is relocated with memcpy(), and
+    // the storage is extended behind the allocator's back, so both
+    // restrictions below are load-bearing.
+    if constexpr (!std::is_trivially_copyable_v<T> || !std::is_same_v<Alloc, std::allocator<T>>) {
+        return false;
+    } else {
+        if (!_impl.storage || !memory::try_extend(_impl.storage, new_cap * sizeof(T))) {
+            return false;
+        }
+        // Unwrap into the extended storage: the head stays put, and the
+        // wrapped tail, if any, moves to just past the old capacity,
+        // making the contents contiguous. new_cap is at least double
+        // the old capacity, so the unwrapped contents always fit.
+        auto n = size();
+        auto b = mask(_impl.begin);
+        if (b + n > _impl.capacity) {
+            auto wrapped = b + n - _impl.capacity;
+            std::memcpy(_impl.storage + _impl.capacity, _impl.storage, wrapped * sizeof(T));
+        }
+        _impl.begin = b;
+        _impl.end = b + n;
+        _impl.capacity = new_cap;
+        return true;
+    }
+}
+
 template <typename T, typename Alloc>
 void
 circular_buffer<T, Alloc>::expand(size_t new_cap) {
+    if (try_expand_in_place(new_cap)) {
+        return;
+    }
     auto new_storage = _impl.allocate(new_cap);
     auto p = new_storage;
     try {
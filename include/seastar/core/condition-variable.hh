@@ -21,7 +21,9 @@
 
 #pragma once
 
-#include <seastar/core/semaphore.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/expiring_fifo.hh>
+#include <seastar/core/timer.hh>
 #include <seastar/core/loop.hh>
 
 namespace seastar {
@@ -59,19 +61,33 @@ public:
 /// acting as a cancellation point.
 
 class condition_variable {
-    using duration = semaphore::duration;
-    using clock = semaphore::clock;
-    using time_point = semaphore::time_point;
+    using duration = typename timer<>::duration;
+    using clock = typename timer<>::clock;
+    using time_point = typename timer<>::time_point;
     struct condition_variable_exception_factory {
         static condition_variable_timed_out timeout() noexcept;
         static broken_condition_variable broken() noexcept;
     };
-    basic_semaphore<condition_variable_exception_factory> _sem;
+    struct waiter_expiry {
+        void operator()(promise<>& pr) noexcept {
+            pr.set_exception(std::make_exception_ptr(condition_variable_exception_factory::timeout()));
+        }
+    };
+    // Waiters queue up in FIFO order. expiring_fifo keeps them in chunked,
+    // stable storage — a wait does not allocate a queue node of its own —
+    // and takes care of the timed waits.
+    expiring_fifo<promise<>, waiter_expiry, clock> _waiters;
+    std::exception_ptr _ex;
+
+    // How many waiters a single broadcast() call, or a single run of its
+    // drain task, wakes directly. Bounds the number of continuations one
+    // task adds to the run queue; see broadcast().
+    static constexpr size_t max_wakeups_per_task = 128;
+
+    class broadcast_drain_task;
 public:
     /// Constructs a condition_variable object.
-    /// Initialzie the semaphore with a default value of 0 to enusre
-    /// the first call to wait() before signal() won't be waken up immediately.
-    condition_variable() noexcept : _sem(0) {}
+    condition_variable() noexcept = default;
 
     /// Waits until condition variable is signaled, may wake up without condition been met
     ///
@@ -79,7 +95,7 @@ public:
     ///         If the condition variable was \ref broken() will return \ref broken_condition_variable
     ///         exception.
     future<> wait() noexcept {
-        return _sem.wait();
+        return wait(time_point::max());
     }
 
     /// Waits until condition variable is signaled or timeout is reached
@@ -90,7 +106,17 @@ public:
     ///         If the condition variable was \ref broken() will return \ref broken_condition_variable
     ///         exception. If timepoint is reached will return \ref condition_variable_timed_out exception.
     future<> wait(time_point timeout) noexcept {
-        return _sem.wait(timeout);
+        if (_ex) {
+            return make_exception_future<>(_ex);
+        }
+        promise<> pr;
+        auto fut = pr.get_future();
+        try {
+            _waiters.push_back(std::move(pr), timeout);
+        } catch (...) {
+            pr.set_exception(std::current_exception());
+        }
+        return fut;
     }
 
     /// Waits until condition variable is signaled or timeout is reached
@@ -101,7 +127,7 @@ public:
     ///         If the condition variable was \ref broken() will return \ref broken_condition_variable
     ///         exception. If timepoint is passed will return \ref condition_variable_timed_out exception.
     future<> wait(duration timeout) noexcept {
-        return _sem.wait(timeout);
+        return wait(clock::now() + timeout);
     }
 
     /// Waits until condition variable is notified and pred() == true, otherwise
@@ -149,21 +175,27 @@ public:
     }
     /// Notify variable and wake up a waiter if there is one
     void signal() noexcept {
-        if (_sem.waiters()) {
-            _sem.signal();
+        if (_waiters) {
+            _waiters.front().set_value();
+            _waiters.pop_front();
         }
     }
-    /// Notify variable and wake up all waiter
-    void broadcast() noexcept {
-        _sem.signal(_sem.waiters());
-    }
+    /// Notify variable and wake up all waiters
+    ///
+    /// The first waiters, up to an internal quota, are woken from here;
+    /// when more fibers are waiting, the remainder is detached into a
+    /// single drain task that wakes them in quota-sized batches, so a
+    /// broadcast to thousands of waiters does not flood the run queue
+    /// with one task per waiter at once. Detached waiters are woken
+    /// even if the variable is destroyed or \ref broken() afterwards;
+    /// waiters queued after broadcast() returns belong to the next
+    /// broadcast.
+    void broadcast() noexcept;
 
     /// Signal to waiters that an error occurred.  \ref wait() will see
     /// an exceptional future<> containing the provided exception parameter.
     /// The future is made available immediately.
-    void broken() noexcept {
-        _sem.broken();
-    }
+    void broken() noexcept;
 };
 
 /// @}
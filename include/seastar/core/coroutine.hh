@@ -43,6 +43,19 @@ public:
         promise_type(promise_type&&) = delete;
         promise_type(const promise_type&) = delete;
 
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+        // The operators cover the whole coroutine frame, not just the
+        // promise, so frames of coroutines that the compiler could not
+        // elide recycle through the per-thread task_pool rather than
+        // hitting the general allocator on every call.
+        static void* operator new(size_t size) {
+            return internal::local_task_pool.allocate(size);
+        }
+        static void operator delete(void* ptr, size_t size) noexcept {
+            internal::local_task_pool.free(ptr, size);
+        }
+#endif
+
         template<typename... U>
         void return_value(U&&... value) {
             _promise.set_value(std::forward<U>(value)...);
@@ -83,6 +96,16 @@ public:
         promise_type(promise_type&&) = delete;
         promise_type(const promise_type&) = delete;
 
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+        // see coroutine_traits_base<T>::promise_type::operator new
+        static void* operator new(size_t size) {
+            return internal::local_task_pool.allocate(size);
+        }
+        static void operator delete(void* ptr, size_t size) noexcept {
+            internal::local_task_pool.free(ptr, size);
+        }
+#endif
+
         void return_void() noexcept {
             _promise.set_value();
         }
@@ -0,0 +1,54 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#pragma once
+
+#include <seastar/http/httpd.hh>
+#include <chrono>
+
+namespace seastar {
+
+/// \brief start the sampling cpu profiler on the local shard
+///
+/// A sample of the call stack is taken every \c period of cpu time
+/// consumed by the shard and aggregated into a fixed per-shard table of
+/// unique stacks with counts, so an always-on profiler neither grows
+/// nor allocates in the sampling path.
+void enable_cpu_profiler(std::chrono::nanoseconds period = std::chrono::milliseconds(10));
+
+/// \brief stop sampling on the local shard, keeping the collected samples
+void disable_cpu_profiler();
+
+/// \brief the local shard's samples in the collapsed-stack format
+///
+/// One line per unique stack, outermost frame first with frames given
+/// as shared object plus offset, followed by the sample count -- the
+/// input format of flamegraph tooling.
+sstring dump_cpu_profile();
+
+/// \defgroup add_cpu_profiler_routes adds a /profiler endpoint returning the
+///    collapsed stacks of every shard, ready to feed to flamegraph tooling
+/// @{
+future<> add_cpu_profiler_routes(distributed<httpd::http_server>& server);
+future<> add_cpu_profiler_routes(httpd::http_server& server);
+/// @}
+
+}
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <memory>
+#include <new>
 #include <cstdlib>
 #include <assert.h>
 #include <type_traits>
@@ -44,21 +45,43 @@ namespace seastar {
 ///  - decrementing a reference count somewhere
 ///
 /// A deleter performs its action from its destructor.
+///
+/// Deleters with a small encapsulated callable (such as a captured
+/// pointer and a free function, or a reference count decrement) are
+/// stored directly inside the \c deleter object and do not allocate;
+/// sharing or chaining such a deleter moves the callable to a
+/// heap-allocated, reference-counted representation on first use.
 class deleter final {
 public:
     /// \cond internal
     struct impl;
     struct raw_object_tag {};
+    static constexpr size_t inline_storage_size = 2 * sizeof(void*);
     /// \endcond
 private:
+    // Dispatch table for a small callable stored in _inline_storage
+    // instead of a heap-allocated impl.
+    struct inline_ops {
+        void (*run_and_destroy)(void* storage) noexcept;
+        void (*move)(void* dst, void* src) noexcept;
+        impl* (*to_impl)(void* storage);
+    };
     // if bit 0 set, point to object to be freed directly.
+    // if bit 1 set, point to the inline_ops of the callable held in
+    // _inline_storage.
     impl* _impl = nullptr;
+    alignas(void*) char _inline_storage[inline_storage_size];
 public:
     /// Constructs an empty deleter that does nothing in its destructor.
     deleter() noexcept = default;
     deleter(const deleter&) = delete;
     /// Moves a deleter.
-    deleter(deleter&& x) noexcept : _impl(x._impl) { x._impl = nullptr; }
+    deleter(deleter&& x) noexcept : _impl(x._impl) {
+        if (is_inline()) {
+            get_inline_ops()->move(_inline_storage, x._inline_storage);
+        }
+        x._impl = nullptr;
+    }
     /// \cond internal
     explicit deleter(impl* i) noexcept : _impl(i) {}
     deleter(raw_object_tag tag, void* object) noexcept
@@ -104,6 +127,34 @@ private:
         auto x = reinterpret_cast<uintptr_t>(object);
         return reinterpret_cast<impl*>(x | 1);
     }
+    static bool is_inline(impl* i) noexcept {
+        auto x = reinterpret_cast<uintptr_t>(i);
+        return x & 2;
+    }
+    bool is_inline() const noexcept {
+        return is_inline(_impl);
+    }
+    const inline_ops* get_inline_ops() const noexcept {
+        auto x = reinterpret_cast<uintptr_t>(_impl);
+        return reinterpret_cast<const inline_ops*>(x & ~uintptr_t(2));
+    }
+    // Moves an inline callable into a heap-allocated impl, so it can be
+    // reference counted (share()) or chained (append()).
+    impl* promote_to_impl() {
+        _impl = get_inline_ops()->to_impl(_inline_storage);
+        return _impl;
+    }
+public:
+    /// \cond internal
+    template <typename Deleter>
+    static constexpr bool can_be_inlined =
+        sizeof(Deleter) <= inline_storage_size
+        && alignof(Deleter) <= alignof(void*)
+        && std::is_nothrow_move_constructible<Deleter>::value;
+
+    template <typename Deleter>
+    static deleter make_inline(Deleter del) noexcept;
+    /// \endcond
 };
 
 /// \cond internal
@@ -121,6 +172,10 @@ deleter::~deleter() {
         std::free(to_raw_object());
         return;
     }
+    if (is_inline()) {
+        get_inline_ops()->run_and_destroy(_inline_storage);
+        return;
+    }
     if (_impl && --_impl->refs == 0) {
         delete _impl;
     }
@@ -156,6 +211,34 @@ inline
 object_deleter_impl<Object>* make_object_deleter_impl(deleter next, Object obj) {
     return new object_deleter_impl<Object>(std::move(next), std::move(obj));
 }
+
+template <typename Deleter>
+inline
+deleter deleter::make_inline(Deleter del) noexcept {
+    static_assert(can_be_inlined<Deleter>, "callable too large to be stored inline");
+    static const inline_ops ops = {
+        [] (void* storage) noexcept {
+            auto d = static_cast<Deleter*>(storage);
+            (*d)();
+            d->~Deleter();
+        },
+        [] (void* dst, void* src) noexcept {
+            auto d = static_cast<Deleter*>(src);
+            new (dst) Deleter(std::move(*d));
+            d->~Deleter();
+        },
+        [] (void* storage) -> impl* {
+            auto d = static_cast<Deleter*>(storage);
+            auto i = new lambda_deleter_impl<Deleter>(deleter(), std::move(*d));
+            d->~Deleter();
+            return i;
+        },
+    };
+    deleter ret;
+    new (ret._inline_storage) Deleter(std::move(del));
+    ret._impl = reinterpret_cast<impl*>(reinterpret_cast<uintptr_t>(&ops) | 2);
+    return ret;
+}
 /// \endcond
 
 /// Makes a \ref deleter that encapsulates the action of
@@ -168,6 +251,11 @@ object_deleter_impl<Object>* make_object_deleter_impl(deleter next, Object obj)
 template <typename Object>
 deleter
 make_deleter(deleter next, Object o) {
+    if constexpr (deleter::can_be_inlined<Object>) {
+        if (!next) {
+            return deleter::make_inline(std::move(o));
+        }
+    }
     return deleter(new lambda_deleter_impl<Object>(std::move(next), std::move(o)));
 }
 
@@ -198,6 +286,10 @@ deleter::share() {
     }
     if (is_raw_object()) {
         _impl = new free_deleter_impl(to_raw_object());
+    } else if (is_inline()) {
+        // sharing needs a reference count, which the inline
+        // representation doesn't have
+        promote_to_impl();
     }
     ++_impl->refs;
     return deleter(_impl);
@@ -214,11 +306,15 @@ void deleter::append(deleter d) {
     impl* next_impl = _impl;
     deleter* next_d = this;
     while (next_impl) {
-        if (next_impl == d._impl) {
+        if (!is_inline(d._impl) && next_impl == d._impl) {
             return; // Already appended
         }
         if (is_raw_object(next_impl)) {
             next_d->_impl = next_impl = new free_deleter_impl(to_raw_object(next_impl));
+        } else if (is_inline(next_impl)) {
+            // chaining needs impl::next, which the inline representation
+            // doesn't have
+            next_impl = next_d->promote_to_impl();
         }
 
         if (next_impl->refs != 1) {
@@ -229,8 +325,7 @@ void deleter::append(deleter d) {
         next_d = &next_impl->next;
         next_impl = next_d->_impl;
     }
-    next_d->_impl = d._impl;
-    d._impl = nullptr;
+    *next_d = std::move(d);
 }
 
 /// Makes a deleter that calls \c std::free() when it is destroyed.
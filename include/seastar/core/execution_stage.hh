@@ -35,6 +35,7 @@
 #include <seastar/util/std-compat.hh>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
+#include <chrono>
 #include <vector>
 #include <boost/range/irange.hpp>
 #include <boost/range/adaptor/transformed.hpp>
@@ -126,16 +127,34 @@ public:
         uint64_t tasks_preempted = 0;
         uint64_t function_calls_enqueued = 0;
         uint64_t function_calls_executed = 0;
+        uint64_t batch_limit_reached = 0;
     };
 protected:
+    // Fixed-point scale of the execution-cost moving average.
+    static constexpr unsigned cost_ema_bits = 3;
     bool _empty = true;
     bool _flush_scheduled = false;
     scheduling_group _sg;
     stats _stats;
     sstring _name;
     metrics::metric_group _metric_group;
+    // Time budget for a single batch; zero means unlimited (batches end
+    // only on preemption).
+    std::chrono::nanoseconds _max_batch_duration = std::chrono::nanoseconds::zero();
+    // Moving average of the execution time of one queued call, in
+    // nanoseconds scaled by 2^cost_ema_bits. Maintained only when a batch
+    // duration limit is set.
+    uint64_t _ns_per_call_ema = 0;
+    // Number of calls fitting in _max_batch_duration at the current
+    // average cost; recomputed after every batch.
+    size_t _batch_limit = std::numeric_limits<size_t>::max();
 protected:
     virtual void do_flush() noexcept = 0;
+    bool batch_is_limited() const noexcept {
+        return _max_batch_duration != std::chrono::nanoseconds::zero();
+    }
+    // Feeds the observed cost of a batch back into the batch limit.
+    void account_batch(size_t nr_executed, std::chrono::nanoseconds elapsed) noexcept;
 public:
     explicit execution_stage(const sstring& name, scheduling_group sg = {});
     virtual ~execution_stage();
@@ -171,6 +190,26 @@ public:
     bool poll() const noexcept {
         return !_empty;
     }
+
+    /// Caps the execution time of a single batch.
+    ///
+    /// The stage measures the average cost of its function calls and ends
+    /// a batch once the number of calls whose combined cost fits in the
+    /// given budget has been executed; remaining queued calls are picked
+    /// up by the next flush. The limit adapts automatically as the cost
+    /// of the wrapped function changes (e.g. with its cache footprint).
+    /// A zero duration (the default) removes the limit, ending batches
+    /// on preemption only.
+    void set_max_batch_duration(std::chrono::nanoseconds duration) noexcept {
+        _max_batch_duration = duration;
+        _batch_limit = std::numeric_limits<size_t>::max();
+    }
+
+    /// Caps the execution time of a single batch to the reactor's task
+    /// quota (\c --task-quota-ms), so that a large backlog in the stage
+    /// does not make its scheduling group overrun the quota and stall
+    /// other groups.
+    void pin_batch_to_task_quota() noexcept;
 };
 
 /// \cond internal
@@ -194,6 +233,10 @@ public:
     static execution_stage_manager& get() noexcept;
 };
 
+// The reactor's task quota (--task-quota-ms) as a duration; out of line to
+// avoid including reactor.hh here.
+std::chrono::nanoseconds task_quota_duration() noexcept;
+
 }
 /// \endcond
 
@@ -240,6 +283,9 @@ private:
     }
 
     virtual void do_flush() noexcept override {
+        auto limited = batch_is_limited();
+        auto start = limited ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+        size_t executed = 0;
         while (!_queue.empty()) {
             auto& wi = _queue.front();
             auto wi_in = std::move(wi._in);
@@ -247,12 +293,20 @@ private:
             _queue.pop_front();
             futurize<ReturnType>::apply(_function, unwrap(std::move(wi_in))).forward_to(std::move(wi_ready));
             _stats.function_calls_executed++;
+            ++executed;
 
+            if (limited && executed >= _batch_limit) {
+                _stats.batch_limit_reached++;
+                break;
+            }
             if (need_preempt()) {
                 _stats.tasks_preempted++;
                 break;
             }
         }
+        if (limited && executed) {
+            account_batch(executed, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
         _empty = _queue.empty();
     }
 public:
@@ -330,6 +384,7 @@ class inheriting_concrete_execution_stage final : public inheriting_execution_st
 
     sstring _name;
     noncopyable_function<ReturnType (Args...)> _function;
+    std::chrono::nanoseconds _max_batch_duration = std::chrono::nanoseconds::zero();
     std::vector<std::optional<per_group_stage_type>> _stage_for_group{max_scheduling_groups()};
 private:
     per_group_stage_type make_stage_for_group(scheduling_group sg) {
@@ -339,7 +394,9 @@ private:
             return _function(std::forward<Args>(args)...);
         };
         auto name = fmt::format("{}.{}", _name, sg.name());
-        return per_group_stage_type(name, sg, wrapped_function);
+        auto stage = per_group_stage_type(name, sg, wrapped_function);
+        stage.set_max_batch_duration(_max_batch_duration);
+        return stage;
     }
 public:
     /// Construct an inheriting concrete execution stage.
@@ -389,6 +446,24 @@ public:
     ///     the scheduling group and the stats for the respective execution
     ///     stage. Scheduling groups that have had no respective calls enqueued
     ///     yet are omitted.
+    /// Caps the execution time of a single batch of each per-group stage.
+    /// \see execution_stage::set_max_batch_duration()
+    void set_max_batch_duration(std::chrono::nanoseconds duration) noexcept {
+        _max_batch_duration = duration;
+        for (auto& slot : _stage_for_group) {
+            if (slot) {
+                slot->set_max_batch_duration(duration);
+            }
+        }
+    }
+
+    /// Caps the execution time of a single batch of each per-group stage
+    /// to the reactor's task quota.
+    /// \see execution_stage::pin_batch_to_task_quota()
+    void pin_batch_to_task_quota() noexcept {
+        set_max_batch_duration(internal::task_quota_duration());
+    }
+
     inheriting_execution_stage::stats get_stats() const noexcept {
         inheriting_execution_stage::stats summary;
         for (unsigned sg_id = 0; sg_id != _stage_for_group.size(); ++sg_id) {
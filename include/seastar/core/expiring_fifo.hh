@@ -27,8 +27,10 @@
 #include <exception>
 #include <memory>
 #include <seastar/core/timer.hh>
+#include <seastar/core/timer-wheel.hh>
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/timed_out_error.hh>
+#include <boost/intrusive/list.hpp>
 
 namespace seastar {
 
@@ -59,23 +61,33 @@ public:
     using time_point = typename Clock::time_point;
 private:
     struct entry {
+        using clock = Clock;
+        using time_point = typename Clock::time_point;
+        using duration = typename Clock::duration;
+
         std::optional<T> payload; // disengaged means that it's expired
-        timer<Clock> tr;
+        time_point timeout = time_point::max(); // max() means that it never expires
+        // Links the entry into the wheel of its expiring_fifo. Entries
+        // are stable in memory (chunked_fifo never moves elements), so
+        // the hook stays valid for the entry's lifetime.
+        boost::intrusive::list_member_hook<> wheel_link;
+
         entry(T&& payload_) : payload(std::move(payload_)) {}
         entry(const T& payload_) : payload(payload_) {}
-        entry(T payload_, expiring_fifo& ef, time_point timeout)
+        entry(T payload_, time_point timeout_)
                 : payload(std::move(payload_))
-                , tr([this, &ef] {
-                    ef._on_expiry(*payload);
-                    payload = std::nullopt;
-                    --ef._size;
-                    ef.drop_expired_front();
-                })
-        {
-            tr.arm(timeout);
-        }
+                , timeout(timeout_)
+        {}
         entry(entry&& x) = delete;
         entry(const entry& x) = delete;
+
+        time_point get_timeout() const noexcept {
+            return timeout;
+        }
+        // Satisfies the timer_wheel interface; never called with a
+        // linked entry, because the fifo clears the wheel before any
+        // entry is destroyed.
+        void cancel() noexcept {}
     };
 
     // If engaged, represents the first element.
@@ -86,6 +98,12 @@ private:
 
     // There is an invariant that the front element is never expired.
     chunked_fifo<entry> _list;
+    // Expirable entries are hashed into the wheel, so arming is O(1) and
+    // everything overdue is collected in one expire() pass. One timer
+    // backs the whole container; it is only (re)armed when the earliest
+    // expiry moves forward, never on pop.
+    timer_wheel<entry, &entry::wheel_link> _wheel;
+    timer<Clock> _timer;
     OnExpiry _on_expiry;
     size_t _size = 0;
 
@@ -98,9 +116,36 @@ private:
             _front.reset();
         }
     }
+
+    // Removes the entry from the wheel if it still awaits expiry.
+    void unlink(entry& e) noexcept {
+        if (e.timeout != time_point::max() && e.payload) {
+            _wheel.remove(e);
+        }
+    }
+
+    // Expires every overdue entry in one pass. The wheel's idea of the
+    // earliest expiry is not updated on pop, so the timer may fire with
+    // nothing overdue; it is then simply re-armed.
+    void expire_now() noexcept {
+        auto expired = _wheel.expire(Clock::now());
+        while (!expired.empty()) {
+            entry& e = expired.front();
+            expired.pop_front();
+            _on_expiry(*e.payload);
+            e.payload = std::nullopt;
+            --_size;
+        }
+        drop_expired_front();
+        if (!_wheel.empty()) {
+            _timer.rearm(_wheel.get_next_timeout());
+        }
+    }
 public:
-    expiring_fifo() noexcept = default;
-    expiring_fifo(OnExpiry on_expiry) noexcept(std::is_nothrow_move_constructible_v<OnExpiry>) : _on_expiry(std::move(on_expiry)) {}
+    expiring_fifo() noexcept(std::is_nothrow_default_constructible_v<OnExpiry> && std::is_nothrow_move_constructible_v<OnExpiry>) : expiring_fifo(OnExpiry()) {}
+    expiring_fifo(OnExpiry on_expiry) noexcept(std::is_nothrow_move_constructible_v<OnExpiry>) : _on_expiry(std::move(on_expiry)) {
+        _timer.set_callback([this] { expire_now(); });
+    }
 
     expiring_fifo(expiring_fifo&& o) noexcept
             : expiring_fifo(std::move(o._on_expiry)) {
@@ -108,6 +153,12 @@ public:
         assert(o._size == 0);
     }
 
+    ~expiring_fifo() {
+        // Unlink whatever is still pending before the entries are
+        // destroyed together with _front/_list.
+        _wheel.clear();
+    }
+
     expiring_fifo& operator=(expiring_fifo&& o) noexcept {
         if (this != &o) {
             this->~expiring_fifo();
@@ -193,20 +244,33 @@ public:
             push_back(std::move(payload));
             return;
         }
+        entry* e;
         if (_size == 0) {
-            _front = std::make_unique<entry>(std::move(payload), *this, timeout);
+            _front = std::make_unique<entry>(std::move(payload), timeout);
+            e = _front.get();
         } else {
-            _list.emplace_back(std::move(payload), *this, timeout);
+            _list.emplace_back(std::move(payload), timeout);
+            e = &_list.back();
         }
         ++_size;
+        if (_wheel.insert(*e)) {
+            // The new entry expires before everything else; this is the
+            // only place the backing timer is armed.
+            _timer.rearm(timeout);
+        }
     }
 
     /// Removes the element at the front.
     /// Can be called only if !empty().
     void pop_front() noexcept {
+        // The timer is deliberately left alone: it may fire with nothing
+        // overdue and re-arm itself, which is cheaper than a timer
+        // update on every pop.
         if (_front) {
+            unlink(*_front);
             _front.reset();
         } else {
+            unlink(_list.front());
             _list.pop_front();
         }
         --_size;
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <boost/intrusive/slist.hpp>
+#include <seastar/core/internal/tsc_clock.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/circular_buffer.hh>
 #include <atomic>
@@ -65,6 +66,8 @@ public:
     /// Checks if the tickets fully equals to another one
     /// \param desc another \ref fair_queue_ticket to compare with
     bool operator==(const fair_queue_ticket& desc) const noexcept;
+    /// \returns a ticket with half of this one's quantities, rounded up
+    fair_queue_ticket halved() const noexcept;
 
     std::chrono::microseconds duration_at_pace(float weight_pace, float size_pace) const noexcept;
 
@@ -177,9 +180,13 @@ class fair_group {
     using fair_group_atomic_rover = std::atomic<fair_group_rover>;
     static_assert(fair_group_atomic_rover::is_always_lock_free);
 
+    using fair_group_atomic_ticket = std::atomic<fair_queue_ticket>;
+    static_assert(fair_group_atomic_ticket::is_always_lock_free);
+
     fair_group_atomic_rover _capacity_tail;
     fair_group_atomic_rover _capacity_head;
-    fair_queue_ticket _maximum_capacity;
+    fair_group_atomic_ticket _maximum_capacity;
+    std::atomic<unsigned> _nr_waiting = {};
 
 public:
     struct config {
@@ -196,10 +203,26 @@ public:
     };
     explicit fair_group(config cfg) noexcept;
 
-    fair_queue_ticket maximum_capacity() const noexcept { return _maximum_capacity; }
+    fair_queue_ticket maximum_capacity() const noexcept { return _maximum_capacity.load(std::memory_order_relaxed); }
+    // Replaces the maximum capacity at runtime, releasing (or withdrawing)
+    // the difference into (from) the shared rovers.
+    void update_capacity(fair_queue_ticket new_cap) noexcept;
     fair_group_rover grab_capacity(fair_queue_ticket cap) noexcept;
+    // Grabs the capacity only if it's all available right now, i.e. never
+    // leaves the tail rover ahead of the head one. Returns false otherwise.
+    bool try_grab_capacity(fair_queue_ticket cap) noexcept;
+    // Grabs the capacity on behalf of another group, but only if at least
+    // half of this group's capacity would remain free, so that local
+    // requests keep flowing while the loan is outstanding.
+    bool try_lend_capacity(fair_queue_ticket cap) noexcept;
     void release_capacity(fair_queue_ticket cap) noexcept;
 
+    // Attached queues announce their starvation for capacity, so that
+    // groups that borrowed some can tell when it's time to give it back.
+    void add_waiter() noexcept { _nr_waiting.fetch_add(1, std::memory_order_relaxed); }
+    void remove_waiter() noexcept { _nr_waiting.fetch_sub(1, std::memory_order_relaxed); }
+    unsigned waiting_queues() const noexcept { return _nr_waiting.load(std::memory_order_relaxed); }
+
     fair_group_rover head() const noexcept {
         return _capacity_head.load(std::memory_order_relaxed);
     }
@@ -290,12 +313,18 @@ private:
 
     bool grab_capacity(fair_queue_ticket cap) noexcept;
     bool grab_pending_capacity(fair_queue_ticket cap) noexcept;
+    void account_dispatched(priority_class_ptr h, fair_queue_ticket ticket);
 public:
     /// Constructs a fair queue with configuration parameters \c cfg.
     ///
     /// \param cfg an instance of the class \ref config
     explicit fair_queue(fair_group& shared, config cfg);
 
+    /// Replaces the configuration parameters at runtime, see \ref config
+    void update_config(config cfg) noexcept {
+        _config = std::move(cfg);
+    }
+
     /// Registers a priority class against this fair queue.
     ///
     /// \param shares how many shares to create this class with
@@ -326,11 +355,30 @@ public:
     /// request finishes executing - regardless of success or failure.
     void queue(priority_class_ptr pc, fair_queue_entry& ent);
 
+    /// Try to dispatch a request described by \c ticket without queueing it.
+    ///
+    /// Succeeds only when this queue has nothing queued or pending, so fairness has
+    /// nothing to arbitrate, and the group has all the needed capacity available right
+    /// now. On success the request is accounted as executing and charged to \c pc as
+    /// if it went through \ref dispatch_requests, and the caller submits it directly,
+    /// still calling \ref notify_requests_finished when it completes. Returns false
+    /// when the request must go through \ref queue instead.
+    bool try_direct_dispatch(priority_class_ptr pc, fair_queue_ticket ticket);
+
+    /// \return the capacity the queue is still missing to dispatch its head
+    /// request, or a zero ticket if nothing is pending
+    fair_queue_ticket pending_deficit() const noexcept;
+
     /// Notifies that ont request finished
     /// \param desc an instance of \c fair_queue_ticket structure describing the request that just finished.
     void notify_requests_finished(fair_queue_ticket desc, unsigned nr = 1) noexcept;
     void notify_request_cancelled(fair_queue_entry& ent) noexcept;
 
+    /// Accounts additional capacity into an entry that is still queued, when
+    /// another request is merged into the one the entry represents. The entry
+    /// must not have been dispatched yet.
+    void merge_queued_ticket(fair_queue_entry& ent, fair_queue_ticket t) noexcept;
+
     /// Try to execute new requests if there is capacity left in the queue.
     void dispatch_requests(std::function<void(fair_queue_entry&)> cb);
 
@@ -348,7 +396,7 @@ public:
              */
             fair_group_rover pending_head = _pending->orig_tail + _pending->cap;
             fair_queue_ticket over = pending_head.maybe_ahead_of(_group.head());
-            return std::chrono::steady_clock::now() + duration(over);
+            return internal::tsc_clock::now() + duration(over);
         }
 
         return std::chrono::steady_clock::time_point::max();
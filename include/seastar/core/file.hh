@@ -30,6 +30,7 @@
 #include <seastar/core/file-types.hh>
 #include <seastar/util/std-compat.hh>
 #include <system_error>
+#include <vector>
 #include <sys/statvfs.h>
 #include <sys/ioctl.h>
 #include <linux/fs.h>
@@ -77,6 +78,7 @@ struct file_open_options {
     uint64_t extent_allocation_size_hint = 1 << 20; ///< Allocate this much disk space when extending the file
     bool sloppy_size = false; ///< Allow the file size not to track the amount of data written until a flush
     uint64_t sloppy_size_hint = 1 << 20; ///< Hint as to what the eventual file size will be
+    uint64_t append_preallocation_size = 0; ///< If non-zero, preallocate disk space in chunks of this many bytes ahead of appending writes, returning the unused tail when the file is closed
     file_permissions create_permissions = file_permissions::default_file_permissions; ///< File permissions to use when creating a file
     bool append_is_unlikely = false; ///< Hint that user promises (or at least tries hard) not to write behind file size
 
@@ -430,6 +432,46 @@ public:
         });
     }
 
+    /// A single extent of a \ref dma_read_bulk_vectored() call: \c length
+    /// bytes starting \c offset bytes into the file.
+    struct extent {
+        uint64_t offset;
+        size_t length;
+    };
+
+    /**
+     * Read a scattered set of extents in one call.
+     *
+     * Extents whose \ref disk_read_dma_alignment-rounded ranges touch or
+     * overlap are serviced by a single disk operation each (index blocks
+     * sharing a disk block cost one read, not several), and the operations
+     * for distinct clusters are issued together, so the whole set passes
+     * the I/O scheduler in one go rather than paying a queue round trip
+     * per extent.
+     *
+     * @param extents the ranges to read; they may be unsorted and may
+     *        overlap, and neither offsets nor lengths need to be aligned
+     * @param pc the IO priority class under which to queue the operations
+     * @param intent the IO intention confirmation (\ref seastar::io_intent)
+     *
+     * @return one buffer per extent, in the order given; like with
+     *        \ref dma_read(), a buffer is shorter than its extent (possibly
+     *        empty) if the file ends inside it. The buffers of one cluster
+     *        share the underlying allocation.
+     */
+    template <typename CharType>
+    future<std::vector<temporary_buffer<CharType>>>
+    dma_read_bulk_vectored(std::vector<extent> extents, const io_priority_class& pc = default_priority_class(), io_intent* intent = nullptr) noexcept {
+        return dma_read_bulk_vectored_impl(std::move(extents), pc, intent).then([] (std::vector<temporary_buffer<uint8_t>> bufs) {
+            std::vector<temporary_buffer<CharType>> ret;
+            ret.reserve(bufs.size());
+            for (auto& t : bufs) {
+                ret.push_back(temporary_buffer<CharType>(reinterpret_cast<CharType*>(t.get_write()), t.size(), t.release()));
+            }
+            return ret;
+        });
+    }
+
     /// \brief Creates a handle that can be transported across shards.
     ///
     /// Creates a handle that can be transported across shards, and then
@@ -443,6 +485,9 @@ private:
     future<temporary_buffer<uint8_t>>
     dma_read_bulk_impl(uint64_t offset, size_t range_size, const io_priority_class& pc, io_intent* intent) noexcept;
 
+    future<std::vector<temporary_buffer<uint8_t>>>
+    dma_read_bulk_vectored_impl(std::vector<extent> extents, const io_priority_class& pc, io_intent* intent) noexcept;
+
     future<size_t>
     dma_write_impl(uint64_t pos, const uint8_t* buffer, size_t len, const io_priority_class& pc, io_intent* intent) noexcept;
 
@@ -0,0 +1,591 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2026 ScyllaDB Ltd.
+ */
+
+#pragma once
+
+#include <seastar/core/cacheline.hh>
+#include <seastar/core/prefetch.hh>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace seastar {
+
+/// \addtogroup util-module
+/// @{
+
+/// An ordered map backed by a B+-tree with wide, flat nodes.
+///
+/// Unlike \c std::map, which allocates one three-pointer node per element
+/// and takes a cache miss per comparison, \c flat_btree_map packs many
+/// elements into each node and sizes the nodes in whole cache lines, so a
+/// lookup touches O(log_B n) nodes instead of O(log_2 n). The keys of each
+/// node are stored contiguously, separate from the values, so the search
+/// only pulls key data into the cache; the next node on the search path is
+/// prefetched while the current one is being scanned. Leaves are chained,
+/// making in-order range scans a linear walk over dense arrays.
+///
+/// Insertion and removal shift elements within a node, so the container
+/// favours read-mostly workloads: shard-local indexes, routing tables,
+/// timer wheels. Removal unlinks nodes only once they become empty and
+/// does not rebalance, so a workload that erases most of a large
+/// population should \ref clear() and \ref bulk_load() instead of eroding
+/// the tree one key at a time.
+///
+/// The container is not a full drop-in replacement for \c std::map:
+/// iterators are invalidated by any insertion or removal, dereferencing an
+/// iterator yields a pair of references rather than a reference to a pair,
+/// and keys must be nothrow move constructible.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class flat_btree_map {
+    static_assert(std::is_nothrow_move_constructible_v<Key>,
+            "flat_btree_map moves keys while shifting and splitting nodes");
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+            "flat_btree_map moves values while shifting and splitting nodes");
+
+    // Nodes are sized to fill a fixed budget of cache lines; wider nodes
+    // mean a shallower tree but longer in-node scans, and eight lines is
+    // the point where the binary search stops being free relative to the
+    // memory access for typical key sizes.
+    static constexpr size_t node_byte_budget = 8 * cache_line_size;
+    static constexpr size_t slots_for(size_t element_size) {
+        constexpr size_t min_slots = 4;
+        constexpr size_t max_slots = 64;
+        return std::max(min_slots, std::min(max_slots, node_byte_budget / element_size));
+    }
+public:
+    static constexpr size_t leaf_capacity = slots_for(sizeof(Key) + sizeof(T));
+    static constexpr size_t inner_capacity = slots_for(sizeof(Key) + sizeof(void*));
+private:
+    struct node_base {
+        uint16_t count = 0;
+        const bool is_leaf;
+        explicit node_base(bool leaf) noexcept : is_leaf(leaf) {}
+    };
+
+    struct inner_node : node_base {
+        node_base* children[inner_capacity + 1];
+        union {
+            // storage only; elements [0, count) are alive, managed manually
+            Key keys[inner_capacity];
+        };
+        inner_node() noexcept : node_base(false) {}
+        ~inner_node() {
+            destroy_range(keys, this->count);
+        }
+    };
+
+    struct leaf_node : node_base {
+        leaf_node* next = nullptr;
+        leaf_node* prev = nullptr;
+        union {
+            Key keys[leaf_capacity];
+        };
+        union {
+            T values[leaf_capacity];
+        };
+        leaf_node() noexcept : node_base(true) {}
+        ~leaf_node() {
+            destroy_range(keys, this->count);
+            destroy_range(values, this->count);
+        }
+    };
+
+    node_base* _root = nullptr;
+    leaf_node* _first = nullptr;
+    leaf_node* _last = nullptr;
+    size_t _size = 0;
+    Compare _less;
+
+private:
+    template <typename U>
+    static void destroy_range(U* arr, uint16_t count) noexcept {
+        for (uint16_t i = 0; i < count; ++i) {
+            arr[i].~U();
+        }
+    }
+
+    // Opens a hole at arr[pos], moving [pos, count) one slot to the
+    // right; the slot past the end is raw storage.
+    template <typename U>
+    static void open_slot(U* arr, uint16_t pos, uint16_t count) noexcept {
+        for (uint16_t i = count; i > pos; --i) {
+            new (&arr[i]) U(std::move(arr[i - 1]));
+            arr[i - 1].~U();
+        }
+    }
+
+    // Closes the hole left by destroying arr[pos], moving (pos, count)
+    // one slot to the left.
+    template <typename U>
+    static void close_slot(U* arr, uint16_t pos, uint16_t count) noexcept {
+        for (uint16_t i = pos; i + 1 < count; ++i) {
+            new (&arr[i]) U(std::move(arr[i + 1]));
+            arr[i + 1].~U();
+        }
+    }
+
+    // Relocates src[src_pos, src_pos + n) into raw storage at dst[dst_pos].
+    template <typename U>
+    static void migrate(U* dst, uint16_t dst_pos, U* src, uint16_t src_pos, uint16_t n) noexcept {
+        for (uint16_t i = 0; i < n; ++i) {
+            new (&dst[dst_pos + i]) U(std::move(src[src_pos + i]));
+            src[src_pos + i].~U();
+        }
+    }
+
+    static void delete_node(node_base* n) noexcept {
+        if (n->is_leaf) {
+            delete static_cast<leaf_node*>(n);
+        } else {
+            auto in = static_cast<inner_node*>(n);
+            for (uint16_t i = 0; i <= in->count; ++i) {
+                delete_node(in->children[i]);
+            }
+            delete in;
+        }
+    }
+
+    uint16_t lower_bound_in(const Key* keys, uint16_t count, const Key& k) const {
+        return std::lower_bound(keys, keys + count, k, _less) - keys;
+    }
+
+    uint16_t upper_bound_in(const Key* keys, uint16_t count, const Key& k) const {
+        return std::upper_bound(keys, keys + count, k, _less) - keys;
+    }
+
+    // Walks from the root to the leaf whose key range covers k. The
+    // first line of the child is going to miss no matter what, but the
+    // node spans several cache lines, so issuing the prefetch for the
+    // whole of it before the binary search overlaps the remaining lines
+    // with the comparisons.
+    leaf_node* descend(const Key& k) const {
+        node_base* n = _root;
+        while (!n->is_leaf) {
+            auto in = static_cast<inner_node*>(n);
+            n = in->children[upper_bound_in(in->keys, in->count, k)];
+            prefetch<node_byte_budget / cache_line_size>(reinterpret_cast<void*>(n));
+        }
+        return static_cast<leaf_node*>(n);
+    }
+
+    // Splits the full child at parent->children[child_idx], inserting
+    // the separator key into the parent, which must have a free slot.
+    void split_child(inner_node* parent, uint16_t child_idx) {
+        node_base* child = parent->children[child_idx];
+        Key* separator_src;
+        node_base* right;
+        if (child->is_leaf) {
+            auto l = static_cast<leaf_node*>(child);
+            auto r = new leaf_node;
+            uint16_t half = l->count / 2;
+            migrate(r->keys, 0, l->keys, half, l->count - half);
+            migrate(r->values, 0, l->values, half, l->count - half);
+            r->count = l->count - half;
+            l->count = half;
+            r->next = l->next;
+            r->prev = l;
+            if (r->next) {
+                r->next->prev = r;
+            } else {
+                _last = r;
+            }
+            l->next = r;
+            separator_src = &r->keys[0];
+            right = r;
+        } else {
+            auto l = static_cast<inner_node*>(child);
+            auto r = new inner_node;
+            uint16_t mid = l->count / 2;
+            migrate(r->keys, 0, l->keys, mid + 1, l->count - mid - 1);
+            std::copy(l->children + mid + 1, l->children + l->count + 1, r->children);
+            r->count = l->count - mid - 1;
+            l->count = mid;
+            // the median key moves up rather than being copied
+            separator_src = &l->keys[mid];
+            right = r;
+        }
+        open_slot(parent->keys, child_idx, parent->count);
+        std::copy_backward(parent->children + child_idx + 1,
+                parent->children + parent->count + 1,
+                parent->children + parent->count + 2);
+        if (child->is_leaf) {
+            new (&parent->keys[child_idx]) Key(*separator_src);
+        } else {
+            new (&parent->keys[child_idx]) Key(std::move(*separator_src));
+            separator_src->~Key();
+        }
+        parent->children[child_idx + 1] = right;
+        ++parent->count;
+    }
+
+public:
+    /// A bidirectional-in-spirit, forward-only iterator over the leaf
+    /// chain. Dereferencing yields a pair of references, not a reference
+    /// to a pair, so there is no \c operator->; use \ref key() and
+    /// \ref mapped() to access the element's parts directly.
+    template <bool Const>
+    class basic_iterator {
+        using leaf_ptr = std::conditional_t<Const, const leaf_node*, leaf_node*>;
+        leaf_ptr _leaf = nullptr;
+        uint16_t _idx = 0;
+        basic_iterator(leaf_ptr leaf, uint16_t idx) noexcept : _leaf(leaf), _idx(idx) {}
+        friend class flat_btree_map;
+        template <bool>
+        friend class basic_iterator;
+    public:
+        using mapped_reference = std::conditional_t<Const, const T&, T&>;
+        using value_type = std::pair<const Key&, mapped_reference>;
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+
+        basic_iterator() = default;
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        basic_iterator(const basic_iterator<OtherConst>& o) noexcept
+                : _leaf(o._leaf), _idx(o._idx) {
+        }
+        const Key& key() const noexcept { return _leaf->keys[_idx]; }
+        mapped_reference mapped() const noexcept { return _leaf->values[_idx]; }
+        value_type operator*() const noexcept { return {key(), mapped()}; }
+        basic_iterator& operator++() noexcept {
+            if (++_idx == _leaf->count) {
+                _leaf = _leaf->next;
+                _idx = 0;
+                if (_leaf && _leaf->next) {
+                    // a scan that crossed one leaf boundary is likely to
+                    // cross the next one too
+                    prefetch(_leaf->next);
+                }
+            }
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+        bool operator==(const basic_iterator& o) const noexcept {
+            return _leaf == o._leaf && _idx == o._idx;
+        }
+        bool operator!=(const basic_iterator& o) const noexcept {
+            return !(*this == o);
+        }
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = size_t;
+
+public:
+    flat_btree_map() = default;
+    flat_btree_map(const flat_btree_map&) = delete;
+    flat_btree_map& operator=(const flat_btree_map&) = delete;
+    flat_btree_map(flat_btree_map&& o) noexcept
+            : _root(std::exchange(o._root, nullptr))
+            , _first(std::exchange(o._first, nullptr))
+            , _last(std::exchange(o._last, nullptr))
+            , _size(std::exchange(o._size, 0))
+            , _less(std::move(o._less)) {
+    }
+    flat_btree_map& operator=(flat_btree_map&& o) noexcept {
+        if (this != &o) {
+            clear();
+            _root = std::exchange(o._root, nullptr);
+            _first = std::exchange(o._first, nullptr);
+            _last = std::exchange(o._last, nullptr);
+            _size = std::exchange(o._size, 0);
+            _less = std::move(o._less);
+        }
+        return *this;
+    }
+    ~flat_btree_map() {
+        clear();
+    }
+
+    size_type size() const noexcept { return _size; }
+    bool empty() const noexcept { return _size == 0; }
+
+    iterator begin() noexcept { return iterator(_first, 0); }
+    iterator end() noexcept { return iterator(); }
+    const_iterator begin() const noexcept { return const_iterator(_first, 0); }
+    const_iterator end() const noexcept { return const_iterator(); }
+
+    /// Destroys all elements and releases all nodes.
+    void clear() noexcept {
+        if (_root) {
+            delete_node(_root);
+            _root = nullptr;
+            _first = nullptr;
+            _last = nullptr;
+            _size = 0;
+        }
+    }
+
+    /// Returns an iterator to the first element whose key is not less
+    /// than \c k, or \ref end().
+    iterator lower_bound(const Key& k) {
+        if (!_root) {
+            return end();
+        }
+        auto leaf = descend(k);
+        auto i = lower_bound_in(leaf->keys, leaf->count, k);
+        if (i == leaf->count) {
+            // k is greater than everything in this leaf; the next leaf's
+            // first key, if any, is the answer
+            return leaf->next ? iterator(leaf->next, 0) : end();
+        }
+        return iterator(leaf, i);
+    }
+    const_iterator lower_bound(const Key& k) const {
+        return const_cast<flat_btree_map*>(this)->lower_bound(k);
+    }
+
+    /// Returns an iterator to the element with key \c k, or \ref end().
+    iterator find(const Key& k) {
+        if (!_root) {
+            return end();
+        }
+        auto leaf = descend(k);
+        auto i = lower_bound_in(leaf->keys, leaf->count, k);
+        if (i == leaf->count || _less(k, leaf->keys[i])) {
+            return end();
+        }
+        return iterator(leaf, i);
+    }
+    const_iterator find(const Key& k) const {
+        return const_cast<flat_btree_map*>(this)->find(k);
+    }
+
+    /// Inserts an element, leaving the map unchanged if the key is
+    /// already present. Returns an iterator to the element with key
+    /// \c k and whether the insertion took place.
+    std::pair<iterator, bool> insert(Key k, T v) {
+        if (!_root) {
+            auto leaf = new leaf_node;
+            new (&leaf->keys[0]) Key(std::move(k));
+            new (&leaf->values[0]) T(std::move(v));
+            leaf->count = 1;
+            _root = _first = _last = leaf;
+            _size = 1;
+            return {iterator(leaf, 0), true};
+        }
+        // Full nodes are split on the way down, so that a parent always
+        // has a slot free by the time a child needs to push a separator
+        // into it, and no path back up has to be kept.
+        if ((_root->is_leaf && _root->count == leaf_capacity)
+                || (!_root->is_leaf && _root->count == inner_capacity)) {
+            auto new_root = new inner_node;
+            new_root->children[0] = _root;
+            _root = new_root;
+            split_child(new_root, 0);
+        }
+        node_base* n = _root;
+        while (!n->is_leaf) {
+            auto in = static_cast<inner_node*>(n);
+            auto i = upper_bound_in(in->keys, in->count, k);
+            node_base* child = in->children[i];
+            auto capacity = child->is_leaf ? leaf_capacity : inner_capacity;
+            if (child->count == capacity) {
+                split_child(in, i);
+                if (!_less(k, in->keys[i])) {
+                    child = in->children[i + 1];
+                } else {
+                    child = in->children[i];
+                }
+            }
+            prefetch<node_byte_budget / cache_line_size>(reinterpret_cast<void*>(child));
+            n = child;
+        }
+        auto leaf = static_cast<leaf_node*>(n);
+        auto i = lower_bound_in(leaf->keys, leaf->count, k);
+        if (i != leaf->count && !_less(k, leaf->keys[i])) {
+            return {iterator(leaf, i), false};
+        }
+        open_slot(leaf->keys, i, leaf->count);
+        open_slot(leaf->values, i, leaf->count);
+        new (&leaf->keys[i]) Key(std::move(k));
+        new (&leaf->values[i]) T(std::move(v));
+        ++leaf->count;
+        ++_size;
+        return {iterator(leaf, i), true};
+    }
+
+    /// Removes the element with key \c k, if present. Returns the number
+    /// of elements removed (zero or one).
+    ///
+    /// Nodes are freed only when they become empty and siblings are
+    /// never rebalanced, so a long sequence of erasures leaves a sparse
+    /// tree; rebuild with \ref clear() and \ref bulk_load() if that
+    /// matters.
+    size_type erase(const Key& k) {
+        if (!_root) {
+            return 0;
+        }
+        // remember the path so that emptied nodes can be unlinked
+        struct frame { inner_node* n; uint16_t child_idx; };
+        frame path[16];
+        unsigned depth = 0;
+        node_base* n = _root;
+        while (!n->is_leaf) {
+            auto in = static_cast<inner_node*>(n);
+            auto i = upper_bound_in(in->keys, in->count, k);
+            assert(depth < 16);
+            path[depth++] = {in, i};
+            n = in->children[i];
+            prefetch<node_byte_budget / cache_line_size>(reinterpret_cast<void*>(n));
+        }
+        auto leaf = static_cast<leaf_node*>(n);
+        auto i = lower_bound_in(leaf->keys, leaf->count, k);
+        if (i == leaf->count || _less(k, leaf->keys[i])) {
+            return 0;
+        }
+        leaf->keys[i].~Key();
+        leaf->values[i].~T();
+        close_slot(leaf->keys, i, leaf->count);
+        close_slot(leaf->values, i, leaf->count);
+        --leaf->count;
+        --_size;
+        if (leaf->count || !depth) {
+            if (!leaf->count) {
+                // the root leaf just became empty
+                delete leaf;
+                _root = nullptr;
+                _first = _last = nullptr;
+            }
+            return 1;
+        }
+        // unlink the empty leaf from its chain and from its parent
+        if (leaf->prev) {
+            leaf->prev->next = leaf->next;
+        } else {
+            _first = leaf->next;
+        }
+        if (leaf->next) {
+            leaf->next->prev = leaf->prev;
+        } else {
+            _last = leaf->prev;
+        }
+        delete leaf;
+        auto [parent, child_idx] = path[--depth];
+        auto key_idx = child_idx ? child_idx - 1 : uint16_t(0);
+        parent->keys[key_idx].~Key();
+        close_slot(parent->keys, key_idx, parent->count);
+        std::copy(parent->children + child_idx + 1,
+                parent->children + parent->count + 1,
+                parent->children + child_idx);
+        --parent->count;
+        // an inner node left with a single child and no keys is collapsed
+        // into its parent (or becomes the root's replacement)
+        while (!parent->count) {
+            auto only_child = parent->children[0];
+            if (!depth) {
+                _root = only_child;
+                delete parent;
+                break;
+            }
+            auto [grandparent, idx] = path[--depth];
+            grandparent->children[idx] = only_child;
+            delete parent;
+            parent = grandparent;
+        }
+        return 1;
+    }
+
+    /// Removes the element the iterator points at. Returns an iterator
+    /// to the following element. Invalidates all other iterators.
+    iterator erase(const_iterator it) {
+        // re-descend by key: erasing may reshape the tree around the leaf
+        Key k = it.key();
+        erase(k);
+        return lower_bound(k);
+    }
+
+    /// Builds the tree from a sorted range of unique key/value pairs,
+    /// packing leaves densely. This is much faster than repeated
+    /// \ref insert() and produces full nodes, giving the shallowest
+    /// possible tree. The map must be empty.
+    template <typename Iterator>
+    void bulk_load(Iterator b, Iterator e) {
+        assert(!_root);
+        if (b == e) {
+            return;
+        }
+        struct entry {
+            Key min_key;
+            node_base* n;
+        };
+        std::vector<entry> level;
+        leaf_node* prev = nullptr;
+        while (b != e) {
+            auto leaf = new leaf_node;
+            while (b != e && leaf->count < leaf_capacity) {
+                new (&leaf->keys[leaf->count]) Key(b->first);
+                new (&leaf->values[leaf->count]) T(b->second);
+                ++leaf->count;
+                ++b;
+                ++_size;
+            }
+            leaf->prev = prev;
+            if (prev) {
+                prev->next = leaf;
+            } else {
+                _first = leaf;
+            }
+            prev = leaf;
+            level.push_back(entry{leaf->keys[0], leaf});
+        }
+        _last = prev;
+        while (level.size() > 1) {
+            std::vector<entry> next_level;
+            size_t pos = 0;
+            while (pos < level.size()) {
+                size_t take = std::min(inner_capacity + 1, level.size() - pos);
+                if (level.size() - pos - take == 1) {
+                    // never leave a lone child for the last group
+                    --take;
+                }
+                auto in = new inner_node;
+                for (size_t j = 0; j < take; ++j) {
+                    in->children[j] = level[pos + j].n;
+                    if (j) {
+                        new (&in->keys[j - 1]) Key(std::move(level[pos + j].min_key));
+                    }
+                }
+                in->count = take - 1;
+                next_level.push_back(entry{std::move(level[pos].min_key), in});
+                pos += take;
+            }
+            level = std::move(next_level);
+        }
+        _root = level[0].n;
+    }
+};
+
+/// @}
+
+}
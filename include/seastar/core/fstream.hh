@@ -50,12 +50,31 @@ class file_input_stream_history {
     friend class file_data_source_impl;
 };
 
+/// Per-stream efficiency counters for a file input stream.
+///
+/// When \ref file_input_stream_options::per_stream_stats is set, the stream
+/// updates these counters as it runs. They describe how well the read-ahead
+/// window tracked the consumption pattern — a high blocked or discarded
+/// ratio means the window was too small or too large, respectively — and
+/// complement the reactor-wide `fstream_*` metrics, which aggregate over
+/// all streams on the shard.
+struct file_input_stream_stats {
+    uint64_t reads_issued = 0;       ///< Read requests issued to the file
+    uint64_t reads_blocked = 0;      ///< Times the consumer had to wait for a buffer
+    uint64_t reads_discarded = 0;    ///< Read-ahead buffers dropped by skips or close
+    uint64_t bytes_consumed = 0;     ///< Bytes handed to the consumer
+    uint64_t bytes_discarded = 0;    ///< Bytes read but never consumed
+    uint64_t read_ahead_grown = 0;   ///< Times the read-ahead window was enlarged
+    uint64_t read_ahead_shrunk = 0;  ///< Times the read-ahead window was reduced
+};
+
 /// Data structure describing options for opening a file input stream
 struct file_input_stream_options {
     size_t buffer_size = 8192;    ///< I/O buffer size
     unsigned read_ahead = 0;      ///< Maximum number of extra read-ahead operations
     ::seastar::io_priority_class io_priority_class = default_priority_class();
     lw_shared_ptr<file_input_stream_history> dynamic_adjustments = { }; ///< Input stream history, if null dynamic adjustments are disabled
+    lw_shared_ptr<file_input_stream_stats> per_stream_stats = { }; ///< Per-stream counters, if null they are not collected
 };
 
 /// \brief Creates an input_stream to read a portion of a file.
@@ -93,6 +112,14 @@ struct file_output_stream_options {
     unsigned buffer_size = 65536;
     unsigned preallocation_size = 0; ///< Preallocate extents. For large files, set to a large number (a few megabytes) to reduce fragmentation
     unsigned write_behind = 1; ///< Number of buffers to write in parallel
+    // With a fixed depth, a value that keeps one device busy idles a
+    // faster one and starves latency-sensitive I/O on a slower one. When
+    // set, the stream starts with a single write in flight and adjusts
+    // the depth between 1 and write_behind from its own completion
+    // latency and demand, so write_behind only needs to be a generous
+    // upper bound.
+    bool adaptive_write_behind = false; ///< Auto-tune the write-behind depth up to \c write_behind from device feedback
+    bool vectored_writes = false; ///< Collect whole-buffer writes into batches instead of copying each into the stream buffer
     ::seastar::io_priority_class io_priority_class = default_priority_class();
 };
 
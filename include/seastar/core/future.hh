@@ -22,6 +22,7 @@
 #pragma once
 
 #include <seastar/core/task.hh>
+#include <seastar/core/preempt.hh>
 #include <seastar/core/thread_impl.hh>
 #include <stdexcept>
 #include <atomic>
@@ -35,6 +36,7 @@
 #include <seastar/util/concepts.hh>
 #include <seastar/util/noncopyable_function.hh>
 #include <seastar/util/backtrace.hh>
+#include <seastar/util/expected.hh>
 
 #if __cplusplus > 201703L
 #include <concepts>
@@ -1133,6 +1135,13 @@ auto futurize_apply(Func&& func, std::tuple<Args...>&& args) noexcept;
 /// \addtogroup future-module
 /// @{
 namespace internal {
+
+// Counts ready continuations that were pushed through the run queue instead
+// of running inline because the task quota was already exhausted
+// (\ref need_preempt() returned true). Exposed as a reactor metric so that
+// workloads whose ready-future chains keep getting broken up can be spotted.
+extern thread_local uint64_t ready_continuations_deferred;
+
 class future_base {
 protected:
     promise_base* _promise;
@@ -1379,15 +1388,16 @@ private:
         // noexcept, it will call std::terminate if new throws.
         memory::scoped_critical_alloc_section _;
         auto tws = new continuation<Pr, Func, Wrapper, T SEASTAR_ELLIPSIS>(std::move(pr), std::move(func), std::move(wrapper));
-        // In a debug build we schedule ready futures, but not in
-        // other build modes.
-#ifdef SEASTAR_DEBUG
+        // We can be called with an available state when the inline fast
+        // path declined to run the continuation (always, in a debug
+        // build; when the task quota ran out, in other build modes). In
+        // that case there is no promise to link to, so go through the
+        // run queue directly.
         if (_state.available()) {
             tws->set_state(std::move(_state));
             ::seastar::schedule(tws);
             return;
         }
-#endif
         schedule(tws);
         _state._u.st = future_state_base::state::invalid;
     }
@@ -1595,11 +1605,17 @@ private:
         if (failed()) {
             return futurator::make_exception_future(static_cast<future_state_base&&>(get_available_state_ref()));
         } else if (available()) {
+            // Run the continuation inline, but only while the task quota
+            // lasts; an unbounded chain of ready futures would otherwise
+            // starve the rest of the run queue.
+            if (!need_preempt()) {
 #if SEASTAR_API_LEVEL < 5
-            return futurator::apply(std::forward<Func>(func), get_available_state_ref().take_value());
+                return futurator::apply(std::forward<Func>(func), get_available_state_ref().take_value());
 #else
-            return futurator::invoke(std::forward<Func>(func), get_available_state_ref().take_value());
+                return futurator::invoke(std::forward<Func>(func), get_available_state_ref().take_value());
 #endif
+            }
+            ++internal::ready_continuations_deferred;
         }
 #endif
         return then_impl_nrvo<Func, Result>(std::forward<Func>(func));
@@ -1678,14 +1694,17 @@ private:
 #ifndef SEASTAR_DEBUG
         using futurator = futurize<FuncResult>;
         if (available()) {
-            if constexpr (AsSelf) {
-                if (_promise) {
-                    detach_promise();
+            if (!need_preempt()) {
+                if constexpr (AsSelf) {
+                    if (_promise) {
+                        detach_promise();
+                    }
+                    return futurator::invoke(std::forward<Func>(func), std::move(*this));
+                } else {
+                    return futurator::invoke(std::forward<Func>(func), future(get_available_state_ref()));
                 }
-                return futurator::invoke(std::forward<Func>(func), std::move(*this));
-            } else {
-                return futurator::invoke(std::forward<Func>(func), future(get_available_state_ref()));
             }
+            ++internal::ready_continuations_deferred;
         }
 #endif
         return then_wrapped_nrvo<FuncResult, Func>(std::forward<Func>(func));
@@ -2180,6 +2199,82 @@ auto futurize_apply(Func&& func, std::tuple<Args...>&& args) noexcept {
 
 namespace internal {
 
+template <typename T>
+struct is_expected : std::false_type {};
+
+template <typename T, typename E>
+struct is_expected<expected<T, E>> : std::true_type {};
+
+template <typename T>
+struct future_single_value;
+
+template <typename T>
+struct future_single_value<future<T>> {
+    using type = T;
+};
+
+}
+
+/// \brief Chains a continuation on a future carrying an \ref expected.
+///
+/// Invokes \c func with the value once the expected resolves successfully;
+/// if it carries an error instead, \c func is skipped and the error is
+/// forwarded to the returned future unchanged, without involving the
+/// exception-handling runtime. An exceptional input future is likewise
+/// forwarded, so unanticipated failures still propagate as exceptions.
+/// \c func must return an \ref expected with the same error type, or a
+/// future thereof.
+///
+/// \param f future carrying an \ref expected
+/// \param func continuation to invoke with a successful value
+/// \return the (possibly error-carrying) result of \c func
+template <typename T, typename E, typename Func>
+auto expected_then(future<expected<T, E>> f, Func func) noexcept {
+    return f.then([func = std::move(func)] (expected<T, E>&& v) mutable {
+        auto invoke = [&] {
+            if constexpr (std::is_void_v<T>) {
+                return futurize_invoke(func);
+            } else {
+                return futurize_invoke(func, std::move(v).value());
+            }
+        };
+        using ret = decltype(invoke());
+        using expected_ret = typename internal::future_single_value<ret>::type;
+        static_assert(internal::is_expected<expected_ret>::value,
+                "expected_then() continuations must return an expected<> or a future<expected<>>");
+        static_assert(std::is_same_v<typename expected_ret::error_type, E>,
+                "expected_then() continuations must preserve the error type");
+        if (!v) {
+            return make_ready_future<expected_ret>(unexpected<E>{std::move(v).error()});
+        }
+        return invoke();
+    });
+}
+
+/// \brief Converts a resolved \ref expected into a future.
+///
+/// Returns a ready future holding the value, or a failed future holding the
+/// error as an exception. This is the boundary between exception-free error
+/// propagation and code expecting exceptional futures: the cost of creating
+/// an exception is paid only here, and only on the error path.
+template <typename T, typename E>
+future<T> to_future(expected<T, E> v) noexcept {
+    if (v) {
+        return make_ready_future<T>(std::move(v).value());
+    }
+    return make_exception_future<T>(std::move(v).error());
+}
+
+template <typename E>
+future<> to_future(expected<void, E> v) noexcept {
+    if (v) {
+        return make_ready_future<>();
+    }
+    return make_exception_future<>(std::move(v).error());
+}
+
+namespace internal {
+
 template <typename... T, typename U>
 inline
 void set_callback(future<T...>& fut, U* callback) noexcept {
@@ -24,6 +24,7 @@
 #include <seastar/core/future.hh>
 #include <seastar/util/std-compat.hh>
 #include <exception>
+#include <utility>
 
 namespace seastar {
 
@@ -106,6 +107,74 @@ public:
         return _stopped->get_future();
     }
 
+    /// Facility to hold a gate opened using RAII.
+    ///
+    /// A \ref holder is obtained from \ref gate::hold() or by copying
+    /// an existing holder: the gate is entered on construction and left
+    /// on destruction. Copying a holder extends an entry the gate has
+    /// already admitted, so unlike \ref enter() it never throws and does
+    /// not check whether the gate was closed — a nested scope can simply
+    /// take a copy instead of re-entering through the checked path or
+    /// wrapping the gate in a gate of its own.
+    ///
+    /// The gate must not be moved while any holders reference it.
+    class holder {
+        gate* _g;
+    public:
+        /// Constructs a holder that holds nothing.
+        holder() noexcept : _g(nullptr) { }
+        /// Enters the given gate; throws \ref gate_closed_exception if it
+        /// was already closed. Prefer \ref gate::hold().
+        explicit holder(gate& g) : _g(&g) {
+            _g->enter();
+        }
+        /// Extends the entry held by \c x, without a closed-gate check.
+        holder(const holder& x) noexcept : _g(x._g) {
+            if (_g) {
+                ++_g->_count;
+            }
+        }
+        /// Takes over the entry held by \c x, which is left holding nothing.
+        holder(holder&& x) noexcept : _g(std::exchange(x._g, nullptr)) { }
+        ~holder() {
+            release();
+        }
+        holder& operator=(const holder& x) noexcept {
+            if (this != &x) {
+                release();
+                _g = x._g;
+                if (_g) {
+                    ++_g->_count;
+                }
+            }
+            return *this;
+        }
+        holder& operator=(holder&& x) noexcept {
+            if (this != &x) {
+                release();
+                _g = std::exchange(x._g, nullptr);
+            }
+            return *this;
+        }
+        /// Leaves the gate now, rather than at destruction time.
+        void release() noexcept {
+            if (_g) {
+                _g->leave();
+                _g = nullptr;
+            }
+        }
+        /// Returns true if an entry is held.
+        explicit operator bool() const noexcept {
+            return _g != nullptr;
+        }
+    };
+
+    /// Enters the gate and returns a \ref holder that leaves it when
+    /// destroyed. Throws \ref gate_closed_exception if the gate is closed.
+    holder hold() {
+        return holder(*this);
+    }
+
     /// Returns a current number of registered in-progress requests.
     size_t get_count() const noexcept {
         return _count;
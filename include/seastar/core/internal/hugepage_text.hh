@@ -0,0 +1,40 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace seastar {
+namespace internal {
+
+// Remaps the hugepage-aligned portions of the executable's text segments
+// onto transparent hugepages, reducing iTLB pressure for large binaries.
+// The text is replaced in place, so this must run before any other thread
+// is started. Returns the number of bytes remapped; 0 means the kernel
+// cannot do it (or the text is too small to contain an aligned hugepage).
+size_t remap_text_to_hugepages() noexcept;
+
+// How many bytes of text remap_text_to_hugepages() put on hugepages.
+size_t remapped_text_bytes() noexcept;
+
+}
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace seastar {
+namespace internal {
+
+/// Per-thread hardware performance counters (cycles, instructions,
+/// last-level-cache misses), read from userspace with rdpmc so a sample
+/// costs only a few cycles and can be taken at every task-queue switch.
+///
+/// The counters count user-mode events of the owning thread only. On
+/// platforms without userspace counter access (non-x86, perf events
+/// disabled, or a kernel that denies rdpmc) enable() fails and read()
+/// returns zeroed samples.
+class hw_perf_counters {
+public:
+    struct sample {
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        uint64_t llc_misses = 0;
+        sample& operator+=(const sample& o) noexcept {
+            cycles += o.cycles;
+            instructions += o.instructions;
+            llc_misses += o.llc_misses;
+            return *this;
+        }
+        sample operator-(const sample& o) const noexcept {
+            return {cycles - o.cycles, instructions - o.instructions, llc_misses - o.llc_misses};
+        }
+    };
+private:
+    struct counter {
+        int fd = -1;
+        void* page = nullptr; // perf_event_mmap_page of the event
+        bool open(uint64_t config) noexcept;
+        uint64_t read() const noexcept;
+        void close() noexcept;
+    };
+    counter _cycles;
+    counter _instructions;
+    counter _llc_misses;
+    bool _enabled = false;
+public:
+    hw_perf_counters() = default;
+    hw_perf_counters(const hw_perf_counters&) = delete;
+    ~hw_perf_counters();
+
+    /// Opens the counters for the calling thread. Returns false, leaving
+    /// the object disabled, if perf events or userspace rdpmc are
+    /// unavailable.
+    bool enable() noexcept;
+    bool enabled() const noexcept { return _enabled; }
+
+    /// Takes a snapshot of the counters; returns a zeroed sample when
+    /// disabled. Attribute an execution interval to its owner by
+    /// subtracting the snapshot taken at its start from the one taken at
+    /// its end.
+    sample read() const noexcept;
+};
+
+}
+}
@@ -64,6 +64,7 @@ public:
     void speculate_epoll(int events) { events_known |= events; }
     file_desc fd;
     bool events_rw = false;   // single consumer for both read and write (accept())
+    bool exclusive_wakeups = false; // listener possibly shared between reactors: wake only one (EPOLLEXCLUSIVE)
     bool no_more_recv = false; // For udp, there is no shutdown indication from the kernel
     bool no_more_send = false; // For udp, there is no shutdown indication from the kernel
     int events_requested = 0; // wanted by pollin/pollout promises
@@ -90,6 +91,8 @@ public:
     future<> connect(socket_address& sa);
     future<size_t> sendmsg(struct msghdr *msg);
     future<size_t> recvmsg(struct msghdr *msg);
+    future<unsigned> sendmmsg(struct mmsghdr* msgs, unsigned n);
+    future<unsigned> recvmmsg(struct mmsghdr* msgs, unsigned n);
     future<size_t> sendto(socket_address addr, const void* buf, size_t len);
 
 protected:
@@ -145,6 +148,12 @@ public:
     future<> readable_or_writeable() {
         return _s->readable_or_writeable();
     }
+    // Marks the underlying fd as a listener that may be polled by several
+    // reactors at once, so backends that support it wake only one of them
+    // per incoming connection (e.g. via EPOLLEXCLUSIVE).
+    void set_exclusive_wakeups() {
+        _s->exclusive_wakeups = true;
+    }
     void abort_reader() {
         return _s->abort_reader();
     }
@@ -163,10 +172,21 @@ public:
     future<size_t> recvmsg(struct msghdr *msg) {
         return _s->recvmsg(msg);
     }
+    future<unsigned> sendmmsg(struct mmsghdr* msgs, unsigned n) {
+        return _s->sendmmsg(msgs, n);
+    }
+    future<unsigned> recvmmsg(struct mmsghdr* msgs, unsigned n) {
+        return _s->recvmmsg(msgs, n);
+    }
     future<size_t> sendto(socket_address addr, const void* buf, size_t len) {
         return _s->sendto(addr, buf, len);
     }
     file_desc& get_file_desc() const { return _s->fd; }
+    // Deregisters the fd from the reactor backend and surrenders it, for
+    // handing the descriptor to another shard. Must only be called with
+    // no outstanding operations; the emptied pollable_fd can only be
+    // discarded afterwards.
+    file_desc detach();
     void shutdown(int how);
     void close() { _s.reset(); }
     explicit operator bool() const noexcept {
@@ -30,7 +30,7 @@ struct file_read_state {
 
     file_read_state(uint64_t offset, uint64_t front, size_t to_read,
             size_t memory_alignment, size_t disk_alignment, io_intent* intent)
-    : buf(tmp_buf_type::aligned(memory_alignment,
+    : buf(tmp_buf_type::aligned_pooled(memory_alignment,
                                 align_up(to_read, disk_alignment)))
     , _offset(offset)
     , _to_read(to_read)
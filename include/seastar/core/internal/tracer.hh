@@ -0,0 +1,165 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#pragma once
+
+#include <seastar/core/task.hh>
+#include <seastar/core/sstring.hh>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <typeinfo>
+#include <vector>
+
+namespace seastar {
+namespace internal {
+
+/// \cond internal
+
+// A sampling tracer for reactor tasks and io requests.
+//
+// One task schedule out of every sampling period is marked when it
+// enters a task queue; when the reactor later runs a marked task the
+// tracer records a span holding the queue time, the run time and the
+// concrete task type. While tracing is on, every io request records a
+// span as well -- disk requests are orders of magnitude rarer than
+// tasks, so they are not sampled down. Spans accumulate in a fixed
+// per-shard ring that overwrites the oldest entries, and
+// dump_chrome_trace() renders the ring in the chrome://tracing JSON
+// format, which flamegraph tooling and perfetto consume directly.
+//
+// When tracing is off the only cost on the task path is a
+// predicted-false branch at schedule and at run; with tracing on,
+// unsampled tasks additionally pay a counter decrement and one table
+// probe. Sampling happens per scheduled task, so a request that hops
+// through many continuations shows up as independent spans rather than
+// one connected trace; connecting them would require a context word in
+// every task, which the unsampled fast path cannot afford.
+class tracer {
+public:
+    using clock = std::chrono::steady_clock;
+    struct span {
+        const std::type_info* type = nullptr; // null for io spans
+        clock::time_point queued;
+        clock::time_point started;
+        clock::time_point ended;
+        uint8_t group = 0; // scheduling group for tasks, io priority class for io
+        bool io = false;
+    };
+private:
+    bool _enabled = false;
+    uint32_t _period = 0;
+    uint32_t _countdown = 0;
+    // Sampled tasks waiting to run, keyed by task pointer. A collision
+    // overwrites the older mark; losing a sample now and then is
+    // harmless and keeps the probe to a single compare.
+    struct pending {
+        const task* t = nullptr;
+        clock::time_point queued;
+    };
+    static constexpr size_t nr_pending = 256;
+    std::array<pending, nr_pending> _pending;
+    std::vector<span> _ring;
+    size_t _next = 0;
+private:
+    static size_t slot_of(const task* t) noexcept {
+        // tasks are cache-line aligned, so drop the dead low bits and
+        // fold some higher ones in
+        auto p = reinterpret_cast<uintptr_t>(t) / cache_line_size;
+        return (p ^ (p >> 8)) % nr_pending;
+    }
+    void record(const span& s) noexcept {
+        _ring[_next] = s;
+        _next = (_next + 1) % _ring.size();
+    }
+public:
+    bool enabled() const noexcept {
+        return _enabled;
+    }
+
+    // Called by the reactor when a task is scheduled, only while enabled.
+    void on_schedule(const task* t) noexcept {
+        if (__builtin_expect(_countdown-- != 0, true)) {
+            return;
+        }
+        _countdown = _period - 1;
+        auto& p = _pending[slot_of(t)];
+        p.t = t;
+        p.queued = clock::now();
+    }
+
+    // Called by run_tasks() in place of t->run_and_dispose(), only
+    // while enabled.
+    void run_task(task* t, uint8_t group) {
+        auto& p = _pending[slot_of(t)];
+        if (__builtin_expect(p.t != t, true)) {
+            t->run_and_dispose();
+            return;
+        }
+        p.t = nullptr;
+        span s;
+        s.type = &typeid(*t); // before run_and_dispose() frees the task
+        s.queued = p.queued;
+        s.group = group;
+        s.started = clock::now();
+        t->run_and_dispose();
+        s.ended = clock::now();
+        record(s);
+    }
+
+    // Called by the io queue when a traced io request completes.
+    void record_io(clock::time_point queued, clock::time_point dispatched, uint8_t pclass) noexcept {
+        span s;
+        s.queued = queued;
+        s.started = dispatched;
+        s.ended = clock::now();
+        s.group = pclass;
+        s.io = true;
+        record(s);
+    }
+
+    void enable(unsigned period, size_t ring_spans);
+    void disable() noexcept;
+    sstring dump_chrome_trace() const;
+};
+
+/// \endcond
+
+/// \brief start sampled task and io tracing on the local shard
+///
+/// One scheduled task in every \c sample_one_in is traced; io requests
+/// are always traced while tracing is on. The trace is kept in a ring
+/// of \c ring_spans spans, overwriting the oldest.
+void enable_task_tracing(unsigned sample_one_in = 997, size_t ring_spans = 131072);
+
+/// \brief stop tracing on the local shard, keeping the collected spans
+void disable_task_tracing() noexcept;
+
+/// \brief render the local shard's trace ring as chrome://tracing JSON
+///
+/// Each span becomes a complete ("X") event with the shard as the
+/// thread id; task spans carry the demangled task type as the event
+/// name and the queue delay and scheduling group as arguments, io spans
+/// carry the time spent waiting in the queue and on the disk.
+sstring dump_task_trace();
+
+}
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace seastar {
+namespace internal {
+
+/// \brief cheap timestamps from the TSC, on the CLOCK_MONOTONIC timeline
+///
+/// On hosts without a working clock_gettime() vDSO every precise
+/// timestamp is a real syscall, and the reactor takes a lot of them.
+/// This clock reads the invariant TSC instead and converts it using a
+/// calibration against \c std::chrono::steady_clock that is refreshed
+/// periodically from the lowres clock timer. The result is on the same
+/// timeline and of the same type as \c std::chrono::steady_clock
+/// time points, so it mixes freely with them; it trades a bounded
+/// conversion error (see \ref calibration_drift_ns()) for not entering
+/// the kernel.
+///
+/// When the TSC is not invariant, or no calibration has been
+/// established yet, now() falls back to the real clock.
+class tsc_clock final {
+public:
+    using base_clock = std::chrono::steady_clock;
+    using rep = base_clock::rep;
+    using period = base_clock::period;
+    using duration = base_clock::duration;
+    using time_point = base_clock::time_point;
+
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept;
+
+    /// whether now() is actually served from the TSC
+    static bool available() noexcept;
+
+    /// \brief refresh the calibration if it is stale
+    ///
+    /// Called from the lowres clock timer on the thread that owns it;
+    /// there must be only a single calibrating thread.
+    static void maybe_recalibrate() noexcept;
+
+    /// cumulative absolute error, in nanoseconds, observed between the
+    /// TSC-converted time and the real clock at recalibration points
+    static uint64_t calibration_drift_ns() noexcept;
+};
+
+}
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2022 ScyllaDB
+ */
+
+#pragma once
+
+#include <seastar/core/sstring.hh>
+#include <string_view>
+#include <unordered_set>
+
+namespace seastar {
+
+/// An interned, immutable string.
+///
+/// Interning maps equal string contents to a single canonical per-shard
+/// copy, so two \c interned_string objects are equal exactly when they
+/// refer to the same copy: equality and hashing are pointer operations,
+/// independent of the string length. This suits small, recurring sets of
+/// names that are used as map keys and compared over and over again --
+/// metric names and labels, header keys and the like.
+///
+/// The canonical copies are never evicted, so only strings of bounded
+/// cardinality should be interned. The table is per shard: an
+/// \c interned_string must not be moved to, or compared on, another
+/// shard.
+class interned_string {
+    const sstring* _str;
+private:
+    static const sstring* intern(std::string_view s) {
+        // Pointers into an unordered_set are stable, and thread_local
+        // in an inline function shares one table per shard across all
+        // translation units.
+        static thread_local std::unordered_set<sstring> strings;
+        return &*strings.emplace(s).first;
+    }
+public:
+    /// Interns the empty string.
+    interned_string() : interned_string(std::string_view()) {}
+    /// Interns \c s, reusing the canonical copy if the same content was
+    /// interned on this shard before.
+    interned_string(std::string_view s) : _str(intern(s)) {}
+    interned_string(const sstring& s) : interned_string(std::string_view(s)) {}
+    interned_string(const char* s) : interned_string(std::string_view(s)) {}
+    /// The canonical copy of the interned content.
+    const sstring& str() const noexcept { return *_str; }
+    operator const sstring&() const noexcept { return *_str; }
+    operator std::string_view() const noexcept { return std::string_view(*_str); }
+    bool operator==(const interned_string& x) const noexcept { return _str == x._str; }
+    bool operator!=(const interned_string& x) const noexcept { return _str != x._str; }
+    /// Content order, so interned keys sort the same way the plain
+    /// strings would.
+    bool operator<(const interned_string& x) const noexcept { return _str != x._str && *_str < *x._str; }
+    size_t hash() const noexcept { return std::hash<const sstring*>()(_str); }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const interned_string& s) {
+    return os << s.str();
+}
+
+}
+
+namespace std {
+
+template <>
+struct hash<seastar::interned_string> {
+    size_t operator()(const seastar::interned_string& s) const noexcept {
+        return s.hash();
+    }
+};
+
+}
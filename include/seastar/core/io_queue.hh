@@ -26,6 +26,8 @@
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/internal/io_request.hh>
+#include <seastar/core/internal/tsc_clock.hh>
+#include <memory>
 #include <mutex>
 #include <array>
 
@@ -62,6 +64,7 @@ using shard_id = unsigned;
 
 class io_priority_class;
 class io_queue;
+class io_completion;
 class io_desc_read_write;
 class queued_io_request;
 
@@ -74,10 +77,34 @@ public:
     };
     explicit io_group(config cfg) noexcept;
 
+    // Links this group with another one serving the same device, so the
+    // two may lend each other capacity. Must be called on both groups.
+    void add_sibling(std::shared_ptr<io_group> sibling);
+
+    // Applies a new configuration at runtime, resizing the group capacity
+    // without disturbing the requests in flight. May be called from any shard.
+    void update_config(config cfg) noexcept;
+
 private:
     friend class io_queue;
     fair_group _fg;
-    const unsigned _maximum_request_size;
+    std::atomic<unsigned> _maximum_request_size;
+
+    // An outstanding capacity loan from a sibling group. The borrowed
+    // amount is given back in halves once the lender's queues start
+    // starving (or the lender may never see it back if they don't).
+    struct loan {
+        std::weak_ptr<io_group> lender;
+        std::atomic<fair_queue_ticket> amount;
+        explicit loan(std::weak_ptr<io_group> g) noexcept : lender(std::move(g)), amount(fair_queue_ticket()) {}
+    };
+
+    std::mutex _siblings_lock;
+    std::vector<std::unique_ptr<loan>> _siblings;
+    std::atomic<unsigned> _nr_siblings = {};
+
+    void borrow_capacity(fair_queue_ticket deficit) noexcept;
+    void repay_loans() noexcept;
 
     static fair_group::config make_fair_group_config(config cfg) noexcept;
 };
@@ -91,6 +118,20 @@ private:
     io_group_ptr _group;
     fair_queue _fq;
     internal::io_sink& _sink;
+    // The most recently queued request that further contiguous requests
+    // may be merged into; cleared once it dispatches or cancels.
+    queued_io_request* _merge_candidate = nullptr;
+
+    // Completion-latency tracking per member device backing this queue
+    // (see config::nr_member_devices); empty when there is only one.
+    struct member_device_data {
+        std::chrono::duration<double> latency_ema = std::chrono::duration<double>(0);
+        uint64_t dispatched = 0;
+        unsigned requests_executing = 0;
+    };
+    std::vector<member_device_data> _members;
+
+    float member_cost_factor(unsigned member) const noexcept;
 
     static constexpr unsigned _max_classes = 2048;
     static std::mutex _register_lock;
@@ -131,8 +172,33 @@ public:
         float disk_us_per_request = 0;
         float disk_us_per_byte = 0;
         sstring mountpoint = "undefined";
+        // Submit a request directly to the sink, skipping the fair queue,
+        // when nothing is queued and the disk has spare capacity for it.
+        bool uncontended_bypass = false;
+        // Periodically re-estimate the disk speed from the observed
+        // completion rates and adjust the ticket costs accordingly, to
+        // follow disks whose performance changes at runtime.
+        bool online_calibration = false;
+        // Merge physically contiguous requests to the same file into one
+        // larger operation before submission, splitting the completion
+        // back afterwards -- what the kernel elevator used to do before
+        // O_DIRECT and our own scheduler took it out of the picture.
+        bool merge_adjacent_requests = false;
+        // Number of physical devices backing this queue (e.g. members of
+        // a RAID-0 array behind a single filesystem) and the size of the
+        // chunks the array interleaves over them. When more than one,
+        // requests are attributed to member devices by offset and the
+        // ticket cost of a request follows the observed completion
+        // latency of its member, so a slow member only makes its own
+        // requests expensive instead of stalling the whole queue.
+        unsigned nr_member_devices = 1;
+        uint64_t member_stripe_size = 128 << 10;
     };
 
+    // A merged operation may not grow beyond the per-request limits (see
+    // get_request_limits()), nor combine more buffers than this.
+    static constexpr unsigned max_merged_parts = 32;
+
     io_queue(io_group_ptr group, internal::io_sink& sink, config cfg);
     ~io_queue();
 
@@ -141,8 +207,12 @@ public:
     future<size_t>
     queue_request(const io_priority_class& pc, size_t len, internal::io_request req, io_intent* intent) noexcept;
     void submit_request(io_desc_read_write* desc, internal::io_request req, priority_class_data& pclass) noexcept;
+    void submit_merged_request(io_completion* desc, internal::io_request req, priority_class_data& pclass, unsigned nr_parts) noexcept;
     void cancel_request(queued_io_request& req, priority_class_data& pclass) noexcept;
     void complete_cancelled_request(queued_io_request& req) noexcept;
+    // Invalidates the merge window if it points at \c req; called when the
+    // request leaves the queue, for whatever reason.
+    void forget_merge_candidate(queued_io_request& req) noexcept;
 
     [[deprecated("modern I/O queues should use a property file")]] size_t capacity() const {
         return _config.capacity;
@@ -161,6 +231,19 @@ public:
 
     void notify_requests_finished(fair_queue_ticket& desc) noexcept;
 
+    unsigned nr_member_devices() const noexcept {
+        return _config.nr_member_devices;
+    }
+
+    // The member device a request starting at \c pos is routed to by the
+    // array interleaving; always 0 when member devices are not configured.
+    unsigned member_of(uint64_t pos) const noexcept;
+    void account_member_dispatched(unsigned member) noexcept;
+    void account_member_completion(unsigned member, std::chrono::duration<double> lat) noexcept;
+    std::chrono::duration<double> member_latency(unsigned member) const noexcept {
+        return _members[member].latency_ema;
+    }
+
     // Dispatch requests that are pending in the I/O queue
     void poll_io_queue();
 
@@ -179,6 +262,11 @@ public:
     future<> update_shares_for_class(io_priority_class pc, size_t new_shares);
     void rename_priority_class(io_priority_class pc, sstring new_name);
 
+    // Applies new configuration parameters at runtime, adjusting the fair
+    // queue ticket costs accordingly. The device id is kept, and the group
+    // limits are updated separately via \ref io_group::update_config.
+    future<> update_config(config cfg);
+
     struct request_limits {
         size_t max_read;
         size_t max_write;
@@ -189,6 +277,17 @@ public:
 private:
     config _config;
     static fair_queue::config make_fair_queue_config(config cfg);
+
+    // Online calibration state (see config::online_calibration) -- the
+    // resources served in the current measurement window, whether the disk
+    // went idle during it, and when the window started.
+    static constexpr std::chrono::seconds calibration_period = std::chrono::seconds(1);
+    fair_queue_ticket _served;
+    bool _served_idled = false;
+    std::chrono::steady_clock::time_point _window_start = internal::tsc_clock::now();
+
+    void account_served(fair_queue_ticket desc) noexcept;
+    void recalibrate(std::chrono::steady_clock::time_point now) noexcept;
 };
 
 }
@@ -106,6 +106,65 @@ output_stream<CharType>::zero_copy_split_and_put(net::packet p) noexcept {
     });
 }
 
+template <typename CharType>
+future<>
+output_stream<CharType>::vectored_put(std::vector<temporary_buffer<CharType>> bufs) noexcept {
+    // if flush is scheduled, disable it, so it will not try to write in parallel
+    _flush = false;
+    if (_flushing) {
+        // flush in progress, wait for it to end before continuing
+        return _in_batch.value().get_future().then([this, bufs = std::move(bufs)] () mutable {
+            return _fd.put(std::move(bufs));
+        });
+    } else {
+        return _fd.put(std::move(bufs));
+    }
+}
+
+// Writes @bufs in batches of _size total length. The last batch is buffered if smaller.
+template <typename CharType>
+future<>
+output_stream<CharType>::vectored_split_and_put(std::vector<temporary_buffer<CharType>> bufs) noexcept {
+    return repeat([this, bufs = std::move(bufs), len = std::exchange(_vectored_len, size_t(0))] () mutable {
+        if (len < _size) {
+            _vectored_len = len;
+            _vectored_bufs = std::move(bufs);
+            return make_ready_future<stop_iteration>(stop_iteration::yes);
+        }
+        std::vector<temporary_buffer<CharType>> batch;
+        size_t need = _size;
+        auto i = bufs.begin();
+        while (need != 0) {
+            if (i->size() <= need) {
+                need -= i->size();
+                batch.push_back(std::move(*i++));
+            } else {
+                batch.push_back(i->share(0, need));
+                i->trim_front(need);
+                need = 0;
+            }
+        }
+        bufs.erase(bufs.begin(), i);
+        len -= _size;
+        return vectored_put(std::move(batch)).then([] {
+            return stop_iteration::no;
+        });
+    });
+}
+
+template <typename CharType>
+future<>
+output_stream<CharType>::vectored_maybe_put() noexcept {
+    if (_vectored_len < _size) {
+        return make_ready_future<>();
+    }
+    if (_trim_to_size) {
+        return vectored_split_and_put(std::exchange(_vectored_bufs, {}));
+    }
+    _vectored_len = 0;
+    return vectored_put(std::exchange(_vectored_bufs, {}));
+}
+
 template<typename CharType>
 future<> output_stream<CharType>::write(net::packet p) noexcept {
     static_assert(std::is_same<CharType, char>::value, "packet works on char");
@@ -113,6 +172,14 @@ future<> output_stream<CharType>::write(net::packet p) noexcept {
     if (p.len() != 0) {
         assert(!_end && "Mixing buffered writes and zero-copy writes not supported yet");
 
+        if (_vectored_writes) {
+            for (auto&& buf : p.release()) {
+                _vectored_len += buf.size();
+                _vectored_bufs.push_back(std::move(buf));
+            }
+            return vectored_maybe_put();
+        }
+
         if (_zc_bufs) {
             _zc_bufs.append(std::move(p));
         } else {
@@ -140,6 +207,11 @@ future<> output_stream<CharType>::write(temporary_buffer<CharType> p) noexcept {
         return make_ready_future<>();
     }
     assert(!_end && "Mixing buffered writes and zero-copy writes not supported yet");
+    if (_vectored_writes) {
+        _vectored_len += p.size();
+        _vectored_bufs.push_back(std::move(p));
+        return vectored_maybe_put();
+    }
     return write(net::packet(std::move(p)));
   } catch (...) {
     return current_exception_as_future();
@@ -354,7 +426,7 @@ template <typename CharType>
 future<>
 output_stream<CharType>::slow_write(const char_type* buf, size_t n) noexcept {
   try {
-    assert(!_zc_bufs && "Mixing buffered writes and zero-copy writes not supported yet");
+    assert(!_zc_bufs && _vectored_bufs.empty() && "Mixing buffered writes and zero-copy writes not supported yet");
     auto bulk_threshold = _end ? (2 * _size - _end) : _size;
     if (n >= bulk_threshold) {
         if (_end) {
@@ -418,6 +490,11 @@ output_stream<CharType>::flush() noexcept {
             return zero_copy_put(std::move(_zc_bufs)).then([this] {
                 return _fd.flush();
             });
+        } else if (!_vectored_bufs.empty()) {
+            _vectored_len = 0;
+            return vectored_put(std::exchange(_vectored_bufs, {})).then([this] {
+                return _fd.flush();
+            });
         }
     } else {
         if (_ex) {
@@ -473,6 +550,9 @@ output_stream<CharType>::poll_flush() noexcept {
         f = _fd.put(std::move(_buf));
     } else if(_zc_bufs) {
         f = _fd.put(std::move(_zc_bufs));
+    } else if (!_vectored_bufs.empty()) {
+        _vectored_len = 0;
+        f = _fd.put(std::exchange(_vectored_bufs, {}));
     }
 
     // FIXME: future is discarded
@@ -550,4 +630,27 @@ future<> copy(input_stream<CharType>& in, output_stream<CharType>& out) {
 }
 
 extern template future<> copy<char>(input_stream<char>&, output_stream<char>&);
+
+inline
+future<uint64_t> splice(data_source& in, data_sink& out) {
+    return do_with(uint64_t(0), [&in, &out] (uint64_t& moved) {
+        return repeat([&in, &out, &moved] {
+            return in.get().then([&out, &moved] (temporary_buffer<char> buf) {
+                if (buf.empty()) {
+                    return make_ready_future<stop_iteration>(stop_iteration::yes);
+                }
+                moved += buf.size();
+                // hand the buffer over by reference; put() wraps it in a
+                // packet together with its deleter
+                return out.put(std::move(buf)).then([&out] {
+                    return out.flush();
+                }).then([] {
+                    return stop_iteration::no;
+                });
+            });
+        }).then([&moved] {
+            return make_ready_future<uint64_t>(moved);
+        });
+    });
+}
 }
@@ -321,6 +321,12 @@ private:
 /// chunks larger than the configured size, which could be the case when a
 /// single write call is made with data larger than the configured size.
 ///
+/// When vectored_writes is true, whole-buffer writes accumulate the
+/// caller-owned buffers as they are and are eventually handed over to the
+/// data sink as a single vector of buffers, so many small writes reach a
+/// sink capable of scatter/gather output in one call and without copying
+/// each of them into the stream's buffer.
+///
 /// The data sink will not receive empty chunks.
 ///
 /// \note All methods must be called sequentially.  That is, no method
@@ -332,11 +338,14 @@ class output_stream final {
     data_sink _fd;
     temporary_buffer<CharType> _buf;
     net::packet _zc_bufs = net::packet::make_null_packet(); //zero copy buffers
+    std::vector<temporary_buffer<CharType>> _vectored_bufs; //vectored write buffers
+    size_t _vectored_len = 0;
     size_t _size = 0;
     size_t _begin = 0;
     size_t _end = 0;
     bool _trim_to_size = false;
     bool _batch_flushes = false;
+    bool _vectored_writes = false;
     std::optional<promise<>> _in_batch;
     bool _flush = false;
     bool _flushing = false;
@@ -349,13 +358,16 @@ private:
     void poll_flush() noexcept;
     future<> zero_copy_put(net::packet p) noexcept;
     future<> zero_copy_split_and_put(net::packet p) noexcept;
+    future<> vectored_put(std::vector<temporary_buffer<CharType>> bufs) noexcept;
+    future<> vectored_split_and_put(std::vector<temporary_buffer<CharType>> bufs) noexcept;
+    future<> vectored_maybe_put() noexcept;
     [[gnu::noinline]]
     future<> slow_write(const CharType* buf, size_t n) noexcept;
 public:
     using char_type = CharType;
     output_stream() noexcept = default;
-    output_stream(data_sink fd, size_t size, bool trim_to_size = false, bool batch_flushes = false) noexcept
-        : _fd(std::move(fd)), _size(size), _trim_to_size(trim_to_size), _batch_flushes(batch_flushes) {}
+    output_stream(data_sink fd, size_t size, bool trim_to_size = false, bool batch_flushes = false, bool vectored_writes = false) noexcept
+        : _fd(std::move(fd)), _size(size), _trim_to_size(trim_to_size), _batch_flushes(batch_flushes), _vectored_writes(vectored_writes) {}
     output_stream(output_stream&&) noexcept = default;
     output_stream& operator=(output_stream&&) noexcept = default;
     ~output_stream() { assert(!_in_batch && "Was this stream properly closed?"); }
@@ -398,6 +410,23 @@ private:
 template <typename CharType>
 future<> copy(input_stream<CharType>&, output_stream<CharType>&);
 
+/*!
+ * \brief move the entire content of a \ref data_source into a \ref data_sink
+ *
+ * Unlike \ref copy(), which stages the bytes through the streams'
+ * buffers, the source's buffers are handed to the sink by reference,
+ * deleters and all, so nothing is copied in userspace and the bytes are
+ * never inspected. This is the primitive for pure-forwarding proxies:
+ * take the \c data_source and \c data_sink of two connected sockets and
+ * splice one into the other. The sink is flushed after every buffer, so
+ * data is forwarded as soon as it arrives.
+ *
+ * Neither endpoint is closed; the caller remains responsible for both.
+ *
+ * \returns the number of bytes moved, once \c in reaches end-of-stream.
+ */
+future<uint64_t> splice(data_source& in, data_sink& out);
+
 }
 
 #include "iostream-impl.hh"
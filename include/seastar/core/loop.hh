@@ -29,7 +29,6 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/task.hh>
 #include <seastar/util/bool_class.hh>
-#include <seastar/core/semaphore.hh>
 
 namespace seastar {
 
@@ -505,8 +504,10 @@ iterator_range_estimate_vector_capacity(Iterator begin, Iterator end, std::forwa
 
 /// \cond internal
 
-class parallel_for_each_state final : private continuation_base<> {
+class parallel_for_each_state : private continuation_base<> {
+protected:
     std::vector<future<>> _incomplete;
+private:
     promise<> _result;
     std::exception_ptr _ex;
 private:
@@ -516,7 +517,19 @@ private:
     void wait_for_one() noexcept;
     virtual void run_and_dispose() noexcept override;
     task* waiting_task() noexcept override { return _result.waiting_task(); }
+protected:
+    // Hook for subclasses that start work lazily (max_concurrent_for_each):
+    // called every time completed futures have been reaped from
+    // _incomplete, so more work can be admitted with add_future(). The
+    // plain parallel_for_each starts everything up front.
+    virtual void refill() noexcept {}
+    virtual ~parallel_for_each_state() = default;
 public:
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    // re-export, hidden by the private inheritance from task
+    using continuation_base<>::operator new;
+    using continuation_base<>::operator delete;
+#endif
     parallel_for_each_state(size_t n);
     void add_future(future<>&& f);
     future<> get_future();
@@ -599,6 +612,36 @@ parallel_for_each_impl(Range&& range, Func&& func) {
             std::forward<Func>(func));
 }
 
+// State for max_concurrent_for_each(): a parallel_for_each_state that
+// holds on to the input range and starts iterations lazily, keeping at
+// most the window's worth in flight. Whenever completed futures are
+// reaped the window is topped back up through the refill() hook, so a
+// long range is processed with bounded memory and a single allocation.
+template <typename Iterator, typename Func>
+class max_concurrent_for_each_state final : public parallel_for_each_state {
+    Iterator _begin;
+    Iterator _end;
+    Func _func;
+    size_t _window;
+private:
+    virtual void refill() noexcept override {
+        while (_begin != _end && _incomplete.size() < _window) {
+            auto f = futurize_invoke(_func, *_begin++);
+            if (!f.available() || f.failed()) {
+                add_future(std::move(f));
+            }
+        }
+    }
+public:
+    max_concurrent_for_each_state(Iterator begin, Iterator end, Func func, size_t window)
+            : parallel_for_each_state(window)
+            , _begin(std::move(begin))
+            , _end(std::move(end))
+            , _func(std::move(func))
+            , _window(window) {
+    }
+};
+
 } // namespace internal
 
 template <typename Range, typename Func>
@@ -633,56 +676,24 @@ SEASTAR_CONCEPT( requires requires (Func f, Iterator i) { { f(*i++) } -> std::sa
 inline
 future<>
 max_concurrent_for_each(Iterator begin, Iterator end, size_t max_concurrent, Func&& func) noexcept {
-    struct state {
-        Iterator begin;
-        Iterator end;
-        Func func;
-        size_t max_concurrent;
-        semaphore sem;
-        std::exception_ptr err;
-
-        state(Iterator begin_, Iterator end_, size_t max_concurrent_, Func func_)
-            : begin(std::move(begin_))
-            , end(std::move(end_))
-            , func(std::move(func_))
-            , max_concurrent(max_concurrent_)
-            , sem(max_concurrent_)
-            , err()
-        { }
-    };
-
     assert(max_concurrent > 0);
 
-    try {
-        return do_with(state(std::move(begin), std::move(end), max_concurrent, std::forward<Func>(func)), [] (state& s) {
-            return do_until([&s] { return s.begin == s.end; }, [&s] {
-                return s.sem.wait().then([&s] () mutable noexcept {
-                    // Possibly run in background and signal _sem when the task is done.
-                    // The background tasks are waited on using _sem.
-                    (void)futurize_invoke(s.func, *s.begin++).then_wrapped([&s] (future<> fut) {
-                        if (fut.failed()) {
-                            auto e = fut.get_exception();;
-                            if (!s.err) {
-                                s.err = std::move(e);
-                            }
-                        }
-                        s.sem.signal();
-                    });
-                });
-            }).then([&s] {
-                // Wait for any background task to finish
-                // and signal and semaphore
-                return s.sem.wait(s.max_concurrent);
-            }).then([&s] {
-                if (!s.err) {
-                    return make_ready_future<>();
-                }
-                return seastar::make_exception_future<>(std::move(s.err));
-            });
-        });
-    } catch (...) {
-        return current_exception_as_future();
+    // Process elements one by one as long as they complete immediately;
+    // hand off to a max_concurrent_for_each_state (which fills the window
+    // through its refill() hook) the moment one of them blocks.
+    while (begin != end) {
+        auto f = futurize_invoke(std::forward<Func>(func), *begin++);
+        if (!f.available() || f.failed()) {
+            memory::scoped_critical_alloc_section _;
+            auto s = new internal::max_concurrent_for_each_state<Iterator, Func>(
+                    std::move(begin), std::move(end), std::forward<Func>(func), max_concurrent);
+            s->add_future(std::move(f));
+            // s->get_future() takes ownership of s (and chains it to one of the futures it
+            // contains) so this isn't a leak
+            return s->get_future();
+        }
     }
+    return make_ready_future<>();
 }
 
 /// Run a maximum of \c max_concurrent tasks in parallel (range version).
@@ -23,12 +23,17 @@
 
 #include <seastar/core/resource.hh>
 #include <seastar/core/bitops.hh>
+#include <seastar/core/sstring.hh>
+#include <chrono>
 #include <new>
 #include <functional>
+#include <utility>
 #include <vector>
 
 namespace seastar {
 
+class scheduling_group;
+
 /// \defgroup memory-module Memory management
 ///
 /// Functions and classes for managing memory.
@@ -208,6 +213,18 @@ extern std::pmr::polymorphic_allocator<char>* malloc_allocator;
 // Returns @true if any work was actually performed.
 bool drain_cross_cpu_freelist();
 
+// Attempts to extend an allocation in place, without moving it.
+//
+// Works only for large (multi-page) allocations owned by the calling
+// shard, and only when the allocation's span can absorb its free buddy
+// spans up to the requested size; returns false otherwise, leaving the
+// allocation untouched. On success the object may be used up to
+// new_size bytes (rounded up to whole pages), and must be freed with
+// the extended size.
+//
+// Always returns false with the default (libc) allocator.
+bool try_extend(void* ptr, size_t new_size) noexcept;
+
 
 // We don't want the memory code calling back into the rest of
 // the system, so allow the rest of the system to tell the memory
@@ -220,6 +237,109 @@ void set_reclaim_hook(
 
 /// \endcond
 
+/// Returns the number of live bytes attributed to a scheduling group on
+/// this shard.
+///
+/// Bytes are attributed to the scheduling group that is current when an
+/// allocation or a free is performed. An object allocated under one group
+/// and freed under another is counted as a transfer between the two, so
+/// the figure is an approximation for objects that change hands.
+size_t scheduling_group_live_memory(scheduling_group sg) noexcept;
+
+/// Sets a soft memory limit for a scheduling group on this shard.
+///
+/// When the group's live bytes (see \ref scheduling_group_live_memory())
+/// exceed \c limit, \c callback is invoked once, from reactor context, in
+/// a safe place with respect to allocations. The callback is re-armed
+/// when live bytes drop back below the limit. The limit is soft:
+/// allocations are never failed because of it; the callback is expected
+/// to shed load or release memory (e.g. trim a cache).
+///
+/// Passing \c std::numeric_limits<size_t>::max() and an empty callback
+/// removes the limit.
+///
+/// \param limit soft limit, in bytes, of live memory for the group
+/// \param callback called when the limit is exceeded
+void set_scheduling_group_soft_limit(scheduling_group sg, size_t limit,
+        std::function<void ()> callback);
+
+/// Enables the sampled memory profiler on this shard.
+///
+/// One backtrace is taken per \c rate allocated bytes, so the overhead
+/// is proportional to the allocation volume and, with a rate of a
+/// megabyte or more, low enough to keep the profiler enabled in
+/// production. Unlike the `SEASTAR_HEAPPROF` profiler, no per-object
+/// state is kept: the profile attributes allocation volume to call
+/// chains, which is what's needed to find allocation and fragmentation
+/// sources.
+///
+/// \param rate bytes of allocation between samples; 0 disables sampling
+void set_sampled_memory_profiling_rate(size_t rate);
+
+/// Returns the current sampling rate (see \ref set_sampled_memory_profiling_rate()).
+size_t sampled_memory_profiling_rate();
+
+/// Returns this shard's sampled allocation profile in collapsed-stack
+/// ("flamegraph") format: one line per sampled call chain, frames
+/// separated by semicolons, followed by the estimated bytes allocated
+/// through that chain. The output can be fed directly to flamegraph.pl.
+sstring sampled_memory_profile();
+
+/// Enables sampled cross-shard layout diagnostics on this shard.
+///
+/// While enabled, each allocation sampled by the memory profiler is
+/// tracked until freed. Objects freed by a shard other than their owner
+/// have their allocation site charged with a remote free, and sampled
+/// allocations made under different scheduling groups that land on the
+/// same cache line are recorded as false-sharing suspects. Both reports
+/// are part of the memory diagnostics dump (see
+/// \ref generate_memory_diagnostics_report()), so layout problems behind
+/// the \c cross_cpu_frees counter can be attributed to code rather than
+/// guessed at.
+///
+/// Samples are taken by the sampled memory profiler, so a profiling rate
+/// must be set (see \ref set_sampled_memory_profiling_rate()) for the
+/// diagnostics to collect anything. Enabling restarts the collection.
+void set_layout_diagnostics_enabled(bool enabled);
+
+/// Returns whether layout diagnostics are enabled (see \ref set_layout_diagnostics_enabled()).
+bool layout_diagnostics_enabled();
+
+/// \cond internal
+
+// Inter-shard span donation. A shard that runs low on memory can hold
+// whole spans donated by other shards and use them to satisfy large
+// allocations; a donated span remains part of the donor's pool, so
+// freeing it routes it back to the donor through the regular cross-cpu
+// free path. Like reclaim, the protocol is driven from outside (the
+// reactor), so the memory code never calls into the rest of the system.
+
+// Size of the spans exchanged between shards.
+static constexpr size_t donation_span_size = 8 << 20;
+
+// Donor side: carve a span of at least \c bytes out of this shard's pool,
+// if it has comfortable free-memory headroom; returns nullptr otherwise.
+void* try_allocate_donation(size_t bytes);
+
+// Borrower side: add a donated span to this shard's reserve.
+void add_donated_span(void* span, size_t bytes);
+
+// Borrower side: retrieve an unused donated span once memory pressure
+// has subsided; the caller is expected to free() it, returning it to
+// the donor. Returns {nullptr, 0} when no span should be given back.
+std::pair<void*, size_t> retrieve_donated_span();
+
+// True when this shard is low enough on memory that borrowing spans
+// from other shards is warranted (with hysteresis against
+// retrieve_donated_span()).
+bool wants_donated_memory();
+
+// Driver for set_idle_memory_return(), called periodically by the
+// reactor. Returns the number of bytes released to the OS by this call.
+size_t return_idle_memory();
+
+/// \endcond
+
 class statistics;
 
 /// Capture a snapshot of memory allocation statistics for this lcore.
@@ -238,14 +358,20 @@ class statistics {
     uint64_t _foreign_mallocs;
     uint64_t _foreign_frees;
     uint64_t _foreign_cross_frees;
+
+    uint64_t _soft_limit_hits;
+    uint64_t _bytes_returned_to_os;
 private:
     statistics(uint64_t mallocs, uint64_t frees, uint64_t cross_cpu_frees,
             uint64_t total_memory, uint64_t free_memory, uint64_t reclaims, uint64_t large_allocs,
-            uint64_t foreign_mallocs, uint64_t foreign_frees, uint64_t foreign_cross_frees)
+            uint64_t foreign_mallocs, uint64_t foreign_frees, uint64_t foreign_cross_frees,
+            uint64_t soft_limit_hits, uint64_t bytes_returned_to_os)
         : _mallocs(mallocs), _frees(frees), _cross_cpu_frees(cross_cpu_frees)
         , _total_memory(total_memory), _free_memory(free_memory), _reclaims(reclaims), _large_allocs(large_allocs)
         , _foreign_mallocs(foreign_mallocs), _foreign_frees(foreign_frees)
-        , _foreign_cross_frees(foreign_cross_frees) {}
+        , _foreign_cross_frees(foreign_cross_frees)
+        , _soft_limit_hits(soft_limit_hits)
+        , _bytes_returned_to_os(bytes_returned_to_os) {}
 public:
     /// Total number of memory allocations calls since the system was started.
     uint64_t mallocs() const { return _mallocs; }
@@ -272,6 +398,12 @@ public:
     uint64_t foreign_frees() const { return _foreign_frees; }
     /// Number of foreign frees on reactor threads
     uint64_t foreign_cross_frees() const { return _foreign_cross_frees; }
+    /// Number of times a scheduling group exceeded its soft memory limit
+    /// (see \ref set_scheduling_group_soft_limit())
+    uint64_t soft_limit_hits() const { return _soft_limit_hits; }
+    /// Number of bytes of idle memory returned to the OS
+    /// (see \ref set_idle_memory_return())
+    uint64_t bytes_returned_to_os() const { return _bytes_returned_to_os; }
     friend statistics stats();
 };
 
@@ -284,6 +416,14 @@ struct memory_layout {
 // Supported only when seastar allocator is enabled.
 memory::memory_layout get_memory_layout();
 
+// Fault in the given address range in batches so that later allocations
+// do not stall on page faults. May be called from any thread, even while
+// the owning shard is allocating from the range; the kernel populates
+// pages without touching their contents. A no-op on kernels without
+// MADV_POPULATE_WRITE (older than 5.14), where the memory keeps being
+// faulted on first use instead.
+void prefault_memory(memory_layout layout);
+
 /// Returns the value of free memory low water mark in bytes.
 /// When free memory is below this value, reclaimers are invoked until it goes above again.
 size_t min_free_memory();
@@ -291,6 +431,23 @@ size_t min_free_memory();
 /// Sets the value of free memory low water mark in memory::page_size units.
 void set_min_free_pages(size_t pages);
 
+/// Enable returning idle memory to the OS.
+///
+/// When this shard's free memory has stayed above \c watermark_bytes for
+/// longer than \c grace, whole free spans are released back to the OS with
+/// batched madvise(MADV_FREE) calls. The spans remain on the free lists
+/// and are reused normally; the kernel reclaims the underlying pages
+/// lazily, under memory pressure, and refaults them transparently on first
+/// write. The amount released so far is reported by
+/// \ref statistics::bytes_returned_to_os().
+///
+/// \param watermark_bytes free memory level above which memory is
+///        released; pass 0 to disable (the default).
+/// \param grace how long free memory must stay above the watermark before
+///        releasing starts, so short-lived dips in usage are not returned
+///        just to be faulted back in.
+void set_idle_memory_return(size_t watermark_bytes, std::chrono::milliseconds grace);
+
 /// Enable the large allocation warning threshold.
 ///
 /// Warn when allocation above a given threshold are performed.
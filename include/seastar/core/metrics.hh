@@ -23,6 +23,7 @@
 
 #include <functional>
 #include <seastar/core/sstring.hh>
+#include <seastar/core/interned_string.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <boost/lexical_cast.hpp>
@@ -312,6 +313,11 @@ struct metric_value {
 
 using metric_function = std::function<metric_value()>;
 
+// Label names recur across the whole metric population, so they are
+// interned: label map lookups and comparisons reduce to pointer
+// comparisons on the keys.
+using labels_type = std::map<interned_string, sstring>;
+
 struct metric_type {
     data_type base_type;
     metric_type_def type_name;
@@ -323,7 +329,7 @@ struct metric_definition_impl {
     metric_function f;
     description d;
     bool enabled = true;
-    std::map<sstring, sstring> labels;
+    labels_type labels;
     metric_definition_impl& operator ()(bool enabled);
     metric_definition_impl& operator ()(const label_instance& label);
     metric_definition_impl& set_type(const sstring& type_name);
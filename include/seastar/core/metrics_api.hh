@@ -22,7 +22,9 @@
 #pragma once
 
 #include <seastar/core/metrics.hh>
+#include <chrono>
 #include <unordered_map>
+#include <regex>
 #include <seastar/core/sharded.hh>
 #include <boost/functional/hash.hpp>
 /*!
@@ -32,15 +34,6 @@
  *
  *
  */
-namespace seastar {
-namespace metrics {
-namespace impl {
-
-using labels_type = std::map<sstring, sstring>;
-}
-}
-}
-
 namespace std {
 
 template<>
@@ -139,6 +132,70 @@ struct hash<seastar::metrics::impl::metric_id>
 
 namespace seastar {
 namespace metrics {
+
+/*!
+ * \brief a relabeling rule applied to metrics as they are registered
+ *
+ * Rules are evaluated in order for every metric that is about to be
+ * registered. The values of the source labels, joined with ';', are
+ * matched against the regular expression in expr; the pseudo label
+ * \_\_name\_\_ stands for the metric full name. Depending on the action a
+ * matching rule can filter the metric out entirely, so it is never
+ * allocated nor iterated during a scrape, or rewrite its labels.
+ */
+struct relabel_config {
+    enum class relabel_action {
+        replace,    ///< set target_label to the replacement, expanding capture groups
+        keep,       ///< register only metrics the expression matches
+        drop,       ///< do not register metrics the expression matches
+        drop_label, ///< remove target_label when the expression matches
+    };
+    std::vector<sstring> source_labels;
+    sstring target_label;
+    sstring replacement = "$1";
+    sstring expr = "(.*)";
+    relabel_action action = relabel_action::replace;
+};
+
+/*!
+ * \brief replace the relabeling rules on all shards
+ *
+ * The rules apply in full to metrics registered from then on. For series
+ * that are already registered only the filtering actions are re-evaluated
+ * (filtered series are disabled rather than removed, so relaxing the rules
+ * later brings them back); label rewrites cannot be applied retroactively
+ * because the owners hold the registered ids.
+ *
+ * An invalid regular expression in one of the rules fails the returned
+ * future and leaves the previous rules in place.
+ */
+future<> set_relabel_configs(std::vector<relabel_config> configs);
+
+/*!
+ * \brief the relabeling rules of the local shard
+ */
+std::vector<relabel_config> get_relabel_configs();
+
+/*!
+ * \brief cache metric samples for the given period on all shards
+ *
+ * When several consumers (or one consumer polling several endpoints)
+ * scrape the metrics at a high frequency, most of the scrape cost is
+ * re-evaluating every registered metric on every shard each time. With
+ * a caching period set, a shard samples its metrics at most once per
+ * period and scrapes that arrive in between share the previous
+ * snapshot.
+ *
+ * A period of zero (the default) disables caching and every scrape
+ * samples afresh.
+ */
+future<> set_sample_caching_period(std::chrono::milliseconds period);
+
+/*!
+ * \brief the sample caching period of the local shard
+ */
+std::chrono::milliseconds get_sample_caching_period();
+
 namespace impl {
 
 /*!
@@ -182,6 +239,7 @@ class impl;
 
 class registered_metric {
     metric_info _info;
+    bool _enabled_by_def;
     metric_function _f;
     shared_ptr<impl> _impl;
 public:
@@ -199,6 +257,14 @@ public:
         _info.enabled = b;
     }
 
+    /*!
+     * \brief whether the metric definition itself enables it, before any
+     * relabel rule is taken into account
+     */
+    bool enabled_by_definition() const {
+        return _enabled_by_def;
+    }
+
     const metric_id& get_id() const {
         return _info.id;
     }
@@ -309,6 +375,15 @@ using metric_values = std::vector<value_vector>;
 struct values_copy {
     shared_ptr<metric_metadata> metadata;
     metric_values values;
+    // bumped whenever the set of registered metrics on the shard
+    // changes; a consumer that remembers the epoch it last saw can
+    // keep reusing derived metadata (merged names, label sets) while
+    // the epoch is stable.
+    uint64_t epoch = 0;
+    // when the copy holds a bounded window of the metric families (see
+    // the windowed get_values() overload), the name of the first family
+    // that was left out; empty when nothing was left out.
+    sstring next_window;
 };
 
 struct config {
@@ -316,11 +391,22 @@ struct config {
 };
 
 class impl {
+    // a relabel_config with its expression compiled once instead of on
+    // every registration
+    struct relabel_rule {
+        relabel_config cfg;
+        std::regex expr;
+    };
     value_map _value_map;
     config _config;
     bool _dirty = true;
+    uint64_t _epoch = 0;
     shared_ptr<metric_metadata> _metadata;
     std::vector<std::vector<metric_function>> _current_metrics;
+    std::vector<relabel_rule> _relabel_rules;
+    shared_ptr<values_copy> _cached_sample;
+    std::chrono::steady_clock::time_point _cached_sample_time;
+    std::chrono::milliseconds _sample_caching_period{0};
 public:
     value_map& get_value_map() {
         return _value_map;
@@ -350,7 +436,50 @@ public:
 
     void dirty() {
         _dirty = true;
+        _epoch++;
+        _cached_sample = nullptr;
+    }
+
+    uint64_t epoch() const {
+        return _epoch;
+    }
+
+    void set_sample_caching_period(std::chrono::milliseconds period) {
+        _sample_caching_period = period;
+        _cached_sample = nullptr;
+    }
+
+    std::chrono::milliseconds get_sample_caching_period() const {
+        return _sample_caching_period;
     }
+
+    /*!
+     * \brief the last sample, if it is still fresh enough to serve
+     */
+    shared_ptr<values_copy> cached_sample(std::chrono::steady_clock::time_point now) const {
+        if (_cached_sample && now - _cached_sample_time < _sample_caching_period) {
+            return _cached_sample;
+        }
+        return nullptr;
+    }
+
+    void cache_sample(shared_ptr<values_copy> sample, std::chrono::steady_clock::time_point now) {
+        if (_sample_caching_period.count()) {
+            _cached_sample = std::move(sample);
+            _cached_sample_time = now;
+        }
+    }
+
+    /*!
+     * \brief run the relabel rules over the labels of a metric being
+     * registered, possibly rewriting them
+     *
+     * returns false when a keep or drop rule filters the metric out
+     */
+    bool apply_relabel_rules(const sstring& full_name, labels_type& labels) const;
+
+    void set_relabel_configs(const std::vector<relabel_config>& configs);
+    std::vector<relabel_config> get_relabel_configs() const;
 };
 
 const value_map& get_value_map();
@@ -358,6 +487,19 @@ using values_reference = shared_ptr<values_copy>;
 
 foreign_ptr<values_reference> get_values();
 
+/*!
+ * \brief sample a bounded window of the shard's metric families
+ *
+ * Like get_values(), but copies only the families whose name is greater
+ * than or equal to \c start_family, up to \c max_families of them, so a
+ * consumer can walk the (sorted) families in bounded slices instead of
+ * holding a snapshot of all of them at once. The name of the first
+ * family left out is reported in values_copy::next_window, to be used
+ * as the start of the following window. \c max_families must be at
+ * least one.
+ */
+foreign_ptr<values_reference> get_values(const sstring& start_family, size_t max_families);
+
 shared_ptr<impl> get_local_impl();
 
 void unregister_metric(const metric_id & id);
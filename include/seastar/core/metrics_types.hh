@@ -20,6 +20,9 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <vector>
 
 namespace seastar {
@@ -78,6 +81,80 @@ struct histogram {
 
 };
 
+/*!
+ * \brief log-linear histogram recorder
+ *
+ * The cheap hot-path counterpart of \ref histogram: recording a value is
+ * an array increment and a sum update, with a single branch in the bucket
+ * index computation. Values are spread over power-of-two ranges, each
+ * split into 2^(Precision-1) linear sub-buckets, so quantiles are resolved
+ * with a relative error of about 2^-Precision whatever the magnitude.
+ * Values of Max and above saturate into the last bucket.
+ *
+ * A recorder belongs to one shard like any other metric source, so plain
+ * increments suffice and no atomics are involved. Conversion to the
+ * \ref histogram snapshot, including the cumulative bucket counts the
+ * exposition formats want, is deferred to to_histogram(), i.e. happens
+ * only when a scrape samples the metric.
+ */
+template <uint64_t Max, unsigned Precision = 2>
+class log_histogram {
+    static_assert(Precision >= 1 && Precision < 32, "Precision out of range");
+    static_assert(Max > (1ull << Precision), "Max smaller than the linear range");
+
+    static constexpr uint64_t sub_buckets = 1ull << Precision;
+
+    static constexpr unsigned index_of(uint64_t value) {
+        if (value < sub_buckets) {
+            return value;
+        }
+        unsigned bucket = 63 - __builtin_clzll(value) - Precision + 1;
+        return sub_buckets + (bucket - 1) * (sub_buckets / 2) + ((value >> bucket) - sub_buckets / 2);
+    }
+
+    static constexpr unsigned nr_buckets = index_of(Max - 1) + 1;
+
+    // the largest value the bucket at index counts (inclusive, as in the
+    // "le" label of the prometheus exposition)
+    static constexpr uint64_t upper_bound_of(unsigned index) {
+        if (index < sub_buckets) {
+            return index;
+        }
+        unsigned bucket = (index - sub_buckets) / (sub_buckets / 2) + 1;
+        uint64_t sub = (index - sub_buckets) % (sub_buckets / 2) + sub_buckets / 2;
+        return ((sub + 1) << bucket) - 1;
+    }
+
+    std::array<uint64_t, nr_buckets> _counts = {};
+    uint64_t _sum = 0;
+public:
+    void record(uint64_t value) {
+        _counts[std::min(index_of(value), nr_buckets - 1)]++;
+        _sum += value;
+    }
+
+    /*!
+     * \brief snapshot the recorder as a \ref histogram
+     *
+     * The optional scale converts the recorded units in the reported
+     * bounds and sum, e.g. pass 1e-6 when recording microseconds to
+     * report seconds.
+     */
+    histogram to_histogram(double scale = 1) const {
+        histogram h;
+        h.buckets.resize(nr_buckets);
+        uint64_t cumulative = 0;
+        for (unsigned i = 0; i < nr_buckets; i++) {
+            cumulative += _counts[i];
+            h.buckets[i].count = cumulative;
+            h.buckets[i].upper_bound = upper_bound_of(i) * scale;
+        }
+        h.sample_count = cumulative;
+        h.sample_sum = _sum * scale;
+        return h;
+    }
+};
+
 }
 
 }
@@ -21,8 +21,11 @@
 
 #pragma once
 
+#include <seastar/core/bitops.hh>
+#include <seastar/core/memory.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/util/std-compat.hh>
+#include <cstdint>
 
 namespace seastar {
 
@@ -40,4 +43,119 @@ temporary_buffer<CharType> make_temporary_buffer(std::pmr::polymorphic_allocator
         make_deleter(deleter(), [allocator, buffer, size] () mutable { allocator->deallocate(buffer, size); }));
 }
 
+namespace internal {
+
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+
+// Shard-local recycling pool for network receive buffers.
+//
+// The receive path allocates a buffer per read and the consumer usually
+// drops it shortly afterwards, so steady-state receive churns the
+// allocator with same-sized allocations. The pool caches returned
+// buffers in a few power-of-two size classes and hands them back to
+// subsequent reads, so a connection at steady state performs no
+// allocator calls per read. A buffer whose last reference dies on a
+// different shard is freed normally instead of being pushed into the
+// wrong shard's pool.
+// The address of this tag identifies a thread; a pool remembers its
+// owner's tag so a deleter running on another shard can tell it must
+// not touch the pool.
+inline thread_local int rx_buffer_pool_thread_tag;
+
+class rx_buffer_pool {
+public:
+    struct statistics {
+        uint64_t hits = 0;    // allocations served from the pool
+        uint64_t misses = 0;  // allocations that went to the allocator
+        uint64_t returns = 0; // buffers accepted back into the pool
+        uint64_t drops = 0;   // buffers rejected because their class was full
+    };
+    static constexpr size_t min_buffer_size = 4096;
+    static constexpr size_t max_buffer_size = 256 * 1024;
+    static bool poolable(size_t size) {
+        return size >= min_buffer_size && size <= max_buffer_size && !(size & (size - 1));
+    }
+private:
+    static constexpr unsigned nr_classes = log2floor(max_buffer_size) - log2floor(min_buffer_size) + 1;
+    // Deep enough to cover the buffers in flight on a busy shard without
+    // holding on to unbounded memory (at most ~4MB of cached buffers).
+    static constexpr unsigned max_free_per_class = 8;
+    struct size_class {
+        char* free[max_free_per_class];
+        unsigned nr_free = 0;
+    };
+    size_class _classes[nr_classes];
+    statistics _stats;
+    const int* _owner_tag = &rx_buffer_pool_thread_tag;
+private:
+    static unsigned class_idx(size_t size) {
+        return log2floor(size) - log2floor(min_buffer_size);
+    }
+public:
+    temporary_buffer<char> allocate(size_t size);
+    void free(char* buffer, size_t size);
+    bool owned_by_this_thread() const { return _owner_tag == &rx_buffer_pool_thread_tag; }
+    const statistics& stats() const { return _stats; }
+    // Deliberately no destructor: buffers can outlive the pool during
+    // thread teardown, and their deleters must not find a destroyed
+    // pool. The few cached buffers are reclaimed when the process exits.
+};
+
+inline thread_local rx_buffer_pool local_rx_buffer_pool;
+
+inline
+temporary_buffer<char>
+rx_buffer_pool::allocate(size_t size) {
+    auto& sc = _classes[class_idx(size)];
+    char* buffer;
+    if (sc.nr_free) {
+        buffer = sc.free[--sc.nr_free];
+        ++_stats.hits;
+    } else {
+        buffer = static_cast<char*>(::operator new(size));
+        ++_stats.misses;
+    }
+    auto pool = this;
+    return temporary_buffer<char>(buffer, size, make_deleter(deleter(), [pool, buffer, size] {
+        if (pool->owned_by_this_thread()) {
+            pool->free(buffer, size);
+        } else {
+            // last reference died on a different shard
+            ::operator delete(buffer);
+        }
+    }));
+}
+
+inline
+void
+rx_buffer_pool::free(char* buffer, size_t size) {
+    auto& sc = _classes[class_idx(size)];
+    if (sc.nr_free < max_free_per_class) {
+        sc.free[sc.nr_free++] = buffer;
+        ++_stats.returns;
+    } else {
+        ::operator delete(buffer);
+        ++_stats.drops;
+    }
+}
+
+#endif
+
+} // namespace internal
+
+/// Creates a `temporary_buffer` for the network receive path.
+///
+/// Like \ref make_temporary_buffer(), but buffers of common receive
+/// sizes allocated with the default allocator are recycled through a
+/// shard-local pool, so steady-state packet receive does not hit the
+/// allocator at all.
+inline temporary_buffer<char> make_recycled_temporary_buffer(std::pmr::polymorphic_allocator<char>* allocator, std::size_t size) {
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    if (allocator == memory::malloc_allocator && internal::rx_buffer_pool::poolable(size)) {
+        return internal::local_rx_buffer_pool.allocate(size);
+    }
+#endif
+    return make_temporary_buffer<char>(allocator, size);
+}
+
 }
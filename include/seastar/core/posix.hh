@@ -265,6 +265,22 @@ public:
         throw_system_error_on(r == -1, "sendmsg");
         return { size_t(r) };
     }
+    std::optional<unsigned> sendmmsg(mmsghdr* msgs, unsigned n, int flags) {
+        auto r = ::sendmmsg(_fd, msgs, n, flags);
+        if (r == -1 && errno == EAGAIN) {
+            return {};
+        }
+        throw_system_error_on(r == -1, "sendmmsg");
+        return { unsigned(r) };
+    }
+    std::optional<unsigned> recvmmsg(mmsghdr* msgs, unsigned n, int flags) {
+        auto r = ::recvmmsg(_fd, msgs, n, flags, nullptr);
+        if (r == -1 && errno == EAGAIN) {
+            return {};
+        }
+        throw_system_error_on(r == -1, "recvmmsg");
+        return { unsigned(r) };
+    }
     void bind(sockaddr& sa, socklen_t sl) {
         auto r = ::bind(_fd, &sa, sl);
         throw_system_error_on(r == -1, "bind");
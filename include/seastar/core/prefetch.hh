@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <boost/mpl/range_c.hpp>
 #include <boost/mpl/for_each.hpp>
@@ -37,6 +37,15 @@ struct config {
     sstring hostname; //!< hostname is deprecated, use label instead
     std::optional<metrics::label_instance> label; //!< A label that will be added to all metrics, we advice not to use it and set it on the prometheus server
     sstring prefix = "seastar"; //!< a prefix that will be added to metric names
+    /*!
+     * The scrape response is produced in chunks: a window of metric
+     * families is gathered from the shards, written out and flushed
+     * before the next window is gathered, so a slow scraper does not
+     * pin a snapshot of all the metrics. This bounds the number of
+     * metric families gathered per shard in each window; 0 disables
+     * the chunking and gathers everything at once.
+     */
+    size_t metric_families_per_chunk = 256;
 };
 
 future<> start(httpd::http_server_control& http_server, config ctx);
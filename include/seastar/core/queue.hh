@@ -21,9 +21,8 @@
 
 #pragma once
 
-#include <seastar/core/circular_buffer.hh>
+#include <seastar/core/chunked_fifo.hh>
 #include <seastar/core/future.hh>
-#include <queue>
 #include <seastar/util/std-compat.hh>
 
 namespace seastar {
@@ -33,7 +32,9 @@ namespace seastar {
 /// Operations returning a future are considered to be active until the future resolves.
 template <typename T>
 class queue {
-    std::queue<T, circular_buffer<T>> _q;
+    // chunked_fifo grows and shrinks chunk by chunk, so queue depth
+    // changes never reallocate and move the whole contents
+    chunked_fifo<T> _q;
     size_t _max;
     std::optional<promise<>> _not_empty;
     std::optional<promise<>> _not_full;
@@ -49,6 +50,25 @@ public:
     /// Returns false if the queue was full and the item was not pushed.
     bool push(T&& a);
 
+    /// \brief Push a batch of items.
+    ///
+    /// Moves items from the range into the queue until the queue is full
+    /// or the range is exhausted, signalling the consumer at most once
+    /// for the whole batch. Returns the number of items pushed; it is up
+    /// to the caller to retry the remainder once the queue drains.
+    /// A producer-side operation.
+    template <typename InputIterator>
+    size_t push_batch(InputIterator begin, InputIterator end);
+
+    /// \brief Pop a batch of items.
+    ///
+    /// Moves up to \c limit items from the queue into \c out, signalling
+    /// the producer at most once for the whole batch. Returns the number
+    /// of items popped.
+    /// A consumer-side operation.
+    template <typename OutputIterator>
+    size_t pop_batch(OutputIterator out, size_t limit);
+
     /// \brief Pop an item.
     ///
     /// Popping from an empty queue will result in undefined behavior.
@@ -117,9 +137,7 @@ public:
     /// Destroy any items in the queue, and pass the provided exception to any
     /// waiting readers or writers - or to any later read or write attempts.
     void abort(std::exception_ptr ex) {
-        while (!_q.empty()) {
-            _q.pop();
-        }
+        _q.clear();
         _ex = ex;
         if (_not_full) {
             _not_full->set_exception(ex);
@@ -167,7 +185,7 @@ template <typename T>
 inline
 bool queue<T>::push(T&& data) {
     if (_q.size() < _max) {
-        _q.push(std::move(data));
+        _q.push_back(std::move(data));
         notify_not_empty();
         return true;
     } else {
@@ -175,6 +193,37 @@ bool queue<T>::push(T&& data) {
     }
 }
 
+template <typename T>
+template <typename InputIterator>
+inline
+size_t queue<T>::push_batch(InputIterator begin, InputIterator end) {
+    size_t pushed = 0;
+    while (begin != end && _q.size() < _max) {
+        _q.push_back(std::move(*begin++));
+        ++pushed;
+    }
+    if (pushed) {
+        notify_not_empty();
+    }
+    return pushed;
+}
+
+template <typename T>
+template <typename OutputIterator>
+inline
+size_t queue<T>::pop_batch(OutputIterator out, size_t limit) {
+    size_t popped = 0;
+    while (popped < limit && !_q.empty()) {
+        *out++ = std::move(_q.front());
+        _q.pop_front();
+        ++popped;
+    }
+    if (popped && !full()) {
+        notify_not_full();
+    }
+    return popped;
+}
+
 template <typename T>
 inline
 T& queue<T>::front() {
@@ -188,7 +237,7 @@ T queue<T>::pop() {
         notify_not_full();
     }
     T data = std::move(_q.front());
-    _q.pop();
+    _q.pop_front();
     return data;
 }
 
@@ -219,11 +268,11 @@ future<> queue<T>::push_eventually(T&& data) {
     }
     if (full()) {
         return not_full().then([this, data = std::move(data)] () mutable {
-            _q.push(std::move(data));
+            _q.push_back(std::move(data));
             notify_not_empty();
         });
     } else {
-        _q.push(std::move(data));
+        _q.push_back(std::move(data));
         notify_not_empty();
         return make_ready_future<>();
     }
@@ -239,7 +288,7 @@ bool queue<T>::consume(Func&& func) {
     bool running = true;
     while (!_q.empty() && running) {
         running = func(std::move(_q.front()));
-        _q.pop();
+        _q.pop_front();
     }
     if (!full()) {
         notify_not_full();
@@ -77,11 +77,15 @@
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/manual_clock.hh>
 #include <seastar/core/metrics_registration.hh>
+#include <seastar/core/metrics_types.hh>
 #include <seastar/core/scheduling.hh>
 #include <seastar/core/scheduling_specific.hh>
 #include <seastar/core/smp.hh>
 #include <seastar/core/internal/io_request.hh>
 #include <seastar/core/internal/io_sink.hh>
+#include <seastar/core/internal/perf_counters.hh>
+#include <seastar/core/internal/tracer.hh>
+#include <seastar/core/internal/tsc_clock.hh>
 #include <seastar/core/make_task.hh>
 #include "internal/pollable_fd.hh"
 #include "internal/poll.hh"
@@ -145,6 +149,7 @@ namespace internal {
 
 class reactor_stall_sampler;
 class cpu_stall_detector;
+class cpu_profiler;
 class buffer_allocator;
 
 template <typename Func> // signature: bool ()
@@ -178,6 +183,103 @@ class io_queue;
 class io_intent;
 class disk_config_params;
 
+namespace internal {
+
+// Governs how long an idle shard keeps polling before blocking in the
+// kernel. The reactor feeds it the outcome of every poll and the length of
+// every sleep; from those it maintains fixed-point moving averages of the
+// poll hit rate and of the fraction of "premature" sleeps (wakeups arriving
+// right after blocking, where the sleep/wakeup latency dominates), and moves
+// the shard between three modes:
+//
+//  - busy_poll:  polls frequently pay off; stretch the poll window so we
+//                rarely pay the sleep/wakeup cost.
+//  - timed_poll: the configured --idle-poll-time-us behavior.
+//  - blocked:    polling is mostly wasted CPU; shrink the poll window and
+//                block early.
+//
+// The current mode and the number of transitions are exposed through the
+// reactor metric group.
+class idle_poll_governor {
+public:
+    enum class state : uint8_t { busy_poll = 0, timed_poll = 1, blocked = 2 };
+private:
+    // fixed-point scale for the moving averages: 0..1024 == 0%..100%
+    static constexpr unsigned ema_scale_bits = 10;
+    // decay of ~1/64 per sample: reacts within a few thousand polls
+    static constexpr unsigned ema_decay_bits = 6;
+    static constexpr unsigned ema_one = 1u << ema_scale_bits;
+    // a sleep shorter than this is considered premature: we paid the
+    // block/unblock latency for nothing
+    static constexpr std::chrono::microseconds premature_sleep_threshold = std::chrono::microseconds(200);
+    unsigned _poll_success = 0;    // EMA of poll hit rate while idling
+    unsigned _premature_sleeps = 0; // EMA of sleeps below the threshold
+    state _state = state::timed_poll;
+    uint64_t _transitions = 0;
+private:
+    void bump(unsigned& ema, bool hit) noexcept {
+        ema -= ema >> ema_decay_bits;
+        if (hit) {
+            ema += ema_one >> ema_decay_bits;
+        }
+    }
+    void update_state() noexcept {
+        // enter/exit thresholds differ to provide hysteresis
+        auto next = _state;
+        switch (_state) {
+        case state::busy_poll:
+            if (_poll_success < ema_one / 4) {
+                next = state::timed_poll;
+            }
+            break;
+        case state::timed_poll:
+            if (_poll_success > ema_one / 2) {
+                next = state::busy_poll;
+            } else if (_poll_success < ema_one / 20 && _premature_sleeps < ema_one / 4) {
+                next = state::blocked;
+            }
+            break;
+        case state::blocked:
+            if (_poll_success > ema_one / 10 || _premature_sleeps > ema_one / 2) {
+                next = state::timed_poll;
+            }
+            break;
+        }
+        if (next != _state) {
+            _state = next;
+            ++_transitions;
+        }
+    }
+public:
+    void account_poll(bool did_work) noexcept {
+        bump(_poll_success, did_work);
+        update_state();
+    }
+    void account_sleep(std::chrono::nanoseconds duration) noexcept {
+        bump(_premature_sleeps, duration < premature_sleep_threshold);
+        update_state();
+    }
+    state current_state() const noexcept {
+        return _state;
+    }
+    uint64_t transitions() const noexcept {
+        return _transitions;
+    }
+    std::chrono::nanoseconds poll_time(std::chrono::nanoseconds configured) const noexcept {
+        switch (_state) {
+        case state::busy_poll:
+            return configured * 16;
+        case state::timed_poll:
+            return configured;
+        case state::blocked:
+            return configured / 16;
+        }
+        __builtin_unreachable();
+    }
+};
+
+}
+
 class io_completion : public kernel_completion {
 public:
     virtual void complete_with(ssize_t res) final override;
@@ -187,7 +289,10 @@ public:
 };
 
 class reactor {
-    using sched_clock = std::chrono::steady_clock;
+    // timestamps taken all over the scheduling path; served from the
+    // calibrated TSC when available, which shares the steady_clock
+    // timeline and time_point type
+    using sched_clock = internal::tsc_clock;
 private:
     struct task_queue;
     using task_queue_list = circular_buffer_fixed_capacity<task_queue*, max_scheduling_groups()>;
@@ -197,6 +302,7 @@ private:
     class batch_flush_pollfn;
     class smp_pollfn;
     class drain_cross_cpu_freelist_pollfn;
+    class memory_rebalance_pollfn;
     class lowres_timer_pollfn;
     class manual_timer_pollfn;
     class epoll_pollfn;
@@ -207,12 +313,16 @@ private:
     class execution_stage_pollfn;
     friend class manual_clock;
     friend class file_data_source_impl; // for fstream statistics
+    friend class file_data_sink_impl; // ditto
+    friend class posix_file_impl; // for async metadata operations
     friend class internal::reactor_stall_sampler;
     friend class preempt_io_context;
     friend struct hrtimer_aio_completion;
     friend struct task_quota_aio_completion;
     friend class reactor_backend_epoll;
     friend class reactor_backend_aio;
+    friend class reactor_backend_uring;
+    friend struct hrtimer_uring_completion;
     friend class reactor_backend_selector;
     friend class aio_storage_context;
 public:
@@ -233,6 +343,11 @@ public:
         uint64_t fstream_read_bytes_blocked = 0;
         uint64_t fstream_read_aheads_discarded = 0;
         uint64_t fstream_read_ahead_discarded_bytes = 0;
+        uint64_t fstream_writes = 0;
+        uint64_t fstream_write_bytes = 0;
+        uint64_t fstream_write_behind_grown = 0;
+        uint64_t fstream_write_behind_shrunk = 0;
+        uint64_t fsyncs_coalesced = 0;
     };
     /// Scheduling statistics.
     struct sched_stats {
@@ -285,18 +400,32 @@ private:
     uint64_t _global_tasks_processed = 0;
     uint64_t _polls = 0;
     std::unique_ptr<internal::cpu_stall_detector> _cpu_stall_detector;
+    std::unique_ptr<internal::cpu_profiler> _cpu_profiler;
 
     unsigned _max_task_backlog = 1000;
-    timer_set<timer<>, &timer<>::_link> _timers;
-    timer_set<timer<>, &timer<>::_link>::timer_list_t _expired_timers;
-    timer_set<timer<lowres_clock>, &timer<lowres_clock>::_link> _lowres_timers;
-    timer_set<timer<lowres_clock>, &timer<lowres_clock>::_link>::timer_list_t _expired_lowres_timers;
-    timer_set<timer<manual_clock>, &timer<manual_clock>::_link> _manual_timers;
-    timer_set<timer<manual_clock>, &timer<manual_clock>::_link>::timer_list_t _expired_manual_timers;
+    // The active timer set implementation: the classic bucketed timer_set by
+    // default, or the hierarchical timing wheel (O(1) arm/disarm with bounded
+    // cascade cost, better for very large timer populations) when built with
+    // -DSEASTAR_TIMER_WHEEL.
+#ifdef SEASTAR_TIMER_WHEEL
+    template <typename Clock>
+    using timer_set_type = timer_wheel<timer<Clock>, &timer<Clock>::_link>;
+#else
+    template <typename Clock>
+    using timer_set_type = timer_set<timer<Clock>, &timer<Clock>::_link>;
+#endif
+    timer_set_type<steady_clock_type> _timers;
+    timer_set_type<steady_clock_type>::timer_list_t _expired_timers;
+    timer_set_type<lowres_clock> _lowres_timers;
+    timer_set_type<lowres_clock>::timer_list_t _expired_lowres_timers;
+    timer_set_type<manual_clock> _manual_timers;
+    timer_set_type<manual_clock>::timer_list_t _expired_manual_timers;
     io_stats _io_stats;
     uint64_t _fsyncs = 0;
     uint64_t _cxx_exceptions = 0;
     uint64_t _abandoned_failed_futures = 0;
+    bool _memory_rebalance_in_progress = false;
+    unsigned _next_memory_donor = 0;
     struct task_queue {
         explicit task_queue(unsigned id, sstring name, float shares);
         int64_t _vruntime = 0;
@@ -305,11 +434,20 @@ private:
         bool _current = false;
         bool _active = false;
         uint8_t _id;
+        // target delay between becoming runnable and first task running;
+        // zero disables deadline scheduling (see pop_eligible_task_queue())
+        sched_clock::duration _latency_goal = {};
         sched_clock::time_point _ts; // to help calculating wait/starve-times
         sched_clock::duration _runtime = {};
         sched_clock::duration _waittime = {};
         sched_clock::duration _starvetime = {};
         uint64_t _tasks_processed = 0;
+        uint64_t _queue_length_hwm = 0;
+        // hardware events consumed by this queue's tasks; only advances
+        // with --scheduling-group-counters
+        internal::hw_perf_counters::sample _hw_events = {};
+        // scheduling delay per activation, in microseconds, saturating at ~1s
+        metrics::log_histogram<1024 * 1024, 2> _time_to_first_run;
         circular_buffer<task*> _q;
         sstring _name;
         int64_t to_vruntime(sched_clock::duration runtime) const;
@@ -325,11 +463,29 @@ private:
     boost::container::static_vector<std::unique_ptr<task_queue>, max_scheduling_groups()> _task_queues;
     internal::scheduling_group_specific_thread_local_data _scheduling_group_specific_data;
     int64_t _last_vruntime = 0;
+    unsigned _nr_deadline_task_queues = 0; // queues with a latency goal set
     task_queue_list _active_task_queues;
     task_queue_list _activating_task_queues;
     task_queue* _at_destroy_tasks;
     sched_clock::duration _task_quota;
+    // What the preemption timer is actually armed with. Equals _task_quota
+    // unless --adaptive-task-quota shrinks it towards the scheduling groups'
+    // latency goals and the current load (see update_effective_task_quota()).
+    sched_clock::duration _effective_task_quota;
+    bool _adaptive_task_quota = false;
+    // Smoothed per-activation scheduling delay across all task queues,
+    // feeding overloaded(). Decays in the load timer so a shard that went
+    // idle does not keep reporting overload.
+    sched_clock::duration _sched_delay_ema = {};
+    // Scheduling delay above which overloaded() reports true; zero
+    // disables the signal (see --overload-threshold-ms).
+    sched_clock::duration _overload_threshold = {};
+    // per-thread hardware counters sampled at task-queue switches
+    // (see --scheduling-group-counters)
+    internal::hw_perf_counters _hw_counters;
+    bool _enable_hw_counters = false;
     task* _current_task = nullptr;
+    internal::tracer _tracer;
     /// Handler that will be called when there is no task to execute on cpu.
     /// It represents a low priority work.
     /// 
@@ -352,6 +508,7 @@ private:
     sched_clock::duration _total_sleep;
     sched_clock::time_point _start_time = sched_clock::now();
     std::chrono::nanoseconds _max_poll_time = calculate_poll_time();
+    internal::idle_poll_governor _idle_governor;
     circular_buffer<output_stream<char>* > _flush_batching;
     std::atomic<bool> _sleeping alignas(seastar::cache_line_size){0};
     pthread_t _thread_id alignas(seastar::cache_line_size) = pthread_self();
@@ -364,12 +521,14 @@ private:
 private:
     static std::chrono::nanoseconds calculate_poll_time();
     static void block_notifier(int);
+    static void profiler_notifier(int);
     void wakeup();
     size_t handle_aio_error(internal::linux_abi::iocb* iocb, int ec);
     bool flush_pending_aio();
     steady_clock_type::time_point next_pending_aio() const noexcept;
     bool reap_kernel_completions();
     bool flush_tcp_batches();
+    bool maybe_rebalance_memory();
     bool do_expire_lowres_timers() noexcept;
     bool do_check_lowres_timers() const noexcept;
     void expire_manual_timers() noexcept;
@@ -427,6 +586,7 @@ private:
     void activate(task_queue& tq);
     void insert_active_task_queue(task_queue* tq);
     task_queue* pop_active_task_queue(sched_clock::time_point now);
+    task_queue* pop_eligible_task_queue(sched_clock::time_point now);
     void insert_activating_task_queues();
     void account_runtime(task_queue& tq, sched_clock::duration runtime);
     void account_idle(sched_clock::duration idletime);
@@ -439,6 +599,7 @@ private:
     void request_preemption();
     void start_handling_signal();
     void reset_preemption_monitor();
+    void update_effective_task_quota() noexcept;
     void service_highres_timer() noexcept;
 
     future<std::tuple<pollable_fd, socket_address>>
@@ -507,6 +668,10 @@ public:
     future<> write_all(pollable_fd_state& fd, const void* buffer, size_t size);
 
     future<file> open_file_dma(std::string_view name, open_flags flags, file_open_options options = {}) noexcept;
+    // Give the reactor backend a chance to pre-register a storage fd with
+    // the kernel (a no-op on all backends except io_uring).
+    void register_storage_file(int fd) noexcept;
+    void unregister_storage_file(int fd) noexcept;
     future<file> open_directory(std::string_view name) noexcept;
     future<> make_directory(std::string_view name, file_permissions permissions = file_permissions::default_dir_permissions) noexcept;
     future<> touch_directory(std::string_view name, file_permissions permissions = file_permissions::default_dir_permissions) noexcept;
@@ -525,7 +690,12 @@ public:
     future<> chmod(std::string_view name, file_permissions permissions) noexcept;
 
     future<int> inotify_add_watch(int fd, std::string_view path, uint32_t flags);
-    
+
+    // Runs a short blocking or CPU-intensive function on the auxiliary
+    // syscall thread, returning its result. The function must not touch any
+    // reactor state.
+    future<int> run_blocking(noncopyable_function<int ()> func) noexcept;
+
     // In the following three methods, prepare_io is not guaranteed to execute in the same processor
     // in which it was generated. Therefore, care must be taken to avoid the use of objects that could
     // be destroyed within or at exit of prepare_io.
@@ -562,11 +732,19 @@ public:
 #endif
     task* current_task() const { return _current_task; }
 
+    internal::tracer& tracer() noexcept { return _tracer; }
+
+    internal::cpu_profiler& profiler() noexcept;
+
     void add_task(task* t) noexcept {
+        if (__builtin_expect(_tracer.enabled(), false)) {
+            _tracer.on_schedule(t);
+        }
         auto sg = t->group();
         auto* q = _task_queues[sg._id].get();
         bool was_empty = q->_q.empty();
         q->_q.push_back(std::move(t));
+        q->_queue_length_hwm = std::max<uint64_t>(q->_queue_length_hwm, q->_q.size());
 #ifdef SEASTAR_SHUFFLE_TASK_QUEUE
         shuffle(q->_q.back(), *q);
 #endif
@@ -576,10 +754,14 @@ public:
     }
     void add_urgent_task(task* t) noexcept {
         memory::scoped_critical_alloc_section _;
+        if (__builtin_expect(_tracer.enabled(), false)) {
+            _tracer.on_schedule(t);
+        }
         auto sg = t->group();
         auto* q = _task_queues[sg._id].get();
         bool was_empty = q->_q.empty();
         q->_q.push_front(std::move(t));
+        q->_queue_length_hwm = std::max<uint64_t>(q->_queue_length_hwm, q->_q.size());
 #ifdef SEASTAR_SHUFFLE_TASK_QUEUE
         shuffle(q->_q.front(), *q);
 #endif
@@ -614,6 +796,23 @@ public:
     steady_clock_type::duration total_busy_time();
     std::chrono::nanoseconds total_steal_time();
 
+    /// Returns the configured task quota (\c --task-quota-ms).
+    sched_clock::duration task_quota() const noexcept { return _task_quota; }
+
+    /// Returns the smoothed delay between a scheduling group becoming
+    /// runnable and its first task running, across all groups on this
+    /// shard. It rises when the run queue grows deeper than the CPU can
+    /// drain promptly, making it a useful overload signal; see \ref
+    /// overloaded().
+    sched_clock::duration scheduling_delay() const noexcept { return _sched_delay_ema; }
+
+    /// Returns true if the shard is overloaded, i.e. \ref scheduling_delay()
+    /// exceeds the threshold configured with \c --overload-threshold-ms.
+    /// Servers (httpd, rpc) consult this to shed or defer new work early
+    /// instead of queueing it behind an already-unserviceable backlog.
+    /// Always false when the threshold is unset (the default).
+    bool overloaded() const noexcept;
+
     const io_stats& get_io_stats() const { return _io_stats; }
     /// Returns statistics related to scheduling. The statistics are
     /// local to this shard.
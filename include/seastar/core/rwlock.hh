@@ -22,6 +22,7 @@
 #pragma once
 
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/chunked_fifo.hh>
 
 namespace seastar {
 
@@ -175,6 +176,166 @@ public:
 
 using rwlock = basic_rwlock<>;
 
+/// \cond internal
+class read_mostly_rwlock;
+
+// lock / unlock semantics for read_mostly_rwlock, so it can be used with with_lock()
+class read_mostly_rwlock_for_read {
+public:
+    future<> lock();
+    void unlock();
+    friend class read_mostly_rwlock;
+};
+
+class read_mostly_rwlock_for_write {
+public:
+    future<> lock();
+    void unlock();
+    friend class read_mostly_rwlock;
+};
+/// \endcond
+
+/// Read-write lock specialized for read-mostly data.
+///
+/// Like \ref rwlock this is a shard-local lock between fibers, not a
+/// cross-CPU lock. Unlike \ref rwlock, which routes every operation
+/// through a semaphore, the read path here is a counter update guarded
+/// by a single test of the writer count: an uncontended \ref read_lock
+/// or \ref read_unlock touches no wait list and allocates nothing.
+/// In exchange, writers are preferred: while any writer is active or
+/// queued, new readers wait, and queued writers are drained
+/// consecutively, each unlock handing the lock directly to the next
+/// writer, before the readers are admitted again. This suits locks
+/// that are taken for read on every request and for write only on rare
+/// reconfiguration, where batching the writers keeps the reader stall
+/// to one window instead of one per writer.
+///
+/// Does not support timeouts; use \ref rwlock if waits must expire.
+class read_mostly_rwlock : private read_mostly_rwlock_for_read, read_mostly_rwlock_for_write {
+    uint32_t _readers = 0;
+    // Active writer plus queued writers. Nonzero blocks new readers, so
+    // the reader fast path tests a single word.
+    uint32_t _writers = 0;
+    chunked_fifo<promise<>> _waiting_writers;
+    chunked_fifo<promise<>> _waiting_readers;
+private:
+    void wake_readers() noexcept {
+        while (!_waiting_readers.empty()) {
+            ++_readers;
+            _waiting_readers.front().set_value();
+            _waiting_readers.pop_front();
+        }
+    }
+public:
+    read_mostly_rwlock() = default;
+    read_mostly_rwlock(read_mostly_rwlock&&) = default;
+    read_mostly_rwlock& operator=(read_mostly_rwlock&&) = default;
+    read_mostly_rwlock(const read_mostly_rwlock&) = delete;
+    void operator=(const read_mostly_rwlock&) = delete;
+
+    /// Cast this lock into a read lock object to be used with "with_lock";
+    /// its lock / unlock calls acquire / release the lock in read mode.
+    read_mostly_rwlock_for_read& for_read() {
+        return *this;
+    }
+
+    /// Cast this lock into a write lock object to be used with "with_lock";
+    /// its lock / unlock calls acquire / release the lock in write mode.
+    read_mostly_rwlock_for_write& for_write() {
+        return *this;
+    }
+
+    /// Acquires this lock in read mode. Many readers are allowed, but when
+    /// this future returns, and until \ref read_unlock is called, all fibers
+    /// waiting on \ref write_lock are guaranteed not to execute.
+    future<> read_lock() {
+        if (__builtin_expect(!_writers, true)) {
+            ++_readers;
+            return make_ready_future<>();
+        }
+        _waiting_readers.emplace_back();
+        return _waiting_readers.back().get_future();
+    }
+
+    /// Releases the lock, which must have been taken in read mode.
+    void read_unlock() noexcept {
+        assert(_readers > 0);
+        if (__builtin_expect(--_readers == 0 && _writers, false)) {
+            // While readers hold the lock every writer is queued, so the
+            // list cannot be empty here; hand the lock to the first one.
+            _waiting_writers.front().set_value();
+            _waiting_writers.pop_front();
+        }
+    }
+
+    /// Acquires this lock in write mode. Only one writer is allowed. When
+    /// this future returns, and until \ref write_unlock is called, all other
+    /// fibers waiting on either \ref read_lock or \ref write_lock are
+    /// guaranteed not to execute.
+    future<> write_lock() {
+        if (++_writers == 1 && !_readers) {
+            return make_ready_future<>();
+        }
+        _waiting_writers.emplace_back();
+        return _waiting_writers.back().get_future();
+    }
+
+    /// Releases the lock, which must have been taken in write mode. Queued
+    /// writers are serviced first, consecutively; readers are admitted once
+    /// no writer is left.
+    void write_unlock() noexcept {
+        assert(_writers > 0 && _readers == 0);
+        if (--_writers) {
+            _waiting_writers.front().set_value();
+            _waiting_writers.pop_front();
+            return;
+        }
+        wake_readers();
+    }
+
+    /// Tries to acquire the lock in read mode iff this can be done without waiting.
+    bool try_read_lock() noexcept {
+        if (_writers) {
+            return false;
+        }
+        ++_readers;
+        return true;
+    }
+
+    /// Tries to acquire the lock in write mode iff this can be done without waiting.
+    bool try_write_lock() noexcept {
+        if (_readers || _writers) {
+            return false;
+        }
+        _writers = 1;
+        return true;
+    }
+
+    /// Checks if any read or write locks are currently held or queued for.
+    bool locked() const noexcept {
+        return _readers || _writers;
+    }
+
+    friend class read_mostly_rwlock_for_read;
+    friend class read_mostly_rwlock_for_write;
+};
+
+inline future<> read_mostly_rwlock_for_read::lock() {
+    return static_cast<read_mostly_rwlock*>(this)->read_lock();
+}
+
+inline void read_mostly_rwlock_for_read::unlock() {
+    static_cast<read_mostly_rwlock*>(this)->read_unlock();
+}
+
+inline future<> read_mostly_rwlock_for_write::lock() {
+    return static_cast<read_mostly_rwlock*>(this)->write_lock();
+}
+
+inline void read_mostly_rwlock_for_write::unlock() {
+    static_cast<read_mostly_rwlock*>(this)->write_unlock();
+}
+
 /// @}
 
 }
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <typeindex>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/function_traits.hh>
@@ -283,6 +284,27 @@ public:
     /// \param shares number of shares allotted to the group. Use numbers
     ///               in the 1-1000 range.
     void set_shares(float shares) noexcept;
+    /// Returns the number of shares currently allotted to the group
+    /// on this shard, as set at creation time or by the latest call
+    /// to \ref set_shares().
+    float get_shares() const noexcept;
+    /// Declares a target scheduling latency for the group.
+    ///
+    /// Shares give proportional throughput but no latency bound: a
+    /// latency-critical group can wait behind a full quota of tasks from a
+    /// batch group. A group with a latency goal is instead dispatched in
+    /// earliest-deadline-first order whenever it has been runnable long
+    /// enough that the goal is about to be missed; while all goals are
+    /// met, the shares-driven proportional order applies unchanged. The
+    /// group's CPU time still counts against its shares, so a deadline
+    /// group cannot monopolize the CPU by setting an aggressive goal.
+    ///
+    /// The adjustment is local to the shard.
+    ///
+    /// \param goal target delay between the group becoming runnable and
+    ///             its first task running; zero (the default) disables
+    ///             deadline scheduling for the group.
+    void set_latency_goal(std::chrono::microseconds goal) noexcept;
     friend future<scheduling_group> create_scheduling_group(sstring name, float shares) noexcept;
     friend future<> destroy_scheduling_group(scheduling_group sg) noexcept;
     friend future<> rename_scheduling_group(scheduling_group sg, sstring new_name) noexcept;
@@ -25,6 +25,7 @@
 #include <seastar/core/chunked_fifo.hh>
 #include <stdexcept>
 #include <exception>
+#include <seastar/core/scheduling.hh>
 #include <seastar/core/timer.hh>
 #include <seastar/core/expiring_fifo.hh>
 
@@ -107,23 +108,27 @@ public:
     using clock = typename timer<Clock>::clock;
     using time_point = typename timer<Clock>::time_point;
     using exception_factory = ExceptionFactory;
+    /// The error produced by the exception factory when a wait times out.
+    using timeout_error = decltype(std::declval<const ExceptionFactory&>().timeout());
 private:
     ssize_t _count;
+    size_t _max_waiters = 0;
     std::exception_ptr _ex;
     struct entry {
-        promise<> pr;
+        promise<expected<void, timeout_error>> pr;
         size_t nr;
-        entry(promise<>&& pr_, size_t nr_) noexcept : pr(std::move(pr_)), nr(nr_) {}
+        // group the waiter will resume in; used by priority inheritance
+        scheduling_group sg = current_scheduling_group();
+        entry(promise<expected<void, timeout_error>>&& pr_, size_t nr_) noexcept : pr(std::move(pr_)), nr(nr_) {}
     };
     using expiry_handler = std::function<void (entry&)>;
     expiring_fifo<entry, expiry_handler, clock> _wait_list;
     expiry_handler make_expiry_handler() noexcept {
+        // The timeout is delivered as a plain value; waiters entered
+        // through wait() convert it to an exception, while
+        // wait_expected() waiters examine it without rethrowing.
         return [this] (entry& e) noexcept {
-            try {
-                e.pr.set_exception(this->timeout());
-            } catch (...) {
-                e.pr.set_exception(semaphore_timed_out());
-            }
+            e.pr.set_value(unexpected<timeout_error>{this->timeout()});
         };
     }
     bool has_available_units(size_t nr) const noexcept {
@@ -132,6 +137,47 @@ private:
     bool may_proceed(size_t nr) const noexcept {
         return has_available_units(nr) && _wait_list.empty();
     }
+    // Priority-inheritance state (see set_priority_inheritance()). The
+    // holder is approximated by the scheduling group of the most recent
+    // grant, which is exact for mutex-like usage (initial count of one).
+    scheduling_group _holder_sg = {};
+    scheduling_group _boosted_sg = {};
+    float _original_shares = 0;
+    // highest shares among the groups that waited since the queue was
+    // last drained
+    float _max_waiting_shares = 0;
+    bool _priority_inheritance = false;
+    bool _boosted = false;
+    void record_holder() noexcept {
+        if (_priority_inheritance) {
+            _holder_sg = current_scheduling_group();
+        }
+    }
+    // Raises the holder group's shares to the highest shares among the
+    // waiting groups, so a low-shares holder is not starved of CPU while
+    // higher-priority work queues up behind it.
+    void boost_holder() noexcept {
+        if (_boosted) {
+            if (_boosted_sg == _holder_sg) {
+                _boosted_sg.set_shares(std::max(_max_waiting_shares, _original_shares));
+                return;
+            }
+            unboost();
+        }
+        auto shares = _holder_sg.get_shares();
+        if (_max_waiting_shares > shares) {
+            _original_shares = shares;
+            _boosted_sg = _holder_sg;
+            _boosted = true;
+            _boosted_sg.set_shares(_max_waiting_shares);
+        }
+    }
+    void unboost() noexcept {
+        if (_boosted) {
+            _boosted_sg.set_shares(_original_shares);
+            _boosted = false;
+        }
+    }
 public:
     /// Returns the maximum number of units the semaphore counter can hold
     static constexpr size_t max_counter() noexcept {
@@ -184,21 +230,72 @@ public:
     future<> wait(time_point timeout, size_t nr = 1) noexcept {
         if (may_proceed(nr)) {
             _count -= nr;
+            record_holder();
             return make_ready_future<>();
         }
         if (_ex) {
             return make_exception_future(_ex);
         }
-        entry e(promise<>(), nr);
+        return wait_expected(timeout, nr).then([] (expected<void, timeout_error> r) {
+            return to_future(std::move(r));
+        });
+    }
+
+    /// Waits until at least a specific number of units are available in the
+    /// counter, and reduces the counter by that amount of units.  If the
+    /// request cannot be satisfied in time, the request is aborted.
+    ///
+    /// Unlike \ref wait(), a timeout is reported as a plain error value in
+    /// the returned \ref expected rather than as an exceptional future, so
+    /// callers that time out at a high rate do not pay for exception
+    /// creation and rethrow on every expiry.  If the semaphore was
+    /// \ref broken(), the future is still exceptional.
+    ///
+    /// \param timeout expiration time.
+    /// \param nr Amount of units to wait for (default 1).
+    /// \return a future resolving to a successful \ref expected when
+    ///         sufficient units are available, or to one carrying the
+    ///         exception factory's timeout error on expiry.
+    future<expected<void, timeout_error>> wait_expected(time_point timeout, size_t nr = 1) noexcept {
+        if (may_proceed(nr)) {
+            _count -= nr;
+            record_holder();
+            return make_ready_future<expected<void, timeout_error>>();
+        }
+        if (_ex) {
+            return make_exception_future<expected<void, timeout_error>>(_ex);
+        }
+        entry e(promise<expected<void, timeout_error>>(), nr);
         auto fut = e.pr.get_future();
         try {
             _wait_list.push_back(std::move(e), timeout);
+            _max_waiters = std::max(_max_waiters, _wait_list.size());
+            if (_priority_inheritance) {
+                _max_waiting_shares = std::max(_max_waiting_shares, current_scheduling_group().get_shares());
+                boost_holder();
+            }
         } catch (...) {
             e.pr.set_exception(std::current_exception());
         }
         return fut;
     }
 
+    /// Waits until at least a specific number of units are available in the
+    /// counter, and reduces the counter by that amount of units.  If the
+    /// request cannot be satisfied in time, the request is aborted.
+    ///
+    /// Like \ref wait_expected(time_point, size_t), but with the timeout
+    /// specified as a duration.
+    ///
+    /// \param timeout how long to wait.
+    /// \param nr Amount of units to wait for (default 1).
+    /// \return a future resolving to a successful \ref expected when
+    ///         sufficient units are available, or to one carrying the
+    ///         exception factory's timeout error on expiry.
+    future<expected<void, timeout_error>> wait_expected(duration timeout, size_t nr = 1) noexcept {
+        return wait_expected(clock::now() + timeout, nr);
+    }
+
     /// Waits until at least a specific number of units are available in the
     /// counter, and reduces the counter by that amount of units.  If the request
     /// cannot be satisfied in time, the request is aborted.
@@ -223,6 +320,12 @@ public:
     /// ready, and the value of the counter is reduced according to
     /// the amount requested.
     ///
+    /// All waiters satisfiable by the deposit are woken in a single
+    /// pass; a bulk release never wakes a waiter whose request cannot
+    /// be satisfied, so woken fibers do not have to re-block.  A waiter
+    /// that has not yet attached a continuation to its future is
+    /// completed in place, without going through the run queue at all.
+    ///
     /// \param nr Number of units to deposit (default 1).
     void signal(size_t nr = 1) noexcept {
         if (_ex) {
@@ -232,9 +335,22 @@ public:
         while (!_wait_list.empty() && has_available_units(_wait_list.front().nr)) {
             auto& x = _wait_list.front();
             _count -= x.nr;
+            if (_priority_inheritance) {
+                _holder_sg = x.sg;
+            }
             x.pr.set_value();
             _wait_list.pop_front();
         }
+        if (_priority_inheritance) {
+            if (_wait_list.empty()) {
+                _max_waiting_shares = 0;
+                unboost();
+            } else {
+                // ownership moved to the last woken waiter's group; re-point
+                // the boost at it on behalf of those still queued
+                boost_holder();
+            }
+        }
     }
 
     /// Consume the specific number of units without blocking
@@ -249,6 +365,7 @@ public:
             return;
         }
         _count -= nr;
+        record_holder();
     }
 
     /// Attempts to reduce the counter value by a specified number of units.
@@ -264,6 +381,7 @@ public:
     bool try_wait(size_t nr = 1) noexcept {
         if (may_proceed(nr)) {
             _count -= nr;
+            record_holder();
             return true;
         } else {
             return false;
@@ -283,6 +401,44 @@ public:
     /// Returns the current number of waiters
     size_t waiters() const noexcept { return _wait_list.size(); }
 
+    /// Returns the highest number of concurrent waiters observed, either
+    /// since the semaphore was constructed or since the last call to
+    /// \ref reset_max_waiters().  Together with \ref waiters() this is
+    /// suitable for feeding wait-queue depth metrics, e.g. around an
+    /// I/O concurrency limiter.
+    size_t max_waiters() const noexcept { return _max_waiters; }
+
+    /// Resets the \ref max_waiters() high watermark to the current
+    /// wait-queue depth, typically after the previous value was sampled
+    /// by a metrics poller.
+    void reset_max_waiters() noexcept { _max_waiters = _wait_list.size(); }
+
+    /// Enables or disables priority inheritance for this semaphore.
+    ///
+    /// When enabled, the scheduling group that most recently took units
+    /// (the presumed holder) has its shares temporarily raised to the
+    /// highest shares among the groups waiting on the semaphore, and
+    /// restored once the wait queue drains.  This counters priority
+    /// inversion: without it, a latency-critical group blocked on a
+    /// semaphore held by a low-shares background group makes progress at
+    /// the holder's pace.
+    ///
+    /// The holder is approximated by the group of the most recent grant,
+    /// which is exact for mutex-like usage (initial count of one); with
+    /// multiple concurrent holders only the latest is boosted.  Do not
+    /// combine with manual \ref scheduling_group::set_shares() adjustments
+    /// of a group while it may be boosted, as the restored value would
+    /// overwrite the manual one.
+    ///
+    /// \param enabled whether to track waiters and boost the holder.
+    void set_priority_inheritance(bool enabled) noexcept {
+        _priority_inheritance = enabled;
+        if (!enabled) {
+            _max_waiting_shares = 0;
+            unboost();
+        }
+    }
+
     /// Signal to waiters that an error occurred.  \ref wait() will see
     /// an exceptional future<> containing a \ref broken_semaphore exception.
     /// The future is made available immediately.
@@ -327,6 +483,10 @@ basic_semaphore<ExceptionFactory, Clock>::broken(std::exception_ptr xp) noexcept
         x.pr.set_exception(xp);
         _wait_list.pop_front();
     }
+    if (_priority_inheritance) {
+        _max_waiting_shares = 0;
+        unboost();
+    }
 }
 
 template<typename ExceptionFactory = semaphore_default_exception_factory, typename Clock = typename timer<>::clock>
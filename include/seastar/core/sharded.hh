@@ -22,15 +22,18 @@
 #pragma once
 
 #include <seastar/core/smp.hh>
+#include <seastar/core/deleter.hh>
 #include <seastar/core/loop.hh>
 #include <seastar/core/map_reduce.hh>
 #include <seastar/util/is_smart_ptr.hh>
 #include <seastar/util/tuple_utils.hh>
 #include <seastar/core/do_with.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/util/concepts.hh>
 #include <seastar/util/log.hh>
 #include <boost/iterator/counting_iterator.hpp>
 #include <functional>
+#include <unordered_map>
 #if __has_include(<concepts>)
 #include <concepts>
 #endif
@@ -59,6 +62,67 @@ using on_each_shard_func = std::function<future<> (unsigned shard)>;
 
 future<> sharded_parallel_for_each(unsigned nr_shards, on_each_shard_func on_each_shard) noexcept(std::is_nothrow_move_constructible_v<on_each_shard_func>);
 
+// Hierarchical reduction over the shard range [first, first + count).
+// Must be called on shard `first`. The range is halved recursively; each
+// half is reduced to a single value on its own first shard, and only that
+// value is forwarded up, so with N shards no shard performs more than
+// O(log N) reduction steps and each intermediate value crosses shards once.
+// `map` is invoked with no arguments on each shard in the range and `reduce`
+// combines two of its results; it must be associative.
+template <typename Value, typename Mapper, typename Reduce>
+future<Value> tree_map_reduce(unsigned first, unsigned count, Mapper map, Reduce reduce) {
+    if (count == 1) {
+        return futurize_invoke(map);
+    }
+    auto half = count / 2;
+    auto right = smp::submit_to(first + half, [first, half, count, map, reduce] () mutable {
+        return tree_map_reduce<Value>(first + half, count - half, std::move(map), std::move(reduce));
+    });
+    return tree_map_reduce<Value>(first, half, map, reduce).then_wrapped([right = std::move(right), reduce] (future<Value> lf) mutable {
+        return right.then_wrapped([lf = std::move(lf), reduce] (future<Value> rf) mutable {
+            if (lf.failed()) {
+                rf.ignore_ready_future();
+                return ::seastar::make_exception_future<Value>(lf.get_exception());
+            }
+            if (rf.failed()) {
+                return ::seastar::make_exception_future<Value>(rf.get_exception());
+            }
+            return futurize_invoke(reduce, lf.get0(), rf.get0());
+        });
+    });
+}
+
+// Submits `func` to every shard in [first, first + count), relaying through
+// intermediate shards: the range is halved recursively and the right half is
+// handed to its own first shard. With N shards no single shard performs more
+// than O(log N) submissions, and completion messages merge on the way back
+// up instead of all landing in the caller's queue; compare with
+// sharded_parallel_for_each(), where the caller submits to every shard
+// directly. All shards are waited for even if some fail; the first failure
+// in range order is reported.
+template <typename Func>
+future<> tree_submit_to_all(smp_submit_to_options options, unsigned first, unsigned count, Func func) {
+    if (count == 0) {
+        return make_ready_future<>();
+    }
+    if (count == 1) {
+        return smp::submit_to(first, options, std::move(func));
+    }
+    auto half = count / 2;
+    auto right = smp::submit_to(first + half, options, [options, first, half, count, func] () mutable {
+        return tree_submit_to_all(options, first + half, count - half, std::move(func));
+    });
+    return tree_submit_to_all(options, first, half, func).then_wrapped([right = std::move(right)] (future<> lf) mutable {
+        return right.then_wrapped([lf = std::move(lf)] (future<> rf) mutable {
+            if (lf.failed()) {
+                rf.ignore_ready_future();
+                return std::move(lf);
+            }
+            return rf;
+        });
+    });
+}
+
 }
 
 /// \addtogroup smp-module
@@ -107,6 +171,28 @@ public:
 };
 
 
+/// \brief Give a sharded service a per-shard gate, closed by \ref sharded::stop()
+///
+/// If a service class inherits from this, it gains a per-shard \ref gate
+/// for tracking in-progress requests, accessible via \code service_gate()
+/// \endcode or the \code hold_gate() \endcode shorthand. \ref sharded::stop()
+/// closes the gate on every shard and waits for requests that entered it to
+/// drain before invoking the service's own \c stop() method (if it has one),
+/// so a service that only needs a gate to drain its requests does not need
+/// to define \c stop() at all, or to wrap a gate of its own.
+class gated_sharded_service {
+    gate _gate;
+public:
+    /// The per-shard request gate.
+    gate& service_gate() noexcept { return _gate; }
+    const gate& service_gate() const noexcept { return _gate; }
+    /// Enters the per-shard gate, returning a \ref gate::holder that
+    /// leaves it when destroyed. Shorthand for `service_gate().hold()`.
+    gate::holder hold_gate() {
+        return _gate.hold();
+    }
+};
+
 /// Exception thrown when a \ref sharded object does not exist
 class no_sharded_instance_exception : public std::exception {
     sstring _msg;
@@ -119,6 +205,22 @@ public:
     }
 };
 
+/// Controls how many instances of a service \ref sharded::start() creates
+/// and which shards share each of them.
+///
+/// A shared instance is owned by one shard of its group; the other shards
+/// get plain-pointer access to it through \ref sharded::local() and should
+/// treat it as read-mostly, routing modifications to the owning shard with
+/// \ref sharded::invoke_on_owner(). This avoids duplicating a large,
+/// rarely-written state (dictionaries, compiled rules) once per shard.
+enum class instantiation_policy {
+    per_shard, //!< one instance per logical core; the default
+    /// one instance per NUMA node, owned by the lowest-numbered shard of
+    /// the node and shared by the node's other shards
+    per_numa,
+    singleton, //!< a single instance, owned by shard 0 and shared by all shards
+};
+
 /// Template helper to distribute a service across all logical cores.
 ///
 /// The \c sharded template manages a sharded service, by creating
@@ -135,12 +237,22 @@ class sharded {
         promise<> freed;
     };
     std::vector<entry> _instances;
+    // With a shared instantiation policy, maps each shard to the shard
+    // owning the instance it uses, and to a plain pointer to that
+    // instance; empty when every shard owns its own instance.
+    std::vector<unsigned> _owners;
+    std::vector<Service*> _views;
 private:
     using invoke_on_all_func_type = std::function<future<> (Service&)>;
 private:
     void service_deleted() noexcept {
         _instances[this_shard_id()].freed.set_value();
     }
+
+    // does the calling shard own the instance it uses?
+    bool owns_local_instance() const noexcept {
+        return _owners.empty() || _owners[this_shard_id()] == this_shard_id();
+    }
     template <typename U, bool async>
     friend struct shared_ptr_make_helper;
 
@@ -181,6 +293,26 @@ public:
     template <typename... Args>
     future<> start(Args&&... args) noexcept;
 
+    /// Starts \c Service with the given \ref instantiation_policy.
+    ///
+    /// With \c per_shard this is equivalent to the plain \ref start().
+    /// With \c per_numa or \c singleton, an instance is constructed only
+    /// on the owning shard of each shard group, and the group's other
+    /// shards access it through \ref local() as read-mostly shared state,
+    /// routing modifications to the owner with \ref invoke_on_owner().
+    ///
+    /// With a shared policy, \ref local_shared() and the \c map() /
+    /// \c map_reduce() family remain limited to owning shards, and
+    /// \ref invoke_on_all() runs the function once per instance, on its
+    /// owning shard.
+    ///
+    /// \param policy how many instances to create and who shares them
+    /// \param args Arguments to be forwarded to \c Service constructor
+    /// \return a \ref seastar::future<> that becomes ready when all instances have been
+    ///         constructed.
+    template <typename... Args>
+    future<> start(instantiation_policy policy, Args&&... args) noexcept;
+
     /// Starts \c Service by constructing an instance on a single logical core
     /// with a copy of \c args passed to the constructor.
     ///
@@ -200,6 +332,11 @@ public:
     /// The return value becomes ready when all instances have processed
     /// the message.
     ///
+    /// The submissions fan out through intermediate shards in a tree, so
+    /// the calling shard performs O(log N) submissions rather than one per
+    /// shard, and completions merge on the way back instead of all landing
+    /// in the caller's queue.
+    ///
     /// \param options the options to forward to the \ref smp::submit_to()
     ///         called behind the scenes.
     /// \param func Function to be invoked on all shards
@@ -219,6 +356,33 @@ public:
       }
     }
 
+    /// Invoke a batch of type-erased functions on all instances of
+    /// `Service`, moving the whole batch to every shard in a single
+    /// message. The functions are applied in order on each shard.
+    ///
+    /// This is cheaper than calling \ref invoke_on_all() once per function
+    /// when propagating a set of updates, since each shard is crossed once
+    /// for the whole batch.
+    ///
+    /// \param options the options to forward to the \ref smp::submit_to()
+    ///         called behind the scenes.
+    /// \param funcs Functions to be invoked, in order, on all shards
+    /// \return Future that becomes ready once all calls have completed
+    future<> invoke_on_all_batch(smp_submit_to_options options, std::vector<std::function<future<> (Service&)>> funcs) noexcept;
+
+    /// Invoke a batch of type-erased functions on all instances of
+    /// `Service`, moving the whole batch to every shard in a single
+    /// message.
+    /// Passes the default \ref smp_submit_to_options to the
+    /// \ref smp::submit_to() called behind the scenes.
+    future<> invoke_on_all_batch(std::vector<std::function<future<> (Service&)>> funcs) noexcept {
+      try {
+        return invoke_on_all_batch(smp_submit_to_options{}, std::move(funcs));
+      } catch (...) {
+        return current_exception_as_future();
+      }
+    }
+
     /// Invoke a function on all instances of `Service`.
     /// The return value becomes ready when all instances have processed
     /// the message. The function can be a member pointer to function,
@@ -363,6 +527,52 @@ public:
                             std::move(reduce));
     }
 
+    /// Applies a map function to all shards, then reduces the output hierarchically.
+    ///
+    /// Unlike \ref map_reduce0, which reduces all per-shard results on the
+    /// calling shard one by one, the shard range is split in half recursively
+    /// and each half is combined on its own first shard before being forwarded,
+    /// so with N shards the calling shard performs O(log N) reduction steps
+    /// instead of N. This matters when intermediate values are large or \c
+    /// reduce is expensive. Since shards are numbered contiguously per package,
+    /// the lower levels of the tree stay within a NUMA node and only the top
+    /// levels cross nodes.
+    ///
+    /// \param map callable with the signature `Value (Service&)` or
+    ///               `future<Value> (Service&)` (for some `Value` type).
+    /// \param initial initial value, reduced once with the combined result.
+    /// \param reduce binary function combining two `Value`s into a `Value`;
+    ///               must be associative, as the combining order is not the
+    ///               left-fold of \ref map_reduce0. It runs on intermediate
+    ///               shards, not only on the caller's.
+    ///
+    /// Each \c map invocation runs on the shard associated with the service.
+    ///
+    /// \tparam  Mapper unary function taking `Service&` and producing a `Value`.
+    /// \tparam  Initial any value type reducible with a `Value`.
+    /// \tparam  Reduce a binary function taking two `Value`s and returning a `Value`.
+    /// \return  Result of reducing `map` of each instance, combined pairwise.
+    template <typename Mapper, typename Initial, typename Reduce,
+              typename Future = futurize_t<std::result_of_t<Mapper(Service&)>>,
+              typename Value = decltype(internal::untuple(std::declval<typename Future::tuple_type>()))>
+    inline
+    future<Initial>
+    map_reduce0_tree(Mapper map, Initial initial, Reduce reduce) {
+        if (_instances.empty()) {
+            return make_ready_future<Initial>(std::move(initial));
+        }
+        auto wrapped_map = [this, map] {
+            auto inst = get_local_service();
+            return map(*inst);
+        };
+        auto nr = unsigned(_instances.size());
+        return smp::submit_to(0, [nr, map = std::move(wrapped_map), reduce] () mutable {
+            return internal::tree_map_reduce<Value>(0, nr, std::move(map), std::move(reduce));
+        }).then([initial = std::move(initial), reduce] (Value v) mutable {
+            return make_ready_future<Initial>(reduce(std::move(initial), std::move(v)));
+        });
+    }
+
     /// Applies a map function to all shards, and return a vector of the result.
     ///
     /// \param mapper callable with the signature `Value (Service&)` or
@@ -427,13 +637,68 @@ public:
         return invoke_on(id, smp_submit_to_options(), std::forward<Func>(func), std::forward<Args>(args)...);
     }
 
-    /// Gets a reference to the local instance.
+    /// The shard owning the instance that serves shard \c shard.
+    ///
+    /// This is \c shard itself unless the service was started with a
+    /// shared \ref instantiation_policy, in which case it is the shard
+    /// the group's instance was constructed on; use it as the target of
+    /// \ref invoke_on() when a call must run on the owning shard.
+    unsigned owner_shard(unsigned shard = this_shard_id()) const noexcept {
+        if (!_owners.empty()) {
+            return _owners[shard];
+        }
+        // start_single() places the only instance on shard 0
+        return _instances.size() == 1 ? 0 : shard;
+    }
+
+    /// Invoke a callable on the instance serving the calling shard, on
+    /// the shard owning that instance.
+    ///
+    /// With a shared \ref instantiation_policy this is how modifications
+    /// reach the instance without racing with the shards reading it; with
+    /// per-shard instantiation it runs on the calling shard.
+    ///
+    /// \param options the options to forward to the \ref smp::submit_to()
+    ///         called behind the scenes.
+    /// \param func a callable with signature `Value (Service&, Args...)` or
+    ///        `future<Value> (Service&, Args...)` (for some `Value` type), or a pointer
+    ///        to a member function of Service
+    /// \param args parameters to the callable; will be copied or moved. To pass by reference,
+    ///              use std::ref().
+    ///
+    /// \return result of calling `func(instance)` on the owning shard
+    template <typename Func, typename... Args, typename Ret = futurize_t<std::invoke_result_t<Func, Service&, Args...>>>
+    SEASTAR_CONCEPT(requires std::invocable<Func, Service&, Args&&...>)
+    Ret
+    invoke_on_owner(smp_submit_to_options options, Func&& func, Args&&... args) {
+        return invoke_on(owner_shard(), options, std::forward<Func>(func), std::forward<Args>(args)...);
+    }
+
+    /// Invoke a callable on the instance serving the calling shard, on
+    /// the shard owning that instance.
+    ///
+    /// Passes the default \ref smp_submit_to_options to the
+    /// \ref smp::submit_to() called behind the scenes.
+    template <typename Func, typename... Args, typename Ret = futurize_t<std::invoke_result_t<Func, Service&, Args...>>>
+    SEASTAR_CONCEPT(requires std::invocable<Func, Service&, Args&&...>)
+    Ret
+    invoke_on_owner(Func&& func, Args&&... args) {
+        return invoke_on_owner(smp_submit_to_options(), std::forward<Func>(func), std::forward<Args>(args)...);
+    }
+
+    /// Gets a reference to the instance serving the local shard. With a
+    /// shared \ref instantiation_policy this may be an instance owned by
+    /// another shard of the group; treat it as read-only and route
+    /// modifications through \ref invoke_on_owner().
     const Service& local() const noexcept;
 
-    /// Gets a reference to the local instance.
+    /// Gets a reference to the instance serving the local shard (see the
+    /// const overload for the shared-instance caveats).
     Service& local() noexcept;
 
-    /// Gets a shared pointer to the local instance.
+    /// Gets a shared pointer to the local instance. Valid only on shards
+    /// that own their instance, as the pointer's reference count may not
+    /// be touched from other shards.
     shared_ptr<Service> local_shared() noexcept;
 
     /// Checks whether the local instance has been initialized.
@@ -592,6 +857,57 @@ sharded<Service>::start(Args&&... args) noexcept {
   }
 }
 
+template <typename Service>
+template <typename... Args>
+future<>
+sharded<Service>::start(instantiation_policy policy, Args&&... args) noexcept {
+    if (policy == instantiation_policy::per_shard) {
+        return start(std::forward<Args>(args)...);
+    }
+  try {
+    assert(_instances.empty());
+    _instances.resize(smp::count);
+    _owners.resize(smp::count);
+    _views.resize(smp::count);
+    if (policy == instantiation_policy::per_numa) {
+        std::unordered_map<unsigned, unsigned> first_shard_on_node;
+        for (shard_id s = 0; s < smp::count; s++) {
+            _owners[s] = first_shard_on_node.try_emplace(smp::numa_node_of_shard(s), s).first->second;
+        }
+    } // else singleton: every shard is served by shard 0
+    return sharded_parallel_for_each(
+        [this, args = std::make_tuple(std::forward<Args>(args)...)] (unsigned c) mutable {
+            return smp::submit_to(c, [this, args] () mutable {
+                if (!owns_local_instance()) {
+                    return;
+                }
+                _instances[this_shard_id()].service = std::apply([this] (Args... args) {
+                    return create_local_service(internal::unwrap_sharded_arg(std::forward<Args>(args))...);
+                }, args);
+            });
+    }).then([this] {
+        // every shard picks up a plain pointer to the instance it shares;
+        // the owning reference stays with the owning shard's entry
+        return sharded_parallel_for_each([this] (unsigned c) {
+            return smp::submit_to(c, [this] {
+                _views[this_shard_id()] = _instances[_owners[this_shard_id()]].service.get();
+            });
+        });
+    }).then_wrapped([this] (future<> f) {
+        try {
+            f.get();
+            return make_ready_future<>();
+        } catch (...) {
+            return this->stop().then([e = std::current_exception()] () mutable {
+                std::rethrow_exception(e);
+            });
+        }
+    });
+  } catch (...) {
+    return current_exception_as_future();
+  }
+}
+
 template <typename Service>
 template <typename... Args>
 future<>
@@ -664,7 +980,14 @@ inline
 future<>
 stop_sharded_instance(Service& instance) {
     constexpr bool has_stop = internal::sharded_has_stop::check<Service>(0);
-    return internal::sharded_call_stop<has_stop>::call(instance);
+    if constexpr (std::is_base_of_v<gated_sharded_service, Service>) {
+        // Drain requests tracked by the service's gate before stopping it.
+        return instance.service_gate().close().then([&instance] {
+            return internal::sharded_call_stop<has_stop>::call(instance);
+        });
+    } else {
+        return internal::sharded_call_stop<has_stop>::call(instance);
+    }
 }
 
 }
@@ -693,6 +1016,8 @@ sharded<Service>::stop() noexcept {
         }).finally([this, fut = std::move(fut)] () mutable {
             _instances.clear();
             _instances = std::vector<sharded<Service>::entry>();
+            _owners = std::vector<unsigned>();
+            _views = std::vector<Service*>();
             return std::move(fut);
         });
     });
@@ -705,9 +1030,30 @@ template <typename Service>
 future<>
 sharded<Service>::invoke_on_all(smp_submit_to_options options, std::function<future<> (Service&)> func) noexcept {
   try {
-    return sharded_parallel_for_each([this, options, func = std::move(func)] (unsigned c) {
-        return smp::submit_to(c, options, [this, func] {
-            return func(*get_local_service());
+    return internal::tree_submit_to_all(options, 0, _instances.size(), [this, func = std::move(func)] {
+        if (!owns_local_instance()) {
+            // a shared instance runs the function once, on its owning shard
+            return make_ready_future<>();
+        }
+        return func(*get_local_service());
+    });
+  } catch (...) {
+    return current_exception_as_future();
+  }
+}
+
+template <typename Service>
+future<>
+sharded<Service>::invoke_on_all_batch(smp_submit_to_options options, std::vector<std::function<future<> (Service&)>> funcs) noexcept {
+  try {
+    return internal::tree_submit_to_all(options, 0, _instances.size(), [this, funcs = std::move(funcs)] () mutable {
+        if (!owns_local_instance()) {
+            return make_ready_future<>();
+        }
+        return do_with(std::move(funcs), [this] (std::vector<invoke_on_all_func_type>& funcs) {
+            return do_for_each(funcs, [this] (invoke_on_all_func_type& func) {
+                return func(*get_local_service());
+            });
         });
     });
   } catch (...) {
@@ -752,12 +1098,18 @@ sharded<Service>::invoke_on_others(smp_submit_to_options options, Func func, Arg
 template <typename Service>
 const Service& sharded<Service>::local() const noexcept {
     assert(local_is_initialized());
+    if (!_views.empty()) {
+        return *_views[this_shard_id()];
+    }
     return *_instances[this_shard_id()].service;
 }
 
 template <typename Service>
 Service& sharded<Service>::local() noexcept {
     assert(local_is_initialized());
+    if (!_views.empty()) {
+        return *_views[this_shard_id()];
+    }
     return *_instances[this_shard_id()].service;
 }
 
@@ -769,6 +1121,9 @@ shared_ptr<Service> sharded<Service>::local_shared() noexcept {
 
 template <typename Service>
 inline bool sharded<Service>::local_is_initialized() const noexcept {
+    if (!_views.empty()) {
+        return _views.size() > this_shard_id() && _views[this_shard_id()];
+    }
     return _instances.size() > this_shard_id() &&
            _instances[this_shard_id()].service;
 }
@@ -896,8 +1251,76 @@ public:
     void reset(std::nullptr_t = nullptr) noexcept(std::is_nothrow_default_constructible_v<PtrType>) {
         reset(PtrType());
     }
+    /// Destroys a group of foreign pointers with at most one cross-shard
+    /// message per owner shard.
+    ///
+    /// Equivalent to destroying each pointer individually, but when the
+    /// pointers share owner shards this sends far fewer messages. See
+    /// \ref foreign_destruction_batch.
+    static void release_batch(std::vector<foreign_ptr> ptrs);
+};
+
+/// Batches the destruction of objects wrapped in \ref foreign_ptr.
+///
+/// Destroying a \ref foreign_ptr sends one message to the owner shard, so
+/// tearing down state that borrowed many foreign objects at once floods
+/// the cross-shard message queues. A \c foreign_destruction_batch instead
+/// collects the wrapped objects in a buffer per owner shard;
+/// \ref flush(), also called by the destructor, destroys each shard's
+/// buffer with a single message.
+class foreign_destruction_batch {
+    std::vector<deleter> _buffers = std::vector<deleter>(smp::count);
+public:
+    foreign_destruction_batch() = default;
+    foreign_destruction_batch(foreign_destruction_batch&&) = default;
+    foreign_destruction_batch(const foreign_destruction_batch&) = delete;
+    foreign_destruction_batch& operator=(foreign_destruction_batch&&) = default;
+    foreign_destruction_batch& operator=(const foreign_destruction_batch&) = delete;
+    ~foreign_destruction_batch() {
+        flush();
+    }
+    /// Takes ownership of \c ptr's wrapped object, deferring its
+    /// destruction to the next \ref flush(). An object owned by the
+    /// current shard is destroyed immediately instead.
+    template <typename PtrType>
+    void add(foreign_ptr<PtrType> ptr) {
+        if (!ptr) {
+            return;
+        }
+        auto cpu = ptr.get_owner_shard();
+        auto value = ptr.release();
+        if (cpu != this_shard_id()) {
+            _buffers[cpu].append(make_object_deleter(std::move(value)));
+        }
+        // otherwise, value's destructor runs here and now
+    }
+    /// Destroys everything collected so far, sending one message per
+    /// owner shard with pending objects.
+    void flush() noexcept {
+        for (unsigned cpu = 0; cpu != _buffers.size(); ++cpu) {
+            if (_buffers[cpu]) {
+                // As with ~foreign_ptr(), the callers have no way to
+                // wait for this future.
+                (void)smp::submit_to(cpu, [d = std::move(_buffers[cpu])] () mutable {
+                    // Destroy the buffer explicitly in the current
+                    // shard; the lambda itself is destroyed in the
+                    // shard that submitted the task.
+                    d = deleter();
+                });
+            }
+        }
+    }
 };
 
+template <typename PtrType>
+inline
+void foreign_ptr<PtrType>::release_batch(std::vector<foreign_ptr> ptrs) {
+    foreign_destruction_batch batch;
+    for (auto& p : ptrs) {
+        batch.add(std::move(p));
+    }
+}
+
 /// Wraps a raw or smart pointer object in a \ref foreign_ptr<>.
 ///
 /// \relates foreign_ptr
@@ -24,6 +24,8 @@
 
 #include <seastar/core/future.hh>
 #include <seastar/core/expiring_fifo.hh>
+#include <boost/intrusive/list.hpp>
+#include <memory>
 
 namespace seastar {
 
@@ -108,11 +110,38 @@ private:
 
     /// \cond internal
     class shared_state : public enable_lw_shared_from_this<shared_state> {
+        // A waiter is a single small heap node holding the peer promise and
+        // linking itself intrusively into the wait list, so broadcasting the
+        // result is one walk over the list with no container bookkeeping.
+        // Only waiters with a timeout carry a timer (see expiring_waiter);
+        // a timed-out waiter unlinks and frees itself in O(1) instead of
+        // lingering in the middle of a fifo until it drains to the front.
+        struct waiter : public boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
+            promise_type pr;
+            virtual ~waiter() = default;
+        };
+        struct expiring_waiter final : waiter {
+            timer<clock> tr;
+            explicit expiring_waiter(time_point timeout)
+                    : tr([this] {
+                        promise_expiry{}(this->pr);
+                        delete this; // the auto_unlink hook removes us from the wait list
+                    }) {
+                tr.arm(timeout);
+            }
+        };
+        using waiter_list_type = boost::intrusive::list<waiter, boost::intrusive::constant_time_size<false>>;
+
         future_type _original_future;
-        expiring_fifo<promise_type, promise_expiry, clock> _peers;
+        waiter_list_type _waiters;
 
     public:
         ~shared_state() {
+            // Destroying the promises signals broken_promise to any peers
+            // still waiting, same as dropping a plain promise would.
+            _waiters.clear_and_dispose([] (waiter* w) noexcept {
+                delete w;
+            });
             // Don't warn if the shared future is exceptional. Any
             // warnings will be reported by the futures returned by
             // get_future.
@@ -125,41 +154,45 @@ private:
             _original_future = std::move(f);
             auto& state = _original_future._state;
             if (_original_future.failed()) {
-                while (_peers) {
-                    _peers.front().set_exception(state.get_exception());
-                    _peers.pop_front();
-                }
+                _waiters.clear_and_dispose([&] (waiter* w) noexcept {
+                    w->pr.set_exception(state.get_exception());
+                    delete w;
+                });
             } else {
-                while (_peers) {
-                    auto& p = _peers.front();
+                _waiters.clear_and_dispose([&] (waiter* w) noexcept {
                     try {
-                        p.set_value(state.get_value());
+                        w->pr.set_value(state.get_value());
                     } catch (...) {
-                        p.set_exception(std::current_exception());
+                        w->pr.set_exception(std::current_exception());
                     }
-                    _peers.pop_front();
-                }
+                    delete w;
+                });
             }
         }
 
         future_type get_future(time_point timeout = time_point::max()) noexcept {
             // Note that some functions called below may throw,
-            // like pushing to _peers or copying _original_future's ready value.
+            // like allocating the waiter or copying _original_future's ready value.
             // We'd rather terminate than propagate these errors similar to
             // .then()'s failure to allocate a continuation as the caller cannot
             // distinguish between an error returned by the original future to
             // failing to perform `get_future` itself.
             memory::scoped_critical_alloc_section _;
             if (!_original_future.available()) {
-                promise_type p;
-                auto f = p.get_future();
+                std::unique_ptr<waiter> w;
+                if (timeout == time_point::max()) {
+                    w = std::make_unique<waiter>();
+                } else {
+                    w = std::make_unique<expiring_waiter>(timeout);
+                }
+                auto f = w->pr.get_future();
                 if (_original_future._state.valid()) {
                     // _original_future's result is forwarded to each peer.
                     (void)_original_future.then_wrapped([s = this->shared_from_this()] (future_type&& f) mutable {
                         s->resolve(std::move(f));
                     });
                 }
-                _peers.push_back(std::move(p), timeout);
+                _waiters.push_back(*w.release());
                 return f;
             } else if (_original_future.failed()) {
                 return future_type(exception_future_marker(), std::exception_ptr(_original_future._state.get_exception()));
@@ -0,0 +1,252 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#pragma once
+
+#include <seastar/core/cacheline.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/smp.hh>
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace seastar {
+
+/// \addtogroup smp-module
+/// @{
+
+/// A single-producer publication of an immutable value to all shards.
+///
+/// The usual way to distribute a routing table or schema object is to
+/// copy it to every shard with \ref sharded::invoke_on_all(), paying for
+/// the copy in memory and propagation time once per shard. Since all
+/// shards run in one address space, the pages of an object that is never
+/// modified after construction can simply be read in place; what needs
+/// managing is its lifetime, because the non-atomic \ref shared_ptr
+/// reference counts cannot be shared between shards.
+///
+/// \c shared_snapshot keeps exactly one copy of the value, owned by the
+/// shard that called \ref publish(). Each shard reads it through a
+/// \ref handle, which pins the value with a counter private to that
+/// shard -- the read side never writes a cache line another shard
+/// touches. When a new value is published, the old one is retired and
+/// reclaimed only after every shard has dropped its last handle to it,
+/// so readers holding a handle across yields keep a stable view while
+/// new readers immediately see the new value.
+///
+/// The object must be created on the publishing shard, \ref publish()
+/// and \ref stop() may only be called there, and each \ref handle must
+/// be released on the shard that obtained it. A publish must complete
+/// before the next one starts. \ref stop() must be called (and waited
+/// for) before destruction; it resolves when every shard has dropped
+/// its handles.
+///
+/// Note that the single copy is allocated from the publishing shard's
+/// memory, so on a multi-socket machine shards on other NUMA nodes read
+/// it remotely; that is usually still a large win over one copy per
+/// shard for big, rarely-accessed-in-bulk state.
+template <typename T>
+class shared_snapshot {
+    struct version {
+        // outstanding read handles, one slot per shard; a slot is only
+        // ever touched by its shard and sits on its own cache line so
+        // the read side does not bounce lines between shards
+        struct alignas(cache_line_size) per_shard_count {
+            long refs = 0;
+            bool retired = false;
+        };
+        std::unique_ptr<const T> value;
+        std::vector<per_shard_count> counts;
+        shared_snapshot* parent;
+        // shards that have not yet drained their handles; owner shard only
+        unsigned undrained;
+
+        version(shared_snapshot* parent, std::unique_ptr<const T> value)
+            : value(std::move(value))
+            , counts(smp::count)
+            , parent(parent)
+            , undrained(smp::count) {
+        }
+
+        // called by a shard that retired its slot and dropped the last
+        // handle; bookkeeping runs on the owner shard
+        void notify_drained() noexcept {
+            (void)smp::submit_to(parent->_owner_shard, [this] {
+                parent->on_version_drained(this);
+            });
+        }
+    };
+
+    unsigned _owner_shard;
+    // slot s is read and written only by shard s
+    std::vector<version*> _current;
+    // the fields below are used on the owner shard only
+    uint64_t _live_versions = 0;
+    bool _switching = false;
+    std::optional<promise<>> _all_drained;
+
+public:
+    /// A shard-local, pinned view of the published value.
+    ///
+    /// Holding a handle keeps the version it refers to alive, including
+    /// across republishes; copying and releasing it touch only memory
+    /// private to the current shard. It must be released on the shard it
+    /// was obtained on.
+    class handle {
+        version* _v = nullptr;
+
+        explicit handle(version* v) noexcept : _v(v) {
+            if (_v) {
+                _v->counts[this_shard_id()].refs++;
+            }
+        }
+        void release() noexcept {
+            if (_v) {
+                auto& c = _v->counts[this_shard_id()];
+                if (--c.refs == 0 && c.retired) {
+                    _v->notify_drained();
+                }
+                _v = nullptr;
+            }
+        }
+        friend class shared_snapshot;
+    public:
+        handle() = default;
+        handle(const handle& o) noexcept : handle(o._v) {}
+        handle(handle&& o) noexcept : _v(std::exchange(o._v, nullptr)) {}
+        handle& operator=(const handle& o) noexcept {
+            if (this != &o) {
+                release();
+                _v = o._v;
+                if (_v) {
+                    _v->counts[this_shard_id()].refs++;
+                }
+            }
+            return *this;
+        }
+        handle& operator=(handle&& o) noexcept {
+            if (this != &o) {
+                release();
+                _v = std::exchange(o._v, nullptr);
+            }
+            return *this;
+        }
+        ~handle() {
+            release();
+        }
+        /// Does the handle refer to a published value?
+        explicit operator bool() const noexcept {
+            return _v != nullptr;
+        }
+        const T& operator*() const noexcept {
+            return *_v->value;
+        }
+        const T* operator->() const noexcept {
+            return _v->value.get();
+        }
+    };
+
+    shared_snapshot() : _owner_shard(this_shard_id()), _current(smp::count, nullptr) {
+    }
+    shared_snapshot(const shared_snapshot&) = delete;
+    shared_snapshot& operator=(const shared_snapshot&) = delete;
+    ~shared_snapshot() {
+        assert(_live_versions == 0);
+    }
+
+    /// Publishes a new value, replacing the current one.
+    ///
+    /// The returned future resolves when every shard sees the new value;
+    /// the previous value is reclaimed in the background once the
+    /// handles still pinning it are released. May only be called on the
+    /// owner shard, and not before a previous publish resolved.
+    future<> publish(std::unique_ptr<const T> value) {
+        assert(this_shard_id() == _owner_shard);
+        assert(!_switching);
+        _switching = true;
+        auto v = new version(this, std::move(value));
+        _live_versions++;
+        return smp::invoke_on_all([this, v] {
+            if (auto old = std::exchange(_current[this_shard_id()], v)) {
+                retire_local(old);
+            }
+        }).finally([this] {
+            _switching = false;
+        });
+    }
+
+    /// Publishes a new value constructed from \c value.
+    future<> publish(T value) {
+        return publish(std::make_unique<const T>(std::move(value)));
+    }
+
+    /// Gets a pinned view of the current value, as seen by the calling
+    /// shard. The handle is disengaged when nothing was published yet.
+    handle read() const noexcept {
+        return handle(_current[this_shard_id()]);
+    }
+
+    /// Retires the current value and waits for all shards to drop their
+    /// handles to it and to any older, still-pinned values. May only be
+    /// called on the owner shard.
+    future<> stop() {
+        assert(this_shard_id() == _owner_shard);
+        assert(!_switching);
+        return smp::invoke_on_all([this] {
+            if (auto old = std::exchange(_current[this_shard_id()], nullptr)) {
+                retire_local(old);
+            }
+        }).then([this] {
+            if (_live_versions == 0) {
+                return make_ready_future<>();
+            }
+            _all_drained.emplace();
+            return _all_drained->get_future();
+        });
+    }
+
+private:
+    // the calling shard stops handing out handles to v; runs once per
+    // shard per version
+    void retire_local(version* v) noexcept {
+        auto& c = v->counts[this_shard_id()];
+        c.retired = true;
+        if (c.refs == 0) {
+            v->notify_drained();
+        }
+    }
+
+    void on_version_drained(version* v) noexcept {
+        if (--v->undrained > 0) {
+            return;
+        }
+        delete v;
+        if (--_live_versions == 0 && _all_drained) {
+            _all_drained->set_value();
+        }
+    }
+};
+
+/// @}
+
+}
@@ -118,6 +118,21 @@ public:
         _free_objects.push_back(reinterpret_cast<uintptr_t>(object));
     }
 
+    // Rebind this (completely free) slab page to another slab class,
+    // rebuilding the free object list for the new object size. The first
+    // object is left out, as the caller hands it out immediately.
+    void reinitialize(size_t objects, size_t object_size, uint8_t slab_class_id) {
+        assert(_refcnt == 0);
+        _slab_class_id = slab_class_id;
+        _free_objects.clear();
+        _free_objects.reserve(objects - 1);
+        auto object = reinterpret_cast<uintptr_t>(_slab_page);
+        for (auto i = 1u; i < objects; i++) {
+            object += object_size;
+            _free_objects.push_back(object);
+        }
+    }
+
     template<typename Item>
     friend class slab_class;
     template<typename Item>
@@ -126,6 +141,7 @@ public:
 
 class slab_item_base {
     boost::intrusive::list_member_hook<> _lru_link;
+    bool _lru_hot = false; // which LRU segment the item lives in
 
     template<typename Item>
     friend class slab_class;
@@ -134,33 +150,55 @@ class slab_item_base {
 template<typename Item>
 class slab_class {
 private:
+    using lru_type = boost::intrusive::list<slab_item_base,
+        boost::intrusive::member_hook<slab_item_base, boost::intrusive::list_member_hook<>,
+        &slab_item_base::_lru_link>>;
+
     boost::intrusive::list<slab_page_desc,
         boost::intrusive::member_hook<slab_page_desc, boost::intrusive::list_member_hook<>,
         &slab_page_desc::_free_pages_link>> _free_slab_pages;
-    boost::intrusive::list<slab_item_base,
-        boost::intrusive::member_hook<slab_item_base, boost::intrusive::list_member_hook<>,
-        &slab_item_base::_lru_link>> _lru;
+    //
+    // Segmented LRU: items start out in the cold segment and are promoted
+    // to the hot one on their first hit. Hits on hot items don't touch the
+    // list at all, so hot items cause no churn; the hot segment is instead
+    // trimmed from its tail whenever a promotion grows it past the cold one.
+    // Eviction takes from the cold tail first.
+    //
+    lru_type _hot_lru;
+    lru_type _cold_lru;
+    size_t _nr_hot = 0;
+    size_t _nr_cold = 0;
     size_t _size; // size of objects
+    size_t _nr_pages = 0;
+    size_t _nr_objects = 0;
+    uint64_t _evictions = 0;
     uint8_t _slab_class_id;
 private:
     template<typename... Args>
     inline
     Item* create_item(void *object, uint32_t slab_page_index, Args&&... args) {
         Item *new_item = new(object) Item(slab_page_index, std::forward<Args>(args)...);
-        _lru.push_front(reinterpret_cast<slab_item_base&>(*new_item));
+        auto& item_ref = reinterpret_cast<slab_item_base&>(*new_item);
+        item_ref._lru_hot = false;
+        _cold_lru.push_front(item_ref);
+        _nr_cold++;
+        _nr_objects++;
         return new_item;
     }
 
     inline
     std::pair<void *, uint32_t> evict_lru_item(std::function<void (Item& item_ref)>& erase_func) {
-        if (_lru.empty()) {
+        auto& lru = !_cold_lru.empty() ? _cold_lru : _hot_lru;
+        if (lru.empty()) {
             return { nullptr, 0U };
         }
 
-        Item& victim = reinterpret_cast<Item&>(_lru.back());
+        Item& victim = reinterpret_cast<Item&>(lru.back());
         uint32_t index = victim.get_slab_page_index();
         assert(victim.is_unlocked());
-        _lru.erase(_lru.iterator_to(reinterpret_cast<slab_item_base&>(victim)));
+        remove_item_from_lru(&victim);
+        _evictions++;
+        _nr_objects--;
         // WARNING: You need to make sure that erase_func will not release victim back to slab.
         erase_func(victim);
 
@@ -175,7 +213,8 @@ public:
     slab_class(slab_class&&) = default;
     ~slab_class() {
         _free_slab_pages.clear();
-        _lru.clear();
+        _hot_lru.clear();
+        _cold_lru.clear();
     }
 
     size_t size() const {
@@ -187,7 +226,19 @@ public:
     }
 
     bool has_no_slab_pages() const {
-        return _lru.empty();
+        return _nr_pages == 0;
+    }
+
+    size_t nr_pages() const {
+        return _nr_pages;
+    }
+
+    size_t nr_objects() const {
+        return _nr_objects;
+    }
+
+    uint64_t evictions() const {
+        return _evictions;
     }
 
     template<typename... Args>
@@ -226,11 +277,41 @@ public:
 
         _free_slab_pages.push_front(*desc);
         insert_slab_page_desc(*desc);
+        _nr_pages++;
 
         // first object from the allocated slab page is returned.
         return create_item(slab_page, slab_page_index, std::forward<Args>(args)...);
     }
 
+    template<typename... Args>
+    Item *create_from_rebalanced_page(uint64_t max_object_size, slab_page_desc& desc, Args&&... args) {
+        auto objects = max_object_size / _size;
+        desc.reinitialize(objects, _size, _slab_class_id);
+        _free_slab_pages.push_front(desc);
+        _nr_pages++;
+
+        // first object from the rebalanced slab page is returned.
+        return create_item(desc.slab_page(), desc.index(), std::forward<Args>(args)...);
+    }
+
+    /*
+     * Detach a completely free slab page from this class, if it has one, so
+     * that the page can be rebalanced into a class which ran out of memory.
+     */
+    slab_page_desc* try_release_empty_page(uint64_t max_object_size) {
+        if (_free_slab_pages.empty()) {
+            return nullptr;
+        }
+        // completely free pages are kept at the front of the list.
+        auto& desc = _free_slab_pages.front();
+        if (desc.size() != max_object_size / _size) {
+            return nullptr;
+        }
+        _free_slab_pages.erase(_free_slab_pages.iterator_to(desc));
+        _nr_pages--;
+        return &desc;
+    }
+
     template<typename... Args>
     Item *create_from_lru(std::function<void (Item& item_ref)>& erase_func, Args&&... args) {
         auto ret = evict_lru_item(erase_func);
@@ -240,30 +321,77 @@ public:
         return create_item(ret.first, ret.second, std::forward<Args>(args)...);
     }
 
-    void free_item(Item *item, slab_page_desc& desc) {
+    void free_item(Item *item, slab_page_desc& desc, size_t objects_per_page) {
         void *object = item;
-        _lru.erase(_lru.iterator_to(reinterpret_cast<slab_item_base&>(*item)));
+        remove_item_from_lru(item);
+        _nr_objects--;
         desc.free_object(object);
         if (desc.size() == 1) {
             // push back desc into the list of slab pages with free objects.
             _free_slab_pages.push_back(desc);
+        } else if (desc.size() == objects_per_page) {
+            // page became completely free; move it to the front, where the
+            // rebalancer looks for pages to steal and the allocation path
+            // (which takes from the back) touches it last.
+            _free_slab_pages.erase(_free_slab_pages.iterator_to(desc));
+            _free_slab_pages.push_front(desc);
         }
     }
 
     void touch_item(Item *item) {
         auto& item_ref = reinterpret_cast<slab_item_base&>(*item);
-        _lru.erase(_lru.iterator_to(item_ref));
-        _lru.push_front(item_ref);
+        if (item_ref._lru_hot) {
+            // hot items stay where they are; the hot segment is trimmed
+            // from its tail on promotions instead.
+            return;
+        }
+        _cold_lru.erase(_cold_lru.iterator_to(item_ref));
+        _nr_cold--;
+        item_ref._lru_hot = true;
+        _hot_lru.push_front(item_ref);
+        _nr_hot++;
+        if (_nr_hot > _nr_cold + 1) {
+            // demote the coldest hot item to keep the segments balanced.
+            auto& demoted = _hot_lru.back();
+            _hot_lru.erase(_hot_lru.iterator_to(demoted));
+            _nr_hot--;
+            demoted._lru_hot = false;
+            _cold_lru.push_front(demoted);
+            _nr_cold++;
+        }
     }
 
     void remove_item_from_lru(Item *item) {
         auto& item_ref = reinterpret_cast<slab_item_base&>(*item);
-        _lru.erase(_lru.iterator_to(item_ref));
+        if (item_ref._lru_hot) {
+            _hot_lru.erase(_hot_lru.iterator_to(item_ref));
+            _nr_hot--;
+        } else {
+            _cold_lru.erase(_cold_lru.iterator_to(item_ref));
+            _nr_cold--;
+        }
     }
 
     void insert_item_into_lru(Item *item) {
         auto& item_ref = reinterpret_cast<slab_item_base&>(*item);
-        _lru.push_front(item_ref);
+        if (item_ref._lru_hot) {
+            _hot_lru.push_front(item_ref);
+            _nr_hot++;
+        } else {
+            _cold_lru.push_front(item_ref);
+            _nr_cold++;
+        }
+    }
+
+    // Accounting counterpart of whole-page eviction, which erases the
+    // page's items without going through free_item().
+    void note_item_evicted() {
+        _evictions++;
+        _nr_objects--;
+    }
+
+    void note_page_evicted() {
+        _nr_pages--;
     }
 
     void remove_desc_from_free_list(slab_page_desc& desc) {
@@ -289,6 +417,7 @@ private:
     struct collectd_stats {
         uint64_t allocs;
         uint64_t frees;
+        uint64_t rebalances;
     } _stats;
     memory::reclaimer *_reclaimer = nullptr;
     bool _reclaimed = false;
@@ -335,9 +464,11 @@ private:
             Item* item = reinterpret_cast<Item*>(object);
             assert(item->is_unlocked());
             slab_class->remove_item_from_lru(item);
+            slab_class->note_item_evicted();
             _erase_func(*item);
             _stats.frees++;
         }
+        slab_class->note_page_evicted();
 #ifdef SEASTAR_DEBUG
         printf("lru slab page eviction succeeded! desc_empty?=%d\n", desc.empty());
 #endif
@@ -399,13 +530,47 @@ private:
 
     void register_metrics() {
         namespace sm = seastar::metrics;
-        _metrics.add_group("slab", {
-            sm::make_derive("malloc_total_operations", sm::description("Total number of slab malloc operations"), _stats.allocs),
-            sm::make_derive("free_total_operations", sm::description("Total number of slab free operations"), _stats.frees),
-            sm::make_gauge("malloc_objects", sm::description("Number of slab created objects currently in memory"), [this] {
-                return _stats.allocs - _stats.frees;
-            })
-        });
+        std::vector<sm::metric_definition> defs;
+        defs.emplace_back(sm::make_derive("malloc_total_operations", sm::description("Total number of slab malloc operations"), _stats.allocs));
+        defs.emplace_back(sm::make_derive("free_total_operations", sm::description("Total number of slab free operations"), _stats.frees));
+        defs.emplace_back(sm::make_derive("page_rebalance_total_operations", sm::description("Total number of slab pages moved between slab classes"), _stats.rebalances));
+        defs.emplace_back(sm::make_gauge("malloc_objects", sm::description("Number of slab created objects currently in memory"), [this] {
+            return _stats.allocs - _stats.frees;
+        }));
+        // per-class occupancy and eviction metrics, labeled by object size.
+        auto class_label = sm::label("class_size");
+        for (auto& sc : _slab_classes) {
+            auto size_str = std::to_string(sc.size());
+            defs.emplace_back(sm::make_gauge("class_pages", sm::description("Number of slab pages currently owned by the slab class"), [&sc] {
+                return sc.nr_pages();
+            })(class_label(size_str)));
+            defs.emplace_back(sm::make_gauge("class_objects", sm::description("Number of objects currently allocated from the slab class"), [&sc] {
+                return sc.nr_objects();
+            })(class_label(size_str)));
+            defs.emplace_back(sm::make_derive("class_evictions", sm::description("Total number of items evicted from the LRU of the slab class"), [&sc] {
+                return sc.evictions();
+            })(class_label(size_str)));
+        }
+        _metrics.add_group("slab", defs);
+    }
+
+    /*
+     * Move a completely free slab page out of some other slab class, so it
+     * can back an allocation in a class which ran out of memory. Keeps a
+     * shifting object-size distribution from thrashing one class' LRU while
+     * other classes sit on idle pages.
+     */
+    slab_page_desc* steal_empty_page(const slab_class<Item>& needy_class) {
+        for (auto& sc : _slab_classes) {
+            if (&sc == &needy_class) {
+                continue;
+            }
+            auto desc = sc.try_release_empty_page(_max_object_size);
+            if (desc) {
+                return desc;
+            }
+        }
+        return nullptr;
     }
 
     inline slab_page_desc& get_slab_page_desc(Item *item)
@@ -484,6 +649,10 @@ public:
                     _available_slab_pages--;
                 }
                 _stats.allocs++;
+            } else if (auto desc = steal_empty_page(*slab_class)) {
+                item = slab_class->create_from_rebalanced_page(_max_object_size, *desc, std::forward<Args>(args)...);
+                _stats.rebalances++;
+                _stats.allocs++;
             } else if (_erase_func) {
                 item = slab_class->create_from_lru(_erase_func, std::forward<Args>(args)...);
             }
@@ -528,7 +697,7 @@ public:
         if (item) {
             auto& desc = get_slab_page_desc(item);
             auto slab_class = get_slab_class(desc.slab_class_id());
-            slab_class->free_item(item, desc);
+            slab_class->free_item(item, desc, _max_object_size / slab_class->size());
             _stats.frees++;
         }
     }
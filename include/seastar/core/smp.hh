@@ -31,6 +31,8 @@
 #include <boost/thread/barrier.hpp>
 #include <boost/range/irange.hpp>
 #include <boost/program_options.hpp>
+#include <atomic>
+#include <chrono>
 #include <deque>
 #include <thread>
 
@@ -67,6 +69,16 @@ struct smp_service_group_config {
     ///
     /// Will be adjusted upwards to allow at least one request per non-local shard.
     unsigned max_nonlocal_requests = 0;
+    /// The maximum queueing delay to tolerate on destination shards.
+    ///
+    /// When non-zero, the per-destination concurrency limits derived from
+    /// \ref max_nonlocal_requests become adaptive: each limit is grown
+    /// while the observed delay between submitting a request and the
+    /// destination shard starting to process it stays below this bound,
+    /// and is reduced multiplicatively when the bound is exceeded.
+    /// \ref max_nonlocal_requests then serves as the starting point of
+    /// the search rather than a fixed limit.
+    std::chrono::microseconds max_destination_queue_delay = {};
     /// An optional name for this smp group
     ///
     /// If this optional is engaged, timeout exception messages of the group's
@@ -159,10 +171,17 @@ void init_default_smp_service_group(shard_id cpu);
 
 smp_service_group_semaphore& get_smp_service_groups_semaphore(unsigned ssg_id, shard_id t) noexcept;
 
+// Returns a unit to the ssg_id/t semaphore and, for groups with a
+// max_destination_queue_delay, adapts the semaphore's limit to the
+// queueing delay recently observed on the destination shard.
+void smp_service_group_complete_request(unsigned ssg_id, shard_id t, uint64_t queue_delay_ns) noexcept;
+
 class smp_message_queue {
     static constexpr size_t queue_length = 128;
     static constexpr size_t batch_size = 16;
     static constexpr size_t prefetch_cnt = 2;
+    static constexpr unsigned response_ema_bits = 3;
+    static constexpr unsigned queue_delay_ema_bits = 3;
     struct work_item;
     struct lf_queue_remote {
         reactor* remote;
@@ -193,9 +212,21 @@ class smp_message_queue {
         size_t _received = 0;
         size_t _last_rcv_batch = 0;
     };
+    // Exponential moving average (in nanoseconds, updated by the receiving
+    // shard, read by the sending shard) of the queueing delay of incoming
+    // work items. See process_incoming() and process_completions().
+    std::atomic<uint64_t> _queue_delay_ns_ema = {};
     struct work_item : public task {
         explicit work_item(smp_service_group ssg) : task(current_scheduling_group()), ssg(ssg) {}
+        // Small work items are recycled through a shard-local pool: both
+        // the allocation in submit() and the release in
+        // process_completions() happen on the requesting shard, so the
+        // allocator can be bypassed on the submit_to() fast path.
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size) noexcept;
         smp_service_group ssg;
+        // when the item entered the queue; used to measure queueing delay
+        std::chrono::steady_clock::time_point submit_time;
         virtual ~work_item() {}
         virtual void fail_with(std::exception_ptr) = 0;
         void process();
@@ -252,6 +283,11 @@ class smp_message_queue {
         } a;
     } _tx;
     std::vector<work_item*> _completed_fifo;
+    // Exponential moving average (scaled by 2^response_ema_bits) of recent
+    // response flush sizes, and the flush threshold derived from it. See
+    // flush_response_batch().
+    size_t _response_batch_ema = 0;
+    size_t _response_batch_target = 1;
 public:
     smp_message_queue(reactor* from, reactor* to);
     ~smp_message_queue();
@@ -294,6 +330,12 @@ class smp {
     static std::unique_ptr<smp_message_queue*[], qs_deleter> _qs;
     static std::thread::id _tmain;
     static bool _using_dpdk;
+    // OS cpu number -> shard pinned to it (~0u if none); empty unless
+    // thread affinity is enabled.
+    static std::vector<shard_id> _cpu_to_shard;
+    // shard -> NUMA node its cpu and memory were allocated on; empty
+    // when the topology is unknown, in which case node 0 is assumed.
+    static std::vector<unsigned> _shard_to_numa_node;
 
     template <typename Func>
     using returns_future = is_future<std::result_of_t<Func()>>;
@@ -308,6 +350,19 @@ public:
     static void arrive_at_event_loop_end();
     static void join_all();
     static bool main_thread() { return std::this_thread::get_id() == _tmain; }
+    /// Maps an OS cpu number (as reported by, e.g., \c SO_INCOMING_CPU or
+    /// \c sched_getcpu()) to the shard pinned to that cpu.
+    ///
+    /// \return the shard running on \c os_cpu, or a disengaged optional if
+    ///         no shard is pinned there (including when thread affinity is
+    ///         disabled).
+    static std::optional<shard_id> shard_of_cpu(unsigned os_cpu) noexcept;
+
+    /// Maps a shard to the NUMA node its cpu and memory were allocated on.
+    ///
+    /// \return the NUMA node \c shard runs on, or node 0 when the topology
+    ///         is unknown (e.g. without hwloc support).
+    static unsigned numa_node_of_shard(shard_id shard) noexcept;
 
     /// Runs a function on a remote core.
     ///
@@ -0,0 +1,392 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB
+ */
+
+#pragma once
+
+#include <seastar/core/future.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/core/cacheline.hh>
+#include <seastar/core/bitops.hh>
+#include <seastar/util/std-compat.hh>
+#include <atomic>
+#include <memory>
+#include <optional>
+
+namespace seastar {
+
+/// \addtogroup smp-module
+/// @{
+
+class broken_channel_exception : public std::exception {
+public:
+    virtual const char* what() const noexcept override {
+        return "Broken channel";
+    }
+};
+
+/// \cond internal
+namespace internal {
+
+// Bounded single-producer single-consumer ring of T, safe for the producer
+// and consumer to live on different shards. Unlike boost::lockfree::spsc_queue
+// it supports move-only element types. Indices grow monotonically; the
+// occupied slots are [_tail, _head).
+template <typename T>
+class spsc_ring {
+    const size_t _mask; // capacity - 1, capacity is a power of two
+    std::unique_ptr<char[]> _storage;
+    alignas(cache_line_size) std::atomic<size_t> _head = {}; // written by producer
+    alignas(cache_line_size) std::atomic<size_t> _tail = {}; // written by consumer
+private:
+    T* slot(size_t idx) noexcept {
+        return reinterpret_cast<T*>(_storage.get()) + (idx & _mask);
+    }
+    static size_t round_up_to_power_of_two(size_t n) noexcept {
+        return size_t(1) << log2ceil(std::max<size_t>(n, 2));
+    }
+public:
+    explicit spsc_ring(size_t capacity)
+            : _mask(round_up_to_power_of_two(capacity) - 1)
+            , _storage(new char[sizeof(T) * (_mask + 1)]) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned element types are not supported");
+    }
+    ~spsc_ring() {
+        // Both sides are gone by now, so relaxed reads are sufficient.
+        auto head = _head.load(std::memory_order_relaxed);
+        for (auto tail = _tail.load(std::memory_order_relaxed); tail != head; ++tail) {
+            slot(tail)->~T();
+        }
+    }
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+    size_t capacity() const noexcept {
+        return _mask + 1;
+    }
+    // Producer side only.
+    bool push(T&& value) {
+        auto head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) > _mask) {
+            return false;
+        }
+        new (slot(head)) T(std::move(value));
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    // Consumer side only.
+    std::optional<T> pop() {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        if (_head.load(std::memory_order_acquire) == tail) {
+            return std::nullopt;
+        }
+        std::optional<T> ret(std::move(*slot(tail)));
+        slot(tail)->~T();
+        _tail.store(tail + 1, std::memory_order_release);
+        return ret;
+    }
+    // May be called from either side; the results are naturally approximate
+    // while the other side is active.
+    bool empty() const noexcept {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+    bool full() const noexcept {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire) > _mask;
+    }
+};
+
+// State shared by the two ends of a spsc_channel. Reference counted
+// manually (lw_shared_ptr is shard-local), with the two ends and every
+// in-flight wakeup task holding one reference each.
+//
+// Items travel through the ring without generating any tasks; tasks are
+// only used to wake a side that went to sleep on a full or empty ring,
+// so a burst of pushes costs at most one cross-shard wakeup, mirroring
+// smp_message_queue's maybe_wakeup(). Each wakeup promise is only ever
+// touched on the shard of the side that owns it: its owner (re)creates
+// and waits on it there, and wakeups are delivered via submit_to() to
+// that same shard.
+template <typename T>
+class spsc_channel_state {
+    spsc_ring<T> _ring;
+    // Written by the consumer, read by the producer.
+    alignas(cache_line_size) std::atomic<bool> _reader_waiting = { false };
+    std::atomic<bool> _read_open = { true };
+    shard_id _reader_shard;   // valid while _reader_waiting
+    promise<> _reader_wakeup;
+    // Written by the producer, read by the consumer.
+    alignas(cache_line_size) std::atomic<bool> _writer_waiting = { false };
+    std::atomic<bool> _write_open = { true };
+    shard_id _writer_shard;   // valid while _writer_waiting
+    promise<> _writer_wakeup;
+    std::atomic<unsigned> _refs = { 2 };
+private:
+    // Wakes the other side if it announced it is waiting. The seq_cst
+    // fence pairs with the one in wait_for_wakeup(): either we see the
+    // waiting flag, or the waiter's recheck sees our ring update.
+    void maybe_wake(std::atomic<bool>& waiting, shard_id& shard, promise<>& pr) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) && waiting.exchange(false)) {
+            get_ref();
+            (void)smp::submit_to(shard, [this, &pr] {
+                pr.set_value();
+                put_ref();
+            });
+        }
+    }
+    // Announces that the calling side is about to sleep and returns the
+    // future to sleep on. recheck() is evaluated after the announcement;
+    // if it returns true the ring changed underneath us and we complete
+    // the wakeup ourselves rather than sleeping for real.
+    template <typename Recheck>
+    future<> wait_for_wakeup(std::atomic<bool>& waiting, shard_id& shard, promise<>& pr, Recheck recheck) {
+        pr = promise<>();
+        auto f = pr.get_future();
+        shard = this_shard_id();
+        waiting.store(true, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (recheck() && waiting.exchange(false)) {
+            pr.set_value();
+        }
+        return f;
+    }
+public:
+    explicit spsc_channel_state(size_t capacity) : _ring(capacity) { }
+    void get_ref() noexcept {
+        _refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    void put_ref() noexcept {
+        if (_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+    size_t capacity() const noexcept {
+        return _ring.capacity();
+    }
+
+    // Producer side.
+    bool try_push(T&& value) {
+        if (!_ring.push(std::move(value))) {
+            return false;
+        }
+        maybe_wake(_reader_waiting, _reader_shard, _reader_wakeup);
+        return true;
+    }
+    bool read_open() const noexcept {
+        return _read_open.load(std::memory_order_relaxed);
+    }
+    future<> wait_for_space() {
+        return wait_for_wakeup(_writer_waiting, _writer_shard, _writer_wakeup, [this] {
+            return !_ring.full() || !read_open();
+        });
+    }
+    void close_write() {
+        _write_open.store(false, std::memory_order_relaxed);
+        maybe_wake(_reader_waiting, _reader_shard, _reader_wakeup);
+        // The promise is only ever touched on our own shard; reset it here
+        // so a future abandoned by the producer is broken on the right shard.
+        _writer_wakeup = promise<>();
+        put_ref();
+    }
+
+    // Consumer side.
+    std::optional<T> try_pop() {
+        auto ret = _ring.pop();
+        if (ret) {
+            maybe_wake(_writer_waiting, _writer_shard, _writer_wakeup);
+        }
+        return ret;
+    }
+    bool write_open() const noexcept {
+        return _write_open.load(std::memory_order_relaxed);
+    }
+    future<> wait_for_items() {
+        return wait_for_wakeup(_reader_waiting, _reader_shard, _reader_wakeup, [this] {
+            return !_ring.empty() || !write_open();
+        });
+    }
+    void close_read() {
+        _read_open.store(false, std::memory_order_relaxed);
+        maybe_wake(_writer_waiting, _writer_shard, _writer_wakeup);
+        _reader_wakeup = promise<>();
+        put_ref();
+    }
+};
+
+} // namespace internal
+/// \endcond
+
+template <typename T>
+class spsc_channel;
+
+/// \brief Read side of a \ref seastar::spsc_channel
+///
+/// Pops items pushed by the \ref spsc_channel_writer, possibly running on a
+/// different shard. All operations must run on the shard currently owning
+/// this object, and only one pop() may be outstanding at a time.
+template <typename T>
+class spsc_channel_reader {
+    internal::spsc_channel_state<T>* _state = nullptr;
+    spsc_channel_reader(internal::spsc_channel_state<T>* state) noexcept : _state(state) { }
+    friend class spsc_channel<T>;
+public:
+    spsc_channel_reader() noexcept = default;
+    ~spsc_channel_reader() {
+        if (_state) {
+            _state->close_read();
+        }
+    }
+    // Allow move, but not copy
+    spsc_channel_reader(spsc_channel_reader&& other) noexcept : _state(std::exchange(other._state, nullptr)) { }
+    spsc_channel_reader& operator=(spsc_channel_reader&& other) noexcept {
+        std::swap(_state, other._state);
+        return *this;
+    }
+
+    /// Pops one item if one is immediately available, without waiting.
+    std::optional<T> try_pop() {
+        return _state->try_pop();
+    }
+
+    /// \brief Pops all immediately available items.
+    ///
+    /// Invokes \c func on every item that can be popped without waiting.
+    /// Together with the batched wakeups this is the cheapest way to consume
+    /// the channel: a burst of pushes costs a single cross-shard task, and
+    /// the whole burst is drained here in one go.
+    ///
+    /// \return the number of items consumed.
+    template <typename Func>
+    size_t drain(Func func) {
+        size_t n = 0;
+        while (auto v = _state->try_pop()) {
+            func(std::move(*v));
+            ++n;
+        }
+        return n;
+    }
+
+    /// \brief Pops the next item, waiting for one if the channel is empty.
+    ///
+    /// Returns a disengaged optional when the write side was closed and
+    /// all items pushed before that were consumed.
+    future<std::optional<T>> pop() {
+        if (auto v = _state->try_pop()) {
+            return make_ready_future<std::optional<T>>(std::move(v));
+        }
+        if (!_state->write_open()) {
+            // The writer might have pushed a final batch just before
+            // closing; the flag is only visible after those pushes are.
+            if (auto v = _state->try_pop()) {
+                return make_ready_future<std::optional<T>>(std::move(v));
+            }
+            return make_ready_future<std::optional<T>>();
+        }
+        return _state->wait_for_items().then([this] {
+            return pop();
+        });
+    }
+};
+
+/// \brief Write side of a \ref seastar::spsc_channel
+///
+/// Pushes items for the \ref spsc_channel_reader, possibly running on a
+/// different shard. All operations must run on the shard currently owning
+/// this object, and only one push() may be outstanding at a time.
+template <typename T>
+class spsc_channel_writer {
+    internal::spsc_channel_state<T>* _state = nullptr;
+    spsc_channel_writer(internal::spsc_channel_state<T>* state) noexcept : _state(state) { }
+    friend class spsc_channel<T>;
+public:
+    spsc_channel_writer() noexcept = default;
+    ~spsc_channel_writer() {
+        if (_state) {
+            _state->close_write();
+        }
+    }
+    // Allow move, but not copy
+    spsc_channel_writer(spsc_channel_writer&& other) noexcept : _state(std::exchange(other._state, nullptr)) { }
+    spsc_channel_writer& operator=(spsc_channel_writer&& other) noexcept {
+        std::swap(_state, other._state);
+        return *this;
+    }
+
+    /// \brief Pushes an item if there is room, without waiting.
+    ///
+    /// Wait-free: no task is generated unless the reader went to sleep on
+    /// an empty channel, in which case a single wakeup is scheduled for it.
+    ///
+    /// \return true if the item was pushed, false if the channel is full
+    ///         (the item is left intact in that case).
+    bool try_push(T&& item) {
+        return _state->try_push(std::move(item));
+    }
+
+    /// \brief Pushes an item, waiting for room if the channel is full.
+    ///
+    /// Fails with \ref broken_channel_exception if the read side was closed.
+    future<> push(T&& item) {
+        if (!_state->read_open()) {
+            return make_exception_future<>(broken_channel_exception());
+        }
+        if (_state->try_push(std::move(item))) {
+            return make_ready_future<>();
+        }
+        return _state->wait_for_space().then([this, item = std::move(item)] () mutable {
+            return push(std::move(item));
+        });
+    }
+};
+
+/// \brief A bounded single-producer single-consumer channel between shards.
+///
+/// Built around a lock-free ring like the one \c smp_message_queue uses
+/// internally, but carrying user items instead of function calls: pushing
+/// and popping items does not generate tasks. A task is only used to wake
+/// the reader when it went to sleep on an empty channel (or the writer,
+/// on a full one), so a burst of pushes is delivered with a single
+/// cross-shard wakeup and can be consumed in one batch with
+/// \ref spsc_channel_reader::drain().
+///
+/// The two ends are movable (including across shards, via \ref
+/// smp::submit_to()), but each end must only be used from the shard that
+/// currently owns it, by one fiber at a time. Destroying an end closes
+/// that side: a closed write side makes pop() return a disengaged
+/// optional once the channel is drained, and a closed read side makes
+/// push() fail with \ref broken_channel_exception.
+///
+/// Note that items may be destroyed on either shard: items still in the
+/// channel when both ends are gone are destroyed wherever the last end
+/// was closed, so T must be safe to destroy on a foreign shard.
+template <typename T>
+class spsc_channel {
+public:
+    spsc_channel_reader<T> reader;
+    spsc_channel_writer<T> writer;
+    /// Creates a channel with room for at least \c capacity items
+    /// (rounded up to a power of two).
+    explicit spsc_channel(size_t capacity) : spsc_channel(new internal::spsc_channel_state<T>(capacity)) { }
+private:
+    spsc_channel(internal::spsc_channel_state<T>* state) : reader(state), writer(state) { }
+};
+
+/// @}
+
+} // namespace seastar
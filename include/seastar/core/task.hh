@@ -21,12 +21,92 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <seastar/core/cacheline.hh>
 #include <seastar/core/scheduling.hh>
 #include <seastar/util/backtrace.hh>
 
 namespace seastar {
 
+/// \cond internal
+namespace internal {
+
+// A per-thread cache of fixed-size allocations for task objects.
+//
+// Continuations are allocated when a future blocks and freed as soon as
+// they run, so at any given time only a handful of sizes are hot, and
+// those cycle through allocate/free at the full task rate. Serving them
+// from a small per-thread free list keeps the hot sizes out of the
+// general allocator's small pools and their refill path. Chunks are
+// cache-line aligned so a recycled task never shares a line with an
+// unrelated object.
+//
+// Chunks freed on a different thread than the one that allocated them
+// simply migrate to the freeing thread's cache; the backing memory is
+// eventually returned with the regular (cross-cpu aware) free.
+class task_pool {
+    struct free_object {
+        free_object* next;
+    };
+    static constexpr size_t object_granularity = cache_line_size;
+    static constexpr size_t max_object_size = 1024;
+    static constexpr size_t nr_classes = max_object_size / object_granularity;
+    // Cap on cached objects per size class; frees beyond it go back to
+    // the general allocator.
+    static constexpr size_t max_free_per_class = 256;
+    struct size_class {
+        free_object* free = nullptr;
+        size_t nr_free = 0;
+    };
+    size_class _classes[nr_classes];
+    // No destructor on purpose: tasks can still be freed during thread
+    // teardown, after thread-local destructors have run. The cached
+    // chunks live as long as the thread does.
+private:
+    static size_t class_of(size_t size) noexcept {
+        return (size - 1) / object_granularity;
+    }
+    static size_t class_size(size_t cls) noexcept {
+        return (cls + 1) * object_granularity;
+    }
+public:
+    void* allocate(size_t size) {
+        if (__builtin_expect(size > max_object_size, false)) {
+            return ::operator new(size);
+        }
+        auto& cls = _classes[class_of(size)];
+        if (__builtin_expect(cls.free != nullptr, true)) {
+            auto obj = cls.free;
+            cls.free = obj->next;
+            --cls.nr_free;
+            return obj;
+        }
+        return ::operator new(class_size(class_of(size)), std::align_val_t(cache_line_size));
+    }
+    void free(void* ptr, size_t size) noexcept {
+        if (__builtin_expect(size > max_object_size, false)) {
+            ::operator delete(ptr);
+            return;
+        }
+        auto& cls = _classes[class_of(size)];
+        if (cls.nr_free >= max_free_per_class) {
+            ::operator delete(ptr, std::align_val_t(cache_line_size));
+            return;
+        }
+        auto obj = static_cast<free_object*>(ptr);
+        obj->next = cls.free;
+        cls.free = obj;
+        ++cls.nr_free;
+    }
+};
+
+inline thread_local task_pool local_task_pool;
+
+}
+/// \endcond
+
 class task {
     scheduling_group _sg;
 #ifdef SEASTAR_TASK_BACKTRACE
@@ -40,6 +120,25 @@ protected:
     ~task() = default;
 public:
     explicit task(scheduling_group sg = current_scheduling_group()) noexcept : _sg(sg) {}
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    // Route task allocation through the per-thread task_pool. Only the
+    // sized delete is provided; deletion always happens with the
+    // concrete type (see the destructor comment above), so the correct
+    // size is always available. Disabled with the default allocator to
+    // keep tasks visible to valgrind and the sanitizers.
+    static void* operator new(size_t size) {
+        return internal::local_task_pool.allocate(size);
+    }
+    static void operator delete(void* ptr, size_t size) noexcept {
+        internal::local_task_pool.free(ptr, size);
+    }
+    // restore placement new, hidden by the class-scope operator new
+    static void* operator new(size_t, void* ptr) noexcept {
+        return ptr;
+    }
+    static void operator delete(void*, void*) noexcept {
+    }
+#endif
     virtual void run_and_dispose() noexcept = 0;
     /// Returns the next task which is waiting for this task to complete execution, or nullptr.
     virtual task* waiting_task() noexcept = 0;
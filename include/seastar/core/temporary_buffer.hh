@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <seastar/core/aligned_buffer.hh>
 #include <seastar/core/deleter.hh>
 #include <seastar/util/eclipse.hh>
 #include <seastar/util/std-compat.hh>
@@ -214,6 +215,23 @@ public:
         return temporary_buffer(buf, size, make_free_deleter(buf));
     }
 
+    /// Creates a \c temporary_buffer like \ref aligned(), preferring the
+    /// shard-local pool of pre-aligned buffers; the buffer returns to the
+    /// pool when the last reference to it is destroyed. Suited for
+    /// short-lived DMA buffers such as file stream chunks.
+    ///
+    /// \param alignment Required alignment; must be a power of two and a multiple of sizeof(void *).
+    /// \param size Required size; must be a multiple of alignment.
+    /// \return a new \c temporary_buffer object.
+    static temporary_buffer aligned_pooled(size_t alignment, size_t size) {
+        void* ptr = internal::allocate_pooled_aligned_buffer(size * sizeof(CharType), alignment);
+        if (!ptr) {
+            return aligned(alignment, size);
+        }
+        auto buf = static_cast<CharType*>(ptr);
+        return temporary_buffer(buf, size, make_deleter([ptr] { free_deleter{}(ptr); }));
+    }
+
     static temporary_buffer copy_of(std::string_view view) {
         void* ptr = ::malloc(view.size());
         if (!ptr) {
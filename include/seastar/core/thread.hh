@@ -86,6 +86,8 @@ public:
 /// \cond internal
 extern thread_local jmp_buf_link g_unthreaded_context;
 
+class stack_cache;
+
 // Internal class holding thread state.  We can't hold this in
 // \c thread itself because \c thread is movable, and we want pointers
 // to this state to be captured.
@@ -97,6 +99,7 @@ class thread_context final : private task {
     };
     using stack_holder = std::unique_ptr<char[], stack_deleter>;
 
+    size_t _stack_size;
     stack_holder _stack;
     noncopyable_function<void ()> _func;
     jmp_buf_link _context;
@@ -117,6 +120,11 @@ private:
     stack_holder make_stack(size_t stack_size);
     virtual void run_and_dispose() noexcept override; // from task class
 public:
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    // re-export, hidden by the private inheritance from task
+    using task::operator new;
+    using task::operator delete;
+#endif
     thread_context(thread_attributes attr, noncopyable_function<void ()> func);
     ~thread_context();
     void switch_in();
@@ -126,6 +134,7 @@ public:
     void yield();
     task* waiting_task() noexcept override { return _done.waiting_task(); }
     friend class thread;
+    friend class stack_cache;
     friend void thread_impl::switch_in(thread_context*);
     friend void thread_impl::switch_out(thread_context*);
     friend scheduling_group thread_impl::sched_group(const thread_context*);
@@ -32,6 +32,12 @@ namespace seastar {
  * The template type "Timer" should have a method named
  * get_timeout() which returns Timer::time_point which denotes
  * timer's expiration.
+ *
+ * If "Timer" also provides get_slack(), returning how late past the
+ * expiration the timer may fire, get_next_timeout() is deferred to the
+ * latest point allowed by all active timers, and an expiry round then
+ * fires every timer whose expiration has passed -- coalescing the
+ * wakeups of slack-tolerant timers instead of waking once per timer.
  */
 template<typename Timer, boost::intrusive::list_member_hook<> Timer::*link>
 class timer_set {
@@ -49,6 +55,10 @@ private:
     static constexpr int n_buckets = timestamp_bits + 1;
 
     std::array<timer_list_t, n_buckets> _buckets;
+    // Lower bound on the latest allowed firing point (expiry plus slack) of
+    // the timers in each bucket; may be stale after remove(), which only
+    // causes a harmless early wakeup.
+    std::array<timestamp_t, n_buckets> _bucket_deadline;
     timestamp_t _last;
     timestamp_t _next;
 
@@ -64,6 +74,28 @@ private:
         return get_timestamp(timer.get_timeout());
     }
 
+    // Timers advertise a firing slack via get_slack(); timer types without
+    // it (e.g. expiring_fifo entries) fire at their exact expiration.
+    template <typename T>
+    static auto get_slack(T& timer, int) noexcept -> decltype(timer.get_slack())
+    {
+        return timer.get_slack();
+    }
+
+    template <typename T>
+    static duration get_slack(T&, long) noexcept
+    {
+        return duration{};
+    }
+
+    // The latest point at which the timer is allowed to fire.
+    static timestamp_t get_deadline(Timer& timer) noexcept
+    {
+        auto timestamp = get_timestamp(timer);
+        auto slack = get_slack(timer, 0).count();
+        return timestamp <= max_timestamp - slack ? timestamp + slack : max_timestamp;
+    }
+
     int get_index(timestamp_t timestamp) const noexcept
     {
         if (timestamp <= _last) {
@@ -80,16 +112,13 @@ private:
         return get_index(get_timestamp(timer));
     }
 
-    int get_last_non_empty_bucket() const noexcept
-    {
-        return bitsets::get_last_set(_non_empty_buckets);
-    }
 public:
     timer_set() noexcept
         : _last(0)
         , _next(max_timestamp)
         , _non_empty_buckets(0)
     {
+        _bucket_deadline.fill(max_timestamp);
     }
 
     ~timer_set() {
@@ -114,9 +143,10 @@ public:
      *  - this timer will be added to the active set until it is expired
      *    by a call to expire() or removed by a call to remove().
      *
-     * Returns true if and only if this timer's timeout is less than get_next_timeout().
+     * Returns true if and only if this timer's latest allowed firing point
+     * (its timeout plus its slack, if any) is less than get_next_timeout().
      * When this function returns true the caller should reschedule expire() to be
-     * called at timer.get_timeout() to ensure timers are expired in a timely manner.
+     * called at get_next_timeout() to ensure timers are expired in a timely manner.
      */
     bool insert(Timer& timer) noexcept
     {
@@ -126,8 +156,10 @@ public:
         _buckets[index].push_back(timer);
         _non_empty_buckets[index] = true;
 
-        if (timestamp < _next) {
-            _next = timestamp;
+        auto deadline = get_deadline(timer);
+        _bucket_deadline[index] = std::min(_bucket_deadline[index], deadline);
+        if (deadline < _next) {
+            _next = deadline;
             return true;
         }
         return false;
@@ -151,6 +183,7 @@ public:
         list.erase(list.iterator_to(timer));
         if (list.empty()) {
             _non_empty_buckets[index] = false;
+            _bucket_deadline[index] = max_timestamp;
         }
     }
 
@@ -182,10 +215,12 @@ public:
         for (int i : bitsets::for_each_set(_non_empty_buckets, index + 1)) {
             exp.splice(exp.end(), _buckets[i]);
             _non_empty_buckets[i] = false;
+            _bucket_deadline[i] = max_timestamp;
         }
 
         _last = timestamp;
         _next = max_timestamp;
+        _bucket_deadline[index] = max_timestamp; // rebuilt by the re-insertions below
 
         auto& list = _buckets[index];
         while (!list.empty()) {
@@ -200,10 +235,17 @@ public:
 
         _non_empty_buckets[index] = !list.empty();
 
-        if (_next == max_timestamp && _non_empty_buckets.any()) {
-            for (auto& timer : _buckets[get_last_non_empty_bucket()]) {
-                _next = std::min(_next, get_timestamp(timer));
+        for (int i : bitsets::for_each_set(_non_empty_buckets)) {
+            if (_bucket_deadline[i] <= timestamp) {
+                // The cached bound came from a timer that was since removed
+                // (every surviving timer expires after now); rebuild it from
+                // the survivors so it cannot keep forcing immediate wakeups.
+                _bucket_deadline[i] = max_timestamp;
+                for (auto& timer : _buckets[i]) {
+                    _bucket_deadline[i] = std::min(_bucket_deadline[i], get_deadline(timer));
+                }
             }
+            _next = std::min(_next, _bucket_deadline[i]);
         }
         return exp;
     }
@@ -226,6 +268,7 @@ public:
     {
         for (int i : bitsets::for_each_set(_non_empty_buckets)) {
             _buckets[i].clear();
+            _bucket_deadline[i] = max_timestamp;
         }
     }
 
@@ -0,0 +1,373 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <boost/intrusive/list.hpp>
+
+namespace seastar {
+
+/**
+ * A hierarchical timing wheel holding and expiring timers, drop-in
+ * compatible with timer_set (see timer-set.hh).
+ *
+ * Timers are hashed into per-level slot lists by the highest bit in
+ * which their expiry differs from the current time, so arming and
+ * disarming a timer is O(1) regardless of how many timers are
+ * outstanding or how widely their timeouts are spread. Timers parked in
+ * higher levels are re-hashed ("cascaded") towards level zero as time
+ * advances; each timer cascades at most once per level, which bounds
+ * the total re-hash work per timer by the number of levels.
+ *
+ * The template type "Timer" should have a method named get_timeout()
+ * which returns Timer::time_point which denotes timer's expiration.
+ *
+ * If "Timer" also provides get_slack(), returning how late past the
+ * expiration the timer may fire, the timer is hashed on its latest
+ * allowed firing point instead of its expiration, so slack-tolerant
+ * timers gravitate to shared slots and expire in batched wakeups.
+ */
+template<typename Timer, boost::intrusive::list_member_hook<> Timer::*link>
+class timer_wheel {
+public:
+    using time_point = typename Timer::time_point;
+    using timer_list_t = boost::intrusive::list<Timer, boost::intrusive::member_hook<Timer, boost::intrusive::list_member_hook<>, link>>;
+private:
+    using duration = typename Timer::duration;
+    using timestamp_t = typename Timer::duration::rep;
+
+    static constexpr timestamp_t max_timestamp = std::numeric_limits<timestamp_t>::max();
+    static constexpr int timestamp_bits = std::numeric_limits<timestamp_t>::digits;
+
+    static constexpr int slot_bits = 6;
+    static constexpr int nr_slots = 1 << slot_bits;
+    static constexpr int nr_levels = (timestamp_bits + slot_bits - 1) / slot_bits;
+
+    std::array<std::array<timer_list_t, nr_slots>, nr_levels> _slots;
+    // per-level occupancy bitmap, bit i set iff _slots[level][i] is non-empty
+    std::array<uint64_t, nr_levels> _occupied = {};
+    // timers inserted with a timeout not later than _last; expired on the
+    // next call to expire()
+    timer_list_t _past;
+    timestamp_t _last;
+    timestamp_t _next;
+private:
+    static timestamp_t get_timestamp(time_point _time_point) noexcept
+    {
+        return _time_point.time_since_epoch().count();
+    }
+
+    // Timers advertise a firing slack via get_slack(); timer types without
+    // it (e.g. expiring_fifo entries) fire at their exact expiration.
+    template <typename T>
+    static auto get_slack(T& timer, int) noexcept -> decltype(timer.get_slack())
+    {
+        return timer.get_slack();
+    }
+
+    template <typename T>
+    static duration get_slack(T&, long) noexcept
+    {
+        return duration{};
+    }
+
+    // Timers are keyed on the latest point at which they are allowed to
+    // fire (expiration plus slack), so a slack-tolerant timer never costs
+    // a wakeup of its own before its window closes.
+    static timestamp_t get_timestamp(Timer& timer) noexcept
+    {
+        auto timestamp = get_timestamp(timer.get_timeout());
+        auto slack = get_slack(timer, 0).count();
+        return timestamp <= max_timestamp - slack ? timestamp + slack : max_timestamp;
+    }
+
+    // Level in which a timer with the given expiry parks: determined by the
+    // highest bit in which it differs from the current time, so that by the
+    // time the expiry is reachable within a level, the level's digit of
+    // _last has caught up with it.
+    int get_level(timestamp_t timestamp) const noexcept
+    {
+        // index of the highest bit in which the expiry differs from _last
+        auto diff_bit = 63 - __builtin_clzll(static_cast<uint64_t>(timestamp ^ _last));
+        return diff_bit / slot_bits;
+    }
+
+    static unsigned get_slot(timestamp_t timestamp, int level) noexcept
+    {
+        return (timestamp >> (level * slot_bits)) & (nr_slots - 1);
+    }
+
+    void link_timer(Timer& timer, timestamp_t timestamp) noexcept
+    {
+        auto level = get_level(timestamp);
+        auto slot = get_slot(timestamp, level);
+        _slots[level][slot].push_back(timer);
+        _occupied[level] |= uint64_t(1) << slot;
+    }
+
+    // Re-establishes _next as the exact expiry of the earliest timer still
+    // in the wheel. Only the cyclically-first occupied slot of each level
+    // needs to be scanned: within a level, slots further ahead hold
+    // strictly later timers.
+    void recompute_next() noexcept
+    {
+        for (int level = 0; level < nr_levels; ++level) {
+            auto occupied = _occupied[level];
+            if (!occupied) {
+                continue;
+            }
+            auto current = get_slot(_last, level);
+            unsigned best_distance = nr_slots + 1;
+            unsigned best_slot = 0;
+            while (occupied) {
+                unsigned slot = __builtin_ctzll(occupied);
+                occupied &= occupied - 1;
+                unsigned distance = ((slot - current - 1) & (nr_slots - 1)) + 1;
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best_slot = slot;
+                }
+            }
+            for (auto& timer : _slots[level][best_slot]) {
+                _next = std::min(_next, get_timestamp(timer));
+            }
+        }
+    }
+
+    // Drains a slot, moving expired timers to exp and re-hashing the rest
+    // towards lower levels.
+    void cascade(timer_list_t& list, timestamp_t now, timer_list_t& exp) noexcept
+    {
+        // Drain via a local list: a next-round timer can re-hash right back
+        // into the slot being drained, and must not be visited again.
+        timer_list_t work;
+        work.splice(work.end(), list);
+        while (!work.empty()) {
+            auto& timer = *work.begin();
+            work.pop_front();
+            auto timestamp = get_timestamp(timer);
+            if (timestamp <= now) {
+                exp.push_back(timer);
+            } else {
+                link_timer(timer, timestamp);
+                _next = std::min(_next, timestamp);
+            }
+        }
+    }
+public:
+    timer_wheel() noexcept
+        : _last(0)
+        , _next(max_timestamp)
+    {
+    }
+
+    ~timer_wheel() {
+        while (!_past.empty()) {
+            _past.begin()->cancel();
+        }
+        for (auto&& level : _slots) {
+            for (auto&& list : level) {
+                while (!list.empty()) {
+                    auto& timer = *list.begin();
+                    timer.cancel();
+                }
+            }
+        }
+    }
+
+    /**
+     * Adds timer to the active set.
+     *
+     * The value returned by timer.get_timeout() is used as timer's expiry. The result
+     * of timer.get_timeout() must not change while the timer is in the active set.
+     *
+     * Preconditions:
+     *  - this timer must not be currently in the active set or in the expired set.
+     *
+     * Postconditions:
+     *  - this timer will be added to the active set until it is expired
+     *    by a call to expire() or removed by a call to remove().
+     *
+     * Returns true if and only if this timer's timeout is less than get_next_timeout().
+     * When this function returns true the caller should reschedule expire() to be
+     * called at timer.get_timeout() to ensure timers are expired in a timely manner.
+     */
+    bool insert(Timer& timer) noexcept
+    {
+        auto timestamp = get_timestamp(timer);
+
+        if (timestamp <= _last) {
+            _past.push_back(timer);
+        } else {
+            link_timer(timer, timestamp);
+        }
+
+        if (timestamp < _next) {
+            _next = timestamp;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Removes timer from the active set.
+     *
+     * Preconditions:
+     *  - timer must be currently in the active set. Note: it must not be in
+     *    the expired set.
+     *
+     * Postconditions:
+     *  - timer is no longer in the active set.
+     *  - this object will no longer hold any references to this timer.
+     */
+    void remove(Timer& timer) noexcept
+    {
+        auto timestamp = get_timestamp(timer);
+        if (timestamp <= _last) {
+            _past.erase(_past.iterator_to(timer));
+            return;
+        }
+        auto level = get_level(timestamp);
+        auto slot = get_slot(timestamp, level);
+        auto& list = _slots[level][slot];
+        list.erase(list.iterator_to(timer));
+        if (list.empty()) {
+            _occupied[level] &= ~(uint64_t(1) << slot);
+        }
+    }
+
+    /**
+     * Expires active timers.
+     *
+     * The time points passed to this function must be monotonically increasing.
+     * Use get_next_timeout() to query for the next time point.
+     *
+     * Preconditions:
+     *  - the time_point passed to this function must not be lesser than
+     *    the previous one passed to this function.
+     *
+     * Postconditons:
+     *  - all timers from the active set with Timer::get_timeout() <= now are moved
+     *    to the expired set.
+     */
+    timer_list_t expire(time_point now) noexcept
+    {
+        timer_list_t exp;
+        auto timestamp = get_timestamp(now);
+
+        if (timestamp < _last) {
+            abort();
+        }
+
+        exp.splice(exp.end(), _past);
+
+        auto prev = _last;
+        _last = timestamp;
+        _next = max_timestamp;
+
+        // At each level, every slot whose digit lies in (prev, timestamp]
+        // may hold timers that either expired or must cascade to a lower
+        // level now that _last advanced. Levels whose digit prefix did not
+        // change need no work.
+        for (int level = 0; level < nr_levels; ++level) {
+            auto shift = level * slot_bits;
+            auto prev_digits = prev >> shift;
+            auto cur_digits = timestamp >> shift;
+            if (prev_digits == cur_digits) {
+                break;
+            }
+            auto nr_advanced = std::min<timestamp_t>(cur_digits - prev_digits, nr_slots);
+            for (timestamp_t i = 1; i <= nr_advanced; ++i) {
+                auto slot = (prev_digits + i) & (nr_slots - 1);
+                if (_occupied[level] & (uint64_t(1) << slot)) {
+                    _occupied[level] &= ~(uint64_t(1) << slot);
+                    cascade(_slots[level][slot], timestamp, exp);
+                }
+            }
+        }
+
+        recompute_next();
+        return exp;
+    }
+
+    /**
+     * Returns a time point at which expire() should be called
+     * in order to ensure timers are expired in a timely manner.
+     *
+     * Returned values are monotonically increasing.
+     */
+    time_point get_next_timeout() const noexcept
+    {
+        return time_point(duration(std::max(_last, _next)));
+    }
+
+    /**
+     * Clears both active and expired timer sets.
+     */
+    void clear() noexcept
+    {
+        _past.clear();
+        for (int level = 0; level < nr_levels; ++level) {
+            while (_occupied[level]) {
+                unsigned slot = __builtin_ctzll(_occupied[level]);
+                _occupied[level] &= _occupied[level] - 1;
+                _slots[level][slot].clear();
+            }
+        }
+    }
+
+    size_t size() const noexcept
+    {
+        size_t res = _past.size();
+        for (int level = 0; level < nr_levels; ++level) {
+            auto occupied = _occupied[level];
+            while (occupied) {
+                unsigned slot = __builtin_ctzll(occupied);
+                occupied &= occupied - 1;
+                res += _slots[level][slot].size();
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Returns true if and only if there are no timers in the active set.
+     */
+    bool empty() const noexcept
+    {
+        if (!_past.empty()) {
+            return false;
+        }
+        for (auto occupied : _occupied) {
+            if (occupied) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    time_point now() noexcept {
+        return Timer::clock::now();
+    }
+};
+}
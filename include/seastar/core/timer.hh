@@ -27,6 +27,7 @@
 #include <functional>
 #include <seastar/core/future.hh>
 #include <seastar/core/timer-set.hh>
+#include <seastar/core/timer-wheel.hh>
 #include <seastar/core/scheduling.hh>
 
 /// \file
@@ -86,6 +87,7 @@ private:
     scheduling_group _sg;
     callback_t _callback;
     time_point _expiry;
+    duration _slack = {};
     std::optional<duration> _period;
     bool _armed = false;
     bool _queued = false;
@@ -107,7 +109,7 @@ public:
     ///
     /// \note care should be taken when moving a timer whose callback captures `this`,
     ///       since the object pointed to by `this` may have been moved as well.
-    timer(timer&& t) noexcept : _sg(t._sg), _callback(std::move(t._callback)), _expiry(std::move(t._expiry)), _period(std::move(t._period)),
+    timer(timer&& t) noexcept : _sg(t._sg), _callback(std::move(t._callback)), _expiry(std::move(t._expiry)), _slack(t._slack), _period(std::move(t._period)),
             _armed(t._armed), _queued(t._queued), _expired(t._expired) {
         _link.swap_nodes(t._link);
         t._queued = false;
@@ -212,8 +214,29 @@ public:
     time_point get_timeout() const noexcept {
         return _expiry;
     }
+    /// Sets how late the timer may fire past its expiration time.
+    ///
+    /// A timer with slack fires at some point within
+    /// [expiry, expiry + slack], allowing the reactor to coalesce
+    /// its wakeup with those of other timers instead of programming the
+    /// hardware timer for the exact deadline. Timers that tolerate tens
+    /// of milliseconds of slack (idle timeouts, periodic refresh) let a
+    /// mostly-idle shard batch many expiries into one wakeup.
+    ///
+    /// The slack must not be changed while the timer is armed; it applies
+    /// to all subsequent arms until changed again.
+    ///
+    /// \param slack how late past the expiration time the timer may fire.
+    void set_slack(duration slack) noexcept {
+        _slack = slack;
+    }
+    /// Gets the firing slack of the timer (zero unless set_slack() was called).
+    duration get_slack() const noexcept {
+        return _slack;
+    }
     friend class reactor;
     friend class timer_set<timer, &timer::_link>;
+    friend class timer_wheel<timer, &timer::_link>;
 };
 
 extern template class timer<steady_clock_type>;
@@ -506,6 +506,87 @@ struct extract_values_from_futures_vector<future<>> {
     }
 };
 
+// State for the caller-provided-storage overload of when_all_succeed().
+// Like parallel_for_each_state, the object acts as its own continuation
+// and waits for the input futures one at a time, in order, harvesting
+// values directly into the caller's output iterator: a single allocation
+// regardless of how many futures are in flight, with the input iterator
+// standing in for a completion counter. The input range and the output
+// storage must stay valid until the returned future resolves.
+template <typename FutureIterator, typename OutputIterator>
+class when_all_succeed_state final
+        : private continuation_base_from_future_t<typename std::iterator_traits<FutureIterator>::value_type> {
+    using future_t = typename std::iterator_traits<FutureIterator>::value_type;
+    FutureIterator _pos;
+    FutureIterator _end;
+    OutputIterator _out;
+    promise<> _result;
+    std::exception_ptr _ex;
+private:
+    // Wait for the next unready future in [_pos, _end), and deliver
+    // _result once the range is exhausted.
+    void wait_for_one() noexcept {
+        while (_pos != _end && _pos->available()) {
+            consume_available(*_pos);
+            ++_pos;
+        }
+        if (_pos != _end) {
+            set_callback(*_pos, static_cast<continuation_base_from_future_t<future_t>*>(this));
+            // This future's state will be collected in run_and_dispose(),
+            // so we can move past it.
+            ++_pos;
+            return;
+        }
+        if (__builtin_expect(bool(_ex), false)) {
+            _result.set_exception(std::move(_ex));
+        } else {
+            _result.set_value();
+        }
+        delete this;
+    }
+    void consume_available(future_t& f) noexcept {
+        if (__builtin_expect(f.failed(), false)) {
+            auto ex = f.get_exception();
+            if (!_ex) {
+                _ex = std::move(ex);
+            }
+        } else if (!_ex) {
+            *_out++ = f.get0();
+        } else {
+            f.ignore_ready_future();
+        }
+    }
+    virtual void run_and_dispose() noexcept override {
+        if (__builtin_expect(this->_state.failed(), false)) {
+            auto ex = std::move(this->_state).get_exception();
+            if (!_ex) {
+                _ex = std::move(ex);
+            }
+        } else if (!_ex) {
+            *_out++ = untuple(std::move(this->_state).get_value());
+        }
+        this->_state = {};
+        wait_for_one();
+    }
+    task* waiting_task() noexcept override { return _result.waiting_task(); }
+public:
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    // re-export, hidden by the private inheritance from task
+    using continuation_base_from_future_t<future_t>::operator new;
+    using continuation_base_from_future_t<future_t>::operator delete;
+#endif
+    when_all_succeed_state(FutureIterator pos, FutureIterator end, OutputIterator out, std::exception_ptr ex) noexcept
+            : _pos(std::move(pos)), _end(std::move(end)), _out(std::move(out)), _ex(std::move(ex)) {
+    }
+    future<> get_future() noexcept {
+        // takes ownership of this; wait_for_one() chains it to one of the
+        // futures in the range and eventually deletes it
+        auto ret = _result.get_future();
+        wait_for_one();
+        return ret;
+    }
+};
+
 template<typename... Futures>
 SEASTAR_CONCEPT( requires seastar::AllAreFutures<Futures...> )
 inline auto when_all_succeed_impl(Futures&&... futures) noexcept {
@@ -557,6 +638,60 @@ when_all_succeed(FutureIterator begin, FutureIterator end) noexcept {
     }
 }
 
+/// Wait for many futures to complete (iterator version, caller-provided storage).
+///
+/// Like the two-argument iterator version, but instead of returning the
+/// values in a freshly allocated \c std::vector, writes them in order to
+/// \c out. This allows wide fan-outs to avoid the intermediate vector and
+/// the per-future continuation allocations: at most one allocation is
+/// performed, and none if all futures are already available.
+///
+/// The input range and the storage \c out writes to must remain valid
+/// until the returned future resolves. As with the other versions, all
+/// futures are waited for even if one of them fails, in which case one of
+/// the exceptions is returned and the output values are unspecified.
+///
+/// \param begin an \c InputIterator designating the beginning of the range of futures
+/// \param end an \c InputIterator designating the end of the range of futures
+/// \param out an \c OutputIterator the values of the resolved futures are written to
+/// \return a \c future<> that becomes ready when all input futures have resolved
+template <typename FutureIterator, typename OutputIterator, typename = typename std::iterator_traits<FutureIterator>::value_type>
+SEASTAR_CONCEPT( requires requires (FutureIterator i) {
+     *i++;
+     { i != i } -> std::convertible_to<bool>;
+     requires is_future<std::remove_reference_t<decltype(*i)>>::value;
+} )
+inline
+future<>
+when_all_succeed(FutureIterator begin, FutureIterator end, OutputIterator out) noexcept {
+    using state = internal::when_all_succeed_state<FutureIterator, OutputIterator>;
+    // Harvest whatever is ready right away; allocate a state only if we
+    // actually have to wait for something.
+    std::exception_ptr ex;
+    while (begin != end && begin->available()) {
+        if (__builtin_expect(begin->failed(), false)) {
+            auto e = begin->get_exception();
+            if (!ex) {
+                ex = std::move(e);
+            }
+        } else if (!ex) {
+            *out++ = begin->get0();
+        } else {
+            begin->ignore_ready_future();
+        }
+        ++begin;
+    }
+    if (begin == end) {
+        if (__builtin_expect(bool(ex), false)) {
+            return make_exception_future<>(std::move(ex));
+        }
+        return make_ready_future<>();
+    }
+    memory::scoped_critical_alloc_section _;
+    auto s = new state(std::move(begin), std::move(end), std::move(out), std::move(ex));
+    return s->get_future();
+}
+
 /// @}
 
 } // namespace seastar
@@ -31,6 +31,98 @@
 
 namespace seastar {
 
+namespace internal {
+
+// Single-allocation waiter for with_timeout(): the continuation parked on
+// the input future, the promise resolving the returned future and the timer
+// (an intrusive node in the reactor's per-shard timer set) all live in one
+// object. Wrapping a future thus costs one allocation and no extra
+// continuation hop, instead of a promise, a timer-holding continuation and
+// a forwarding continuation.
+template <typename ExceptionFactory, typename Clock, typename... T>
+class timeout_waiter final : public continuation_base<T...>, private ExceptionFactory {
+    promise<T...> _pr;
+    timer<Clock> _timer;
+public:
+    timeout_waiter()
+        : _timer([this] {
+            _pr.set_exception(std::make_exception_ptr(ExceptionFactory::timeout()));
+        })
+    {}
+    future<T...> get_future() noexcept {
+        return _pr.get_future();
+    }
+    void arm(typename timer<Clock>::time_point timeout) noexcept {
+        _timer.arm(timeout);
+    }
+    virtual void run_and_dispose() noexcept override {
+        if (_timer.cancel()) {
+            _pr.set_urgent_state(std::move(this->_state));
+        } else {
+            // timed out first; drop the result
+            this->_state.ignore();
+        }
+        delete this;
+    }
+};
+
+template <typename... T>
+struct first_or_void {
+    using type = void;
+};
+
+template <typename T, typename... Rest>
+struct first_or_void<T, Rest...> {
+    using type = T;
+};
+
+// Companion of timeout_waiter for with_timeout_expected(): expiry resolves
+// the promise with an error value instead of an exception, so the state and
+// allocation layout is the same but the exception-handling runtime is never
+// entered on the timeout path.
+template <typename ExceptionFactory, typename Clock, typename... T>
+class expected_timeout_waiter final : public continuation_base<T...>, private ExceptionFactory {
+public:
+    using error_type = decltype(std::declval<const ExceptionFactory&>().timeout());
+    using expected_type = expected<typename first_or_void<T...>::type, error_type>;
+private:
+    promise<expected_type> _pr;
+    timer<Clock> _timer;
+public:
+    expected_timeout_waiter()
+        : _timer([this] {
+            _pr.set_value(unexpected<error_type>{ExceptionFactory::timeout()});
+        })
+    {}
+    future<expected_type> get_future() noexcept {
+        return _pr.get_future();
+    }
+    void arm(typename timer<Clock>::time_point timeout) noexcept {
+        _timer.arm(timeout);
+    }
+    virtual void run_and_dispose() noexcept override {
+        if (_timer.cancel()) {
+            if (this->_state.failed()) {
+                _pr.set_exception(std::move(this->_state).get_exception());
+            } else if constexpr (std::is_void_v<typename first_or_void<T...>::type>) {
+                _pr.set_value(expected_type());
+            } else {
+#if SEASTAR_API_LEVEL < 5
+                _pr.set_value(expected_type(std::get<0>(std::move(this->_state).get_value())));
+#else
+                _pr.set_value(expected_type(std::move(this->_state).get_value()));
+#endif
+            }
+        } else {
+            // timed out first; drop the result
+            this->_state.ignore();
+        }
+        delete this;
+    }
+};
+
+}
+
 /// \addtogroup future-util
 /// @{
 
@@ -51,20 +143,47 @@ future<T...> with_timeout(std::chrono::time_point<Clock, Duration> timeout, futu
     if (f.available()) {
         return f;
     }
-    auto pr = std::make_unique<promise<T...>>();
-    auto result = pr->get_future();
-    timer<Clock> timer([&pr = *pr] {
-        pr.set_exception(std::make_exception_ptr(ExceptionFactory::timeout()));
-    });
-    timer.arm(timeout);
-    // Future is returned indirectly.
-    (void)f.then_wrapped([pr = std::move(pr), timer = std::move(timer)] (auto&& f) mutable {
-        if (timer.cancel()) {
-            f.forward_to(std::move(*pr));
-        } else {
-            f.ignore_ready_future();
-        }
-    });
+    auto waiter = std::make_unique<internal::timeout_waiter<ExceptionFactory, Clock, T...>>();
+    auto result = waiter->get_future();
+    waiter->arm(timeout);
+    internal::set_callback(f, waiter.release());
+    return result;
+}
+
+/// \brief Wait for either a future or a timeout, reporting expiry as a value
+///
+/// Like \ref with_timeout(), but when the timeout is reached the returned
+/// future resolves with an \ref expected carrying the error produced by
+/// ExceptionFactory::timeout() — \ref timed_out_error by default — instead
+/// of an exceptional future, keeping high-rate timeout paths off the
+/// exception-handling runtime. A failure of \c f itself still propagates
+/// as an exception.
+///
+/// Note that timing out doesn't cancel any tasks associated with the original future.
+/// It also doesn't cancel the callback registerred on it.
+///
+/// \param f future to wait for
+/// \param timeout time point after which the returned future should resolve
+///        with an error
+///
+/// \return a future resolving to an \ref expected holding either f's value
+///         or a timeout error
+template<typename ExceptionFactory = default_timeout_exception_factory, typename Clock, typename Duration, typename... T>
+future<typename internal::expected_timeout_waiter<ExceptionFactory, Clock, T...>::expected_type>
+with_timeout_expected(std::chrono::time_point<Clock, Duration> timeout, future<T...> f) {
+    using waiter_type = internal::expected_timeout_waiter<ExceptionFactory, Clock, T...>;
+    using expected_type = typename waiter_type::expected_type;
+    if (f.available()) {
+        // then() forwards an exceptional state without invoking the
+        // continuation, so this covers failed futures as well.
+        return f.then([] (auto&&... v) {
+            return expected_type(std::forward<decltype(v)>(v)...);
+        });
+    }
+    auto waiter = std::make_unique<waiter_type>();
+    auto result = waiter->get_future();
+    waiter->arm(timeout);
+    internal::set_callback(f, waiter.release());
     return result;
 }
 
@@ -0,0 +1,272 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <seastar/core/cacheline.hh>
+#include <seastar/core/condition-variable.hh>
+#include <seastar/core/do_with.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/core/with_scheduling_group.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+namespace seastar {
+
+/// \addtogroup future-util
+/// @{
+
+/// \brief An opt-in pool of tasks that idle shards may steal.
+///
+/// Normally work placement in seastar is explicit: \ref smp::submit_to
+/// runs a function on the shard the caller names. For stateless stages
+/// whose shards see a skewed load this forces applications to build
+/// their own dispatcher. A work_stealing_pool instead lets each shard
+/// enqueue tasks locally; a task is normally executed by the shard that
+/// submitted it (preserving cache locality), but when a shard runs out
+/// of local work it looks for the most backlogged peer and steals a
+/// small batch of tasks over the regular cross-shard message queues.
+///
+/// Tasks submitted with \ref submit() may be stolen; tasks submitted
+/// with \ref submit_pinned() always run on the submitting shard. In
+/// both cases the returned future resolves on the submitting shard,
+/// like \ref smp::submit_to. Stolen tasks run under the scheduling
+/// group given in \ref config.
+///
+/// The pool must be constructed on one shard after \ref app_template
+/// has started all reactors, \ref start()ed before use, and
+/// \ref stop()ped (which drains all queued tasks) before destruction.
+/// It must outlive all use on all shards; typically it is owned by the
+/// same scope that owns the application's top-level futures.
+class work_stealing_pool {
+public:
+    struct config {
+        /// Scheduling group that pool tasks run under, on whichever
+        /// shard ends up executing them.
+        scheduling_group sg = current_scheduling_group();
+        /// Maximum number of tasks moved per steal.
+        unsigned steal_batch = 4;
+        /// Minimum backlog a shard must accumulate before peers will
+        /// steal from it. Keeps short queues, which the owner will
+        /// drain quickly anyway, on their home shard.
+        unsigned steal_threshold = 8;
+        /// How long an idle shard sleeps before re-scanning peers'
+        /// backlogs for steal candidates.
+        std::chrono::microseconds idle_scan_period = std::chrono::microseconds(500);
+    };
+private:
+    using task_type = noncopyable_function<future<> ()>;
+    struct shard_state {
+        // accessed only from the owning shard
+        std::deque<task_type> stealable;
+        std::deque<task_type> pinned;
+        condition_variable work_available;
+        bool stopping = false;
+        std::optional<future<>> done;
+        // mirror of stealable.size(), read by remote shards scanning
+        // for a victim; keep it on its own cache line so that scans do
+        // not bounce the line holding the queues
+        alignas(seastar::cache_line_size) std::atomic<size_t> depth = {};
+    };
+    config _cfg;
+    std::unique_ptr<shard_state[]> _shards;
+private:
+    shard_state& local() noexcept {
+        return _shards[this_shard_id()];
+    }
+    void enqueue(task_type t, std::deque<task_type>& q) {
+        auto& s = local();
+        q.push_back(std::move(t));
+        s.depth.store(s.stealable.size(), std::memory_order_relaxed);
+        s.work_available.signal();
+    }
+    // Most backlogged shard worth stealing from, or this shard if none
+    // crosses the threshold.
+    shard_id pick_victim() const noexcept {
+        auto victim = this_shard_id();
+        size_t best = _cfg.steal_threshold - 1;
+        for (auto cpu : smp::all_cpus()) {
+            if (cpu == this_shard_id()) {
+                continue;
+            }
+            auto depth = _shards[cpu].depth.load(std::memory_order_relaxed);
+            if (depth > best) {
+                best = depth;
+                victim = cpu;
+            }
+        }
+        return victim;
+    }
+    future<> run_one(task_type t) {
+        return with_scheduling_group(_cfg.sg, std::move(t));
+    }
+    future<> steal_or_wait(shard_state& s) {
+        auto victim = pick_victim();
+        if (s.stopping || victim == this_shard_id()) {
+            // nothing worth stealing; wait for local submissions (or
+            // another scan, whichever comes first)
+            return s.work_available.wait(std::chrono::duration_cast<semaphore::duration>(_cfg.idle_scan_period)).handle_exception_type([] (condition_variable_timed_out&) {});
+        }
+        return smp::submit_to(victim, [this] {
+            auto& vs = local();
+            // marshalled behind a unique_ptr: a bare vector of
+            // noncopyable_function cannot ride through the future plumbing,
+            // which wants to copy-initialize its value
+            auto batch = std::make_unique<std::vector<task_type>>();
+            // leave at least half of the backlog with its owner
+            auto nr = std::min<size_t>(_cfg.steal_batch, vs.stealable.size() / 2);
+            batch->reserve(nr);
+            while (batch->size() < nr) {
+                // steal from the cold end; the owner drains the front
+                batch->push_back(std::move(vs.stealable.back()));
+                vs.stealable.pop_back();
+            }
+            vs.depth.store(vs.stealable.size(), std::memory_order_relaxed);
+            return batch;
+        }).then([this] (std::unique_ptr<std::vector<task_type>> batch) {
+            return do_with(std::move(batch), [this] (std::unique_ptr<std::vector<task_type>>& batch) {
+                return do_for_each(*batch, [this] (task_type& t) {
+                    return run_one(std::move(t));
+                });
+            });
+        });
+    }
+    future<> run(shard_state& s) {
+        return do_until([&s] {
+            return s.stopping && s.stealable.empty() && s.pinned.empty();
+        }, [this, &s] {
+            if (!s.pinned.empty()) {
+                auto t = std::move(s.pinned.front());
+                s.pinned.pop_front();
+                return run_one(std::move(t));
+            }
+            if (!s.stealable.empty()) {
+                auto t = std::move(s.stealable.front());
+                s.stealable.pop_front();
+                s.depth.store(s.stealable.size(), std::memory_order_relaxed);
+                return run_one(std::move(t));
+            }
+            return steal_or_wait(s);
+        });
+    }
+    // Runs func on whatever shard executes the task and routes the
+    // result back to the submitting shard, following the same pattern
+    // as smp_message_queue::async_work_item: the promise lives at a
+    // stable address and is only touched on the submitting shard.
+    template <typename Func>
+    futurize_t<std::result_of_t<Func()>> wrap_and_enqueue(Func func, std::deque<task_type>& q) {
+        using futurator = futurize<std::result_of_t<Func()>>;
+        using future_type = typename futurator::type;
+        using value_type = typename future_type::value_type;
+        struct item {
+            shard_id origin;
+            typename futurator::promise_type pr;
+            Func func;
+            std::optional<value_type> result;
+            std::exception_ptr ex; // if !result
+            explicit item(Func func) : origin(this_shard_id()), func(std::move(func)) {}
+        };
+        auto i = std::make_unique<item>(std::move(func));
+        auto fut = i->pr.get_future();
+        enqueue(task_type([i = std::move(i)] () mutable {
+            return futurator::invoke(i->func).then_wrapped([i = std::move(i)] (future_type f) mutable {
+                if (f.failed()) {
+                    i->ex = f.get_exception();
+                } else {
+                    i->result = f.get();
+                }
+                auto origin = i->origin;
+                return smp::submit_to(origin, [i = std::move(i)] () mutable {
+                    // move to a local so the item is also destroyed on
+                    // the submitting shard, where its promise links live
+                    auto local = std::move(i);
+                    if (local->result) {
+                        local->pr.set_value(std::move(*local->result));
+                    } else {
+                        local->pr.set_exception(std::move(local->ex));
+                    }
+                });
+            });
+        }), q);
+        return fut;
+    }
+public:
+    explicit work_stealing_pool(config cfg)
+        : _cfg(cfg)
+        , _shards(std::make_unique<shard_state[]>(smp::count)) {
+    }
+    work_stealing_pool(); // with default config
+
+    /// Starts a worker fiber on every shard. Must complete before the
+    /// first \ref submit().
+    future<> start() {
+        return smp::invoke_on_all([this] {
+            auto& s = local();
+            s.done = run(s);
+        });
+    }
+
+    /// Stops the pool, draining tasks already queued on every shard.
+    /// No \ref submit() may be issued once stop() has been called.
+    future<> stop() {
+        return smp::invoke_on_all([this] {
+            auto& s = local();
+            s.stopping = true;
+            s.work_available.signal();
+            return s.done ? std::move(*s.done) : make_ready_future<>();
+        });
+    }
+
+    /// Submits a task that any shard may execute. The returned future
+    /// resolves on the submitting shard with func's result.
+    template <typename Func>
+    futurize_t<std::result_of_t<Func()>> submit(Func func) {
+        return wrap_and_enqueue(std::move(func), local().stealable);
+    }
+
+    /// Submits a task pinned to the submitting shard; it will never be
+    /// stolen. Use for work whose state is local to this shard.
+    template <typename Func>
+    futurize_t<std::result_of_t<Func()>> submit_pinned(Func func) {
+        return wrap_and_enqueue(std::move(func), local().pinned);
+    }
+};
+
+// out of line because a `= {}` default argument cannot use the nested
+// config's member initializers from within the enclosing class
+inline work_stealing_pool::work_stealing_pool()
+    : work_stealing_pool(config()) {
+}
+
+/// @}
+
+}
@@ -0,0 +1,117 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#pragma once
+
+#include <seastar/core/condition-variable.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/iostream.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/http/response_parser.hh>
+#include <seastar/net/api.hh>
+#include <seastar/util/noncopyable_function.hh>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace seastar {
+
+namespace httpd {
+
+/**
+ * An asynchronous HTTP/1.1 client.
+ *
+ * An instance serves one shard and holds a pool of keep-alive
+ * connections to a single server. Requests beyond the pool size queue
+ * for the next connection to come free; a response whose framing allows
+ * it returns its connection to the pool for reuse.
+ *
+ * The response body is handed to the caller as an input_stream whose
+ * buffers come straight off the socket, so consuming it costs no copy,
+ * and not reading ahead of the caller applies backpressure to the
+ * server.
+ */
+class http_client {
+public:
+    /**
+     * Invoked with the parsed status line and headers once they are in,
+     * and with the body readable from the given stream. When the
+     * returned future resolves, any unread remainder of the body is
+     * drained and the connection is recycled; the stream must not be
+     * used afterwards.
+     */
+    using response_handler = noncopyable_function<future<>(const http_response& rsp, input_stream<char>& body)>;
+private:
+    class client_connection;
+    socket_address _addr;
+    sstring _host;
+    unsigned _max_connections;
+    // total connections, both idle and in use
+    unsigned _connections = 0;
+    std::list<std::unique_ptr<client_connection>> _idle;
+    condition_variable _available;
+    gate _pending;
+    bool _closed = false;
+public:
+    /**
+     * \param addr the server to connect to
+     * \param host the value for the Host header of requests that do not
+     *        set one themselves
+     * \param max_connections the size of the connection pool
+     */
+    explicit http_client(socket_address addr, sstring host = "", unsigned max_connections = 4);
+    ~http_client();
+
+    /**
+     * Send one request and handle its response.
+     * \param method the request method
+     * \param path the request path, including any query string
+     * \param headers additional request headers; Host and Content-Length
+     *        are filled in unless present
+     * \param body the request body, empty for bodyless requests
+     * \param handler see \ref response_handler
+     *
+     * The returned future resolves when the response was fully handled,
+     * or fails with the error that interrupted it.
+     */
+    future<> make_request(sstring method, sstring path,
+            std::unordered_map<sstring, sstring> headers, sstring body,
+            response_handler handler);
+
+    /**
+     * Convenience wrapper around \ref make_request: GET the given path
+     * and buffer the whole body into the returned response's _content.
+     */
+    future<std::unique_ptr<http_response>> get(sstring path);
+
+    /**
+     * Close the idle connections and wait for the requests in flight.
+     * No new requests may be issued once closing started.
+     */
+    future<> close();
+private:
+    future<std::unique_ptr<client_connection>> get_connection();
+    future<> put_connection(std::unique_ptr<client_connection> con, bool reusable);
+};
+
+}
+
+}
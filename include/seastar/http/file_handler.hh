@@ -22,7 +22,10 @@
 #pragma once
 
 #include <seastar/http/handlers.hh>
+#include <seastar/core/file.hh>
 #include <seastar/core/iostream.hh>
+#include <seastar/core/temporary_buffer.hh>
+#include <optional>
 
 namespace seastar {
 
@@ -50,6 +53,22 @@ public:
     virtual output_stream<char> transform(std::unique_ptr<request> req,
             const sstring& extension, output_stream<char>&& s) = 0;
 
+    /**
+     * A transformer whose output for a given file depends only on a few
+     * request attributes can name them here, making its output cacheable:
+     * the file handler keeps transformed bodies in a size-bounded
+     * shard-local LRU keyed by (file, this key), revalidated against the
+     * file on every hit, and reruns the transformation only on a miss.
+     * @param req the request
+     * @param extension the file extension originating the content
+     * @return the attributes the output depends on, encoded into a string,
+     * or std::nullopt (the default) if the output is not cacheable
+     */
+    virtual std::optional<sstring> cache_key(const request& req,
+            const sstring& extension) {
+        return std::nullopt;
+    }
+
     virtual ~file_transformer() = default;
 };
 
@@ -98,12 +117,38 @@ protected:
 
     /**
      * read a file from the disk and return it in the replay.
+     * Small files are served from a shard-local content cache validated
+     * against the file's modification time; the reply carries ETag and
+     * Last-Modified headers and conditional requests get 304 responses.
      * @param file the full path to a file on the disk
      * @param req the reuest
      * @param rep the reply
      */
     future<std::unique_ptr<reply> > read(sstring file,
             std::unique_ptr<request> req, std::unique_ptr<reply> rep);
+
+    /**
+     * set up the reply to send the given buffer as its body, going through
+     * the transformer if one is set
+     */
+    std::unique_ptr<reply> write_buffer(temporary_buffer<char> content,
+            std::unique_ptr<request> req, const sstring& extension,
+            std::unique_ptr<reply> rep);
+
+    /**
+     * set up the reply to send an already transformed buffer as its body
+     */
+    std::unique_ptr<reply> serve_transformed(temporary_buffer<char> content,
+            const sstring& extension, std::unique_ptr<reply> rep);
+
+    /**
+     * read a file, run it through the transformer, cache the result under
+     * the given key and send it as the reply
+     */
+    future<std::unique_ptr<reply>> read_transformed(sstring key,
+            sstring file_name, sstring extension, stat_data sd,
+            std::unique_ptr<request> req, std::unique_ptr<reply> rep);
+
     file_transformer* transformer;
 
     output_stream<char> get_stream(std::unique_ptr<request> req,
@@ -51,6 +51,17 @@ public:
     virtual future<std::unique_ptr<reply> > handle(const sstring& path,
             std::unique_ptr<request> req, std::unique_ptr<reply> rep) = 0;
 
+    /**
+     * A handler that returns true here receives the request body through
+     * request::content_stream instead of having it buffered whole into
+     * request::content, even when content streaming was not enabled on
+     * the server. Reading the stream applies backpressure to the socket,
+     * so a large upload costs only the stream's buffer, not its size.
+     */
+    virtual bool needs_content_stream() const {
+        return false;
+    }
+
     virtual ~handler_base() = default;
 
     /**
@@ -0,0 +1,190 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#pragma once
+
+#include <seastar/core/condition-variable.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/iostream.hh>
+#include <seastar/core/queue.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/http/reply.hh>
+#include <seastar/http/request.hh>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace seastar {
+
+namespace httpd {
+
+class http_server;
+
+/**
+ * Server-side HTTP/2 (RFC 7540).
+ *
+ * A connection multiplexes concurrent streams; each stream carries one
+ * request, dispatched through the server's routes exactly like an
+ * HTTP/1.1 request, and its response is framed back with HPACK-coded
+ * headers. Frames from all streams funnel into a single writer, so
+ * responses that become ready together share one flush.
+ *
+ * The protocol is negotiated through the cleartext prior-knowledge
+ * preface ("PRI * HTTP/2.0"); negotiating "h2" over TLS needs ALPN
+ * support in the tls layer. Server push and stream priorities are not
+ * implemented, and incoming HPACK string literals must not be Huffman
+ * coded.
+ */
+namespace http2 {
+
+/// Error codes from RFC 7540, Section 7.
+enum class error_code : uint32_t {
+    no_error = 0x0,
+    protocol_error = 0x1,
+    internal_error = 0x2,
+    flow_control_error = 0x3,
+    frame_size_error = 0x6,
+    refused_stream = 0x7,
+    compression_error = 0x9,
+};
+
+/// An error that terminates the whole connection; the code is reported
+/// to the peer in a GOAWAY frame.
+class session_error : public std::runtime_error {
+    error_code _code;
+public:
+    session_error(error_code code, const std::string& msg)
+            : std::runtime_error(msg), _code(code) {
+    }
+    error_code code() const {
+        return _code;
+    }
+};
+
+/**
+ * HPACK (RFC 7541) header block decoder.
+ *
+ * An instance holds the dynamic table of a connection's receiving
+ * direction, so every header block arriving on the connection must pass
+ * through it, in order, even for streams that are being discarded.
+ */
+class hpack_decoder {
+public:
+    using header_list = std::vector<std::pair<sstring, sstring>>;
+
+    /// Decode one complete header block. Throws session_error with
+    /// error_code::compression_error on malformed input.
+    header_list decode(const char* p, size_t len);
+private:
+    std::pair<sstring, sstring> at(uint64_t index) const;
+    void insert(sstring name, sstring value);
+    void evict();
+private:
+    // newest entry first, as the index space is ordered
+    std::deque<std::pair<sstring, sstring>> _dynamic;
+    size_t _dynamic_size = 0;
+    size_t _max_dynamic_size = 4096;
+};
+
+/**
+ * HPACK header block encoder.
+ *
+ * Deliberately stateless: every header is emitted as a literal without
+ * indexing, referencing the static table for the name when it has one,
+ * and strings are never Huffman coded. A stateless encoding is valid no
+ * matter what the peer has acknowledged, at the cost of some bytes on
+ * the wire.
+ */
+class hpack_encoder {
+public:
+    void encode(std::string& out, const sstring& name, const sstring& value);
+    void encode_status(std::string& out, int status);
+};
+
+/**
+ * One HTTP/2 connection. Takes over the streams of an established
+ * connection after the preface was recognized and runs the session to
+ * completion; the caller closes the streams afterwards as usual.
+ */
+class connection {
+    struct frame {
+        uint8_t type;
+        uint8_t flags;
+        uint32_t stream_id;
+        temporary_buffer<char> payload;
+    };
+    struct stream {
+        std::unique_ptr<request> req;
+        sstring body;
+        int64_t send_window;
+        bool dispatched = false;
+    };
+    http_server& _server;
+    input_stream<char>& _read_buf;
+    output_stream<char>& _write_buf;
+    hpack_decoder _decoder;
+    hpack_encoder _encoder;
+    std::unordered_map<uint32_t, stream> _streams;
+    // streams reset by the peer while their response was in flight
+    std::unordered_set<uint32_t> _reset;
+    uint32_t _max_stream_id = 0;
+    // peer settings and send-direction flow control windows
+    int64_t _send_window = 65535;
+    int64_t _peer_initial_window = 65535;
+    uint32_t _peer_max_frame_size = 16384;
+    bool _done = false;
+    condition_variable _window_change;
+    // outgoing frames awaiting the writer; an empty element marks eof
+    queue<std::string> _outq { 128 };
+    gate _pending_responses;
+public:
+    connection(http_server& server, input_stream<char>& read_buf,
+            output_stream<char>& write_buf)
+            : _server(server), _read_buf(read_buf), _write_buf(write_buf) {
+    }
+    future<> process();
+private:
+    future<> read_loop();
+    future<> write_loop();
+    future<std::optional<frame>> read_frame();
+    future<> handle_frame(frame f);
+    future<> read_header_block(uint32_t stream_id, std::string fragment,
+            bool end_stream, bool end_headers);
+    void process_header_block(uint32_t stream_id, std::string block, bool end_stream);
+    future<> handle_data(frame f);
+    future<> handle_settings(frame f);
+    void handle_window_update(const frame& f);
+    void handle_rst_stream(const frame& f);
+    void finish_request(uint32_t stream_id, stream& s);
+    void dispatch(uint32_t stream_id, std::unique_ptr<request> req);
+    future<> send_response(uint32_t stream_id, std::unique_ptr<reply> rep);
+    future<> send_data(uint32_t stream_id, std::string body);
+    future<std::string> materialize_body(reply& rep);
+    future<> submit(std::string frame_bytes);
+};
+
+}
+
+}
+
+}
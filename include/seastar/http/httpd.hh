@@ -53,6 +53,14 @@ class http_server;
 class http_stats;
 struct reply;
 
+namespace http2 {
+class connection;
+}
+
+namespace websocket {
+class connection;
+}
+
 using namespace std::chrono_literals;
 
 class http_stats {
@@ -73,6 +81,14 @@ class connection : public boost::intrusive::list_base_hook<> {
     std::unique_ptr<reply> _resp;
     // null element marks eof
     queue<std::unique_ptr<reply>> _replies { 10 };
+    // Replies complete a full cycle through the connection: allocated here,
+    // filled in by the handler, written out and dropped. Keeping the written
+    // ones around spares a keep-alive connection the allocation of a reply
+    // and its headers map for every request it serves. Requests cannot be
+    // pooled the same way: their ownership passes into the handler and never
+    // returns.
+    static constexpr size_t max_pooled_replies = 10;
+    std::vector<std::unique_ptr<reply>> _reply_pool;
     bool _done = false;
 public:
     connection(http_server& server, connected_socket&& fd,
@@ -120,9 +136,28 @@ public:
      */
     static sstring set_query_param(request& req);
 
+    /**
+     * Take over the connection for the websocket protocol: answer the
+     * upgrade request and run the registered endpoint handler over the
+     * connection's streams (see websocket.hh).
+     */
+    future<> upgrade_websocket(std::unique_ptr<request> req);
+
     future<bool> generate_reply(std::unique_ptr<request> req);
     void generate_error_reply_and_close(std::unique_ptr<request> req, reply::status_type status, const sstring& msg);
 
+    /**
+     * Take a cleared reply from the connection's pool, or allocate one if
+     * the pool is empty.
+     */
+    std::unique_ptr<reply> allocate_reply();
+
+    /**
+     * Return a written-out reply to the pool for reuse by a later response
+     * on this connection.
+     */
+    void recycle_reply(std::unique_ptr<reply> resp);
+
     future<> write_body();
 
     output_stream<char>& out();
@@ -138,12 +173,14 @@ class http_server {
     uint64_t _requests_served = 0;
     uint64_t _read_errors = 0;
     uint64_t _respond_errors = 0;
+    uint64_t _requests_shed = 0;
     shared_ptr<seastar::tls::server_credentials> _credentials;
     sstring _date = http_date();
     timer<> _date_format_timer { [this] {_date = http_date();} };
     size_t _content_length_limit = std::numeric_limits<size_t>::max();
     bool _content_streaming = false;
     gate _task_gate;
+    std::unordered_map<sstring, std::function<future<> (websocket::connection&)>> _websocket_handlers;
 public:
     routes _routes;
     using connection = seastar::httpd::connection;
@@ -186,6 +223,16 @@ public:
 
     void set_content_streaming(bool b);
 
+    /*!
+     * \brief register a websocket endpoint
+     *
+     * A GET request for \c url carrying a websocket upgrade is answered
+     * with the handshake and the handler runs over the established
+     * connection; the connection closes when the returned future
+     * resolves. The url is matched exactly, like routes::put.
+     */
+    void set_websocket_handler(const sstring& url, std::function<future<> (websocket::connection&)> handler);
+
     future<> listen(socket_address addr, listen_options lo);
     future<> listen(socket_address addr);
     future<> stop();
@@ -197,13 +244,16 @@ public:
     uint64_t requests_served() const;
     uint64_t read_errors() const;
     uint64_t reply_errors() const;
+    uint64_t requests_shed() const;
     // Write the current date in the specific "preferred format" defined in
     // RFC 7231, Section 7.1.1.1.
     static sstring http_date();
+    static sstring http_date(time_t t);
 private:
     future<> do_accept_one(int which);
     boost::intrusive::list<connection> _connections;
     friend class seastar::httpd::connection;
+    friend class http2::connection;
     friend class http_server_tester;
 };
 
@@ -0,0 +1,50 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace seastar {
+
+// Not in httpd::internal: this header is pulled in by the generated
+// request_parser.hh, whose `using namespace httpd` inside namespace seastar
+// would otherwise make every unqualified `internal` reference in headers
+// included after it ambiguous.
+namespace internal {
+
+// Vectorized scanners for the HTTP parser fast paths. Each returns the
+// length of the longest prefix of [p, p + len) made solely of the
+// character class in question, i.e. the offset of the first byte that
+// ends the run (or len if the whole input qualifies).
+
+// tchar, the characters allowed in header field names and methods
+// (RFC 7230, section 3.2.6)
+size_t scan_token_chars(const char* p, size_t len);
+
+// The characters that may appear inside a header field value: VCHAR,
+// obs-text, SP and HT. The terminating byte of a run is in practice the
+// CR of the line's CRLF, so this doubles as end-of-line detection.
+size_t scan_value_chars(const char* p, size_t len);
+
+}
+
+}
@@ -78,6 +78,20 @@ public:
 
     virtual size_t match(const sstring& url, size_t ind, parameters& param)
             override;
+
+    /**
+     * @return the name of the matched parameter
+     */
+    const sstring& name() const {
+        return _name;
+    }
+
+    /**
+     * @return true when the parameter covers the remainder of the url
+     */
+    bool entire_path() const {
+        return _entire_path;
+    }
 private:
     sstring _name;
     bool _entire_path;
@@ -101,6 +115,13 @@ public:
 
     virtual size_t match(const sstring& url, size_t ind, parameters& param)
             override;
+
+    /**
+     * @return the string this matcher compares against
+     */
+    const sstring& pattern() const {
+        return _cmp;
+    }
 private:
     sstring _cmp;
     unsigned _len;
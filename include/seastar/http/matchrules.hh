@@ -112,6 +112,21 @@ public:
         return *this;
     }
 
+    /**
+     * @return the ordered matchers making up this rule, e.g. for
+     * compiling the rule into a dispatch structure
+     */
+    const std::vector<matcher*>& matchers() const {
+        return _match_list;
+    }
+
+    /**
+     * @return the rule's handler
+     */
+    handler_base* handler() const {
+        return _handler;
+    }
+
 private:
     std::vector<matcher*> _match_list;
     handler_base* _handler;
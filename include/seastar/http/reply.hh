@@ -32,6 +32,7 @@
 #pragma once
 
 #include <seastar/core/sstring.hh>
+#include <optional>
 #include <unordered_map>
 #include <seastar/http/mime_types.hh>
 #include <seastar/core/iostream.hh>
@@ -44,6 +45,10 @@ namespace httpd {
 class connection;
 class routes;
 
+namespace http2 {
+class connection;
+}
+
 /**
  * A reply to be sent to a client.
  */
@@ -142,6 +147,22 @@ struct reply {
     }
     sstring response_line();
 
+    /**
+     * Reset the reply to the state of a newly constructed one, so the
+     * object can serve another response. The memory held by the headers
+     * map is kept, sparing its reallocation on reuse.
+     */
+    reply& clear() {
+        _status = status_type::ok;
+        _headers.clear();
+        _version = {};
+        _content = {};
+        _response_line = {};
+        _body_writer = {};
+        _body_writer_length = std::nullopt;
+        return *this;
+    }
+
     /*!
      * \brief use an output stream to write the message body
      *
@@ -160,6 +181,17 @@ struct reply {
 
     void write_body(const sstring& content_type, noncopyable_function<future<>(output_stream<char>&&)>&& body_writer);
 
+    /*!
+     * \brief use an output stream to write a message body of known length
+     *
+     * Like the body_writer overload above, but for a body whose size is
+     * known up front. The reply carries a Content-Length header instead
+     * of using chunked transfer encoding, and the bytes the writer
+     * produces go out without the chunk framing overhead. The writer
+     * must produce exactly \c content_length bytes.
+     */
+    void write_body(const sstring& content_type, size_t content_length, noncopyable_function<future<>(output_stream<char>&&)>&& body_writer);
+
     /*!
      * \brief Write a string as the reply
      *
@@ -176,8 +208,12 @@ private:
     future<> write_reply_headers(connection& connection);
 
     noncopyable_function<future<>(output_stream<char>&&)> _body_writer;
+    // engaged when the body writer's output has a known length, in which
+    // case the reply is not chunked
+    std::optional<size_t> _body_writer_length;
     friend class routes;
     friend class connection;
+    friend class http2::connection;
 };
 
 } // namespace httpd
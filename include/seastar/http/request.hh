@@ -137,6 +137,28 @@ struct request {
         return content_type_class == ctclass::app_x_www_urlencoded;
     }
 
+    /**
+     * Reset the request to the state of a newly constructed one, so the
+     * object can be filled in by the parser again. The memory held by the
+     * maps is kept, sparing its reallocation on reuse.
+     */
+    void clear() {
+        _method = {};
+        _url = {};
+        _version = {};
+        content_type_class = ctclass::other;
+        content_length = 0;
+        _headers.clear();
+        query_parameters.clear();
+        connection_ptr = nullptr;
+        param.clear();
+        content = {};
+        content_stream = nullptr;
+        trailing_headers.clear();
+        chunk_extensions.clear();
+        protocol_name = "http";
+    }
+
 };
 
 } // namespace httpd
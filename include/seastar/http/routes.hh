@@ -28,6 +28,7 @@
 
 #include <boost/program_options/variables_map.hpp>
 #include <unordered_map>
+#include <memory>
 
 namespace seastar {
 
@@ -106,7 +107,7 @@ public:
      * @return it self
      */
     routes& add(match_rule* rule, operation_type type = GET) {
-        _rules[type][_rover++] = rule;
+        add_cookie(rule, type);
         return *this;
     }
 
@@ -160,7 +161,6 @@ public:
     handler_base* get_handler(operation_type type, const sstring& url,
             parameters& params);
 
-private:
     /**
      * Normalize the url to remove the last / if exists
      * and get the parameter part
@@ -170,12 +170,20 @@ private:
      */
     sstring normalize_url(const sstring& url);
 
+private:
     std::unordered_map<sstring, handler_base*> _map[NUM_OPERATION];
 public:
     using rule_cookie = uint64_t;
 private:
     rule_cookie _rover = 0;
     std::map<rule_cookie, match_rule*> _rules[NUM_OPERATION];
+    // The rules compiled into a per-operation dispatch trie (see
+    // routes.cc); rebuilt lazily on the first lookup after the rule set
+    // changed.
+    struct dispatch_trie;
+    std::unique_ptr<dispatch_trie> _trie[NUM_OPERATION];
+    bool _trie_dirty = true;
+    void compile_tries();
     //default Handler -- for any HTTP Method and Path (/*)
     handler_base* _default_handler = nullptr;
 public:
@@ -225,6 +233,7 @@ public:
     rule_cookie add_cookie(match_rule* rule, operation_type type) {
         auto pos = _rover++;
         _rules[type][pos] = rule;
+        _trie_dirty = true;
         return pos;
     }
 
@@ -43,6 +43,9 @@ class content_replace : public file_transformer {
 public:
     virtual output_stream<char> transform(std::unique_ptr<request> req,
             const sstring& extension, output_stream<char>&& s);
+
+    virtual std::optional<sstring> cache_key(const request& req,
+            const sstring& extension) override;
     /**
      * the constructor get the file extension the replace would work on.
      * @param extension file extension, when not set all files extension
@@ -0,0 +1,131 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#pragma once
+
+#include <seastar/core/iostream.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
+#include <optional>
+#include <vector>
+
+namespace seastar {
+
+namespace httpd {
+
+/**
+ * Server-side WebSocket (RFC 6455).
+ *
+ * A GET request carrying a websocket upgrade is matched against the
+ * endpoints registered with http_server::set_websocket_handler(); on a
+ * match the server completes the handshake and hands the connection's
+ * streams to the endpoint's handler, which exchanges messages until it
+ * resolves or the peer closes.
+ *
+ * Frames are parsed over the input stream's buffers and unmasked in
+ * place, so a message payload reaches the handler without a copy, and
+ * outgoing frames are buffered in the output stream until a flush, so
+ * small messages written back-to-back share one write to the socket.
+ */
+namespace websocket {
+
+/// Frame opcodes from RFC 6455, Section 5.2.
+enum class opcode : uint8_t {
+    continuation = 0x0,
+    text = 0x1,
+    binary = 0x2,
+    close = 0x8,
+    ping = 0x9,
+    pong = 0xa,
+};
+
+/**
+ * One complete application message. Fragmented messages arrive joined
+ * and control frames are handled by the connection, so kind is text,
+ * binary, or close; a close message (also produced by eof) means the
+ * conversation is over.
+ */
+struct message {
+    opcode kind = opcode::close;
+    temporary_buffer<char> payload;
+    explicit operator bool() const {
+        return kind != opcode::close;
+    }
+};
+
+/// A malformed frame from the peer; terminates the connection.
+class protocol_error : public std::runtime_error {
+public:
+    explicit protocol_error(const std::string& msg) : std::runtime_error(msg) {
+    }
+};
+
+/// Compute the Sec-WebSocket-Accept value answering a handshake key
+/// (RFC 6455, Section 4.2.2).
+sstring handshake_accept(const sstring& key);
+
+/**
+ * One established websocket connection. Takes over the streams of an
+ * upgraded connection after the handshake; the caller closes the
+ * streams afterwards as usual.
+ */
+class connection {
+    // A frame larger than this is a protocol error; it bounds the memory
+    // a peer can make us buffer for a single message fragment.
+    static constexpr size_t max_frame_size = 1 << 20;
+    struct frame {
+        bool fin;
+        opcode kind;
+        temporary_buffer<char> payload;
+    };
+    input_stream<char>& _read_buf;
+    output_stream<char>& _write_buf;
+    // fragments of a partially received message
+    std::vector<temporary_buffer<char>> _fragments;
+    size_t _fragments_size = 0;
+    opcode _fragments_kind = opcode::continuation;
+    bool _closed = false;
+public:
+    connection(input_stream<char>& read_buf, output_stream<char>& write_buf)
+            : _read_buf(read_buf), _write_buf(write_buf) {
+    }
+    /// Read the next message, answering pings along the way. A close
+    /// message means the peer is done; further reads return close again.
+    future<message> read_message();
+    /// Frame one message into the output buffer without flushing, so a
+    /// batch of small messages can go out in a single write.
+    future<> write_message(opcode kind, temporary_buffer<char> payload);
+    /// Flush buffered frames to the peer.
+    future<> flush();
+    /// write_message() and flush() in one call.
+    future<> send_message(opcode kind, temporary_buffer<char> payload);
+    /// Send a close frame with the given status code and flush it.
+    future<> close(uint16_t status = 1000);
+private:
+    future<std::optional<frame>> read_frame();
+    message assemble();
+};
+
+}
+
+}
+
+}
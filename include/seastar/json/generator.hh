@@ -0,0 +1,126 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright 2021 Cloudius Systems
+ */
+
+#pragma once
+
+#include <seastar/core/iostream.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
+#include <string_view>
+#include <time.h>
+#include <vector>
+
+namespace seastar {
+
+namespace json {
+
+/**
+ * An incremental json serializer.
+ *
+ * Output accumulates in a list of fixed-size chunks instead of being
+ * concatenated, so appending is amortized a bounds check and a memcpy
+ * however large the document grows. Strings are escaped a word at a
+ * time and numbers are formatted directly with to_chars, with no
+ * stringstream or locale machinery on the path.
+ *
+ * An api handler can build its reply with append() calls and return
+ * str() as its json_return_type, or move the chunks into the reply
+ * stream with write(). clear() recycles the buffer for the next
+ * document without giving up the allocation.
+ */
+class generator {
+    static constexpr size_t chunk_size = 4096;
+    std::vector<temporary_buffer<char>> _full;
+    temporary_buffer<char> _current;
+    size_t _pos = 0;    // write position in _current
+    size_t _size = 0;   // bytes in _full
+public:
+    /**
+     * append raw bytes that are already valid json
+     */
+    void append_raw(const char* s, size_t n);
+
+    void append(char c) {
+        append_raw(&c, 1);
+    }
+
+    /**
+     * append a string value, quoted and escaped as a json string
+     */
+    void append_string(std::string_view v);
+
+    void append(int n);
+    void append(unsigned n);
+    void append(long n);
+    void append(unsigned long n);
+
+    /**
+     * append a floating point value; infinities and NaN have no json
+     * representation and throw like formatter::to_json does
+     */
+    void append(float f);
+    void append(double d);
+
+    void append(bool b) {
+        b ? append_raw("true", 4) : append_raw("false", 5);
+    }
+
+    void append(const struct tm& d);
+
+    /**
+     * the number of bytes appended so far
+     */
+    size_t size() const {
+        return _size + _pos;
+    }
+
+    /**
+     * copy the accumulated output into one contiguous string
+     */
+    sstring str() const;
+
+    /**
+     * move the accumulated chunks out, leaving the generator empty;
+     * useful for handing the output to a stream without copying
+     */
+    std::vector<temporary_buffer<char>> take();
+
+    /**
+     * write the accumulated output to the stream and leave the
+     * generator empty
+     */
+    future<> write(output_stream<char>& out);
+
+    /**
+     * forget the accumulated output but keep the current chunk, so a
+     * long-lived generator serializes repeatedly without reallocating
+     */
+    void clear();
+private:
+    char* reserve(size_t n);
+    void commit(size_t n) {
+        _pos += n;
+    }
+};
+
+}
+
+}
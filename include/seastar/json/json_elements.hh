@@ -21,13 +21,18 @@
 
 #pragma once
 
+#include <cstdlib>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <time.h>
 #include <sstream>
 #include <seastar/core/do_with.hh>
 #include <seastar/core/loop.hh>
 #include <seastar/json/formatter.hh>
+#include <seastar/json/generator.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/iostream.hh>
 
@@ -35,6 +40,88 @@ namespace seastar {
 
 namespace json {
 
+struct json_base;
+
+namespace internal {
+
+/**
+ * Assign a value from the text of a parsed json scalar. For strings the
+ * text is the unescaped characters; for numbers and booleans it is the
+ * literal token. Returns false when the token does not fit the type.
+ */
+template<typename T>
+bool assign_json_scalar(T& value, std::string_view text, bool is_string) {
+    if constexpr (std::is_same_v<T, sstring> || std::is_same_v<T, std::string>) {
+        value = T(text.data(), text.size());
+        return true;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        if (is_string || (text != "true" && text != "false")) {
+            return false;
+        }
+        value = text == "true";
+        return true;
+    } else if constexpr (std::is_same_v<T, char>) {
+        if (!is_string || text.size() != 1) {
+            return false;
+        }
+        value = text[0];
+        return true;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        if (is_string) {
+            return false;
+        }
+        // number tokens are short; a bounded copy buys strtod's parsing
+        char buf[64];
+        if (text.empty() || text.size() >= sizeof(buf)) {
+            return false;
+        }
+        std::memcpy(buf, text.data(), text.size());
+        buf[text.size()] = '\0';
+        char* end;
+        if constexpr (std::is_floating_point_v<T>) {
+            value = std::strtod(buf, &end);
+        } else if constexpr (std::is_signed_v<T>) {
+            value = std::strtoll(buf, &end, 10);
+        } else {
+            value = std::strtoull(buf, &end, 10);
+        }
+        return end == buf + text.size();
+    } else {
+        return false;
+    }
+}
+
+template<typename T, typename = void>
+struct has_flat_writer : std::false_type {};
+
+template<typename T>
+struct has_flat_writer<T, std::void_t<decltype(std::declval<const T&>().append(std::declval<generator&>()))>> : std::true_type {};
+
+/**
+ * Append a value to a generator in its json representation. Objects
+ * carrying a generated flat writer (an append(generator&) method, see
+ * scripts/seastar-json2code.py) write themselves; everything else goes
+ * through the formatter and an sstring temporary.
+ */
+template<typename T>
+void append_json_value(generator& g, const T& value) {
+    if constexpr (std::is_same_v<T, sstring> || std::is_same_v<T, std::string>) {
+        g.append_string(value);
+    } else if constexpr (std::is_same_v<T, char>) {
+        // a char promotes to int on the formatter::to_json path too
+        g.append(int(value));
+    } else if constexpr (std::is_same_v<T, bool> || std::is_arithmetic_v<T> || std::is_same_v<T, date_time>) {
+        g.append(value);
+    } else if constexpr (has_flat_writer<T>::value) {
+        value.append(g);
+    } else {
+        auto s = formatter::to_json(value);
+        g.append_raw(s.data(), s.size());
+    }
+}
+
+}
+
 /**
  * The base class for all json element.
  * Every json element has a name
@@ -78,6 +165,41 @@ public:
     virtual std::string to_string() = 0;
 
     virtual future<> write(output_stream<char>& s) const = 0;
+
+    /**
+     * Assign the element from a scalar parsed out of a json document by
+     * the streaming parser (see json/parser.hh).
+     * @return false when the value does not fit the element's type
+     */
+    virtual bool set_json_scalar(std::string_view text, bool is_string) {
+        return false;
+    }
+
+    /**
+     * The nested object to parse into when the element's value is a
+     * json object, or nullptr when the element does not hold one.
+     */
+    virtual json_base* json_object() {
+        return nullptr;
+    }
+
+    /// Prepare the element for a json array value; non-list elements
+    /// reject it.
+    virtual bool start_json_array() {
+        return false;
+    }
+
+    /// Append a scalar array item, as in set_json_scalar().
+    virtual bool add_json_array_scalar(std::string_view text, bool is_string) {
+        return false;
+    }
+
+    /// Append a nested object array item and return it, or nullptr when
+    /// the items are not objects.
+    virtual json_base* add_json_array_object() {
+        return nullptr;
+    }
+
     std::string _name;
     bool _mandatory;
     bool _set;
@@ -137,6 +259,31 @@ public:
     virtual future<> write(output_stream<char>& s) const override {
         return formatter::write(s, _value);
     }
+
+    /**
+     * Append the value to a generator; used by the flat writers
+     * json2code generates, bypassing the virtual element interface.
+     */
+    void append_value(generator& g) const {
+        internal::append_json_value(g, _value);
+    }
+
+    virtual bool set_json_scalar(std::string_view text, bool is_string) override {
+        if (!internal::assign_json_scalar(_value, text, is_string)) {
+            return false;
+        }
+        _set = true;
+        return true;
+    }
+
+    virtual json_base* json_object() override {
+        if constexpr (std::is_base_of_v<json_base, T>) {
+            _set = true;
+            return &_value;
+        } else {
+            return nullptr;
+        }
+    }
 private:
     T _value;
 };
@@ -180,6 +327,51 @@ public:
     virtual future<> write(output_stream<char>& s) const override {
         return formatter::write(s, _elements);
     }
+
+    /**
+     * Append the list to a generator as a json array; used by the flat
+     * writers json2code generates.
+     */
+    void append_value(generator& g) const {
+        g.append('[');
+        bool first = true;
+        for (const auto& e : _elements) {
+            if (!first) {
+                g.append(',');
+            }
+            first = false;
+            internal::append_json_value(g, e);
+        }
+        g.append(']');
+    }
+
+    virtual bool start_json_array() override {
+        _elements.clear();
+        _set = true;
+        return true;
+    }
+
+    virtual bool add_json_array_scalar(std::string_view text, bool is_string) override {
+        if constexpr (std::is_base_of_v<json_base, T>) {
+            return false;
+        } else {
+            T v{};
+            if (!internal::assign_json_scalar(v, text, is_string)) {
+                return false;
+            }
+            _elements.push_back(std::move(v));
+            return true;
+        }
+    }
+
+    virtual json_base* add_json_array_object() override {
+        if constexpr (std::is_base_of_v<json_base, T> && std::is_move_constructible_v<T>) {
+            _elements.emplace_back();
+            return &_elements.back();
+        } else {
+            return nullptr;
+        }
+    }
     std::vector<T> _elements;
 };
 
@@ -252,6 +444,19 @@ struct json_base : public jsonable {
     std::vector<json_base_element*> _elements;
 };
 
+/**
+ * Write an object carrying a generated flat writer (an
+ * append(generator&) method, see scripts/seastar-json2code.py) to a
+ * stream through a generator, moving the chunks out without copying.
+ */
+template<typename T>
+future<> write_flat(const T& obj, output_stream<char>& s) {
+    return do_with(generator(), [&obj, &s] (generator& g) {
+        obj.append(g);
+        return g.write(s);
+    });
+}
+
 /**
  * There are cases where a json request needs to return a successful
  * empty reply.
@@ -0,0 +1,133 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#pragma once
+
+#include <seastar/core/future.hh>
+#include <seastar/core/iostream.hh>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace seastar {
+
+namespace json {
+
+struct json_base;
+
+/// A malformed json document, or one that does not fit the object it is
+/// being parsed onto.
+class parse_error : public std::runtime_error {
+public:
+    explicit parse_error(const std::string& msg) : std::runtime_error(msg) {
+    }
+};
+
+/**
+ * Event receiver for the streaming parser. The views passed to the
+ * callbacks are valid only for the duration of the call: they point
+ * into the chunk being parsed, or into the parser's scratch space when
+ * a token crossed a chunk boundary or contained escapes.
+ */
+class sax_handler {
+public:
+    virtual ~sax_handler() = default;
+    virtual void start_object() = 0;
+    virtual void end_object() = 0;
+    virtual void start_array() = 0;
+    virtual void end_array() = 0;
+    virtual void on_key(std::string_view key) = 0;
+    /// A scalar value: the unescaped characters of a string, or the
+    /// literal text of a number, true, false or null.
+    virtual void on_scalar(std::string_view text, bool is_string) = 0;
+};
+
+/**
+ * An incremental, push-style json parser.
+ *
+ * Feed the document in chunks as they arrive from the wire; the state
+ * carries over between chunks, so the document never needs to be
+ * assembled into one buffer. Only a token that spans a chunk boundary
+ * or contains escapes goes through the parser's scratch buffer --
+ * everything else reaches the handler as a view into the chunk.
+ */
+class sax_parser {
+    enum class state : uint8_t {
+        value,          // expecting a value
+        array_value,    // expecting a value or ']'
+        object_key,     // expecting a key or '}'
+        object_colon,   // expecting ':'
+        object_comma,   // expecting ',' or '}'
+        array_comma,    // expecting ',' or ']'
+        string_body,    // inside a string
+        string_escape,  // after a backslash
+        string_unicode, // inside the hex digits of a \u escape
+        bare_token,     // inside a number, true, false or null
+        done,           // a complete top level value was consumed
+    };
+    sax_handler& _handler;
+    std::vector<char> _stack; // open containers, '{' or '['
+    state _state = state::value;
+    bool _parsing_key = false;
+    // a token carried across a chunk boundary or being unescaped
+    std::string _scratch;
+    bool _use_scratch = false;
+    uint16_t _unicode = 0;
+    uint8_t _unicode_left = 0;
+    uint16_t _high_surrogate = 0;
+public:
+    explicit sax_parser(sax_handler& handler) : _handler(handler) {
+    }
+    /// Consume one chunk of the document; throws parse_error on
+    /// malformed input.
+    void parse_chunk(std::string_view chunk);
+    /// Signal the end of the input; throws parse_error if the document
+    /// is incomplete.
+    void finish();
+    /// Has a complete top level value been consumed?
+    bool done() const {
+        return _state == state::done;
+    }
+private:
+    void after_value();
+    void close_container(char kind);
+    void end_string(std::string_view tail);
+    void append_utf8(uint32_t code_point);
+};
+
+/// Run the parser over a stream until the document completes or the
+/// stream ends; the handler sees the events as the chunks arrive.
+future<> parse(input_stream<char>& in, sax_handler& handler);
+
+/**
+ * Parse a json document from a stream onto a json_base object as
+ * generated by json2code: keys are matched against the object's
+ * registered elements, scalars are converted to the element's type,
+ * nested objects and arrays of scalars recurse, and unknown keys are
+ * skipped. Throws parse_error for malformed documents, for values that
+ * do not fit their element, and when a mandatory element remains unset.
+ */
+future<> parse(input_stream<char>& in, json_base& obj);
+
+}
+
+}
@@ -30,6 +30,9 @@
 #include <seastar/net/packet.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/core/iostream.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/util/noncopyable_function.hh>
 #include <seastar/util/std-compat.hh>
 #include "../core/internal/api-level.hh"
 #include <sys/types.h>
@@ -73,6 +76,30 @@ struct sctp_keepalive_params {
 
 using keepalive_params = std::variant<tcp_keepalive_params, sctp_keepalive_params>;
 
+/// Point-in-time transport-level statistics of a single TCP connection,
+/// as reported by the protocol implementation: TCP_INFO for the posix
+/// stack, the connection control block for the native stack. Cheap to
+/// collect, so suitable for periodic per-connection polling.
+struct tcp_connection_stats {
+    /// Smoothed round-trip time estimate
+    std::chrono::microseconds rtt{0};
+    /// Round-trip time variance
+    std::chrono::microseconds rtt_variance{0};
+    /// Sender maximum segment size, bytes
+    uint32_t mss = 0;
+    /// Congestion window, bytes
+    uint64_t congestion_window = 0;
+    /// Bytes accepted from the application but not yet put on the wire
+    uint64_t send_queue_bytes = 0;
+    /// Bytes on the wire not yet acknowledged by the peer
+    uint64_t unacked_bytes = 0;
+    /// Segments retransmitted over the lifetime of the connection
+    uint64_t retransmits = 0;
+    /// Rate at which the stack paces outgoing data, bytes per second;
+    /// zero when the connection is not paced
+    uint64_t pacing_rate = 0;
+};
+
 /// \cond internal
 class connected_socket_impl;
 class socket_impl;
@@ -89,6 +116,12 @@ public:
     virtual socket_address get_dst() = 0;
     virtual uint16_t get_dst_port() = 0;
     virtual packet& get_data() = 0;
+    // Non-zero when the datagram was coalesced from several wire datagrams
+    // of that size by receive offload (GRO)
+    virtual uint16_t gro_segment_size() { return 0; }
+    // Engaged when the stack captured a receive timestamp for this
+    // datagram (see offload_info::rx_timestamp)
+    virtual std::optional<std::chrono::steady_clock::time_point> rx_timestamp() { return std::nullopt; }
 };
 
 class udp_datagram final {
@@ -100,6 +133,15 @@ public:
     socket_address get_dst() { return _impl->get_dst(); }
     uint16_t get_dst_port() { return _impl->get_dst_port(); }
     packet& get_data() { return _impl->get_data(); }
+    /// Non-zero when the datagram was coalesced from several wire datagrams
+    /// of that size by receive offload (GRO); get_data() then holds the
+    /// segments back to back, with only the last one possibly shorter.
+    uint16_t gro_segment_size() { return _impl->gro_segment_size(); }
+    /// When the datagram was received, on the steady clock, when the
+    /// stack captured a timestamp for it. The posix stack timestamps every
+    /// datagram (kernel permitting); the native stack only a sampled
+    /// subset, so callers must cope with a disengaged result.
+    std::optional<std::chrono::steady_clock::time_point> rx_timestamp() { return _impl->rx_timestamp(); }
 };
 
 class udp_channel {
@@ -116,8 +158,27 @@ public:
     socket_address local_address() const;
 
     future<udp_datagram> receive();
+    /// Receives up to \c max datagrams in one call, completing as soon as
+    /// at least one is available. Where the stack queues datagrams per
+    /// device poll (the native stack), everything already queued is
+    /// delivered in one consumer wakeup instead of one task per datagram;
+    /// elsewhere this degrades to a single-datagram receive.
+    future<std::vector<udp_datagram>> receive_batch(size_t max);
     future<> send(const socket_address& dst, const char* msg);
     future<> send(const socket_address& dst, packet p);
+    /// Sends \c p as a train of datagrams carrying \c segment_size bytes
+    /// each (the last one may be shorter). Stacks with UDP segmentation
+    /// offload hand the whole buffer to the kernel in one call; others
+    /// fall back to carving it in software.
+    future<> send(const socket_address& dst, packet p, uint16_t segment_size);
+    /// Requests that datagrams arriving on this channel's port be spread
+    /// round-robin across all shards instead of by flow hash, for ports
+    /// whose traffic concentrates on a few flows. Takes effect on the
+    /// native stack when the device distributes packets in software; the
+    /// port must be bound (with redistribution enabled) on every shard,
+    /// and datagrams of one flow may then be delivered out of order.
+    /// Other stacks ignore the request. This is a hint and may be ignored.
+    void set_rx_redistribution(bool enable);
     bool is_closed() const;
     /// Causes a pending receive() to complete (possibly with an exception)
     void shutdown_input();
@@ -135,6 +196,10 @@ class network_interface_impl;
 
 } /* namespace net */
 
+namespace metrics {
+class label_instance;
+}
+
 /// \addtogroup networking-module
 /// @{
 
@@ -210,6 +275,74 @@ public:
     /// Linux users should refer to protocol-specific manuals
     /// to see available options, e.g. tcp(7), ip(7), etc.
     int get_sockopt(int level, int optname, void* data, size_t len) const;
+    /// Enables zero-copy transmission for writes of at least \c threshold
+    /// bytes (0 disables it). Instead of copying such writes into kernel
+    /// socket buffers, the kernel pins the user pages and the buffers are
+    /// kept alive until the kernel reports it is done with them, which
+    /// saves CPU on bulk transfers at the cost of per-write bookkeeping.
+    /// This is a hint and may be ignored: it takes effect only on streams
+    /// created by output() after this call, only on stacks and socket
+    /// families that support it (the posix stack over TCP, on kernels with
+    /// MSG_ZEROCOPY), and only for writes that reach the socket unbuffered
+    /// (see output_stream zero-copy handling of large writes).
+    void set_zerocopy_send(size_t threshold);
+    /// Enables zero-copy reception for reads of at least \c threshold
+    /// bytes (0 disables it). Instead of copying received data out of
+    /// kernel socket buffers, whole pages are mapped into the returned
+    /// buffer (TCP_ZEROCOPY_RECEIVE) and returned to the kernel when the
+    /// buffer is freed; small or unaligned residue still goes through
+    /// read(). Page mapping has a fixed per-read cost, so this only pays
+    /// off for bulk transfers — around 16 KiB per read and up. This is a
+    /// hint and may be ignored: it takes effect only on streams created
+    /// by input() after this call, and only on stacks, socket families
+    /// and kernels that support it (the posix stack over TCP).
+    void set_zerocopy_receive(size_t threshold);
+    /// Bounds the data queued behind a slow receiver to roughly \c bytes
+    /// (0 restores kernel defaults). Without it, a write completes as
+    /// soon as the kernel accepts the data, which it does until the whole
+    /// send buffer — megabytes of memory and latency — is full. With it,
+    /// the socket is set up with TCP_NOTSENT_LOWAT and a write completes
+    /// only once the unsent backlog drops below the watermark, so
+    /// backpressure reaches output_stream (and the application) while
+    /// the queue is still shallow. A sensible value is a few round trips
+    /// of bandwidth; too small a value costs throughput by draining the
+    /// queue between wakeups. Per-socket queue depth is observable as
+    /// the send_queue_bytes gauge of \ref register_stats_metrics(). This
+    /// is a hint and may be ignored: it takes effect only on streams
+    /// created by output() after this call, and only on stacks and
+    /// socket families that support it (the posix stack over TCP).
+    void set_notsent_lowat(size_t bytes);
+    /// Returns transport-level statistics of this connection (see
+    /// \ref net::tcp_connection_stats), or a disengaged optional when the
+    /// underlying protocol or stack does not expose them (e.g. unix
+    /// domain sockets). Useful to single out individual connections that
+    /// make no progress — a deep send queue with a small congestion
+    /// window or mounting retransmits points at a slow or lossy peer.
+    std::optional<net::tcp_connection_stats> get_tcp_stats() const;
+    /// Registers gauges exposing this connection's \ref get_tcp_stats()
+    /// values with the metrics subsystem under group \c group_name.
+    /// \c labels are applied to every metric and are how the caller
+    /// tells connections apart (e.g. a peer-address label instance).
+    /// Dropping the returned handle unregisters the metrics; the handle
+    /// must not outlive the socket.
+    metrics::metric_groups register_stats_metrics(const sstring& group_name, std::vector<metrics::label_instance> labels);
+    /// True when the underlying stack can move this connection between
+    /// shards with \ref migrate().
+    bool can_migrate() const noexcept;
+    /// Moves this established connection to another shard without
+    /// resetting it, so a rebalancer can correct the placement chosen at
+    /// accept time. Consumes this socket; \c consumer runs on \c shard
+    /// with the rebuilt socket, from which fresh streams are created.
+    ///
+    /// The connection must be quiescent: no outstanding send or receive,
+    /// and any input_stream or output_stream fully drained or flushed
+    /// and then discarded via their detach() method — closing them would
+    /// shut down the connection, and buffered stream state cannot cross
+    /// shards. The returned future resolves, on the calling shard, once
+    /// the consumer has run. Fails when \ref can_migrate() is false
+    /// (e.g. the native stack, where packet steering pins a connection
+    /// to the shard its flow hashes to).
+    future<> migrate(shard_id shard, noncopyable_function<void (connected_socket)> consumer);
 
     /// Disables output to the socket.
     ///
@@ -258,6 +391,15 @@ public:
     /// Gets O_REUSEADDR option
     /// \return whether the reuseaddr option is enabled or not
     bool get_reuseaddr() const;
+    /// Requests a TCP Fast Open connect (TCP_FASTOPEN_CONNECT).
+    ///
+    /// When enabled, \ref connect() completes without waiting for the
+    /// handshake and the first write rides the SYN, saving a round trip
+    /// when reconnecting to a server that has handed out a TFO cookie.
+    /// Connection errors are consequently reported by the first I/O
+    /// operation instead of by connect(). Must be called before
+    /// \ref connect(); stacks and kernels without TFO support ignore it.
+    void set_fastopen_connect(bool enabled);
     /// Stops any in-flight connection attempt.
     ///
     /// Cancels the connection attempt if it's still in progress, and
@@ -292,6 +434,13 @@ public:
         port,
         // This algorithm distributes all new connections to listen_options::fixed_cpu shard only.
         fixed,
+        // This algorithm distributes a new connection to the shard pinned to the
+        // cpu where the kernel delivers the connection's packets (SO_INCOMING_CPU),
+        // so RX softirq processing and the owning shard share a core and packets
+        // never cross cpus on their way in. Falls back to connection_distribution
+        // when the delivery cpu hosts no shard (e.g. thread affinity disabled, or
+        // more RSS queues than shards).
+        incoming_cpu,
         default_ = connection_distribution
     };
     /// Constructs a \c server_socket not corresponding to a connection
@@ -332,6 +481,17 @@ struct listen_options {
     transport proto = transport::TCP;
     int listen_backlog = 100;
     unsigned fixed_cpu = 0u;
+    // Depth of the TCP Fast Open queue (TCP_FASTOPEN). When non-zero, the
+    // kernel completes handshakes from clients presenting a valid TFO
+    // cookie without waiting for the final ACK, so data carried on the SYN
+    // is available on the first read. Ignored for non-TCP sockets.
+    int fastopen_queue_depth = 0;
+    // Delay waking accept() until the first data segment arrives, or the
+    // timeout expires (TCP_DEFER_ACCEPT). Saves a wakeup-and-wait round for
+    // request/response protocols, which cannot make progress on a freshly
+    // accepted connection until the request shows up anyway. A zero timeout
+    // leaves the option off. Ignored for non-TCP sockets.
+    std::chrono::seconds defer_accept_timeout = std::chrono::seconds(0);
     void set_fixed_cpu(unsigned cpu) {
         lba = server_socket::load_balancing_algorithm::fixed;
         fixed_cpu = cpu;
@@ -86,6 +86,16 @@ public:
             tcp_port, udp_port;
         std::optional<std::vector<sstring>>
             domains;
+        // Lifetime of cached name lookups. The hostent interface of
+        // c-ares does not expose per-record TTLs, so cached entries live
+        // for this long (default 5s; hot entries are refreshed in the
+        // background at half-life, so they rarely expire). Zero disables
+        // caching.
+        std::optional<std::chrono::milliseconds>
+            cache_ttl;
+        // Lifetime of cached resolution failures (default 1s)
+        std::optional<std::chrono::milliseconds>
+            negative_cache_ttl;
     };
 
     enum class srv_proto {
@@ -126,6 +136,13 @@ public:
                                         const sstring& service,
                                         const sstring& domain);
 
+    /**
+     * Drops all cached name lookups, or those for a single name.
+     * Subsequent queries go back to the wire.
+     */
+    void invalidate_cache();
+    void invalidate_cache(const sstring& name);
+
     /**
      * Shuts the object down. Great for tests.
      */
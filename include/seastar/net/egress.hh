@@ -0,0 +1,92 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#pragma once
+
+#include <seastar/core/fair_queue.hh>
+#include <seastar/core/iostream.hh>
+#include <seastar/core/scheduling.hh>
+#include <array>
+
+namespace seastar {
+namespace net {
+
+/// \brief Scheduling-group-aware network egress scheduler.
+///
+/// Disk I/O is prioritized via \ref fair_queue, but network writes from
+/// all scheduling groups otherwise share the socket path unprioritized,
+/// so a bulk transfer can starve small latency-sensitive writes on the
+/// same NIC. An egress_scheduler sits between an output stream's
+/// \ref data_sink and the socket: each transmit batch waits for a
+/// fair-queue ticket sized by the batch length and charged to the
+/// writer's current scheduling group, so batches reach the socket in
+/// proportion to the groups' egress shares.
+///
+/// One instance covers one NIC's traffic on one shard; decorate each
+/// connection's sink with \ref wrap(). Since the scheduler operates
+/// above the socket's data_sink it works with both the posix and the
+/// native stack.
+class egress_scheduler {
+public:
+    struct config {
+        /// how many transmit batches may be in flight towards the socket layer
+        unsigned max_requests = 128;
+        /// how many bytes may be in flight towards the socket layer
+        size_t max_bytes = 1 << 20;
+    };
+private:
+    class egress_sink;
+    struct waiter;
+
+    // ticket sizes are in 512-byte units, like the I/O queue's
+    static constexpr unsigned ticket_size_shift = 9;
+    static constexpr uint32_t default_shares = 100;
+
+    fair_group _group;
+    fair_queue _fq;
+    uint32_t _max_ticket_size;
+    std::array<priority_class_ptr, max_scheduling_groups()> _classes = {};
+
+    priority_class_ptr pclass(scheduling_group sg);
+    fair_queue_ticket make_ticket(size_t bytes) const noexcept;
+    future<> get_ticket(scheduling_group sg, fair_queue_ticket ticket);
+    void put_ticket(fair_queue_ticket ticket) noexcept;
+    void dispatch();
+public:
+    egress_scheduler();
+    explicit egress_scheduler(config cfg);
+    ~egress_scheduler();
+
+    egress_scheduler(const egress_scheduler&) = delete;
+    egress_scheduler& operator=(const egress_scheduler&) = delete;
+
+    /// Decorates \c sink so every put() first passes through this
+    /// scheduler, charged to the caller's current scheduling group.
+    ///
+    /// The scheduler must outlive all sinks wrapped by it.
+    data_sink wrap(data_sink sink);
+
+    /// Adjusts the egress shares of \c sg; all groups start at 100.
+    void update_shares(scheduling_group sg, uint32_t shares);
+};
+
+}
+}
@@ -28,15 +28,15 @@
 #include <cstdint>
 #include <array>
 #include <map>
-#include <list>
 #include <chrono>
+#include <boost/intrusive/list.hpp>
 #include <seastar/core/array_map.hh>
 #include <seastar/net/byteorder.hh>
 #include <seastar/core/byteorder.hh>
 #include <seastar/net/arp.hh>
 #include <seastar/net/ip_checksum.hh>
 #include <seastar/net/const.hh>
-#include <seastar/net/packet-util.hh>
+#include <seastar/net/packet.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/net/toeplitz.hh>
 #include <seastar/net/udp.hh>
@@ -309,6 +309,9 @@ private:
     std::unordered_map<uint16_t, lw_shared_ptr<udp_channel_state>> _channels;
     int _queue_size = default_queue_size;
     uint16_t _next_anonymous_port = min_anonymous_port;
+    // Rotated into the forwarding hash of redistributed ports so
+    // consecutive datagrams land on different shards
+    uint16_t _spray_counter = 0;
     circular_buffer<ipv4_traits::l4packet> _packetq;
 private:
     uint16_t next_port(uint16_t port);
@@ -375,9 +378,6 @@ struct ipv4_frag_id::hash : private std::hash<ipv4_address>,
     }
 };
 
-struct ipv4_tag {};
-using ipv4_packet_merger = packet_merger<uint32_t, ipv4_tag>;
-
 class ipv4 {
 public:
     using clock_type = lowres_clock;
@@ -400,8 +400,19 @@ private:
     array_map<ip_protocol*, 256> _l4;
     ip_packet_filter * _packet_filter = nullptr;
     struct frag {
+        // A hole-free run of payload: fragments landing adjacent to a run
+        // are joined by chaining their buffers onto the run's packet, not
+        // by copying.
+        struct seg {
+            uint32_t offset;
+            packet p;
+        };
+        ipv4_frag_id id;
+        boost::intrusive::list_member_hook<> age_link;
         packet header;
-        ipv4_packet_merger data;
+        // Runs sorted by offset and non-overlapping; in-order arrival
+        // keeps this at a single element.
+        std::vector<seg> segs;
         clock_type::time_point rx_time;
         uint32_t mem_size = 0;
         // fragment with MF == 0 inidates it is the last fragment
@@ -409,13 +420,19 @@ private:
 
         packet get_assembled_packet(ethernet_address from, ethernet_address to);
         int32_t merge(ip_hdr &h, uint16_t offset, packet p);
+        void insert_data(uint32_t offset, packet p);
         bool is_complete();
     };
+    using frag_age_list = boost::intrusive::list<frag,
+        boost::intrusive::member_hook<frag, boost::intrusive::list_member_hook<>, &frag::age_link>>;
     std::unordered_map<ipv4_frag_id, frag, ipv4_frag_id::hash> _frags;
-    std::list<ipv4_frag_id> _frags_age;
+    // Oldest first; entries are unlinked in O(1) via their hook.
+    frag_age_list _frags_age;
     static constexpr std::chrono::seconds _frag_timeout{30};
     static constexpr uint32_t _frag_low_thresh{3 * 1024 * 1024};
     static constexpr uint32_t _frag_high_thresh{4 * 1024 * 1024};
+    static constexpr size_t _frag_max_flows{1024};
+    static constexpr size_t _frag_expiry_batch{256};
     uint32_t _frag_mem{0};
     timer<lowres_clock> _frag_timer;
     circular_buffer<l3_protocol::l3packet> _packetq;
@@ -428,7 +445,7 @@ private:
     bool in_my_netmask(ipv4_address a) const;
     void frag_limit_mem();
     void frag_timeout();
-    void frag_drop(ipv4_frag_id frag_id, uint32_t dropped_size);
+    void frag_drop(frag& frag) noexcept;
     void frag_arm(clock_type::time_point now) {
         auto tp = now + _frag_timeout;
         _frag_timer.arm(tp);
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <seastar/core/smp.hh>
+#include <seastar/core/circular_buffer.hh>
 #include <seastar/core/deleter.hh>
 #include <seastar/core/queue.hh>
 #include <seastar/core/stream.hh>
@@ -30,6 +31,7 @@
 #include <seastar/net/ethernet.hh>
 #include <seastar/net/packet.hh>
 #include <seastar/net/const.hh>
+#include <chrono>
 #include <unordered_map>
 
 namespace seastar {
@@ -48,6 +50,12 @@ class device;
 class qp;
 class l3_protocol;
 
+// Records a packet carrying a sampled rx timestamp (see
+// offload_info::rx_timestamp) into this shard's delivery latency
+// histogram. Protocols call this at the point the payload becomes
+// readable by the application; packets without a timestamp are ignored.
+void record_rx_delivery(const packet& p);
+
 class forward_hash {
     uint8_t data[64];
     size_t end_idx = 0;
@@ -123,8 +131,32 @@ class interface {
     ethernet_address _hw_address;
     net::hw_features _hw_features;
     std::vector<l3_protocol::packet_provider_type> _pkt_providers;
+    // Software receive aggregation (GRO): consecutive in-order TCP/IPv4
+    // segments of one connection arriving within a single poll batch are
+    // merged into one packet before protocol processing.
+    struct gro_flow {
+        packet p;
+        ethernet_address from;
+        l3_rx_stream* l3;
+        uint32_t src_ip;
+        uint32_t dst_ip;
+        uint16_t src_port;
+        uint16_t dst_port;
+        uint32_t next_seq;
+        uint32_t ack;
+        uint16_t window;
+        uint32_t total_len;
+        unsigned segments;
+    };
+    static constexpr size_t max_gro_flows = 8;
+    static constexpr unsigned max_gro_segments = 64;
+    std::vector<gro_flow> _gro_flows;
+    bool _gro_flush_scheduled = false;
 private:
     future<> dispatch_packet(packet p);
+    bool gro_receive(packet& p, ethernet_address from, l3_rx_stream& l3);
+    void flush_gro_flow(gro_flow& flow);
+    void flush_gro();
 public:
     explicit interface(std::shared_ptr<device> dev);
     ethernet_address hw_address() { return _hw_address; }
@@ -264,6 +296,10 @@ class device {
 protected:
     std::unique_ptr<qp*[]> _queues;
     size_t _rss_table_bits = 0;
+    // One packet in this many gets an rx timestamp; keeps the extra clock
+    // read off most of the hot path while still feeding the latency
+    // histograms steadily under load.
+    static constexpr unsigned rx_timestamp_sample_rate = 64;
 public:
     device() {
         _queues = std::make_unique<qp*[]>(smp::count);
@@ -272,6 +308,16 @@ public:
     qp& queue_for_cpu(unsigned cpu) { return *_queues[cpu]; }
     qp& local_queue() { return queue_for_cpu(this_shard_id()); }
     void l2receive(packet p) {
+        static thread_local unsigned sample_counter;
+        if (++sample_counter >= rx_timestamp_sample_rate) {
+            sample_counter = 0;
+            auto& oi = p.offload_info_ref();
+            // a packet forwarded from another shard, or timestamped by
+            // the stack below us, keeps its original stamp
+            if (!oi.rx_timestamp) {
+                oi.rx_timestamp = std::chrono::steady_clock::now();
+            }
+        }
         // FIXME: future is discarded
         (void)_queues[this_shard_id()]->_rx_stream.produce(std::move(p));
     }
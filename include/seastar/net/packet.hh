@@ -27,12 +27,79 @@
 #include <vector>
 #include <cassert>
 #include <algorithm>
+#include <chrono>
 #include <iosfwd>
 #include <seastar/util/std-compat.hh>
 #include <functional>
 
 namespace seastar {
 
+namespace internal {
+
+// Per-shard recycling arena for net::packet::impl allocations. The impl
+// header and its fragment array are carved from a single fixed-size
+// chunk; a destroyed packet returns its chunk to a small free list, so
+// steady-state packet assembly and teardown do not touch the allocator.
+// Chunks are only recycled when freed on the owning shard; a packet
+// that dies on a foreign cpu (see packet::free_on_cpu()) falls back to
+// the regular allocator, which knows how to return foreign memory.
+class packet_arena {
+    struct chunk_header {
+        union {
+            packet_arena* owner; // while allocated; nullptr if oversized
+            chunk_header* next;  // while on the free list
+        };
+    };
+    // enough for impl plus a generous fragment array
+    static constexpr size_t chunk_size = 512;
+    static constexpr size_t max_free_chunks = 512;
+    static constexpr size_t header_size = alignof(std::max_align_t);
+    static_assert(sizeof(chunk_header) <= header_size);
+    chunk_header* _free = nullptr;
+    size_t _nr_free = 0;
+public:
+    ~packet_arena() {
+        while (_free) {
+            auto c = _free;
+            _free = c->next;
+            ::operator delete(c);
+        }
+    }
+    void* allocate(size_t size) {
+        chunk_header* h;
+        if (header_size + size <= chunk_size) {
+            if (_free) {
+                h = _free;
+                _free = h->next;
+                --_nr_free;
+            } else {
+                h = static_cast<chunk_header*>(::operator new(chunk_size));
+            }
+            h->owner = this;
+        } else {
+            h = static_cast<chunk_header*>(::operator new(header_size + size));
+            h->owner = nullptr;
+        }
+        return reinterpret_cast<char*>(h) + header_size;
+    }
+    void free(void* ptr) noexcept {
+        auto h = reinterpret_cast<chunk_header*>(static_cast<char*>(ptr) - header_size);
+        if (h->owner == this && _nr_free < max_free_chunks) {
+            h->next = _free;
+            _free = h;
+            ++_nr_free;
+        } else {
+            ::operator delete(h);
+        }
+    }
+    static packet_arena& local() noexcept {
+        static thread_local packet_arena arena;
+        return arena;
+    }
+};
+
+}
+
 namespace net {
 
 struct fragment {
@@ -51,6 +118,11 @@ struct offload_info {
     uint16_t tso_seg_size = 0;
     // HW stripped VLAN header (CPU order)
     std::optional<uint16_t> vlan_tci;
+    // When the packet was received. Engaged only for a sampled subset of
+    // rx packets; stamped as the packet leaves the device layer, or
+    // earlier when the stack can get a timestamp from the kernel or the
+    // device. Feeds the rx latency histograms.
+    std::optional<std::chrono::steady_clock::time_point> rx_timestamp;
 };
 
 // Zero-copy friendly packet class
@@ -141,15 +213,15 @@ class packet final {
         }
         void* operator new(size_t size, size_t nr_frags = default_nr_frags) {
             assert(nr_frags == uint16_t(nr_frags));
-            return ::operator new(size + nr_frags * sizeof(fragment));
+            return internal::packet_arena::local().allocate(size + nr_frags * sizeof(fragment));
         }
         // Matching the operator new above
         void operator delete(void* ptr, size_t nr_frags) {
-            return ::operator delete(ptr);
+            return internal::packet_arena::local().free(ptr);
         }
         // Since the above "placement delete" hides the global one, expose it
         void operator delete(void* ptr) {
-            return ::operator delete(ptr);
+            return internal::packet_arena::local().free(ptr);
         }
 
         bool using_internal_data() const noexcept {
@@ -27,6 +27,7 @@
 #include <seastar/core/polymorphic_temporary_buffer.hh>
 #include <seastar/core/internal/buffer_allocator.hh>
 #include <boost/program_options.hpp>
+#include <deque>
 
 namespace seastar {
 
@@ -60,6 +61,10 @@ class conntrack {
             _cpu_load[cpu]++;
             return cpu;
         }
+        void moved_cpu(shard_id from, shard_id to) {
+            _cpu_load[from]--;
+            _cpu_load[to]++;
+        }
     };
 
     lw_shared_ptr<load_balancer> _lb;
@@ -92,6 +97,21 @@ public:
         shard_id cpu() {
             return _target_cpu;
         }
+        // Re-accounts the tracked connection to cpu when it migrates
+        // there (see connected_socket::migrate())
+        void move_to(shard_id cpu) {
+            if (!_lb) {
+                return;
+            }
+            if (cpu == _target_cpu) {
+                return;
+            }
+            // FIXME: future is discarded
+            (void)smp::submit_to(_host_cpu, [lb = &*_lb, from = _target_cpu, to = cpu] {
+                lb->moved_cpu(from, to);
+            });
+            _target_cpu = cpu;
+        }
     };
     friend class handle;
 
@@ -108,12 +128,22 @@ class posix_data_source_impl final : public data_source_impl, private internal::
     std::pmr::polymorphic_allocator<char>* _buffer_allocator;
     pollable_fd _fd;
     connected_socket_input_stream_config _config;
+    // TCP_ZEROCOPY_RECEIVE state: reads of at least _zerocopy_threshold
+    // bytes map the received pages into the returned buffer instead of
+    // copying them out of the kernel; cleared on the first failure so
+    // unsupported sockets pay the probing cost only once.
+    size_t _zerocopy_threshold;
 private:
     virtual temporary_buffer<char> allocate_buffer() override;
+    future<temporary_buffer<char>> do_get();
+    temporary_buffer<char> try_zerocopy_receive();
+    void adjust_buffer_size(size_t last_read);
 public:
     explicit posix_data_source_impl(pollable_fd fd, connected_socket_input_stream_config config,
-            std::pmr::polymorphic_allocator<char>* allocator=memory::malloc_allocator)
-            : _buffer_allocator(allocator), _fd(std::move(fd)), _config(config) {
+            std::pmr::polymorphic_allocator<char>* allocator=memory::malloc_allocator,
+            size_t zerocopy_threshold = 0)
+            : _buffer_allocator(allocator), _fd(std::move(fd)), _config(config)
+            , _zerocopy_threshold(zerocopy_threshold) {
     }
     future<temporary_buffer<char>> get() override;
     future<> close() override;
@@ -122,12 +152,30 @@ public:
 class posix_data_sink_impl : public data_sink_impl {
     pollable_fd _fd;
     packet _p;
+    // MSG_ZEROCOPY state: writes of at least _zerocopy_threshold bytes are
+    // sent without copying into the kernel. Each successful zero-copy
+    // sendmsg() consumes one sequence number; the packet backing a send is
+    // parked in _zc_inflight, keyed by the last sequence number it used,
+    // until the kernel acknowledges that range on the socket error queue.
+    const size_t _zerocopy_threshold;
+    // TCP_NOTSENT_LOWAT is set on the socket: a put() completes only once
+    // poll-out readiness reports the unsent backlog below the watermark,
+    // so backpressure reaches the caller while the queue is shallow.
+    const bool _notsent_lowat;
+    uint32_t _zc_seq = 0;
+    std::deque<std::pair<uint32_t, packet>> _zc_inflight;
 public:
-    explicit posix_data_sink_impl(pollable_fd fd) : _fd(std::move(fd)) {}
+    explicit posix_data_sink_impl(pollable_fd fd, size_t zerocopy_threshold = 0, bool notsent_lowat = false)
+        : _fd(std::move(fd)), _zerocopy_threshold(zerocopy_threshold), _notsent_lowat(notsent_lowat) {}
     using data_sink_impl::put;
     future<> put(packet p) override;
     future<> put(temporary_buffer<char> buf) override;
     future<> close() override;
+private:
+    future<> zerocopy_put(packet p);
+    void reap_zerocopy_acks();
+    future<> drain_zerocopy_acks();
+    future<> wait_unsent_below_lowat();
 };
 
 class posix_ap_server_socket_impl : public server_socket_impl {
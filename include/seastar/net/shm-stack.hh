@@ -0,0 +1,54 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#pragma once
+
+#include <seastar/net/posix-stack.hh>
+
+namespace seastar {
+
+namespace net {
+
+/// A network stack for co-located Seastar processes.
+///
+/// Behaves exactly like the posix stack, except that connections over
+/// unix-domain addresses bypass the kernel network stack: the unix socket
+/// is used only to hand a shared-memory segment and doorbell eventfds to
+/// the peer, after which data flows through a pair of single-producer
+/// single-consumer rings mapped into both processes. The receive side
+/// hands out \ref temporary_buffer views directly into the ring, so
+/// same-host IPC pays one copy (into the ring) instead of two syscalls
+/// and two copies per message.
+class shm_network_stack : public posix_network_stack {
+public:
+    explicit shm_network_stack(boost::program_options::variables_map opts, std::pmr::polymorphic_allocator<char>* allocator=memory::malloc_allocator);
+    virtual server_socket listen(socket_address sa, listen_options opts) override;
+    virtual ::seastar::socket socket() override;
+    static future<std::unique_ptr<network_stack>> create(boost::program_options::variables_map opts, std::pmr::polymorphic_allocator<char>* allocator=memory::malloc_allocator) {
+        return make_ready_future<std::unique_ptr<network_stack>>(std::unique_ptr<network_stack>(new shm_network_stack(opts, allocator)));
+    }
+};
+
+void register_shm_stack();
+
+}
+
+}
@@ -32,6 +32,14 @@ namespace net {
 /// \cond internal
 class connected_socket_impl {
 public:
+    // Shard-independent remains of a migrating socket: produced on the
+    // source shard by detach_for_migration() and rebuilt into a new impl
+    // on the target shard by attach() (see connected_socket::migrate()).
+    class migration_state {
+    public:
+        virtual ~migration_state() {}
+        virtual std::unique_ptr<connected_socket_impl> attach() = 0;
+    };
     virtual ~connected_socket_impl() {}
     virtual data_source source() = 0;
     virtual data_source source(connected_socket_input_stream_config csisc);
@@ -46,6 +54,17 @@ public:
     virtual keepalive_params get_keepalive_parameters() const = 0;
     virtual void set_sockopt(int level, int optname, const void* data, size_t len) = 0;
     virtual int get_sockopt(int level, int optname, void* data, size_t len) const = 0;
+    virtual void set_zerocopy_send(size_t threshold);
+    virtual void set_zerocopy_receive(size_t threshold);
+    virtual void set_notsent_lowat(size_t bytes);
+    virtual std::optional<tcp_connection_stats> get_tcp_stats() const;
+    // Whether this socket can be moved between shards. Stacks answering
+    // true override detach_for_migration() as well; the default is false.
+    virtual bool can_migrate() const noexcept;
+    // Consumes the socket's shard-bound resources into a migration_state.
+    // Called only when can_migrate() and with no outstanding operations;
+    // the impl is discarded afterwards.
+    virtual std::unique_ptr<migration_state> detach_for_migration();
 };
 
 class socket_impl {
@@ -54,6 +73,7 @@ public:
     virtual future<connected_socket> connect(socket_address sa, socket_address local, transport proto = transport::TCP) = 0;
     virtual void set_reuseaddr(bool reuseaddr) = 0;
     virtual bool get_reuseaddr() const = 0;
+    virtual void set_fastopen_connect(bool enabled);
     virtual void shutdown() = 0;
 };
 
@@ -71,8 +91,20 @@ public:
     virtual ~udp_channel_impl() {}
     virtual socket_address local_address() const = 0;
     virtual future<udp_datagram> receive() = 0;
+    // Receive up to max datagrams in one call. The default implementation
+    // waits for a single datagram; stacks that queue datagrams per device
+    // poll override it to drain the queue in one consumer wakeup.
+    virtual future<std::vector<udp_datagram>> receive_batch(size_t max);
     virtual future<> send(const socket_address& dst, const char* msg) = 0;
     virtual future<> send(const socket_address& dst, packet p) = 0;
+    // Send p as a train of segment_size-byte datagrams. The default
+    // implementation carves the packet in software; stacks with
+    // segmentation offload override it.
+    virtual future<> send(const socket_address& dst, packet p, uint16_t segment_size);
+    // Spread this port's datagrams over all shards instead of by flow
+    // hash. The default implementation ignores the request; stacks with
+    // a software receive-distribution stage override it.
+    virtual void set_rx_redistribution(bool enable);
     virtual void shutdown_input() = 0;
     virtual void shutdown_output() = 0;
     virtual bool is_closed() const = 0;
@@ -95,7 +95,7 @@ void tcp_debug(const char* fmt, Args&&... args) {
 
 struct tcp_option {
     // The kind and len field are fixed and defined in TCP protocol
-    enum class option_kind: uint8_t { mss = 2, win_scale = 3, sack = 4, timestamps = 8,  nop = 1, eol = 0 };
+    enum class option_kind: uint8_t { mss = 2, win_scale = 3, sack = 4, sack_block = 5, timestamps = 8,  nop = 1, eol = 0 };
     enum class option_len:  uint8_t { mss = 4, win_scale = 3, sack = 2, timestamps = 10, nop = 1, eol = 1 };
     static void write(char* p, option_kind kind, option_len len) {
         p[0] = static_cast<uint8_t>(kind);
@@ -189,6 +189,15 @@ struct tcp_option {
     uint16_t _local_mss;
     uint8_t _remote_win_scale = 0;
     uint8_t _local_win_scale = 0;
+
+    // SACK (RFC 2018). A SACK block option holds at most 3 blocks here
+    // since it shares the option space with nothing else but padding.
+    static constexpr uint8_t max_sack_blocks = 3;
+    // Blocks reported by the peer in the last parsed segment, as
+    // (start, end) sequence ranges in host sequence space
+    std::vector<std::pair<uint32_t, uint32_t>> _sack_blocks_received;
+    // Blocks to advertise in the next outgoing segment
+    std::vector<std::pair<uint32_t, uint32_t>> _sack_blocks_to_send;
 };
 inline char*& operator+=(char*& x, tcp_option::option_len len) { x += uint8_t(len); return x; }
 inline const char*& operator+=(const char*& x, tcp_option::option_len len) { x += uint8_t(len); return x; }
@@ -287,6 +296,105 @@ struct tcp_hdr {
 struct tcp_tag {};
 using tcp_packet_merger = packet_merger<tcp_seq, tcp_tag>;
 
+/// View of the tcb state a congestion controller may inspect and adjust.
+/// The window fields reference the tcb's own counters so the rest of the
+/// send path keeps reading them as before.
+struct tcp_congestion_state {
+    uint32_t& cwnd;
+    uint32_t& ssthresh;
+    uint16_t smss;
+    uint32_t flight_size;
+    std::chrono::milliseconds srtt;
+};
+
+/// \brief Congestion control policy for the native TCP stack.
+///
+/// The tcb reports protocol events (acknowledgments, duplicate ACKs,
+/// retransmission timeouts) and the controller updates the congestion
+/// window and slow start threshold. A controller may additionally impose
+/// a pacing rate; the tcb then spreads segments over time using a
+/// reactor timer instead of transmitting the whole window back to back.
+class tcp_congestion_controller {
+public:
+    virtual ~tcp_congestion_controller() {}
+    // Connection established; peer_window is the initial send window
+    virtual void on_established(tcp_congestion_state s, uint32_t peer_window) = 0;
+    // acked_bytes of new data were cumulatively acknowledged
+    virtual void on_ack(tcp_congestion_state s, uint32_t acked_bytes) = 0;
+    // Third duplicate ACK; entered is false when RFC6582 suppressed
+    // re-entering fast retransmit
+    virtual void on_fast_retransmit(tcp_congestion_state s, uint32_t limited_transfer, bool entered) = 0;
+    // Fourth and subsequent duplicate ACKs in fast recovery
+    virtual void on_dup_ack(tcp_congestion_state s) = 0;
+    // Partial ACK during fast recovery (RFC 6582)
+    virtual void on_partial_ack(tcp_congestion_state s, uint32_t acked_bytes) = 0;
+    // Full ACK, leaving fast recovery
+    virtual void on_full_ack(tcp_congestion_state s) = 0;
+    // Retransmission timeout fired
+    virtual void on_retransmit_timeout(tcp_congestion_state s, bool first_retransmit) = 0;
+    // A clean round-trip time measurement became available
+    virtual void on_rtt_sample(tcp_congestion_state s, std::chrono::milliseconds rtt) {}
+    // Bytes per second the tcb may put on the wire, or disengaged when
+    // the controller is window-limited only
+    virtual std::optional<uint64_t> pacing_rate() const { return std::nullopt; }
+};
+
+/// Loss-based controller implementing RFC 5681 slow start and congestion
+/// avoidance with RFC 6582 NewReno fast recovery. This is the behaviour
+/// that used to be hardwired into the tcb.
+class tcp_reno_controller final : public tcp_congestion_controller {
+public:
+    virtual void on_established(tcp_congestion_state s, uint32_t peer_window) override;
+    virtual void on_ack(tcp_congestion_state s, uint32_t acked_bytes) override;
+    virtual void on_fast_retransmit(tcp_congestion_state s, uint32_t limited_transfer, bool entered) override;
+    virtual void on_dup_ack(tcp_congestion_state s) override;
+    virtual void on_partial_ack(tcp_congestion_state s, uint32_t acked_bytes) override;
+    virtual void on_full_ack(tcp_congestion_state s) override;
+    virtual void on_retransmit_timeout(tcp_congestion_state s, bool first_retransmit) override;
+};
+
+/// Rate-based controller in the spirit of BBR: estimates the bottleneck
+/// bandwidth from delivery rate samples and the propagation delay from a
+/// windowed minimum RTT, paces transmissions at the estimated bandwidth
+/// and caps the window at twice the bandwidth-delay product. Losses do
+/// not shrink the window; only a retransmission timeout resets the
+/// model. Pacing avoids the line-rate bursts that overrun shallow switch
+/// buffers in incast-heavy topologies.
+class tcp_rate_based_controller final : public tcp_congestion_controller {
+    static constexpr unsigned nr_bw_samples = 8;
+    // Windowed max filter of delivery rate samples, bytes per second
+    std::array<uint64_t, nr_bw_samples> _bw = {};
+    unsigned _bw_slot = 0;
+    uint64_t _delivered = 0;
+    lowres_clock::time_point _sample_start;
+    std::chrono::milliseconds _min_rtt{0};
+    lowres_clock::time_point _min_rtt_stamp;
+    enum class phase { startup, drain, probe };
+    phase _phase = phase::startup;
+    unsigned _probe_slot = 0;
+    // Bandwidth plateau detection for leaving startup
+    uint64_t _full_bw = 0;
+    unsigned _full_bw_count = 0;
+    uint64_t _pacing = 0;
+private:
+    uint64_t max_bw() const;
+    void advance_phase(tcp_congestion_state s);
+public:
+    virtual void on_established(tcp_congestion_state s, uint32_t peer_window) override;
+    virtual void on_ack(tcp_congestion_state s, uint32_t acked_bytes) override;
+    virtual void on_fast_retransmit(tcp_congestion_state s, uint32_t limited_transfer, bool entered) override;
+    virtual void on_dup_ack(tcp_congestion_state s) override;
+    virtual void on_partial_ack(tcp_congestion_state s, uint32_t acked_bytes) override;
+    virtual void on_full_ack(tcp_congestion_state s) override;
+    virtual void on_retransmit_timeout(tcp_congestion_state s, bool first_retransmit) override;
+    virtual void on_rtt_sample(tcp_congestion_state s, std::chrono::milliseconds rtt) override;
+    virtual std::optional<uint64_t> pacing_rate() const override;
+};
+
+enum class tcp_congestion_algorithm { reno, rate_based };
+
+std::unique_ptr<tcp_congestion_controller> make_tcp_congestion_controller(tcp_congestion_algorithm algo);
+
 template <typename InetTraits>
 class tcp {
 public:
@@ -325,6 +433,9 @@ private:
             uint16_t data_len;
             unsigned nr_transmits;
             clock_type::time_point tx_time;
+            // Segment was selectively acknowledged by the peer and must
+            // not be retransmitted (RFC 2018)
+            bool sacked = false;
         };
         struct send {
             tcp_seq unacknowledged;
@@ -394,8 +505,16 @@ private:
         // Clock granularity
         static constexpr std::chrono::milliseconds _rto_clk_granularity{1};
         static constexpr uint16_t _max_nr_retransmit{5};
+        // Data segments retransmitted over the lifetime of the connection
+        uint64_t _total_retransmits = 0;
         timer<lowres_clock> _retransmit;
         timer<lowres_clock> _persist;
+        // Congestion control policy
+        std::unique_ptr<tcp_congestion_controller> _cc;
+        // Pacing budget in bytes, replenished from the controller's rate
+        uint64_t _pacing_tokens = 0;
+        clock_type::time_point _pacing_refill_time;
+        timer<lowres_clock> _pacing;
         uint16_t _nr_full_seg_received = 0;
         struct isn_secret {
             // 512 bits secretkey for ISN generating
@@ -469,6 +588,20 @@ private:
         tcp_state& state() {
             return _state;
         }
+        tcp_connection_stats get_stats() const {
+            tcp_connection_stats stats;
+            stats.rtt = std::chrono::duration_cast<std::chrono::microseconds>(_snd.srtt);
+            stats.rtt_variance = std::chrono::duration_cast<std::chrono::microseconds>(_snd.rttvar);
+            stats.mss = _snd.mss;
+            stats.congestion_window = _snd.cwnd;
+            stats.send_queue_bytes = _snd.unsent_len;
+            stats.unacked_bytes = uint32_t(_snd.next - _snd.unacknowledged);
+            stats.retransmits = _total_retransmits;
+            if (_cc) {
+                stats.pacing_rate = _cc->pacing_rate().value_or(0);
+            }
+            return stats;
+        }
     private:
         void respond_with_reset(tcp_hdr* th);
         bool merge_out_of_order();
@@ -542,6 +675,12 @@ private:
                 // Sent 1 full-sized segment at most
                 x = std::min(uint32_t(_snd.mss), x);
             }
+
+            // A pacing controller additionally bounds what may be put on
+            // the wire right now; the pacing timer sends the rest later
+            if (auto rate = _cc->pacing_rate()) {
+                x = std::min(x, pacing_budget(*rate));
+            }
             return x;
         }
         uint32_t flight_size() {
@@ -549,6 +688,10 @@ private:
             std::for_each(_snd.data.begin(), _snd.data.end(), [&] (unacked_segment& seg) { size += seg.p.len(); });
             return size;
         }
+        tcp_congestion_state cc_state() {
+            return tcp_congestion_state{_snd.cwnd, _snd.ssthresh, _snd.mss, flight_size(), _snd.srtt};
+        }
+        uint32_t pacing_budget(uint64_t rate);
         uint16_t local_mss() {
             return _tcp.hw_features().mtu - net::tcp_hdr_len_min - InetTraits::ip_hdr_len_min;
         }
@@ -647,12 +790,182 @@ private:
             _snd.partial_ack = 0;
         }
         uint32_t data_segment_acked(tcp_seq seg_ack);
+        void update_sack_scoreboard();
         bool segment_acceptable(tcp_seq seg_seq, unsigned seg_len);
         void init_from_options(tcp_hdr* th, uint8_t* opt_start, uint8_t* opt_end);
         friend class connection;
     };
+    // Open-addressing connection lookup table. At millions of concurrent
+    // connections per shard a node-based map costs a cache miss per node
+    // hop and stalls the rx path for a full rehash when it grows; here a
+    // probe walks consecutive 32-byte slots, so after the first (ideally
+    // prefetched, see prefetch()) access it stays within adjacent cache
+    // lines, and growth migrates the old slot array a few slots at a time,
+    // amortized across polls and table operations.
+    class connection_table {
+        enum class slot_state : uint8_t { empty, full, erased };
+        struct slot {
+            connid id;
+            lw_shared_ptr<tcb> tcbp;  // engaged only when full
+            size_t hash = 0;
+            slot_state st = slot_state::empty;
+        };
+        static constexpr size_t min_capacity = 512;
+        // Slots migrated from the old array per migrate_step() call
+        static constexpr size_t migration_batch = 32;
+        std::vector<slot> _slots;
+        // The previous slot array while a growth migration is in progress
+        std::vector<slot> _old;
+        size_t _migrate_pos = 0;
+        size_t _size = 0;  // live entries, across both arrays
+        size_t _used = 0;  // full + erased slots in _slots
+    private:
+        static size_t index_of(size_t hash, size_t cap) {
+            // Fibonacci hashing: the connid hash is a plain xor of the
+            // fields, so spread it out before taking the top bits
+            return (hash * 0x9e3779b97f4a7c15ull) >> (64 - __builtin_ctzll(cap));
+        }
+        static slot* lookup(std::vector<slot>& tab, const connid& id, size_t hash) {
+            auto mask = tab.size() - 1;
+            auto i = index_of(hash, tab.size());
+            while (true) {
+                auto& s = tab[i];
+                if (s.st == slot_state::empty) {
+                    return nullptr;
+                }
+                if (s.st == slot_state::full && s.hash == hash && s.id == id) {
+                    return &s;
+                }
+                i = (i + 1) & mask;
+            }
+        }
+        // Unchecked insert into tab; the caller guarantees the key is
+        // absent and the table has room
+        void place(std::vector<slot>& tab, connid id, lw_shared_ptr<tcb> tcbp, size_t hash) {
+            auto mask = tab.size() - 1;
+            auto i = index_of(hash, tab.size());
+            while (tab[i].st == slot_state::full) {
+                i = (i + 1) & mask;
+            }
+            auto& s = tab[i];
+            if (s.st == slot_state::empty) {
+                _used++;
+            }
+            s.id = std::move(id);
+            s.tcbp = std::move(tcbp);
+            s.hash = hash;
+            s.st = slot_state::full;
+        }
+        void start_migration(size_t new_cap) {
+            _old = std::exchange(_slots, std::vector<slot>(new_cap));
+            _migrate_pos = 0;
+            _used = 0;
+        }
+        void maybe_grow() {
+            if ((_used + 1) * 4 < _slots.size() * 3) {
+                return;
+            }
+            // Two generations at once would lose entries; finish the
+            // pending migration before starting the next one
+            while (migrate_step()) {}
+            auto new_cap = _slots.size();
+            // Erased slots count towards _used, so a tombstone-heavy
+            // table may just be rehashed in place at the same size
+            while ((_size + 1) * 2 >= new_cap) {
+                new_cap *= 2;
+            }
+            start_migration(new_cap);
+        }
+        static void erase_slot(slot& s) {
+            s.tcbp = nullptr;
+            s.st = slot_state::erased;
+        }
+    public:
+        connection_table() : _slots(min_capacity) {}
+        // Moves up to migration_batch slots from the old array. Returns
+        // false when there is no migration in progress; called from the
+        // tcp packet provider, so a growing table drains a little every
+        // poll even when the rx path is quiet.
+        bool migrate_step() {
+            if (_old.empty()) {
+                return false;
+            }
+            for (auto n = migration_batch; n--;) {
+                if (_migrate_pos == _old.size()) {
+                    _old = {};
+                    _migrate_pos = 0;
+                    break;
+                }
+                auto& s = _old[_migrate_pos++];
+                if (s.st == slot_state::full) {
+                    place(_slots, std::move(s.id), std::move(s.tcbp), s.hash);
+                    erase_slot(s);
+                }
+            }
+            return true;
+        }
+        // Starts pulling the slots the key would occupy into cache;
+        // issued at packet-classification time so the memory access
+        // overlaps the checksum verification that follows.
+        void prefetch(const connid& id) const {
+            auto hash = connid_hash{}(id);
+            __builtin_prefetch(&_slots[index_of(hash, _slots.size())]);
+            if (!_old.empty()) {
+                __builtin_prefetch(&_old[index_of(hash, _old.size())]);
+            }
+        }
+        lw_shared_ptr<tcb>* find(const connid& id) {
+            auto hash = connid_hash{}(id);
+            if (auto s = lookup(_slots, id, hash)) {
+                return &s->tcbp;
+            }
+            if (!_old.empty()) {
+                if (auto s = lookup(_old, id, hash)) {
+                    return &s->tcbp;
+                }
+            }
+            return nullptr;
+        }
+        void insert(const connid& id, lw_shared_ptr<tcb> tcbp) {
+            migrate_step();
+            maybe_grow();
+            place(_slots, id, std::move(tcbp), connid_hash{}(id));
+            _size++;
+        }
+        void erase(const connid& id) {
+            migrate_step();
+            auto hash = connid_hash{}(id);
+            if (auto s = lookup(_slots, id, hash)) {
+                erase_slot(*s);
+                _size--;
+                return;
+            }
+            if (!_old.empty()) {
+                if (auto s = lookup(_old, id, hash)) {
+                    erase_slot(*s);
+                    _size--;
+                }
+            }
+        }
+        // Pre-sizes the table so n connections fit at half load without
+        // triggering a growth migration
+        void reserve(size_t n) {
+            auto cap = min_capacity;
+            while (n * 2 > cap) {
+                cap *= 2;
+            }
+            if (cap <= _slots.size()) {
+                return;
+            }
+            while (migrate_step()) {}
+            start_migration(cap);
+        }
+        size_t size() const {
+            return _size;
+        }
+    };
     inet_type& _inet;
-    std::unordered_map<connid, lw_shared_ptr<tcb>, connid_hash> _tcbs;
+    connection_table _tcbs;
     std::unordered_map<uint16_t, listener*> _listening;
     std::random_device _rd;
     std::default_random_engine _e;
@@ -662,6 +975,7 @@ private:
     circular_buffer<ipv4_traits::l4packet> _packetq;
     semaphore _queue_space = {212992};
     metrics::metric_groups _metrics;
+    tcp_congestion_algorithm _congestion_algorithm = tcp_congestion_algorithm::reno;
 public:
     const inet_type& inet() const {
         return _inet;
@@ -701,6 +1015,9 @@ public:
         uint16_t foreign_port() {
             return _tcb->_foreign_port;
         }
+        tcp_connection_stats get_stats() const {
+            return _tcb->get_stats();
+        }
         void shutdown_connect();
         void close_read();
         void close_write();
@@ -761,6 +1078,11 @@ public:
             it->second->dec_pending();
         }
     }
+    // Congestion control algorithm used by connections created afterwards
+    void set_congestion_algorithm(tcp_congestion_algorithm algo) { _congestion_algorithm = algo; }
+    // Pre-size the connection table for an expected number of concurrent
+    // connections, avoiding growth migrations during ramp-up
+    void reserve_connections(size_t n) { _tcbs.reserve(n); }
 private:
     void send_packet_without_tcb(ipaddr from, ipaddr to, packet p);
     void respond_with_reset(tcp_hdr* rth, ipaddr local_ip, ipaddr foreign_ip);
@@ -780,6 +1102,8 @@ tcp<InetTraits>::tcp(inet_type& inet)
     });
 
     _inet.register_packet_provider([this, tcb_polled = 0u] () mutable {
+        // Amortize connection table growth across polls
+        _tcbs.migrate_step();
         std::optional<typename InetTraits::l4packet> l4p;
         auto c = _poll_tcbs.size();
         if (!_packetq.empty() && (!(tcb_polled % 128) || c == 0)) {
@@ -829,10 +1153,10 @@ auto tcp<InetTraits>::connect(socket_address sa) -> connection {
         id = connid{src_ip, dst_ip, src_port, dst_port};
     } while (_inet._inet.netif()->hw_queues_count() > 1 &&
              (_inet._inet.netif()->hash2cpu(id.hash(_inet._inet.netif()->rss_key())) != this_shard_id()
-              || _tcbs.find(id) != _tcbs.end()));
+              || _tcbs.find(id) != nullptr));
 
     auto tcbp = make_lw_shared<tcb>(*this, id);
-    _tcbs.insert({id, tcbp});
+    _tcbs.insert(id, tcbp);
     tcbp->connect();
     return connection(tcbp);
 }
@@ -862,6 +1186,12 @@ void tcp<InetTraits>::received(packet p, ipaddr from, ipaddr to) {
         return;
     }
 
+    auto h = tcp_hdr::read(th);
+    auto id = connid{to, from, h.dst_port, h.src_port};
+    // Start the connection lookup before the checksum pass below; at high
+    // connection counts the table slot is rarely in cache.
+    _tcbs.prefetch(id);
+
     if (!hw_features().rx_csum_offload) {
         checksummer csum;
         InetTraits::tcp_pseudo_header_checksum(csum, from, to, p.len());
@@ -870,11 +1200,9 @@ void tcp<InetTraits>::received(packet p, ipaddr from, ipaddr to) {
             return;
         }
     }
-    auto h = tcp_hdr::read(th);
-    auto id = connid{to, from, h.dst_port, h.src_port};
     auto tcbi = _tcbs.find(id);
     lw_shared_ptr<tcb> tcbp;
-    if (tcbi == _tcbs.end()) {
+    if (!tcbi) {
         auto listener = _listening.find(id.local_port);
         if (listener == _listening.end() || listener->second->full()) {
             // 1) In CLOSE state
@@ -904,7 +1232,7 @@ void tcp<InetTraits>::received(packet p, ipaddr from, ipaddr to) {
                 // check the security
                 // NOTE: Ignored for now
                 tcbp = make_lw_shared<tcb>(*this, id);
-                _tcbs.insert({id, tcbp});
+                _tcbs.insert(id, tcbp);
                 // TODO: we need to remove the tcb and decrease the pending if
                 // it stays SYN_RECEIVED state forever.
                 listener->second->inc_pending();
@@ -917,7 +1245,7 @@ void tcp<InetTraits>::received(packet p, ipaddr from, ipaddr to) {
             return;
         }
     } else {
-        tcbp = tcbi->second;
+        tcbp = *tcbi;
         if (tcbp->state() == tcp_state::SYN_SENT) {
             // 3) In SYN_SENT State
             return tcbp->input_handle_syn_sent_state(&h, std::move(p));
@@ -959,7 +1287,10 @@ tcp<InetTraits>::tcb::tcb(tcp& t, connid id)
     , _foreign_port(id.foreign_port)
     , _delayed_ack([this] { _nr_full_seg_received = 0; output(); })
     , _retransmit([this] { retransmit(); })
-    , _persist([this] { persist(); }) {
+    , _persist([this] { persist(); })
+    , _cc(make_tcp_congestion_controller(t._congestion_algorithm))
+    , _pacing_refill_time(clock_type::now())
+    , _pacing([this] { output(); }) {
 }
 
 template <typename InetTraits>
@@ -1043,6 +1374,33 @@ uint32_t tcp<InetTraits>::tcb::data_segment_acked(tcp_seq seg_ack) {
     return total_acked_bytes;
 }
 
+template <typename InetTraits>
+void tcp<InetTraits>::tcb::update_sack_scoreboard() {
+    if (_option._sack_blocks_received.empty()) {
+        return;
+    }
+    // Mark segments of the retransmission queue covered by a reported
+    // block, so retransmissions can skip data the peer already holds.
+    // The mark is never cleared; RFC 2018 allows the peer to renege but
+    // the retransmission timeout still resends the whole queue head.
+    for (auto& block : _option._sack_blocks_received) {
+        auto left = tcp_seq{block.first};
+        auto right = tcp_seq{block.second};
+        if (right <= left) {
+            continue;
+        }
+        auto seq = _snd.unacknowledged;
+        for (auto& unacked_seg : _snd.data) {
+            auto seg_end = seq + unacked_seg.p.len();
+            if (!unacked_seg.sacked && left <= seq && seg_end <= right) {
+                unacked_seg.sacked = true;
+            }
+            seq = seg_end;
+        }
+    }
+    _option._sack_blocks_received.clear();
+}
+
 template <typename InetTraits>
 bool tcp<InetTraits>::tcb::segment_acceptable(tcp_seq seg_seq, unsigned seg_len) {
     if (seg_len == 0 && _rcv.window == 0) {
@@ -1087,17 +1445,8 @@ void tcp<InetTraits>::tcb::init_from_options(tcp_hdr* th, uint8_t* opt_start, ui
     // Segment acknowledgment number used for last window update
     _snd.wl2 = th->ack;
 
-    // Setup initial congestion window
-    if (2190 < _snd.mss) {
-        _snd.cwnd = 2 * _snd.mss;
-    } else if (1095 < _snd.mss && _snd.mss <= 2190) {
-        _snd.cwnd = 3 * _snd.mss;
-    } else {
-        _snd.cwnd = 4 * _snd.mss;
-    }
-
-    // Setup initial slow start threshold
-    _snd.ssthresh = th->window << _snd.window_scale;
+    // Setup initial congestion window and slow start threshold
+    _cc->on_established(cc_state(), th->window << _snd.window_scale);
 }
 
 template <typename InetTraits>
@@ -1201,6 +1550,16 @@ void tcp<InetTraits>::tcb::input_handle_syn_sent_state(tcp_hdr* th, packet p) {
 
 template <typename InetTraits>
 void tcp<InetTraits>::tcb::input_handle_other_state(tcp_hdr* th, packet p) {
+    if (th->data_offset > 5 && _option._sack_received) {
+        // All other options are negotiated on SYN only, but segments may
+        // carry SACK blocks describing data the peer holds out of order.
+        auto th_len = th->data_offset * 4;
+        auto opt = reinterpret_cast<uint8_t*>(p.get_header(0, th_len));
+        if (opt) {
+            _option.parse(opt + tcp_hdr::len, opt + th_len);
+            update_sack_scoreboard();
+        }
+    }
     p.trim_front(th->data_offset * 4);
     bool do_output = false;
     bool do_output_data = false;
@@ -1347,11 +1706,10 @@ void tcp<InetTraits>::tcb::input_handle_other_state(tcp_hdr* th, packet p) {
 
                 if (_snd.dupacks >= 3) {
                     // We are in fast retransmit / fast recovery phase
-                    uint32_t smss = _snd.mss;
                     if (seg_ack > _snd.recover) {
                         tcp_debug("ack: full_ack\n");
                         // Set cwnd to min (ssthresh, max(FlightSize, SMSS) + SMSS)
-                        _snd.cwnd = std::min(_snd.ssthresh, std::max(flight_size(), smss) + smss);
+                        _cc->on_full_ack(cc_state());
                         // Exit the fast recovery procedure
                         exit_fast_recovery();
                         set_retransmit_timer();
@@ -1361,12 +1719,7 @@ void tcp<InetTraits>::tcb::input_handle_other_state(tcp_hdr* th, packet p) {
                         fast_retransmit();
                         // Deflate the congestion window by the amount of new data
                         // acknowledged by the Cumulative Acknowledgment field
-                        _snd.cwnd -= acked_bytes;
-                        // If the partial ACK acknowledges at least one SMSS of new
-                        // data, then add back SMSS bytes to the congestion window
-                        if (acked_bytes >= smss) {
-                            _snd.cwnd += smss;
-                        }
+                        _cc->on_partial_ack(cc_state(), acked_bytes);
                         // Send a new segment if permitted by the new value of
                         // cwnd.  Do not exit the fast recovery procedure For
                         // the first partial ACK that arrives during fast
@@ -1398,7 +1751,6 @@ void tcp<InetTraits>::tcb::input_handle_other_state(tcp_hdr* th, packet p) {
                 // and repair loss, based on incoming duplicate ACKs.
                 // Here, We follow RFC5681.
                 _snd.dupacks++;
-                uint32_t smss = _snd.mss;
                 // 3 duplicated ACKs trigger a fast retransmit
                 if (_snd.dupacks == 1 || _snd.dupacks == 2) {
                     // RFC5681 Step 3.1
@@ -1408,17 +1760,16 @@ void tcp<InetTraits>::tcb::input_handle_other_state(tcp_hdr* th, packet p) {
                     // RFC6582 Step 3.2
                     if (seg_ack - 1 > _snd.recover) {
                         _snd.recover = _snd.next - 1;
-                        // RFC5681 Step 3.2
-                        _snd.ssthresh = std::max((flight_size() - _snd.limited_transfer) / 2, 2 * smss);
+                        // RFC5681 Step 3.2 and 3.3
+                        _cc->on_fast_retransmit(cc_state(), _snd.limited_transfer, true);
                         fast_retransmit();
                     } else {
                         // Do not enter fast retransmit and do not reset ssthresh
+                        _cc->on_fast_retransmit(cc_state(), _snd.limited_transfer, false);
                     }
-                    // RFC5681 Step 3.3
-                    _snd.cwnd = _snd.ssthresh + 3 * smss;
                 } else if (_snd.dupacks > 3) {
                     // RFC5681 Step 3.4
-                    _snd.cwnd += smss;
+                    _cc->on_dup_ack(cc_state());
                     // RFC5681 Step 3.5
                     do_output_data = true;
                 }
@@ -1488,6 +1839,7 @@ void tcp<InetTraits>::tcb::input_handle_other_state(tcp_hdr* th, packet p) {
             // RCV.NXT over the data accepted, and adjusts RCV.WND as
             // apporopriate to the current buffer availability.  The total of
             // RCV.NXT and RCV.WND should not be reduced.
+            record_rx_delivery(p);
             _rcv.data_size += p.len();
             _rcv.data.push_back(std::move(p));
             _rcv.next += seg_len;
@@ -1567,7 +1919,10 @@ packet tcp<InetTraits>::tcb::get_transmit_packet() {
     auto can_send = this->can_send();
     // Max number of TCP payloads we can pass to NIC
     uint32_t len;
-    if (_tcp.hw_features().tx_tso) {
+    // TSO also requires L4 checksum offload: the NIC computes the checksum
+    // of every segment it carves, and output_one() only marks packets for
+    // segmentation when both features are present.
+    if (_tcp.hw_features().tx_tso && _tcp.hw_features().tx_csum_l4_offload) {
         // FIXME: Info tap device the size of the splitted packet
         len = _tcp.hw_features().max_packet_len - net::tcp_hdr_len_min - InetTraits::ip_hdr_len_min;
     } else {
@@ -1604,21 +1959,70 @@ packet tcp<InetTraits>::tcb::get_transmit_packet() {
         q.trim_front(can_send);
     }
     _snd.unsent_len -= p.len();
+    if (_cc->pacing_rate()) {
+        _pacing_tokens -= std::min<uint64_t>(_pacing_tokens, p.len());
+    }
     return p;
 }
 
+template <typename InetTraits>
+uint32_t tcp<InetTraits>::tcb::pacing_budget(uint64_t rate) {
+    auto now = clock_type::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - _pacing_refill_time);
+    _pacing_refill_time = now;
+    // Allow a burst of a couple of timer periods worth of data so the
+    // coarse lowres_clock granularity does not starve the connection
+    auto burst = std::max<uint64_t>(rate / 50, 4 * _snd.mss);
+    _pacing_tokens = std::min<uint64_t>(burst, _pacing_tokens + rate * elapsed.count() / 1000000);
+    if (_pacing_tokens < _snd.mss && _snd.unsent_len && !_pacing.armed()) {
+        // Come back once enough budget for a full segment accumulated
+        auto wait = std::chrono::microseconds((_snd.mss - _pacing_tokens) * 1000000 / std::max<uint64_t>(rate, 1));
+        _pacing.arm(std::chrono::ceil<typename clock_type::duration>(wait));
+    }
+    return std::min<uint64_t>(_pacing_tokens, std::numeric_limits<uint32_t>::max());
+}
+
 template <typename InetTraits>
 void tcp<InetTraits>::tcb::output_one(bool data_retransmit) {
     if (in_state(CLOSED)) {
         return;
     }
 
-    packet p = data_retransmit ? _snd.data.front().p.share() : get_transmit_packet();
+    tcp_seq retransmit_seq = _snd.unacknowledged;
+    packet p;
+    if (data_retransmit) {
+        // With SACK the peer may already hold later segments; retransmit
+        // the first hole in the scoreboard instead of blindly resending
+        // from SND.UNA. Without SACK no segment is ever marked and this
+        // picks the front of the queue as before.
+        auto i = _snd.data.begin();
+        while (i->sacked && std::next(i) != _snd.data.end()) {
+            retransmit_seq += i->p.len();
+            ++i;
+        }
+        p = i->p.share();
+    } else {
+        p = get_transmit_packet();
+    }
     packet clone = p.share();  // early clone to prevent share() from calling packet::unuse_internal_data() on header.
     uint16_t len = p.len();
     bool syn_on = syn_needs_on();
     bool ack_on = ack_needs_on();
 
+    // Advertise data held out of order (RFC 2018). Only pure ACKs carry
+    // SACK blocks so a full sized data segment cannot overflow the MTU
+    // by growing its header; the immediate ACK sent in response to an
+    // out-of-order arrival is such a segment.
+    _option._sack_blocks_to_send.clear();
+    if (_option._sack_received && !syn_on && ack_on && len == 0) {
+        for (auto& [seq, q] : _rcv.out_of_order.map) {
+            _option._sack_blocks_to_send.emplace_back(seq.raw, (seq + q.len()).raw);
+            if (_option._sack_blocks_to_send.size() == tcp_option::max_sack_blocks) {
+                break;
+            }
+        }
+    }
+
     auto options_size = _option.get_size(syn_on, ack_on);
     auto th = p.prepend_uninitialized_header(tcp_hdr::len + options_size);
     auto h = tcp_hdr{};
@@ -1636,7 +2040,7 @@ void tcp<InetTraits>::tcb::output_one(bool data_retransmit) {
 
     tcp_seq seq;
     if (data_retransmit) {
-        seq = _snd.unacknowledged;
+        seq = retransmit_seq;
     } else {
         seq = syn_on ? _snd.initial : _snd.next;
         _snd.next += len;
@@ -1883,6 +2287,7 @@ bool tcp<InetTraits>::tcb::merge_out_of_order() {
                 seg_len -= trim;
             }
             _rcv.next += seg_len;
+            record_rx_delivery(p);
             _rcv.data_size += p.len();
             _rcv.data.push_back(std::move(p));
             // Since c++11, erase() always returns the value of the following element
@@ -1965,20 +2370,16 @@ void tcp<InetTraits>::tcb::retransmit() {
     auto& unacked_seg = _snd.data.front();
 
     // According to RFC5681
-    // Update ssthresh only for the first retransmit
-    uint32_t smss = _snd.mss;
-    if (unacked_seg.nr_transmits == 0) {
-        _snd.ssthresh = std::max(flight_size() / 2, 2 * smss);
-    }
+    // ssthresh is only updated for the first retransmit
+    _cc->on_retransmit_timeout(cc_state(), unacked_seg.nr_transmits == 0);
     // RFC6582 Step 4
     _snd.recover = _snd.next - 1;
-    // Start the slow start process
-    _snd.cwnd = smss;
     // End fast recovery
     exit_fast_recovery();
 
     if (unacked_seg.nr_transmits < _max_nr_retransmit) {
         unacked_seg.nr_transmits++;
+        _total_retransmits++;
     } else {
         // Delete connection when max num of retransmission is reached
         do_reset();
@@ -1994,6 +2395,7 @@ void tcp<InetTraits>::tcb::fast_retransmit() {
     if (!_snd.data.empty()) {
         auto& unacked_seg = _snd.data.front();
         unacked_seg.nr_transmits++;
+        _total_retransmits++;
         retransmit_one();
         output();
     }
@@ -2020,6 +2422,10 @@ void tcp<InetTraits>::tcb::update_rto(clock_type::time_point tx_time) {
     // RTO <- SRTT + max(G, K * RTTVAR)
     _rto =  _snd.srtt + std::max(_rto_clk_granularity, 4 * _snd.rttvar);
 
+    // Only segments transmitted once produce a sample, so the controller
+    // gets clean measurements (Karn's algorithm)
+    _cc->on_rtt_sample(cc_state(), R);
+
     // Make sure 1 sec << _rto << 60 sec
     _rto = std::max(_rto, _rto_min);
     _rto = std::min(_rto, _rto_max);
@@ -2027,15 +2433,7 @@ void tcp<InetTraits>::tcb::update_rto(clock_type::time_point tx_time) {
 
 template <typename InetTraits>
 void tcp<InetTraits>::tcb::update_cwnd(uint32_t acked_bytes) {
-    uint32_t smss = _snd.mss;
-    if (_snd.cwnd < _snd.ssthresh) {
-        // In slow start phase
-        _snd.cwnd += std::min(acked_bytes, smss);
-    } else {
-        // In congestion avoidance phase
-        uint32_t round_up = 1;
-        _snd.cwnd += std::max(round_up, smss * smss / _snd.cwnd);
-    }
+    _cc->on_ack(cc_state(), acked_bytes);
 }
 
 template <typename InetTraits>
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <functional>
+#include <map>
 #include <unordered_set>
 
 #include <boost/any.hpp>
@@ -210,6 +211,21 @@ namespace tls {
          */
         void set_dn_verification_callback(dn_callback);
 
+        /**
+         * Offload record encryption of established sessions to the kernel
+         * (Linux kTLS). After a handshake that negotiated an AES-GCM
+         * cipher, the transmit keys are pushed into the socket and writes
+         * bypass the userspace record layer entirely, making them eligible
+         * for zero-copy transmission.
+         *
+         * Transmit side only; reads keep using the userspace record layer.
+         * An offloaded session cannot renegotiate, and closing it
+         * terminates the stream without a close_notify alert. The offload
+         * silently stays off when the kernel, the socket type or the
+         * negotiated cipher does not support it.
+         */
+        void enable_kernel_tls();
+
     private:
         class impl;
         friend class session;
@@ -282,6 +298,19 @@ namespace tls {
         void set_client_auth(client_auth);
         void set_priority_string(const sstring&);
 
+        /**
+         * Enables stateless TLS session resumption (RFC 5077 session
+         * tickets) for server sessions built from this builder.
+         *
+         * A ticket key is generated once and copied into every credentials
+         * object produced by apply_to()/build_*(), so a client that first
+         * connected to one shard can resume its session on any other shard
+         * without repeating the full key exchange. Resumption rates are
+         * exposed through the per-shard tls handshakes/session_resumptions
+         * metrics.
+         */
+        void enable_session_tickets();
+
         void apply_to(certificate_credentials&) const;
 
         shared_ptr<certificate_credentials> build_certificate_credentials() const;
@@ -43,6 +43,9 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace seastar {
@@ -73,27 +76,62 @@ static constexpr uint8_t default_rsskey_52bytes_v[] = {
 
 static constexpr rss_key_type default_rsskey_52bytes{default_rsskey_52bytes_v, sizeof(default_rsskey_52bytes_v)};
 
+// Table-driven Toeplitz: for every input byte position the 256 possible
+// XOR contributions are precomputed from the key, so hashing costs one
+// table lookup per input byte instead of the classic bit-by-bit loop.
+class toeplitz_hash_table {
+    std::vector<std::array<uint32_t, 256>> _tables;
+public:
+    explicit toeplitz_hash_table(rss_key_type key) : _tables(key.size()) {
+        for (size_t i = 0; i < key.size(); i++) {
+            // 40-bit window of the key starting at byte i, zero padded
+            // past the end of the key like the bit loop's shift register
+            uint64_t w = 0;
+            for (size_t j = 0; j < 5; j++) {
+                w = (w << 8) | (i + j < key.size() ? key[i + j] : 0);
+            }
+            // v for bit b of input byte i: 32 key bits from bit 8*i + b
+            uint32_t v[8];
+            for (unsigned b = 0; b < 8; b++) {
+                v[b] = uint32_t((w >> (8 - b)) & 0xffff'ffff);
+            }
+            auto& t = _tables[i];
+            for (unsigned val = 0; val < 256; val++) {
+                uint32_t h = 0;
+                for (unsigned b = 0; b < 8; b++) {
+                    if (val & (1 << (7 - b))) {
+                        h ^= v[b];
+                    }
+                }
+                t[val] = h;
+            }
+        }
+    }
+    template<typename T>
+    uint32_t operator()(const T& data) const {
+        uint32_t hash = 0;
+        auto n = std::min(size_t(data.size()), _tables.size());
+        for (size_t i = 0; i != n; i++) {
+            hash ^= _tables[i][uint8_t(data[i])];
+        }
+        return hash;
+    }
+};
+
 template<typename T>
 static inline uint32_t
 toeplitz_hash(rss_key_type key, const T& data)
 {
-	uint32_t hash = 0, v;
-	u_int i, b;
-
-	/* XXXRW: Perhaps an assertion about key length vs. data length? */
-
-	v = (key[0]<<24) + (key[1]<<16) + (key[2] <<8) + key[3];
-	for (i = 0; i < data.size(); i++) {
-		for (b = 0; b < 8; b++) {
-			if (data[i] & (1<<(7-b)))
-				hash ^= v;
-			v <<= 1;
-			if ((i + 4) < key.size() &&
-			    (key[i+4] & (1<<(7-b))))
-				v |= 1;
-		}
-	}
-	return (hash);
+    // The stacks only ever hash with a handful of static keys; expand
+    // each into its lookup tables at most once per shard
+    static thread_local std::vector<std::pair<rss_key_type, std::unique_ptr<toeplitz_hash_table>>> tables;
+    for (auto& [k, t] : tables) {
+        if (k == key) {
+            return (*t)(data);
+        }
+    }
+    tables.emplace_back(key, std::make_unique<toeplitz_hash_table>(key));
+    return (*tables.back().second)(data);
 }
 
 }
@@ -0,0 +1,41 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#pragma once
+
+#include <memory>
+#include <seastar/net/net.hh>
+#include <seastar/core/sstring.hh>
+
+namespace seastar {
+
+/// Creates a vhost-user backed device for the native network stack.
+///
+/// Connects as the virtio driver side to a vhost-user backend (e.g. an
+/// OVS-DPDK or VPP vhostuser port) over its unix socket, and places the
+/// virtqueues and all frame buffers in a memfd region shared with the
+/// backend, so frames move through shared-memory rings without the kernel
+/// in the data path. Useful where a PMD cannot own the NIC, such as
+/// containers.
+std::unique_ptr<net::device> create_vhost_user_net_device(boost::program_options::variables_map opts = boost::program_options::variables_map());
+boost::program_options::options_description get_vhost_user_net_options_description();
+
+}
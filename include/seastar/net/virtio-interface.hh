@@ -82,6 +82,28 @@
  * at the end of the used ring. Guest should ignore the used->flags field. */
 #define VIRTIO_RING_F_EVENT_IDX         (1 << 29)
 
+/* The device complies with the virtio 1.0+ (non-legacy) framing. */
+#define VIRTIO_F_VERSION_1              (1ULL << 32)
+
+/* The device supports the packed virtqueue layout: a single ring of
+ * descriptors written in place by both sides, instead of the split
+ * descriptor table plus avail and used rings. */
+#define VIRTIO_F_RING_PACKED            (1ULL << 34)
+
+/* Packed virtqueue descriptor flags, in addition to VRING_DESC_F_*.
+ * A descriptor is available when AVAIL equals the driver's wrap counter
+ * and USED does not; the device marks it used by setting both to its own
+ * wrap counter. */
+#define VRING_PACKED_DESC_F_AVAIL       (1 << 7)
+#define VRING_PACKED_DESC_F_USED        (1 << 15)
+
+/* Values of the flags field in the packed virtqueue event suppression
+ * structures. DESC additionally arms a specific descriptor offset (with
+ * VIRTIO_RING_F_EVENT_IDX negotiated). */
+#define VRING_PACKED_EVENT_FLAG_ENABLE  0x0
+#define VRING_PACKED_EVENT_FLAG_DISABLE 0x1
+#define VRING_PACKED_EVENT_FLAG_DESC    0x2
+
 /* The standard layout for the ring is a continuous chunk of memory which looks
  * like this.  We assume num is a power of 2.
  *
@@ -0,0 +1,41 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#pragma once
+
+#include <memory>
+#include <seastar/net/net.hh>
+#include <seastar/core/sstring.hh>
+
+namespace seastar {
+
+/// Creates an AF_XDP backed device for the native network stack.
+///
+/// One XDP socket per shard is bound to the NIC queue with the same
+/// index, so the NIC's RSS configuration spreads connections over the
+/// shards exactly like with the DPDK backend. The interface must have an
+/// XDP program attached that redirects packets into an XSKMAP pinned at
+/// a known path (e.g. the stock xdpsock redirect program); each queue's
+/// socket registers itself in that map.
+std::unique_ptr<net::device> create_xdp_net_device(boost::program_options::variables_map opts = boost::program_options::variables_map());
+boost::program_options::options_description get_xdp_net_options_description();
+
+}
@@ -0,0 +1,137 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#pragma once
+
+#include <functional>
+
+#include <seastar/core/loop.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/rpc/rpc.hh>
+
+namespace seastar {
+
+namespace rpc {
+
+/// \addtogroup rpc
+/// @{
+
+/// A shard-local pool of connections to one RPC server.
+///
+/// An \ref protocol::client is a single TCP connection owned by the shard it
+/// was created on; callers on other shards have to \c submit_to the owner,
+/// serializing all traffic to the server through one shard. A client_pool is
+/// meant to be wrapped in a \ref seastar::sharded so that every shard gets
+/// its own connections and invokes verbs locally:
+///
+/// \code
+/// seastar::sharded<rpc::client_pool<serializer>> pool;
+/// pool.start(std::ref(proto), options, addr).get();
+/// ...
+/// echo(pool.local().get_client(), msg)
+/// \endcode
+///
+/// The \c max_outstanding constructor argument is an aggregate limit on
+/// concurrent \ref with_client invocations across all shards; each shard
+/// gets an equal part of it.
+template <typename Serializer, typename MsgType = uint32_t>
+class client_pool {
+public:
+    using client_type = typename protocol<Serializer, MsgType>::client;
+private:
+    std::vector<std::unique_ptr<client_type>> _clients;
+    semaphore _concurrency;
+    size_t _next = 0;
+
+    static size_t shard_concurrency(size_t max_outstanding) {
+        if (max_outstanding == semaphore::max_counter()) {
+            return max_outstanding;
+        }
+        return std::max<size_t>(max_outstanding / smp::count, 1);
+    }
+public:
+    /// Open \c connections_per_shard connections to \c addr on this shard.
+    client_pool(protocol<Serializer, MsgType>& proto, client_options options, const socket_address& addr,
+            unsigned connections_per_shard = 1, size_t max_outstanding = semaphore::max_counter())
+            : _concurrency(shard_concurrency(max_outstanding)) {
+        _clients.reserve(connections_per_shard);
+        for (unsigned i = 0; i < connections_per_shard; i++) {
+            _clients.emplace_back(std::make_unique<client_type>(proto, options, addr));
+        }
+    }
+
+    /// Open \c connections_per_shard connections to \c addr on this shard,
+    /// each over a socket obtained from \c make_socket.
+    client_pool(protocol<Serializer, MsgType>& proto, client_options options, const socket_address& addr,
+            unsigned connections_per_shard, size_t max_outstanding, std::function<seastar::socket ()> make_socket)
+            : _concurrency(shard_concurrency(max_outstanding)) {
+        _clients.reserve(connections_per_shard);
+        for (unsigned i = 0; i < connections_per_shard; i++) {
+            _clients.emplace_back(std::make_unique<client_type>(proto, options, make_socket(), addr));
+        }
+    }
+
+    /// Returns one of this shard's connections, rotating between them.
+    client_type& get_client() {
+        return *_clients[_next++ % _clients.size()];
+    }
+
+    /// Returns the connection this shard consistently uses for \c route.
+    ///
+    /// Calls made with the same routing key go out over the same connection
+    /// in order, which round-robin \ref get_client does not guarantee.
+    client_type& get_client(uint64_t route) {
+        return *_clients[route % _clients.size()];
+    }
+
+    /// Invokes \c func with one of this shard's connections, holding a unit
+    /// of the pool's aggregate concurrency limit until the future \c func
+    /// returns resolves.
+    template <typename Func>
+    auto with_client(Func func) {
+        return with_semaphore(_concurrency, 1, [this, func = std::move(func)] () mutable {
+            return func(get_client());
+        });
+    }
+
+    /// Like \ref with_client(Func), but uses the connection selected by
+    /// \c route as in \ref get_client(uint64_t).
+    template <typename Func>
+    auto with_client(uint64_t route, Func func) {
+        return with_semaphore(_concurrency, 1, [this, route, func = std::move(func)] () mutable {
+            return func(get_client(route));
+        });
+    }
+
+    /// Stops all of this shard's connections.
+    future<> stop() {
+        return parallel_for_each(_clients, [] (std::unique_ptr<client_type>& c) {
+            return c->stop();
+        });
+    }
+};
+
+/// @}
+
+}
+
+}
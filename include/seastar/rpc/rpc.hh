@@ -24,6 +24,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <list>
+#include <map>
 #include <seastar/core/future.hh>
 #include <seastar/core/seastar.hh>
 #include <seastar/net/api.hh>
@@ -37,6 +38,9 @@
 #include <seastar/core/queue.hh>
 #include <seastar/core/weak_ptr.hh>
 #include <seastar/core/scheduling.hh>
+#include <seastar/core/io_priority_class.hh>
+#include <seastar/core/execution_stage.hh>
+#include <seastar/core/metrics_registration.hh>
 #include <seastar/util/backtrace.hh>
 #include <seastar/util/log.hh>
 
@@ -72,6 +76,11 @@ struct isolation_config {
     /// Specifies a scheduling group under which the connection (and all its
     /// verb handlers) will execute.
     scheduling_group sched_group = current_scheduling_group();
+    /// Specifies the I/O priority class verb handlers should use for disk
+    /// I/O issued on behalf of the connection (or call). The rpc layer does
+    /// not issue disk I/O itself; handlers retrieve the class with
+    /// \ref server::isolation_config_for.
+    ::seastar::io_priority_class io_priority = default_priority_class();
 };
 
 /// Default isolation configuration - run everything in the default scheduling group.
@@ -97,6 +106,12 @@ struct resource_limits {
     /// Configures isolation for a connection based on its isolation cookie. May throw,
     /// in which case the connection will be terminated.
     std::function<isolation_config (sstring isolation_cookie)> isolate_connection = default_isolate_connection;
+    /// Configures isolation for an individual call based on the QoS tag the
+    /// client attached to it (\see client_options::qos_tag_source). Must be a
+    /// pure function of the tag - the result is cached per tag on each shard.
+    /// May throw, in which case the connection will be terminated. When unset,
+    /// the per-call QoS feature is not negotiated and tags are never sent.
+    std::function<isolation_config (uint8_t qos_tag)> isolate_call;
 };
 
 struct client_options {
@@ -110,6 +125,18 @@ struct client_options {
     ///
     /// \see resource_limits::isolate_connection
     sstring isolation_cookie;
+    /// When set, every call carries a one-byte QoS tag obtained by invoking
+    /// this function at call time, so a connection shared by callers of
+    /// different service tiers can label each call individually; typically
+    /// the function inspects \ref current_scheduling_group. The server maps
+    /// the tag to a scheduling group and an I/O priority class with
+    /// \ref resource_limits::isolate_call.
+    std::function<uint8_t ()> qos_tag_source;
+    /// Maximum time outgoing messages may be held back waiting for more
+    /// messages to share a flush (and a TCP segment) with. Zero, the default,
+    /// flushes after every message; latency-critical connections should
+    /// keep it that way.
+    std::chrono::microseconds batch_flush_delay = std::chrono::microseconds(0);
 };
 
 /// @}
@@ -171,6 +198,8 @@ enum class protocol_features : uint32_t {
     CONNECTION_ID = 2,
     STREAM_PARENT = 3,
     ISOLATION = 4,
+    COMPRESS_BYPASS = 5,
+    QOS = 6,
 };
 
 // internal representation of feature data
@@ -264,6 +293,18 @@ protected:
     future<> _send_loop_stopped = make_ready_future<>();
     std::unique_ptr<compressor> _compressor;
     bool _timeout_negotiated = false;
+    bool _compress_bypass_negotiated = false;
+    bool _qos_negotiated = false;
+    // Compressibility feedback, tracked per request verb (verb 0 doubles
+    // for response and stream frames, which carry no verb): the number of
+    // frames to send uncompressed before probing the verb again.
+    std::unordered_map<uint64_t, unsigned> _compress_skip;
+    // When non-zero, flushes of the outgoing queue are delayed by up to
+    // this much while more frames are queued, so that small frames share
+    // one flush (and one tcp segment).
+    std::chrono::microseconds _batch_flush_delay = std::chrono::microseconds(0);
+    // Time the oldest unflushed frame was written, if any.
+    std::optional<rpc_clock_type::time_point> _unflushed_since;
     // stream related fields
     bool _is_stream = false;
     connection_id _id = invalid_connection_id;
@@ -281,8 +322,9 @@ protected:
         return _is_stream;
     }
 
-    snd_buf compress(snd_buf buf);
+    snd_buf compress(snd_buf buf, uint64_t verb = 0);
     future<> send_buffer(snd_buf buf);
+    future<> flush_send_buffer();
 
     enum class outgoing_queue_type {
         request,
@@ -395,8 +437,9 @@ public:
 class client : public rpc::connection, public weakly_referencable<client> {
     socket _socket;
     id_type _message_id = 1;
+    using expiry_map = std::multimap<rpc_clock_type::time_point, id_type>;
     struct reply_handler_base {
-        timer<rpc_clock_type> t;
+        std::optional<expiry_map::iterator> expiry; // position in _expiring while armed
         cancellable* pcancel = nullptr;
         virtual void operator()(client&, id_type, rcv_buf data) = 0;
         virtual void timeout() {}
@@ -429,6 +472,11 @@ public:
     };
 private:
     std::unordered_map<id_type, std::unique_ptr<reply_handler_base>> _outstanding;
+    // Expiry times of outstanding calls with a timeout, serviced in batches
+    // by _expiry_timer instead of arming a timer per call. When a connection
+    // fails the whole map is dropped in one sweep.
+    expiry_map _expiring;
+    timer<rpc_clock_type> _expiry_timer;
     socket_address _server_addr, _local_addr;
     client_options _options;
     std::optional<shared_promise<>> _client_negotiated = shared_promise<>();
@@ -437,6 +485,8 @@ private:
 private:
     future<> negotiate_protocol(input_stream<char>& in);
     void negotiate(feature_map server_features);
+    void expire_waiters();
+    void detach_expiry(reply_handler_base& h);
     future<std::tuple<int64_t, std::optional<rcv_buf>>>
     read_response_frame(input_stream<char>& in);
     future<std::tuple<int64_t, std::optional<rcv_buf>>>
@@ -478,8 +528,12 @@ public:
         return _stats;
     }
     auto next_message_id() { return _message_id++; }
+    // The QoS tag to attach to an outgoing call, sampled in the caller's
+    // context (zero when no tag source is configured).
+    uint8_t qos_tag() const {
+        return _options.qos_tag_source ? _options.qos_tag_source() : 0;
+    }
     void wait_for_reply(id_type id, std::unique_ptr<reply_handler_base>&& h, std::optional<rpc_clock_type::time_point> timeout, cancellable* cancel);
-    void wait_timed_out(id_type id);
     future<> stop();
     void abort_all_streams();
     void deregister_this_stream();
@@ -532,7 +586,7 @@ public:
         std::optional<isolation_config> _isolation_config;
     private:
         future<> negotiate_protocol(input_stream<char>& in);
-        future<std::tuple<std::optional<uint64_t>, uint64_t, int64_t, std::optional<rcv_buf>>>
+        future<std::tuple<std::optional<uint64_t>, std::optional<uint8_t>, uint64_t, int64_t, std::optional<rcv_buf>>>
         read_request_frame_compressed(input_stream<char>& in);
         future<feature_map> negotiate(feature_map requested);
         void send_loop() {
@@ -590,6 +644,15 @@ private:
     gate _reply_gate;
     server_options _options;
     uint64_t _next_client_id = 1;
+    // Isolation configurations resolved from per-call QoS tags, cached so
+    // that resource_limits::isolate_call runs once per tag per shard.
+    std::unordered_map<uint8_t, isolation_config> _qos_configs;
+    // Reverse map from scheduling group to the isolation configuration that
+    // selected it, serving isolation_config_for() lookups by handlers.
+    std::unordered_map<unsigned, isolation_config> _isolation_by_sg;
+
+    isolation_config qos_isolation(uint8_t qos_tag);
+    void remember_isolation(const isolation_config& cfg);
 
 public:
     server(protocol_base* proto, const socket_address& addr, resource_limits memory_limit = resource_limits());
@@ -607,17 +670,42 @@ public:
     gate& reply_gate() {
         return _reply_gate;
     }
+    /// Returns the isolation configuration that selected \c sg, if any, so a
+    /// verb handler can recover the I/O priority class of the call it is
+    /// servicing from its own \ref current_scheduling_group.
+    std::optional<isolation_config> isolation_config_for(scheduling_group sg) const;
+    /// Exports aggregate metrics for this server's open connections: send
+    /// queue depth, bytes on the wire and compression ratio components.
+    /// \param domain a label value distinguishing this server from other
+    ///     rpc servers on the same shard; must be unique among them.
+    void register_metrics(const sstring& domain);
     friend connection;
     friend client;
+private:
+    metrics::metric_groups _metric_group;
 };
 
 using rpc_handler_func = std::function<future<> (shared_ptr<server::connection>, std::optional<rpc_clock_type::time_point> timeout, int64_t msgid,
                                                  rcv_buf data)>;
 
 struct rpc_handler {
+    using dispatch_stage_type = inheriting_concrete_execution_stage<future<>,
+            shared_ptr<server::connection>, std::optional<rpc_clock_type::time_point>, int64_t, rcv_buf>;
     scheduling_group sg;
     rpc_handler_func func;
+    // set by protocol::enable_batched_dispatch(); when present, incoming
+    // calls for the verb are funneled through the stage so that requests
+    // arriving within one poll batch run back-to-back
+    std::unique_ptr<dispatch_stage_type> stage;
     gate use_gate;
+    // cheap counters updated on every invocation; exported only if
+    // protocol::enable_per_verb_metrics() was called
+    struct {
+        uint64_t count = 0;       // invocations of the handler
+        uint64_t bytes_in = 0;    // request payload bytes
+        std::chrono::nanoseconds handler_time = {}; // time spent in the handler
+    } stats;
+    metrics::metric_groups metric_group;
 };
 
 class protocol_base {
@@ -878,7 +966,44 @@ private:
         if (!r.second) {
             throw_with_backtrace<std::runtime_error>("registered handler already exists");
         }
+        if (_metrics_domain) {
+            register_verb_metrics(t, r.first->second);
+        }
     }
+
+    void register_verb_metrics(MsgType t, rpc_handler& handler);
+
+    std::optional<sstring> _metrics_domain;
+
+public:
+    /// Starts exporting per-verb counters (invocations, request bytes, time
+    /// spent in the handler) for all verbs registered with this protocol,
+    /// labeled by verb id. The counters are maintained regardless, so
+    /// enabling this adds no hot-path cost.
+    ///
+    /// \param domain a label value distinguishing this protocol instance
+    ///     from other protocols on the same shard; must be unique among them.
+    void enable_per_verb_metrics(const sstring& domain) {
+        _metrics_domain = domain;
+        for (auto& e : _handlers) {
+            register_verb_metrics(e.first, e.second);
+        }
+    }
+
+    /// Routes incoming calls for the verb through an execution stage, so
+    /// that requests arriving within one poll batch run back-to-back
+    /// instead of interleaving with unrelated handlers. For verbs that
+    /// arrive in bursts this improves instruction cache locality at the
+    /// cost of some added latency. Batches are cut by preemption and are
+    /// additionally capped to the reactor's task quota, so a backlogged
+    /// verb cannot stall other scheduling groups.
+    ///
+    /// The handler for the verb must already be registered. The stage is
+    /// named after the verb id, so the same verb id must not have batched
+    /// dispatch enabled in two protocol instances on one shard.
+    ///
+    /// \param t the verb to dispatch through an execution stage.
+    void enable_batched_dispatch(MsgType t);
 };
 
 /// @}
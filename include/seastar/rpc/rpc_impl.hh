@@ -29,6 +29,7 @@
 #include <boost/range/numeric.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <seastar/net/packet-data-source.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/core/print.hh>
 
 namespace seastar {
@@ -213,8 +214,12 @@ template <typename Serializer, typename Output>
 struct marshall_one {
     template <typename T> struct helper {
         static void doit(Serializer& serializer, Output& out, const T& arg) {
-            using serialize_helper_type = serialize_helper<is_smart_ptr<typename std::remove_reference<T>::type>::value>;
-            serialize_helper_type::serialize(serializer, out, arg);
+            if constexpr (std::is_same_v<T, rcv_buf>) {
+                put_rcv_buf(out, arg);
+            } else {
+                using serialize_helper_type = serialize_helper<is_smart_ptr<typename std::remove_reference<T>::type>::value>;
+                serialize_helper_type::serialize(serializer, out, arg);
+            }
         }
     };
     template<typename T> struct helper<std::reference_wrapper<const T>> {
@@ -226,6 +231,21 @@ struct marshall_one {
         sstring id = serialize_connection_id(cid);
         out.write(id.c_str(), id.size());
     }
+    // An rcv_buf parameter travels as a length-prefixed blob of raw bytes,
+    // bypassing the user serializer. The receiving side hands it to the
+    // handler as zero-copy views of the connection's receive buffer (see
+    // unmarshal_one below).
+    static void put_rcv_buf(Output& out, const rcv_buf& data) {
+        uint32_t v32 = cpu_to_le(data.size);
+        out.write(reinterpret_cast<const char*>(&v32), sizeof(v32));
+        if (auto* b = std::get_if<temporary_buffer<char>>(&data.bufs)) {
+            out.write(b->get(), b->size());
+        } else {
+            for (auto& b : std::get<std::vector<temporary_buffer<char>>>(data.bufs)) {
+                out.write(b.get(), b.size());
+            }
+        }
+    }
     template <typename... T> struct helper<sink<T...>> {
         static void doit(Serializer& serializer, Output& out, const sink<T...>& arg) {
             put_connection_id(arg.get_id(), out);
@@ -262,41 +282,167 @@ static inline memory_output_stream<snd_buf::iterator> make_serializer_stream(snd
     }
 }
 
+// Detects whether Serializer declares
+//
+//     static constexpr bool rpc_flat_serialization = true;
+//
+// by which it promises that its encoding of any trivially copyable argument
+// is exactly the argument's in-memory representation, allowing the
+// marshalling code to bypass it entirely for such arguments.
+template <typename Serializer, typename = void>
+struct serializer_supports_flat_serialization : std::false_type {};
+
+template <typename Serializer>
+struct serializer_supports_flat_serialization<Serializer, std::enable_if_t<Serializer::rpc_flat_serialization>> : std::true_type {};
+
+// Argument types must be normalized before checking: marshalling sees
+// const references and std::reference_wrapper where unmarshalling sees
+// plain values, and both sides have to agree on whether the fast path
+// applies.
+template <typename T>
+struct flat_serializable_arg_impl : std::bool_constant<std::is_trivially_copyable_v<T> &&
+                                                       std::is_trivially_default_constructible_v<T> &&
+                                                       std::has_unique_object_representations_v<T>> {};
+template <typename T>
+struct flat_serializable_arg_impl<std::reference_wrapper<const T>> : flat_serializable_arg_impl<std::remove_cv_t<T>> {};
+// an optional argument's presence is signalled by bytes remaining in the
+// stream, which has no flat image
+template <typename T>
+struct flat_serializable_arg_impl<optional<T>> : std::false_type {};
+
+template <typename T>
+struct flat_serializable_arg : flat_serializable_arg_impl<std::remove_cv_t<std::remove_reference_t<T>>> {};
+
+/// Whether calls of a verb with the given argument (or return) types are
+/// marshalled by memcpying the packed argument images instead of going
+/// through Serializer. This requires the serializer to opt in with
+///
+///     static constexpr bool rpc_flat_serialization = true;
+///
+/// and every argument to be trivially copyable with no padding bytes (and
+/// hence no floating point members). Performance-critical verbs can
+/// static_assert() this trait to verify that they hit the fast path. Note
+/// that flat images are in host representation, so the serializer must only
+/// opt in if all communicating hosts share one.
+template <typename Serializer, typename... T>
+struct is_flat_serializable : std::bool_constant<serializer_supports_flat_serialization<Serializer>::value &&
+                                                 sizeof...(T) != 0 &&
+                                                 (flat_serializable_arg<T>::value && ...)> {};
+
+template <typename Serializer, typename... T>
+inline constexpr bool is_flat_serializable_v = is_flat_serializable<Serializer, T...>::value;
+
+template <typename T>
+struct unwrap_flat_arg_type_impl { using type = T; };
+template <typename T>
+struct unwrap_flat_arg_type_impl<std::reference_wrapper<const T>> { using type = std::remove_cv_t<T>; };
+template <typename T>
+using unwrap_flat_arg_t = typename unwrap_flat_arg_type_impl<std::remove_cv_t<std::remove_reference_t<T>>>::type;
+
+template <typename T>
+inline const T& unwrap_flat_arg(const T& arg) {
+    return arg;
+}
+template <typename T>
+inline const T& unwrap_flat_arg(const std::reference_wrapper<const T>& arg) {
+    return arg.get();
+}
+
 template <typename Serializer, typename... T>
 inline snd_buf marshall(Serializer& serializer, size_t head_space, const T&... args) {
-    measuring_output_stream measure;
-    do_marshall(serializer, measure, args...);
-    snd_buf ret(measure.size() + head_space);
-    auto out = make_serializer_stream(ret);
-    out.skip(head_space);
-    do_marshall(serializer, out, args...);
+    if constexpr (is_flat_serializable_v<Serializer, T...>) {
+        // sizes are compile-time constants, so these writes compile down to
+        // fixed-size memcpys of the argument images, with no measuring pass
+        // and no serializer involvement
+        constexpr size_t size = (sizeof(unwrap_flat_arg_t<T>) + ...);
+        snd_buf ret(head_space + size);
+        auto out = make_serializer_stream(ret);
+        out.skip(head_space);
+        (out.write(reinterpret_cast<const char*>(&unwrap_flat_arg(args)), sizeof(unwrap_flat_arg(args))), ...);
+        return ret;
+    } else {
+        measuring_output_stream measure;
+        do_marshall(serializer, measure, args...);
+        snd_buf ret(measure.size() + head_space);
+        auto out = make_serializer_stream(ret);
+        out.skip(head_space);
+        do_marshall(serializer, out, args...);
+        return ret;
+    }
+}
+
+// Carves the next len bytes of the deserialization stream out as an rcv_buf
+// sharing the connection's receive buffer org instead of copying from it.
+// The returned fragments remain valid for as long as the handler keeps them,
+// even after the request buffer itself is dismissed.
+template <typename Input>
+inline rcv_buf share_rcv_buf_view(rcv_buf& org, Input& in, uint32_t len) {
+    if (len > in.size()) {
+        throw std::out_of_range("deserialization buffer underflow");
+    }
+    rcv_buf ret(len);
+    in.with_stream(make_visitor(
+        [&] (simple_input_stream& s) {
+            auto& buf = std::get<temporary_buffer<char>>(org.bufs);
+            ret.bufs = buf.share(s.begin() - buf.get(), len);
+        },
+        [&] (fragmented_memory_input_stream<rcv_buf::iterator>& s) {
+            auto frags = std::vector<temporary_buffer<char>>();
+            auto it = s.fragment_iterator();
+            auto left = size_t(len);
+            // the view may start in the middle of the fragment the stream
+            // is currently positioned in
+            if (left && s.first_fragment_size()) {
+                auto& cur = *std::prev(it);
+                auto this_size = std::min(left, s.first_fragment_size());
+                frags.push_back(cur.share(s.first_fragment_data() - cur.get(), this_size));
+                left -= this_size;
+            }
+            while (left) {
+                auto this_size = std::min(left, it->size());
+                frags.push_back(it->share(0, this_size));
+                left -= this_size;
+                ++it;
+            }
+            ret.bufs = std::move(frags);
+        }
+    ));
+    in.skip(len);
     return ret;
 }
 
 template <typename Serializer, typename Input>
-inline std::tuple<> do_unmarshall(connection& c, Input& in) {
+inline std::tuple<> do_unmarshall(connection& c, rcv_buf& org, Input& in) {
     return std::make_tuple();
 }
 
 template<typename Serializer, typename Input>
 struct unmarshal_one {
     template<typename T> struct helper {
-        static T doit(connection& c, Input& in) {
-            return read(c.serializer<Serializer>(), in, type<T>());
+        static T doit(connection& c, rcv_buf& org, Input& in) {
+            if constexpr (std::is_same_v<T, rcv_buf>) {
+                // delivered as zero-copy views into org, bypassing the
+                // user serializer (see marshall_one::put_rcv_buf)
+                uint32_t v32;
+                in.read(reinterpret_cast<char*>(&v32), sizeof(v32));
+                return share_rcv_buf_view(org, in, le_to_cpu(v32));
+            } else {
+                return read(c.serializer<Serializer>(), in, type<T>());
+            }
         }
     };
     template<typename T> struct helper<optional<T>> {
-        static optional<T> doit(connection& c, Input& in) {
+        static optional<T> doit(connection& c, rcv_buf& org, Input& in) {
             if (in.size()) {
-                return optional<T>(read(c.serializer<Serializer>(), in, type<typename remove_optional<T>::type>()));
+                return optional<T>(helper<typename remove_optional<T>::type>::doit(c, org, in));
             } else {
                 return optional<T>();
             }
         }
     };
     template<typename T> struct helper<std::reference_wrapper<const T>> {
-        static T doit(connection& c, Input& in) {
-            return helper<T>::doit(c, in);
+        static T doit(connection& c, rcv_buf& org, Input& in) {
+            return helper<T>::doit(c, org, in);
         }
     };
     static connection_id get_connection_id(Input& in) {
@@ -305,34 +451,46 @@ struct unmarshal_one {
         return deserialize_connection_id(id);
     }
     template<typename... T> struct helper<sink<T...>> {
-        static sink<T...> doit(connection& c, Input& in) {
+        static sink<T...> doit(connection& c, rcv_buf& org, Input& in) {
             return sink<T...>(make_shared<sink_impl<Serializer, T...>>(c.get_stream(get_connection_id(in))));
         }
     };
     template<typename... T> struct helper<source<T...>> {
-        static source<T...> doit(connection& c, Input& in) {
+        static source<T...> doit(connection& c, rcv_buf& org, Input& in) {
             return source<T...>(make_shared<source_impl<Serializer, T...>>(c.get_stream(get_connection_id(in))));
         }
     };
     template <typename... T> struct helper<tuple<T...>> {
-        static tuple<T...> doit(connection& c, Input& in) {
-            return do_unmarshall<Serializer, Input, T...>(c, in);
+        static tuple<T...> doit(connection& c, rcv_buf& org, Input& in) {
+            return do_unmarshall<Serializer, Input, T...>(c, org, in);
         }
     };
 };
 
 template <typename Serializer, typename Input, typename T0, typename... Trest>
-inline std::tuple<T0, Trest...> do_unmarshall(connection& c, Input& in) {
+inline std::tuple<T0, Trest...> do_unmarshall(connection& c, rcv_buf& org, Input& in) {
     // FIXME: something less recursive
-    auto first = std::make_tuple(unmarshal_one<Serializer, Input>::template helper<T0>::doit(c, in));
-    auto rest = do_unmarshall<Serializer, Input, Trest...>(c, in);
+    auto first = std::make_tuple(unmarshal_one<Serializer, Input>::template helper<T0>::doit(c, org, in));
+    auto rest = do_unmarshall<Serializer, Input, Trest...>(c, org, in);
     return std::tuple_cat(std::move(first), std::move(rest));
 }
 
+template <typename T, typename Input>
+inline T read_flat_arg(Input& in) {
+    T arg;
+    in.read(reinterpret_cast<char*>(&arg), sizeof(T));
+    return arg;
+}
+
 template <typename Serializer, typename... T>
 inline std::tuple<T...> unmarshall(connection& c, rcv_buf input) {
     auto in = make_deserializer_stream(input);
-    return do_unmarshall<Serializer, decltype(in), T...>(c, in);
+    if constexpr (is_flat_serializable_v<Serializer, T...>) {
+        // braced initialization reads the argument images in order
+        return std::tuple<T...>{read_flat_arg<T>(in)...};
+    } else {
+        return do_unmarshall<Serializer, decltype(in), T...>(c, input, in);
+    }
 }
 
 inline std::exception_ptr unmarshal_exception(rcv_buf& d) {
@@ -464,12 +622,17 @@ auto send_helper(MsgType xt, signature<Ret (InArgs...)> xsig) {
 
             // send message
             auto msg_id = dst.next_message_id();
-            snd_buf data = marshall(dst.template serializer<Serializer>(), 28, args...);
-            static_assert(snd_buf::chunk_size >= 28, "send buffer chunk size is too small");
-            auto p = data.front().get_write() + 8; // 8 extra bytes for expiration timer
+            snd_buf data = marshall(dst.template serializer<Serializer>(), 29, args...);
+            static_assert(snd_buf::chunk_size >= 29, "send buffer chunk size is too small");
+            // one byte for the QoS tag and 8 extra bytes for expiration timer;
+            // the tag is sampled here, in the caller's context, while unneeded
+            // header fields are dropped later in the send loop
+            auto p = data.front().get_write();
+            *p = static_cast<char>(dst.qos_tag());
+            p += 9;
             write_le<uint64_t>(p, uint64_t(t));
             write_le<int64_t>(p + 8, msg_id);
-            write_le<uint32_t>(p + 16, data.size - 28);
+            write_le<uint32_t>(p + 16, data.size - 29);
 
             // prepare reply handler, if return type is now_wait_type this does nothing, since no reply will be sent
             using wait = wait_signature_t<Ret>;
@@ -722,6 +885,48 @@ void protocol<Serializer, MsgType>::put_handler(rpc_handler* h) {
     h->use_gate.leave();
 }
 
+template<typename Serializer, typename MsgType>
+void protocol<Serializer, MsgType>::register_verb_metrics(MsgType t, rpc_handler& handler) {
+    namespace sm = seastar::metrics;
+    std::vector<sm::label_instance> labels = {
+        sm::label("domain")(*_metrics_domain),
+        sm::label("verb")(format("{}", t)),
+    };
+    // the metrics are dropped with the handler when the verb is unregistered
+    handler.metric_group.add_group("rpc", {
+        sm::make_derive("requests", handler.stats.count,
+                sm::description("Number of requests received for the verb"), labels),
+        sm::make_total_bytes("request_bytes", handler.stats.bytes_in,
+                sm::description("Payload bytes of requests received for the verb"), labels),
+        sm::make_derive("handler_time_ms", [&handler] () -> int64_t {
+                    return std::chrono::duration_cast<std::chrono::milliseconds>(handler.stats.handler_time).count();
+                },
+                sm::description("Total time spent executing the verb's handler, in milliseconds"), labels),
+    });
+}
+
+template<typename Serializer, typename MsgType>
+void protocol<Serializer, MsgType>::enable_batched_dispatch(MsgType t) {
+    auto it = _handlers.find(t);
+    if (it == _handlers.end()) {
+        throw_with_backtrace<std::runtime_error>("trying to enable batched dispatch for an unknown verb");
+    }
+    auto& handler = it->second;
+    if (handler.stage) {
+        return;
+    }
+    // the handler stays in _handlers until the verb is unregistered and the
+    // stage is destroyed together with it, so the reference capture is safe
+    handler.stage = std::make_unique<rpc_handler::dispatch_stage_type>(format("rpc-verb-{}", t),
+            [&handler] (shared_ptr<rpc::server::connection> conn, std::optional<rpc_clock_type::time_point> timeout, int64_t msg_id, rcv_buf data) {
+        auto start = std::chrono::steady_clock::now();
+        return handler.func(std::move(conn), timeout, msg_id, std::move(data)).finally([&handler, start] {
+            handler.stats.handler_time += std::chrono::steady_clock::now() - start;
+        });
+    });
+    handler.stage->pin_batch_to_task_quota();
+}
+
 template<typename T> T make_shard_local_buffer_copy(foreign_ptr<std::unique_ptr<T>> org);
 
 template<typename Serializer, typename... Out>
@@ -736,12 +941,13 @@ future<> sink_impl<Serializer, Out...>::operator()(const Out&... args) {
     // but only one at a time
     auto size = std::min(size_t(data.size), max_stream_buffers_memory);
     const auto seq_num = _next_seq_num++;
-    return get_units(this->_sem, size).then([this, data = make_foreign(std::make_unique<snd_buf>(std::move(data))), seq_num] (semaphore_units<> su) mutable {
+    return get_units(this->_sem, size).then([this, size, data = make_foreign(std::make_unique<snd_buf>(std::move(data))), seq_num] (semaphore_units<> su) mutable {
         if (this->_ex) {
             return make_exception_future(this->_ex);
         }
         // It is OK to discard this future. The user is required to
         // wait for it when closing.
+        auto start = std::chrono::steady_clock::now();
         (void)smp::submit_to(this->_con->get_owner_shard(), [this, data = std::move(data), seq_num] () mutable {
             connection* con = this->_con->get();
             if (con->error()) {
@@ -771,11 +977,12 @@ future<> sink_impl<Serializer, Out...>::operator()(const Out&... args) {
                 out_of_order_bufs.erase(it);
             }
             return ret_fut;
-        }).then_wrapped([su = std::move(su), this] (future<> f) {
+        }).then_wrapped([su = std::move(su), this, size, start] (future<> f) {
             if (f.failed() && !this->_ex) { // first error is the interesting one
                 this->_ex = f.get_exception();
             } else {
                 f.ignore_ready_future();
+                this->adjust_window(size, std::chrono::steady_clock::now() - start);
             }
         });
         return make_ready_future<>();
@@ -784,18 +991,23 @@ future<> sink_impl<Serializer, Out...>::operator()(const Out&... args) {
 
 template<typename Serializer, typename... Out>
 future<> sink_impl<Serializer, Out...>::flush() {
-    // wait until everything is sent out before returning.
-    return with_semaphore(this->_sem, max_stream_buffers_memory, [this] {
+    // wait until everything is sent out before returning. The window must
+    // not be resized while we wait for all of its units.
+    this->freeze_window();
+    return with_semaphore(this->_sem, this->window_size(), [this] {
         if (this->_ex) {
             return make_exception_future(this->_ex);
         }
         return make_ready_future();
+    }).finally([this] {
+        this->unfreeze_window();
     });
 }
 
 template<typename Serializer, typename... Out>
 future<> sink_impl<Serializer, Out...>::close() {
-    return with_semaphore(this->_sem, max_stream_buffers_memory, [this] {
+    this->freeze_window(); // the sink is done, the window stays as it is
+    return with_semaphore(this->_sem, this->window_size(), [this] {
         return smp::submit_to(this->_con->get_owner_shard(), [this] {
             connection* con = this->_con->get();
             if (con->sink_closed()) { // double close, should not happen!
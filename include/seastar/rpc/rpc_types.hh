@@ -53,6 +53,11 @@ struct stats {
     counter_type sent_messages = 0;
     counter_type wait_reply = 0;
     counter_type timeout = 0;
+    counter_type bytes_sent = 0;     // wire bytes of sent frames, after compression
+    counter_type bytes_received = 0; // payload bytes of received request/response frames
+    counter_type compression_input_bytes = 0;  // bytes fed to the compressor
+    counter_type compression_output_bytes = 0; // bytes the compressor produced from them
+    counter_type deferred_on_overload = 0;     // times the server paused reading requests on shard overload
 };
 
 
@@ -176,6 +181,10 @@ struct cancellable {
     }
 };
 
+// Also usable directly as a verb parameter or return type: the payload is
+// then transferred as a raw blob, bypassing the serializer, and the handler
+// receives the fragments as zero-copy views of the connection's receive
+// buffer.
 struct rcv_buf {
     uint32_t size = 0;
     std::optional<semaphore_units<>> su;
@@ -264,6 +273,8 @@ std::ostream& operator<<(std::ostream&, const connection_id&);
 using xshard_connection_ptr = lw_shared_ptr<foreign_ptr<shared_ptr<connection>>>;
 constexpr size_t max_queued_stream_buffers = 50;
 constexpr size_t max_stream_buffers_memory = 100 * 1024;
+// upper bound a sink's adaptive send window may grow to
+constexpr size_t max_stream_window_memory = 4 * 1024 * 1024;
 
 /// \addtogroup rpc
 /// @{
@@ -277,12 +288,57 @@ public:
         xshard_connection_ptr _con;
         semaphore _sem;
         std::exception_ptr _ex;
+        // The send window starts at max_stream_buffers_memory and adapts to
+        // the observed bandwidth-delay product of the connection: completion
+        // latency and throughput of sends are tracked as exponential moving
+        // averages and the window follows twice their product, clamped to
+        // [max_stream_buffers_memory, max_stream_window_memory]. Long fat
+        // pipes thus get a window large enough to keep them full, while
+        // low-latency peers stay at the floor.
+        size_t _window_size = max_stream_buffers_memory;
+        unsigned _window_frozen = 0; // flush/close in progress, do not resize
+        std::chrono::steady_clock::time_point _last_completion = {};
+        double _latency_ewma = 0; // seconds
+        double _rate_ewma = 0;    // bytes per second
         impl(xshard_connection_ptr con) : _con(std::move(con)), _sem(max_stream_buffers_memory) {}
+        void adjust_window(size_t bytes, std::chrono::steady_clock::duration latency) {
+            auto now = std::chrono::steady_clock::now();
+            auto lat = std::chrono::duration<double>(latency).count();
+            _latency_ewma = _latency_ewma ? _latency_ewma * 0.75 + lat * 0.25 : lat;
+            if (_last_completion != std::chrono::steady_clock::time_point()) {
+                auto interval = std::chrono::duration<double>(now - _last_completion).count();
+                auto rate = bytes / std::max(interval, 1e-6);
+                _rate_ewma = _rate_ewma ? _rate_ewma * 0.75 + rate * 0.25 : rate;
+            }
+            _last_completion = now;
+            if (_window_frozen) {
+                return;
+            }
+            auto target = std::min(std::max(size_t(_rate_ewma * _latency_ewma * 2), max_stream_buffers_memory), max_stream_window_memory);
+            if (target > _window_size) {
+                _sem.signal(target - _window_size);
+            } else if (target < _window_size) {
+                _sem.consume(_window_size - target);
+            }
+            _window_size = target;
+        }
+        void freeze_window() {
+            _window_frozen++;
+        }
+        void unfreeze_window() {
+            _window_frozen--;
+        }
     public:
         virtual ~impl() {};
         virtual future<> operator()(const Out&... args) = 0;
         virtual future<> close() = 0;
         virtual future<> flush() = 0;
+        size_t window_size() const {
+            return _window_size;
+        }
+        size_t window_used() const {
+            return _window_size - std::min(_sem.available_units(), ssize_t(_window_size));
+        }
         friend sink;
     };
 
@@ -304,6 +360,16 @@ public:
     future<> flush() {
         return _impl->flush();
     }
+    // Current adaptive send window of the sink, in bytes, and how much of
+    // it is occupied by sends in flight. The ratio is the sink's window
+    // utilization; streams are per-object, so exporting it as a metric is
+    // left to the application.
+    size_t window_size() const {
+        return _impl->window_size();
+    }
+    size_t window_used() const {
+        return _impl->window_used();
+    }
     connection_id get_id() const;
 };
 
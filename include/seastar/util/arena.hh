@@ -0,0 +1,199 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace seastar {
+
+/// \addtogroup memory-module
+/// @{
+
+/// \brief Bump-pointer region allocator for objects that die together.
+///
+/// An arena hands out memory by advancing a pointer through large
+/// chunks obtained from the shard's allocator, and releases everything
+/// at once: \ref reset() rewinds the arena to its beginning in O(1),
+/// keeping the chunks for reuse by the next round of allocations. This
+/// suits request handlers that allocate many short-lived objects with a
+/// common lifetime (parse trees, scratch buffers, serialization state)
+/// and would otherwise churn the general allocator's free lists.
+///
+/// Individual allocations cannot be freed, and the arena does not run
+/// destructors: objects placed in it must either be trivially
+/// destructible or be destroyed by the caller before \ref reset().
+///
+/// Like any other seastar object, an arena belongs to the shard that
+/// created it and must not be used from other shards.
+class arena {
+    struct chunk {
+        chunk* next;
+        size_t size; // of data[]
+        char* data() noexcept {
+            return reinterpret_cast<char*>(this) + data_offset;
+        }
+    };
+    static constexpr size_t data_offset = (sizeof(chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+public:
+    static constexpr size_t default_chunk_size = 128 * 1024 - data_offset;
+private:
+    chunk* _head = nullptr;
+    chunk* _current = nullptr;
+    char* _pos = nullptr;
+    char* _end = nullptr;
+    size_t _chunk_size;
+private:
+    static chunk* make_chunk(size_t size) {
+        auto c = static_cast<chunk*>(::operator new(data_offset + size));
+        c->next = nullptr;
+        c->size = size;
+        return c;
+    }
+    // Moves on to the next retained chunk, or a freshly allocated one,
+    // that can hold size bytes.
+    void* alloc_slow(size_t size, size_t alignment) {
+        while (_current && _current->next) {
+            _current = _current->next;
+            _pos = _current->data();
+            _end = _pos + _current->size;
+            if (auto p = try_alloc(size, alignment)) {
+                return p;
+            }
+        }
+        auto c = make_chunk(std::max(size + alignment, _chunk_size));
+        if (_current) {
+            _current->next = c;
+        } else {
+            _head = c;
+        }
+        _current = c;
+        _pos = c->data();
+        _end = _pos + c->size;
+        return try_alloc(size, alignment);
+    }
+    void* try_alloc(size_t size, size_t alignment) noexcept {
+        auto pos = reinterpret_cast<uintptr_t>(_pos);
+        auto aligned = (pos + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        if (aligned + size > reinterpret_cast<uintptr_t>(_end)) {
+            return nullptr;
+        }
+        _pos = reinterpret_cast<char*>(aligned + size);
+        return reinterpret_cast<void*>(aligned);
+    }
+public:
+    explicit arena(size_t chunk_size = default_chunk_size) noexcept
+        : _chunk_size(chunk_size) {
+    }
+    arena(arena&& other) noexcept
+        : _head(std::exchange(other._head, nullptr))
+        , _current(std::exchange(other._current, nullptr))
+        , _pos(std::exchange(other._pos, nullptr))
+        , _end(std::exchange(other._end, nullptr))
+        , _chunk_size(other._chunk_size) {
+    }
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+    ~arena() {
+        auto c = _head;
+        while (c) {
+            auto next = c->next;
+            ::operator delete(c);
+            c = next;
+        }
+    }
+
+    /// Allocates uninitialized memory from the arena.
+    ///
+    /// \param size number of bytes to allocate
+    /// \param alignment required alignment; must be a power of two
+    void* alloc(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        if (auto p = try_alloc(size, alignment)) {
+            return p;
+        }
+        return alloc_slow(size, alignment);
+    }
+
+    /// Rewinds the arena to its beginning, releasing all allocations at
+    /// once. O(1); the backing chunks are retained and reused by
+    /// subsequent allocations.
+    void reset() noexcept {
+        _current = _head;
+        if (_current) {
+            _pos = _current->data();
+            _end = _pos + _current->size;
+        }
+    }
+
+    /// Constructs an object of type T in the arena. The object will not
+    /// be destroyed by the arena; see the class comment.
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        return new (alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+};
+
+/// \brief STL-compatible allocator backed by an \ref arena.
+///
+/// Lets standard containers place their elements in an arena:
+///
+/// ```
+/// arena a;
+/// std::vector<int, arena_allocator<int>> v{arena_allocator<int>(a)};
+/// ```
+///
+/// deallocate() is a no-op; the memory is reclaimed wholesale by
+/// arena::reset(). The arena must outlive any container using it.
+template <typename T>
+class arena_allocator {
+    arena* _arena;
+    template <typename U>
+    friend class arena_allocator;
+public:
+    using value_type = T;
+
+    explicit arena_allocator(arena& a) noexcept : _arena(&a) {}
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept : _arena(other._arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(_arena->alloc(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) noexcept {
+        // reclaimed wholesale by arena::reset()
+    }
+
+    bool operator==(const arena_allocator& other) const noexcept {
+        return _arena == other._arena;
+    }
+    bool operator!=(const arena_allocator& other) const noexcept {
+        return _arena != other._arena;
+    }
+};
+
+/// @}
+
+}
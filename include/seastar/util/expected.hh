@@ -0,0 +1,111 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB
+ */
+
+#pragma once
+
+#include <cassert>
+#include <optional>
+#include <utility>
+#include <variant>
+
+namespace seastar {
+
+/// \addtogroup utilities
+/// @{
+
+/// Wrapper distinguishing an error value from a success value of the
+/// same type when constructing an \ref expected.
+///
+/// \see expected
+template <typename E>
+struct unexpected {
+    E error;
+};
+
+template <typename E>
+unexpected(E) -> unexpected<E>;
+
+/// A value of type \c T, or an error of type \c E explaining why the
+/// value is unavailable.
+///
+/// This is a minimal analog of C++23's `std::expected`, used as a future
+/// payload to report anticipated failures — timeouts, mostly — as plain
+/// values. An exceptional future costs an `std::exception_ptr` allocation
+/// when it is created and a `throw`/`catch` cycle whenever it is examined;
+/// for failures that occur at a high rate and are always handled, carrying
+/// the error in the value channel avoids the exception-handling runtime
+/// completely. Unanticipated failures should continue to use exceptional
+/// futures.
+///
+/// \see seastar::basic_semaphore::wait_expected()
+/// \see seastar::with_timeout_expected()
+template <typename T, typename E>
+class expected {
+    std::variant<T, E> _u;
+public:
+    using value_type = T;
+    using error_type = E;
+    /// Constructs an expected holding a value.
+    expected(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : _u(std::in_place_index<0>, std::move(value)) {}
+    /// Constructs an expected holding an error.
+    expected(unexpected<E> e) noexcept(std::is_nothrow_move_constructible_v<E>)
+        : _u(std::in_place_index<1>, std::move(e.error)) {}
+    /// Returns true if a value is held.
+    bool has_value() const noexcept { return _u.index() == 0; }
+    /// Returns true if a value is held.
+    explicit operator bool() const noexcept { return has_value(); }
+    /// Returns the held value. Must not be called unless \ref has_value().
+    T& value() & noexcept { return std::get<0>(_u); }
+    const T& value() const& noexcept { return std::get<0>(_u); }
+    T&& value() && noexcept { return std::get<0>(std::move(_u)); }
+    /// Returns the held error. Must not be called if \ref has_value().
+    E& error() & noexcept { return std::get<1>(_u); }
+    const E& error() const& noexcept { return std::get<1>(_u); }
+    E&& error() && noexcept { return std::get<1>(std::move(_u)); }
+};
+
+/// Specialization of \ref expected for operations that produce no value;
+/// holds either success or an error of type \c E.
+template <typename E>
+class expected<void, E> {
+    std::optional<E> _error;
+public:
+    using value_type = void;
+    using error_type = E;
+    /// Constructs an expected denoting success.
+    expected() noexcept = default;
+    /// Constructs an expected holding an error.
+    expected(unexpected<E> e) noexcept(std::is_nothrow_move_constructible_v<E>)
+        : _error(std::move(e.error)) {}
+    /// Returns true if the operation succeeded.
+    bool has_value() const noexcept { return !_error; }
+    /// Returns true if the operation succeeded.
+    explicit operator bool() const noexcept { return has_value(); }
+    /// Returns the held error. Must not be called if \ref has_value().
+    E& error() & noexcept { return *_error; }
+    const E& error() const& noexcept { return *_error; }
+    E&& error() && noexcept { return *std::move(_error); }
+};
+
+/// @}
+
+}
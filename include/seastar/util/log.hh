@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include <seastar/core/scheduling.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/util/concepts.hh>
 #include <seastar/util/log-impl.hh>
@@ -84,9 +85,16 @@ class logger_registry;
 class logger {
     sstring _name;
     std::atomic<log_level> _level = { log_level::info };
+    // Per-instance rate limit, see set_rate_limit(). An interval of zero
+    // means no limit; the bookkeeping is racy across shards on purpose,
+    // rate limiting is approximate.
+    std::atomic<int64_t> _rate_limit_interval_ms = { 0 };
+    std::atomic<int64_t> _rate_limit_next_ms = { 0 };
+    std::atomic<uint64_t> _rate_limited_messages = { 0 };
     static std::ostream* _out;
     static std::atomic<bool> _ostream;
     static std::atomic<bool> _syslog;
+    static std::atomic<bool> _async;
 
 public:
     class log_writer {
@@ -135,6 +143,7 @@ private:
     // We can't use an std::function<> as it potentially allocates.
     void do_log(log_level level, log_writer& writer);
     void failed_to_log(std::exception_ptr ex, format_info fmt) noexcept;
+    bool check_instance_rate_limit() noexcept;
 public:
     /// Apply a rate limit to log message(s)
     ///
@@ -393,6 +402,40 @@ public:
     ///       this should be rare (will have to fill the pipe buffer
     ///       before syslogd can clear it) but can happen.
     static void set_syslog_enabled(bool enabled) noexcept;
+
+    /// Write log records asynchronously. default is false
+    ///
+    /// Instead of writing and flushing the ostream in the calling task,
+    /// formatted records are copied into a fixed per-shard ring buffer
+    /// and written out by a task scheduled in the drain scheduling
+    /// group (see \ref set_async_drain_scheduling_group()), so a burst
+    /// of messages does not stall the task that logs. When the ring
+    /// fills up further records are dropped and counted, and the next
+    /// drain reports how many were lost. Messages logged outside a
+    /// reactor thread fall back to the synchronous path.
+    static void set_async_enabled(bool enabled) noexcept;
+
+    /// Set the scheduling group draining the asynchronous log ring on
+    /// this shard; pick a low-priority one so logging yields to real
+    /// work. default is the default scheduling group
+    static void set_async_drain_scheduling_group(scheduling_group sg) noexcept;
+
+    /// Number of records dropped on this shard because the
+    /// asynchronous log ring was full
+    static uint64_t dropped_async_messages() noexcept;
+
+    /// Rate-limit all messages of this logger instance
+    ///
+    /// At most one record per interval is emitted, the rest are counted
+    /// in \ref rate_limited_messages(). Unlike \ref rate_limit this
+    /// covers every call site of the instance. An interval of zero
+    /// removes the limit.
+    void set_rate_limit(std::chrono::milliseconds interval) noexcept;
+
+    /// Number of messages suppressed by the per-instance rate limit
+    uint64_t rate_limited_messages() const noexcept {
+        return _rate_limited_messages.load(std::memory_order_relaxed);
+    }
 };
 
 /// \brief used to keep a static registry of loggers
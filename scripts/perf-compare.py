@@ -0,0 +1,92 @@
+#!/bin/env python3
+#
+# Compare two result files produced by a perf-tests binary run with
+# --json-output and report which differences look statistically
+# significant.
+#
+# Only summary statistics are stored in the JSON, so the test is an
+# approximate z-test: the median absolute deviation is converted to an
+# estimate of the standard deviation (sigma ~ 1.4826 * mad for normally
+# distributed samples) and the standard error of the median is derived
+# from it and the number of runs.
+#
+# This file is open source software, licensed to you under the terms
+# of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+# distributed with this work for additional information regarding copyright
+# ownership.  You may not use this file except in compliance with the License.
+#
+# Copyright (C) 2021 ScyllaDB
+
+import argparse
+import json
+import math
+import sys
+
+COUNTERS = ['cycles', 'instructions', 'llc-misses', 'branch-misses', 'dtlb-misses']
+
+# two-sided z threshold for p < 0.05
+Z_THRESHOLD = 1.96
+
+
+def load_results(path):
+    with open(path) as f:
+        return json.load(f)['results']
+
+
+def median_stderr(result):
+    # the median of n samples has a standard error of roughly
+    # 1.2533 * sigma / sqrt(n)
+    sigma = 1.4826 * result['mad']
+    return 1.2533 * sigma / math.sqrt(result['runs'])
+
+
+def compare(old, new):
+    delta = new['median'] - old['median']
+    se = math.hypot(median_stderr(old), median_stderr(new))
+    z = abs(delta) / se if se else math.inf
+    return delta, z
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='compare two perf-tests json result files')
+    parser.add_argument('old', help='baseline json file')
+    parser.add_argument('new', help='json file to compare against the baseline')
+    parser.add_argument('--all', action='store_true',
+                        help='show all tests, not only significant changes')
+    args = parser.parse_args()
+
+    old_results = load_results(args.old)
+    new_results = load_results(args.new)
+
+    common = sorted(set(old_results) & set(new_results))
+    if not common:
+        print('no common tests between the two files', file=sys.stderr)
+        return 1
+    for name in sorted(set(old_results) ^ set(new_results)):
+        print(f'# {name}: only in one of the files, skipped', file=sys.stderr)
+
+    fmt = '{:<40} {:>12} {:>12} {:>9} {:>7} {}'
+    print(fmt.format('test', 'old', 'new', 'diff', 'z', ''))
+    for name in common:
+        old, new = old_results[name], new_results[name]
+        delta, z = compare(old, new)
+        significant = z > Z_THRESHOLD
+        if not significant and not args.all:
+            continue
+        ratio = delta / old['median'] * 100 if old['median'] else math.inf
+        print(fmt.format(name, f"{old['median']:.3f}ns", f"{new['median']:.3f}ns",
+                         f'{ratio:+.1f}%', f'{z:.1f}',
+                         'SIGNIFICANT' if significant else ''))
+        # counters have no spread recorded, report the change as-is
+        for counter in COUNTERS:
+            if counter in old and counter in new:
+                cdelta = new[counter] - old[counter]
+                cratio = cdelta / old[counter] * 100 if old[counter] else math.inf
+                print(fmt.format(f'    {counter}', f'{old[counter]:.1f}',
+                                 f'{new[counter]:.1f}', f'{cratio:+.1f}%', '', ''))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -367,6 +367,7 @@ def create_h_file(data, hfile_name, api_name, init_method, base_api):
             member_init = ''
             member_assignment = ''
             member_copy = ''
+            member_append = ''
             for member_name in model["properties"]:
                 member = model["properties"][member_name]
                 if "description" in member:
@@ -385,6 +386,15 @@ def create_h_file(data, hfile_name, api_name, init_method, base_api):
                 member_init += member_name + '");\n'
                 member_assignment += "  " + member_name + " = " + "e." + member_name + ";\n"
                 member_copy += "  e." + member_name + " = " + member_name + ";\n"
+                member_append += Template("""  if ($name._set) {
+    if (!first) {
+      g.append_raw(", ", 2);
+    }
+    first = false;
+    g.append_raw("\\"$name\\": ", $len);
+    $name.append_value(g);
+  }
+""").substitute({'name': member_name, 'len': len(member_name) + 4})
             fprintln(hfile, "void register_params() {")
             fprintln(hfile, member_init)
             fprintln(hfile, '}')
@@ -410,6 +420,23 @@ def create_h_file(data, hfile_name, api_name, init_method, base_api):
             fprintln(hfile, member_copy)
             fprintln(hfile, "  return *this;")
             fprintln(hfile, "}")
+            print_comment(hfile, "A flat writer: the field layout is known here at generation " +
+                          "time, so the set fields serialize straight into the generator " +
+                          "with no virtual element dispatch and no string temporaries.")
+            fprintln(hfile, "void append(", config.jsonns, "::generator& g) const {")
+            fprintln(hfile, "  g.append('{');")
+            fprintln(hfile, "  bool first = true;")
+            fprintln(hfile, member_append)
+            fprintln(hfile, "  g.append('}');")
+            fprintln(hfile, "}")
+            fprintln(hfile, "virtual std::string to_json() const override {")
+            fprintln(hfile, "  ", config.jsonns, "::generator g;")
+            fprintln(hfile, "  append(g);")
+            fprintln(hfile, "  return std::string(g.str());")
+            fprintln(hfile, "}")
+            fprintln(hfile, "virtual future<> write(output_stream<char>& s) const override {")
+            fprintln(hfile, "  return ", config.jsonns, "::write_flat(*this, s);")
+            fprintln(hfile, "}")
             fprintln(hfile, "};\n\n")
 
  #   print_ind_comment(hfile, "", "Initialize the path")
@@ -55,6 +55,16 @@ void message_queue::submit_item(std::unique_ptr<message_queue::work_item> item)
     ++_sent.value;
 }
 
+void message_queue::finish_batch(size_t nr) {
+    if (!nr) {
+        return;
+    }
+    // one doorbell for the whole batch; skipped entirely when the reactor
+    // is awake and polling (see maybe_wakeup())
+    _pending.maybe_wakeup();
+    _sent.value.fetch_add(nr, std::memory_order_relaxed);
+}
+
 bool message_queue::pure_poll_rx() const {
     return !_pending.empty();
 }
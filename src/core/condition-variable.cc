@@ -20,6 +20,8 @@
  */
 
 #include <seastar/core/condition-variable.hh>
+#include <seastar/core/chunked_fifo.hh>
+#include <seastar/core/task.hh>
 
 namespace seastar {
 
@@ -41,4 +43,75 @@ broken_condition_variable condition_variable::condition_variable_exception_facto
     return broken_condition_variable();
 }
 
+// Wakes waiters detached by broadcast() in quota-sized batches,
+// rescheduling itself between batches so that the woken continuations
+// (and unrelated tasks) interleave with the drain instead of queueing
+// up behind thousands of wakeups.
+class condition_variable::broadcast_drain_task final : public task {
+    chunked_fifo<promise<>> _waiters;
+public:
+    explicit broadcast_drain_task(chunked_fifo<promise<>> waiters) noexcept
+        : _waiters(std::move(waiters)) {
+    }
+    virtual void run_and_dispose() noexcept override {
+        auto quota = max_wakeups_per_task;
+        while (!_waiters.empty() && quota--) {
+            _waiters.front().set_value();
+            _waiters.pop_front();
+        }
+        if (!_waiters.empty()) {
+            schedule(this);
+            return;
+        }
+        delete this;
+    }
+    virtual task* waiting_task() noexcept override {
+        return nullptr;
+    }
+};
+
+void condition_variable::broadcast() noexcept {
+    // Wake the first few waiters directly; a broadcast to a handful of
+    // fibers stays allocation-free.
+    auto quota = max_wakeups_per_task;
+    while (_waiters && quota--) {
+        _waiters.front().set_value();
+        _waiters.pop_front();
+    }
+    if (!_waiters) {
+        return;
+    }
+    // Detach the remainder into a drain task. Once detached, the waiters
+    // no longer depend on this condition variable being alive, and are
+    // out of reach of signal()/broken()/expiry.
+    chunked_fifo<promise<>> detached;
+    try {
+        while (_waiters) {
+            detached.push_back(std::move(_waiters.front()));
+            _waiters.pop_front();
+        }
+        schedule(new broadcast_drain_task(std::move(detached)));
+        return;
+    } catch (...) {
+        // Could not allocate the drain task; fall back to waking
+        // everything from here.
+    }
+    while (!detached.empty()) {
+        detached.front().set_value();
+        detached.pop_front();
+    }
+    while (_waiters) {
+        _waiters.front().set_value();
+        _waiters.pop_front();
+    }
+}
+
+void condition_variable::broken() noexcept {
+    _ex = std::make_exception_ptr(condition_variable_exception_factory::broken());
+    while (_waiters) {
+        _waiters.front().set_exception(_ex);
+        _waiters.pop_front();
+    }
+}
+
 } // namespace seastar
@@ -0,0 +1,73 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <seastar/core/cpu_profiler.hh>
+#include <seastar/core/do_with.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/http/function_handlers.hh>
+#include <boost/range/irange.hpp>
+
+#include "stall_detector.hh"
+
+namespace seastar {
+
+void enable_cpu_profiler(std::chrono::nanoseconds period) {
+    engine().profiler().enable(period);
+}
+
+void disable_cpu_profiler() {
+    engine().profiler().disable();
+}
+
+sstring dump_cpu_profile() {
+    return engine().profiler().dump_collapsed();
+}
+
+future<> add_cpu_profiler_routes(httpd::http_server& server) {
+    auto handler = [] (std::unique_ptr<httpd::request> req, std::unique_ptr<httpd::reply> rep) {
+        return do_with(sstring(), boost::irange(0u, smp::count), [] (sstring& profile, boost::integer_range<unsigned>& shards) {
+            return do_for_each(shards, [&profile] (unsigned cpu) {
+                return smp::submit_to(cpu, [] {
+                    return dump_cpu_profile();
+                }).then([&profile] (sstring shard_profile) {
+                    profile += shard_profile;
+                });
+            }).then([&profile] {
+                return std::move(profile);
+            });
+        }).then([rep = std::move(rep)] (sstring profile) mutable {
+            rep->write_body("txt", std::move(profile));
+            return make_ready_future<std::unique_ptr<httpd::reply>>(std::move(rep));
+        });
+    };
+    server._routes.put(httpd::GET, "/profiler", new httpd::function_handler(handler, "txt"));
+    return make_ready_future<>();
+}
+
+future<> add_cpu_profiler_routes(distributed<httpd::http_server>& server) {
+    return server.invoke_on_all([] (httpd::http_server& s) {
+        return add_cpu_profiler_routes(s);
+    });
+}
+
+}
@@ -22,6 +22,7 @@
 #include <seastar/core/execution_stage.hh>
 #include <seastar/core/print.hh>
 #include <seastar/core/make_task.hh>
+#include <seastar/core/reactor.hh>
 
 namespace seastar {
 
@@ -93,6 +94,9 @@ execution_stage::execution_stage(execution_stage&& other)
     , _stats(other._stats)
     , _name(std::move(other._name))
     , _metric_group(std::move(other._metric_group))
+    , _max_batch_duration(other._max_batch_duration)
+    , _ns_per_call_ema(other._ns_per_call_ema)
+    , _batch_limit(other._batch_limit)
 {
     internal::execution_stage_manager::get().update_execution_stage_registration(other, *this);
 }
@@ -128,10 +132,35 @@ execution_stage::execution_stage(const sstring& name, scheduling_group sg)
                                   [name, &esm = internal::execution_stage_manager::get()] {
                                       return esm.get_stage(name)->get_stats().function_calls_executed;
                                   }),
+             metrics::make_derive("batch_limit_reached",
+                                  metrics::description("Counts batches cut short by the stage's batch duration limit"),
+                                  { metrics::label_instance("execution_stage", name), },
+                                  [name, &esm = internal::execution_stage_manager::get()] {
+                                      return esm.get_stage(name)->get_stats().batch_limit_reached;
+                                  }),
            });
     undo.cancel();
 }
 
+void execution_stage::account_batch(size_t nr_executed, std::chrono::nanoseconds elapsed) noexcept {
+    auto cost = uint64_t(elapsed.count()) / nr_executed;
+    _ns_per_call_ema += cost - (_ns_per_call_ema >> cost_ema_bits);
+    auto avg = std::max<uint64_t>(_ns_per_call_ema >> cost_ema_bits, 1);
+    _batch_limit = std::max<size_t>(uint64_t(_max_batch_duration.count()) / avg, 1);
+}
+
+namespace internal {
+
+std::chrono::nanoseconds task_quota_duration() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(engine().task_quota());
+}
+
+}
+
+void execution_stage::pin_batch_to_task_quota() noexcept {
+    set_max_batch_duration(internal::task_quota_duration());
+}
+
 bool execution_stage::flush() noexcept {
     if (_empty || _flush_scheduled) {
         return false;
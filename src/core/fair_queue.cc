@@ -77,6 +77,10 @@ bool fair_queue_ticket::operator==(const fair_queue_ticket& o) const noexcept {
     return _weight == o._weight && _size == o._size;
 }
 
+fair_queue_ticket fair_queue_ticket::halved() const noexcept {
+    return fair_queue_ticket(_weight - _weight / 2, _size - _size / 2);
+}
+
 std::ostream& operator<<(std::ostream& os, fair_queue_ticket t) {
     return os << t._weight << ":" << t._size;
 }
@@ -108,7 +112,7 @@ std::ostream& operator<<(std::ostream& os, fair_group_rover r) {
 fair_group::fair_group(config cfg) noexcept
         : _capacity_tail(fair_group_rover(0, 0))
         , _capacity_head(fair_group_rover(cfg.max_req_count, cfg.max_bytes_count))
-        , _maximum_capacity(cfg.max_req_count, cfg.max_bytes_count)
+        , _maximum_capacity(fair_queue_ticket(cfg.max_req_count, cfg.max_bytes_count))
 {
     assert(!_capacity_tail.load(std::memory_order_relaxed)
                 .maybe_ahead_of(_capacity_head.load(std::memory_order_relaxed)));
@@ -121,6 +125,43 @@ fair_group_rover fair_group::grab_capacity(fair_queue_ticket cap) noexcept {
     return cur;
 }
 
+bool fair_group::try_grab_capacity(fair_queue_ticket cap) noexcept {
+    fair_group_rover cur = _capacity_tail.load(std::memory_order_relaxed);
+    do {
+        if ((cur + cap).maybe_ahead_of(head())) {
+            return false;
+        }
+    } while (!_capacity_tail.compare_exchange_weak(cur, cur + cap));
+    return true;
+}
+
+bool fair_group::try_lend_capacity(fair_queue_ticket cap) noexcept {
+    fair_queue_ticket reserve = maximum_capacity().halved();
+    fair_group_rover cur = _capacity_tail.load(std::memory_order_relaxed);
+    do {
+        if ((cur + cap + reserve).maybe_ahead_of(head())) {
+            return false;
+        }
+    } while (!_capacity_tail.compare_exchange_weak(cur, cur + cap));
+    return true;
+}
+
+void fair_group::update_capacity(fair_queue_ticket new_cap) noexcept {
+    fair_queue_ticket old_cap = _maximum_capacity.exchange(new_cap, std::memory_order_relaxed);
+    fair_group_rover new_r = fair_group_rover(0, 0) + new_cap;
+    fair_group_rover old_r = fair_group_rover(0, 0) + old_cap;
+    fair_queue_ticket inc = new_r.maybe_ahead_of(old_r);
+    fair_queue_ticket dec = old_r.maybe_ahead_of(new_r);
+    if (inc) {
+        release_capacity(inc);
+    }
+    if (dec) {
+        // Withdrawing may temporarily leave the tail ahead of the head;
+        // in-flight requests releasing their capacity will catch it up.
+        grab_capacity(dec);
+    }
+}
+
 void fair_group::release_capacity(fair_queue_ticket cap) noexcept {
     fair_group_rover cur = _capacity_head.load(std::memory_order_relaxed);
     while (!_capacity_head.compare_exchange_weak(cur, cur + cap)) ;
@@ -129,7 +170,7 @@ void fair_group::release_capacity(fair_queue_ticket cap) noexcept {
 fair_queue::fair_queue(fair_group& group, config cfg)
     : _config(std::move(cfg))
     , _group(group)
-    , _base(std::chrono::steady_clock::now())
+    , _base(internal::tsc_clock::now())
 {
     seastar_logger.debug("Created fair queue, ticket pace {}:{}", cfg.ticket_weight_pace, cfg.ticket_size_pace);
 }
@@ -178,6 +219,7 @@ bool fair_queue::grab_pending_capacity(fair_queue_ticket cap) noexcept {
 
     if (cap == _pending->cap) {
         _pending.reset();
+        _group.remove_waiter();
     } else {
         /*
          * This branch is called when the fair queue decides to
@@ -200,6 +242,7 @@ bool fair_queue::grab_capacity(fair_queue_ticket cap) noexcept {
     fair_group_rover orig_tail = _group.grab_capacity(cap);
     if ((orig_tail + cap).maybe_ahead_of(_group.head())) {
         _pending.emplace(orig_tail, cap);
+        _group.add_waiter();
         return false;
     }
 
@@ -243,17 +286,60 @@ void fair_queue::queue(priority_class_ptr pc, fair_queue_entry& ent) {
     _requests_queued++;
 }
 
+void fair_queue::account_dispatched(priority_class_ptr h, fair_queue_ticket ticket) {
+    auto delta = std::chrono::duration_cast<std::chrono::microseconds>(internal::tsc_clock::now() - _base);
+    auto req_cost  = ticket.normalize(_group.maximum_capacity()) / h->_shares;
+    auto cost  = expf(1.0f/_config.tau.count() * delta.count()) * req_cost;
+    float next_accumulated = h->_accumulated + cost;
+    while (std::isinf(next_accumulated)) {
+        normalize_stats();
+        // If we have renormalized, our time base will have changed. This should happen very infrequently
+        delta = std::chrono::duration_cast<std::chrono::microseconds>(internal::tsc_clock::now() - _base);
+        cost  = expf(1.0f/_config.tau.count() * delta.count()) * req_cost;
+        next_accumulated = h->_accumulated + cost;
+    }
+    h->_accumulated = next_accumulated;
+}
+
+bool fair_queue::try_direct_dispatch(priority_class_ptr pc, fair_queue_ticket ticket) {
+    if (_requests_queued > 0 || _pending) {
+        return false;
+    }
+
+    if (!_group.try_grab_capacity(ticket)) {
+        return false;
+    }
+
+    _resources_executing += ticket;
+    _requests_executing++;
+    account_dispatched(pc, ticket);
+    return true;
+}
+
 void fair_queue::notify_requests_finished(fair_queue_ticket desc, unsigned nr) noexcept {
     _resources_executing -= desc;
     _requests_executing -= nr;
     _group.release_capacity(desc);
 }
 
+fair_queue_ticket fair_queue::pending_deficit() const noexcept {
+    if (!_pending) {
+        return fair_queue_ticket();
+    }
+
+    return (_pending->orig_tail + _pending->cap).maybe_ahead_of(_group.head());
+}
+
 void fair_queue::notify_request_cancelled(fair_queue_entry& ent) noexcept {
     _resources_queued -= ent._ticket;
     ent._ticket = fair_queue_ticket();
 }
 
+void fair_queue::merge_queued_ticket(fair_queue_entry& ent, fair_queue_ticket t) noexcept {
+    ent._ticket += t;
+    _resources_queued += t;
+}
+
 void fair_queue::dispatch_requests(std::function<void(fair_queue_entry&)> cb) {
     while (_requests_queued) {
         priority_class_ptr h;
@@ -279,18 +365,7 @@ void fair_queue::dispatch_requests(std::function<void(fair_queue_entry&)> cb) {
         _requests_executing++;
         _requests_queued--;
 
-        auto delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _base);
-        auto req_cost  = req._ticket.normalize(_group.maximum_capacity()) / h->_shares;
-        auto cost  = expf(1.0f/_config.tau.count() * delta.count()) * req_cost;
-        float next_accumulated = h->_accumulated + cost;
-        while (std::isinf(next_accumulated)) {
-            normalize_stats();
-            // If we have renormalized, our time base will have changed. This should happen very infrequently
-            delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _base);
-            cost  = expf(1.0f/_config.tau.count() * delta.count()) * req_cost;
-            next_accumulated = h->_accumulated + cost;
-        }
-        h->_accumulated = next_accumulated;
+        account_dispatched(h, req._ticket);
 
         if (!h->_queue.empty()) {
             push_priority_class(h);
@@ -22,14 +22,19 @@
 #pragma once
 
 #include <seastar/core/file.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/shared_ptr.hh>
 
 #include <deque>
 #include <atomic>
+#include <optional>
 
 namespace seastar {
 class io_queue;
 
+template <typename T>
+struct syscall_result;
+
 namespace internal {
 
 struct fs_info {
@@ -85,6 +90,16 @@ class posix_file_impl : public file_impl {
     const bool _nowait_works;
     io_queue* _io_queue;
     const open_flags _open_flags;
+    // Group commit for flush(): while an fdatasync is on the device, later
+    // flush requests accumulate in _pending_flush and are all satisfied by
+    // a single fdatasync issued when the current one completes.
+    bool _flush_in_progress = false;
+    std::optional<shared_promise<>> _pending_flush;
+
+    // fallocate() through the reactor backend when it supports asynchronous
+    // metadata operations, falling back to the thread pool otherwise. On
+    // failure the returned result is -1 and error carries the errno.
+    future<syscall_result<int>> do_fallocate(int mode, uint64_t offset, uint64_t length) noexcept;
 protected:
     int _fd;
 
@@ -136,6 +151,7 @@ public:
 private:
     void query_dma_alignment(uint32_t block_size);
     void configure_io_lengths() noexcept;
+    future<> do_flush() noexcept;
 
     /**
      * Try to read from the given position where the previous short read has
@@ -222,6 +238,12 @@ class append_challenged_posix_file_impl final : public posix_file_impl, public e
 
     const bool _sloppy_size = false;
     const uint64_t _sloppy_size_hint;
+    // Preallocate disk space this many bytes at a time ahead of the append
+    // frontier, so appending writes don't each pay for an extent operation
+    // (0 disables; see file_open_options::append_preallocation_size).
+    uint64_t _preallocation_size;
+    // End of the range whose disk space is known to be allocated.
+    uint64_t _allocated_size = 0;
     // Fulfiled when _done and I/O is complete
     promise<> _completed;
 private:
@@ -236,6 +258,7 @@ private:
     bool may_quit() const noexcept;
     void enqueue_op(op&& op);
     int truncate_sync(uint64_t len) noexcept;
+    void preallocate_sync(uint64_t end) noexcept;
     template <typename... T, typename Func>
     future<T...> enqueue(opcode type, uint64_t pos, size_t len, Func&& func) noexcept {
         try {
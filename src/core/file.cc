@@ -39,6 +39,7 @@
 #include <seastar/util/later.hh>
 #include <seastar/core/io_queue.hh>
 #include "core/file-impl.hh"
+#include "core/reactor_backend.hh"
 #include "core/syscall_result.hh"
 #include "core/thread_pool.hh"
 #include "core/uname.hh"
@@ -85,9 +86,13 @@ posix_file_impl::posix_file_impl(int fd, open_flags f, file_open_options options
 {
     query_dma_alignment(block_size);
     configure_io_lengths();
+    engine().register_storage_file(_fd);
 }
 
 posix_file_impl::~posix_file_impl() {
+    if (_fd != -1) {
+        engine().unregister_storage_file(_fd);
+    }
     if (_refcount && _refcount->fetch_add(-1, std::memory_order_relaxed) != 1) {
         return;
     }
@@ -148,6 +153,7 @@ posix_file_impl::posix_file_impl(int fd, open_flags f, std::atomic<unsigned>* re
     _disk_write_dma_alignment = disk_write_dma_alignment;
     _disk_overwrite_dma_alignment = disk_overwrite_dma_alignment;
     configure_io_lengths();
+    engine().register_storage_file(_fd);
 }
 
 future<>
@@ -155,7 +161,40 @@ posix_file_impl::flush(void) noexcept {
     if ((_open_flags & open_flags::dsync) != open_flags{}) {
         return make_ready_future<>();
     }
-    return engine().fdatasync(_fd);
+    if (!_flush_in_progress) {
+        return do_flush();
+    }
+    // An fdatasync is already on the device. It may not cover writes that
+    // completed after it was issued, so join the batch that will be
+    // covered by the single fdatasync issued when it finishes. The batch
+    // window is thus sized by the observed sync latency: the slower the
+    // device is syncing, the more requests each fdatasync absorbs.
+    engine()._io_stats.fsyncs_coalesced += 1;
+    if (!_pending_flush) {
+        _pending_flush.emplace();
+    }
+    return _pending_flush->get_shared_future();
+}
+
+future<>
+posix_file_impl::do_flush() noexcept {
+    _flush_in_progress = true;
+    return engine().fdatasync(_fd).finally([this] {
+        _flush_in_progress = false;
+        if (_pending_flush) {
+            auto pr = std::move(*_pending_flush);
+            _pending_flush.reset();
+            // Everyone in the batch called flush() before this point, so
+            // one fdatasync issued now covers all of their writes.
+            (void)do_flush().then_wrapped([pr = std::move(pr)] (future<> f) mutable {
+                if (f.failed()) {
+                    pr.set_exception(f.get_exception());
+                } else {
+                    pr.set_value();
+                }
+            });
+        }
+    });
 }
 
 future<struct stat>
@@ -173,12 +212,22 @@ posix_file_impl::truncate(uint64_t length) noexcept {
     });
 }
 
+future<syscall_result<int>>
+posix_file_impl::do_fallocate(int mode, uint64_t offset, uint64_t length) noexcept {
+    auto& r = engine();
+    if (r._backend->supports_async_metadata()) {
+        return r._backend->submit_fallocate(_fd, mode, offset, length).then([] (ssize_t ret) {
+            return syscall_result<int>(ret < 0 ? -1 : 0, ret < 0 ? static_cast<int>(-ret) : 0);
+        });
+    }
+    return r._thread_pool->submit<syscall_result<int>>([fd = _fd, mode, offset, length] {
+        return wrap_syscall<int>(::fallocate(fd, mode, offset, length));
+    });
+}
+
 future<>
 posix_file_impl::discard(uint64_t offset, uint64_t length) noexcept {
-    return engine()._thread_pool->submit<syscall_result<int>>([this, offset, length] () mutable {
-        return wrap_syscall<int>(::fallocate(_fd, FALLOC_FL_PUNCH_HOLE|FALLOC_FL_KEEP_SIZE,
-            offset, length));
-    }).then([] (syscall_result<int> sr) {
+    return do_fallocate(FALLOC_FL_PUNCH_HOLE|FALLOC_FL_KEEP_SIZE, offset, length).then([] (syscall_result<int> sr) {
         sr.throw_if_error();
         return make_ready_future<>();
     });
@@ -192,14 +241,11 @@ posix_file_impl::allocate(uint64_t position, uint64_t length) noexcept {
     if (!supported) {
         return make_ready_future<>();
     }
-    return engine()._thread_pool->submit<syscall_result<int>>([this, position, length] () mutable {
-        auto ret = ::fallocate(_fd, FALLOC_FL_ZERO_RANGE|FALLOC_FL_KEEP_SIZE, position, length);
-        if (ret == -1 && errno == EOPNOTSUPP) {
-            ret = 0;
+    return do_fallocate(FALLOC_FL_ZERO_RANGE|FALLOC_FL_KEEP_SIZE, position, length).then([] (syscall_result<int> sr) {
+        if (sr.result == -1 && sr.error == EOPNOTSUPP) {
             supported = false; // Racy, but harmless.  At most we issue an extra call or two.
+            return make_ready_future<>();
         }
-        return wrap_syscall<int>(ret);
-    }).then([] (syscall_result<int> sr) {
         sr.throw_if_error();
         return make_ready_future<>();
     });
@@ -468,7 +514,7 @@ posix_file_impl::read_maybe_eof(uint64_t pos, size_t len, const io_priority_clas
     // We have to allocate a new aligned buffer to make sure we don't get
     // an EINVAL error due to unaligned destination buffer.
     //
-    temporary_buffer<uint8_t> buf = temporary_buffer<uint8_t>::aligned(
+    temporary_buffer<uint8_t> buf = temporary_buffer<uint8_t>::aligned_pooled(
                _memory_dma_alignment, align_up(len, size_t(_disk_read_dma_alignment)));
 
     // try to read a single bulk from the given position
@@ -561,10 +607,11 @@ append_challenged_posix_file_impl::append_challenged_posix_file_impl(int fd, ope
         , _fsync_is_exclusive(fsi.fsync_is_exclusive)
         , _sloppy_size(options.sloppy_size)
         , _sloppy_size_hint(align_up<uint64_t>(options.sloppy_size_hint, _disk_write_dma_alignment))
+        , _preallocation_size(align_up<uint64_t>(options.append_preallocation_size, _disk_write_dma_alignment))
 {
     auto r = ::lseek(fd, 0, SEEK_END);
     throw_system_error_on(r == -1);
-    _committed_size = _logical_size = r;
+    _allocated_size = _committed_size = _logical_size = r;
 }
 
 append_challenged_posix_file_impl::~append_challenged_posix_file_impl() {
@@ -619,10 +666,29 @@ int append_challenged_posix_file_impl::truncate_sync(uint64_t length) noexcept {
     int r = ::ftruncate(_fd, length);
     if (r != -1) {
         _committed_size = length;
+        // Shrinking releases the blocks past the new size, preallocated
+        // ones included.
+        _allocated_size = std::min(_allocated_size, length);
     }
     return r;
 }
 
+// Allocates disk space up to align_up(end, _preallocation_size), without
+// changing the file size, so the appending writes about to be dispatched
+// find their extents in place. Runs in the reactor thread for the same
+// reason truncate_sync() does, and only once per preallocation chunk.
+void append_challenged_posix_file_impl::preallocate_sync(uint64_t end) noexcept {
+    end = align_up(end, _preallocation_size);
+    int r = ::fallocate(_fd, FALLOC_FL_KEEP_SIZE, _allocated_size, end - _allocated_size);
+    if (r != -1) {
+        _allocated_size = end;
+    } else if (errno == EOPNOTSUPP) {
+        // The filesystem cannot preallocate; stop trying.
+        _preallocation_size = 0;
+    }
+    // Other errors (e.g. ENOSPC) are left for the writes themselves to report.
+}
+
 // If we have a bunch of size-extending writes in the queue,
 // issue an ftruncate() extending the file size, so they can
 // be issued concurrently.
@@ -646,6 +712,9 @@ append_challenged_posix_file_impl::optimize_queue() noexcept {
             ++n_appending_writes;
         }
     }
+    if (_preallocation_size && speculative_size > _allocated_size) {
+        preallocate_sync(speculative_size);
+    }
     if (n_appending_writes > _max_size_changing_ops
             || (n_appending_writes && _sloppy_size)) {
         if (_sloppy_size) {
@@ -831,6 +900,7 @@ append_challenged_posix_file_impl::truncate(uint64_t length) noexcept {
         [this, length] () mutable {
             return posix_file_impl::truncate(length).then([this, length] () mutable {
                 _committed_size = _logical_size = length;
+                _allocated_size = std::min(_allocated_size, length);
             });
         }
     );
@@ -850,6 +920,15 @@ append_challenged_posix_file_impl::close() noexcept {
         if (_logical_size != _committed_size) {
             truncate_sync(_logical_size);
         }
+        if (_allocated_size > _logical_size) {
+            // Return the unused preallocated tail; being past eof, it would
+            // otherwise stay with the file indefinitely.
+            auto hole = align_up<uint64_t>(_logical_size, _disk_write_dma_alignment);
+            if (hole < _allocated_size) {
+                ::fallocate(_fd, FALLOC_FL_PUNCH_HOLE|FALLOC_FL_KEEP_SIZE, hole, _allocated_size - hole);
+            }
+            _allocated_size = _logical_size;
+        }
         return posix_file_impl::close().finally([this] { _closing_state = state::closed; });
     });
 }
@@ -1013,6 +1092,79 @@ file::dma_read_bulk_impl(uint64_t offset, size_t range_size, const io_priority_c
   }
 }
 
+future<std::vector<temporary_buffer<uint8_t>>>
+file::dma_read_bulk_vectored_impl(std::vector<extent> extents, const io_priority_class& pc, io_intent* intent) noexcept {
+  try {
+    using ret_type = std::vector<temporary_buffer<uint8_t>>;
+    if (extents.empty()) {
+        return make_ready_future<ret_type>(ret_type());
+    }
+    // Extents whose disk-alignment-rounded ranges touch are folded into one
+    // cluster, read with a single operation; the per-extent buffers are then
+    // sliced out of the cluster buffer without copying.
+    struct cluster {
+        uint64_t begin;
+        uint64_t end;
+        uint64_t aligned_end;
+        temporary_buffer<uint8_t> buf;
+    };
+    struct state {
+        std::vector<extent> extents;
+        std::vector<cluster> clusters;
+        std::vector<size_t> cluster_of;
+    };
+    auto st = std::make_unique<state>();
+    st->extents = std::move(extents);
+    st->cluster_of.resize(st->extents.size());
+    auto alignment = uint64_t(disk_read_dma_alignment());
+    std::vector<size_t> order(st->extents.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&st] (size_t a, size_t b) {
+        return st->extents[a].offset < st->extents[b].offset;
+    });
+    for (auto i : order) {
+        auto& e = st->extents[i];
+        auto aligned_begin = align_down(e.offset, alignment);
+        auto aligned_end = align_up(e.offset + e.length, alignment);
+        if (!st->clusters.empty() && aligned_begin <= st->clusters.back().aligned_end) {
+            auto& c = st->clusters.back();
+            c.end = std::max(c.end, e.offset + e.length);
+            c.aligned_end = std::max(c.aligned_end, aligned_end);
+        } else {
+            st->clusters.push_back(cluster{e.offset, e.offset + e.length, aligned_end, {}});
+        }
+        st->cluster_of[i] = st->clusters.size() - 1;
+    }
+    auto& s = *st;
+    // All the reads are issued before the first suspension point, so the
+    // whole set reaches the I/O queue within one reactor poll.
+    return parallel_for_each(s.clusters, [this, &s, pc, intent] (cluster& c) {
+        return dma_read_bulk_impl(c.begin, c.end - c.begin, pc, intent).then([&c] (temporary_buffer<uint8_t> buf) {
+            c.buf = std::move(buf);
+        });
+    }).then([&s] {
+        ret_type ret;
+        ret.reserve(s.extents.size());
+        for (size_t i = 0; i < s.extents.size(); i++) {
+            auto& e = s.extents[i];
+            auto& c = s.clusters[s.cluster_of[i]];
+            auto rel = e.offset - c.begin;
+            if (rel >= c.buf.size()) {
+                // the file ended before this extent
+                ret.push_back(temporary_buffer<uint8_t>());
+            } else {
+                ret.push_back(c.buf.share(rel, std::min<size_t>(e.length, c.buf.size() - rel)));
+            }
+        }
+        return ret;
+    }).finally([st = std::move(st)] {});
+  } catch (...) {
+    return current_exception_as_future<std::vector<temporary_buffer<uint8_t>>>();
+  }
+}
+
 future<> file::discard(uint64_t offset, uint64_t length) noexcept {
   try {
     return _file_impl->discard(offset, length);
@@ -71,8 +71,17 @@ class file_data_source_impl : public data_source_impl {
     size_t _current_buffer_size;
     bool _in_slow_start = false;
     io_intent _intent;
+    unsigned _nonblocked_gets = 0;
     using unused_ratio_target = std::ratio<25, 100>;
+    // Number of consecutive get() calls that found their buffer already
+    // completed before we conclude that the read-ahead window is larger
+    // than needed to hide the device latency and shrink it by one.
+    static constexpr unsigned read_ahead_shrink_threshold = 16;
 private:
+    file_input_stream_stats* stats() const {
+        return _options.per_stream_stats.get();
+    }
+
     size_t minimal_buffer_size() const {
         return std::min(std::max(_options.buffer_size / 4, size_t(8192)), _options.buffer_size);
     }
@@ -87,6 +96,26 @@ private:
                 auto& h = *_options.dynamic_adjustments;
                 h.read_ahead = std::max(h.read_ahead, _current_read_ahead);
             }
+            if (auto* s = stats()) {
+                s->read_ahead_grown++;
+            }
+        }
+    }
+
+    void try_decrease_read_ahead() {
+        // The inverse feedback of try_increase_read_ahead(): if reads keep
+        // completing before the consumer comes back for them, they finish
+        // faster than they are consumed and a smaller window would hide
+        // the latency just as well, while wasting less bandwidth and
+        // memory if the stream turns out to be short or gets skipped.
+        if (++_nonblocked_gets < read_ahead_shrink_threshold
+                || _current_read_ahead <= unsigned(!!_options.read_ahead)) {
+            return;
+        }
+        _nonblocked_gets = 0;
+        _current_read_ahead--;
+        if (auto* s = stats()) {
+            s->read_ahead_shrunk++;
         }
     }
     unsigned get_initial_read_ahead() const {
@@ -192,8 +221,13 @@ public:
         assert(_reads_in_progress == 0);
     }
     virtual future<temporary_buffer<char>> get() override {
-        if (!_read_buffers.empty() && !_read_buffers.front()._ready.available()) {
-            try_increase_read_ahead();
+        if (!_read_buffers.empty()) {
+            if (!_read_buffers.front()._ready.available()) {
+                _nonblocked_gets = 0;
+                try_increase_read_ahead();
+            } else {
+                try_decrease_read_ahead();
+            }
         }
         issue_read_aheads(1);
         auto ret = std::move(_read_buffers.front());
@@ -201,9 +235,15 @@ public:
         update_history_consumed(ret._size);
         _reactor._io_stats.fstream_reads += 1;
         _reactor._io_stats.fstream_read_bytes += ret._size;
+        if (auto* s = stats()) {
+            s->bytes_consumed += ret._size;
+        }
         if (!ret._ready.available()) {
             _reactor._io_stats.fstream_reads_blocked += 1;
             _reactor._io_stats.fstream_read_bytes_blocked += ret._size;
+            if (auto* s = stats()) {
+                s->reads_blocked += 1;
+            }
         }
         return std::move(ret._ready);
     }
@@ -231,6 +271,10 @@ public:
                 dropped += front._size;
                 _reactor._io_stats.fstream_read_aheads_discarded += 1;
                 _reactor._io_stats.fstream_read_ahead_discarded_bytes += front._size;
+                if (auto* s = stats()) {
+                    s->reads_discarded += 1;
+                    s->bytes_discarded += front._size;
+                }
                 _read_buffers.pop_front();
             }
         }
@@ -248,6 +292,10 @@ public:
             for (auto&& c : _read_buffers) {
                 _reactor._io_stats.fstream_read_aheads_discarded += 1;
                 _reactor._io_stats.fstream_read_ahead_discarded_bytes += c._size;
+                if (auto* s = stats()) {
+                    s->reads_discarded += 1;
+                    s->bytes_discarded += c._size;
+                }
                 dropped += c._size;
                 ignore_read_future(std::move(c._ready));
             }
@@ -271,6 +319,9 @@ private:
                 continue;
             }
             ++_reads_in_progress;
+            if (auto* s = stats()) {
+                s->reads_issued += 1;
+            }
             // if _pos is not dma-aligned, we'll get a short read.  Account for that.
             // Also avoid reading beyond _remain.
             uint64_t align = _file.disk_read_dma_alignment();
@@ -336,12 +387,67 @@ input_stream<char> make_file_input_stream(
 
 
 class file_data_sink_impl : public data_sink_impl {
+    reactor& _reactor = engine();
     file _file;
     file_output_stream_options _options;
     uint64_t _pos = 0;
-    semaphore _write_behind_sem = { _options.write_behind };
+    unsigned _current_write_behind = _options.adaptive_write_behind ? 1 : _options.write_behind;
+    semaphore _write_behind_sem = { _current_write_behind };
     future<> _background_writes_done = make_ready_future<>();
     bool _failed = false;
+    // Adaptive write-behind feedback (see put()).
+    std::chrono::steady_clock::duration _write_latency_ema = {};
+    std::chrono::steady_clock::duration _fastest_write = std::chrono::steady_clock::duration::max();
+    unsigned _nonblocked_puts = 0;
+    // Number of consecutive put() calls that found the pipeline fully
+    // drained before we conclude the depth is larger than needed to keep
+    // the device busy and shrink it by one.
+    static constexpr unsigned write_behind_shrink_threshold = 16;
+    // Stop growing, and start backing off, once writes take this many
+    // times longer than the fastest write this stream has seen: past that
+    // point extra depth mostly adds queueing delay, for this stream and
+    // for everything else sharing the io queue, while the throughput gain
+    // is marginal.
+    static constexpr unsigned write_behind_latency_backoff = 4;
+private:
+    bool write_latency_acceptable() const {
+        return _write_latency_ema < _fastest_write * write_behind_latency_backoff;
+    }
+
+    void try_increase_write_behind() {
+        // The producer is about to block: the pipeline is full at the
+        // current depth, so a deeper one may keep the device busier —
+        // unless latency says the device is already saturated.
+        _nonblocked_puts = 0;
+        if (_current_write_behind < _options.write_behind && write_latency_acceptable()) {
+            _current_write_behind++;
+            _write_behind_sem.signal();
+            _reactor._io_stats.fstream_write_behind_grown += 1;
+        } else if (!write_latency_acceptable()) {
+            try_decrease_write_behind();
+        }
+    }
+
+    void try_decrease_write_behind() {
+        if (_current_write_behind <= 1) {
+            return;
+        }
+        _current_write_behind--;
+        // Takes effect as in-flight writes complete; the deficit is paid
+        // off before new writes can claim the unit.
+        _write_behind_sem.consume(1);
+        _reactor._io_stats.fstream_write_behind_shrunk += 1;
+    }
+
+    void account_write(std::chrono::steady_clock::duration latency, size_t bytes) {
+        _reactor._io_stats.fstream_writes += 1;
+        _reactor._io_stats.fstream_write_bytes += bytes;
+        if (!_options.adaptive_write_behind) {
+            return;
+        }
+        _fastest_write = std::min(_fastest_write, latency);
+        _write_latency_ema += (latency - _write_latency_ema) / 8;
+    }
 public:
     file_data_sink_impl(file f, file_output_stream_options options)
             : _file(std::move(f)), _options(options) {
@@ -349,14 +455,48 @@ public:
     }
     future<> put(net::packet data) override { abort(); }
     virtual temporary_buffer<char> allocate_buffer(size_t size) override {
-        return temporary_buffer<char>::aligned(_file.memory_dma_alignment(), size);
+        return temporary_buffer<char>::aligned_pooled(_file.memory_dma_alignment(), size);
     }
     using data_sink_impl::put;
+    virtual future<> put(std::vector<temporary_buffer<char>> data) override {
+        if (data.size() == 1) {
+            return put(std::move(data.front()));
+        }
+        // dma writes need aligned memory, which the caller-owned buffers
+        // of a vectored stream don't provide, so coalesce the batch into
+        // one aligned buffer and issue a single write.
+        size_t len = 0;
+        for (auto& buf : data) {
+            len += buf.size();
+        }
+        auto out = allocate_buffer(len);
+        auto p = out.get_write();
+        for (auto& buf : data) {
+            p = std::copy_n(buf.get(), buf.size(), p);
+        }
+        return put(std::move(out));
+    }
     virtual future<> put(temporary_buffer<char> buf) override {
         uint64_t pos = _pos;
         _pos += buf.size();
         if (!_options.write_behind) {
-            return do_put(pos, std::move(buf));
+            auto start = std::chrono::steady_clock::now();
+            auto bytes = buf.size();
+            return do_put(pos, std::move(buf)).finally([this, start, bytes] {
+                account_write(std::chrono::steady_clock::now() - start, bytes);
+            });
+        }
+        if (_options.adaptive_write_behind) {
+            if (_write_behind_sem.available_units() <= 0) {
+                try_increase_write_behind();
+            } else if (unsigned(_write_behind_sem.available_units()) == _current_write_behind
+                    && ++_nonblocked_puts >= write_behind_shrink_threshold) {
+                // Writes keep completing before the producer comes back
+                // with the next buffer; a shallower pipeline hides the
+                // latency just as well.
+                _nonblocked_puts = 0;
+                try_decrease_write_behind();
+            }
         }
         // Write behind strategy:
         //
@@ -370,7 +510,10 @@ public:
                 _background_writes_done = make_ready_future<>();
                 return ret;
             }
-            auto this_write_done = do_put(pos, std::move(buf)).finally([this] {
+            auto start = std::chrono::steady_clock::now();
+            auto bytes = buf.size();
+            auto this_write_done = do_put(pos, std::move(buf)).finally([this, start, bytes] {
+                account_write(std::chrono::steady_clock::now() - start, bytes);
                 _write_behind_sem.signal();
             });
             _background_writes_done = when_all(std::move(_background_writes_done), std::move(this_write_done))
@@ -438,10 +581,14 @@ public:
     future<> wait() noexcept {
         // restore to pristine state; for flush() + close() sequence
         // (we allow either flush, or close, or both)
-        return _write_behind_sem.wait(_options.write_behind).then([this] {
+        //
+        // put() doesn't run concurrently with us, so the depth cannot
+        // change while we hold the units.
+        auto depth = _current_write_behind;
+        return _write_behind_sem.wait(depth).then([this] {
             return std::exchange(_background_writes_done, make_ready_future<>());
-        }).finally([this] {
-            _write_behind_sem.signal(_options.write_behind);
+        }).finally([this, depth] {
+            _write_behind_sem.signal(depth);
         });
     }
 public:
@@ -477,7 +624,7 @@ output_stream<char> make_file_output_stream(file f, file_output_stream_options o
 // Don't generate a deprecation warning for the unsafe functions calling each other.
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-    return output_stream<char>(api_v2::make_file_data_sink(std::move(f), options), options.buffer_size, true);
+    return output_stream<char>(api_v2::make_file_data_sink(std::move(f), options), options.buffer_size, true, false, options.vectored_writes);
 #pragma GCC diagnostic pop
 }
 
@@ -511,8 +658,8 @@ future<output_stream<char>> make_file_output_stream(file f, size_t buffer_size)
 }
 
 future<output_stream<char>> make_file_output_stream(file f, file_output_stream_options options) noexcept {
-    return api_v3::and_newer::make_file_data_sink(std::move(f), options).then([buffer_size = options.buffer_size] (data_sink&& ds) {
-        return output_stream<char>(std::move(ds), buffer_size, true);
+    return api_v3::and_newer::make_file_data_sink(std::move(f), options).then([buffer_size = options.buffer_size, vectored = options.vectored_writes] (data_sink&& ds) {
+        return output_stream<char>(std::move(ds), buffer_size, true, false, vectored);
     });
 }
 
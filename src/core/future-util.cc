@@ -46,21 +46,30 @@ void parallel_for_each_state::wait_for_one() noexcept {
     // futures are likely to complete earlier than the back futures.
     // If that's indeed the case, then the front futures will be
     // available and we won't have to wait for them.
-
-    // Skip over futures that happen to be complete already.
-    while (!_incomplete.empty() && _incomplete.back().available()) {
-        if (_incomplete.back().failed()) {
-            _ex = _incomplete.back().get_exception();
+    while (true) {
+        // Skip over futures that happen to be complete already.
+        while (!_incomplete.empty() && _incomplete.back().available()) {
+            if (_incomplete.back().failed()) {
+                _ex = _incomplete.back().get_exception();
+            }
+            _incomplete.pop_back();
         }
-        _incomplete.pop_back();
-    }
 
-    // If there's an incompelete future, wait for it.
-    if (!_incomplete.empty()) {
-        internal::set_callback(_incomplete.back(), static_cast<continuation_base<>*>(this));
-        // This future's state will be collected in run_and_dispose(), so we can drop it.
-        _incomplete.pop_back();
-        return;
+        // Let a windowed subclass top the window back up.
+        refill();
+
+        // If there's an incompelete future, wait for it.
+        if (!_incomplete.empty()) {
+            if (_incomplete.back().available()) {
+                // refill() added an already-failed future; reap it too.
+                continue;
+            }
+            internal::set_callback(_incomplete.back(), static_cast<continuation_base<>*>(this));
+            // This future's state will be collected in run_and_dispose(), so we can drop it.
+            _incomplete.pop_back();
+            return;
+        }
+        break;
     }
 
     // Everything completed, report a result.
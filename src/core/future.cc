@@ -53,6 +53,8 @@ namespace internal {
 
 static_assert(std::is_empty<uninitialized_wrapper<std::tuple<>>>::value, "This should still be empty");
 
+thread_local uint64_t ready_continuations_deferred = 0;
+
 void promise_base::move_it(promise_base&& x) noexcept {
     // Don't use std::exchange to make sure x's values are nulled even
     // if &x == this.
@@ -0,0 +1,139 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <seastar/core/internal/hugepage_text.hh>
+#include <seastar/core/align.hh>
+#include <seastar/util/log.hh>
+#include <seastar/util/read_first_line.hh>
+
+#include <cstring>
+#include <vector>
+
+#include <link.h>
+#include <sys/mman.h>
+
+namespace seastar {
+
+extern logger seastar_logger;
+
+namespace internal {
+
+static size_t remapped_bytes = 0;
+
+static constexpr uintptr_t huge_page_size = 2 << 20;
+
+static bool transparent_hugepages_enabled() {
+    try {
+        // The active mode is bracketed, e.g. "always [madvise] never"
+        auto line = read_first_line("/sys/kernel/mm/transparent_hugepage/enabled");
+        return line.find("[always]") != sstring::npos || line.find("[madvise]") != sstring::npos;
+    } catch (...) {
+        return false;
+    }
+}
+
+struct text_segment {
+    uintptr_t begin;
+    uintptr_t end;
+};
+
+static int collect_text_segments(dl_phdr_info* info, size_t, void* data) {
+    auto& segments = *static_cast<std::vector<text_segment>*>(data);
+    for (unsigned i = 0; i < info->dlpi_phnum; i++) {
+        const auto& ph = info->dlpi_phdr[i];
+        if (ph.p_type == PT_LOAD && (ph.p_flags & PF_X)) {
+            auto begin = uintptr_t(info->dlpi_addr) + ph.p_vaddr;
+            segments.push_back(text_segment{begin, begin + ph.p_memsz});
+        }
+    }
+    // The main executable is visited first (with an empty name); shared
+    // libraries are left alone, their text is small and shared anyway.
+    return 1;
+}
+
+// Replaces [begin, end), rounded inwards to hugepage boundaries, with an
+// anonymous hugepage-backed mapping holding the same bytes. The swap itself
+// is a single mremap(), so execution continues seamlessly on the new pages
+// even though this very function lives in the range being replaced.
+static size_t remap_segment(uintptr_t begin, uintptr_t end) {
+    begin = align_up(begin, huge_page_size);
+    end = align_down(end, huge_page_size);
+    if (begin >= end) {
+        return 0;
+    }
+    auto len = end - begin;
+    // Over-allocate so we can carve out a hugepage-aligned scratch area
+    auto mmap_ret = ::mmap(nullptr, len + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mmap_ret == MAP_FAILED) {
+        return 0;
+    }
+    auto raw = uintptr_t(mmap_ret);
+    auto scratch = align_up(raw, huge_page_size);
+    if (scratch != raw) {
+        ::munmap(reinterpret_cast<void*>(raw), scratch - raw);
+    }
+    auto tail = raw + len + huge_page_size - (scratch + len);
+    if (tail) {
+        ::munmap(reinterpret_cast<void*>(scratch + len), tail);
+    }
+    if (::madvise(reinterpret_cast<void*>(scratch), len, MADV_HUGEPAGE) != 0) {
+        ::munmap(reinterpret_cast<void*>(scratch), len);
+        return 0;
+    }
+    // Copying the text in populates the hugepages
+    std::memcpy(reinterpret_cast<void*>(scratch), reinterpret_cast<void*>(begin), len);
+    if (::mprotect(reinterpret_cast<void*>(scratch), len, PROT_READ | PROT_EXEC) != 0) {
+        ::munmap(reinterpret_cast<void*>(scratch), len);
+        return 0;
+    }
+    if (::mremap(reinterpret_cast<void*>(scratch), len, len, MREMAP_MAYMOVE | MREMAP_FIXED, reinterpret_cast<void*>(begin)) == MAP_FAILED) {
+        ::munmap(reinterpret_cast<void*>(scratch), len);
+        return 0;
+    }
+    return len;
+}
+
+size_t remap_text_to_hugepages() noexcept {
+    try {
+        if (!transparent_hugepages_enabled()) {
+            seastar_logger.info("not remapping text to hugepages: transparent hugepages are disabled");
+            return 0;
+        }
+        std::vector<text_segment> segments;
+        ::dl_iterate_phdr(collect_text_segments, &segments);
+        size_t total = 0;
+        for (auto& s : segments) {
+            total += remap_segment(s.begin, s.end);
+        }
+        remapped_bytes = total;
+        seastar_logger.info("remapped {} bytes of text to transparent hugepages", total);
+        return total;
+    } catch (...) {
+        return 0;
+    }
+}
+
+size_t remapped_text_bytes() noexcept {
+    return remapped_bytes;
+}
+
+}
+}
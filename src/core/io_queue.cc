@@ -54,19 +54,52 @@ class io_desc_read_write final : public io_completion {
     io_queue& _ioq;
     fair_queue_ticket _fq_ticket;
     promise<size_t> _pr;
+    internal::tracer::clock::time_point _trace_queued = {};
+    internal::tracer::clock::time_point _trace_dispatched = {};
+    uint8_t _trace_class = 0;
+    uint8_t _member = 0;
+    internal::tsc_clock::time_point _member_dispatched = {};
 private:
     void notify_requests_finished() noexcept {
         _ioq.notify_requests_finished(_fq_ticket);
     }
+    void maybe_trace_completion() noexcept {
+        if (__builtin_expect(_trace_queued != internal::tracer::clock::time_point{}, false)) {
+            engine().tracer().record_io(_trace_queued, _trace_dispatched, _trace_class);
+        }
+    }
+    void maybe_account_member() noexcept {
+        if (__builtin_expect(_member_dispatched != internal::tsc_clock::time_point{}, false)) {
+            _ioq.account_member_completion(_member, internal::tsc_clock::now() - _member_dispatched);
+        }
+    }
 public:
-    io_desc_read_write(io_queue& ioq, fair_queue_ticket ticket)
+    io_desc_read_write(io_queue& ioq, fair_queue_ticket ticket, unsigned pclass, unsigned member = 0)
         : _ioq(ioq)
         , _fq_ticket(ticket)
-    {}
+        , _member(member)
+    {
+        if (__builtin_expect(engine().tracer().enabled(), false)) {
+            _trace_queued = internal::tracer::clock::now();
+            _trace_class = pclass;
+        }
+    }
+
+    void set_dispatched() noexcept {
+        if (__builtin_expect(_trace_queued != internal::tracer::clock::time_point{}, false)) {
+            _trace_dispatched = internal::tracer::clock::now();
+        }
+        if (__builtin_expect(_ioq.nr_member_devices() > 1, false)) {
+            _member_dispatched = internal::tsc_clock::now();
+            _ioq.account_member_dispatched(_member);
+        }
+    }
 
     virtual void set_exception(std::exception_ptr eptr) noexcept override {
         io_log.trace("dev {} : req {} error", _ioq.dev_id(), fmt::ptr(this));
         notify_requests_finished();
+        maybe_trace_completion();
+        maybe_account_member();
         _pr.set_exception(eptr);
         delete this;
     }
@@ -74,6 +107,8 @@ public:
     virtual void complete(size_t res) noexcept override {
         io_log.trace("dev {} : req {} complete", _ioq.dev_id(), fmt::ptr(this));
         notify_requests_finished();
+        maybe_trace_completion();
+        maybe_account_member();
         _pr.set_value(res);
         delete this;
     }
@@ -83,16 +118,86 @@ public:
         delete this;
     }
 
+    // Complete (or fail) the promise without returning the ticket to the
+    // fair queue. Used for the parts of a merged request, whose combined
+    // ticket is returned in one go by the io_desc_merged completion.
+    void complete_part(size_t res) noexcept {
+        maybe_trace_completion();
+        maybe_account_member();
+        _pr.set_value(res);
+        delete this;
+    }
+
+    void fail_part(std::exception_ptr eptr) noexcept {
+        maybe_trace_completion();
+        maybe_account_member();
+        _pr.set_exception(std::move(eptr));
+        delete this;
+    }
+
     future<size_t> get_future() {
         return _pr.get_future();
     }
 };
 
+// The completion of several contiguous requests submitted to the disk as
+// one readv/writev. It owns the iovec array for the lifetime of the
+// operation and, when the disk answers, splits the (possibly short) result
+// over the original requests in file order.
+class io_desc_merged final : public io_completion {
+    io_queue& _ioq;
+    fair_queue_ticket _ticket; // combined over all parts
+    std::vector<std::unique_ptr<io_desc_read_write>> _parts;
+    std::vector<::iovec> _iov;
+public:
+    io_desc_merged(io_queue& ioq, fair_queue_ticket ticket, unsigned nr_parts)
+        : _ioq(ioq)
+        , _ticket(ticket)
+    {
+        _parts.reserve(nr_parts);
+        _iov.reserve(nr_parts);
+    }
+
+    void add_part(std::unique_ptr<io_desc_read_write> desc, void* addr, size_t len) {
+        _parts.push_back(std::move(desc));
+        _iov.push_back(::iovec{addr, len});
+    }
+
+    std::vector<::iovec>& iov() noexcept { return _iov; }
+
+    void set_dispatched() noexcept {
+        for (auto& p : _parts) {
+            p->set_dispatched();
+        }
+    }
+
+    virtual void complete(size_t res) noexcept override {
+        io_log.trace("dev {} : merged req {} complete", _ioq.dev_id(), fmt::ptr(this));
+        _ioq.notify_requests_finished(_ticket);
+        for (size_t i = 0; i < _parts.size(); ++i) {
+            auto part_res = std::min(res, _iov[i].iov_len);
+            res -= part_res;
+            _parts[i].release()->complete_part(part_res);
+        }
+        delete this;
+    }
+
+    virtual void set_exception(std::exception_ptr eptr) noexcept override {
+        io_log.trace("dev {} : merged req {} error", _ioq.dev_id(), fmt::ptr(this));
+        _ioq.notify_requests_finished(_ticket);
+        for (auto& p : _parts) {
+            p.release()->fail_part(eptr);
+        }
+        delete this;
+    }
+};
+
 struct priority_class_data {
     friend class io_queue;
     priority_class_ptr ptr;
     size_t bytes;
     uint64_t ops;
+    uint64_t ops_bypassed;
     uint32_t nr_queued;
     std::chrono::duration<double> queue_time;
     std::chrono::duration<double> total_queue_time;
@@ -102,9 +207,18 @@ struct priority_class_data {
     void register_stats(sstring name, sstring mountpoint);
 public:
     void account_for(size_t len, std::chrono::duration<double> lat) noexcept;
+    void account_bypassed(size_t len) noexcept;
 };
 
 class queued_io_request : private internal::io_request {
+    // A contiguous request absorbed into this one while both sat in the
+    // queue; it dispatches as part of one combined readv/writev.
+    struct merged_part {
+        internal::io_request req;
+        std::unique_ptr<io_desc_read_write> desc;
+        size_t len;
+    };
+
     io_queue& _ioq;
     priority_class_data& _pclass;
     size_t _len;
@@ -112,39 +226,98 @@ class queued_io_request : private internal::io_request {
     fair_queue_entry _fq_entry;
     internal::cancellable_queue::link _intent;
     std::unique_ptr<io_desc_read_write> _desc;
+    std::vector<merged_part> _more;
+    size_t _merged_len; // bytes covered, this request and _more together
 
     bool is_cancelled() const noexcept { return !_desc; }
 
+    void dispatch_merged() noexcept {
+        auto delta = std::chrono::duration_cast<std::chrono::duration<double>>(internal::tsc_clock::now() - _started);
+        _pclass.account_for(_len, delta);
+        for (auto& p : _more) {
+            _pclass.account_for(p.len, delta);
+        }
+        _intent.maybe_dequeue();
+        auto desc = std::make_unique<io_desc_merged>(_ioq, _fq_entry.ticket(), _more.size() + 1);
+        io_log.trace("dev {} : req {} submit merged, {} parts", _ioq.dev_id(), fmt::ptr(&*desc), _more.size() + 1);
+        desc->add_part(std::move(_desc), address(), size());
+        for (auto& p : _more) {
+            desc->add_part(std::move(p.desc), p.req.address(), p.req.size());
+        }
+        auto combined = opcode() == operation::read
+            ? io_request::make_readv(fd(), pos(), desc->iov(), nowait_works())
+            : io_request::make_writev(fd(), pos(), desc->iov(), nowait_works());
+        desc->set_dispatched();
+        _ioq.submit_merged_request(desc.release(), std::move(combined), _pclass, _more.size() + 1);
+    }
+
 public:
-    queued_io_request(internal::io_request req, io_queue& q, priority_class_data& pc, size_t l)
+    queued_io_request(internal::io_request req, io_queue& q, priority_class_data& pc, unsigned pclass_id, size_t l)
         : io_request(std::move(req))
         , _ioq(q)
         , _pclass(pc)
         , _len(l)
-        , _started(std::chrono::steady_clock::now())
+        , _started(internal::tsc_clock::now())
         , _fq_entry(_ioq.request_fq_ticket(*this, _len))
-        , _desc(std::make_unique<io_desc_read_write>(_ioq, _fq_entry.ticket()))
+        , _desc(std::make_unique<io_desc_read_write>(_ioq, _fq_entry.ticket(), pclass_id, _ioq.member_of(pos())))
+        , _merged_len(opcode() == operation::read || opcode() == operation::write ? size() : 0)
     {
         io_log.trace("dev {} : req {} queue  len {} ticket {}", _ioq.dev_id(), fmt::ptr(&*_desc), _len, _fq_entry.ticket());
     }
 
     queued_io_request(queued_io_request&&) = delete;
 
+    // Whether req may ride along with this request as a single disk
+    // operation: both must be still-queued plain reads (or plain writes)
+    // of the same priority class, to the same file, with req starting
+    // exactly where the operation built so far ends.
+    bool can_absorb(const internal::io_request& req, const priority_class_data& pc, size_t max_len) const noexcept {
+        return !is_cancelled()
+            && &_pclass == &pc
+            && _more.size() + 1 < io_queue::max_merged_parts
+            && (opcode() == operation::read || opcode() == operation::write)
+            && req.opcode() == opcode()
+            && req.fd() == fd()
+            && req.pos() == pos() + _merged_len
+            && _merged_len + req.size() <= max_len;
+    }
+
+    // Takes ownership of a request that satisfied can_absorb(). The
+    // caller has already grown this request's fair queue ticket by the
+    // absorbed request's worth.
+    future<size_t> absorb(internal::io_request req, size_t len, std::unique_ptr<io_desc_read_write> desc) {
+        auto fut = desc->get_future();
+        _merged_len += req.size();
+        _more.push_back(merged_part{std::move(req), std::move(desc), len});
+        return fut;
+    }
+
     void dispatch() noexcept {
+        _ioq.forget_merge_candidate(*this);
         if (is_cancelled()) {
             _ioq.complete_cancelled_request(*this);
             delete this;
             return;
         }
 
+        if (!_more.empty()) {
+            dispatch_merged();
+            delete this;
+            return;
+        }
+
         io_log.trace("dev {} : req {} submit", _ioq.dev_id(), fmt::ptr(&*_desc));
-        _pclass.account_for(_len, std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - _started));
+        _pclass.account_for(_len, std::chrono::duration_cast<std::chrono::duration<double>>(internal::tsc_clock::now() - _started));
         _intent.maybe_dequeue();
         _ioq.submit_request(_desc.release(), std::move(*this), _pclass);
         delete this;
     }
 
     void cancel() noexcept {
+        // Only intent-less requests are merged into, and only an intent
+        // can cancel, so a merge chain never gets here.
+        assert(_more.empty());
+        _ioq.forget_merge_candidate(*this);
         _ioq.cancel_request(*this, _pclass);
         _desc.release()->cancel();
     }
@@ -231,6 +404,86 @@ void
 io_queue::notify_requests_finished(fair_queue_ticket& desc) noexcept {
     _requests_executing--;
     _fq.notify_requests_finished(desc);
+
+    if (_config.online_calibration) {
+        account_served(desc);
+    }
+}
+
+void io_queue::account_served(fair_queue_ticket desc) noexcept {
+    _served += desc;
+    if (_requests_executing == 0) {
+        // The disk went idle, so the window no longer measures its speed
+        _served_idled = true;
+    }
+
+    auto now = internal::tsc_clock::now();
+    if (now - _window_start >= calibration_period) {
+        recalibrate(now);
+    }
+}
+
+unsigned io_queue::member_of(uint64_t pos) const noexcept {
+    if (_members.empty()) {
+        return 0;
+    }
+    // The file offset is a proxy for the array offset: with large files on
+    // a striped array the two walk the members in the same round-robin
+    // pattern, which is all the cost model needs.
+    return (pos / _config.member_stripe_size) % _members.size();
+}
+
+void io_queue::account_member_dispatched(unsigned member) noexcept {
+    auto& m = _members[member];
+    m.dispatched++;
+    m.requests_executing++;
+}
+
+void io_queue::account_member_completion(unsigned member, std::chrono::duration<double> lat) noexcept {
+    auto& m = _members[member];
+    m.requests_executing--;
+    // EMA over the last few completions; enough history to ride out a
+    // single outlier, short enough to track a member that degrades
+    m.latency_ema += (lat - m.latency_ema) / 8;
+}
+
+float io_queue::member_cost_factor(unsigned member) const noexcept {
+    auto lat = _members[member].latency_ema;
+    if (lat.count() == 0) {
+        return 1.0f;
+    }
+    auto fastest = lat;
+    for (auto& m : _members) {
+        if (m.latency_ema.count() > 0 && m.latency_ema < fastest) {
+            fastest = m.latency_ema;
+        }
+    }
+    // Clamped so that a stuck member cannot price its requests beyond the
+    // group capacity (and lock the queue up).
+    return std::min(float(lat / fastest), 4.0f);
+}
+
+void io_queue::recalibrate(std::chrono::steady_clock::time_point now) noexcept {
+    auto fq_cfg = make_fair_queue_config(_config);
+    auto predicted = _served.duration_at_pace(fq_cfg.ticket_weight_pace, fq_cfg.ticket_size_pace);
+    if (!_served_idled && predicted.count() > 0) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - _window_start);
+        // How much slower (or faster) the disk served the window than the
+        // current ticket costs predict. The correction is clamped and only
+        // a quarter of it is applied per window, so a single odd window
+        // cannot send the costs flying.
+        float ratio = std::min(std::max(float(elapsed.count()) / predicted.count(), 0.5f), 2.0f);
+        float factor = 1.0f + (ratio - 1.0f) / 4;
+        _config.disk_us_per_request *= factor;
+        _config.disk_us_per_byte *= factor;
+        _fq.update_config(make_fair_queue_config(_config));
+        io_log.debug("dev {} : recalibrated to {} us/req, {} us/byte", dev_id(),
+                _config.disk_us_per_request, _config.disk_us_per_byte);
+    }
+
+    _served = fair_queue_ticket();
+    _served_idled = _requests_executing == 0;
+    _window_start = now;
 }
 
 fair_queue::config io_queue::make_fair_queue_config(config iocfg) {
@@ -246,6 +499,10 @@ io_queue::io_queue(io_group_ptr group, internal::io_sink& sink, io_queue::config
     , _fq(_group->_fg, make_fair_queue_config(cfg))
     , _sink(sink)
     , _config(std::move(cfg)) {
+    if (_config.nr_member_devices > 1) {
+        _config.member_stripe_size = std::max<uint64_t>(_config.member_stripe_size, 1);
+        _members.resize(_config.nr_member_devices);
+    }
     seastar_logger.debug("Created io queue, multipliers {}:{}",
             cfg.disk_req_write_to_read_multiplier,
             cfg.disk_bytes_write_to_read_multiplier);
@@ -286,6 +543,73 @@ io_group::io_group(config cfg) noexcept
     seastar_logger.debug("Created io group, limits {}:{}", cfg.max_req_count, cfg.max_bytes_count);
 }
 
+void io_group::update_config(config cfg) noexcept {
+    auto fg_cfg = make_fair_group_config(cfg);
+    _fg.update_capacity(fair_queue_ticket(fg_cfg.max_req_count, fg_cfg.max_bytes_count));
+    _maximum_request_size.store(cfg.max_bytes_count, std::memory_order_relaxed);
+    seastar_logger.debug("Updated io group, limits {}:{}", cfg.max_req_count, cfg.max_bytes_count);
+}
+
+void io_group::add_sibling(std::shared_ptr<io_group> sibling) {
+    std::lock_guard<std::mutex> lock(_siblings_lock);
+    _siblings.push_back(std::make_unique<loan>(std::move(sibling)));
+    _nr_siblings.fetch_add(1, std::memory_order_relaxed);
+}
+
+void io_group::borrow_capacity(fair_queue_ticket deficit) noexcept {
+    if (_nr_siblings.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    // The loans are walked from the poll loop, so never block on the
+    // lock -- a shard that lost the race simply retries next poll.
+    std::unique_lock<std::mutex> lock(_siblings_lock, std::try_to_lock);
+    if (!lock) {
+        return;
+    }
+    for (auto& l : _siblings) {
+        auto lender = l->lender.lock();
+        if (!lender || !lender->_fg.try_lend_capacity(deficit)) {
+            continue;
+        }
+        _fg.release_capacity(deficit);
+        fair_queue_ticket cur = l->amount.load(std::memory_order_relaxed);
+        while (!l->amount.compare_exchange_weak(cur, cur + deficit)) ;
+        break;
+    }
+}
+
+void io_group::repay_loans() noexcept {
+    if (_nr_siblings.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_siblings_lock, std::try_to_lock);
+    if (!lock) {
+        return;
+    }
+    for (auto& l : _siblings) {
+        fair_queue_ticket cur = l->amount.load(std::memory_order_relaxed);
+        if (!cur) {
+            continue;
+        }
+        auto lender = l->lender.lock();
+        if (!lender || lender->_fg.waiting_queues() == 0) {
+            continue;
+        }
+        // Return half of the loan per poll. Halving decays the debt
+        // exponentially, so the lender regains its capacity quickly
+        // without the borrower losing it all at once.
+        fair_queue_ticket chunk;
+        do {
+            chunk = cur.halved();
+        } while (cur && !l->amount.compare_exchange_weak(cur, cur - chunk));
+        if (!cur) {
+            continue;
+        }
+        _fg.grab_capacity(chunk);
+        lender->_fg.release_capacity(chunk);
+    }
+}
+
 io_queue::~io_queue() {
     // It is illegal to stop the I/O queue with pending requests.
     // Technically we would use a gate to guarantee that. But here, it is not
@@ -352,6 +676,7 @@ priority_class_data::priority_class_data(sstring name, sstring mountpoint, prior
     : ptr(ptr)
     , bytes(0)
     , ops(0)
+    , ops_bypassed(0)
     , nr_queued(0)
     , queue_time(0)
     , total_queue_time(0)
@@ -387,6 +712,7 @@ priority_class_data::register_stats(sstring name, sstring mountpoint) {
     new_metrics.add_group("io_queue", {
             sm::make_derive("total_bytes", bytes, sm::description("Total bytes passed in the queue"), {io_queue_shard(shard), sm::shard_label(owner), mountlabel, class_label}),
             sm::make_derive("total_operations", ops, sm::description("Total bytes passed in the queue"), {io_queue_shard(shard), sm::shard_label(owner), mountlabel, class_label}),
+            sm::make_derive("total_bypassed_operations", ops_bypassed, sm::description("Total operations that skipped the queue (uncontended bypass)"), {io_queue_shard(shard), sm::shard_label(owner), mountlabel, class_label}),
             sm::make_derive("total_delay_sec", [this] {
                     return total_queue_time.count();
                 }, sm::description("Total time spent in the queue"), {io_queue_shard(shard), sm::shard_label(owner), mountlabel, class_label}),
@@ -417,6 +743,13 @@ void priority_class_data::account_for(size_t len, std::chrono::duration<double>
     total_queue_time += lat;
 }
 
+void priority_class_data::account_bypassed(size_t len) noexcept {
+    ops++;
+    ops_bypassed++;
+    bytes += len;
+    queue_time = std::chrono::duration<double>(0);
+}
+
 priority_class_data& io_queue::find_or_create_class(const io_priority_class& pc) {
     auto id = pc.id();
     if (id >= _priority_classes.size()) {
@@ -467,15 +800,25 @@ fair_queue_ticket io_queue::request_fq_ticket(const internal::io_request& req, s
 
     static thread_local size_t oversize_warning_threshold = 0;
 
-    if (size >= _group->_maximum_request_size) {
+    size_t max_size = _group->_maximum_request_size.load(std::memory_order_relaxed);
+    if (size >= max_size) {
         if (size > oversize_warning_threshold) {
             oversize_warning_threshold = size;
             io_log.warn("oversized request (length {}) submitted. "
                 "dazed and confuzed, trimming its weight from {} down to {}", len,
                 size >> request_ticket_size_shift,
-                _group->_maximum_request_size >> request_ticket_size_shift);
+                max_size >> request_ticket_size_shift);
         }
-        size = _group->_maximum_request_size;
+        size = max_size;
+    }
+
+    if (__builtin_expect(!_members.empty(), false)) {
+        // A request routed to a slower member occupies its device for
+        // proportionally longer, so charge it proportionally more of the
+        // bytes dimension; requests to healthy members stay cheap and
+        // keep flowing while the slow member's requests queue up.
+        float factor = member_cost_factor(member_of(req.pos()));
+        size = std::min(size_t(size * factor), max_size);
     }
 
     return fair_queue_ticket(weight, size >> request_ticket_size_shift);
@@ -483,8 +826,9 @@ fair_queue_ticket io_queue::request_fq_ticket(const internal::io_request& req, s
 
 io_queue::request_limits io_queue::get_request_limits() const noexcept {
     request_limits l;
-    l.max_read = align_down<size_t>(_group->_maximum_request_size / read_request_base_count, minimal_request_size);
-    l.max_write = align_down<size_t>(_group->_maximum_request_size / _config.disk_bytes_write_to_read_multiplier, minimal_request_size);
+    size_t max_size = _group->_maximum_request_size.load(std::memory_order_relaxed);
+    l.max_read = align_down<size_t>(max_size / read_request_base_count, minimal_request_size);
+    l.max_write = align_down<size_t>(max_size / _config.disk_bytes_write_to_read_multiplier, minimal_request_size);
     return l;
 }
 
@@ -494,7 +838,44 @@ io_queue::queue_request(const io_priority_class& pc, size_t len, internal::io_re
         // First time will hit here, and then we create the class. It is important
         // that we create the shared pointer in the same shard it will be used at later.
         auto& pclass = find_or_create_class(pc);
-        auto queued_req = std::make_unique<queued_io_request>(std::move(req), *this, pclass, len);
+        if (_config.merge_adjacent_requests && intent == nullptr && _merge_candidate != nullptr) {
+            auto limits = get_request_limits();
+            if (_merge_candidate->can_absorb(req, pclass, req.is_write() ? limits.max_write : limits.max_read)) {
+                // The request continues one that is already queued; ride
+                // along with it as a single disk operation instead of
+                // paying for a ticket slot and an iocb of its own. The
+                // candidate's queued ticket grows by this request's worth,
+                // so fairness still charges for the full amount.
+                auto ticket = request_fq_ticket(req, len);
+                auto desc = std::make_unique<io_desc_read_write>(*this, ticket, pc.id(), member_of(req.pos()));
+                io_log.trace("dev {} : req {} merge  len {} ticket {}", dev_id(), fmt::ptr(&*desc), len, ticket);
+                _fq.merge_queued_ticket(_merge_candidate->queue_entry(), ticket);
+                pclass.nr_queued++;
+                _queued_requests++;
+                return _merge_candidate->absorb(std::move(req), len, std::move(desc));
+            }
+        }
+        if (_config.uncontended_bypass && intent == nullptr) {
+            // When nothing is waiting in this queue and the disk has spare capacity,
+            // fairness has nothing to arbitrate, so the request may go straight to
+            // the sink instead of waiting for the next poll to dispatch it. Requests
+            // with an intent attached still take the queue -- once submitted they
+            // couldn't be cancelled anyway.
+            auto ticket = request_fq_ticket(req, len);
+            if (_fq.try_direct_dispatch(pclass.ptr, ticket)) {
+                auto desc = std::make_unique<io_desc_read_write>(*this, ticket, pc.id(), member_of(req.pos()));
+                auto fut = desc->get_future();
+                io_log.trace("dev {} : req {} bypass len {} ticket {}", dev_id(), fmt::ptr(&*desc), len, ticket);
+                pclass.account_bypassed(len);
+                _requests_executing++;
+                desc->set_dispatched();
+                _sink.submit(desc.release(), std::move(req));
+                return fut;
+            }
+        }
+        bool mergeable = _config.merge_adjacent_requests && intent == nullptr
+                && (req.opcode() == internal::io_request::operation::read || req.opcode() == internal::io_request::operation::write);
+        auto queued_req = std::make_unique<queued_io_request>(std::move(req), *this, pclass, pc.id(), len);
         auto fut = queued_req->get_future();
         internal::cancellable_queue* cq = nullptr;
         if (intent != nullptr) {
@@ -503,6 +884,9 @@ io_queue::queue_request(const io_priority_class& pc, size_t len, internal::io_re
 
         _fq.queue(pclass.ptr, queued_req->queue_entry());
         queued_req->set_intent(cq);
+        if (mergeable) {
+            _merge_candidate = queued_req.get();
+        }
         queued_req.release();
         pclass.nr_queued++;
         _queued_requests++;
@@ -514,15 +898,42 @@ void io_queue::poll_io_queue() {
     _fq.dispatch_requests([] (fair_queue_entry& fqe) {
         queued_io_request::from_fq_entry(fqe).dispatch();
     });
+
+    // If dispatching stalled on the group capacity, see if a sibling
+    // group has some to spare; otherwise start giving back whatever
+    // was borrowed if the lenders want it.
+    fair_queue_ticket deficit = _fq.pending_deficit();
+    if (deficit) {
+        _group->borrow_capacity(deficit);
+    } else {
+        _group->repay_loans();
+    }
 }
 
 void io_queue::submit_request(io_desc_read_write* desc, internal::io_request req, priority_class_data& pclass) noexcept {
     _queued_requests--;
     _requests_executing++;
     pclass.nr_queued--;
+    desc->set_dispatched();
+    _sink.submit(desc, std::move(req));
+}
+
+void io_queue::submit_merged_request(io_completion* desc, internal::io_request req, priority_class_data& pclass, unsigned nr_parts) noexcept {
+    _queued_requests -= nr_parts;
+    // One combined operation goes to disk, and its completion returns the
+    // combined ticket in one go, so the chain counts as a single request
+    // in flight.
+    _requests_executing++;
+    pclass.nr_queued -= nr_parts;
     _sink.submit(desc, std::move(req));
 }
 
+void io_queue::forget_merge_candidate(queued_io_request& req) noexcept {
+    if (_merge_candidate == &req) {
+        _merge_candidate = nullptr;
+    }
+}
+
 void io_queue::cancel_request(queued_io_request& req, priority_class_data& pclass) noexcept {
     _queued_requests--;
     pclass.nr_queued--;
@@ -541,6 +952,18 @@ io_queue::update_shares_for_class(const io_priority_class pc, size_t new_shares)
     });
 }
 
+future<>
+io_queue::update_config(config cfg) {
+    return futurize_invoke([this, cfg = std::move(cfg)] () mutable {
+        cfg.devid = _config.devid;
+        // the backing topology cannot change at runtime
+        cfg.nr_member_devices = _config.nr_member_devices;
+        cfg.member_stripe_size = _config.member_stripe_size;
+        _config = std::move(cfg);
+        _fq.update_config(make_fair_queue_config(_config));
+    });
+}
+
 void
 io_queue::rename_priority_class(io_priority_class pc, sstring new_name) {
     if (_priority_classes.size() > pc.id() &&
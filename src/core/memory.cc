@@ -54,6 +54,7 @@
 
 #include <seastar/core/cacheline.hh>
 #include <seastar/core/memory.hh>
+#include <seastar/core/scheduling.hh>
 #include <seastar/core/print.hh>
 #include <seastar/util/alloc_failure_injector.hh>
 #include <seastar/util/memory_diagnostics.hh>
@@ -62,6 +63,7 @@
 #include <seastar/core/aligned_buffer.hh>
 #include <unordered_set>
 #include <iostream>
+#include <sstream>
 #include <thread>
 
 #include <dlfcn.h>
@@ -119,6 +121,7 @@ __thread int critical_alloc_section = 0;
 #include <seastar/core/posix.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <new>
+#include <chrono>
 #include <cstdint>
 #include <algorithm>
 #include <limits>
@@ -130,6 +133,7 @@ __thread int critical_alloc_section = 0;
 #include <cstring>
 #include <boost/intrusive/list.hpp>
 #include <sys/mman.h>
+#include <sys/vfs.h>
 #include <seastar/util/defer.hh>
 #include <seastar/util/backtrace.hh>
 
@@ -201,7 +205,7 @@ static thread_local bool is_reactor_thread = false;
 
 namespace alloc_stats {
 
-enum class types { allocs, frees, cross_cpu_frees, reclaims, large_allocs, foreign_mallocs, foreign_frees, foreign_cross_frees, enum_size };
+enum class types { allocs, frees, cross_cpu_frees, reclaims, large_allocs, foreign_mallocs, foreign_frees, foreign_cross_frees, soft_limit_hits, bytes_returned_to_os, enum_size };
 
 using stats_array = std::array<uint64_t, static_cast<std::size_t>(types::enum_size)>;
 using stats_atomic_array = std::array<std::atomic_uint64_t, static_cast<std::size_t>(types::enum_size)>;
@@ -237,6 +241,165 @@ static uint64_t get(types stat_type)
 
 }
 
+// Per-scheduling-group memory accounting.
+//
+// Live bytes are attributed to the scheduling group that is current when
+// the allocation or the free is performed. An object allocated under one
+// group and freed under another (including objects drained from the
+// cross-cpu free list) is therefore counted as a transfer between the two
+// groups. This keeps the hot paths down to a pair of thread-local updates
+// and is accurate enough for the soft limits built on top of it.
+namespace sg_alloc {
+
+struct group_state {
+    size_t live_bytes = 0;
+    size_t soft_limit = std::numeric_limits<size_t>::max();
+    // set when the callback has been scheduled; re-armed once live_bytes
+    // drops back below soft_limit
+    bool callback_pending = false;
+    std::function<void ()> callback;
+};
+
+static thread_local std::array<group_state, max_scheduling_groups()> groups;
+
+static group_state& current_group() {
+    return groups[seastar::internal::scheduling_group_index(current_scheduling_group())];
+}
+
+// Out of line; needs cpu_pages, which is defined below.
+static void schedule_callback(group_state& gs);
+
+static inline void charge(size_t bytes) {
+    if (!is_reactor_thread) {
+        return;
+    }
+    auto& gs = current_group();
+    gs.live_bytes += bytes;
+    if (__builtin_expect(gs.live_bytes > gs.soft_limit, false) && !gs.callback_pending) {
+        schedule_callback(gs);
+    }
+}
+
+static inline void uncharge(size_t bytes) {
+    if (!is_reactor_thread) {
+        return;
+    }
+    auto& gs = current_group();
+    // Bytes charged to another group (or allocated before the reactor
+    // started) can be freed here; don't let the counter wrap.
+    gs.live_bytes -= std::min(gs.live_bytes, bytes);
+    if (__builtin_expect(gs.callback_pending, false) && gs.live_bytes <= gs.soft_limit) {
+        gs.callback_pending = false;
+    }
+}
+
+}
+
+// Sampled cross-shard layout diagnostics.
+//
+// Piggybacks on the sampled allocation profiler: for each sampled
+// allocation we remember the pointer, its call chain and the scheduling
+// group it was allocated under. When the owner shard later frees such an
+// object on behalf of another shard (off the cross-cpu freelist), the
+// allocation site is charged with a remote free — pointing at the code
+// that allocates objects which migrate across shards. When two sampled
+// allocations made under different scheduling groups land on the same
+// cache line, the pair of sites is recorded as a false-sharing suspect.
+// Both reports are rendered by the memory diagnostics dump.
+namespace layout_diagnostics {
+
+static thread_local bool enabled = false;
+
+struct tracked_alloc {
+    simple_backtrace site;
+    unsigned sg_index;
+};
+
+// sampled live objects, keyed by pointer; owned by the allocating shard
+static auto& tracked() {
+    static thread_local std::unordered_map<void*, tracked_alloc> m;
+    return m;
+}
+
+// allocation sites whose objects were freed by a remote shard, with the
+// number of such frees observed
+static auto& remote_free_sites() {
+    static thread_local std::unordered_map<simple_backtrace, uint64_t> m;
+    return m;
+}
+
+struct line_owner {
+    void* obj;
+    unsigned sg_index;
+};
+
+// the most recent sampled allocation on each cache line
+static auto& line_owners() {
+    static thread_local std::unordered_map<uintptr_t, line_owner> m;
+    return m;
+}
+
+struct shared_line {
+    unsigned sg_a;
+    unsigned sg_b;
+    simple_backtrace site_a;
+    simple_backtrace site_b;
+};
+
+// detailed reports are capped; past the cap only the counter grows
+static constexpr size_t max_shared_line_reports = 32;
+static thread_local uint64_t shared_line_hits = 0;
+
+static auto& shared_lines() {
+    static thread_local std::vector<shared_line> v;
+    return v;
+}
+
+static uintptr_t cache_line_of(void* ptr) {
+    return reinterpret_cast<uintptr_t>(ptr) & ~uintptr_t(cache_line_size - 1);
+}
+
+// Called for every profiler sample while diagnostics are on; allocation
+// re-entry is blocked by the profiler's own guard.
+static void on_sample(void* ptr, const simple_backtrace& site) {
+    if (!enabled) {
+        return;
+    }
+    auto sg = seastar::internal::scheduling_group_index(current_scheduling_group());
+    auto [it, inserted] = line_owners().try_emplace(cache_line_of(ptr), line_owner{ptr, sg});
+    if (!inserted && it->second.sg_index != sg) {
+        ++shared_line_hits;
+        auto other = tracked().find(it->second.obj);
+        if (other != tracked().end() && shared_lines().size() < max_shared_line_reports) {
+            shared_lines().push_back({other->second.sg_index, sg, other->second.site, site});
+        }
+        it->second = line_owner{ptr, sg};
+    }
+    tracked().emplace(ptr, tracked_alloc{site, sg});
+}
+
+// \c remote is true when the object comes off the cross-cpu freelist,
+// i.e. was freed by another shard.
+static void on_free(void* ptr, bool remote) {
+    if (__builtin_expect(!enabled, true) || tracked().empty()) {
+        return;
+    }
+    auto it = tracked().find(ptr);
+    if (it == tracked().end()) {
+        return;
+    }
+    if (remote) {
+        ++remote_free_sites()[it->second.site];
+    }
+    auto lo = line_owners().find(cache_line_of(ptr));
+    if (lo != line_owners().end() && lo->second.obj == ptr) {
+        line_owners().erase(lo);
+    }
+    tracked().erase(it);
+}
+
+}
+
 // original memory allocator support
 // note: allocations before calling the constructor would use seastar allocator
 using malloc_func_type = void * (*)(size_t);
@@ -317,6 +480,7 @@ struct free_object {
 
 struct page {
     bool free;
+    bool advised; // head of a free span already given to MADV_FREE (see advise_out_free_spans())
     uint8_t offset_in_span;
     uint16_t nr_small_alloc;
     uint32_t span_size; // in pages, if we're the head or the tail
@@ -366,6 +530,14 @@ public:
         }
         _front = ary[_front].link._next;
     }
+    // Calls func(span) for each span on the list, front to back. func must
+    // not add or remove spans.
+    template <typename Func>
+    void for_each(page* ary, Func&& func) {
+        for (auto idx = _front; idx; idx = ary[idx].link._next) {
+            func(ary[idx]);
+        }
+    }
     friend seastar::internal::log_buf::inserter_iterator do_dump_memory_diagnostics(seastar::internal::log_buf::inserter_iterator);
 };
 
@@ -476,6 +648,26 @@ struct cross_cpu_free_item {
     cross_cpu_free_item* next;
 };
 
+// Cross-cpu frees are batched: a reactor thread accumulates objects
+// destined for a remote shard on a local, non-atomic chain, and publishes
+// the whole chain onto the destination's xcpu_freelist at once, either
+// when the batch fills up or from drain_cross_cpu_freelist(), which the
+// reactor polls regularly. This amortizes the compare-exchange (and the
+// resulting cache-line ping-pong with other producers) over
+// cross_cpu_free_batch_size items.
+static constexpr unsigned cross_cpu_free_batch_size = 32;
+
+struct cross_cpu_free_batch {
+    cross_cpu_free_item* head = nullptr;
+    cross_cpu_free_item* tail = nullptr;
+    unsigned count = 0;
+};
+
+static thread_local cross_cpu_free_batch xcpu_free_batches[max_cpus];
+// bit per destination cpu with a non-empty batch, so flushing doesn't
+// have to scan all of xcpu_free_batches
+static thread_local unsigned long xcpu_free_pending[max_cpus / std::numeric_limits<unsigned long>::digits];
+
 struct cpu_pages {
     uint32_t min_free_pages = 20000000 / page_size;
     char* memory;
@@ -483,7 +675,23 @@ struct cpu_pages {
     uint32_t nr_pages;
     uint32_t nr_free_pages;
     uint32_t current_min_free_pages = 0;
+    // Size of the pages backing the heap: huge_page_size for anonymous
+    // memory (a hint honored by THP), or the mount's page size when the
+    // heap is hugetlbfs-backed (2MB or 1GB). The heap is mapped and grown
+    // in multiples of this, so huge-page-sized spans stay aligned to it.
+    size_t backing_page_size = huge_page_size;
+    // Bytes mapped beyond nr_pages * page_size by replace_memory_backing()
+    // rounding the bootstrap heap up to backing_page_size; do_resize()
+    // must not map them again.
+    size_t premapped_bytes = 0;
     size_t large_allocation_warning_threshold = std::numeric_limits<size_t>::max();
+    // Idle memory return (see memory::set_idle_memory_return()): once free
+    // memory has stayed above idle_return_watermark for idle_return_grace,
+    // free spans are handed back to the OS with MADV_FREE.
+    size_t idle_return_watermark = std::numeric_limits<size_t>::max(); // disabled
+    std::chrono::steady_clock::duration idle_return_grace = {};
+    std::chrono::steady_clock::time_point idle_return_above_since = {};
+    bool idle_return_above_watermark = false;
     unsigned cpu_id = -1U;
     std::function<void (std::function<void ()>)> reclaim_hook;
     std::vector<reclaimer*> reclaimers;
@@ -526,7 +734,10 @@ struct cpu_pages {
     void free(void* ptr, size_t size);
     static bool try_foreign_free(void* ptr);
     void shrink(void* ptr, size_t new_size);
+    bool try_extend_large(void* ptr, size_t new_size);
     static void free_cross_cpu(unsigned cpu_id, void* ptr);
+    static void publish_cross_cpu_frees(unsigned cpu_id, cross_cpu_free_item* head, cross_cpu_free_item* tail);
+    static bool flush_cross_cpu_free_batches();
     bool drain_cross_cpu_freelist();
     size_t object_size(void* ptr);
     page* to_page(void* p) {
@@ -539,6 +750,9 @@ struct cpu_pages {
     void schedule_reclaim();
     void set_reclaim_hook(std::function<void (std::function<void ()>)> hook);
     void set_min_free_pages(size_t pages);
+    void set_idle_memory_return(size_t watermark_bytes, std::chrono::milliseconds grace);
+    size_t return_idle_memory();
+    size_t advise_out_free_spans(size_t max_bytes);
     void resize(size_t new_size, allocate_system_memory_fn alloc_sys_mem);
     void do_resize(size_t new_size, allocate_system_memory_fn alloc_sys_mem);
     void replace_memory_backing(allocate_system_memory_fn alloc_sys_mem);
@@ -552,6 +766,27 @@ static thread_local cpu_pages cpu_mem;
 std::atomic<unsigned> cpu_pages::cpu_id_gen;
 cpu_pages* cpu_pages::all_cpus[max_cpus];
 
+namespace sg_alloc {
+
+static void schedule_callback(group_state& gs) {
+    if (!cpu_mem.reclaim_hook) {
+        // The reactor hasn't installed the hook yet; try again on the
+        // next allocation.
+        return;
+    }
+    gs.callback_pending = true;
+    alloc_stats::increment(alloc_stats::types::soft_limit_hits);
+    // gs lives in a thread_local array and the hook runs the function on
+    // this same shard, so capturing it by reference is safe.
+    cpu_mem.reclaim_hook([&gs] {
+        if (gs.callback) {
+            gs.callback();
+        }
+    });
+}
+
+}
+
 #ifdef SEASTAR_HEAPPROF
 
 void set_heap_profiling_enabled(bool enable) {
@@ -622,6 +857,7 @@ void cpu_pages::free_span_no_merge(uint32_t span_start, uint32_t nr_pages) {
     auto span = &pages[span_start];
     auto span_end = &pages[span_start + nr_pages - 1];
     span->free = span_end->free = true;
+    span->advised = false; // freshly freed or merged, so (partly) resident again
     span->span_size = span_end->span_size = nr_pages;
     auto idx = index_of(nr_pages);
     link(free_spans[idx], span);
@@ -734,6 +970,7 @@ cpu_pages::allocate_large_and_trim(unsigned n_pages) {
     span->free = span_end->free = false;
     span->span_size = span_end->span_size = span_size;
     span->pool = nullptr;
+    sg_alloc::charge(span_size * page_size);
 #ifdef SEASTAR_HEAPPROF
     auto alloc_site = get_allocation_site();
     span->alloc_site = alloc_site;
@@ -836,12 +1073,16 @@ cpu_pages::allocate_small(unsigned size) {
     }
     new (&pool.alloc_site_holder(ptr)) allocation_site_ptr{alloc_site};
 #endif
+    if (ptr) {
+        sg_alloc::charge(pool.object_size());
+    }
     return ptr;
 }
 
 void cpu_pages::free_large(void* ptr) {
     pageidx idx = (reinterpret_cast<char*>(ptr) - mem()) / page_size;
     page* span = &pages[idx];
+    sg_alloc::uncharge(size_t(span->span_size) * page_size);
 #ifdef SEASTAR_HEAPPROF
     auto alloc_site = span->alloc_site;
     if (alloc_site) {
@@ -875,22 +1116,71 @@ void cpu_pages::free_cross_cpu(unsigned cpu_id, void* ptr) {
         return;
     }
     auto p = reinterpret_cast<cross_cpu_free_item*>(ptr);
+    alloc_stats::increment(alloc_stats::types::cross_cpu_frees);
+    if (!is_reactor_thread) {
+        // Nobody flushes a non-reactor thread's batches; publish directly.
+        p->next = nullptr;
+        publish_cross_cpu_frees(cpu_id, p, p);
+        return;
+    }
+    constexpr auto digits = std::numeric_limits<unsigned long>::digits;
+    auto& b = xcpu_free_batches[cpu_id];
+    p->next = b.head;
+    b.head = p;
+    if (!b.tail) {
+        b.tail = p;
+        xcpu_free_pending[cpu_id / digits] |= 1UL << (cpu_id % digits);
+    }
+    if (++b.count == cross_cpu_free_batch_size) {
+        auto head = b.head;
+        auto tail = b.tail;
+        b = {};
+        xcpu_free_pending[cpu_id / digits] &= ~(1UL << (cpu_id % digits));
+        publish_cross_cpu_frees(cpu_id, head, tail);
+    }
+}
+
+void cpu_pages::publish_cross_cpu_frees(unsigned cpu_id, cross_cpu_free_item* head, cross_cpu_free_item* tail) {
     auto& list = all_cpus[cpu_id]->xcpu_freelist;
     auto old = list.load(std::memory_order_relaxed);
     do {
-        p->next = old;
-    } while (!list.compare_exchange_weak(old, p, std::memory_order_release, std::memory_order_relaxed));
-    alloc_stats::increment(alloc_stats::types::cross_cpu_frees);
+        tail->next = old;
+    } while (!list.compare_exchange_weak(old, head, std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool cpu_pages::flush_cross_cpu_free_batches() {
+    bool flushed = false;
+    constexpr auto digits = std::numeric_limits<unsigned long>::digits;
+    for (unsigned w = 0; w < max_cpus / digits; ++w) {
+        while (xcpu_free_pending[w]) {
+            auto cpu_id = w * digits + count_trailing_zeros(xcpu_free_pending[w]);
+            xcpu_free_pending[w] &= xcpu_free_pending[w] - 1;
+            auto& b = xcpu_free_batches[cpu_id];
+            if (live_cpus[cpu_id].load(std::memory_order_relaxed)) {
+                publish_cross_cpu_frees(cpu_id, b.head, b.tail);
+                flushed = true;
+            } // else: thread was destroyed; leak the chain, as above
+            b = {};
+        }
+    }
+    return flushed;
 }
 
 bool cpu_pages::drain_cross_cpu_freelist() {
+    bool flushed = flush_cross_cpu_free_batches();
     if (!xcpu_freelist.load(std::memory_order_relaxed)) {
-        return false;
+        return flushed;
     }
     auto p = xcpu_freelist.exchange(nullptr, std::memory_order_acquire);
     while (p) {
         auto n = p->next;
+        if (n) {
+            // the chain was linked by remote shards; pull the next node in
+            // while we free this one
+            __builtin_prefetch(n);
+        }
         alloc_stats::increment(alloc_stats::types::frees);
+        layout_diagnostics::on_free(p, true);
         free(p);
         p = n;
     }
@@ -901,6 +1191,7 @@ void cpu_pages::free(void* ptr) {
     page* span = to_page(ptr);
     if (span->pool) {
         small_pool& pool = *span->pool;
+        sg_alloc::uncharge(pool.object_size());
 #ifdef SEASTAR_HEAPPROF
         allocation_site_ptr alloc_site = pool.alloc_site_holder(ptr);
         if (alloc_site) {
@@ -922,6 +1213,7 @@ void cpu_pages::free(void* ptr, size_t size) {
     if (size <= max_small_allocation) {
         size = object_size_with_alloc_site(size);
         auto pool = &small_pools[small_pool::size_to_idx(size)];
+        sg_alloc::uncharge(pool->object_size());
 #ifdef SEASTAR_HEAPPROF
         allocation_site_ptr alloc_site = pool->alloc_site_holder(ptr);
         if (alloc_site) {
@@ -969,6 +1261,7 @@ void cpu_pages::shrink(void* ptr, size_t new_size) {
     if (new_size_pages == old_size_pages) {
         return;
     }
+    sg_alloc::uncharge((old_size_pages - new_size_pages) * page_size);
 #ifdef SEASTAR_HEAPPROF
     auto alloc_site = span->alloc_site;
     if (alloc_site) {
@@ -983,6 +1276,42 @@ void cpu_pages::shrink(void* ptr, size_t new_size) {
     free_span_unaligned(idx + new_size_pages, old_size_pages - new_size_pages);
 }
 
+bool cpu_pages::try_extend_large(void* ptr, size_t new_size) {
+    page* span = to_page(ptr);
+    if (span->pool) {
+        // small-pool objects belong to fixed size classes
+        return false;
+    }
+    pageidx idx = span - pages;
+    auto span_size = span->span_size;
+    auto new_size_pages = uint32_t((new_size + page_size - 1) >> page_bits);
+    while (span_size < new_size_pages) {
+        // Spans are naturally aligned, so the span can only grow by
+        // absorbing its buddy, and only when it is the lower one
+        if (idx & span_size) {
+            return false;
+        }
+        auto buddy = idx + span_size;
+        if (buddy + span_size > nr_pages || !pages[buddy].free || pages[buddy].span_size != span_size) {
+            return false;
+        }
+        unlink(free_spans[index_of(span_size)], &pages[buddy]);
+        nr_free_pages -= span_size;
+        sg_alloc::charge(span_size * page_size);
+#ifdef SEASTAR_HEAPPROF
+        if (span->alloc_site) {
+            span->alloc_site->size += span_size * page_size;
+        }
+#endif
+        span_size *= 2;
+        span->span_size = span_size;
+        auto span_end = &pages[idx + span_size - 1];
+        span_end->free = false;
+        span_end->span_size = span_size;
+    }
+    return true;
+}
+
 cpu_pages::~cpu_pages() {
     if (is_initialized()) {
         live_cpus[cpu_id].store(false, std::memory_order_relaxed);
@@ -1036,6 +1365,16 @@ static allocate_anonymous_memory(void* where, size_t how_much) {
             MAP_PRIVATE | MAP_FIXED);
 }
 
+// The page size backing a hugetlbfs mount (2MB or 1GB); for hugetlbfs,
+// fstatfs() reports it in f_bsize.
+static size_t
+hugetlbfs_page_size(file_desc& fd) {
+    struct ::statfs buf;
+    auto r = ::fstatfs(fd.get(), &buf);
+    throw_system_error_on(r == -1, "fstatfs");
+    return buf.f_bsize;
+}
+
 mmap_area
 allocate_hugetlbfs_memory(file_desc& fd, void* where, size_t how_much) {
     auto pos = fd.size();
@@ -1056,11 +1395,17 @@ void cpu_pages::replace_memory_backing(allocate_system_memory_fn alloc_sys_mem)
     // place, map hugetlbfs in place, and copy it back, without modifying it during
     // the operation.
     auto bytes = nr_pages * page_size;
+    // hugetlbfs mappings must be multiples of the backing page size; with
+    // 1GB pages the bootstrap heap is smaller than a single page, so map
+    // the excess now and remember not to map it again when the heap grows
+    // into it.
+    auto mmap_bytes = align_up(bytes, backing_page_size);
     auto old_mem = mem();
     auto relocated_old_mem = mmap_anonymous(nullptr, bytes, PROT_READ|PROT_WRITE, MAP_PRIVATE);
     std::memcpy(relocated_old_mem.get(), old_mem, bytes);
-    alloc_sys_mem(old_mem, bytes).release();
+    alloc_sys_mem(old_mem, mmap_bytes).release();
     std::memcpy(old_mem, relocated_old_mem.get(), bytes);
+    premapped_bytes = mmap_bytes;
 }
 
 void cpu_pages::do_resize(size_t new_size, allocate_system_memory_fn alloc_sys_mem) {
@@ -1071,9 +1416,18 @@ void cpu_pages::do_resize(size_t new_size, allocate_system_memory_fn alloc_sys_m
     auto old_size = nr_pages * page_size;
     auto mmap_start = memory + old_size;
     auto mmap_size = new_size - old_size;
-    auto mem = alloc_sys_mem(mmap_start, mmap_size);
-    mem.release();
-    ::madvise(mmap_start, mmap_size, MADV_HUGEPAGE);
+    if (old_size < premapped_bytes) {
+        // replace_memory_backing() rounded the bootstrap heap up to
+        // backing_page_size; that part is already mapped.
+        auto skip = std::min(premapped_bytes - old_size, mmap_size);
+        mmap_start += skip;
+        mmap_size -= skip;
+    }
+    if (mmap_size) {
+        auto mem = alloc_sys_mem(mmap_start, mmap_size);
+        mem.release();
+        ::madvise(mmap_start, mmap_size, MADV_HUGEPAGE);
+    }
     // one past last page structure is a sentinel
     auto new_page_array_pages = align_up(sizeof(page[new_pages + 1]), page_size) / page_size;
     auto new_page_array
@@ -1103,11 +1457,11 @@ void cpu_pages::do_resize(size_t new_size, allocate_system_memory_fn alloc_sys_m
 }
 
 void cpu_pages::resize(size_t new_size, allocate_system_memory_fn alloc_memory) {
-    new_size = align_down(new_size, huge_page_size);
+    new_size = align_down(new_size, backing_page_size);
     while (nr_pages * page_size < new_size) {
         // don't reallocate all at once, since there might not
         // be enough free memory available to relocate the pages array
-        auto tmp_size = std::min(new_size, 4 * nr_pages * page_size);
+        auto tmp_size = std::min(new_size, align_up(4 * nr_pages * page_size, backing_page_size));
         do_resize(tmp_size, alloc_memory);
     }
 }
@@ -1167,6 +1521,64 @@ void cpu_pages::set_min_free_pages(size_t pages) {
     maybe_reclaim();
 }
 
+void cpu_pages::set_idle_memory_return(size_t watermark_bytes, std::chrono::milliseconds grace) {
+    idle_return_watermark = watermark_bytes ? watermark_bytes : std::numeric_limits<size_t>::max();
+    idle_return_grace = grace;
+    idle_return_above_watermark = false;
+}
+
+// Hands free spans back to the OS with MADV_FREE (MADV_DONTNEED on kernels
+// that lack it). The spans stay on the free lists and are reused normally:
+// the kernel only reclaims the underlying pages lazily, under memory
+// pressure, and refaults them on the first write after reuse. The advised
+// flag keeps us from re-advising the same idle span on every pass; it is
+// cleared whenever a span is freed or merged.
+size_t
+cpu_pages::advise_out_free_spans(size_t max_bytes) {
+#ifdef MADV_FREE
+    static constexpr int advice = MADV_FREE;
+#else
+    static constexpr int advice = MADV_DONTNEED;
+#endif
+    size_t advised = 0;
+    // Largest spans first: fewest syscalls per byte, and big spans are the
+    // least likely to be reused soon.
+    for (unsigned idx = nr_span_lists; idx-- > 0 && advised < max_bytes; ) {
+        free_spans[idx].for_each(pages, [&] (page& span) {
+            if (span.advised || advised >= max_bytes) {
+                return;
+            }
+            auto bytes = size_t(span.span_size) * page_size;
+            ::madvise(mem() + (&span - pages) * page_size, bytes, advice);
+            span.advised = true;
+            advised += bytes;
+        });
+    }
+    return advised;
+}
+
+size_t cpu_pages::return_idle_memory() {
+    if (size_t(nr_free_pages) * page_size <= idle_return_watermark) {
+        idle_return_above_watermark = false;
+        return 0;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (!idle_return_above_watermark) {
+        idle_return_above_watermark = true;
+        idle_return_above_since = now;
+        return 0;
+    }
+    if (now - idle_return_above_since < idle_return_grace) {
+        return 0;
+    }
+    // Cap the work per call so a huge backlog of idle spans doesn't turn
+    // into a syscall storm in a single reactor tick.
+    static constexpr size_t max_bytes_per_call = 64 << 20;
+    auto advised = advise_out_free_spans(max_bytes_per_call);
+    alloc_stats::increment(alloc_stats::types::bytes_returned_to_os, advised);
+    return advised;
+}
+
 small_pool::small_pool(unsigned object_size) noexcept
     : _object_size(object_size) {
     unsigned span_size = 1;
@@ -1301,6 +1713,42 @@ small_pool::trim_free_list() {
     }
 }
 
+// This shard's reserve of spans borrowed from other shards (see the
+// protocol description in memory.hh). The reserve is a small fixed
+// array: it is touched when this shard is low on memory, so it must not
+// allocate itself.
+namespace donation {
+
+static constexpr unsigned max_reserve = 16;
+
+struct reserved_span {
+    void* ptr;
+    size_t bytes;
+};
+
+static thread_local reserved_span reserve[max_reserve];
+static thread_local unsigned nr_reserved = 0;
+
+// Best-fit search of the reserve for a large allocation that the local
+// pool could not satisfy. The whole span is handed out; its real size
+// is tracked by the donor's page metadata, so freeing works as usual.
+static void* take(size_t size) {
+    unsigned best = nr_reserved;
+    for (unsigned i = 0; i < nr_reserved; ++i) {
+        if (reserve[i].bytes >= size && (best == nr_reserved || reserve[i].bytes < reserve[best].bytes)) {
+            best = i;
+        }
+    }
+    if (best == nr_reserved) {
+        return nullptr;
+    }
+    auto ptr = reserve[best].ptr;
+    reserve[best] = reserve[--nr_reserved];
+    return ptr;
+}
+
+}
+
 void
 abort_on_underflow(size_t size) {
     if (std::make_signed_t<size_t>(size) < 0) {
@@ -1315,8 +1763,11 @@ void* allocate_large(size_t size) {
     if ((size_t(size_in_pages) << page_bits) < size) {
         return nullptr; // (size + page_size - 1) caused an overflow
     }
-    return cpu_mem.allocate_large(size_in_pages);
-
+    auto ptr = cpu_mem.allocate_large(size_in_pages);
+    if (!ptr) {
+        ptr = donation::take(size);
+    }
+    return ptr;
 }
 
 void* allocate_large_aligned(size_t align, size_t size) {
@@ -1358,6 +1809,65 @@ static inline cpu_pages& get_cpu_mem()
     return *cpu_mem_ptr;
 }
 
+// Continuous sampled allocation profiler.
+//
+// Unlike the SEASTAR_HEAPPROF profiler, which records every allocation
+// and has to be compiled in, this takes one backtrace per sample_rate
+// allocated bytes, which is cheap enough to stay enabled in production.
+// It attributes allocation volume to call chains, not live objects: a
+// site that shows up prominently allocates a lot, whether or not it
+// also frees.
+namespace heap_sampling {
+
+static constexpr ssize_t sampling_disabled = std::numeric_limits<ssize_t>::max();
+static thread_local size_t sample_rate = 0; // bytes between samples; 0 = off
+static thread_local ssize_t bytes_until_sample = sampling_disabled;
+
+struct site_stats {
+    uint64_t samples = 0;
+    uint64_t bytes = 0; // scaled up by sample_rate to estimate the total
+};
+
+using site_map = std::unordered_map<simple_backtrace, site_stats>;
+
+static site_map& sites() {
+    static thread_local site_map m;
+    return m;
+}
+
+[[gnu::cold]]
+static void sample_allocation(void* ptr, size_t size) {
+    // Collecting the backtrace and updating the map allocate themselves;
+    // block re-entry until we re-arm at the end.
+    bytes_until_sample = sampling_disabled;
+    if (!sample_rate || !is_reactor_thread) {
+        return;
+    }
+    simple_backtrace::vector_type v;
+    backtrace([&] (frame f) {
+        if (v.size() < v.capacity()) {
+            v.emplace_back(std::move(f));
+        }
+    });
+    // ';' so the exported stacks are already in collapsed ("flamegraph")
+    // format
+    auto bt = simple_backtrace(std::move(v), ';');
+    layout_diagnostics::on_sample(ptr, bt);
+    auto& st = sites()[std::move(bt)];
+    ++st.samples;
+    // each sample stands for sample_rate bytes of allocation on average
+    st.bytes += std::max(size, sample_rate);
+    bytes_until_sample = sample_rate;
+}
+
+inline void on_alloc(void* ptr, size_t size) {
+    if (__builtin_expect((bytes_until_sample -= size) < 0, false)) {
+        sample_allocation(ptr, size);
+    }
+}
+
+}
+
 #ifdef SEASTAR_DEBUG_ALLOCATIONS
 static constexpr int debug_allocation_pattern = 0xab;
 #endif
@@ -1385,6 +1895,7 @@ void* allocate(size_t size) {
 #ifdef SEASTAR_DEBUG_ALLOCATIONS
         std::memset(ptr, debug_allocation_pattern, size);
 #endif
+        heap_sampling::on_alloc(ptr, size);
     }
     alloc_stats::increment(alloc_stats::types::allocs);
     return ptr;
@@ -1415,6 +1926,7 @@ void* allocate_aligned(size_t align, size_t size) {
 #ifdef SEASTAR_DEBUG_ALLOCATIONS
         std::memset(ptr, debug_allocation_pattern, size);
 #endif
+        heap_sampling::on_alloc(ptr, size);
     }
     alloc_stats::increment(alloc_stats::types::allocs);
     return ptr;
@@ -1425,6 +1937,7 @@ void free(void* obj) {
         return;
     }
     alloc_stats::increment(alloc_stats::types::frees);
+    layout_diagnostics::on_free(obj, false);
     get_cpu_mem().free(obj);
 }
 
@@ -1433,6 +1946,7 @@ void free(void* obj, size_t size) {
         return;
     }
     alloc_stats::increment(alloc_stats::types::frees);
+    layout_diagnostics::on_free(obj, false);
     get_cpu_mem().free(obj, size);
 }
 
@@ -1453,10 +1967,102 @@ void shrink(void* obj, size_t new_size) {
     cpu_mem.shrink(obj, new_size);
 }
 
+bool try_extend(void* obj, size_t new_size) noexcept {
+    if (!is_seastar_memory(obj) || object_cpu_id(obj) != cpu_mem.cpu_id) {
+        return false;
+    }
+    if (!cpu_mem.try_extend_large(obj, new_size)) {
+        return false;
+    }
+    alloc_stats::increment(alloc_stats::types::frees);
+    alloc_stats::increment(alloc_stats::types::allocs); // keep them balanced
+    return true;
+}
+
 void set_reclaim_hook(std::function<void (std::function<void ()>)> hook) {
     cpu_mem.set_reclaim_hook(hook);
 }
 
+void set_sampled_memory_profiling_rate(size_t rate) {
+    heap_sampling::sample_rate = rate;
+    heap_sampling::bytes_until_sample = rate ? ssize_t(rate) : heap_sampling::sampling_disabled;
+}
+
+size_t sampled_memory_profiling_rate() {
+    return heap_sampling::sample_rate;
+}
+
+void set_layout_diagnostics_enabled(bool enabled) {
+    if (enabled && !layout_diagnostics::enabled) {
+        // start a fresh collection
+        layout_diagnostics::tracked().clear();
+        layout_diagnostics::line_owners().clear();
+        layout_diagnostics::remote_free_sites().clear();
+        layout_diagnostics::shared_lines().clear();
+        layout_diagnostics::shared_line_hits = 0;
+    }
+    layout_diagnostics::enabled = enabled;
+}
+
+bool layout_diagnostics_enabled() {
+    return layout_diagnostics::enabled;
+}
+
+sstring sampled_memory_profile() {
+    std::ostringstream os;
+    for (auto&& [bt, st] : heap_sampling::sites()) {
+        os << bt << ' ' << st.bytes << '\n';
+    }
+    return sstring(os.str());
+}
+
+void* try_allocate_donation(size_t bytes) {
+    auto& cm = get_cpu_mem();
+    unsigned n_pages = (bytes + page_size - 1) >> page_bits;
+    // Only donate out of comfortable headroom, so a donor doesn't turn
+    // into a borrower itself.
+    if (cm.nr_free_pages < n_pages + 4 * cm.min_free_pages) {
+        return nullptr;
+    }
+    return cm.allocate_large(n_pages);
+}
+
+void add_donated_span(void* span, size_t bytes) {
+    if (donation::nr_reserved == donation::max_reserve) {
+        // shouldn't happen (wants_donated_memory() stops earlier), but
+        // don't lose the span
+        seastar::memory::free(span);
+        return;
+    }
+    donation::reserve[donation::nr_reserved++] = {span, bytes};
+}
+
+std::pair<void*, size_t> retrieve_donated_span() {
+    auto& cm = get_cpu_mem();
+    // hysteresis: keep the reserve until local memory is comfortable again
+    if (!donation::nr_reserved || cm.nr_free_pages < 4 * cm.min_free_pages) {
+        return {nullptr, 0};
+    }
+    auto s = donation::reserve[--donation::nr_reserved];
+    return {s.ptr, s.bytes};
+}
+
+bool wants_donated_memory() {
+    auto& cm = get_cpu_mem();
+    return cm.nr_free_pages < 2 * cm.min_free_pages && donation::nr_reserved < donation::max_reserve;
+}
+
+size_t scheduling_group_live_memory(scheduling_group sg) noexcept {
+    return sg_alloc::groups[seastar::internal::scheduling_group_index(sg)].live_bytes;
+}
+
+void set_scheduling_group_soft_limit(scheduling_group sg, size_t limit, std::function<void ()> callback) {
+    auto& gs = sg_alloc::groups[seastar::internal::scheduling_group_index(sg)];
+    gs.soft_limit = limit;
+    gs.callback = std::move(callback);
+    gs.callback_pending = false;
+}
+
 reclaimer::reclaimer(std::function<reclaiming_result ()> reclaim, reclaimer_scope scope)
     : reclaimer([reclaim = std::move(reclaim)] (request) {
         return reclaim();
@@ -1505,10 +2111,20 @@ void configure(std::vector<resource::memory> m, bool mbind,
         // std::function is copyable, but file_desc is not, so we must use
         // a shared_ptr to allow sys_alloc to be copied around
         auto fdp = make_lw_shared<file_desc>(file_desc::temporary(*hugetlbfs_path));
-        sys_alloc = [fdp] (void* where, size_t how_much) {
-            return allocate_hugetlbfs_memory(*fdp, where, how_much);
-        };
-        cpu_mem.replace_memory_backing(sys_alloc);
+        auto backing_size = hugetlbfs_page_size(*fdp);
+        if (backing_size > total) {
+            // A single page of the mount (e.g. 1GB hugetlbfs) exceeds the
+            // shard's memory; fall back to transparent huge pages.
+            std::cerr << "WARNING: hugetlbfs page size (" << backing_size
+                    << ") exceeds shard memory (" << total
+                    << "); falling back to anonymous memory" << std::endl;
+        } else {
+            cpu_mem.backing_page_size = backing_size;
+            sys_alloc = [fdp] (void* where, size_t how_much) {
+                return allocate_hugetlbfs_memory(*fdp, where, how_much);
+            };
+            cpu_mem.replace_memory_backing(sys_alloc);
+        }
     }
     cpu_mem.resize(total, sys_alloc);
     size_t pos = 0;
@@ -1533,10 +2149,33 @@ void configure(std::vector<resource::memory> m, bool mbind,
     }
 }
 
+void prefault_memory(memory_layout layout) {
+#ifdef MADV_POPULATE_WRITE
+    constexpr int populate_write = MADV_POPULATE_WRITE;
+#else
+    constexpr int populate_write = 23; // Linux 5.14+
+#endif
+    // Batches keep individual madvise() calls short; with 1GB hugetlbfs
+    // pages a batch is still a handful of pages.
+    constexpr size_t batch_size = 128 << 20;
+    auto pos = layout.start;
+    while (pos < layout.end) {
+        auto len = std::min<size_t>(batch_size, layout.end - pos);
+        if (::madvise(reinterpret_cast<void*>(pos), len, populate_write) != 0) {
+            // typically EINVAL from an older kernel; first-use faulting
+            // takes over from here
+            return;
+        }
+        pos += len;
+    }
+}
+
 statistics stats() {
     return statistics{alloc_stats::get(alloc_stats::types::allocs), alloc_stats::get(alloc_stats::types::frees), alloc_stats::get(alloc_stats::types::cross_cpu_frees),
         cpu_mem.nr_pages * page_size, cpu_mem.nr_free_pages * page_size, alloc_stats::get(alloc_stats::types::reclaims), alloc_stats::get(alloc_stats::types::large_allocs),
-        alloc_stats::get(alloc_stats::types::foreign_mallocs), alloc_stats::get(alloc_stats::types::foreign_frees), alloc_stats::get(alloc_stats::types::foreign_cross_frees)};
+        alloc_stats::get(alloc_stats::types::foreign_mallocs), alloc_stats::get(alloc_stats::types::foreign_frees), alloc_stats::get(alloc_stats::types::foreign_cross_frees),
+        alloc_stats::get(alloc_stats::types::soft_limit_hits),
+        alloc_stats::get(alloc_stats::types::bytes_returned_to_os)};
 }
 
 bool drain_cross_cpu_freelist() {
@@ -1555,6 +2194,14 @@ void set_min_free_pages(size_t pages) {
     cpu_mem.set_min_free_pages(pages);
 }
 
+void set_idle_memory_return(size_t watermark_bytes, std::chrono::milliseconds grace) {
+    cpu_mem.set_idle_memory_return(watermark_bytes, grace);
+}
+
+size_t return_idle_memory() {
+    return cpu_mem.return_idle_memory();
+}
+
 static thread_local int report_on_alloc_failure_suppressed = 0;
 
 class disable_report_on_alloc_failure_temporarily {
@@ -1655,6 +2302,34 @@ seastar::internal::log_buf::inserter_iterator do_dump_memory_diagnostics(seastar
         });
     }
 
+    if (layout_diagnostics::enabled) {
+        auto& rfs = layout_diagnostics::remote_free_sites();
+        std::vector<std::pair<const simple_backtrace*, uint64_t>> by_count;
+        by_count.reserve(rfs.size());
+        for (auto&& [bt, count] : rfs) {
+            by_count.emplace_back(&bt, count);
+        }
+        std::sort(by_count.begin(), by_count.end(), [] (auto& a, auto& b) {
+            return a.second > b.second;
+        });
+        static constexpr size_t max_remote_free_sites = 10;
+        it = fmt::format_to(it, "Sampled remote-free sites: {}\n", rfs.size());
+        for (size_t i = 0; i < std::min(by_count.size(), max_remote_free_sites); ++i) {
+            std::ostringstream os;
+            os << *by_count[i].first;
+            it = fmt::format_to(it, "{} remote frees at {}\n", by_count[i].second, os.str());
+        }
+        it = fmt::format_to(it, "Sampled cache lines shared across scheduling groups: {}\n", layout_diagnostics::shared_line_hits);
+        for (auto&& sl : layout_diagnostics::shared_lines()) {
+            std::ostringstream os_a;
+            std::ostringstream os_b;
+            os_a << sl.site_a;
+            os_b << sl.site_b;
+            it = fmt::format_to(it, "group {} at {}\n  shares a cache line with group {} at {}\n", sl.sg_a, os_a.str(), sl.sg_b, os_b.str());
+        }
+        it = fmt::format_to(it, "\n");
+    }
+
     it = fmt::format_to(it, "Small pools:\n");
     it = fmt::format_to(it, "objsz\tspansz\tusedobj\tmemory\tunused\twst%\n");
     for (unsigned i = 0; i < cpu_mem.small_pools.nr_small_pools; i++) {
@@ -2178,6 +2853,100 @@ void operator delete[](void* ptr, std::align_val_t a, const std::nothrow_t&) noe
 
 namespace seastar {
 
+namespace internal {
+
+// Shard-local pool behind allocate_pooled_aligned_buffer() (see
+// aligned_buffer.hh). DMA-aligned buffers of 4k..128k are recycled
+// through small per-size free lists instead of going back to the
+// allocator, so streaming file reads stop paying an allocation plus the
+// attendant page faults for every read-ahead chunk. Pooled buffers are
+// ordinary aligned allocations, so anything the pool refuses --
+// oversized buffers, overfull size classes, frees on the wrong shard --
+// simply falls back to free().
+class pooled_aligned_buffers {
+    static constexpr size_t min_buffer_size = 4096;
+    static constexpr size_t max_buffer_size = 128 * 1024;
+    static constexpr unsigned nr_classes = log2floor(max_buffer_size / min_buffer_size) + 1;
+    // caps the memory the pool can hold to ~2MB per shard
+    static constexpr unsigned max_free_per_class = 8;
+    struct free_object {
+        free_object* next;
+    };
+    struct size_class {
+        free_object* free = nullptr;
+        unsigned nr_free = 0;
+    };
+    size_class _classes[nr_classes];
+    static unsigned index_of(size_t size) {
+        return log2floor(size) - log2floor(min_buffer_size);
+    }
+public:
+    void* allocate(size_t size, size_t align) {
+        if (!memory::is_reactor_thread || !size || size > max_buffer_size || align > min_buffer_size) {
+            return nullptr;
+        }
+        // All pooled buffers are aligned to min_buffer_size and sized to
+        // a power of two, so any buffer of the right size class satisfies
+        // any poolable request.
+        auto full_size = std::max(size_t(1) << log2ceil(size), min_buffer_size);
+        auto& sc = _classes[index_of(full_size)];
+        if (sc.free) {
+            auto obj = sc.free;
+            sc.free = obj->next;
+            --sc.nr_free;
+            return obj;
+        }
+        return allocate_aligned_buffer_impl(full_size, min_buffer_size);
+    }
+    bool try_recycle(void* p) noexcept {
+        if (!memory::is_reactor_thread) {
+            // the pool has no destructor, so a short-lived thread would
+            // leak whatever it recycles
+            return false;
+        }
+        if (reinterpret_cast<uintptr_t>(p) & (min_buffer_size - 1)) {
+            return false;
+        }
+        if (!memory::is_seastar_memory(p) || memory::object_cpu_id(p) != memory::cpu_mem.cpu_id) {
+            // let free() route foreign buffers back to their owner
+            return false;
+        }
+        auto size = ::malloc_usable_size(p);
+        if (size < min_buffer_size || size > max_buffer_size) {
+            return false;
+        }
+        auto& sc = _classes[index_of(size)];
+        if (sc.nr_free == max_free_per_class) {
+            return false;
+        }
+        auto obj = static_cast<free_object*>(p);
+        obj->next = sc.free;
+        sc.free = obj;
+        ++sc.nr_free;
+        return true;
+    }
+};
+
+// This pool fills and is consumed on reactor threads only, which live as
+// long as the process does, so there is deliberately no destructor; being
+// trivially destructible also makes it safe to consult during thread
+// teardown.
+static thread_local pooled_aligned_buffers local_pooled_aligned_buffers;
+
+void* allocate_pooled_aligned_buffer(size_t size, size_t align) {
+    return local_pooled_aligned_buffers.allocate(size, align);
+}
+
+bool try_recycle_aligned_buffer(void* p) noexcept {
+    return local_pooled_aligned_buffers.try_recycle(p);
+}
+
+} // namespace internal
+
+}
+
+namespace seastar {
+
 #else
 
 namespace seastar {
@@ -2221,14 +2990,67 @@ void set_reclaim_hook(std::function<void (std::function<void ()>)> hook) {
 void configure(std::vector<resource::memory> m, bool mbind, std::optional<std::string> hugepages_path) {
 }
 
+void prefault_memory(memory_layout) {
+}
+
 statistics stats() {
-    return statistics{0, 0, 0, 1 << 30, 1 << 30, 0, 0, 0, 0, 0};
+    return statistics{0, 0, 0, 1 << 30, 1 << 30, 0, 0, 0, 0, 0, 0, 0};
+}
+
+size_t scheduling_group_live_memory(scheduling_group) noexcept {
+    // Not tracked for the default allocator.
+    return 0;
+}
+
+void set_scheduling_group_soft_limit(scheduling_group, size_t, std::function<void ()>) {
+    // Ignore, not supported for default allocator.
+}
+
+void set_sampled_memory_profiling_rate(size_t) {
+    seastar_logger.warn("Seastar compiled with default allocator, sampled memory profiler not supported");
+}
+
+size_t sampled_memory_profiling_rate() {
+    return 0;
+}
+
+sstring sampled_memory_profile() {
+    return sstring();
+}
+
+void set_layout_diagnostics_enabled(bool) {
+    seastar_logger.warn("Seastar compiled with default allocator, layout diagnostics not supported");
+}
+
+bool layout_diagnostics_enabled() {
+    return false;
+}
+
+void* try_allocate_donation(size_t) {
+    // No span donation with the default allocator; memory is shared anyway.
+    return nullptr;
+}
+
+void add_donated_span(void*, size_t) {
+}
+
+std::pair<void*, size_t> retrieve_donated_span() {
+    return {nullptr, 0};
+}
+
+bool wants_donated_memory() {
+    return false;
 }
 
 bool drain_cross_cpu_freelist() {
     return false;
 }
 
+bool try_extend(void*, size_t) noexcept {
+    // The default allocator cannot extend allocations in place.
+    return false;
+}
+
 memory_layout get_memory_layout() {
     throw std::runtime_error("get_memory_layout() not supported");
 }
@@ -2241,6 +3063,14 @@ void set_min_free_pages(size_t pages) {
     // Ignore, reclaiming not supported for default allocator.
 }
 
+void set_idle_memory_return(size_t watermark_bytes, std::chrono::milliseconds grace) {
+    // Ignore, the default allocator returns memory on its own schedule.
+}
+
+size_t return_idle_memory() {
+    return 0;
+}
+
 void set_large_allocation_warning_threshold(size_t) {
     // Ignore, not supported for default allocator.
 }
@@ -2274,6 +3104,20 @@ sstring generate_memory_diagnostics_report() {
 
 }
 
+namespace internal {
+
+void* allocate_pooled_aligned_buffer(size_t size, size_t align) {
+    // No pooling with the default allocator; keeps every buffer visible
+    // to valgrind/ASan.
+    return nullptr;
+}
+
+bool try_recycle_aligned_buffer(void* p) noexcept {
+    return false;
+}
+
+}
+
 }
 
 namespace seastar {
@@ -112,6 +112,26 @@ future<> configure(const boost::program_options::variables_map & opts) {
     });
 }
 
+future<> set_relabel_configs(std::vector<relabel_config> configs) {
+    return smp::invoke_on_all([configs] {
+        impl::get_local_impl()->set_relabel_configs(configs);
+    });
+}
+
+std::vector<relabel_config> get_relabel_configs() {
+    return impl::get_local_impl()->get_relabel_configs();
+}
+
+future<> set_sample_caching_period(std::chrono::milliseconds period) {
+    return smp::invoke_on_all([period] {
+        impl::get_local_impl()->set_sample_caching_period(period);
+    });
+}
+
+std::chrono::milliseconds get_sample_caching_period() {
+    return impl::get_local_impl()->get_sample_caching_period();
+}
+
 
 bool label_instance::operator!=(const label_instance& id2) const {
     auto& id1 = *this;
@@ -122,7 +142,7 @@ label shard_label("shard");
 namespace impl {
 
 registered_metric::registered_metric(metric_id id, metric_function f, bool enabled) :
-        _f(f), _impl(get_local_impl()) {
+        _enabled_by_def(enabled), _f(f), _impl(get_local_impl()) {
     _info.enabled = enabled;
     _info.id = id;
 }
@@ -185,6 +205,15 @@ metric_groups_impl& metric_groups_impl::add_metric(group_name_type name, const m
 
     metric_id id(name, md._impl->name, md._impl->labels);
 
+    auto labels = md._impl->labels;
+    if (!get_local_impl()->apply_relabel_rules(id.full_name(), labels)) {
+        // a drop/keep rule filtered the metric out, never register it
+        return *this;
+    }
+    if (labels != md._impl->labels) {
+        id = metric_id(name, md._impl->name, std::move(labels));
+    }
+
     get_local_impl()->add_registration(id, md._impl->type, md._impl->f, md._impl->d, md._impl->enabled);
 
     _registration.push_back(id);
@@ -256,10 +285,15 @@ const value_map& get_value_map() {
 }
 
 foreign_ptr<values_reference> get_values() {
+    auto now = std::chrono::steady_clock::now();
+    if (auto cached = get_local_impl()->cached_sample(now)) {
+        return cached;
+    }
     shared_ptr<values_copy> res_ref = ::seastar::make_shared<values_copy>();
     auto& res = *(res_ref.get());
     auto& mv = res.values;
     res.metadata = get_local_impl()->metadata();
+    res.epoch = get_local_impl()->epoch();
     auto & functions = get_local_impl()->functions();
     mv.reserve(functions.size());
     for (auto&& i : functions) {
@@ -270,6 +304,38 @@ foreign_ptr<values_reference> get_values() {
         }
         mv.emplace_back(std::move(values));
     }
+    get_local_impl()->cache_sample(res_ref, now);
+    return res_ref;
+}
+
+foreign_ptr<values_reference> get_values(const sstring& start_family, size_t max_families) {
+    shared_ptr<values_copy> res_ref = ::seastar::make_shared<values_copy>();
+    auto& res = *(res_ref.get());
+    auto all_metadata = get_local_impl()->metadata();
+    auto& functions = get_local_impl()->functions();
+    res.epoch = get_local_impl()->epoch();
+    // the metadata is sorted by family name, so a window is a
+    // contiguous slice of it
+    auto begin = std::lower_bound(all_metadata->begin(), all_metadata->end(), start_family,
+            [](const metric_family_metadata& mf, const sstring& name) {
+        return mf.mf.name < name;
+    });
+    auto end = (size_t(all_metadata->end() - begin) > max_families) ? begin + max_families : all_metadata->end();
+    if (end != all_metadata->end()) {
+        res.next_window = end->mf.name;
+    }
+    auto window = ::seastar::make_shared<metric_metadata>(begin, end);
+    res.values.reserve(end - begin);
+    for (auto i = begin; i != end; ++i) {
+        auto& family_functions = functions[i - all_metadata->begin()];
+        value_vector values;
+        values.reserve(family_functions.size());
+        for (auto&& v : family_functions) {
+            values.emplace_back(v());
+        }
+        res.values.emplace_back(std::move(values));
+    }
+    res.metadata = std::move(window);
     return res_ref;
 }
 
@@ -326,6 +392,79 @@ std::vector<std::vector<metric_function>>& impl::functions() {
     return _current_metrics;
 }
 
+bool impl::apply_relabel_rules(const sstring& full_name, labels_type& labels) const {
+    for (auto& rule : _relabel_rules) {
+        std::string source;
+        const char* delimiter = "";
+        for (auto& l : rule.cfg.source_labels) {
+            source += delimiter;
+            if (l == "__name__") {
+                source += full_name;
+            } else if (auto i = labels.find(l); i != labels.end()) {
+                source += i->second;
+            }
+            delimiter = ";";
+        }
+        std::smatch match;
+        bool matched = std::regex_match(source, match, rule.expr);
+        switch (rule.cfg.action) {
+        case relabel_config::relabel_action::drop:
+            if (matched) {
+                return false;
+            }
+            break;
+        case relabel_config::relabel_action::keep:
+            if (!matched) {
+                return false;
+            }
+            break;
+        case relabel_config::relabel_action::replace:
+            if (matched) {
+                labels[rule.cfg.target_label] = sstring(match.format(std::string(rule.cfg.replacement)));
+            }
+            break;
+        case relabel_config::relabel_action::drop_label:
+            if (matched) {
+                labels.erase(rule.cfg.target_label);
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+void impl::set_relabel_configs(const std::vector<relabel_config>& configs) {
+    std::vector<relabel_rule> rules;
+    rules.reserve(configs.size());
+    for (auto& c : configs) {
+        // may throw std::regex_error, leaving the current rules untouched
+        rules.push_back(relabel_rule{c, std::regex(c.expr.c_str())});
+    }
+    _relabel_rules = std::move(rules);
+    // Re-evaluate the filtering actions for series that already exist.
+    // Their owners hold the ids they registered with, so labels can not be
+    // rewritten retroactively; filtered series are disabled instead of
+    // removed, which takes them out of the scrape and lets a later rule
+    // change restore them.
+    for (auto& family : _value_map) {
+        for (auto& m : family.second) {
+            labels_type labels = m.first;
+            bool kept = apply_relabel_rules(family.first, labels);
+            m.second->set_enabled(kept && m.second->enabled_by_definition());
+        }
+    }
+    dirty();
+}
+
+std::vector<relabel_config> impl::get_relabel_configs() const {
+    std::vector<relabel_config> res;
+    res.reserve(_relabel_rules.size());
+    for (auto& rule : _relabel_rules) {
+        res.push_back(rule.cfg);
+    }
+    return res;
+}
+
 void impl::add_registration(const metric_id& id, const metric_type& type, metric_function f, const description& d, bool enabled) {
     auto rm = ::seastar::make_shared<registered_metric>(id, f, enabled);
     sstring name = id.full_name();
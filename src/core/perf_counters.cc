@@ -0,0 +1,144 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <seastar/core/internal/perf_counters.hh>
+#include <seastar/util/log.hh>
+
+#include <atomic>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace seastar {
+
+extern logger seastar_logger;
+
+namespace internal {
+
+bool
+hw_perf_counters::counter::open(uint64_t config) noexcept {
+    perf_event_attr attr = {};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    // user-mode events of this thread only; counting (not sampling), so
+    // the only overhead is the PMU slot
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd == -1) {
+        return false;
+    }
+    page = ::mmap(nullptr, getpagesize(), PROT_READ, MAP_SHARED, fd, 0);
+    if (page == MAP_FAILED) {
+        page = nullptr;
+        close();
+        return false;
+    }
+    auto pc = reinterpret_cast<perf_event_mmap_page*>(page);
+    if (!pc->cap_user_rdpmc) {
+        // reading through the fd on every task switch would defeat the
+        // purpose; treat the counter as unavailable
+        close();
+        return false;
+    }
+    return true;
+}
+
+void
+hw_perf_counters::counter::close() noexcept {
+    if (page) {
+        ::munmap(page, getpagesize());
+        page = nullptr;
+    }
+    if (fd != -1) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+uint64_t
+hw_perf_counters::counter::read() const noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    auto pc = reinterpret_cast<perf_event_mmap_page*>(page);
+    uint32_t seq;
+    uint64_t count;
+    // the kernel updates index/offset when the event is rescheduled;
+    // the seqlock makes the pair consistent with the rdpmc read
+    do {
+        seq = pc->lock;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        auto idx = pc->index;
+        count = pc->offset;
+        if (idx) {
+            uint64_t pmc = __builtin_ia32_rdpmc(idx - 1);
+            // the pmc is pmc_width bits wide; sign-extend so that offset,
+            // which the kernel keeps in the same truncated arithmetic,
+            // sums to the full value
+            auto shift = 64 - pc->pmc_width;
+            count += uint64_t(int64_t(pmc << shift) >> shift);
+        }
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    } while (pc->lock != seq);
+    return count;
+#else
+    return 0;
+#endif
+}
+
+bool
+hw_perf_counters::enable() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    if (_enabled) {
+        return true;
+    }
+    if (_cycles.open(PERF_COUNT_HW_CPU_CYCLES)
+            && _instructions.open(PERF_COUNT_HW_INSTRUCTIONS)
+            && _llc_misses.open(PERF_COUNT_HW_CACHE_MISSES)) {
+        _enabled = true;
+        return true;
+    }
+    seastar_logger.warn("could not enable hardware performance counters: {}", strerror(errno));
+    _cycles.close();
+    _instructions.close();
+    _llc_misses.close();
+    return false;
+#else
+    return false;
+#endif
+}
+
+hw_perf_counters::~hw_perf_counters() {
+    _cycles.close();
+    _instructions.close();
+    _llc_misses.close();
+}
+
+hw_perf_counters::sample
+hw_perf_counters::read() const noexcept {
+    if (!_enabled) {
+        return {};
+    }
+    return {_cycles.read(), _instructions.read(), _llc_misses.read()};
+}
+
+}
+}
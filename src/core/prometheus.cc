@@ -23,7 +23,9 @@
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include "proto/metrics2.pb.h"
+#include <charconv>
 #include <sstream>
+#include <string_view>
 
 #include <seastar/core/scollectd_api.hh>
 #include "core/scollectd-impl.hh"
@@ -84,7 +86,7 @@ static pm::Metric* add_label(pm::Metric* mt, const metrics::impl::metric_id & id
     }
     for (auto &&i : id.labels()) {
         auto label = mt->add_label();
-        label->set_name(i.first);
+        label->set_name(i.first.str());
         label->set_value(i.second);
     }
     return mt;
@@ -140,37 +142,90 @@ static std::string to_str(seastar::metrics::impl::data_type dt) {
     return "untyped";
 }
 
-static std::string to_str(const seastar::metrics::impl::metric_value& v) {
+/*!
+ * \brief accumulates exposition text and flushes it to the stream in chunks
+ *
+ * One scrape reuses a single buffer for the whole exposition: text is
+ * appended in place, numbers go through to_chars, and whenever the buffer
+ * grows past the chunk size it is handed to the stream and its allocation
+ * recycled. Must be used inside a seastar thread.
+ */
+class text_writer {
+    static constexpr size_t chunk_size = 32 * 1024;
+    output_stream<char>& _out;
+    // std::string, not sstring: the buffer needs cheap in-place append
+    // (reserve/push_back/clear) and is never handed out whole
+    std::string _buf;
+public:
+    explicit text_writer(output_stream<char>& out) : _out(out) {
+        _buf.reserve(chunk_size);
+    }
+
+    void append(std::string_view s) {
+        _buf.append(s.data(), s.size());
+    }
+
+    void append(char c) {
+        _buf.push_back(c);
+    }
+
+    template <typename T>
+    void append_value(T v) {
+        char tmp[64];
+        auto r = std::to_chars(tmp, tmp + sizeof(tmp), v);
+        _buf.append(tmp, r.ptr - tmp);
+    }
+
+    void maybe_flush() {
+        if (_buf.size() >= chunk_size) {
+            flush();
+        }
+    }
+
+    void flush() {
+        _out.write(_buf.data(), _buf.size()).get();
+        _buf.clear();
+    }
+};
+
+static void add_value(text_writer& s, const seastar::metrics::impl::metric_value& v) {
     switch (v.type()) {
     case seastar::metrics::impl::data_type::GAUGE:
-        return std::to_string(v.d());
+        s.append_value(v.d());
+        break;
     case seastar::metrics::impl::data_type::COUNTER:
-        return std::to_string(v.i());
+        s.append_value(v.i());
+        break;
     case seastar::metrics::impl::data_type::DERIVE:
-        return std::to_string(v.ui());
-    default:
+        s.append_value(v.ui());
         break;
+    default:
+        break; // we should never get here
     }
-    return ""; // we should never get here but it makes the compiler happy
 }
 
-static void add_name(std::ostream& s, const sstring& name, const std::map<sstring, sstring>& labels, const config& ctx) {
-    s << name << "{";
+// The labels of a metric name, rendered once per metric: "{a=\"1\",b=\"2\""
+// without the closing brace, so per-bucket labels can still be appended.
+static sstring make_label_prefix(const metrics::impl::labels_type& labels, const config& ctx) {
+    sstring res = "{";
     const char* delimiter = "";
     if (ctx.label) {
-        s << ctx.label->key()  << "=\"" << ctx.label->value() << '"';
+        res += ctx.label->key() + "=\"" + ctx.label->value() + "\"";
         delimiter = ",";
     }
-
-    if (!labels.empty()) {
-        for (auto l : labels) {
-            s << delimiter;
-            s << l.first  << "=\"" << l.second << '"';
-            delimiter = ",";
-        }
+    for (auto& l : labels) {
+        res += delimiter;
+        res += l.first.str() + "=\"" + l.second + "\"";
+        delimiter = ",";
     }
-    s << "} ";
+    return res;
+}
 
+static void add_name(text_writer& s, const sstring& name, const sstring& suffix, const sstring& label_prefix) {
+    s.append(name);
+    s.append(suffix);
+    s.append(label_prefix);
+    s.append("} ");
 }
 
 /*!
@@ -299,11 +354,12 @@ public:
     /** @} */
 };
 
-static future<> get_map_value(metrics_families_per_shard& vec) {
+static future<> get_map_value(metrics_families_per_shard& vec, sstring start, size_t max_families) {
     vec.resize(smp::count);
-    return parallel_for_each(boost::irange(0u, smp::count), [&vec] (auto cpu) {
-        return smp::submit_to(cpu, [] {
-            return mi::get_values();
+    return parallel_for_each(boost::irange(0u, smp::count), [&vec, start = std::move(start), max_families] (auto cpu) {
+        return smp::submit_to(cpu, [start, max_families] {
+            // 0 disables the windowing and gathers everything at once
+            return max_families ? mi::get_values(start, max_families) : mi::get_values();
         }).then([&vec, cpu] (auto res) {
             vec[cpu] = std::move(res);
         });
@@ -564,52 +620,86 @@ metric_family_range get_range(const metrics_families_per_shard& mf, const sstrin
 
 }
 
+/*!
+ * \brief the part of a gathered window of metric families that is ready
+ * to be written out.
+ *
+ * The window was gathered starting at family \c start; families at or
+ * past \c window_end were left out of it by at least one shard, so they
+ * belong to a later window. An empty \c window_end means no shard left
+ * anything out and the range extends to the end of the window.
+ */
+static metric_family_range get_window_range(const metrics_families_per_shard& mf, const sstring& start, const sstring& window_end) {
+    auto b = mf.lower_bound(start);
+    if (window_end.empty()) {
+        return metric_family_range(b, metric_family_iterator(mf, 0));
+    }
+    return metric_family_range(b, mf.lower_bound(window_end));
+}
+
 future<> write_text_representation(output_stream<char>& out, const config& ctx, const metric_family_range& m) {
     return seastar::async([&ctx, &out, &m] () mutable {
+        text_writer s(out);
         bool found = false;
         for (metric_family& metric_family : m) {
             auto name = ctx.prefix + "_" + metric_family.name();
             found = false;
-            metric_family.foreach_metric([&out, &ctx, &found, &name, &metric_family](auto value, auto value_info) mutable {
-                std::stringstream s;
+            metric_family.foreach_metric([&s, &ctx, &found, &name, &metric_family](auto value, auto value_info) mutable {
                 if (!found) {
                     if (metric_family.metadata().d.str() != "") {
-                        s << "# HELP " << name << " " <<  metric_family.metadata().d.str() << "\n";
+                        s.append("# HELP ");
+                        s.append(name);
+                        s.append(' ');
+                        s.append(metric_family.metadata().d.str());
+                        s.append('\n');
                     }
-                    s << "# TYPE " << name << " " << to_str(metric_family.metadata().type) << "\n";
+                    s.append("# TYPE ");
+                    s.append(name);
+                    s.append(' ');
+                    s.append(to_str(metric_family.metadata().type));
+                    s.append('\n');
                     found = true;
                 }
+                auto label_prefix = make_label_prefix(value_info.id.labels(), ctx);
                 if (value.type() == mi::data_type::HISTOGRAM) {
                     auto&& h = value.get_histogram();
-                    std::map<sstring, sstring> labels = value_info.id.labels();
-                    add_name(s, name + "_sum", labels, ctx);
-                    s << h.sample_sum;
-                    s << "\n";
-                    add_name(s, name + "_count", labels, ctx);
-                    s << h.sample_count;
-                    s << "\n";
-
-                    auto& le = labels["le"];
-                    auto bucket = name + "_bucket";
-                    for (auto  i : h.buckets) {
-                         le = std::to_string(i.upper_bound);
-                        add_name(s, bucket, labels, ctx);
-                        s << i.count;
-                        s << "\n";
+                    add_name(s, name, "_sum", label_prefix);
+                    s.append_value(h.sample_sum);
+                    s.append('\n');
+                    add_name(s, name, "_count", label_prefix);
+                    s.append_value(h.sample_count);
+                    s.append('\n');
+
+                    // the buckets only differ in the "le" label, appended
+                    // after the prefix rendered above
+                    const char* delimiter = value_info.id.labels().empty() && !ctx.label ? "le=\"" : ",le=\"";
+                    for (auto i : h.buckets) {
+                        s.append(name);
+                        s.append("_bucket");
+                        s.append(label_prefix);
+                        s.append(delimiter);
+                        s.append_value(i.upper_bound);
+                        s.append("\"} ");
+                        s.append_value(i.count);
+                        s.append('\n');
                     }
-                    labels["le"] = "+Inf";
-                    add_name(s, bucket, labels, ctx);
-                    s << h.sample_count;
-                    s << "\n";
+                    s.append(name);
+                    s.append("_bucket");
+                    s.append(label_prefix);
+                    s.append(delimiter);
+                    s.append("+Inf\"} ");
+                    s.append_value(h.sample_count);
+                    s.append('\n');
                 } else {
-                    add_name(s, name, value_info.id.labels(), ctx);
-                    s << to_str(value);
-                    s << "\n";
+                    add_name(s, name, "", label_prefix);
+                    add_value(s, value);
+                    s.append('\n');
                 }
-                out.write(s.str()).get();
+                s.maybe_flush();
                 thread::maybe_yield();
             });
         }
+        s.flush();
     });
 }
 
@@ -677,15 +767,61 @@ public:
         auto text = is_accept_text(req->get_header("Accept"));
         sstring metric_family_name = req->get_query_param("name");
         bool prefix = trim_asterisk(metric_family_name);
+        bool exact = !prefix && !metric_family_name.empty();
+        // with a prefix query the gathering can stop once the cursor
+        // moves past the names sharing the prefix
+        sstring stop_at;
+        if (prefix && !metric_family_name.empty()) {
+            stop_at = metric_family_name;
+            ++stop_at.back();
+        }
 
-        rep->write_body((text) ? "txt" : "proto", [this, text, metric_family_name, prefix] (output_stream<char>&& s) {
-            return do_with(metrics_families_per_shard(), output_stream<char>(std::move(s)),
-                    [this, text, prefix, &metric_family_name] (metrics_families_per_shard& families, output_stream<char>& s) mutable {
-                return get_map_value(families).then([&s, &families, this, text, prefix, &metric_family_name]() mutable {
-                    return do_with(get_range(families, metric_family_name, prefix),
-                            [&s, this, text](metric_family_range& m) {
-                        return (text) ? write_text_representation(s, _ctx, m) :
-                                write_protobuf_representation(s, _ctx, m);
+        rep->write_body((text) ? "txt" : "proto", [this, text, exact, stop_at, metric_family_name] (output_stream<char>&& s) {
+            // The families are gathered and written out in bounded
+            // windows: the next window is snapshotted from the shards
+            // only after the previous one was flushed to the scraper,
+            // so the peak memory of a scrape stays capped no matter how
+            // slowly the response is consumed.
+            return do_with(output_stream<char>(std::move(s)), sstring(metric_family_name), false,
+                    [this, text, exact, stop_at] (output_stream<char>& s, sstring& start, bool& done) {
+                return do_until([&done] { return done; }, [this, text, exact, &stop_at, &s, &start, &done] () mutable {
+                    return do_with(metrics_families_per_shard(), [this, text, exact, &stop_at, &s, &start, &done] (metrics_families_per_shard& families) mutable {
+                        return get_map_value(families, start, _ctx.metric_families_per_chunk).then(
+                                [this, text, exact, &stop_at, &s, &start, &done, &families] () mutable {
+                            // the first family some shard left out of its
+                            // window; families before it are complete on
+                            // every shard, later ones wait for the next
+                            // window
+                            sstring next;
+                            for (auto&& shard_families : families) {
+                                const sstring& left_out = shard_families->next_window;
+                                if (!left_out.empty() && (next.empty() || left_out < next)) {
+                                    next = left_out;
+                                }
+                            }
+                            sstring window_end = next;
+                            if (exact) {
+                                // the requested family is the first in the
+                                // window, so one window covers it
+                                done = true;
+                            } else if (stop_at.empty()) {
+                                done = next.empty();
+                            } else {
+                                if (window_end.empty() || stop_at < window_end) {
+                                    window_end = stop_at;
+                                }
+                                done = next.empty() || !(next < stop_at);
+                            }
+                            auto m = exact ? get_range(families, start, false)
+                                           : get_window_range(families, start, window_end);
+                            start = std::move(next);
+                            return do_with(std::move(m), [&s, this, text] (metric_family_range& m) {
+                                return (text) ? write_text_representation(s, _ctx, m) :
+                                        write_protobuf_representation(s, _ctx, m);
+                            }).then([&s] () mutable {
+                                return s.flush();
+                            });
+                        });
                     });
                 }).finally([&s] () mutable {
                     return s.close();
@@ -25,6 +25,7 @@
 #include <sys/syscall.h>
 #include <sys/vfs.h>
 #include <sys/statfs.h>
+#include <sys/sysmacros.h>
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <sys/inotify.h>
@@ -35,6 +36,7 @@
 #include <seastar/net/packet.hh>
 #include <seastar/net/stack.hh>
 #include <seastar/net/posix-stack.hh>
+#include <seastar/net/shm-stack.hh>
 #include <seastar/net/native-stack.hh>
 #include <seastar/core/resource.hh>
 #include <seastar/core/print.hh>
@@ -52,6 +54,7 @@
 #include <seastar/core/io_queue.hh>
 #include <seastar/core/internal/io_desc.hh>
 #include <seastar/core/internal/buffer_allocator.hh>
+#include <seastar/core/internal/hugepage_text.hh>
 #include <seastar/core/scheduling_specific.hh>
 #include <seastar/util/log.hh>
 #include "core/file-impl.hh"
@@ -66,6 +69,8 @@
 #include <fcntl.h>
 #include <sys/eventfd.h>
 #include <sys/poll.h>
+#include <netinet/tcp.h>
+#include <linux/filter.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/thread/barrier.hpp>
 #include <boost/algorithm/string/classification.hpp>
@@ -104,6 +109,11 @@
 
 #ifdef SEASTAR_SHUFFLE_TASK_QUEUE
 #include <random>
+#include <thread>
+#endif
+
+#ifdef SEASTAR_HAVE_NUMA
+#include <numaif.h>
 #endif
 
 #include <sys/mman.h>
@@ -145,6 +155,10 @@ struct mountpoint_params {
     uint64_t write_bytes_rate = std::numeric_limits<uint64_t>::max();
     uint64_t read_req_rate = std::numeric_limits<uint64_t>::max();
     uint64_t write_req_rate = std::numeric_limits<uint64_t>::max();
+    // Physical devices behind the mountpoint (RAID members) and the
+    // array's chunk size; see io_queue::config::nr_member_devices.
+    unsigned nr_member_devices = 1;
+    uint64_t member_stripe_size = 128 << 10;
 };
 
 }
@@ -159,6 +173,12 @@ struct convert<seastar::mountpoint_params> {
         mp.read_req_rate = parse_memory_size(node["read_iops"].as<std::string>());
         mp.write_bytes_rate = parse_memory_size(node["write_bandwidth"].as<std::string>());
         mp.write_req_rate = parse_memory_size(node["write_iops"].as<std::string>());
+        if (node["member_devices"]) {
+            mp.nr_member_devices = node["member_devices"].as<unsigned>();
+        }
+        if (node["member_stripe_size"]) {
+            mp.member_stripe_size = parse_memory_size(node["member_stripe_size"].as<std::string>());
+        }
         return true;
     }
 };
@@ -459,6 +479,38 @@ future<size_t> pollable_fd_state::sendmsg(struct msghdr* msg) {
     });
 }
 
+future<unsigned> pollable_fd_state::sendmmsg(struct mmsghdr* msgs, unsigned n) {
+    maybe_no_more_send();
+    return engine().writeable(*this).then([this, msgs, n] {
+        auto r = fd.sendmmsg(msgs, n, 0);
+        if (!r) {
+            return sendmmsg(msgs, n);
+        }
+        // See the comment about speculation in sendmsg(); only a fully
+        // transmitted batch hints that there is room for more.
+        if (*r == n) {
+            speculate_epoll(EPOLLOUT);
+        }
+        return make_ready_future<unsigned>(*r);
+    });
+}
+
+future<unsigned> pollable_fd_state::recvmmsg(struct mmsghdr* msgs, unsigned n) {
+    maybe_no_more_recv();
+    return engine().readable(*this).then([this, msgs, n] {
+        auto r = fd.recvmmsg(msgs, n, 0);
+        if (!r) {
+            return recvmmsg(msgs, n);
+        }
+        // A full batch suggests more datagrams are already queued; see the
+        // speculation comment in recvmsg().
+        if (*r == n) {
+            speculate_epoll(EPOLLIN);
+        }
+        return make_ready_future<unsigned>(*r);
+    });
+}
+
 future<size_t> pollable_fd_state::sendto(socket_address addr, const void* buf, size_t len) {
     maybe_no_more_send();
     return engine().writeable(*this).then([this, buf, len, addr] () mutable {
@@ -572,6 +624,10 @@ lowres_clock_impl::lowres_clock_impl() {
 }
 
 void lowres_clock_impl::update() noexcept {
+    // single periodic caller on the thread that owns the lowres timer,
+    // which is what tsc_clock calibration requires
+    internal::tsc_clock::maybe_recalibrate();
+
     auto const steady_count =
             std::chrono::duration_cast<steady_duration>(base_steady_clock::now().time_since_epoch()).count();
 
@@ -865,6 +921,45 @@ reactor::task_queue::register_stats() {
                 return _time_spent_on_task_quota_violations / 1ms;
         }, sm::description("Total amount in milliseconds we were in violation of the task quota"),
            {group_label}),
+        sm::make_gauge("queue_length_hwm", [this] { return _queue_length_hwm; },
+                sm::description("Highest backlog seen on this queue since startup, in tasks; a high watermark far above queue_length points at bursts"),
+                {group_label}),
+        sm::make_histogram("time_to_first_run", [this] { return _time_to_first_run.to_histogram(1e-6); },
+                sm::description("Histogram of the delay, in seconds, between this queue becoming runnable and its first task running; long delays mean other groups crowd this one out"),
+                {group_label}),
+        sm::make_gauge("shares_fraction", [this] {
+            float total = 0;
+            for (auto&& tq : engine()._task_queues) {
+                total += tq->_shares;
+            }
+            return _shares / total;
+        }, sm::description("This queue's fraction of the total shares; compare with runtime_fraction to see whether the group consumes more or less cpu than allotted"),
+           {group_label}),
+        sm::make_gauge("runtime_fraction", [this] {
+            auto total = sched_clock::duration{};
+            for (auto&& tq : engine()._task_queues) {
+                total += tq->_runtime;
+            }
+            return total.count() ? double(_runtime.count()) / total.count() : 0.;
+        }, sm::description("This queue's fraction of the accumulated runtime of all queues; compare with shares_fraction to see whether the group consumes more or less cpu than allotted"),
+           {group_label}),
+        sm::make_derive("cpu_cycles", [this] { return _hw_events.cycles; },
+                sm::description("CPU cycles spent running this queue's tasks; requires --scheduling-group-counters"),
+                {group_label}),
+        sm::make_derive("instructions", [this] { return _hw_events.instructions; },
+                sm::description("Instructions retired by this queue's tasks; requires --scheduling-group-counters"),
+                {group_label}),
+        sm::make_derive("llc_misses", [this] { return _hw_events.llc_misses; },
+                sm::description("Last-level-cache misses incurred by this queue's tasks; requires --scheduling-group-counters"),
+                {group_label}),
+        sm::make_gauge("instructions_per_cycle", [this] {
+            return _hw_events.cycles ? double(_hw_events.instructions) / _hw_events.cycles : 0.;
+        }, sm::description("Lifetime instructions-per-cycle of this queue's tasks; a low value relative to other groups points at cache- or memory-bound work"),
+           {group_label}),
+        sm::make_gauge("llc_misses_per_kilo_instruction", [this] {
+            return _hw_events.instructions ? 1000. * _hw_events.llc_misses / _hw_events.instructions : 0.;
+        }, sm::description("Lifetime last-level-cache misses per thousand instructions of this queue's tasks; high values indicate the group's working set does not fit in cache"),
+           {group_label}),
     });
     _metrics = std::exchange(new_metrics, {});
 }
@@ -928,6 +1023,7 @@ reactor::reactor(unsigned id, reactor_backend_selector rbs, reactor_config cfg)
 #endif
     , _cpu_started(0)
     , _cpu_stall_detector(std::make_unique<cpu_stall_detector>())
+    , _cpu_profiler(std::make_unique<cpu_profiler>())
     , _reuseport(posix_reuseport_detect())
     , _thread_pool(std::make_unique<thread_pool>(this, seastar::format("syscall-{}", id))) {
     /*
@@ -950,6 +1046,7 @@ reactor::reactor(unsigned id, reactor_backend_selector rbs, reactor_config cfg)
     sigset_t mask;
     sigemptyset(&mask);
     sigaddset(&mask, cpu_stall_detector::signal_number());
+    sigaddset(&mask, cpu_profiler::signal_number());
     auto r = ::pthread_sigmask(SIG_UNBLOCK, &mask, NULL);
     assert(r == 0);
 #endif
@@ -964,6 +1061,7 @@ reactor::~reactor() {
     sigset_t mask;
     sigemptyset(&mask);
     sigaddset(&mask, cpu_stall_detector::signal_number());
+    sigaddset(&mask, cpu_profiler::signal_number());
     auto r = ::pthread_sigmask(SIG_BLOCK, &mask, NULL);
     assert(r == 0);
 
@@ -1173,6 +1271,93 @@ void cpu_stall_detector::start_sleep() {
 void cpu_stall_detector::end_sleep() {
 }
 
+cpu_profiler::cpu_profiler() {
+    struct sigevent sev = {};
+    sev.sigev_notify = SIGEV_THREAD_ID;
+    sev.sigev_signo = signal_number();
+    sev._sigev_un._tid = syscall(SYS_gettid);
+    int err = timer_create(CLOCK_THREAD_CPUTIME_ID, &sev, &_timer);
+    if (err) {
+        throw std::system_error(std::error_code(err, std::system_category()));
+    }
+    _samples = std::make_unique<sample[]>(nr_slots);
+}
+
+cpu_profiler::~cpu_profiler() {
+    timer_delete(_timer);
+}
+
+void cpu_profiler::enable(std::chrono::nanoseconds period) {
+    _period = std::max(period, std::chrono::nanoseconds(100us));
+    _enabled = true;
+    auto its = posix::to_relative_itimerspec(_period, _period);
+    timer_settime(_timer, 0, &its, nullptr);
+}
+
+void cpu_profiler::disable() {
+    _enabled = false;
+    auto its = posix::to_relative_itimerspec(0s, 0s);
+    timer_settime(_timer, 0, &its, nullptr);
+}
+
+// Runs in signal context, so only the fixed-size stack walk the stall
+// detector also performs, plus one update of preallocated table state.
+void cpu_profiler::on_signal() {
+    frame frames[max_depth];
+    unsigned depth = 0;
+    uint64_t hash = 0;
+    backtrace([&] (frame f) noexcept {
+        if (depth < max_depth) {
+            frames[depth++] = f;
+            hash ^= f.addr + reinterpret_cast<uintptr_t>(f.so) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+    });
+    ++_total_samples;
+    auto& s = _samples[hash % nr_slots];
+    if (s.count != 0 && s.hash == hash) {
+        ++s.count;
+        return;
+    }
+    if (s.count != 0 && --s.count != 0) {
+        // the incumbent stack outvotes this one for now
+        ++_evicted_samples;
+        return;
+    }
+    s.hash = hash;
+    s.count = 1;
+    s.depth = depth;
+    std::copy_n(frames, depth, s.frames);
+}
+
+sstring cpu_profiler::dump_collapsed() const {
+    // keep the handler from mutating the table mid-read
+    sigset_t mask, prev;
+    sigemptyset(&mask);
+    sigaddset(&mask, signal_number());
+    ::pthread_sigmask(SIG_BLOCK, &mask, &prev);
+    sstring out;
+    for (size_t i = 0; i < nr_slots; i++) {
+        const sample& s = _samples[i];
+        if (s.count == 0) {
+            continue;
+        }
+        // collapsed format wants the outermost frame first; the walk
+        // produced them innermost first
+        for (unsigned j = s.depth; j-- > 0;) {
+            const frame& f = s.frames[j];
+            if (!f.so->name.empty()) {
+                out += f.so->name;
+                out += "+";
+            }
+            fmt::format_to(std::back_inserter(out), "0x{:x}", f.addr);
+            out += j == 0 ? " " : ";";
+        }
+        fmt::format_to(std::back_inserter(out), "{}\n", s.count);
+    }
+    ::pthread_sigmask(SIG_SETMASK, &prev, nullptr);
+    return out;
+}
+
 void
 reactor::update_blocked_reactor_notify_ms(std::chrono::milliseconds ms) {
     auto cfg = _cpu_stall_detector->get_config();
@@ -1206,6 +1391,16 @@ reactor::block_notifier(int) {
     engine()._cpu_stall_detector->on_signal();
 }
 
+void
+reactor::profiler_notifier(int) {
+    engine()._cpu_profiler->on_signal();
+}
+
+internal::cpu_profiler&
+reactor::profiler() noexcept {
+    return *_cpu_profiler;
+}
+
 void
 cpu_stall_detector::generate_trace() {
     auto delta = std::chrono::steady_clock::now() - _run_started_at;
@@ -1324,6 +1519,10 @@ void reactor::configure(boost::program_options::variables_map vm) {
     _handle_sigint = !vm.count("no-handle-interrupt");
     auto task_quota = vm["task-quota-ms"].as<double>() * 1ms;
     _task_quota = std::chrono::duration_cast<sched_clock::duration>(task_quota);
+    _effective_task_quota = _task_quota;
+    _adaptive_task_quota = vm["adaptive-task-quota"].as<bool>();
+    _overload_threshold = std::chrono::duration_cast<sched_clock::duration>(vm["overload-threshold-ms"].as<double>() * 1ms);
+    _enable_hw_counters = vm["scheduling-group-counters"].as<bool>();
 
     auto blocked_time = vm["blocked-reactor-notify-ms"].as<unsigned>() * 1ms;
     cpu_stall_detector_config csdc;
@@ -1352,6 +1551,7 @@ void reactor::configure(boost::program_options::variables_map vm) {
     _force_io_getevents_syscall = vm["force-aio-syscalls"].as<bool>();
     aio_nowait_supported = vm["linux-aio-nowait"].as<bool>();
     _have_aio_fsync = vm["aio-fsync"].as<bool>();
+    _thread_pool->set_concurrency(vm["blocking-syscall-threads"].as<unsigned>());
 }
 
 pollable_fd
@@ -1382,8 +1582,34 @@ reactor::posix_listen(socket_address sa, listen_options opts) {
     if (opts.reuse_address) {
         fd.setsockopt(SOL_SOCKET, SO_REUSEADDR, 1);
     }
-    if (_reuseport && !sa.is_af_unix())
+    if (_reuseport && !sa.is_af_unix()) {
         fd.setsockopt(SOL_SOCKET, SO_REUSEPORT, 1);
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+        // Steer each new connection to the reuseport listener whose group
+        // index matches the cpu its packets are processed on, so the
+        // accepting shard shares a core with the NIC RSS queue and packets
+        // do not cross cpus. Index and cpu line up because every shard
+        // opens its listener in shard order.
+        static struct sock_filter cpu_filter[] = {
+            { BPF_LD | BPF_W | BPF_ABS, 0, 0, uint32_t(SKF_AD_OFF + SKF_AD_CPU) },
+            { BPF_RET | BPF_A, 0, 0, 0 },
+        };
+        struct sock_fprog prog = { 2, cpu_filter };
+        try {
+            fd.setsockopt(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, socklen_t(sizeof(prog)));
+        } catch (std::system_error&) {
+            // Just an optimization; old kernels do fine without it.
+        }
+#endif
+    }
+    if (!sa.is_af_unix() && opts.proto == transport::TCP) {
+        if (opts.fastopen_queue_depth) {
+            fd.setsockopt(IPPROTO_TCP, TCP_FASTOPEN, opts.fastopen_queue_depth);
+        }
+        if (opts.defer_accept_timeout.count()) {
+            fd.setsockopt(IPPROTO_TCP, TCP_DEFER_ACCEPT, int(opts.defer_accept_timeout.count()));
+        }
+    }
 
     try {
         fd.bind(sa.u.sa, sa.length());
@@ -1392,7 +1618,13 @@ reactor::posix_listen(socket_address sa, listen_options opts) {
         throw std::system_error(s.code(), fmt::format("posix_listen failed for address {}", sa));
     }
 
-    return pollable_fd(std::move(fd));
+    auto pfd = pollable_fd(std::move(fd));
+    if (!_reuseport) {
+        // Without SO_REUSEPORT every shard may end up polling the same
+        // listening socket; let the backend wake only one per connection.
+        pfd.set_exclusive_wakeups();
+    }
+    return pfd;
 }
 
 bool
@@ -1434,6 +1666,11 @@ pollable_fd::pollable_fd(file_desc fd, pollable_fd::speculation speculate)
     : _s(engine()._backend->make_pollable_fd_state(std::move(fd), speculate))
 {}
 
+file_desc pollable_fd::detach() {
+    engine()._backend->detach(*_s);
+    return std::move(_s->fd);
+}
+
 void pollable_fd::shutdown(int how) {
     engine()._backend->shutdown(*_s, how);
 }
@@ -1599,11 +1836,20 @@ size_t sanitize_iovecs(std::vector<iovec>& iov, size_t disk_alignment) noexcept
 
 }
 
+void reactor::register_storage_file(int fd) noexcept {
+    _backend->register_storage_file(fd);
+}
+
+void reactor::unregister_storage_file(int fd) noexcept {
+    _backend->unregister_storage_file(fd);
+}
+
 future<file>
 reactor::open_file_dma(std::string_view nameref, open_flags flags, file_open_options options) noexcept {
     return do_with(static_cast<int>(flags), std::move(options), [this, nameref] (auto& open_flags, file_open_options& options) {
         sstring name(nameref);
-        return _thread_pool->submit<syscall_result<int>>([this, name, &open_flags, &options, strict_o_direct = _strict_o_direct, bypass_fsync = _bypass_fsync] () mutable {
+        auto open_slow = [this, name, &open_flags, &options] {
+          return _thread_pool->submit<syscall_result<int>>([this, name, &open_flags, &options, strict_o_direct = _strict_o_direct, bypass_fsync = _bypass_fsync] () mutable {
             // We want O_DIRECT, except in three cases:
             //   - tmpfs (which doesn't support it, but works fine anyway)
             //   - strict_o_direct == false (where we forgive it being not supported)
@@ -1646,7 +1892,30 @@ reactor::open_file_dma(std::string_view nameref, open_flags flags, file_open_opt
                 ::ioctl(fd, XFS_IOC_FSSETXATTR, &attr);
             }
             return wrap_syscall<int>(fd);
-        }).then([&options, name = std::move(name), &open_flags] (syscall_result<int> sr) {
+          });
+        };
+        future<syscall_result<int>> open_done = make_ready_future<syscall_result<int>>(syscall_result<int>(-1, 0));
+        if (_backend->supports_async_metadata() && !options.extent_allocation_size_hint) {
+            // Fast path: submit the open through the backend, with O_DIRECT up
+            // front rather than upgrading via fcntl() afterwards. If it fails
+            // for any reason (e.g. O_DIRECT on tmpfs) retry on the thread pool,
+            // which knows which failures to forgive.
+            open_flags |= O_CLOEXEC;
+            if (_bypass_fsync) {
+                open_flags &= ~O_DSYNC;
+            }
+            auto async_flags = open_flags | (_kernel_page_cache ? 0 : O_DIRECT);
+            auto mode = static_cast<mode_t>(options.create_permissions);
+            open_done = _backend->submit_openat(name, async_flags, mode).then([open_slow] (ssize_t fd) {
+                if (fd >= 0) {
+                    return make_ready_future<syscall_result<int>>(syscall_result<int>(static_cast<int>(fd), 0));
+                }
+                return open_slow();
+            });
+        } else {
+            open_done = open_slow();
+        }
+        return open_done.then([&options, name = std::move(name), &open_flags] (syscall_result<int> sr) {
             sr.throw_fs_exception_if_error("open failed", name);
             return make_file_impl(sr.result, options, open_flags);
         }).then([] (shared_ptr<file_impl> impl) {
@@ -1771,8 +2040,38 @@ timespec_to_time_point(const timespec& ts) {
     return std::chrono::system_clock::time_point(d);
 }
 
+using statx_struct = struct ::statx;
+
+static struct stat statx_to_stat(const statx_struct& sx) noexcept {
+    struct stat st = {};
+    st.st_dev = makedev(sx.stx_dev_major, sx.stx_dev_minor);
+    st.st_ino = sx.stx_ino;
+    st.st_mode = sx.stx_mode;
+    st.st_nlink = sx.stx_nlink;
+    st.st_uid = sx.stx_uid;
+    st.st_gid = sx.stx_gid;
+    st.st_rdev = makedev(sx.stx_rdev_major, sx.stx_rdev_minor);
+    st.st_size = sx.stx_size;
+    st.st_blksize = sx.stx_blksize;
+    st.st_blocks = sx.stx_blocks;
+    st.st_atim = { time_t(sx.stx_atime.tv_sec), long(sx.stx_atime.tv_nsec) };
+    st.st_mtim = { time_t(sx.stx_mtime.tv_sec), long(sx.stx_mtime.tv_nsec) };
+    st.st_ctim = { time_t(sx.stx_ctime.tv_sec), long(sx.stx_ctime.tv_nsec) };
+    return st;
+}
+
 future<struct stat>
 reactor::fstat(int fd) noexcept {
+    if (_backend->supports_async_metadata()) {
+        return do_with(statx_struct{}, [this, fd] (statx_struct& sx) {
+            return _backend->submit_statx(fd, "", AT_EMPTY_PATH, STATX_BASIC_STATS, &sx).then([&sx] (ssize_t ret) {
+                if (ret < 0) {
+                    return make_exception_future<struct stat>(std::system_error(-ret, std::system_category()));
+                }
+                return make_ready_future<struct stat>(statx_to_stat(sx));
+            });
+        });
+    }
     return _thread_pool->submit<syscall_result_extra<struct stat>>([fd] {
         struct stat st;
         auto ret = ::fstat(fd, &st);
@@ -1797,6 +2096,11 @@ reactor::inotify_add_watch(int fd, std::string_view path, uint32_t flags) {
     });
 }
 
+future<int>
+reactor::run_blocking(noncopyable_function<int ()> func) noexcept {
+    return _thread_pool->submit<int>(std::move(func));
+}
+
 future<stat_data>
 reactor::file_stat(std::string_view pathname, follow_symlink follow) noexcept {
     // Allocating memory for a sstring can throw, hence the futurize_invoke
@@ -2143,9 +2447,21 @@ void reactor::register_metrics() {
             sm::make_gauge("tasks_pending", std::bind(&reactor::pending_task_count, this), sm::description("Number of pending tasks in the queue")),
             // total_operations value:DERIVE:0:U
             sm::make_derive("tasks_processed", std::bind(&reactor::tasks_processed, this), sm::description("Total tasks processed")),
+            sm::make_derive("ready_continuations_deferred", [] { return internal::ready_continuations_deferred; },
+                    sm::description("Total continuations on ready futures that went through the run queue because the task quota was exhausted")),
             sm::make_derive("polls", _polls, sm::description("Number of times pollers were executed")),
+            sm::make_derive("tsc_calibration_drift_ns", [] { return internal::tsc_clock::calibration_drift_ns(); },
+                    sm::description("Cumulative error, in nanoseconds, observed between the calibrated TSC clock and CLOCK_MONOTONIC at recalibration points; calibration happens on shard 0, so the value is the same on all shards")),
             sm::make_derive("timers_pending", std::bind(&decltype(_timers)::size, &_timers), sm::description("Number of tasks in the timer-pending queue")),
             sm::make_gauge("utilization", [this] { return (1-_load)  * 100; }, sm::description("CPU utilization")),
+            sm::make_gauge("effective_task_quota_ms", [this] { return _effective_task_quota / 1.0ms; },
+                    sm::description("The task quota currently enforced by the preemption timer (see --adaptive-task-quota)")),
+            sm::make_gauge("scheduling_delay_us", [this] { return std::chrono::duration_cast<std::chrono::microseconds>(_sched_delay_ema).count(); },
+                    sm::description("Smoothed delay between a task queue becoming runnable and its first task running; the overload signal consulted by overloaded() (see --overload-threshold-ms)")),
+            sm::make_gauge("idle_poll_state", [this] { return static_cast<int>(_idle_governor.current_state()); },
+                    sm::description("Idle/poll governor state of this shard (0: busy-poll, 1: timed-poll, 2: blocked)")),
+            sm::make_derive("idle_poll_state_changes", [this] { return _idle_governor.transitions(); },
+                    sm::description("Number of idle/poll governor state transitions")),
             sm::make_derive("cpu_busy_ms", [this] () -> int64_t { return total_busy_time() / 1ms; },
                     sm::description("Total cpu busy time in milliseconds")),
             sm::make_derive("cpu_steal_time_ms", [this] () -> int64_t { return total_steal_time() / 1ms; },
@@ -2161,6 +2477,8 @@ void reactor::register_metrics() {
             sm::make_derive("aio_errors", _io_stats.aio_errors, sm::description("Total aio errors")),
             // total_operations value:DERIVE:0:U
             sm::make_derive("fsyncs", _fsyncs, sm::description("Total number of fsync operations")),
+            sm::make_derive("fsyncs_coalesced", _io_stats.fsyncs_coalesced,
+                    sm::description("Total number of flush requests satisfied by another request's fsync (group commit)")),
             // total_operations value:DERIVE:0:U
             sm::make_derive("io_threaded_fallbacks", std::bind(&thread_pool::operation_count, _thread_pool.get()),
                     sm::description("Total number of io-threaded-fallbacks operations")),
@@ -2176,7 +2494,13 @@ void reactor::register_metrics() {
             sm::make_current_bytes("free_memory", [] { return memory::stats().free_memory(); }, sm::description("Free memeory size in bytes")),
             sm::make_current_bytes("total_memory", [] { return memory::stats().total_memory(); }, sm::description("Total memeory size in bytes")),
             sm::make_current_bytes("allocated_memory", [] { return memory::stats().allocated_memory(); }, sm::description("Allocated memeory size in bytes")),
-            sm::make_derive("reclaims_operations", [] { return memory::stats().reclaims(); }, sm::description("Total reclaims operations"))
+            sm::make_derive("reclaims_operations", [] { return memory::stats().reclaims(); }, sm::description("Total reclaims operations")),
+            sm::make_derive("soft_limit_hits", [] { return memory::stats().soft_limit_hits(); },
+                    sm::description("Total number of times a scheduling group exceeded its soft memory limit")),
+            sm::make_derive("bytes_returned_to_os", [] { return memory::stats().bytes_returned_to_os(); },
+                    sm::description("Total bytes of idle memory returned to the OS")),
+            sm::make_current_bytes("hugepage_text_bytes", [] { return internal::remapped_text_bytes(); },
+                    sm::description("Bytes of executable text remapped onto transparent hugepages (see --hugepage-text)"))
     });
 
     _metric_groups.add_group("reactor", {
@@ -2212,6 +2536,20 @@ void reactor::register_metrics() {
                 description(
                         "Counts the number of buffered bytes that were read ahead of time and were discarded because they were not needed, wasting disk bandwidth."
                         " Indicates over-eager read ahead configuration.")),
+        make_counter("fstream_writes", _io_stats.fstream_writes,
+                description(
+                        "Counts writes issued by disk file streams.  A high rate indicates high disk activity.")),
+        make_derive("fstream_write_bytes", _io_stats.fstream_write_bytes,
+                description(
+                        "Counts bytes written by disk file streams.  Divide by fstream_writes to determine average write size.")),
+        make_counter("fstream_write_behind_grown", _io_stats.fstream_write_behind_grown,
+                description(
+                        "Counts the number of times an adaptive file output stream deepened its write-behind pipeline."
+                        " Contrast with fstream_write_behind_shrunk to see where the depths settled.")),
+        make_counter("fstream_write_behind_shrunk", _io_stats.fstream_write_behind_shrunk,
+                description(
+                        "Counts the number of times an adaptive file output stream reduced its write-behind pipeline,"
+                        " because it was drained between writes or writes started taking too long.")),
     });
 }
 
@@ -2225,7 +2563,11 @@ void reactor::run_tasks(task_queue& tq) {
         STAP_PROBE(seastar, reactor_run_tasks_single_start);
         task_histogram_add_task(*tsk);
         _current_task = tsk;
-        tsk->run_and_dispose();
+        if (__builtin_expect(_tracer.enabled(), false)) {
+            _tracer.run_task(tsk, tq._id);
+        } else {
+            tsk->run_and_dispose();
+        }
         _current_task = nullptr;
         STAP_PROBE(seastar, reactor_run_tasks_single_end);
         ++tq._tasks_processed;
@@ -2428,6 +2770,51 @@ public:
     }
 };
 
+// Moves memory between shards when their static partitioning turns out
+// not to match the workload: a shard low on memory borrows whole spans
+// from its siblings, and gives them back once its own pressure subsides.
+// See the protocol description in memory.hh.
+class reactor::memory_rebalance_pollfn final : public simple_pollfn<true> {
+public:
+    virtual bool poll() final override {
+        return engine().maybe_rebalance_memory();
+    }
+};
+
+bool reactor::maybe_rebalance_memory() {
+    // Give back borrowed spans we no longer need; freeing a span routes
+    // it to the donor via the cross-cpu free path.
+    auto [span, bytes] = memory::retrieve_donated_span();
+    if (span) {
+        ::free(span);
+        return true;
+    }
+    if (smp::count == 1 || _memory_rebalance_in_progress || !memory::wants_donated_memory()) {
+        return false;
+    }
+    // Ask the shards in turn rather than stampeding the same donor.
+    auto donor = _next_memory_donor++ % smp::count;
+    if (donor == _id) {
+        donor = _next_memory_donor++ % smp::count;
+    }
+    _memory_rebalance_in_progress = true;
+    (void)smp::submit_to(donor, [] {
+        return memory::try_allocate_donation(memory::donation_span_size);
+    }).then_wrapped([this] (future<void*> f) {
+        _memory_rebalance_in_progress = false;
+        try {
+            auto span = f.get0();
+            if (span) {
+                memory::add_donated_span(span, memory::donation_span_size);
+            }
+        } catch (...) {
+            // submitting the request can itself fail under memory
+            // pressure; we'll retry on a later poll
+        }
+    });
+    return true;
+}
+
 class reactor::lowres_timer_pollfn final : public reactor::pollfn {
     reactor& _r;
     // A highres timer is implemented as a waking  signal; so
@@ -2600,13 +2987,80 @@ void reactor::insert_active_task_queue(task_queue* tq) {
     }
 }
 
+bool
+reactor::overloaded() const noexcept {
+    return _overload_threshold != sched_clock::duration{} && _sched_delay_ema >= _overload_threshold;
+}
+
 reactor::task_queue* reactor::pop_active_task_queue(sched_clock::time_point now) {
     task_queue* tq = _active_task_queues.front();
     _active_task_queues.pop_front();
-    tq->_starvetime += now - tq->_ts;
+    auto delay = now - tq->_ts;
+    tq->_starvetime += delay;
+    tq->_time_to_first_run.record(std::max<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(delay).count(), 0));
+    _sched_delay_ema += (delay - _sched_delay_ema) / 8;
     return tq;
 }
 
+reactor::task_queue* reactor::pop_eligible_task_queue(sched_clock::time_point now) {
+    auto& atq = _active_task_queues;
+    if (_nr_deadline_task_queues && atq.size() > 1) {
+        // Earliest-deadline-first overlay: a queue whose latency goal
+        // would be missed by letting the front queue run a full quota is
+        // dispatched ahead of the vruntime order. While all goals are
+        // met, the shares-driven order below applies unchanged.
+        size_t best = atq.size();
+        auto best_deadline = sched_clock::time_point::max();
+        for (size_t i = 0; i != atq.size(); ++i) {
+            auto* tq = atq[i];
+            if (tq->_latency_goal == sched_clock::duration{}) {
+                continue;
+            }
+            auto deadline = tq->_ts + tq->_latency_goal;
+            if (deadline <= now + _effective_task_quota && deadline < best_deadline) {
+                best = i;
+                best_deadline = deadline;
+            }
+        }
+        // bubble the chosen queue to the front, keeping the others in
+        // vruntime order
+        for (size_t i = best; i != 0 && i < atq.size(); --i) {
+            std::swap(atq[i], atq[i - 1]);
+        }
+    }
+    return pop_active_task_queue(now);
+}
+
+// With --adaptive-task-quota, recomputes the effective quota from the
+// configured one: a scheduling group with a latency goal bounds how long any
+// other group may keep the CPU (half the goal, so a group activating right
+// after a slice starts still meets it), and under light load shorter slices
+// cost little throughput while making cross-shard responses visible sooner.
+// Called once a second from the load timer and whenever a goal changes; the
+// preemption timer is only re-armed when the result actually moves.
+void
+reactor::update_effective_task_quota() noexcept {
+    if (!_adaptive_task_quota) {
+        return;
+    }
+    // Never arm the timer faster than this; below it the timer and poll
+    // overhead start to dominate.
+    static constexpr auto quota_floor = std::chrono::duration_cast<sched_clock::duration>(100us);
+    // _load is the idle fraction; scale with the busy fraction
+    auto quota = quota_floor + std::chrono::duration_cast<sched_clock::duration>((_task_quota - quota_floor) * (1.0 - _load));
+    for (auto&& tq : _task_queues) {
+        if (tq && tq->_latency_goal != sched_clock::duration{}) {
+            quota = std::min(quota, tq->_latency_goal / 2);
+        }
+    }
+    quota = std::clamp(quota, quota_floor, _task_quota);
+    if (quota != _effective_task_quota) {
+        _effective_task_quota = quota;
+        auto its = seastar::posix::to_relative_itimerspec(quota, quota);
+        _task_quota_timer.timerfd_settime(0, its);
+    }
+}
+
 void
 reactor::insert_activating_task_queues() {
     // Quadratic, but since we expect the common cases in insert_active_task_queue() to dominate, faster
@@ -2625,20 +3079,24 @@ reactor::run_some_tasks() {
     reset_preemption_monitor();
 
     sched_clock::time_point t_run_completed = std::chrono::steady_clock::now();
+    auto hw_run_completed = _hw_counters.read();
     STAP_PROBE(seastar, reactor_run_tasks_start);
     _cpu_stall_detector->start_task_run(t_run_completed);
     do {
         auto t_run_started = t_run_completed;
+        auto hw_run_started = hw_run_completed;
         insert_activating_task_queues();
-        task_queue* tq = pop_active_task_queue(t_run_started);
+        task_queue* tq = pop_eligible_task_queue(t_run_started);
         sched_print("running tq {} {}", (void*)tq, tq->_name);
         tq->_current = true;
         _last_vruntime = std::max(tq->_vruntime, _last_vruntime);
         run_tasks(*tq);
         tq->_current = false;
         t_run_completed = std::chrono::steady_clock::now();
+        hw_run_completed = _hw_counters.read();
         auto delta = t_run_completed - t_run_started;
         account_runtime(*tq, delta);
+        tq->_hw_events += hw_run_completed - hw_run_started;
         sched_print("run complete ({} {}); time consumed {} usec; final vruntime {} empty {}",
                 (void*)tq, tq->_name, delta / 1us, tq->_vruntime, tq->_q.empty());
         tq->_ts = t_run_completed;
@@ -2696,6 +3154,11 @@ int reactor::run() {
 
     register_metrics();
 
+    if (_enable_hw_counters) {
+        // per-thread counters, so they must be opened on this thread
+        _hw_counters.enable();
+    }
+
     // The order in which we execute the pollers is very important for performance.
     //
     // This is because events that are generated in one poller may feed work into others. If
@@ -2750,6 +3213,7 @@ int reactor::run() {
     poller syscall_poller(std::make_unique<syscall_pollfn>(*this));
 
     poller drain_cross_cpu_freelist(std::make_unique<drain_cross_cpu_freelist_pollfn>());
+    poller memory_rebalance(std::make_unique<memory_rebalance_pollfn>());
 
     poller expire_lowres_timers(std::make_unique<lowres_timer_pollfn>(*this));
     poller sig_poller(std::make_unique<signal_pollfn>(*this));
@@ -2771,12 +3235,23 @@ int reactor::run() {
             _load -= (drop/5);
         }
         _load += (load/5);
+        // Decay the scheduling-delay signal so it drops once the backlog
+        // clears; while loaded, the per-activation updates in
+        // pop_active_task_queue() dominate this halving.
+        _sched_delay_ema -= _sched_delay_ema / 2;
+        update_effective_task_quota();
     });
     load_timer.arm_periodic(1s);
 
-    itimerspec its = seastar::posix::to_relative_itimerspec(_task_quota, _task_quota);
+    // Cheap no-op unless memory::set_idle_memory_return() enabled it.
+    timer<lowres_clock> idle_memory_return_timer;
+    idle_memory_return_timer.set_callback([] {
+        memory::return_idle_memory();
+    });
+    idle_memory_return_timer.arm_periodic(1s);
+
+    itimerspec its = seastar::posix::to_relative_itimerspec(_effective_task_quota, _effective_task_quota);
     _task_quota_timer.timerfd_settime(0, its);
-    auto& task_quote_itimerspec = its;
 
     struct sigaction sa_block_notifier = {};
     sa_block_notifier.sa_handler = &reactor::block_notifier;
@@ -2784,6 +3259,12 @@ int reactor::run() {
     auto r = sigaction(cpu_stall_detector::signal_number(), &sa_block_notifier, nullptr);
     assert(r == 0);
 
+    struct sigaction sa_profiler_notifier = {};
+    sa_profiler_notifier.sa_handler = &reactor::profiler_notifier;
+    sa_profiler_notifier.sa_flags = SA_RESTART;
+    r = sigaction(cpu_profiler::signal_number(), &sa_profiler_notifier, nullptr);
+    assert(r == 0);
+
     bool idle = false;
 
     std::function<bool()> check_for_work = [this] () {
@@ -2815,12 +3296,14 @@ int reactor::run() {
 
         if (check_for_work()) {
             if (idle) {
+                _idle_governor.account_poll(true);
                 _total_idle += idle_end - idle_start;
                 account_idle(idle_end - idle_start);
                 idle_start = idle_end;
                 idle = false;
             }
         } else {
+            _idle_governor.account_poll(false);
             idle_end = sched_clock::now();
             if (!idle) {
                 idle_start = idle_end;
@@ -2838,7 +3321,7 @@ int reactor::run() {
             }
             if (go_to_sleep) {
                 internal::cpu_relax();
-                if (idle_end - idle_start > _max_poll_time) {
+                if (idle_end - idle_start > _idle_governor.poll_time(_max_poll_time)) {
                     // Turn off the task quota timer to avoid spurious wakeups
                     struct itimerspec zero_itimerspec = {};
                     _task_quota_timer.timerfd_settime(0, zero_itimerspec);
@@ -2849,7 +3332,9 @@ int reactor::run() {
                     // We may have slept for a while, so freshen idle_end
                     idle_end = sched_clock::now();
                     _total_sleep += idle_end - start_sleep;
-                    _task_quota_timer.timerfd_settime(0, task_quote_itimerspec);
+                    _idle_governor.account_sleep(idle_end - start_sleep);
+                    auto task_quota_its = seastar::posix::to_relative_itimerspec(_effective_task_quota, _effective_task_quota);
+                    _task_quota_timer.timerfd_settime(0, task_quota_its);
                 }
             } else {
                 // We previously ran pure_check_for_work(), might not actually have performed
@@ -3014,8 +3499,7 @@ poller::~poller() {
 
 syscall_work_queue::syscall_work_queue()
     : _pending()
-    , _completed()
-    , _start_eventfd(0) {
+    , _start_eventfd(file_desc::eventfd(0, EFD_CLOEXEC | EFD_SEMAPHORE)) {
 }
 
 void syscall_work_queue::submit_item(std::unique_ptr<syscall_work_queue::work_item> item) {
@@ -3025,26 +3509,15 @@ void syscall_work_queue::submit_item(std::unique_ptr<syscall_work_queue::work_it
             item->set_exception(f.get_exception());
             return;
         }
-        _pending.push(item.release());
-        _start_eventfd.signal(1);
+        auto pushed = _pending.push(item.release());
+        assert(pushed);
+        // one semaphore unit wakes one worker for the one item
+        uint64_t one = 1;
+        auto r = _start_eventfd.write(&one, sizeof(one));
+        assert(r == sizeof(one));
     });
 }
 
-unsigned syscall_work_queue::complete() {
-    std::array<work_item*, queue_length> tmp_buf;
-    auto end = tmp_buf.data();
-    auto nr = _completed.consume_all([&] (work_item* wi) {
-        *end++ = wi;
-    });
-    for (auto p = tmp_buf.data(); p != end; ++p) {
-        auto wi = *p;
-        wi->complete();
-        delete wi;
-    }
-    _queue_has_room.signal(nr);
-    return nr;
-}
-
 
 smp_message_queue::smp_message_queue(reactor* from, reactor* to)
     : _pending(to)
@@ -3096,6 +3569,7 @@ void smp_message_queue::submit_item(shard_id t, smp_timeout_clock::time_point ti
         ++_last_cmpl_batch;
         return;
     }
+    item->submit_time = internal::tsc_clock::now();
     _tx.a.pending_fifo.push_back(item.get());
     // no exceptions from this point
     item.release();
@@ -3108,7 +3582,7 @@ void smp_message_queue::submit_item(shard_id t, smp_timeout_clock::time_point ti
 
 void smp_message_queue::respond(work_item* item) {
     _completed_fifo.push_back(item);
-    if (_completed_fifo.size() >= batch_size || engine()._stopped) {
+    if (_completed_fifo.size() >= _response_batch_target || engine()._stopped) {
         flush_response_batch();
     }
 }
@@ -3121,6 +3595,15 @@ void smp_message_queue::flush_response_batch() {
         if (begin == end) {
             return;
         }
+        auto nr = end - begin;
+        // Track the recent flush sizes and raise the eager-flush threshold in
+        // respond() towards them, so that bursts of completions share one
+        // cross-core notification. A trickle of responses decays the
+        // threshold back towards one, keeping per-message latency low; the
+        // poll loop flushes whatever accumulated regardless, so a raised
+        // threshold never delays a response past the current poll.
+        _response_batch_ema += nr - (_response_batch_ema >> response_ema_bits);
+        _response_batch_target = std::max<size_t>(std::min<size_t>(_response_batch_ema >> response_ema_bits, batch_size), 1);
         _completed.maybe_wakeup();
         _completed_fifo.erase(begin, end);
     }
@@ -3184,10 +3667,11 @@ size_t smp_message_queue::process_queue(lf_queue& q, Func process) {
 }
 
 size_t smp_message_queue::process_completions(shard_id t) {
-    auto nr = process_queue<prefetch_cnt*2>(_completed, [t] (work_item* wi) {
+    auto queue_delay_ns = _queue_delay_ns_ema.load(std::memory_order_relaxed);
+    auto nr = process_queue<prefetch_cnt*2>(_completed, [t, queue_delay_ns] (work_item* wi) {
         wi->complete();
         auto ssg_id = smp_service_group_id(wi->ssg);
-        get_smp_service_groups_semaphore(ssg_id, t).signal();
+        smp_service_group_complete_request(ssg_id, t, queue_delay_ns);
         delete wi;
     });
     _current_queue_length -= nr;
@@ -3204,7 +3688,19 @@ void smp_message_queue::flush_request_batch() {
 }
 
 size_t smp_message_queue::process_incoming() {
-    auto nr = process_queue<prefetch_cnt>(_pending, [] (work_item* wi) {
+    bool sampled = false;
+    auto nr = process_queue<prefetch_cnt>(_pending, [this, &sampled] (work_item* wi) {
+        if (!sampled) {
+            // Fold the queueing delay of the oldest pending item into an
+            // exponential moving average; the sending shard reads it in
+            // process_completions() to adapt smp_service_group limits.
+            sampled = true;
+            auto delay = internal::tsc_clock::now() - wi->submit_time;
+            auto delay_ns = uint64_t(std::max<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count(), 0));
+            auto ema = _queue_delay_ns_ema.load(std::memory_order_relaxed);
+            ema += (delay_ns >> queue_delay_ema_bits) - (ema >> queue_delay_ema_bits);
+            _queue_delay_ns_ema.store(ema, std::memory_order_relaxed);
+        }
         wi->process();
     });
     _received += nr;
@@ -3347,10 +3843,14 @@ reactor::get_options_description(reactor_config cfg) {
         ("poll-aio", bpo::value<bool>()->default_value(true),
                 "busy-poll for disk I/O (reduces latency and increases throughput)")
         ("task-quota-ms", bpo::value<double>()->default_value(cfg.task_quota / 1ms), "Max time (ms) between polls")
+        ("adaptive-task-quota", bpo::value<bool>()->default_value(false), "shrink the task quota towards the scheduling groups' latency goals and, under light load, towards shorter polling intervals; task-quota-ms becomes the upper bound")
+        ("overload-threshold-ms", bpo::value<double>()->default_value(0), "scheduling delay above which the shard reports itself overloaded, letting servers (httpd, rpc) shed or defer new work early; 0 disables the signal")
+        ("scheduling-group-counters", bpo::value<bool>()->default_value(false), "attribute hardware cycles, instructions and last-level-cache misses to scheduling groups using userspace counter reads (rdpmc); silently ignored where perf events or rdpmc are unavailable")
         ("max-task-backlog", bpo::value<unsigned>()->default_value(1000), "Maximum number of task backlog to allow; above this we ignore I/O")
         ("blocked-reactor-notify-ms", bpo::value<unsigned>()->default_value(200), "threshold in miliseconds over which the reactor is considered blocked if no progress is made")
         ("blocked-reactor-reports-per-minute", bpo::value<unsigned>()->default_value(5), "Maximum number of backtraces reported by stall detector per minute")
         ("blocked-reactor-report-format-oneline", bpo::value<bool>()->default_value(true), "Print a simplified backtrace on a single line")
+        ("blocking-syscall-threads", bpo::value<unsigned>()->default_value(1), "Number of threads per shard executing blocking system calls, so that a stuck call does not serialize the others")
         ("relaxed-dma", "allow using buffered I/O if DMA is not available (reduces performance)")
         ("linux-aio-nowait",
                 bpo::value<bool>()->default_value(aio_nowait_supported),
@@ -3397,6 +3897,8 @@ smp::get_options_description()
         ("reserve-memory", bpo::value<std::string>(), "memory reserved to OS (if --memory not specified)")
         ("hugepages", bpo::value<std::string>(), "path to accessible hugetlbfs mount (typically /dev/hugepages/something)")
         ("lock-memory", bpo::value<bool>(), "lock all memory (prevents swapping)")
+        ("hugepage-text", bpo::value<bool>()->default_value(false), "remap the executable's text onto transparent hugepages at startup, reducing iTLB pressure for large binaries")
+        ("prefault-memory", bpo::value<bool>()->default_value(false), "fault in shard memory in background threads at startup, so that it is already populated when first allocated; listeners can start serving while the prefault is still running")
         ("thread-affinity", bpo::value<bool>()->default_value(true), "pin threads to their cpus (disable for overprovisioning)")
 #ifdef SEASTAR_HAVE_HWLOC
         ("num-io-queues", bpo::value<unsigned>(), "Number of IO queues. Each IO unit will be responsible for a fraction of the IO requests. Defaults to the number of threads")
@@ -3407,6 +3909,9 @@ smp::get_options_description()
 #endif
         ("io-properties-file", bpo::value<std::string>(), "path to a YAML file describing the characteristics of the I/O Subsystem")
         ("io-properties", bpo::value<std::string>(), "a YAML string describing the characteristics of the I/O Subsystem")
+        ("io-queue-bypass", bpo::value<bool>()->default_value(false), "submit I/O requests directly to disk when the I/O queue is empty and the disk has spare capacity (experimental)")
+        ("io-queue-calibration", bpo::value<bool>()->default_value(false), "continuously re-estimate the I/O scheduler ticket costs from observed completion rates (experimental)")
+        ("io-queue-merging", bpo::value<bool>()->default_value(false), "merge physically contiguous I/O requests into one disk operation before submission (experimental)")
         ("mbind", bpo::value<bool>()->default_value(true), "enable mbind")
 #ifndef SEASTAR_NO_EXCEPTION_HACK
         ("enable-glibc-exception-scaling-workaround", bpo::value<bool>()->default_value(true), "enable workaround for glibc/gcc c++ exception scalablity problem")
@@ -3441,6 +3946,24 @@ std::unique_ptr<smp_message_queue*[], smp::qs_deleter> smp::_qs;
 std::thread::id smp::_tmain;
 unsigned smp::count = 1;
 bool smp::_using_dpdk;
+std::vector<shard_id> smp::_cpu_to_shard;
+std::vector<unsigned> smp::_shard_to_numa_node;
+
+std::optional<shard_id>
+smp::shard_of_cpu(unsigned os_cpu) noexcept {
+    if (os_cpu >= _cpu_to_shard.size() || _cpu_to_shard[os_cpu] == ~0u) {
+        return std::nullopt;
+    }
+    return _cpu_to_shard[os_cpu];
+}
+
+unsigned
+smp::numa_node_of_shard(shard_id shard) noexcept {
+    if (shard >= _shard_to_numa_node.size()) {
+        return 0;
+    }
+    return _shard_to_numa_node[shard];
+}
 
 void smp::start_all_queues()
 {
@@ -3475,6 +3998,32 @@ void smp::join_all()
     }
 }
 
+// Prefaulting a terabyte-class machine takes tens of seconds, so it
+// happens on dedicated threads while the reactors already run; the
+// threads are joined from smp::cleanup().
+static std::mutex prefault_threads_mutex;
+static std::vector<std::thread> prefault_threads;
+
+static void spawn_memory_prefault_thread(shard_id shard, unsigned cpu_id, bool thread_affinity) {
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    // must be called on the shard's own thread, the layout is thread-local
+    auto layout = memory::get_memory_layout();
+    std::lock_guard<std::mutex> guard(prefault_threads_mutex);
+    prefault_threads.emplace_back([layout, shard, cpu_id, thread_affinity] {
+        auto thread_name = seastar::format("prefault-{}", shard);
+        pthread_setname_np(pthread_self(), thread_name.c_str());
+        if (thread_affinity) {
+            // fault on the shard's cpu so the pages land on its NUMA node
+            pin_this_thread(cpu_id);
+        }
+        auto start = std::chrono::steady_clock::now();
+        memory::prefault_memory(memory::memory_layout{layout.start, layout.end});
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        seastar_logger.info("prefaulted {}M of shard {} memory in {}ms", (layout.end - layout.start) >> 20, shard, ms);
+    });
+#endif
+}
+
 void smp::pin(unsigned cpu_id) {
     if (_using_dpdk) {
         // dpdk does its own pinning
@@ -3504,6 +4053,10 @@ void smp::allocate_reactor(unsigned id, reactor_backend_selector rbs, reactor_co
 }
 
 void smp::cleanup() {
+    for (auto& t : prefault_threads) {
+        t.join();
+    }
+    prefault_threads.clear();
     smp::_threads = std::vector<posix_thread>();
     _thread_loops.clear();
 }
@@ -3562,12 +4115,16 @@ static void sigabrt_action() noexcept {
     print_with_backtrace("Aborting");
 }
 
+// Rows of the queue matrix are page-aligned so each row can be mbind()ed to
+// the NUMA node of the shard that polls it.
+static constexpr size_t qs_row_alignment = 4096;
+
 void smp::qs_deleter::operator()(smp_message_queue** qs) const {
     for (unsigned i = 0; i < smp::count; i++) {
         for (unsigned j = 0; j < smp::count; j++) {
             qs[i][j].~smp_message_queue();
         }
-        ::operator delete[](qs[i]);
+        ::operator delete[](qs[i], std::align_val_t(qs_row_alignment));
     }
     delete[](qs);
 }
@@ -3578,6 +4135,9 @@ private:
     std::optional<unsigned> _capacity;
     std::unordered_map<dev_t, mountpoint_params> _mountpoints;
     std::chrono::duration<double> _latency_goal;
+    bool _bypass = false;
+    bool _calibration = false;
+    bool _merging = false;
 
 public:
     uint64_t per_io_group(uint64_t qty, unsigned nr_groups) const noexcept {
@@ -3600,6 +4160,10 @@ public:
             _capacity = configuration["max-io-requests"].as<unsigned>();
         }
 
+        _bypass = configuration["io-queue-bypass"].as<bool>();
+        _calibration = configuration["io-queue-calibration"].as<bool>();
+        _merging = configuration["io-queue-merging"].as<bool>();
+
         if (configuration.count("num-io-groups")) {
             _num_io_groups = configuration["num-io-groups"].as<unsigned>();
             if (!_num_io_groups) {
@@ -3643,6 +4207,9 @@ public:
                             d.read_req_rate == 0 || d.write_req_rate == 0) {
                         throw std::runtime_error(fmt::format("R/W bytes and req rates must not be zero"));
                     }
+                    if (d.nr_member_devices == 0 || d.member_stripe_size == 0) {
+                        throw std::runtime_error(fmt::format("Member device count and stripe size must not be zero"));
+                    }
 
                     seastar_logger.debug("dev_id: {} mountpoint: {}", buf.st_dev, d.mountpoint);
                     _mountpoints.emplace(buf.st_dev, d);
@@ -3687,6 +4254,11 @@ public:
         cfg.devid = devid;
         cfg.disk_bytes_write_to_read_multiplier = io_queue::read_request_base_count;
         cfg.disk_req_write_to_read_multiplier = io_queue::read_request_base_count;
+        cfg.uncontended_bypass = _bypass;
+        cfg.online_calibration = _calibration;
+        cfg.merge_adjacent_requests = _merging;
+        cfg.nr_member_devices = p.nr_member_devices;
+        cfg.member_stripe_size = p.member_stripe_size;
 
         if (!_capacity) {
             if (p.read_bytes_rate != std::numeric_limits<uint64_t>::max()) {
@@ -3712,6 +4284,7 @@ public:
 
 void smp::register_network_stacks() {
     register_posix_stack();
+    register_shm_stack();
     register_native_stack();
 }
 
@@ -3763,6 +4336,18 @@ void smp::configure(boost::program_options::variables_map configuration, reactor
     if (!thread_affinity) {
         mbind = false;
     }
+    auto prefault = configuration["prefault-memory"].as<bool>();
+
+    // Log how long the startup phases take; on large machines the total
+    // is dominated by memory and smp queue construction and regressions
+    // here directly delay rolling restarts.
+    auto startup_phase_start = std::chrono::steady_clock::now();
+    auto log_startup_phase = [&startup_phase_start] (const char* phase) {
+        auto now = std::chrono::steady_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - startup_phase_start).count();
+        seastar_logger.info("startup: {} took {}ms", phase, ms);
+        startup_phase_start = now;
+    };
 
     smp::count = 1;
     smp::_tmain = std::this_thread::get_id();
@@ -3856,6 +4441,12 @@ void smp::configure(boost::program_options::variables_map configuration, reactor
         }
     }
 
+    if (configuration["hugepage-text"].as<bool>()) {
+        // Must happen while we are still single-threaded: the text is
+        // replaced under our feet.
+        internal::remap_text_to_hugepages();
+    }
+
     rc.cpus = smp::count;
     rc.cpu_set = std::move(cpu_set);
 
@@ -3873,11 +4464,29 @@ void smp::configure(boost::program_options::variables_map configuration, reactor
 #endif
 
     auto resources = resource::allocate(rc);
+    log_startup_phase("resource allocation");
     std::vector<resource::cpu> allocations = std::move(resources.cpus);
     if (thread_affinity) {
         smp::pin(allocations[0].cpu_id);
+        for (shard_id i = 0; i < smp::count; i++) {
+            auto cpu_id = allocations[i].cpu_id;
+            if (cpu_id >= _cpu_to_shard.size()) {
+                _cpu_to_shard.resize(cpu_id + 1, ~0u);
+            }
+            _cpu_to_shard[cpu_id] = i;
+        }
+    }
+    _shard_to_numa_node.assign(smp::count, 0);
+    for (shard_id i = 0; i < smp::count; i++) {
+        if (!allocations[i].mem.empty()) {
+            _shard_to_numa_node[i] = allocations[i].mem.front().nodeid;
+        }
     }
     memory::configure(allocations[0].mem, mbind, hugepages_path);
+    log_startup_phase("shard 0 memory configuration");
+    if (prefault) {
+        spawn_memory_prefault_thread(0, allocations[0].cpu_id, thread_affinity);
+    }
 
     if (configuration.count("abort-on-seastar-bad-alloc")) {
         memory::enable_abort_on_allocation_failure();
@@ -3929,6 +4538,13 @@ void smp::configure(boost::program_options::variables_map configuration, reactor
             if (iog.attached == 0) {
                 struct io_group::config gcfg = disk_config.generate_group_config(id, topology.groups.size());
                 iog.g = std::make_shared<io_group>(std::move(gcfg));
+                // Groups of the same device may lend each other capacity
+                for (auto& other : topology.groups) {
+                    if (other.g && other.g != iog.g) {
+                        other.g->add_sibling(iog.g);
+                        iog.g->add_sibling(other.g);
+                    }
+                }
                 seastar_logger.debug("allocate {} IO group", group_idx);
             }
             iog.attached++;
@@ -3952,7 +4568,7 @@ void smp::configure(boost::program_options::variables_map configuration, reactor
     unsigned i;
     for (i = 1; i < smp::count; i++) {
         auto allocation = allocations[i];
-        create_thread([configuration, &disk_config, hugepages_path, i, allocation, assign_io_queue, alloc_io_queue, thread_affinity, heapprof_enabled, mbind, backend_selector, reactor_cfg] {
+        create_thread([configuration, &disk_config, hugepages_path, i, allocation, assign_io_queue, alloc_io_queue, thread_affinity, heapprof_enabled, mbind, prefault, backend_selector, reactor_cfg] {
           try {
             auto thread_name = seastar::format("reactor-{}", i);
             pthread_setname_np(pthread_self(), thread_name.c_str());
@@ -3960,6 +4576,9 @@ void smp::configure(boost::program_options::variables_map configuration, reactor
                 smp::pin(allocation.cpu_id);
             }
             memory::configure(allocation.mem, mbind, hugepages_path);
+            if (prefault) {
+                spawn_memory_prefault_thread(i, allocation.cpu_id, thread_affinity);
+            }
             if (heapprof_enabled) {
                 memory::set_heap_profiling_enabled(heapprof_enabled);
             }
@@ -4015,20 +4634,42 @@ void smp::configure(boost::program_options::variables_map configuration, reactor
 #endif
 
     reactors_registered.wait();
+    log_startup_phase("reactor construction");
     smp::_qs = decltype(smp::_qs){new smp_message_queue* [smp::count], qs_deleter{}};
     for(unsigned i = 0; i < smp::count; i++) {
-        smp::_qs[i] = reinterpret_cast<smp_message_queue*>(operator new[] (sizeof(smp_message_queue) * smp::count));
+        auto row_bytes = sizeof(smp_message_queue) * smp::count;
+        smp::_qs[i] = reinterpret_cast<smp_message_queue*>(operator new[] (row_bytes, std::align_val_t(qs_row_alignment)));
+#ifdef SEASTAR_HAVE_NUMA
+        // Row i holds the queues whose submission side shard i polls. Bind it
+        // to shard i's NUMA node instead of leaving it wherever shard 0's
+        // allocator placed it, so cross-socket shards do not pay a remote
+        // access for the queue control structures on every poll.
+        if (mbind && !allocations[i].mem.empty()) {
+            unsigned long nodemask = 1UL << allocations[i].mem.front().nodeid;
+            auto r = ::mbind(smp::_qs[i], row_bytes,
+                            MPOL_PREFERRED,
+                            &nodemask, std::numeric_limits<unsigned long>::digits,
+                            MPOL_MF_MOVE);
+            if (r == -1) {
+                char err[1000] = {};
+                strerror_r(errno, err, sizeof(err));
+                seastar_logger.warn("unable to mbind smp queues; performance may suffer: {}", err);
+            }
+        }
+#endif
         for (unsigned j = 0; j < smp::count; ++j) {
             new (&smp::_qs[i][j]) smp_message_queue(_reactors[j], _reactors[i]);
         }
     }
     alien::smp::_qs = alien::smp::create_qs(_reactors);
     smp_queues_constructed.wait();
+    log_startup_phase("smp queue construction");
     start_all_queues();
     for (auto& dev_id : disk_config.device_ids()) {
         assign_io_queue(0, dev_id);
     }
     inited.wait();
+    log_startup_phase("shard initialization");
 
     engine().configure(configuration);
     // The raw `new` is necessary because of the private constructor of `lowres_clock_impl`.
@@ -4308,7 +4949,11 @@ reactor::destroy_scheduling_group(scheduling_group sg) {
         auto& sg_data = _scheduling_group_specific_data;
         auto& this_sg = sg_data.per_scheduling_group_data[sg._id];
         this_sg.queue_is_initialized = false;
+        if (_task_queues[sg._id]->_latency_goal != sched_clock::duration{}) {
+            --_nr_deadline_task_queues;
+        }
         _task_queues[sg._id].reset();
+        update_effective_task_quota();
     });
 
 }
@@ -4328,6 +4973,26 @@ scheduling_group::set_shares(float shares) noexcept {
     engine()._task_queues[_id]->set_shares(shares);
 }
 
+float
+scheduling_group::get_shares() const noexcept {
+    return engine()._task_queues[_id]->_shares;
+}
+
+void
+scheduling_group::set_latency_goal(std::chrono::microseconds goal) noexcept {
+    auto& tq = *engine()._task_queues[_id];
+    auto new_goal = std::chrono::duration_cast<reactor::sched_clock::duration>(goal);
+    auto old_goal = std::exchange(tq._latency_goal, new_goal);
+    auto had_goal = old_goal != reactor::sched_clock::duration{};
+    auto has_goal = new_goal != reactor::sched_clock::duration{};
+    if (has_goal && !had_goal) {
+        ++engine()._nr_deadline_task_queues;
+    } else if (!has_goal && had_goal) {
+        --engine()._nr_deadline_task_queues;
+    }
+    engine().update_effective_task_quota();
+}
+
 future<scheduling_group>
 create_scheduling_group(sstring name, float shares) noexcept {
     auto aid = allocate_scheduling_group_id();
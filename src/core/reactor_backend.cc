@@ -537,6 +537,11 @@ void reactor_backend_aio::forget(pollable_fd_state& fd) noexcept {
     // ?
 }
 
+void reactor_backend_aio::detach(pollable_fd_state& fd) noexcept {
+    // aio polls are one-shot; with no outstanding operations nothing in
+    // the kernel refers to the state.
+}
+
 future<std::tuple<pollable_fd, socket_address>>
 reactor_backend_aio::accept(pollable_fd_state& listenfd) {
     return engine().do_accept(listenfd);
@@ -725,52 +730,93 @@ reactor_backend_epoll::wait_and_process(int timeout, const sigset_t* active_sigm
         maybe_switch_steady_clock_timers(timeout, _steady_clock_timer_reactor_thread, _steady_clock_timer_timer_thread);
     });
     std::array<epoll_event, 128> eevt;
-    int nr = ::epoll_pwait(_epollfd.get(), eevt.data(), eevt.size(), timeout, active_sigmask);
-    if (nr == -1 && errno == EINTR) {
-        return false; // gdb can cause this
-    }
-    assert(nr != -1);
-    for (int i = 0; i < nr; ++i) {
-        auto& evt = eevt[i];
-        auto pfd = reinterpret_cast<pollable_fd_state*>(evt.data.ptr);
-        if (!pfd) {
-            char dummy[8];
-            _r._notify_eventfd.read(dummy, 8);
-            continue;
+    bool processed = false;
+    for (;;) {
+        int nr = ::epoll_pwait(_epollfd.get(), eevt.data(), eevt.size(), timeout, active_sigmask);
+        if (nr == -1 && errno == EINTR) {
+            return processed; // gdb can cause this
         }
-        if (evt.data.ptr == &_steady_clock_timer_reactor_thread) {
-            char dummy[8];
-            _steady_clock_timer_reactor_thread.read(dummy, 8);
-            _highres_timer_pending.store(true, std::memory_order_relaxed);
-            _steady_clock_timer_deadline = {};
-            continue;
+        assert(nr != -1);
+        // Group the ready fds by completion type first, then dispatch each
+        // group in one tight loop: running the same completion code
+        // back-to-back is cheaper than interleaving the three flavors.
+        struct ready_fd {
+            pollable_fd_state* pfd;
+            int events;
+        };
+        std::array<ready_fd, eevt.size()> in_ready;
+        std::array<ready_fd, eevt.size()> out_ready;
+        std::array<ready_fd, eevt.size()> rw_ready;
+        size_t nr_in = 0, nr_out = 0, nr_rw = 0;
+        for (int i = 0; i < nr; ++i) {
+            auto& evt = eevt[i];
+            auto pfd = reinterpret_cast<pollable_fd_state*>(evt.data.ptr);
+            if (!pfd) {
+                char dummy[8];
+                _r._notify_eventfd.read(dummy, 8);
+                continue;
+            }
+            if (evt.data.ptr == &_steady_clock_timer_reactor_thread) {
+                char dummy[8];
+                _steady_clock_timer_reactor_thread.read(dummy, 8);
+                _highres_timer_pending.store(true, std::memory_order_relaxed);
+                _steady_clock_timer_deadline = {};
+                continue;
+            }
+            if (evt.events & (EPOLLHUP | EPOLLERR)) {
+                // treat the events as required events when error occurs, let
+                // send/recv/accept/connect handle the specific error.
+                evt.events = pfd->events_requested;
+            }
+            auto events = int(evt.events & (EPOLLIN | EPOLLOUT));
+            auto events_to_remove = events & ~pfd->events_requested;
+            if (pfd->events_rw) {
+                // accept() signals normal completions via EPOLLIN, but errors (due to shutdown())
+                // via EPOLLOUT|EPOLLHUP, so we have to wait for both EPOLLIN and EPOLLOUT with the
+                // same future
+                rw_ready[nr_rw++] = ready_fd{pfd, events};
+            } else {
+                // Normal processing where EPOLLIN and EPOLLOUT are waited for via different
+                // futures.
+                if (events & EPOLLIN) {
+                    in_ready[nr_in++] = ready_fd{pfd, events};
+                }
+                if (events & EPOLLOUT) {
+                    out_ready[nr_out++] = ready_fd{pfd, events};
+                }
+            }
+            if (events_to_remove) {
+                pfd->events_epoll &= ~events_to_remove;
+                evt.events = pfd->events_epoll;
+                auto op = evt.events ? EPOLL_CTL_MOD : EPOLL_CTL_DEL;
+                if (pfd->exclusive_wakeups && op == EPOLL_CTL_MOD) {
+                    // modifying an EPOLLEXCLUSIVE registration is invalid;
+                    // re-add instead
+                    ::epoll_ctl(_epollfd.get(), EPOLL_CTL_DEL, pfd->fd.get(), nullptr);
+                    op = EPOLL_CTL_ADD;
+                    evt.events |= EPOLLEXCLUSIVE;
+                }
+                ::epoll_ctl(_epollfd.get(), op, pfd->fd.get(), &evt);
+            }
         }
-        if (evt.events & (EPOLLHUP | EPOLLERR)) {
-            // treat the events as required events when error occurs, let
-            // send/recv/accept/connect handle the specific error.
-            evt.events = pfd->events_requested;
+        for (size_t i = 0; i != nr_in; ++i) {
+            complete_epoll_event(*in_ready[i].pfd, in_ready[i].events, EPOLLIN);
         }
-        auto events = evt.events & (EPOLLIN | EPOLLOUT);
-        auto events_to_remove = events & ~pfd->events_requested;
-        if (pfd->events_rw) {
-            // accept() signals normal completions via EPOLLIN, but errors (due to shutdown())
-            // via EPOLLOUT|EPOLLHUP, so we have to wait for both EPOLLIN and EPOLLOUT with the
-            // same future
-            complete_epoll_event(*pfd, events, EPOLLIN|EPOLLOUT);
-        } else {
-            // Normal processing where EPOLLIN and EPOLLOUT are waited for via different
-            // futures.
-            complete_epoll_event(*pfd, events, EPOLLIN);
-            complete_epoll_event(*pfd, events, EPOLLOUT);
+        for (size_t i = 0; i != nr_out; ++i) {
+            complete_epoll_event(*out_ready[i].pfd, out_ready[i].events, EPOLLOUT);
+        }
+        for (size_t i = 0; i != nr_rw; ++i) {
+            complete_epoll_event(*rw_ready[i].pfd, rw_ready[i].events, EPOLLIN|EPOLLOUT);
         }
-        if (events_to_remove) {
-            pfd->events_epoll &= ~events_to_remove;
-            evt.events = pfd->events_epoll;
-            auto op = evt.events ? EPOLL_CTL_MOD : EPOLL_CTL_DEL;
-            ::epoll_ctl(_epollfd.get(), op, pfd->fd.get(), &evt);
+        processed |= nr != 0;
+        if (nr < static_cast<int>(eevt.size())) {
+            return processed;
         }
+        // The event buffer came back full, so more fds are likely ready:
+        // drain the ready list with zero timeout before returning to the
+        // reactor loop.
+        timeout = 0;
     }
-    return nr;
 }
 
 class epoll_pollable_fd_state : public pollable_fd_state {
@@ -874,6 +920,17 @@ future<> reactor_backend_epoll::get_epoll_future(pollable_fd_state& pfd, int eve
         ::epoll_event eevt;
         eevt.events = pfd.events_epoll;
         eevt.data.ptr = &pfd;
+        if (pfd.exclusive_wakeups) {
+            // Listening sockets shared by several reactors without
+            // SO_REUSEPORT otherwise wake every epoll waiter per incoming
+            // connection. EPOLLEXCLUSIVE is only accepted by EPOLL_CTL_ADD,
+            // so changing the interest set needs a remove + re-add cycle.
+            if (ctl == EPOLL_CTL_MOD) {
+                ::epoll_ctl(_epollfd.get(), EPOLL_CTL_DEL, pfd.fd.get(), nullptr);
+                ctl = EPOLL_CTL_ADD;
+            }
+            eevt.events |= EPOLLEXCLUSIVE;
+        }
         int r = ::epoll_ctl(_epollfd.get(), ctl, pfd.fd.get(), &eevt);
         assert(r == 0);
         _need_epoll_events = true;
@@ -903,6 +960,19 @@ void reactor_backend_epoll::forget(pollable_fd_state& fd) noexcept {
     delete efd;
 }
 
+void reactor_backend_epoll::detach(pollable_fd_state& fd) noexcept {
+    // The fd stays in the interest set after a completed poll (it is
+    // only removed lazily on a later spurious wakeup), and the stale
+    // registration points at this state. Remove it while the fd is
+    // still open; forget()'s deferred EPOLL_CTL_DEL would run against
+    // an already-stolen descriptor and fail, leaving the registration
+    // to fire on freed memory.
+    if (fd.events_epoll) {
+        ::epoll_ctl(_epollfd.get(), EPOLL_CTL_DEL, fd.fd.get(), nullptr);
+        fd.events_epoll = 0;
+    }
+}
+
 future<std::tuple<pollable_fd, socket_address>>
 reactor_backend_epoll::accept(pollable_fd_state& listenfd) {
     return engine().do_accept(listenfd);
@@ -1004,6 +1074,12 @@ reactor_backend_osv::forget(pollable_fd_state& fd) noexcept {
     abort();
 }
 
+void
+reactor_backend_osv::detach(pollable_fd_state& fd) noexcept {
+    std::cerr << "reactor_backend_osv does not support file descriptors - detach() shouldn't have been called!\n";
+    abort();
+}
+
 future<std::tuple<pollable_fd, socket_address>>
 reactor_backend_osv::accept(pollable_fd_state& listenfd) {
     return engine().do_accept(listenfd);
@@ -1054,6 +1130,757 @@ reactor_backend_osv::make_pollable_fd_state(file_desc fd, pollable_fd::speculati
 }
 #endif
 
+future<ssize_t> reactor_backend::submit_openat(sstring pathname, int flags, mode_t mode) {
+    // Callers must check supports_async_metadata() first
+    abort();
+}
+
+future<ssize_t> reactor_backend::submit_statx(int dirfd, sstring pathname, int flags, unsigned mask, struct ::statx* buf) {
+    abort();
+}
+
+future<ssize_t> reactor_backend::submit_fallocate(int fd, int mode, uint64_t offset, uint64_t length) {
+    abort();
+}
+
+#ifdef SEASTAR_HAVE_URING
+
+static long io_uring_setup_syscall(unsigned entries, ::io_uring_params* p) {
+    return ::syscall(__NR_io_uring_setup, entries, p);
+}
+
+static long io_uring_enter_syscall(int fd, unsigned to_submit, unsigned min_complete, unsigned flags, const sigset_t* sig) {
+    // Can't use sizeof(sigset_t) because user and kernel sigset_t are inconsistent
+    return ::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, sig, size_t(8));
+}
+
+file_desc uring_context::make_ring(unsigned entries, bool sqpoll, bool iopoll, ::io_uring_params& params) {
+    params = {};
+    if (iopoll) {
+        params.flags |= IORING_SETUP_IOPOLL;
+    }
+    if (sqpoll) {
+        params.flags |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = 100; // msec before the poller thread goes idle
+    }
+    int fd = io_uring_setup_syscall(entries, &params);
+    if (fd == -1 && sqpoll) {
+        // SQPOLL needs privileges (or a 5.11+ kernel); fall back to plain submission
+        params = {};
+        params.flags |= iopoll ? IORING_SETUP_IOPOLL : 0;
+        fd = io_uring_setup_syscall(entries, &params);
+    }
+    throw_system_error_on(fd == -1, "io_uring_setup");
+    return file_desc::from_fd(fd);
+}
+
+uring_context::uring_context(bool sqpoll, bool iopoll)
+    : _sqpoll(sqpoll)
+    , _iopoll(iopoll)
+    , _ring_fd(make_ring(nr_entries, sqpoll, iopoll, _params)) {
+    _sqpoll = _params.flags & IORING_SETUP_SQPOLL;
+    _sq_mmap_size = _params.sq_off.array + _params.sq_entries * sizeof(unsigned);
+    _cq_mmap_size = _params.cq_off.cqes + _params.cq_entries * sizeof(::io_uring_cqe);
+    bool single_mmap = _params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        _sq_mmap_size = _cq_mmap_size = std::max(_sq_mmap_size, _cq_mmap_size);
+    }
+    _sq_mmap = ::mmap(nullptr, _sq_mmap_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, _ring_fd.get(), IORING_OFF_SQ_RING);
+    throw_system_error_on(_sq_mmap == MAP_FAILED, "mmap");
+    if (single_mmap) {
+        _cq_mmap = nullptr;
+    } else {
+        _cq_mmap = ::mmap(nullptr, _cq_mmap_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, _ring_fd.get(), IORING_OFF_CQ_RING);
+        throw_system_error_on(_cq_mmap == MAP_FAILED, "mmap");
+    }
+    _sqes_mmap_size = _params.sq_entries * sizeof(::io_uring_sqe);
+    auto sqes = ::mmap(nullptr, _sqes_mmap_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, _ring_fd.get(), IORING_OFF_SQES);
+    throw_system_error_on(sqes == MAP_FAILED, "mmap");
+    _sqes = reinterpret_cast<::io_uring_sqe*>(sqes);
+    auto sq = reinterpret_cast<char*>(_sq_mmap);
+    _sq_khead = reinterpret_cast<unsigned*>(sq + _params.sq_off.head);
+    _sq_ktail = reinterpret_cast<unsigned*>(sq + _params.sq_off.tail);
+    _sq_kflags = reinterpret_cast<unsigned*>(sq + _params.sq_off.flags);
+    _sq_array = reinterpret_cast<unsigned*>(sq + _params.sq_off.array);
+    _sq_mask = *reinterpret_cast<unsigned*>(sq + _params.sq_off.ring_mask);
+    auto cq = single_mmap ? sq : reinterpret_cast<char*>(_cq_mmap);
+    _cq_khead = reinterpret_cast<unsigned*>(cq + _params.cq_off.head);
+    _cq_ktail = reinterpret_cast<unsigned*>(cq + _params.cq_off.tail);
+    _cq_mask = *reinterpret_cast<unsigned*>(cq + _params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<::io_uring_cqe*>(cq + _params.cq_off.cqes);
+    _sq_local_tail = *_sq_ktail;
+}
+
+uring_context::~uring_context() {
+    ::munmap(_sqes, _sqes_mmap_size);
+    ::munmap(_sq_mmap, _sq_mmap_size);
+    if (_cq_mmap) {
+        ::munmap(_cq_mmap, _cq_mmap_size);
+    }
+}
+
+::io_uring_sqe& uring_context::get_sqe() {
+    // The kernel consumes all entries on io_uring_enter(), so after a flush()
+    // the queue always has room; with SQPOLL the poller thread may lag briefly.
+    while (_sq_local_tail - __atomic_load_n(_sq_khead, __ATOMIC_ACQUIRE) >= _params.sq_entries) {
+        flush();
+    }
+    auto idx = _sq_local_tail & _sq_mask;
+    auto& sqe = _sqes[idx];
+    sqe = {};
+    _sq_array[idx] = idx;
+    ++_sq_local_tail;
+    ++_to_submit;
+    // The new tail is only published to the kernel in flush(), once the
+    // caller has filled the entry in. With SQPOLL the poller thread
+    // consumes entries as soon as the tail moves, so publishing here
+    // would race it against the caller and could submit a zeroed sqe.
+    return sqe;
+}
+
+void uring_context::queue_poll_add(int fd, int events, void* user_data) {
+    auto& sqe = get_sqe();
+    sqe.opcode = IORING_OP_POLL_ADD;
+    sqe.fd = fd;
+    sqe.poll_events = events;
+    sqe.user_data = reinterpret_cast<uintptr_t>(user_data);
+}
+
+size_t uring_context::flush() {
+    auto nr = std::exchange(_to_submit, 0u);
+    // All queued entries are fully written by now; make them visible to
+    // the kernel in one go.
+    __atomic_store_n(_sq_ktail, _sq_local_tail, __ATOMIC_RELEASE);
+    if (_sqpoll) {
+        // The poller thread picks entries up on its own; we only need to kick
+        // it if it went idle.
+        if (__atomic_load_n(_sq_kflags, __ATOMIC_ACQUIRE) & IORING_SQ_NEED_WAKEUP) {
+            auto r = io_uring_enter_syscall(_ring_fd.get(), 0, 0, IORING_ENTER_SQ_WAKEUP, nullptr);
+            assert(r >= 0 || errno == EINTR);
+        }
+        return nr;
+    }
+    size_t submitted = 0;
+    while (submitted < nr) {
+        auto r = io_uring_enter_syscall(_ring_fd.get(), nr - submitted, 0, 0, nullptr);
+        if (r == -1) {
+            switch (errno) {
+            case EINTR:
+                continue;
+            case EAGAIN:
+            case EBUSY:
+                // completion queue is backed up; drain it and retry
+                reap_completions();
+                continue;
+            default:
+                throw_system_error_on(true, "io_uring_enter");
+            }
+        }
+        submitted += r;
+    }
+    return nr;
+}
+
+size_t uring_context::reap_completions() {
+    auto head = *_cq_khead;
+    auto tail = __atomic_load_n(_cq_ktail, __ATOMIC_ACQUIRE);
+    size_t nr = 0;
+    while (head != tail) {
+        auto& cqe = _cqes[head & _cq_mask];
+        auto* desc = reinterpret_cast<kernel_completion*>(uintptr_t(cqe.user_data));
+        auto res = cqe.res;
+        ++head;
+        ++nr;
+        // completing may reenter get_sqe(), so release the entry first
+        __atomic_store_n(_cq_khead, head, __ATOMIC_RELEASE);
+        desc->complete_with(res);
+    }
+    return nr;
+}
+
+size_t uring_context::poll_completions() {
+    auto r = io_uring_enter_syscall(_ring_fd.get(), 0, 0, IORING_ENTER_GETEVENTS, nullptr);
+    if (r == -1) {
+        assert(errno == EINTR || errno == EBUSY);
+    }
+    return reap_completions();
+}
+
+void uring_context::wait(const sigset_t* active_sigmask) {
+    auto r = io_uring_enter_syscall(_ring_fd.get(), 0, 1, IORING_ENTER_GETEVENTS, active_sigmask);
+    if (r == -1) {
+        assert(errno == EINTR);
+    }
+}
+
+namespace internal {
+
+thread_local void* (*allocate_registered_buffer_hook)(size_t size, size_t align) = nullptr;
+thread_local char* registered_buffer_base = nullptr;
+thread_local size_t registered_buffer_size = 0;
+thread_local uring_buffer_pool* registered_buffer_pool = nullptr;
+
+void free_registered_buffer(void* p) noexcept {
+    registered_buffer_pool->free(p);
+}
+
+}
+
+int uring_buffer_pool::size_class(size_t size) {
+    if (size > (min_chunk << (nr_size_classes - 1))) {
+        return -1;
+    }
+    unsigned cls = 0;
+    while ((min_chunk << cls) < size) {
+        ++cls;
+    }
+    return cls;
+}
+
+bool uring_buffer_pool::create(uring_context& ring) {
+    auto mem = ::mmap(nullptr, pool_bytes, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_POPULATE, -1, 0);
+    if (mem == MAP_FAILED) {
+        return false;
+    }
+    ::iovec iov = { mem, pool_bytes };
+    auto r = ::syscall(__NR_io_uring_register, ring.ring_fd(), IORING_REGISTER_BUFFERS, &iov, 1);
+    if (r == -1) {
+        // typically RLIMIT_MEMLOCK; run without registered buffers
+        ::munmap(mem, pool_bytes);
+        return false;
+    }
+    _base = reinterpret_cast<char*>(mem);
+    _size = pool_bytes;
+    _next = _base;
+    _chunk_class.resize(pool_bytes / min_chunk);
+    return true;
+}
+
+uring_buffer_pool::~uring_buffer_pool() {
+    if (_base) {
+        // buffers are unregistered implicitly when the ring fd is closed
+        ::munmap(_base, _size);
+    }
+}
+
+void* uring_buffer_pool::allocate(size_t size, size_t align) noexcept {
+    auto cls = size_class(std::max(size, align));
+    if (cls < 0 || align > (min_chunk << cls)) {
+        return nullptr;
+    }
+    if (!_free_chunks[cls].empty()) {
+        auto* p = _free_chunks[cls].back();
+        _free_chunks[cls].pop_back();
+        return p;
+    }
+    auto chunk_size = min_chunk << cls;
+    // carve in class-size units, so chunks stay naturally aligned
+    auto* p = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(_next) + chunk_size - 1) & ~uintptr_t(chunk_size - 1));
+    if (p + chunk_size > _base + _size) {
+        return nullptr;
+    }
+    _next = p + chunk_size;
+    _chunk_class[(p - _base) / min_chunk] = cls;
+    return p;
+}
+
+void uring_buffer_pool::free(void* ptr) noexcept {
+    auto* p = reinterpret_cast<char*>(ptr);
+    auto cls = _chunk_class[(p - _base) / min_chunk];
+    _free_chunks[cls].push_back(p);
+}
+
+// Completion of a metadata operation: resolves the caller's future with the
+// raw kernel result and owns the pathname until the operation is done.
+struct uring_metadata_completion final : public kernel_completion {
+    promise<ssize_t> result;
+    sstring path;
+    virtual void complete_with(ssize_t res) override {
+        result.set_value(res);
+        delete this;
+    }
+};
+
+bool reactor_backend_uring::supports_async_metadata() const {
+    return _metadata_ops_enabled;
+}
+
+void reactor_backend_uring::detect_metadata_ops() {
+    // IORING_REGISTER_PROBE appeared in 5.6 together with the metadata
+    // opcodes; on older kernels the probe itself fails.
+    alignas(::io_uring_probe) char buf[sizeof(::io_uring_probe) + IORING_OP_LAST * sizeof(::io_uring_probe_op)] = {};
+    auto* probe = reinterpret_cast<::io_uring_probe*>(buf);
+    auto r = ::syscall(__NR_io_uring_register, _uring.ring_fd(), IORING_REGISTER_PROBE, probe, IORING_OP_LAST);
+    if (r == -1) {
+        return;
+    }
+    auto supported = [probe] (unsigned op) {
+        return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+    };
+    _metadata_ops_enabled = supported(IORING_OP_OPENAT) && supported(IORING_OP_STATX) && supported(IORING_OP_FALLOCATE);
+}
+
+future<ssize_t> reactor_backend_uring::submit_openat(sstring pathname, int flags, mode_t mode) {
+    auto c = std::make_unique<uring_metadata_completion>();
+    c->path = std::move(pathname);
+    auto& sqe = _uring.get_sqe();
+    sqe.opcode = IORING_OP_OPENAT;
+    sqe.fd = AT_FDCWD;
+    sqe.addr = reinterpret_cast<uintptr_t>(c->path.c_str());
+    sqe.open_flags = flags;
+    sqe.len = mode;
+    sqe.user_data = reinterpret_cast<uintptr_t>(static_cast<kernel_completion*>(c.get()));
+    return c.release()->result.get_future();
+}
+
+future<ssize_t> reactor_backend_uring::submit_statx(int dirfd, sstring pathname, int flags, unsigned mask, struct ::statx* buf) {
+    auto c = std::make_unique<uring_metadata_completion>();
+    c->path = std::move(pathname);
+    auto& sqe = _uring.get_sqe();
+    sqe.opcode = IORING_OP_STATX;
+    sqe.fd = dirfd;
+    sqe.addr = reinterpret_cast<uintptr_t>(c->path.c_str());
+    sqe.statx_flags = flags;
+    sqe.len = mask;
+    sqe.off = reinterpret_cast<uintptr_t>(buf);
+    sqe.user_data = reinterpret_cast<uintptr_t>(static_cast<kernel_completion*>(c.get()));
+    return c.release()->result.get_future();
+}
+
+future<ssize_t> reactor_backend_uring::submit_fallocate(int fd, int mode, uint64_t offset, uint64_t length) {
+    auto c = std::make_unique<uring_metadata_completion>();
+    auto& sqe = _uring.get_sqe();
+    sqe.opcode = IORING_OP_FALLOCATE;
+    sqe.fd = fd;
+    sqe.off = offset;
+    sqe.addr = length;
+    sqe.len = mode;
+    sqe.user_data = reinterpret_cast<uintptr_t>(static_cast<kernel_completion*>(c.get()));
+    return c.release()->result.get_future();
+}
+
+uring_context& reactor_backend_uring::ring_for(const io_request& req) {
+    // Only reads and writes may be submitted to a polled ring; fsyncs (and
+    // anything else) keep using the interrupt-driven ring.
+    if (_storage_ring) {
+        switch (req.opcode()) {
+        case io_request::operation::read:
+        case io_request::operation::readv:
+        case io_request::operation::write:
+        case io_request::operation::writev:
+            return *_storage_ring;
+        default:
+            break;
+        }
+    }
+    return _uring;
+}
+
+void reactor_backend_uring::prepare_sqe(io_request& req, io_completion* desc, ::io_uring_sqe& sqe, bool allow_fixed) {
+    sqe.fd = req.fd();
+    if (allow_fixed && _fixed_files_enabled) {
+        auto it = _fixed_files.find(req.fd());
+        if (it != _fixed_files.end()) {
+            sqe.fd = it->second;
+            sqe.flags |= IOSQE_FIXED_FILE;
+        }
+    }
+    switch (req.opcode()) {
+    case io_request::operation::fdatasync:
+        sqe.opcode = IORING_OP_FSYNC;
+        sqe.fsync_flags = IORING_FSYNC_DATASYNC;
+        break;
+    case io_request::operation::write:
+        sqe.opcode = IORING_OP_WRITE;
+        sqe.off = req.pos();
+        sqe.addr = reinterpret_cast<uintptr_t>(req.address());
+        sqe.len = req.size();
+        if (allow_fixed && _buffer_pool.contains(req.address())) {
+            sqe.opcode = IORING_OP_WRITE_FIXED;
+            sqe.buf_index = 0;
+        }
+        break;
+    case io_request::operation::writev:
+        sqe.opcode = IORING_OP_WRITEV;
+        sqe.off = req.pos();
+        sqe.addr = reinterpret_cast<uintptr_t>(req.iov());
+        sqe.len = req.size();
+        break;
+    case io_request::operation::read:
+        sqe.opcode = IORING_OP_READ;
+        sqe.off = req.pos();
+        sqe.addr = reinterpret_cast<uintptr_t>(req.address());
+        sqe.len = req.size();
+        if (allow_fixed && _buffer_pool.contains(req.address())) {
+            sqe.opcode = IORING_OP_READ_FIXED;
+            sqe.buf_index = 0;
+        }
+        break;
+    case io_request::operation::readv:
+        sqe.opcode = IORING_OP_READV;
+        sqe.off = req.pos();
+        sqe.addr = reinterpret_cast<uintptr_t>(req.iov());
+        sqe.len = req.size();
+        break;
+    default:
+        seastar_logger.error("Invalid operation for sqe: {}", req.opname());
+        std::abort();
+    }
+    sqe.user_data = reinterpret_cast<uintptr_t>(static_cast<kernel_completion*>(desc));
+}
+
+hrtimer_uring_completion::hrtimer_uring_completion(reactor& r, file_desc& fd)
+    : fd_kernel_completion(fd)
+    , completion_with_poll_sqe(fd.get(), POLLIN, this)
+    , _r(r) {}
+
+smp_wakeup_uring_completion::smp_wakeup_uring_completion(file_desc& fd)
+    : fd_kernel_completion(fd)
+    , completion_with_poll_sqe(fd.get(), POLLIN, this) {}
+
+void
+hrtimer_uring_completion::complete_with(ssize_t ret) {
+    uint64_t expirations = 0;
+    (void)_fd.read(&expirations, 8);
+    if (expirations) {
+        _r.service_highres_timer();
+    }
+    completed();
+}
+
+void
+smp_wakeup_uring_completion::complete_with(ssize_t ret) {
+    uint64_t ignore = 0;
+    (void)_fd.read(&ignore, 8);
+    completed();
+}
+
+class uring_pollable_fd_state : public pollable_fd_state {
+    pollable_fd_state_completion _completion_pollin;
+    pollable_fd_state_completion _completion_pollout;
+public:
+    pollable_fd_state_completion* get_desc(int events) {
+        if (events & POLLIN) {
+            return &_completion_pollin;
+        }
+        return &_completion_pollout;
+    }
+    explicit uring_pollable_fd_state(file_desc fd, speculation speculate)
+        : pollable_fd_state(std::move(fd), std::move(speculate))
+    {}
+    future<> get_completion_future(int events) {
+        return get_desc(events)->get_future();
+    }
+};
+
+file_desc reactor_backend_uring::make_timerfd() {
+    return file_desc::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC|TFD_NONBLOCK);
+}
+
+bool reactor_backend_uring::detect_sqpoll() {
+    // Opt-in, since SQPOLL dedicates a kernel thread per shard.
+    auto var = ::getenv("SEASTAR_IO_URING_SQPOLL");
+    return var && var[0] == '1';
+}
+
+reactor_backend_uring::reactor_backend_uring(reactor& r)
+    : _r(r)
+    , _hrtimer_timerfd(make_timerfd())
+    , _preempting_io(_r, _r._task_quota_timer, _hrtimer_timerfd)
+    , _uring(detect_sqpoll(), false)
+    , _hrtimer_completion(_r, _hrtimer_timerfd)
+    , _smp_wakeup_completion(_r._notify_eventfd)
+{
+    // Protect against spurious wakeups - if we get notified that the timer has
+    // expired when it really hasn't, we don't want to block in read(tfd, ...).
+    auto tfd = _r._task_quota_timer.get();
+    ::fcntl(tfd, F_SETFL, ::fcntl(tfd, F_GETFL) | O_NONBLOCK);
+
+    sigset_t mask = make_sigset_mask(hrtimer_signal());
+    auto e = ::pthread_sigmask(SIG_BLOCK, &mask, NULL);
+    assert(e == 0);
+
+    if (detect_fixed()) {
+        setup_fixed_storage();
+    }
+
+    if (detect_iopoll() && !_r._kernel_page_cache) {
+        try {
+            _storage_ring = std::make_unique<uring_context>(detect_sqpoll(), true);
+        } catch (...) {
+            seastar_logger.warn("Could not create an IORING_SETUP_IOPOLL ring, storage completions will be interrupt driven: {}",
+                    std::current_exception());
+        }
+    }
+
+    detect_metadata_ops();
+}
+
+reactor_backend_uring::~reactor_backend_uring() {
+    if (_fixed_enabled) {
+        internal::allocate_registered_buffer_hook = nullptr;
+        internal::registered_buffer_base = nullptr;
+        internal::registered_buffer_size = 0;
+        internal::registered_buffer_pool = nullptr;
+    }
+}
+
+bool reactor_backend_uring::detect_fixed() {
+    // Opt-in: registered buffers consume RLIMIT_MEMLOCK and pool memory
+    // whether or not the workload benefits.
+    auto var = ::getenv("SEASTAR_IO_URING_FIXED");
+    return var && var[0] == '1';
+}
+
+bool reactor_backend_uring::detect_iopoll() {
+    // Opt-in: requires files on storage with polled completion queues,
+    // opened with O_DIRECT; on anything else reads and writes fail with
+    // EOPNOTSUPP.
+    auto var = ::getenv("SEASTAR_IO_URING_IOPOLL");
+    return var && var[0] == '1';
+}
+
+void reactor_backend_uring::setup_fixed_storage() {
+    _fixed_enabled = true;
+    if (_buffer_pool.create(_uring)) {
+        internal::registered_buffer_pool = &_buffer_pool;
+        internal::registered_buffer_base = _buffer_pool.base();
+        internal::registered_buffer_size = _buffer_pool.size();
+        internal::allocate_registered_buffer_hook = [] (size_t size, size_t align) -> void* {
+            return internal::registered_buffer_pool->allocate(size, align);
+        };
+    }
+    // Register a sparse fixed-file table; slots are filled in as files are
+    // opened. Older kernels (< 5.13) reject sparse tables, in which case we
+    // run without registered files.
+    std::vector<int> fds(fixed_file_table_size, -1);
+    auto r = ::syscall(__NR_io_uring_register, _uring.ring_fd(), IORING_REGISTER_FILES, fds.data(), fds.size());
+    if (r == 0) {
+        _fixed_files_enabled = true;
+        _free_fixed_slots.reserve(fixed_file_table_size);
+        for (unsigned i = 0; i < fixed_file_table_size; ++i) {
+            _free_fixed_slots.push_back(fixed_file_table_size - i - 1);
+        }
+    }
+}
+
+void reactor_backend_uring::register_storage_file(int fd) {
+    if (!_fixed_files_enabled || _free_fixed_slots.empty() || _fixed_files.count(fd)) {
+        return;
+    }
+    auto slot = _free_fixed_slots.back();
+    ::io_uring_files_update update = {};
+    update.offset = slot;
+    update.fds = reinterpret_cast<uintptr_t>(&fd);
+    auto r = ::syscall(__NR_io_uring_register, _uring.ring_fd(), IORING_REGISTER_FILES_UPDATE, &update, 1);
+    if (r == 1) {
+        _free_fixed_slots.pop_back();
+        _fixed_files.emplace(fd, slot);
+    }
+}
+
+void reactor_backend_uring::unregister_storage_file(int fd) {
+    auto it = _fixed_files.find(fd);
+    if (it == _fixed_files.end()) {
+        return;
+    }
+    auto slot = it->second;
+    _fixed_files.erase(it);
+    int minus_one = -1;
+    ::io_uring_files_update update = {};
+    update.offset = slot;
+    update.fds = reinterpret_cast<uintptr_t>(&minus_one);
+    auto r = ::syscall(__NR_io_uring_register, _uring.ring_fd(), IORING_REGISTER_FILES_UPDATE, &update, 1);
+    if (r == 1) {
+        _free_fixed_slots.push_back(slot);
+    }
+}
+
+bool reactor_backend_uring::reap_kernel_completions() {
+    bool did_work = _uring.reap_completions() > 0;
+    if (_storage_in_flight) {
+        auto nr = _storage_ring->poll_completions();
+        _storage_in_flight -= nr;
+        did_work |= nr > 0;
+    }
+    return did_work;
+}
+
+bool reactor_backend_uring::kernel_submit_work() {
+    _hrtimer_completion.maybe_queue(_uring);
+    bool did_work = _r._io_sink.drain([this] (internal::io_request& req, io_completion* desc) -> bool {
+        auto& ring = ring_for(req);
+        // fixed files and buffers are registered with the main ring only
+        prepare_sqe(req, desc, ring.get_sqe(), &ring == &_uring);
+        _storage_in_flight += &ring == _storage_ring.get();
+        return true;
+    }) > 0;
+    did_work |= _uring.flush() > 0;
+    if (_storage_ring) {
+        did_work |= _storage_ring->flush() > 0;
+    }
+    return did_work;
+}
+
+bool reactor_backend_uring::kernel_events_can_sleep() const {
+    // Completions on a polled ring are harvested only when we ask for them,
+    // so the reactor must keep polling until the in-flight storage I/O
+    // drains.
+    return _uring.can_sleep() && _storage_in_flight == 0;
+}
+
+void reactor_backend_uring::wait_and_process_events(const sigset_t* active_sigmask) {
+    bool did_work = _preempting_io.service_preempting_io();
+    _hrtimer_completion.maybe_queue(_uring);
+    _smp_wakeup_completion.maybe_queue(_uring);
+    _uring.flush();
+    if (!did_work) {
+        _uring.wait(active_sigmask);
+    }
+    _uring.reap_completions();
+    _preempting_io.service_preempting_io(); // clear task quota timer
+}
+
+future<> reactor_backend_uring::poll(pollable_fd_state& fd, int events) {
+    try {
+        if (events & fd.events_known) {
+            fd.events_known &= ~events;
+            return make_ready_future<>();
+        }
+
+        fd.events_rw = events == (POLLIN|POLLOUT);
+
+        auto* pfd = static_cast<uring_pollable_fd_state*>(&fd);
+        auto* desc = pfd->get_desc(events);
+        *desc = pollable_fd_state_completion{};
+        _uring.queue_poll_add(fd.fd.get(), events, desc);
+        return pfd->get_completion_future(events);
+    } catch (...) {
+        return make_exception_future<>(std::current_exception());
+    }
+}
+
+future<> reactor_backend_uring::readable(pollable_fd_state& fd) {
+    return poll(fd, POLLIN);
+}
+
+future<> reactor_backend_uring::writeable(pollable_fd_state& fd) {
+    return poll(fd, POLLOUT);
+}
+
+future<> reactor_backend_uring::readable_or_writeable(pollable_fd_state& fd) {
+    return poll(fd, POLLIN|POLLOUT);
+}
+
+void reactor_backend_uring::forget(pollable_fd_state& fd) noexcept {
+    auto* pfd = static_cast<uring_pollable_fd_state*>(&fd);
+    delete pfd;
+    // ?
+}
+
+void reactor_backend_uring::detach(pollable_fd_state& fd) noexcept {
+    // poll_add submissions are one-shot; with no outstanding operations
+    // nothing in the kernel refers to the state.
+}
+
+future<std::tuple<pollable_fd, socket_address>>
+reactor_backend_uring::accept(pollable_fd_state& listenfd) {
+    return engine().do_accept(listenfd);
+}
+
+future<> reactor_backend_uring::connect(pollable_fd_state& fd, socket_address& sa) {
+    return engine().do_connect(fd, sa);
+}
+
+void reactor_backend_uring::shutdown(pollable_fd_state& fd, int how) {
+    fd.fd.shutdown(how);
+}
+
+future<size_t>
+reactor_backend_uring::read_some(pollable_fd_state& fd, void* buffer, size_t len) {
+    return engine().do_read_some(fd, buffer, len);
+}
+
+future<size_t>
+reactor_backend_uring::read_some(pollable_fd_state& fd, const std::vector<iovec>& iov) {
+    return engine().do_read_some(fd, iov);
+}
+
+future<temporary_buffer<char>>
+reactor_backend_uring::read_some(pollable_fd_state& fd, internal::buffer_allocator* ba) {
+    return engine().do_read_some(fd, ba);
+}
+
+future<size_t>
+reactor_backend_uring::write_some(pollable_fd_state& fd, const void* buffer, size_t len) {
+    return engine().do_write_some(fd, buffer, len);
+}
+
+future<size_t>
+reactor_backend_uring::write_some(pollable_fd_state& fd, net::packet& p) {
+    return engine().do_write_some(fd, p);
+}
+
+void reactor_backend_uring::signal_received(int signo, siginfo_t* siginfo, void* ignore) {
+    engine()._signals.action(signo, siginfo, ignore);
+}
+
+void reactor_backend_uring::start_tick() {
+    _preempting_io.start_tick();
+}
+
+void reactor_backend_uring::stop_tick() {
+    _preempting_io.stop_tick();
+}
+
+void reactor_backend_uring::arm_highres_timer(const ::itimerspec& its) {
+    _hrtimer_timerfd.timerfd_settime(TFD_TIMER_ABSTIME, its);
+}
+
+void reactor_backend_uring::reset_preemption_monitor() {
+    _preempting_io.reset_preemption_monitor();
+}
+
+void reactor_backend_uring::request_preemption() {
+    _preempting_io.request_preemption();
+}
+
+void reactor_backend_uring::start_handling_signal() {
+    // The uring backend only uses SIGHUP/SIGTERM/SIGINT. We don't need to handle them right away and our
+    // implementation of request_preemption is not signal safe, so do nothing.
+}
+
+pollable_fd_state_ptr
+reactor_backend_uring::make_pollable_fd_state(file_desc fd, pollable_fd::speculation speculate) {
+    return pollable_fd_state_ptr(new uring_pollable_fd_state(std::move(fd), std::move(speculate)));
+}
+
+static bool detect_io_uring() {
+    ::io_uring_params params = {};
+    int fd = io_uring_setup_syscall(1, &params);
+    if (fd == -1) {
+        return false;
+    }
+    auto cleanup = defer([&] { ::close(fd); });
+    // Probe for the opcodes we rely on. IORING_REGISTER_PROBE itself needs a
+    // 5.6 kernel, the same one that introduced the non-vectored read/write
+    // opcodes, so an older kernel fails here rather than at submission time.
+    char buf[sizeof(::io_uring_probe) + IORING_OP_LAST * sizeof(::io_uring_probe_op)] = {};
+    auto* probe = reinterpret_cast<::io_uring_probe*>(buf);
+    auto r = ::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, IORING_OP_LAST);
+    if (r == -1) {
+        return false;
+    }
+    for (auto op : {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READV, IORING_OP_WRITEV, IORING_OP_FSYNC, IORING_OP_POLL_ADD}) {
+        if (op >= probe->ops_len || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif /* SEASTAR_HAVE_URING */
+
 static bool detect_aio_poll() {
     auto fd = file_desc::eventfd(0, 0);
     aio_context_t ioc{};
@@ -1095,6 +1922,10 @@ bool reactor_backend_selector::has_enough_aio_nr() {
 std::unique_ptr<reactor_backend> reactor_backend_selector::create(reactor& r) {
     if (_name == "linux-aio") {
         return std::make_unique<reactor_backend_aio>(r);
+#ifdef SEASTAR_HAVE_URING
+    } else if (_name == "io-uring") {
+        return std::make_unique<reactor_backend_uring>(r);
+#endif
     } else if (_name == "epoll") {
         return std::make_unique<reactor_backend_epoll>(r);
     }
@@ -1110,6 +1941,11 @@ std::vector<reactor_backend_selector> reactor_backend_selector::available() {
     if (detect_aio_poll() && has_enough_aio_nr()) {
         ret.push_back(reactor_backend_selector("linux-aio"));
     }
+#ifdef SEASTAR_HAVE_URING
+    if (detect_io_uring()) {
+        ret.push_back(reactor_backend_selector("io-uring"));
+    }
+#endif
     ret.push_back(reactor_backend_selector("epoll"));
     return ret;
 }
@@ -26,11 +26,14 @@
 #include <seastar/core/internal/pollable_fd.hh>
 #include <seastar/core/internal/poll.hh>
 #include <seastar/core/linux-aio.hh>
+#include <seastar/core/internal/io_request.hh>
 #include <seastar/core/cacheline.hh>
 #include <sys/time.h>
 #include <signal.h>
 #include <thread>
 #include <stack>
+#include <unordered_map>
+#include <vector>
 #include <boost/any.hpp>
 #include <boost/program_options.hpp>
 #include <boost/container/static_vector.hpp>
@@ -39,9 +42,15 @@
 #include <osv/newpoll.hh>
 #endif
 
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define SEASTAR_HAVE_URING
+#endif
+
 namespace seastar {
 
 class reactor;
+class io_completion;
 
 // FIXME: merge it with storage context below. At this point the
 // main thing to do is unify the iocb list
@@ -179,6 +188,11 @@ public:
     virtual future<> writeable(pollable_fd_state& fd) = 0;
     virtual future<> readable_or_writeable(pollable_fd_state& fd) = 0;
     virtual void forget(pollable_fd_state& fd) noexcept = 0;
+    // Withdraws any lingering kernel registration of the fd while it is
+    // still open, so its file_desc can be stolen (e.g. for migration to
+    // another shard) without leaving the backend pointing at the state.
+    // Must be called with no outstanding operations on the fd.
+    virtual void detach(pollable_fd_state& fd) noexcept = 0;
 
     virtual future<std::tuple<pollable_fd, socket_address>>
     accept(pollable_fd_state& listenfd) = 0;
@@ -199,6 +213,23 @@ public:
     virtual void start_handling_signal() = 0;
 
     virtual pollable_fd_state_ptr make_pollable_fd_state(file_desc fd, pollable_fd::speculation speculate) = 0;
+
+    // Storage-path optimizations implemented by the io_uring backend; other
+    // backends ignore these. register_storage_file() is called when a file
+    // is opened so the backend may pre-validate ("register") the fd with the
+    // kernel and skip the per-submission fd lookup.
+    virtual void register_storage_file(int fd) {}
+    virtual void unregister_storage_file(int fd) {}
+
+    // Asynchronous metadata operations. A backend that can submit these to
+    // the kernel without blocking returns true from
+    // supports_async_metadata(); callers of the submit methods must check it
+    // first and otherwise use the syscall thread pool. Results follow the
+    // kernel convention: a negative value is a negated errno.
+    virtual bool supports_async_metadata() const { return false; }
+    virtual future<ssize_t> submit_openat(sstring pathname, int flags, mode_t mode);
+    virtual future<ssize_t> submit_statx(int dirfd, sstring pathname, int flags, unsigned mask, struct ::statx* buf);
+    virtual future<ssize_t> submit_fallocate(int fd, int mode, uint64_t offset, uint64_t length);
 };
 
 // reactor backend using file-descriptor & epoll, suitable for running on
@@ -241,6 +272,7 @@ public:
     virtual future<> writeable(pollable_fd_state& fd) override;
     virtual future<> readable_or_writeable(pollable_fd_state& fd) override;
     virtual void forget(pollable_fd_state& fd) noexcept override;
+    virtual void detach(pollable_fd_state& fd) noexcept override;
 
     virtual future<std::tuple<pollable_fd, socket_address>>
     accept(pollable_fd_state& listenfd) override;
@@ -289,6 +321,7 @@ public:
     virtual future<> writeable(pollable_fd_state& fd) override;
     virtual future<> readable_or_writeable(pollable_fd_state& fd) override;
     virtual void forget(pollable_fd_state& fd) noexcept override;
+    virtual void detach(pollable_fd_state& fd) noexcept override;
 
     virtual future<std::tuple<pollable_fd, socket_address>>
     accept(pollable_fd_state& listenfd) override;
@@ -312,6 +345,218 @@ public:
     make_pollable_fd_state(file_desc fd, pollable_fd::speculation speculate) override;
 };
 
+#ifdef SEASTAR_HAVE_URING
+
+// Minimal io_uring wrapper, in the spirit of core/linux-aio.hh: we drive the
+// ring through raw system calls and mmap()ed queues instead of depending on
+// liburing. One instance serves both storage I/O and fd polling, so a single
+// io_uring_enter() replaces the io_submit()/io_pgetevents() pairs of the
+// linux-aio backend.
+class uring_context {
+    static constexpr unsigned nr_entries = 1024;
+    bool _sqpoll;
+    bool _iopoll;
+    ::io_uring_params _params = {};
+    file_desc _ring_fd;
+    // submission and completion rings, mmap()ed from the ring fd
+    void* _sq_mmap = nullptr;
+    size_t _sq_mmap_size = 0;
+    void* _cq_mmap = nullptr;  // nullptr with IORING_FEAT_SINGLE_MMAP
+    size_t _cq_mmap_size = 0;
+    ::io_uring_sqe* _sqes = nullptr;
+    size_t _sqes_mmap_size = 0;
+    unsigned* _sq_khead = nullptr;
+    unsigned* _sq_ktail = nullptr;
+    unsigned* _sq_kflags = nullptr;
+    unsigned* _sq_array = nullptr;
+    unsigned _sq_mask = 0;
+    unsigned* _cq_khead = nullptr;
+    unsigned* _cq_ktail = nullptr;
+    unsigned _cq_mask = 0;
+    ::io_uring_cqe* _cqes = nullptr;
+    unsigned _sq_local_tail = 0;
+    unsigned _to_submit = 0;
+private:
+    static file_desc make_ring(unsigned entries, bool sqpoll, bool iopoll, ::io_uring_params& params);
+public:
+    uring_context(bool sqpoll, bool iopoll);
+    ~uring_context();
+    uring_context(const uring_context&) = delete;
+
+    // Returns a submission queue entry, flushing the queue to the kernel
+    // if it is full. Never returns nullptr.
+    ::io_uring_sqe& get_sqe();
+    void queue_poll_add(int fd, int events, void* user_data);
+    size_t flush();
+    size_t reap_completions();
+    // Harvests completions from a polled (IORING_SETUP_IOPOLL) ring. The
+    // kernel checks the device completion queues only when asked to, so a
+    // non-blocking GETEVENTS pass is made before reaping.
+    size_t poll_completions();
+    void wait(const sigset_t* active_sigmask);
+    int ring_fd() const {
+        return _ring_fd.get();
+    }
+    unsigned sq_entries() const {
+        return _params.sq_entries;
+    }
+    bool can_sleep() const {
+        // Unlike linux-aio, any completion posted to the ring wakes up
+        // io_uring_enter(GETEVENTS), so in-flight storage I/O does not
+        // prevent sleeping.
+        return true;
+    }
+};
+
+// Re-arming poll registration on the ring, the io_uring counterpart of
+// completion_with_iocb.
+class completion_with_poll_sqe {
+    bool _armed = false;
+    int _poll_fd;
+    int _poll_events;
+    void* _user_data;
+protected:
+    completion_with_poll_sqe(int fd, int events, void* user_data)
+        : _poll_fd(fd), _poll_events(events), _user_data(user_data) {}
+    void completed() {
+        _armed = false;
+    }
+public:
+    void maybe_queue(uring_context& context) {
+        if (!_armed) {
+            _armed = true;
+            context.queue_poll_add(_poll_fd, _poll_events, _user_data);
+        }
+    }
+};
+
+// Pre-registered DMA buffer pool (IORING_REGISTER_BUFFERS). One large
+// region is pinned and registered with the ring once, and aligned DMA
+// buffers are carved from it in power-of-two size classes, so reads and
+// writes of pool memory can be submitted as IORING_OP_READ_FIXED /
+// IORING_OP_WRITE_FIXED.
+class uring_buffer_pool {
+    static constexpr size_t pool_bytes = 16 << 20;
+    static constexpr size_t min_chunk = 4096;
+    static constexpr unsigned nr_size_classes = 6; // 4k .. 128k
+    char* _base = nullptr;
+    size_t _size = 0;
+    char* _next = nullptr; // carving frontier
+    std::array<std::vector<char*>, nr_size_classes> _free_chunks;
+    std::vector<uint8_t> _chunk_class; // indexed by offset / min_chunk
+    static int size_class(size_t size);
+public:
+    ~uring_buffer_pool();
+    // mmap()s and registers the pool; returns false (leaving the pool
+    // disabled) if registration fails, e.g. due to RLIMIT_MEMLOCK.
+    bool create(uring_context& ring);
+    void* allocate(size_t size, size_t align) noexcept;
+    void free(void* p) noexcept;
+    bool contains(const void* p) const noexcept {
+        return reinterpret_cast<const char*>(p) >= _base && reinterpret_cast<const char*>(p) < _base + _size;
+    }
+    char* base() const { return _base; }
+    size_t size() const { return _size; }
+};
+
+struct hrtimer_uring_completion : public fd_kernel_completion,
+                                  public completion_with_poll_sqe {
+private:
+    reactor& _r;
+public:
+    hrtimer_uring_completion(reactor& r, file_desc& fd);
+    virtual void complete_with(ssize_t value) override;
+};
+
+struct smp_wakeup_uring_completion : public fd_kernel_completion,
+                                     public completion_with_poll_sqe {
+    smp_wakeup_uring_completion(file_desc& fd);
+    virtual void complete_with(ssize_t value) override;
+};
+
+// reactor backend that funnels storage I/O, socket polling and the high
+// resolution timer through a single io_uring instance. Preemption (the task
+// quota timer) still goes through the small linux-aio preempt_io_context,
+// whose completion memory is cheap to poll from userspace.
+class reactor_backend_uring : public reactor_backend {
+    reactor& _r;
+    file_desc _hrtimer_timerfd;
+    preempt_io_context _preempting_io; // Used for the timer tick and the high resolution timer
+    uring_context _uring;
+    hrtimer_uring_completion _hrtimer_completion;
+    smp_wakeup_uring_completion _smp_wakeup_completion;
+    // Opt-in registered files and registered buffers (SEASTAR_IO_URING_FIXED=1)
+    static constexpr unsigned fixed_file_table_size = 4096;
+    bool _fixed_enabled = false;
+    bool _fixed_files_enabled = false;
+    uring_buffer_pool _buffer_pool;
+    std::unordered_map<int, unsigned> _fixed_files; // fd -> fixed file slot
+    std::vector<unsigned> _free_fixed_slots;
+    // Opt-in completion polling for low-latency storage (SEASTAR_IO_URING_IOPOLL=1):
+    // reads and writes go through a second, IORING_SETUP_IOPOLL ring whose
+    // completions the reactor polls from its loop instead of waiting for a
+    // device interrupt. Requires storage with polled completion queues
+    // (e.g. nvme.poll_queues).
+    std::unique_ptr<uring_context> _storage_ring;
+    unsigned _storage_in_flight = 0;
+    // Metadata operations (openat/statx/fallocate) are available from
+    // kernel 5.6 on; probed at startup.
+    bool _metadata_ops_enabled = false;
+    static file_desc make_timerfd();
+    static bool detect_sqpoll();
+    static bool detect_fixed();
+    static bool detect_iopoll();
+    void setup_fixed_storage();
+    void detect_metadata_ops();
+    uring_context& ring_for(const internal::io_request& req);
+    void prepare_sqe(internal::io_request& req, io_completion* desc, ::io_uring_sqe& sqe, bool allow_fixed);
+public:
+    explicit reactor_backend_uring(reactor& r);
+    virtual ~reactor_backend_uring() override;
+
+    virtual bool reap_kernel_completions() override;
+    virtual bool kernel_submit_work() override;
+    virtual bool kernel_events_can_sleep() const override;
+    virtual void wait_and_process_events(const sigset_t* active_sigmask) override;
+    future<> poll(pollable_fd_state& fd, int events);
+    virtual future<> readable(pollable_fd_state& fd) override;
+    virtual future<> writeable(pollable_fd_state& fd) override;
+    virtual future<> readable_or_writeable(pollable_fd_state& fd) override;
+    virtual void forget(pollable_fd_state& fd) noexcept override;
+    virtual void detach(pollable_fd_state& fd) noexcept override;
+
+    virtual future<std::tuple<pollable_fd, socket_address>>
+    accept(pollable_fd_state& listenfd) override;
+    virtual future<> connect(pollable_fd_state& fd, socket_address& sa) override;
+    virtual void shutdown(pollable_fd_state& fd, int how) override;
+    virtual future<size_t> read_some(pollable_fd_state& fd, void* buffer, size_t len) override;
+    virtual future<size_t> read_some(pollable_fd_state& fd, const std::vector<iovec>& iov) override;
+    virtual future<temporary_buffer<char>> read_some(pollable_fd_state& fd, internal::buffer_allocator* ba) override;
+    virtual future<size_t> write_some(pollable_fd_state& fd, net::packet& p) override;
+    virtual future<size_t> write_some(pollable_fd_state& fd, const void* buffer, size_t len) override;
+
+    virtual void signal_received(int signo, siginfo_t* siginfo, void* ignore) override;
+    virtual void start_tick() override;
+    virtual void stop_tick() override;
+    virtual void arm_highres_timer(const ::itimerspec& its) override;
+    virtual void reset_preemption_monitor() override;
+    virtual void request_preemption() override;
+    virtual void start_handling_signal() override;
+
+    virtual pollable_fd_state_ptr
+    make_pollable_fd_state(file_desc fd, pollable_fd::speculation speculate) override;
+
+    virtual void register_storage_file(int fd) override;
+    virtual void unregister_storage_file(int fd) override;
+
+    virtual bool supports_async_metadata() const override;
+    virtual future<ssize_t> submit_openat(sstring pathname, int flags, mode_t mode) override;
+    virtual future<ssize_t> submit_statx(int dirfd, sstring pathname, int flags, unsigned mask, struct ::statx* buf) override;
+    virtual future<ssize_t> submit_fallocate(int fd, int mode, uint64_t offset, uint64_t length) override;
+};
+
+#endif /* SEASTAR_HAVE_URING */
+
 #ifdef HAVE_OSV
 // reactor_backend using OSv-specific features, without any file descriptors.
 // This implementation cannot currently wait on file descriptors, but unlike
@@ -333,6 +578,7 @@ public:
     virtual future<> readable(pollable_fd_state& fd) override;
     virtual future<> writeable(pollable_fd_state& fd) override;
     virtual void forget(pollable_fd_state& fd) noexcept override;
+    virtual void detach(pollable_fd_state& fd) noexcept override;
 
     virtual future<std::tuple<pollable_fd, socket_address>>
     accept(pollable_fd_state& listenfd) override;
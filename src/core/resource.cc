@@ -251,8 +251,11 @@ size_t calculate_memory(configuration c, size_t available_memory, float panic_fa
 #include <seastar/util/defer.hh>
 #include <seastar/core/print.hh>
 #include <hwloc.h>
+#include <filesystem>
+#include <fstream>
 #include <unordered_map>
 #include <boost/range/irange.hpp>
+#include <sys/sysmacros.h>
 
 namespace seastar {
 
@@ -346,8 +349,33 @@ struct distribute_objects {
     }
 };
 
+// Ask sysfs which NUMA node the device hangs off; for nvme the node is
+// reported by one of the parents of the block device (the PCIe root).
+// Restricted topologies may not contain the node, and virtual devices
+// report none, so the answer is optional.
+static std::optional<unsigned> device_numa_node(dev_t devid) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    auto dev = fs::canonical(fs::path(format("/sys/dev/block/{}:{}", major(devid), minor(devid))), ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    for (auto dir = dev; dir.has_relative_path(); dir = dir.parent_path()) {
+        std::ifstream f(dir / "numa_node");
+        int node;
+        if (f >> node) {
+            if (node < 0) {
+                // the device is not attached to a particular node
+                return std::nullopt;
+            }
+            return unsigned(node);
+        }
+    }
+    return std::nullopt;
+}
+
 static io_queue_topology
-allocate_io_queues(hwloc_topology_t& topology, std::vector<cpu> cpus, std::unordered_map<unsigned, hwloc_obj_t>& cpu_to_node,
+allocate_io_queues(hwloc_topology_t& topology, dev_t devid, std::vector<cpu> cpus, std::unordered_map<unsigned, hwloc_obj_t>& cpu_to_node,
         unsigned num_io_groups, unsigned& last_node_idx) {
     auto node_of_shard = [&cpus, &cpu_to_node] (unsigned shard) {
         auto node = cpu_to_node.at(cpus[shard].cpu_id);
@@ -399,16 +427,14 @@ allocate_io_queues(hwloc_topology_t& topology, std::vector<cpu> cpus, std::unord
         assert(0);
     };
 
-    auto cpu_sets = distribute_objects(topology, num_io_groups);
     ret.nr_queues = cpus.size();
     ret.nr_groups = 0;
 
-    // First step: distribute the IO queues given the information returned in cpu_sets.
-    // If there is one IO queue per processor, only this loop will be executed.
     std::unordered_map<unsigned, std::vector<unsigned>> node_coordinators;
-    for (auto&& cs : cpu_sets()) {
-        auto io_coordinator = find_shard(hwloc_bitmap_first(cs));
+    std::vector<unsigned> group_coordinators;
+    auto add_coordinator = [&] (unsigned io_coordinator) {
         ret.shard_to_group[io_coordinator] = ret.nr_groups++;
+        group_coordinators.push_back(io_coordinator);
 
         auto node_id = node_of_shard(io_coordinator);
         if (node_coordinators.count(node_id) == 0) {
@@ -416,6 +442,31 @@ allocate_io_queues(hwloc_topology_t& topology, std::vector<cpu> cpus, std::unord
         }
         node_coordinators.at(node_id).push_back(io_coordinator);
         numa_nodes[node_id].erase(io_coordinator);
+    };
+
+    // Prefer seeding the IO groups on the NUMA node the device is
+    // attached to, so that shards end up grouped with, and forwarded to,
+    // device-local ones rather than paying a cross-node hop to a group
+    // seeded on an arbitrary node.
+    auto dev_node = device_numa_node(devid);
+    if (dev_node && numa_nodes.count(*dev_node) && numa_nodes.at(*dev_node).size() >= num_io_groups) {
+        auto local_shards = boost::copy_range<std::vector<unsigned>>(numa_nodes.at(*dev_node));
+        // spaced out, so the seeds do not crowd one cache/core complex
+        auto stride = local_shards.size() / num_io_groups;
+        for (unsigned group = 0; group < num_io_groups; group++) {
+            add_coordinator(local_shards[group * stride]);
+        }
+    } else {
+        if (dev_node) {
+            seastar_logger.info("device {}:{}: NUMA node {} has no (or too few) shards, distributing IO groups across all nodes",
+                    major(devid), minor(devid), *dev_node);
+        }
+        // First step: distribute the IO queues given the information returned in cpu_sets.
+        // If there is one IO queue per processor, only this loop will be executed.
+        auto cpu_sets = distribute_objects(topology, num_io_groups);
+        for (auto&& cs : cpu_sets()) {
+            add_coordinator(find_shard(hwloc_bitmap_first(cs)));
+        }
     }
 
 
@@ -438,6 +489,23 @@ allocate_io_queues(hwloc_topology_t& topology, std::vector<cpu> cpus, std::unord
         }
     }
 
+    // Report the chosen topology, so cross-node placement can be spotted
+    // without a debug build.
+    unsigned off_node_shards = 0;
+    for (auto shard : boost::irange(0, int(cpus.size()))) {
+        auto coordinator = group_coordinators[ret.shard_to_group[shard]];
+        if (node_of_shard(shard) != node_of_shard(coordinator)) {
+            off_node_shards++;
+        }
+    }
+    sstring seeds;
+    for (auto coordinator : group_coordinators) {
+        seeds += format("{}{}", seeds.empty() ? "" : " ", coordinator);
+    }
+    seastar_logger.info("device {}:{}: NUMA node {}, {} IO group(s) seeded on shard(s) [{}], {} of {} shards grouped off-node",
+            major(devid), minor(devid), dev_node ? format("{}", *dev_node) : "unknown",
+            ret.nr_groups, seeds, off_node_shards, cpus.size());
+
     return ret;
 }
 
@@ -595,7 +663,7 @@ resources allocate(configuration c) {
 
     unsigned last_node_idx = 0;
     for (auto devid : c.devices) {
-        ret.ioq_topology.emplace(devid, allocate_io_queues(topology, ret.cpus, cpu_to_node, c.num_io_groups, last_node_idx));
+        ret.ioq_topology.emplace(devid, allocate_io_queues(topology, devid, ret.cpus, cpu_to_node, c.num_io_groups, last_node_idx));
     }
     return ret;
 }
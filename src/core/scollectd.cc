@@ -169,7 +169,7 @@ struct cpwriter {
         }
         sstring res = id.name();
         for (auto i : id.labels()) {
-            if (i.first != seastar::metrics::shard_label.name()) {
+            if (i.first.str() != seastar::metrics::shard_label.name()) {
                 res += "-" + i.second;
             }
         }
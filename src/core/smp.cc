@@ -32,10 +32,67 @@ void smp_message_queue::work_item::process() {
     schedule(this);
 }
 
+// Shard-local pool of memory for small cross-shard work items. A work
+// item is allocated in submit() and released in process_completions(),
+// both on the requesting shard, so no synchronization is needed; at
+// millions of submit_to() calls per second the allocator round-trip for
+// every item is measurable, and items double as the result slot the
+// remote shard writes into, so recycling them recycles that slot too.
+namespace {
+
+struct work_item_slot {
+    work_item_slot* next;
+};
+
+// covers async_work_item with a typical lambda and small result
+constexpr size_t work_item_slot_size = 192;
+// bounds memory pinned by the pool to ~max_pooled_work_items * slot size
+constexpr size_t max_pooled_work_items = 1024;
+
+thread_local work_item_slot* free_work_items = nullptr;
+thread_local size_t nr_free_work_items = 0;
+
+}
+
+void* smp_message_queue::work_item::operator new(size_t size) {
+    if (size <= work_item_slot_size) {
+        if (free_work_items) {
+            --nr_free_work_items;
+            return std::exchange(free_work_items, free_work_items->next);
+        }
+        // allocate a full slot so the chunk is recyclable on delete
+        size = work_item_slot_size;
+    }
+    return ::operator new(size);
+}
+
+void smp_message_queue::work_item::operator delete(void* ptr, size_t size) noexcept {
+    if (size <= work_item_slot_size && nr_free_work_items < max_pooled_work_items) {
+        ++nr_free_work_items;
+        free_work_items = new (ptr) work_item_slot{free_work_items};
+        return;
+    }
+    ::operator delete(ptr);
+}
+
 struct smp_service_group_impl {
+    // State of the adaptive concurrency limit towards one server shard;
+    // engaged only when max_queue_delay_ns is non-zero.
+    struct adaptive_limit {
+        size_t current = 0;        // units currently granted to the client semaphore
+        size_t max = 0;            // upper bound for additive increase
+        unsigned completions = 0;  // completions since the last adjustment
+    };
     std::vector<smp_service_group_semaphore> clients;   // one client per server shard
+    std::vector<adaptive_limit> limits;                 // parallel to clients; empty if not adaptive
+    uint64_t max_queue_delay_ns = 0;                    // from smp_service_group_config; 0 disables adaptation
 };
 
+// How many completions to accumulate between adjustments of an adaptive
+// limit. Keeps the controller's reaction slower than the delay EMA it
+// feeds on, so a single spike does not collapse the limit.
+static constexpr unsigned adaptive_limit_adjust_period = 64;
+
 static smp_service_group_semaphore smp_service_group_management_sem{1, named_semaphore_exception_factory{"smp_service_group_management_sem"}};
 static thread_local std::vector<smp_service_group_impl> smp_service_groups;
 
@@ -71,12 +128,23 @@ future<smp_service_group> create_smp_service_group(smp_service_group_config ssgc
                 for (unsigned i = 0; i != smp::count; ++i) {
                     smp_service_groups[id].clients.emplace_back(per_client, make_service_group_semaphore_exception_factory(id, i, cpu, ssgc.group_name));
                 }
+                auto& ssgi = smp_service_groups[id];
+                ssgi.max_queue_delay_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(ssgc.max_destination_queue_delay).count();
+                if (ssgi.max_queue_delay_ns) {
+                    ssgi.limits.resize(smp::count); // may throw
+                    for (auto& lim : ssgi.limits) {
+                        lim.current = per_client;
+                        lim.max = per_client * 4;
+                    }
+                }
               });
             }).handle_exception([id] (std::exception_ptr e) {
                 // rollback
                 return smp::invoke_on_all([id] {
                     if (smp_service_groups.size() > id) {
                         smp_service_groups[id].clients.clear();
+                        smp_service_groups[id].limits.clear();
+                        smp_service_groups[id].max_queue_delay_ns = 0;
                     }
                 }).then([e = std::move(e)] () mutable {
                     std::rethrow_exception(std::move(e));
@@ -94,6 +162,8 @@ future<> destroy_smp_service_group(smp_service_group ssg) noexcept {
             auto id = internal::smp_service_group_id(ssg);
             return smp::invoke_on_all([id] {
                 smp_service_groups[id].clients.clear();
+                smp_service_groups[id].limits.clear();
+                smp_service_groups[id].max_queue_delay_ns = 0;
             });
         });
     });
@@ -112,4 +182,29 @@ smp_service_group_semaphore& get_smp_service_groups_semaphore(unsigned ssg_id, s
     return smp_service_groups[ssg_id].clients[t];
 }
 
+void smp_service_group_complete_request(unsigned ssg_id, shard_id t, uint64_t queue_delay_ns) noexcept {
+    auto& ssgi = smp_service_groups[ssg_id];
+    ssgi.clients[t].signal();
+    if (!ssgi.max_queue_delay_ns) {
+        return;
+    }
+    auto& lim = ssgi.limits[t];
+    if (++lim.completions < adaptive_limit_adjust_period) {
+        return;
+    }
+    lim.completions = 0;
+    if (queue_delay_ns > ssgi.max_queue_delay_ns) {
+        // Multiplicative decrease: the destination shard is not keeping
+        // up, so halve our share of its queue.
+        auto target = std::max(lim.current / 2, size_t(1));
+        ssgi.clients[t].consume(lim.current - target);
+        lim.current = target;
+    } else if (lim.current < lim.max) {
+        // Additive increase: delay is within bounds, probe for more
+        // concurrency.
+        ++lim.current;
+        ssgi.clients[t].signal();
+    }
+}
+
 }
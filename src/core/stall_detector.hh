@@ -26,8 +26,11 @@
 #include <limits>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <seastar/core/posix.hh>
 #include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/util/backtrace.hh>
 
 namespace seastar {
 
@@ -84,5 +87,46 @@ public:
     void end_sleep();
 };
 
+// Always-on sampling CPU profiler.
+//
+// A second thread-cputime timer in the mold of cpu_stall_detector's: it
+// fires a thread-directed signal every sampling period of consumed cpu
+// time and the handler captures the call stack with the same
+// async-signal-safe backtrace() walk the stall detector performs.
+// Samples are aggregated in place into a fixed open-addressed table of
+// unique stacks with counts, so the handler never allocates; a stack
+// colliding with a different incumbent decays the incumbent's count and
+// takes the slot only once it reaches zero, which keeps hot stacks from
+// being evicted by one-off ones. dump_collapsed() renders the table in
+// the collapsed-stack format flamegraph tooling reads.
+class cpu_profiler {
+public:
+    static constexpr unsigned max_depth = 32;
+    struct sample {
+        uint64_t hash = 0;
+        uint64_t count = 0;
+        unsigned depth = 0;
+        frame frames[max_depth];
+    };
+private:
+    static constexpr size_t nr_slots = 512;
+    timer_t _timer;
+    bool _enabled = false;
+    std::chrono::nanoseconds _period = {};
+    std::unique_ptr<sample[]> _samples;
+    uint64_t _total_samples = 0;
+    uint64_t _evicted_samples = 0;
+public:
+    cpu_profiler();
+    ~cpu_profiler();
+    static int signal_number() { return SIGRTMIN + 2; }
+    bool enabled() const { return _enabled; }
+    std::chrono::nanoseconds period() const { return _period; }
+    void enable(std::chrono::nanoseconds period);
+    void disable();
+    void on_signal();
+    sstring dump_collapsed() const;
+};
+
 }
 }
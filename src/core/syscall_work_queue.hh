@@ -23,9 +23,11 @@
 
 #include <seastar/core/internal/pollable_fd.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/posix.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/util/std-compat.hh>
 #include <seastar/util/noncopyable_function.hh>
+#include <boost/lockfree/queue.hpp>
 #include <boost/lockfree/spsc_queue.hpp>
 
 namespace seastar {
@@ -33,11 +35,18 @@ namespace seastar {
 class syscall_work_queue {
     static constexpr size_t queue_length = 128;
     struct work_item;
-    using lf_queue = boost::lockfree::spsc_queue<work_item*,
+    // submitted by the reactor thread, consumed by any of the pool's
+    // worker threads
+    using lf_queue = boost::lockfree::queue<work_item*,
+                            boost::lockfree::capacity<queue_length>>;
+    // completions flow back over a queue with a single producer: the
+    // worker that executed the call
+    using completion_queue = boost::lockfree::spsc_queue<work_item*,
                             boost::lockfree::capacity<queue_length>>;
     lf_queue _pending;
-    lf_queue _completed;
-    writeable_eventfd _start_eventfd;
+    // eventfd in semaphore mode: each signalled unit wakes exactly one
+    // worker, which consumes exactly one work item
+    file_desc _start_eventfd;
     semaphore _queue_has_room = { queue_length };
     struct work_item {
         virtual ~work_item() {}
@@ -70,14 +79,6 @@ public:
       }
     }
 private:
-    void work();
-    // Scans the _completed queue, that contains the requests already handled by the syscall thread,
-    // effectively opening up space for more requests to be submitted. One consequence of this is
-    // that from the reactor's point of view, a request is not considered handled until it is
-    // removed from the _completed queue.
-    //
-    // Returns the number of requests handled.
-    unsigned complete();
     void submit_item(std::unique_ptr<syscall_work_queue::work_item> wi);
 
     friend class thread_pool;
@@ -20,11 +20,13 @@
  * Copyright (C) 2015 Cloudius Systems, Ltd.
  */
 
+#include <seastar/core/align.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/core/posix.hh>
 #include <seastar/core/reactor.hh>
 #include <ucontext.h>
 #include <algorithm>
+#include <unordered_map>
 
 #include <valgrind/valgrind.h>
 
@@ -167,19 +169,74 @@ static size_t get_stack_size(thread_attributes attr) {
 #endif
 }
 
+// Per-shard cache of recycled seastar::thread stacks, keyed by stack size.
+// A recycled stack keeps its valgrind registration and, with
+// SEASTAR_THREAD_STACK_GUARDS, its armed guard page, so creating a thread
+// becomes allocation- and syscall-free in steady state. Stacks returned
+// above the watermark have their pages dropped with madvise() before the
+// memory goes back to the allocator, since the allocator does not return
+// memory to the OS on its own.
+class stack_cache {
+    // maximum number of recycled stacks kept per stack size; sized for
+    // spawn-heavy workloads without pinning much memory per shard
+    // (16 * 128 KiB = 2 MiB)
+    static constexpr size_t high_watermark = 16;
+    std::unordered_map<size_t, std::vector<thread_context::stack_holder>> _stacks;
+public:
+    thread_context::stack_holder get(size_t stack_size) {
+        auto i = _stacks.find(stack_size);
+        if (i == _stacks.end() || i->second.empty()) {
+            return thread_context::stack_holder(nullptr, thread_context::stack_deleter(0));
+        }
+        auto stack = std::move(i->second.back());
+        i->second.pop_back();
+#ifdef SEASTAR_ASAN_ENABLED
+        // Avoid ASAN false positive due to the previous user's garbage
+        size_t guard = 0;
+#ifdef SEASTAR_THREAD_STACK_GUARDS
+        guard = getpagesize(); // the guard page is still armed, skip it
+#endif
+        std::fill_n(stack.get() + guard, stack_size - guard, 0);
+#endif
+        return stack;
+    }
+    void put(size_t stack_size, thread_context::stack_holder stack) noexcept {
+        std::vector<thread_context::stack_holder>* stacks = nullptr;
+        try {
+            stacks = &_stacks[stack_size];
+            stacks->reserve(high_watermark);
+        } catch (...) {
+            // out of memory; just free the stack below
+            stacks = nullptr;
+        }
+        if (stacks && stacks->size() < high_watermark) {
+            stacks->push_back(std::move(stack));
+            return;
+        }
+        // Excess stack: drop its pages so the OS gets the memory back,
+        // then let the deleter hand it to the allocator.
+        size_t page_size = getpagesize();
+        auto begin = align_up(stack.get(), page_size);
+        auto end = align_down(stack.get() + stack_size, page_size);
+        if (begin < end) {
+            ::madvise(begin, end - begin, MADV_DONTNEED);
+        }
+    }
+};
+
+static thread_local stack_cache g_stack_cache;
+
 thread_context::thread_context(thread_attributes attr, noncopyable_function<void ()> func)
         : task(attr.sched_group.value_or(current_scheduling_group()))
-        , _stack(make_stack(get_stack_size(attr)))
+        , _stack_size(get_stack_size(attr))
+        , _stack(make_stack(_stack_size))
         , _func(std::move(func)) {
-    setup(get_stack_size(attr));
+    setup(_stack_size);
     _all_threads.push_front(*this);
 }
 
 thread_context::~thread_context() {
-#ifdef SEASTAR_THREAD_STACK_GUARDS
-    auto mp_result = mprotect(_stack.get(), getpagesize(), PROT_READ | PROT_WRITE);
-    assert(mp_result == 0);
-#endif
+    g_stack_cache.put(_stack_size, std::move(_stack));
     _all_threads.erase(_all_threads.iterator_to(*this));
 }
 
@@ -187,6 +244,9 @@ thread_context::stack_deleter::stack_deleter(int valgrind_id) : valgrind_id(valg
 
 thread_context::stack_holder
 thread_context::make_stack(size_t stack_size) {
+    if (auto stack = g_stack_cache.get(stack_size)) {
+        return stack;
+    }
 #ifdef SEASTAR_THREAD_STACK_GUARDS
     size_t page_size = getpagesize();
     size_t alignment = page_size;
@@ -213,6 +273,10 @@ thread_context::make_stack(size_t stack_size) {
 }
 
 void thread_context::stack_deleter::operator()(char* ptr) const noexcept {
+#ifdef SEASTAR_THREAD_STACK_GUARDS
+    auto mp_result = mprotect(ptr, getpagesize(), PROT_READ | PROT_WRITE);
+    assert(mp_result == 0);
+#endif
     VALGRIND_STACK_DEREGISTER(valgrind_id);
     free(ptr);
 }
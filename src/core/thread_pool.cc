@@ -20,49 +20,105 @@
  */
 
 #include <seastar/core/reactor.hh>
+#include <seastar/core/print.hh>
 #include "core/thread_pool.hh"
 
 namespace seastar {
 
+extern logger seastar_logger;
+
 /* not yet implemented for OSv. TODO: do the notification like we do class smp. */
 #ifndef HAVE_OSV
-thread_pool::thread_pool(reactor* r, sstring name) : _reactor(r), _worker_thread([this, name] { work(name); }) {
+
+static int64_t steady_clock_ms() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+thread_pool::worker::worker(thread_pool& p, sstring worker_name)
+        : pool(p)
+        , name(std::move(worker_name))
+        , thread([this] { pool.work(name, this); }) {
+}
+
+thread_pool::thread_pool(reactor* r, sstring name) : _reactor(r), _name(std::move(name)) {
+    _workers.push_back(std::make_unique<worker>(*this, _name));
 }
 
-void thread_pool::work(sstring name) {
+void thread_pool::set_concurrency(unsigned nr_workers) {
+    nr_workers = std::max(nr_workers, 1u);
+    while (_workers.size() < nr_workers) {
+        _workers.push_back(std::make_unique<worker>(*this, format("{}-{}", _name, _workers.size())));
+    }
+}
+
+void thread_pool::work(sstring name, worker* w) {
     pthread_setname_np(pthread_self(), name.c_str());
     sigset_t mask;
     sigfillset(&mask);
     auto r = ::pthread_sigmask(SIG_BLOCK, &mask, NULL);
     throw_pthread_error(r);
-    std::array<syscall_work_queue::work_item*, syscall_work_queue::queue_length> tmp_buf;
     while (true) {
         uint64_t count;
-        auto r = ::read(inter_thread_wq._start_eventfd.get_read_fd(), &count, sizeof(count));
-        assert(r == sizeof(count));
+        auto ret = ::read(inter_thread_wq._start_eventfd.get(), &count, sizeof(count));
+        assert(ret == sizeof(count));
         if (_stopped.load(std::memory_order_relaxed)) {
             break;
         }
+        // the eventfd is in semaphore mode and signalled once per
+        // submitted item, so a wakeup guarantees an item is (or is just
+        // about to be popped by a sibling, leaving us a later one) in
+        // the queue
+        syscall_work_queue::work_item* wi = nullptr;
+        while (!inter_thread_wq._pending.pop(wi)) {
+        }
+        w->busy_since.store(steady_clock_ms(), std::memory_order_relaxed);
+        wi->process();
+        w->busy_since.store(0, std::memory_order_relaxed);
+        w->completed.push(wi);
+        if (_main_thread_idle.load(std::memory_order_seq_cst)) {
+            uint64_t one = 1;
+            ::write(_reactor->_notify_eventfd.get(), &one, 8);
+        }
+    }
+}
+
+unsigned thread_pool::complete() {
+    std::array<syscall_work_queue::work_item*, syscall_work_queue::queue_length> tmp_buf;
+    unsigned nr = 0;
+    auto now = steady_clock_ms();
+    for (auto& w : _workers) {
         auto end = tmp_buf.data();
-        inter_thread_wq._pending.consume_all([&] (syscall_work_queue::work_item* wi) {
+        w->completed.consume_all([&] (syscall_work_queue::work_item* wi) {
             *end++ = wi;
         });
         for (auto p = tmp_buf.data(); p != end; ++p) {
             auto wi = *p;
-            wi->process();
-            inter_thread_wq._completed.push(wi);
+            wi->complete();
+            delete wi;
+            ++nr;
         }
-        if (_main_thread_idle.load(std::memory_order_seq_cst)) {
-            uint64_t one = 1;
-            ::write(_reactor->_notify_eventfd.get(), &one, 8);
+        auto busy = w->busy_since.load(std::memory_order_relaxed);
+        if (busy == 0) {
+            w->warned = false;
+        } else if (!w->warned && now - busy >= slow_call_warn_threshold.count()) {
+            seastar_logger.warn("blocking call on thread {} stuck for more than {} ms", w->name, now - busy);
+            w->warned = true;
         }
     }
+    inter_thread_wq._queue_has_room.signal(nr);
+    return nr;
 }
 
 thread_pool::~thread_pool() {
     _stopped.store(true, std::memory_order_relaxed);
-    inter_thread_wq._start_eventfd.signal(1);
-    _worker_thread.join();
+    // one semaphore unit per worker, so each of them wakes up and exits
+    uint64_t n = _workers.size();
+    auto r = inter_thread_wq._start_eventfd.write(&n, sizeof(n));
+    assert(r == sizeof(n));
+    for (auto& w : _workers) {
+        w->thread.join();
+    }
 }
 #endif
 
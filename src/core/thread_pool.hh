@@ -22,6 +22,9 @@
 #pragma once
 
 #include "syscall_work_queue.hh"
+#include <chrono>
+#include <memory>
+#include <vector>
 
 namespace seastar {
 
@@ -31,8 +34,24 @@ class thread_pool {
     reactor* _reactor;
     uint64_t _aio_threaded_fallbacks = 0;
 #ifndef HAVE_OSV
+    // A blocking call stuck for longer than this (hung NFS mount, bad
+    // disk) gets reported; it only occupies its own worker, the other
+    // workers keep serving calls.
+    static constexpr std::chrono::milliseconds slow_call_warn_threshold{2000};
+    struct worker {
+        thread_pool& pool;
+        sstring name;
+        syscall_work_queue::completion_queue completed;
+        // milliseconds on the steady clock when the call currently
+        // executing started; zero when the worker is idle
+        std::atomic<int64_t> busy_since = { 0 };
+        bool warned = false; // reactor thread only
+        posix_thread thread; // last member: the thread starts immediately
+        worker(thread_pool& p, sstring worker_name);
+    };
     syscall_work_queue inter_thread_wq;
-    posix_thread _worker_thread;
+    sstring _name;
+    std::vector<std::unique_ptr<worker>> _workers;
     std::atomic<bool> _stopped = { false };
     std::atomic<bool> _main_thread_idle = { false };
 public:
@@ -45,7 +64,17 @@ public:
     }
     uint64_t operation_count() const { return _aio_threaded_fallbacks; }
 
-    unsigned complete() { return inter_thread_wq.complete(); }
+    // Grows the pool to nr_workers threads, so that many blocking calls
+    // can execute concurrently and one stuck call does not serialize the
+    // rest. The pool never shrinks.
+    void set_concurrency(unsigned nr_workers);
+
+    // Drains every worker's completion queue, fulfilling the promises of
+    // the finished calls and opening up room for more submissions, and
+    // runs the slow-call watchdog over the calls still executing.
+    //
+    // Returns the number of requests handled.
+    unsigned complete();
     // Before we enter interrupt mode, we must make sure that the syscall thread will properly
     // generate signals to wake us up. This means we need to make sure that all modifications to
     // the pending and completed fields in the inter_thread_wq are visible to all threads.
@@ -58,13 +87,14 @@ public:
     // harmless.
     void exit_interrupt_mode() { _main_thread_idle.store(false, std::memory_order_relaxed); }
 
+private:
+    void work(sstring thread_name, worker* w);
 #else
 public:
     template <typename T, typename Func>
     future<T> submit(Func func) { std::cerr << "thread_pool not yet implemented on osv\n"; abort(); }
+    void set_concurrency(unsigned nr_workers) {}
 #endif
-private:
-    void work(sstring thread_name);
 };
 
 
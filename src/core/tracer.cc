@@ -0,0 +1,117 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <seastar/core/internal/tracer.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/json/generator.hh>
+
+#include <cxxabi.h>
+#include <cstdlib>
+#include <memory>
+
+namespace seastar {
+namespace internal {
+
+void tracer::enable(unsigned period, size_t ring_spans) {
+    _period = std::max(period, 1u);
+    _countdown = 0;
+    _pending = {};
+    _ring.assign(std::max<size_t>(ring_spans, 1), span{});
+    _next = 0;
+    _enabled = true;
+}
+
+void tracer::disable() noexcept {
+    _enabled = false;
+}
+
+static sstring demangle(const std::type_info* type) {
+    int status;
+    std::unique_ptr<char, void (*)(void*)> name(
+            abi::__cxa_demangle(type->name(), nullptr, nullptr, &status), std::free);
+    return status == 0 ? sstring(name.get()) : sstring(type->name());
+}
+
+static double microseconds(tracer::clock::time_point t) {
+    return std::chrono::duration<double, std::micro>(t.time_since_epoch()).count();
+}
+
+sstring tracer::dump_chrome_trace() const {
+    json::generator gen;
+    gen.append_raw("{\"traceEvents\":[", 16);
+    bool first = true;
+    // oldest first: the slot at _next is the next one to be overwritten
+    for (size_t i = 0; i < _ring.size(); i++) {
+        const span& s = _ring[(_next + i) % _ring.size()];
+        if (s.ended == clock::time_point{}) {
+            continue; // never written
+        }
+        if (!first) {
+            gen.append(',');
+        }
+        first = false;
+        gen.append_raw("{\"ph\":\"X\",\"pid\":0,\"tid\":", 24);
+        gen.append(this_shard_id());
+        if (s.io) {
+            gen.append_raw(",\"cat\":\"io\",\"name\":\"io\",\"ts\":", 29);
+            gen.append(microseconds(s.queued));
+            gen.append_raw(",\"dur\":", 7);
+            gen.append(microseconds(s.ended) - microseconds(s.queued));
+            gen.append_raw(",\"args\":{\"class\":", 17);
+            gen.append(unsigned(s.group));
+            gen.append_raw(",\"wait_us\":", 11);
+            gen.append(microseconds(s.started) - microseconds(s.queued));
+            gen.append_raw(",\"disk_us\":", 11);
+            gen.append(microseconds(s.ended) - microseconds(s.started));
+        } else {
+            gen.append_raw(",\"cat\":\"task\",\"name\":", 21);
+            gen.append_string(demangle(s.type));
+            gen.append_raw(",\"ts\":", 6);
+            gen.append(microseconds(s.started));
+            gen.append_raw(",\"dur\":", 7);
+            gen.append(microseconds(s.ended) - microseconds(s.started));
+            gen.append_raw(",\"args\":{\"group\":", 17);
+            gen.append_string(scheduling_group_from_index(s.group).name());
+            gen.append_raw(",\"queue_us\":", 12);
+            gen.append(microseconds(s.started) - microseconds(s.queued));
+        }
+        gen.append_raw("}}", 2);
+    }
+    gen.append_raw("]}", 2);
+    return gen.str();
+}
+
+void enable_task_tracing(unsigned sample_one_in, size_t ring_spans) {
+    engine().tracer().enable(sample_one_in, ring_spans);
+}
+
+void disable_task_tracing() noexcept {
+    engine().tracer().disable();
+}
+
+sstring dump_task_trace() {
+    return engine().tracer().dump_chrome_trace();
+}
+
+}
+}
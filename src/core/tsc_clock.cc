@@ -0,0 +1,171 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <seastar/core/internal/tsc_clock.hh>
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace seastar {
+namespace internal {
+
+namespace {
+
+// Conversion parameters from TSC ticks to nanoseconds on the
+// steady_clock timeline:
+//   ns = ns_base + (tsc - tsc_base) * mult >> mult_shift
+// Updated only by the calibrating thread; readers use the generation
+// counter as a seqlock. A generation of zero means no calibration has
+// been established yet.
+constexpr unsigned mult_shift = 32;
+
+std::atomic<uint64_t> cal_generation = { 0 };
+std::atomic<uint64_t> cal_tsc_base = { 0 };
+std::atomic<int64_t> cal_ns_base = { 0 };
+std::atomic<uint64_t> cal_mult = { 0 };
+
+std::atomic<uint64_t> total_drift_ns = { 0 };
+
+// calibration interval; the first interval is a single lowres tick so
+// that the TSC frequency becomes known shortly after start-up
+constexpr auto recalibration_interval = std::chrono::seconds(1);
+
+bool tsc_is_invariant() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned a = 0, b = 0, c = 0, d = 0;
+    if (!__get_cpuid(0x80000007, &a, &b, &c, &d)) {
+        return false;
+    }
+    return d & (1u << 8);
+#else
+    return false;
+#endif
+}
+
+uint64_t read_tsc() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+int64_t steady_now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            tsc_clock::base_clock::now().time_since_epoch()).count();
+}
+
+int64_t convert(uint64_t tsc, uint64_t tsc_base, int64_t ns_base, uint64_t mult) noexcept {
+    return ns_base + int64_t((unsigned __int128)(tsc - tsc_base) * mult >> mult_shift);
+}
+
+}
+
+bool tsc_clock::available() noexcept {
+    return cal_generation.load(std::memory_order_acquire) >= 2
+            && (cal_generation.load(std::memory_order_relaxed) & 1) == 0;
+}
+
+tsc_clock::time_point tsc_clock::now() noexcept {
+    auto gen = cal_generation.load(std::memory_order_acquire);
+    while (gen >= 2) {
+        if (gen & 1) {
+            // calibration in progress, spin until it settles
+            gen = cal_generation.load(std::memory_order_acquire);
+            continue;
+        }
+        auto tsc_base = cal_tsc_base.load(std::memory_order_relaxed);
+        auto ns_base = cal_ns_base.load(std::memory_order_relaxed);
+        auto mult = cal_mult.load(std::memory_order_relaxed);
+        auto ns = convert(read_tsc(), tsc_base, ns_base, mult);
+        auto gen2 = cal_generation.load(std::memory_order_acquire);
+        if (gen2 == gen) {
+            return time_point(std::chrono::nanoseconds(ns));
+        }
+        gen = gen2;
+    }
+    return base_clock::now();
+}
+
+void tsc_clock::maybe_recalibrate() noexcept {
+    static thread_local uint64_t last_tsc = 0;
+    static thread_local int64_t last_ns = 0;
+    static thread_local int64_t next_calibration_ns = 0;
+
+    if (!tsc_is_invariant()) {
+        return;
+    }
+
+    auto ns = steady_now_ns();
+    auto tsc = read_tsc();
+    if (!last_tsc) {
+        // first call, just establish the base pair
+        last_tsc = tsc;
+        last_ns = ns;
+        return;
+    }
+    if (ns < next_calibration_ns) {
+        return;
+    }
+    if (tsc <= last_tsc || ns <= last_ns) {
+        // TSC stepped backwards (e.g. VM migration to a host without
+        // TSC scaling), start over from a fresh base pair
+        cal_generation.store(0, std::memory_order_release);
+        last_tsc = tsc;
+        last_ns = ns;
+        return;
+    }
+
+    auto mult = uint64_t(((unsigned __int128)(ns - last_ns) << mult_shift) / (tsc - last_tsc));
+    auto gen = cal_generation.load(std::memory_order_relaxed);
+    auto ns_base = ns;
+    if (gen >= 2) {
+        // account the error the old parameters had accumulated, and
+        // never step the converted time backwards
+        auto old_now = convert(tsc, cal_tsc_base.load(std::memory_order_relaxed),
+                cal_ns_base.load(std::memory_order_relaxed),
+                cal_mult.load(std::memory_order_relaxed));
+        auto drift = old_now > ns ? old_now - ns : ns - old_now;
+        total_drift_ns.fetch_add(drift, std::memory_order_relaxed);
+        ns_base = std::max(ns, old_now);
+    }
+
+    cal_generation.store(gen + 1, std::memory_order_release);
+    cal_tsc_base.store(tsc, std::memory_order_relaxed);
+    cal_ns_base.store(ns_base, std::memory_order_relaxed);
+    cal_mult.store(mult, std::memory_order_relaxed);
+    cal_generation.store(gen + 2, std::memory_order_release);
+
+    last_tsc = tsc;
+    last_ns = ns;
+    next_calibration_ns = ns + std::chrono::duration_cast<std::chrono::nanoseconds>(recalibration_interval).count();
+}
+
+uint64_t tsc_clock::calibration_drift_ns() noexcept {
+    return total_drift_ns.load(std::memory_order_relaxed);
+}
+
+}
+}
@@ -0,0 +1,260 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#include <seastar/http/client.hh>
+#include <seastar/http/internal/content_source.hh>
+#include <seastar/http/short_streams.hh>
+#include <seastar/core/do_with.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/seastar.hh>
+#include <strings.h>
+
+namespace seastar {
+
+namespace httpd {
+
+// Case-insensitive response header lookup; servers are free to pick any
+// capitalization for the names they send back.
+static const sstring* find_header(const http_response& rsp, const char* name) {
+    for (auto& h : rsp._headers) {
+        if (strcasecmp(h.first.c_str(), name) == 0) {
+            return &h.second;
+        }
+    }
+    return nullptr;
+}
+
+// Reads the response body when the server signals its end by closing the
+// connection, i.e. neither Content-Length nor chunking frame it.
+class until_eof_source_impl : public data_source_impl {
+    input_stream<char>& _inp;
+public:
+    explicit until_eof_source_impl(input_stream<char>& inp) : _inp(inp) {
+    }
+
+    virtual future<temporary_buffer<char>> get() override {
+        return _inp.read();
+    }
+
+    virtual future<> close() override {
+        return make_ready_future<>();
+    }
+};
+
+class http_client::client_connection {
+    connected_socket _fd;
+    input_stream<char> _read_buf;
+    output_stream<char> _write_buf;
+    http_response_parser _parser;
+    // scratch space for a chunked response body; the client has no
+    // request object to put extensions and trailers into
+    std::unordered_map<sstring, sstring> _extensions;
+    std::unordered_map<sstring, sstring> _trailers;
+    bool _reusable = true;
+public:
+    explicit client_connection(connected_socket&& fd)
+        : _fd(std::move(fd))
+        , _read_buf(_fd.input())
+        , _write_buf(_fd.output()) {
+    }
+
+    // Whether the response left the connection positioned at a message
+    // boundary, so another request may be sent on it.
+    bool reusable() const {
+        return _reusable;
+    }
+
+    future<> do_request(const sstring& text, const sstring& method, response_handler& handler) {
+        return _write_buf.write(text.data(), text.size()).then([this] {
+            return _write_buf.flush();
+        }).then([this] {
+            return recv_response();
+        }).then([this, &method, &handler] (std::unique_ptr<http_response> rsp) {
+            return do_with(std::move(rsp), input_stream<char>(), [this, &method, &handler] (std::unique_ptr<http_response>& rsp, input_stream<char>& body) {
+                body = make_body_stream(*rsp, method);
+                return handler(*rsp, body).then([&body] {
+                    // realign on the next response in case the handler
+                    // did not read the body to its end
+                    return skip_entire_stream(body);
+                }).finally([&body] {
+                    return body.close();
+                });
+            });
+        });
+    }
+
+    future<> close() {
+        return _write_buf.close();
+    }
+private:
+    future<std::unique_ptr<http_response>> recv_response() {
+        _parser.init();
+        return _read_buf.consume(_parser).then([this] {
+            if (_parser.eof()) {
+                _reusable = false;
+                return make_exception_future<std::unique_ptr<http_response>>(
+                        std::runtime_error("server closed connection before responding"));
+            }
+            auto rsp = _parser.get_parsed_response();
+            if (rsp->_status_code >= 100 && rsp->_status_code < 200 && rsp->_status_code != 101) {
+                // interim response, the final one follows
+                return recv_response();
+            }
+            return make_ready_future<std::unique_ptr<http_response>>(std::move(rsp));
+        });
+    }
+
+    input_stream<char> make_body_stream(const http_response& rsp, const sstring& method) {
+        const sstring* connection = find_header(rsp, "Connection");
+        if (rsp._version == "1.0") {
+            _reusable = connection && strcasecmp(connection->c_str(), "keep-alive") == 0;
+        } else if (connection && strcasecmp(connection->c_str(), "close") == 0) {
+            _reusable = false;
+        }
+        if (method == "HEAD" || rsp._status_code == 204 || rsp._status_code == 304) {
+            // these responses carry no body regardless of their headers
+            return input_stream<char>(data_source(std::make_unique<internal::content_length_source_impl>(_read_buf, 0)));
+        }
+        const sstring* te = find_header(rsp, "Transfer-Encoding");
+        if (te && strcasecmp(te->c_str(), "chunked") == 0) {
+            _extensions.clear();
+            _trailers.clear();
+            return input_stream<char>(data_source(std::make_unique<internal::chunked_source_impl>(_read_buf, _extensions, _trailers)));
+        }
+        const sstring* cl = find_header(rsp, "Content-Length");
+        if (cl) {
+            return input_stream<char>(data_source(std::make_unique<internal::content_length_source_impl>(_read_buf, strtol(cl->c_str(), nullptr, 10))));
+        }
+        // the body runs until the server closes the connection
+        _reusable = false;
+        return input_stream<char>(data_source(std::make_unique<until_eof_source_impl>(_read_buf)));
+    }
+};
+
+http_client::http_client(socket_address addr, sstring host, unsigned max_connections)
+    : _addr(addr)
+    , _host(std::move(host))
+    , _max_connections(max_connections) {
+}
+
+http_client::~http_client() = default;
+
+future<std::unique_ptr<http_client::client_connection>> http_client::get_connection() {
+    if (!_idle.empty()) {
+        auto con = std::move(_idle.front());
+        _idle.pop_front();
+        return make_ready_future<std::unique_ptr<client_connection>>(std::move(con));
+    }
+    if (_connections < _max_connections) {
+        ++_connections;
+        return connect(_addr).then([] (connected_socket fd) {
+            return std::make_unique<client_connection>(std::move(fd));
+        }).handle_exception([this] (std::exception_ptr ex) {
+            --_connections;
+            return make_exception_future<std::unique_ptr<client_connection>>(std::move(ex));
+        });
+    }
+    // the pool is fully busy, wait for a request in flight to finish
+    return _available.wait([this] {
+        return !_idle.empty() || _connections < _max_connections;
+    }).then([this] {
+        return get_connection();
+    });
+}
+
+future<> http_client::put_connection(std::unique_ptr<client_connection> con, bool reusable) {
+    if (reusable && !_closed) {
+        _idle.push_back(std::move(con));
+        _available.signal();
+        return make_ready_future<>();
+    }
+    auto c = con.get();
+    return c->close().then_wrapped([this, con = std::move(con)] (future<> f) {
+        f.ignore_ready_future();
+        --_connections;
+        _available.signal();
+    });
+}
+
+future<> http_client::make_request(sstring method, sstring path,
+        std::unordered_map<sstring, sstring> headers, sstring body,
+        response_handler handler) {
+    return with_gate(_pending, [this, method = std::move(method), path = std::move(path),
+            headers = std::move(headers), body = std::move(body), handler = std::move(handler)] () mutable {
+        sstring text = method + " " + path + " HTTP/1.1\r\n";
+        if (!headers.count("Host")) {
+            text += "Host: " + _host + "\r\n";
+        }
+        if (!body.empty() && !headers.count("Content-Length")) {
+            text += "Content-Length: " + to_sstring(body.size()) + "\r\n";
+        }
+        for (auto& h : headers) {
+            text += h.first + ": " + h.second + "\r\n";
+        }
+        text += "\r\n";
+        text += body;
+        return do_with(std::move(text), std::move(method), std::move(handler),
+                [this] (sstring& text, sstring& method, response_handler& handler) {
+            return get_connection().then([this, &text, &method, &handler] (std::unique_ptr<client_connection> con) {
+                auto c = con.get();
+                return c->do_request(text, method, handler).then_wrapped([this, con = std::move(con)] (future<> f) mutable {
+                    bool reusable = !f.failed() && con->reusable();
+                    return put_connection(std::move(con), reusable).then([f = std::move(f)] () mutable {
+                        return std::move(f);
+                    });
+                });
+            });
+        });
+    });
+}
+
+future<std::unique_ptr<http_response>> http_client::get(sstring path) {
+    return do_with(std::unique_ptr<http_response>(), [this, path = std::move(path)] (std::unique_ptr<http_response>& result) mutable {
+        return make_request("GET", std::move(path), {}, "", [&result] (const http_response& rsp, input_stream<char>& body) {
+            result = std::make_unique<http_response>(rsp);
+            return read_entire_stream_contiguous(body).then([&result] (sstring content) {
+                result->_content = std::move(content);
+            });
+        }).then([&result] {
+            return std::move(result);
+        });
+    });
+}
+
+future<> http_client::close() {
+    if (_closed) {
+        return make_ready_future<>();
+    }
+    _closed = true;
+    _available.broken();
+    return _pending.close().then([this] {
+        return do_for_each(_idle, [] (std::unique_ptr<client_connection>& con) {
+            return con->close();
+        }).then([this] {
+            _connections -= _idle.size();
+            _idle.clear();
+        });
+    });
+}
+
+}
+
+}
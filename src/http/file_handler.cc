@@ -22,17 +22,112 @@
 #include <seastar/http/file_handler.hh>
 #include <seastar/core/seastar.hh>
 #include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <list>
+#include <unordered_map>
 #include <seastar/core/reactor.hh>
+#include <seastar/core/file.hh>
 #include <seastar/core/fstream.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/app-template.hh>
 #include <seastar/http/exception.hh>
+#include <seastar/http/httpd.hh>
 
 namespace seastar {
 
 namespace httpd {
 
+// Shard-local cache of small served files, keyed by path. Entries hold the
+// raw file bytes in a temporary_buffer that is share()d into each response,
+// so a hot file is read from disk once and then served without further disk
+// I/O or copies. Every hit is revalidated against the file's current size
+// and modification time (the caller stats the file anyway to produce the
+// ETag), so a replaced file is picked up on the next request.
+class file_content_cache {
+    size_t _max_entry_size;
+    size_t _capacity;
+public:
+    file_content_cache(size_t max_entry_size, size_t capacity)
+            : _max_entry_size(max_entry_size), _capacity(capacity) {
+    }
+    size_t max_entry_size() const {
+        return _max_entry_size;
+    }
+private:
+    struct entry {
+        sstring path;
+        temporary_buffer<char> content;
+        std::chrono::system_clock::time_point modified;
+    };
+    std::list<entry> _lru; // most recently used first
+    std::unordered_map<sstring, std::list<entry>::iterator> _index;
+    size_t _size = 0;
+private:
+    void erase(std::unordered_map<sstring, std::list<entry>::iterator>::iterator it) {
+        _size -= it->second->content.size();
+        _lru.erase(it->second);
+        _index.erase(it);
+    }
+public:
+    std::optional<temporary_buffer<char>> get(const sstring& path, const stat_data& sd) {
+        auto it = _index.find(path);
+        if (it == _index.end()) {
+            return std::nullopt;
+        }
+        if (it->second->modified != sd.time_modified || it->second->content.size() != sd.size) {
+            // the file changed on disk since it was cached
+            erase(it);
+            return std::nullopt;
+        }
+        _lru.splice(_lru.begin(), _lru, it->second);
+        return _lru.front().content.share();
+    }
+    void put(sstring path, temporary_buffer<char> content, const stat_data& sd) {
+        if (content.size() > _max_entry_size) {
+            return;
+        }
+        auto it = _index.find(path);
+        if (it != _index.end()) {
+            erase(it);
+        }
+        _size += content.size();
+        _lru.push_front(entry{path, std::move(content), sd.time_modified});
+        _index.emplace(std::move(path), _lru.begin());
+        while (_size > _capacity) {
+            _size -= _lru.back().content.size();
+            _index.erase(_lru.back().path);
+            _lru.pop_back();
+        }
+    }
+};
+
+// raw file bytes; large files are better streamed than pinned in memory
+static thread_local file_content_cache content_cache(128 * 1024, 4 * 1024 * 1024);
+// transformer output, keyed by (path, transformer cache key) and likewise
+// revalidated against the source file. Sized for the occasional big asset
+// whose transformation is what this cache is here to avoid repeating.
+static thread_local file_content_cache transformed_cache(4 * 1024 * 1024, 16 * 1024 * 1024);
+
+// Collects everything written through it, so a transformer's output can
+// be captured for the cache.
+class capture_data_sink_impl : public data_sink_impl {
+    std::vector<temporary_buffer<char>>& _bufs;
+public:
+    explicit capture_data_sink_impl(std::vector<temporary_buffer<char>>& bufs) : _bufs(bufs) {
+    }
+    virtual future<> put(net::packet data) override { abort(); }
+    using data_sink_impl::put;
+    virtual future<> put(temporary_buffer<char> buf) override {
+        _bufs.push_back(std::move(buf));
+        return make_ready_future<>();
+    }
+    virtual future<> close() override {
+        return make_ready_future<>();
+    }
+};
+
 directory_handler::directory_handler(const sstring& doc_root,
         file_transformer* transformer)
         : file_interaction_handler(transformer), doc_root(doc_root) {
@@ -83,25 +178,153 @@ output_stream<char> file_interaction_handler::get_stream(std::unique_ptr<request
     return std::move(s);
 }
 
+std::unique_ptr<reply> file_interaction_handler::write_buffer(
+        temporary_buffer<char> content, std::unique_ptr<request> req,
+        const sstring& extension, std::unique_ptr<reply> rep) {
+    rep->write_body(extension, [this, req = std::move(req), extension, content = std::move(content)] (output_stream<char>&& s) mutable {
+        return do_with(output_stream<char>(get_stream(std::move(req), extension, std::move(s))), std::move(content),
+                [] (output_stream<char>& os, temporary_buffer<char>& content) {
+            return os.write(std::move(content)).then([&os] {
+                return os.close();
+            });
+        });
+    });
+    return rep;
+}
+
 future<std::unique_ptr<reply>> file_interaction_handler::read(
         sstring file_name, std::unique_ptr<request> req,
         std::unique_ptr<reply> rep) {
     sstring extension = get_extension(file_name);
-    rep->write_body(extension, [req = std::move(req), extension, file_name, this] (output_stream<char>&& s) mutable {
-        return do_with(output_stream<char>(get_stream(std::move(req), extension, std::move(s))),
-                [file_name] (output_stream<char>& os) {
-            return open_file_dma(file_name, open_flags::ro).then([&os] (file f) {
-                return do_with(input_stream<char>(make_file_input_stream(std::move(f))), [&os](input_stream<char>& is) {
-                    return copy(is, os).then([&os] {
-                        return os.close();
-                    }).then([&is] {
+    return file_stat(file_name).then([this, file_name, extension, req = std::move(req), rep = std::move(rep)] (stat_data sd) mutable {
+        if (!transformer) {
+            // The validators identify the raw file bytes, so they only apply
+            // when no transformer rewrites the body.
+            auto etag = seastar::format("\"{}-{}\"",
+                    sd.time_modified.time_since_epoch().count(), sd.size);
+            auto last_modified = http_server::http_date(std::chrono::system_clock::to_time_t(sd.time_modified));
+            sstring if_none_match = req->get_header("If-None-Match");
+            sstring if_modified_since = req->get_header("If-Modified-Since");
+            if ((!if_none_match.empty() && if_none_match == etag) ||
+                    (if_none_match.empty() && !if_modified_since.empty() && if_modified_since == last_modified)) {
+                rep->_headers["ETag"] = std::move(etag);
+                rep->set_status(reply::status_type::not_modified).done();
+                return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+            }
+            rep->_headers["ETag"] = std::move(etag);
+            rep->_headers["Last-Modified"] = std::move(last_modified);
+        }
+        if (transformer && sd.size <= transformed_cache.max_entry_size()) {
+            if (auto variant = transformer->cache_key(*req, extension)) {
+                sstring key = file_name + "\n" + *variant;
+                if (auto content = transformed_cache.get(key, sd)) {
+                    return make_ready_future<std::unique_ptr<reply>>(
+                            serve_transformed(std::move(*content), extension, std::move(rep)));
+                }
+                return read_transformed(std::move(key), file_name, extension, sd,
+                        std::move(req), std::move(rep));
+            }
+        }
+        if (sd.size <= content_cache.max_entry_size()) {
+            if (auto content = content_cache.get(file_name, sd)) {
+                return make_ready_future<std::unique_ptr<reply>>(
+                        write_buffer(std::move(*content), std::move(req), extension, std::move(rep)));
+            }
+            // small file, cache miss: read it whole and cache it
+            return open_file_dma(file_name, open_flags::ro).then([sd] (file f) {
+                return do_with(input_stream<char>(make_file_input_stream(std::move(f))), [sd] (input_stream<char>& is) {
+                    return is.read_exactly(sd.size).finally([&is] {
                         return is.close();
                     });
                 });
+            }).then([this, file_name, extension, sd, req = std::move(req), rep = std::move(rep)] (temporary_buffer<char> content) mutable {
+                content_cache.put(file_name, content.share(), sd);
+                return write_buffer(std::move(content), std::move(req), extension, std::move(rep));
             });
+        }
+        // Large files are streamed, moving each chunk from the file stream to
+        // the socket instead of copying it into the output stream's buffer.
+        auto body_writer = [req = std::move(req), extension, file_name, this] (output_stream<char>&& s) mutable {
+            return do_with(output_stream<char>(get_stream(std::move(req), extension, std::move(s))),
+                    [file_name] (output_stream<char>& os) {
+                return open_file_dma(file_name, open_flags::ro).then([&os] (file f) {
+                    return do_with(input_stream<char>(make_file_input_stream(std::move(f))), [&os](input_stream<char>& is) {
+                        return repeat([&is, &os] {
+                            return is.read().then([&os] (temporary_buffer<char> buf) {
+                                if (buf.empty()) {
+                                    return make_ready_future<stop_iteration>(stop_iteration::yes);
+                                }
+                                return os.write(std::move(buf)).then([] {
+                                    return stop_iteration::no;
+                                });
+                            });
+                        }).then([&os] {
+                            return os.close();
+                        }).then([&is] {
+                            return is.close();
+                        });
+                    });
+                });
+            });
+        };
+        if (transformer) {
+            // the transformer may change the body size, so it has to go
+            // out chunked
+            rep->write_body(extension, std::move(body_writer));
+        } else {
+            rep->write_body(extension, sd.size, std::move(body_writer));
+        }
+        return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+    });
+}
+
+std::unique_ptr<reply> file_interaction_handler::serve_transformed(
+        temporary_buffer<char> content, const sstring& extension,
+        std::unique_ptr<reply> rep) {
+    // the content already went through the transformer, so it goes out
+    // as it is, with its length known up front
+    rep->write_body(extension, content.size(), [content = std::move(content)] (output_stream<char>&& s) mutable {
+        return do_with(std::move(s), std::move(content),
+                [] (output_stream<char>& os, temporary_buffer<char>& content) {
+            return os.write(std::move(content)).then([&os] {
+                return os.close();
+            });
+        });
+    });
+    return rep;
+}
+
+future<std::unique_ptr<reply>> file_interaction_handler::read_transformed(
+        sstring key, sstring file_name, sstring extension, stat_data sd,
+        std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    return open_file_dma(file_name, open_flags::ro).then([sd] (file f) {
+        return do_with(input_stream<char>(make_file_input_stream(std::move(f))), [sd] (input_stream<char>& is) {
+            return is.read_exactly(sd.size).finally([&is] {
+                return is.close();
+            });
+        });
+    }).then([this, key = std::move(key), extension, sd, req = std::move(req), rep = std::move(rep)] (temporary_buffer<char> raw) mutable {
+        // run the transformation once, into memory, and cache its output
+        auto bufs = make_lw_shared<std::vector<temporary_buffer<char>>>();
+        auto os = make_lw_shared<output_stream<char>>(transformer->transform(std::move(req), extension,
+                output_stream<char>(data_sink(std::make_unique<capture_data_sink_impl>(*bufs)), 32000, true)));
+        return os->write(std::move(raw)).then([os] {
+            return os->close();
+        }).then([this, bufs, os, key = std::move(key), extension, sd, rep = std::move(rep)] () mutable {
+            size_t size = 0;
+            for (auto& b : *bufs) {
+                size += b.size();
+            }
+            temporary_buffer<char> content(size);
+            char* out = content.get_write();
+            for (auto& b : *bufs) {
+                memcpy(out, b.get(), b.size());
+                out += b.size();
+            }
+            transformed_cache.put(std::move(key), content.share(), sd);
+            return serve_transformed(std::move(content), extension, std::move(rep));
         });
     });
-    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
 }
 
 bool file_interaction_handler::redirect_if_needed(const request& req,
@@ -0,0 +1,857 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <seastar/core/loop.hh>
+#include <seastar/core/when_all.hh>
+#include <seastar/http/http2.hh>
+#include <seastar/http/httpd.hh>
+#include <seastar/net/packet.hh>
+#include <seastar/util/log.hh>
+
+namespace seastar {
+
+extern logger hlogger;
+
+namespace httpd {
+
+namespace http2 {
+
+namespace frame_type {
+constexpr uint8_t data = 0x0;
+constexpr uint8_t headers = 0x1;
+constexpr uint8_t priority = 0x2;
+constexpr uint8_t rst_stream = 0x3;
+constexpr uint8_t settings = 0x4;
+constexpr uint8_t ping = 0x6;
+constexpr uint8_t goaway = 0x7;
+constexpr uint8_t window_update = 0x8;
+constexpr uint8_t continuation = 0x9;
+}
+
+namespace frame_flag {
+constexpr uint8_t end_stream = 0x1;
+constexpr uint8_t ack = 0x1;
+constexpr uint8_t end_headers = 0x4;
+constexpr uint8_t padded = 0x8;
+constexpr uint8_t priority = 0x20;
+}
+
+namespace setting {
+constexpr uint16_t initial_window_size = 0x4;
+constexpr uint16_t max_frame_size = 0x5;
+constexpr uint16_t max_concurrent_streams = 0x3;
+}
+
+static constexpr size_t frame_header_size = 9;
+// what we accept; we never ask the peer to raise it
+static constexpr uint32_t our_max_frame_size = 16384;
+static constexpr size_t max_header_block_size = 64 * 1024;
+static constexpr uint32_t max_concurrent_streams = 100;
+
+static void append_u16(std::string& s, uint16_t v) {
+    s.push_back(char(v >> 8));
+    s.push_back(char(v));
+}
+
+static void append_u32(std::string& s, uint32_t v) {
+    s.push_back(char(v >> 24));
+    s.push_back(char(v >> 16));
+    s.push_back(char(v >> 8));
+    s.push_back(char(v));
+}
+
+static uint16_t read_u16(const char* p) {
+    return (uint16_t(uint8_t(p[0])) << 8) | uint8_t(p[1]);
+}
+
+static uint32_t read_u32(const char* p) {
+    return (uint32_t(uint8_t(p[0])) << 24) | (uint32_t(uint8_t(p[1])) << 16)
+            | (uint32_t(uint8_t(p[2])) << 8) | uint8_t(p[3]);
+}
+
+static std::string make_frame(uint8_t type, uint8_t flags, uint32_t stream_id, std::string_view payload) {
+    std::string f;
+    f.reserve(frame_header_size + payload.size());
+    uint32_t len = payload.size();
+    f.push_back(char(len >> 16));
+    f.push_back(char(len >> 8));
+    f.push_back(char(len));
+    f.push_back(char(type));
+    f.push_back(char(flags));
+    append_u32(f, stream_id);
+    f.append(payload.data(), payload.size());
+    return f;
+}
+
+// The static table from RFC 7541, Appendix A.
+struct hpack_static_entry {
+    const char* name;
+    const char* value;
+};
+
+static const hpack_static_entry hpack_static_table[61] = {
+    { ":authority", "" },
+    { ":method", "GET" },
+    { ":method", "POST" },
+    { ":path", "/" },
+    { ":path", "/index.html" },
+    { ":scheme", "http" },
+    { ":scheme", "https" },
+    { ":status", "200" },
+    { ":status", "204" },
+    { ":status", "206" },
+    { ":status", "304" },
+    { ":status", "400" },
+    { ":status", "404" },
+    { ":status", "500" },
+    { "accept-charset", "" },
+    { "accept-encoding", "gzip, deflate" },
+    { "accept-language", "" },
+    { "accept-ranges", "" },
+    { "accept", "" },
+    { "access-control-allow-origin", "" },
+    { "age", "" },
+    { "allow", "" },
+    { "authorization", "" },
+    { "cache-control", "" },
+    { "content-disposition", "" },
+    { "content-encoding", "" },
+    { "content-language", "" },
+    { "content-length", "" },
+    { "content-location", "" },
+    { "content-range", "" },
+    { "content-type", "" },
+    { "cookie", "" },
+    { "date", "" },
+    { "etag", "" },
+    { "expect", "" },
+    { "expires", "" },
+    { "from", "" },
+    { "host", "" },
+    { "if-match", "" },
+    { "if-modified-since", "" },
+    { "if-none-match", "" },
+    { "if-range", "" },
+    { "if-unmodified-since", "" },
+    { "last-modified", "" },
+    { "link", "" },
+    { "location", "" },
+    { "max-forwards", "" },
+    { "proxy-authenticate", "" },
+    { "proxy-authorization", "" },
+    { "range", "" },
+    { "referer", "" },
+    { "refresh", "" },
+    { "retry-after", "" },
+    { "server", "" },
+    { "set-cookie", "" },
+    { "strict-transport-security", "" },
+    { "transfer-encoding", "" },
+    { "user-agent", "" },
+    { "vary", "" },
+    { "via", "" },
+    { "www-authenticate", "" },
+};
+
+hpack_decoder::header_list hpack_decoder::decode(const char* p, size_t len) {
+    auto q = reinterpret_cast<const uint8_t*>(p);
+    auto end = q + len;
+    auto error = [] (const char* msg) {
+        return session_error(error_code::compression_error, msg);
+    };
+    auto integer = [&] (unsigned prefix) -> uint64_t {
+        uint64_t mask = (uint64_t(1) << prefix) - 1;
+        uint64_t v = *q++ & mask;
+        if (v < mask) {
+            return v;
+        }
+        unsigned shift = 0;
+        uint8_t b;
+        do {
+            if (q == end || shift > 28) {
+                throw error("malformed integer");
+            }
+            b = *q++;
+            v += uint64_t(b & 0x7f) << shift;
+            shift += 7;
+        } while (b & 0x80);
+        return v;
+    };
+    auto string = [&] () -> sstring {
+        if (q == end) {
+            throw error("truncated string literal");
+        }
+        bool huffman = *q & 0x80;
+        uint64_t n = integer(7);
+        if (huffman) {
+            throw error("Huffman-coded string literals are not supported");
+        }
+        if (n > uint64_t(end - q)) {
+            throw error("truncated string literal");
+        }
+        sstring s(reinterpret_cast<const char*>(q), n);
+        q += n;
+        return s;
+    };
+    header_list out;
+    while (q != end) {
+        uint8_t b = *q;
+        if (b & 0x80) {
+            // indexed header field
+            out.push_back(at(integer(7)));
+        } else if (b & 0x40) {
+            // literal with incremental indexing
+            uint64_t index = integer(6);
+            sstring name = index ? at(index).first : string();
+            sstring value = string();
+            insert(name, value);
+            out.emplace_back(std::move(name), std::move(value));
+        } else if (b & 0x20) {
+            // dynamic table size update
+            uint64_t size = integer(5);
+            if (size > 4096) {
+                throw error("dynamic table size above the advertised limit");
+            }
+            _max_dynamic_size = size;
+            evict();
+        } else {
+            // literal without indexing and never-indexed, handled alike
+            uint64_t index = integer(4);
+            sstring name = index ? at(index).first : string();
+            sstring value = string();
+            out.emplace_back(std::move(name), std::move(value));
+        }
+    }
+    return out;
+}
+
+std::pair<sstring, sstring> hpack_decoder::at(uint64_t index) const {
+    if (index >= 1 && index <= 61) {
+        auto& e = hpack_static_table[index - 1];
+        return {e.name, e.value};
+    }
+    if (index >= 62 && index - 62 < _dynamic.size()) {
+        return _dynamic[index - 62];
+    }
+    throw session_error(error_code::compression_error, "header index out of range");
+}
+
+void hpack_decoder::insert(sstring name, sstring value) {
+    // entry size as defined in RFC 7541, Section 4.1
+    _dynamic_size += name.size() + value.size() + 32;
+    _dynamic.emplace_front(std::move(name), std::move(value));
+    evict();
+}
+
+void hpack_decoder::evict() {
+    while (_dynamic_size > _max_dynamic_size && !_dynamic.empty()) {
+        auto& e = _dynamic.back();
+        _dynamic_size -= e.first.size() + e.second.size() + 32;
+        _dynamic.pop_back();
+    }
+}
+
+static void encode_integer(std::string& out, uint8_t first_byte, unsigned prefix, uint64_t v) {
+    uint64_t mask = (uint64_t(1) << prefix) - 1;
+    if (v < mask) {
+        out.push_back(char(first_byte | v));
+        return;
+    }
+    out.push_back(char(first_byte | mask));
+    v -= mask;
+    while (v >= 128) {
+        out.push_back(char(0x80 | (v & 0x7f)));
+        v >>= 7;
+    }
+    out.push_back(char(v));
+}
+
+static void encode_string(std::string& out, const sstring& s) {
+    encode_integer(out, 0, 7, s.size());
+    out.append(s.c_str(), s.size());
+}
+
+void hpack_encoder::encode(std::string& out, const sstring& name, const sstring& value) {
+    static const thread_local std::unordered_map<std::string_view, unsigned> name_index = [] {
+        std::unordered_map<std::string_view, unsigned> m;
+        for (unsigned i = 0; i < 61; i++) {
+            // the first entry for a name wins, as it has the lowest index
+            m.emplace(hpack_static_table[i].name, i + 1);
+        }
+        return m;
+    }();
+    auto it = name_index.find(std::string_view(name.c_str(), name.size()));
+    if (it != name_index.end()) {
+        encode_integer(out, 0x00, 4, it->second);
+    } else {
+        out.push_back(0x00);
+        encode_string(out, name);
+    }
+    encode_string(out, value);
+}
+
+void hpack_encoder::encode_status(std::string& out, int status) {
+    switch (status) {
+    case 200: out.push_back(char(0x88)); return;
+    case 204: out.push_back(char(0x89)); return;
+    case 206: out.push_back(char(0x8a)); return;
+    case 304: out.push_back(char(0x8b)); return;
+    case 400: out.push_back(char(0x8c)); return;
+    case 404: out.push_back(char(0x8d)); return;
+    case 500: out.push_back(char(0x8e)); return;
+    }
+    encode_integer(out, 0x00, 4, 8); // the ":status" name from the static table
+    encode_string(out, to_sstring(status));
+}
+
+future<> connection::process() {
+    return when_all(read_loop(), write_loop()).then(
+            [] (std::tuple<future<>, future<>> joined) {
+        try {
+            std::get<0>(joined).get();
+        } catch (...) {
+            hlogger.debug("http2 read exception encountered: {}", std::current_exception());
+        }
+        try {
+            std::get<1>(joined).get();
+        } catch (...) {
+            hlogger.debug("http2 write exception encountered: {}", std::current_exception());
+        }
+        return make_ready_future<>();
+    });
+}
+
+future<> connection::read_loop() {
+    // the request parser already consumed the preface up to and including
+    // the empty header section; the remainder is ours to verify
+    return _read_buf.read_exactly(6).then([this] (temporary_buffer<char> rest) {
+        if (rest.size() != 6 || memcmp(rest.get(), "SM\r\n\r\n", 6) != 0) {
+            throw session_error(error_code::protocol_error, "bad connection preface");
+        }
+        std::string settings;
+        append_u16(settings, setting::max_concurrent_streams);
+        append_u32(settings, max_concurrent_streams);
+        return submit(make_frame(frame_type::settings, 0, 0, settings));
+    }).then([this] {
+        return do_until([this] { return _done; }, [this] {
+            return read_frame().then([this] (std::optional<frame> f) {
+                if (!f) {
+                    _done = true;
+                    return make_ready_future<>();
+                }
+                return handle_frame(std::move(*f));
+            });
+        });
+    }).then_wrapped([this] (future<> f) {
+        auto code = error_code::no_error;
+        try {
+            f.get();
+        } catch (session_error& e) {
+            code = e.code();
+            hlogger.debug("http2 session error: {}", e.what());
+        } catch (...) {
+            code = error_code::internal_error;
+        }
+        // tell the peer why before hanging up; best effort only
+        std::string goaway;
+        append_u32(goaway, _max_stream_id);
+        append_u32(goaway, static_cast<uint32_t>(code));
+        return submit(make_frame(frame_type::goaway, 0, 0, goaway)).then_wrapped([] (future<> f) {
+            f.ignore_ready_future();
+        });
+    }).then([this] {
+        // responses stuck on flow control can make no more progress
+        _window_change.broken();
+        return _pending_responses.close();
+    }).then([this] {
+        return _outq.push_eventually({}).then_wrapped([] (future<> f) {
+            f.ignore_ready_future();
+        });
+    });
+}
+
+future<> connection::write_loop() {
+    return repeat([this] {
+        return _outq.pop_eventually().then([this] (std::string f) {
+            if (f.empty()) {
+                // eof marker; everything before it has been written
+                return make_ready_future<stop_iteration>(stop_iteration::yes);
+            }
+            return _write_buf.write(f.data(), f.size()).then([this] {
+                if (!_outq.empty()) {
+                    // more frames are already waiting; they share this flush
+                    return make_ready_future<stop_iteration>(stop_iteration::no);
+                }
+                return _write_buf.flush().then([] {
+                    return stop_iteration::no;
+                });
+            });
+        });
+    }).handle_exception([this] (std::exception_ptr ex) {
+        // a dead socket must not leave submitters waiting on the queue
+        _outq.abort(ex);
+    });
+}
+
+future<std::optional<connection::frame>> connection::read_frame() {
+    return _read_buf.read_exactly(frame_header_size).then([this] (temporary_buffer<char> h) {
+        if (h.empty()) {
+            return make_ready_future<std::optional<frame>>(std::nullopt);
+        }
+        if (h.size() != frame_header_size) {
+            throw session_error(error_code::protocol_error, "connection closed mid-frame");
+        }
+        uint32_t len = (uint32_t(uint8_t(h[0])) << 16) | (uint32_t(uint8_t(h[1])) << 8) | uint8_t(h[2]);
+        if (len > our_max_frame_size) {
+            throw session_error(error_code::frame_size_error, "frame exceeds SETTINGS_MAX_FRAME_SIZE");
+        }
+        frame f;
+        f.type = h[3];
+        f.flags = h[4];
+        f.stream_id = read_u32(h.get() + 5) & 0x7fffffff;
+        return _read_buf.read_exactly(len).then([f = std::move(f), len] (temporary_buffer<char> payload) mutable {
+            if (payload.size() != len) {
+                throw session_error(error_code::protocol_error, "connection closed mid-frame");
+            }
+            f.payload = std::move(payload);
+            return make_ready_future<std::optional<frame>>(std::move(f));
+        });
+    });
+}
+
+future<> connection::handle_frame(frame f) {
+    // strip the optional pad length prefix and trailing padding
+    auto unpad = [] (frame& f) -> std::pair<const char*, size_t> {
+        const char* data = f.payload.get();
+        size_t size = f.payload.size();
+        if (f.flags & frame_flag::padded) {
+            if (size < 1 || size_t(uint8_t(data[0])) + 1 > size) {
+                throw session_error(error_code::protocol_error, "bad padding");
+            }
+            size -= uint8_t(data[0]) + 1;
+            ++data;
+        }
+        return {data, size};
+    };
+    switch (f.type) {
+    case frame_type::data:
+        return handle_data(std::move(f));
+    case frame_type::headers: {
+        if (f.stream_id == 0) {
+            throw session_error(error_code::protocol_error, "HEADERS on stream 0");
+        }
+        auto [data, size] = unpad(f);
+        if (f.flags & frame_flag::priority) {
+            if (size < 5) {
+                throw session_error(error_code::frame_size_error, "truncated HEADERS");
+            }
+            data += 5;
+            size -= 5;
+        }
+        return read_header_block(f.stream_id, std::string(data, size),
+                f.flags & frame_flag::end_stream, f.flags & frame_flag::end_headers);
+    }
+    case frame_type::priority:
+        return make_ready_future<>();
+    case frame_type::rst_stream:
+        handle_rst_stream(f);
+        return make_ready_future<>();
+    case frame_type::settings:
+        return handle_settings(std::move(f));
+    case frame_type::ping:
+        if (f.stream_id != 0 || f.payload.size() != 8) {
+            throw session_error(error_code::frame_size_error, "bad PING frame");
+        }
+        if (f.flags & frame_flag::ack) {
+            return make_ready_future<>();
+        }
+        return submit(make_frame(frame_type::ping, frame_flag::ack, 0,
+                std::string_view(f.payload.get(), 8)));
+    case frame_type::goaway:
+        _done = true;
+        return make_ready_future<>();
+    case frame_type::window_update:
+        handle_window_update(f);
+        return make_ready_future<>();
+    case frame_type::continuation:
+        throw session_error(error_code::protocol_error, "CONTINUATION without HEADERS");
+    default:
+        // unknown frame types must be ignored (RFC 7540, Section 4.1)
+        return make_ready_future<>();
+    }
+}
+
+future<> connection::handle_data(frame f) {
+    if (f.stream_id == 0) {
+        throw session_error(error_code::protocol_error, "DATA on stream 0");
+    }
+    const char* data = f.payload.get();
+    size_t size = f.payload.size();
+    if (f.flags & frame_flag::padded) {
+        if (size < 1 || size_t(uint8_t(data[0])) + 1 > size) {
+            throw session_error(error_code::protocol_error, "bad padding");
+        }
+        size -= uint8_t(data[0]) + 1;
+        ++data;
+    }
+    auto it = _streams.find(f.stream_id);
+    if (it != _streams.end() && !it->second.dispatched) {
+        auto& s = it->second;
+        s.body += sstring(data, size);
+        if (f.flags & frame_flag::end_stream) {
+            finish_request(f.stream_id, s);
+        }
+    }
+    if (f.payload.empty()) {
+        return make_ready_future<>();
+    }
+    // grant the bytes straight back: requests are buffered whole, so
+    // there is no point throttling the peer below our settings
+    std::string wu;
+    append_u32(wu, f.payload.size());
+    auto frames = make_frame(frame_type::window_update, 0, 0, wu);
+    it = _streams.find(f.stream_id);
+    if (it != _streams.end() && !it->second.dispatched) {
+        // the request is still incomplete; replenish its stream window too
+        frames += make_frame(frame_type::window_update, 0, f.stream_id, wu);
+    }
+    return submit(std::move(frames));
+}
+
+future<> connection::read_header_block(uint32_t stream_id, std::string fragment,
+        bool end_stream, bool end_headers) {
+    if (end_headers) {
+        process_header_block(stream_id, std::move(fragment), end_stream);
+        return make_ready_future<>();
+    }
+    // the block continues in CONTINUATION frames, which must follow
+    // back-to-back on the same stream
+    return read_frame().then([this, stream_id, end_stream, fragment = std::move(fragment)] (std::optional<frame> f) mutable {
+        if (!f || f->type != frame_type::continuation || f->stream_id != stream_id) {
+            throw session_error(error_code::protocol_error, "header block interrupted");
+        }
+        if (fragment.size() + f->payload.size() > max_header_block_size) {
+            throw session_error(error_code::protocol_error, "header block too large");
+        }
+        fragment.append(f->payload.get(), f->payload.size());
+        return read_header_block(stream_id, std::move(fragment), end_stream,
+                f->flags & frame_flag::end_headers);
+    });
+}
+
+void connection::process_header_block(uint32_t stream_id, std::string block, bool end_stream) {
+    // the decoder must see every block to keep its dynamic table in sync,
+    // even for streams whose contents end up discarded
+    auto headers = _decoder.decode(block.data(), block.size());
+    if ((stream_id & 1) == 0) {
+        throw session_error(error_code::protocol_error, "invalid client stream id");
+    }
+    auto it = _streams.find(stream_id);
+    if (it != _streams.end()) {
+        // a second HEADERS on an open stream carries trailers
+        if (!it->second.dispatched && it->second.req) {
+            for (auto& h : headers) {
+                if (h.first.empty() || h.first[0] == ':') {
+                    continue;
+                }
+                it->second.req->trailing_headers[h.first] = std::move(h.second);
+            }
+            if (end_stream) {
+                finish_request(stream_id, it->second);
+            }
+        }
+        return;
+    }
+    if (stream_id <= _max_stream_id) {
+        // a closed stream; nothing useful left to do with it
+        return;
+    }
+    _max_stream_id = stream_id;
+    if (_streams.size() >= max_concurrent_streams) {
+        std::string rst;
+        append_u32(rst, static_cast<uint32_t>(error_code::refused_stream));
+        // if the queue is full the reset is dropped; the peer will find
+        // out when the connection makes no progress on the stream
+        _outq.push(make_frame(frame_type::rst_stream, 0, stream_id, rst));
+        return;
+    }
+    auto req = std::make_unique<request>();
+    req->_version = "2.0";
+    for (auto& h : headers) {
+        if (h.first == ":method") {
+            req->_method = std::move(h.second);
+        } else if (h.first == ":path") {
+            req->_url = std::move(h.second);
+        } else if (h.first == ":scheme") {
+            req->protocol_name = std::move(h.second);
+        } else if (h.first == ":authority") {
+            req->_headers["Host"] = std::move(h.second);
+        } else if (!h.first.empty() && h.first[0] != ':') {
+            auto& value = req->_headers[h.first];
+            if (value.empty()) {
+                value = std::move(h.second);
+            } else {
+                // combined as for repeated HTTP/1.1 header fields
+                value += sstring(",") + h.second;
+            }
+        }
+    }
+    if (req->_method.empty() || req->_url.empty()) {
+        throw session_error(error_code::protocol_error, "missing mandatory pseudo-header");
+    }
+    auto& s = _streams[stream_id];
+    s.send_window = _peer_initial_window;
+    s.req = std::move(req);
+    if (end_stream) {
+        finish_request(stream_id, s);
+    }
+}
+
+future<> connection::handle_settings(frame f) {
+    if (f.stream_id != 0) {
+        throw session_error(error_code::protocol_error, "SETTINGS on a stream");
+    }
+    if (f.flags & frame_flag::ack) {
+        if (!f.payload.empty()) {
+            throw session_error(error_code::frame_size_error, "SETTINGS ack with payload");
+        }
+        return make_ready_future<>();
+    }
+    if (f.payload.size() % 6) {
+        throw session_error(error_code::frame_size_error, "bad SETTINGS frame");
+    }
+    for (size_t off = 0; off < f.payload.size(); off += 6) {
+        uint16_t id = read_u16(f.payload.get() + off);
+        uint32_t value = read_u32(f.payload.get() + off + 2);
+        switch (id) {
+        case setting::initial_window_size: {
+            if (value > 0x7fffffff) {
+                throw session_error(error_code::flow_control_error, "initial window too large");
+            }
+            // applies retroactively to every open stream's window
+            int64_t delta = int64_t(value) - _peer_initial_window;
+            _peer_initial_window = value;
+            for (auto& s : _streams) {
+                s.second.send_window += delta;
+            }
+            _window_change.broadcast();
+            break;
+        }
+        case setting::max_frame_size:
+            if (value < 16384 || value > 16777215) {
+                throw session_error(error_code::protocol_error, "bad SETTINGS_MAX_FRAME_SIZE");
+            }
+            _peer_max_frame_size = value;
+            break;
+        default:
+            // SETTINGS_HEADER_TABLE_SIZE only matters to an encoder that
+            // indexes; the remaining settings we do not use or enforce
+            break;
+        }
+    }
+    return submit(make_frame(frame_type::settings, frame_flag::ack, 0, {}));
+}
+
+void connection::handle_window_update(const frame& f) {
+    if (f.payload.size() != 4) {
+        throw session_error(error_code::frame_size_error, "bad WINDOW_UPDATE frame");
+    }
+    uint32_t increment = read_u32(f.payload.get()) & 0x7fffffff;
+    if (increment == 0) {
+        throw session_error(error_code::protocol_error, "zero window increment");
+    }
+    if (f.stream_id == 0) {
+        _send_window += increment;
+        if (_send_window > 0x7fffffff) {
+            throw session_error(error_code::flow_control_error, "connection window overflow");
+        }
+    } else {
+        auto it = _streams.find(f.stream_id);
+        if (it != _streams.end()) {
+            it->second.send_window += increment;
+        }
+    }
+    _window_change.broadcast();
+}
+
+void connection::handle_rst_stream(const frame& f) {
+    if (f.stream_id == 0 || f.payload.size() != 4) {
+        throw session_error(error_code::frame_size_error, "bad RST_STREAM frame");
+    }
+    auto it = _streams.find(f.stream_id);
+    if (it == _streams.end()) {
+        return;
+    }
+    if (it->second.dispatched) {
+        // the handler is running; its response must be dropped, not sent
+        _reset.insert(f.stream_id);
+        // wake a sender stuck on this stream's window
+        _window_change.broadcast();
+    } else {
+        _streams.erase(it);
+    }
+}
+
+void connection::finish_request(uint32_t stream_id, stream& s) {
+    auto req = std::move(s.req);
+    req->content_length = s.body.size();
+    req->content = std::move(s.body);
+    s.dispatched = true;
+    dispatch(stream_id, std::move(req));
+}
+
+void connection::dispatch(uint32_t stream_id, std::unique_ptr<request> req) {
+    ++_server._requests_served;
+    (void)with_gate(_pending_responses, [this, stream_id, req = std::move(req)] () mutable {
+        sstring url = httpd::connection::set_query_param(*req);
+        auto resp = std::make_unique<reply>();
+        resp->set_version(req->_version);
+        resp->_headers["Server"] = "Seastar httpd";
+        resp->_headers["Date"] = _server._date;
+        return _server._routes.handle(url, std::move(req), std::move(resp)).then(
+                [this, stream_id] (std::unique_ptr<reply> rep) {
+            return send_response(stream_id, std::move(rep));
+        }).handle_exception([stream_id] (std::exception_ptr ex) {
+            hlogger.debug("http2 stream {} response failed: {}", stream_id, ex);
+        });
+    });
+}
+
+future<> connection::send_response(uint32_t stream_id, std::unique_ptr<reply> rep) {
+    if (_reset.erase(stream_id)) {
+        _streams.erase(stream_id);
+        return make_ready_future<>();
+    }
+    auto& r = *rep;
+    return materialize_body(r).then([this, stream_id, rep = std::move(rep)] (std::string body) mutable {
+        std::string block;
+        _encoder.encode_status(block, static_cast<int>(rep->_status));
+        for (auto& h : rep->_headers) {
+            sstring name = h.first;
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            if (name == "connection" || name == "keep-alive" || name == "transfer-encoding") {
+                // connection-specific headers must not appear in HTTP/2
+                continue;
+            }
+            _encoder.encode(block, name, h.second);
+        }
+        _encoder.encode(block, "content-length", to_sstring(body.size()));
+        // the whole block goes out as one queue element, keeping it
+        // contiguous on the wire as required, no matter how frames of
+        // other streams are being queued around it
+        std::string frames;
+        size_t off = 0;
+        bool first = true;
+        do {
+            size_t chunk = std::min(block.size() - off, size_t(_peer_max_frame_size));
+            bool last = off + chunk == block.size();
+            uint8_t type = first ? frame_type::headers : frame_type::continuation;
+            uint8_t flags = (last ? frame_flag::end_headers : 0)
+                    | (first && body.empty() ? frame_flag::end_stream : 0);
+            frames += make_frame(type, flags, stream_id,
+                    std::string_view(block).substr(off, chunk));
+            off += chunk;
+            first = false;
+        } while (off < block.size());
+        return submit(std::move(frames)).then([this, stream_id, body = std::move(body)] () mutable {
+            if (body.empty()) {
+                return make_ready_future<>();
+            }
+            return send_data(stream_id, std::move(body));
+        }).finally([this, stream_id] {
+            _streams.erase(stream_id);
+            _reset.erase(stream_id);
+        });
+    });
+}
+
+future<> connection::send_data(uint32_t stream_id, std::string body) {
+    return do_with(std::move(body), size_t(0), [this, stream_id] (std::string& body, size_t& off) {
+        return do_until([&body, &off] { return off == body.size(); }, [this, stream_id, &body, &off] {
+            if (_reset.count(stream_id)) {
+                // the peer gave up on the stream mid-response
+                off = body.size();
+                return make_ready_future<>();
+            }
+            auto it = _streams.find(stream_id);
+            int64_t window = std::min(_send_window, it->second.send_window);
+            if (window <= 0) {
+                return _window_change.wait();
+            }
+            size_t chunk = std::min({body.size() - off, size_t(window), size_t(_peer_max_frame_size)});
+            _send_window -= chunk;
+            it->second.send_window -= chunk;
+            bool last = off + chunk == body.size();
+            auto f = make_frame(frame_type::data, last ? frame_flag::end_stream : 0,
+                    stream_id, std::string_view(body.data() + off, chunk));
+            off += chunk;
+            return submit(std::move(f));
+        });
+    });
+}
+
+// collects everything written through an output_stream into a string
+class memory_sink final : public data_sink_impl {
+    std::string& _out;
+public:
+    explicit memory_sink(std::string& out) : _out(out) {
+    }
+    future<> put(net::packet data) override {
+        for (unsigned i = 0; i < data.nr_frags(); i++) {
+            auto& frag = data.frag(i);
+            _out.append(frag.base, frag.size);
+        }
+        return make_ready_future<>();
+    }
+    future<> put(temporary_buffer<char> buf) override {
+        _out.append(buf.get(), buf.size());
+        return make_ready_future<>();
+    }
+    future<> close() override {
+        return make_ready_future<>();
+    }
+};
+
+future<std::string> connection::materialize_body(reply& rep) {
+    if (!rep._body_writer) {
+        return make_ready_future<std::string>(std::string(rep._content.c_str(), rep._content.size()));
+    }
+    // HTTP/2 has no chunked transfer coding, and flow control wants the
+    // length up front, so a streamed body is collected in memory first
+    auto out = std::make_unique<std::string>();
+    auto& s = *out;
+    output_stream<char> os(data_sink(std::make_unique<memory_sink>(s)), 8192);
+    return rep._body_writer(std::move(os)).then([out = std::move(out)] {
+        return make_ready_future<std::string>(std::move(*out));
+    });
+}
+
+future<> connection::submit(std::string frame_bytes) {
+    return _outq.push_eventually(std::move(frame_bytes));
+}
+
+}
+
+}
+
+}
@@ -27,6 +27,7 @@
 #include <seastar/core/when_all.hh>
 #include <seastar/core/metrics.hh>
 #include <seastar/core/print.hh>
+#include <seastar/core/reactor.hh>
 #include <iostream>
 #include <algorithm>
 #include <unordered_map>
@@ -35,7 +36,9 @@
 #include <limits>
 #include <cctype>
 #include <vector>
+#include <seastar/http/http2.hh>
 #include <seastar/http/httpd.hh>
+#include <seastar/http/websocket.hh>
 #include <seastar/http/internal/content_source.hh>
 #include <seastar/http/reply.hh>
 #include <seastar/http/short_streams.hh>
@@ -59,7 +62,8 @@ http_stats::http_stats(http_server& server, const sstring& name)
             sm::make_gauge("connections_current", [&server] { return server.current_connections(); }, sm::description("The current number of open  connections"), labels),
             sm::make_derive("read_errors", [&server] { return server.read_errors(); }, sm::description("The total number of errors while reading http requests"), labels),
             sm::make_derive("reply_errors", [&server] { return server.reply_errors(); }, sm::description("The total number of errors while replying to http"), labels),
-            sm::make_derive("requests_served", [&server] { return server.requests_served(); }, sm::description("The total number of http requests served"), labels)
+            sm::make_derive("requests_served", [&server] { return server.requests_served(); }, sm::description("The total number of http requests served"), labels),
+            sm::make_derive("requests_shed", [&server] { return server.requests_shed(); }, sm::description("The total number of http requests rejected with 503 because the shard was overloaded (see --overload-threshold-ms)"), labels)
     });
 }
 
@@ -94,6 +98,10 @@ future<> connection::start_response() {
                 f.ignore_ready_future();
                 return make_ready_future<>();
             }
+            if (_resp->_body_writer_length) {
+                // the body went out under a Content-Length, not chunked
+                return make_ready_future<>();
+            }
             return _write_buf.write("0\r\n\r\n", 5);
         }).then_wrapped([this ] (auto f) {
             if (f.failed()) {
@@ -116,7 +124,7 @@ future<> connection::start_response() {
                 _replies.push(std::unique_ptr<reply>());
                 f.ignore_ready_future();
             }
-            _resp.reset();
+            recycle_reply(std::move(_resp));
             return make_ready_future<>();
         });
     }
@@ -133,7 +141,7 @@ future<> connection::start_response() {
     }).then([this] {
         return _write_buf.flush();
     }).then([this] {
-        _resp.reset();
+        recycle_reply(std::move(_resp));
     });
 }
 
@@ -209,8 +217,24 @@ set_request_content(std::unique_ptr<httpd::request> req, input_stream<char>* con
     }
 }
 
+std::unique_ptr<reply> connection::allocate_reply() {
+    if (_reply_pool.empty()) {
+        return std::make_unique<reply>();
+    }
+    auto resp = std::move(_reply_pool.back());
+    _reply_pool.pop_back();
+    return resp;
+}
+
+void connection::recycle_reply(std::unique_ptr<reply> resp) {
+    if (resp && _reply_pool.size() < max_pooled_replies) {
+        resp->clear();
+        _reply_pool.push_back(std::move(resp));
+    }
+}
+
 void connection::generate_error_reply_and_close(std::unique_ptr<httpd::request> req, reply::status_type status, const sstring& msg) {
-    auto resp = std::make_unique<reply>();
+    auto resp = allocate_reply();
     // TODO: Handle HTTP/2.0 when it releases
     resp->set_version(req->_version);
     resp->set_status(status, msg);
@@ -226,8 +250,18 @@ future<> connection::read_one() {
             _done = true;
             return make_ready_future<>();
         }
-        ++_server._requests_served;
         std::unique_ptr<httpd::request> req = _parser.get_parsed_request();
+        if (req->_method == "PRI" && req->_url == "*" && req->_version == "2.0") {
+            // The HTTP/2 prior-knowledge connection preface (RFC 7540,
+            // Section 3.4) parses as a request line. The rest of the
+            // connection speaks HTTP/2; when the session ends, so does
+            // the connection.
+            _done = true;
+            return do_with(http2::connection(_server, _read_buf, _write_buf), [] (http2::connection& conn) {
+                return conn.process();
+            });
+        }
+        ++_server._requests_served;
         if (_server._credentials) {
             req->protocol_name = "https";
         }
@@ -240,6 +274,18 @@ future<> connection::read_one() {
             return make_ready_future<>();
         }
 
+        if (engine().overloaded()) {
+            // Shed early: the request would otherwise queue behind a
+            // backlog the shard already cannot drain in time.
+            ++_server._requests_shed;
+            generate_error_reply_and_close(std::move(req), reply::status_type::service_unavailable, "Shard is overloaded");
+            return make_ready_future<>();
+        }
+
+        if (request::case_insensitive_cmp()(req->get_header("Upgrade"), "websocket")) {
+            return upgrade_websocket(std::move(req));
+        }
+
         size_t content_length_limit = _server.get_content_length_limit();
         sstring length_header = req->get_header("Content-Length");
         req->content_length = strtol(length_header.c_str(), nullptr, 10);
@@ -260,7 +306,7 @@ future<> connection::read_one() {
         auto maybe_reply_continue = [this, req = std::move(req)] () mutable {
             if (req->_version == "1.1" && request::case_insensitive_cmp()(req->get_header("Expect"), "100-continue")){
                 return _replies.not_full().then([req = std::move(req), this] () mutable {
-                    auto continue_reply = std::make_unique<reply>();
+                    auto continue_reply = allocate_reply();
                     set_headers(*continue_reply);
                     continue_reply->set_version(req->_version);
                     continue_reply->set_status(reply::status_type::continue_).done();
@@ -273,8 +319,21 @@ future<> connection::read_one() {
         };
 
         return maybe_reply_continue().then([this] (std::unique_ptr<httpd::request> req) {
-            return do_with(make_content_stream(req.get(), _read_buf), sstring(req->_version), std::move(req), [this] (input_stream<char>& content_stream, sstring& version, std::unique_ptr<httpd::request>& req) {
-                return set_request_content(std::move(req), &content_stream, _server.get_content_streaming()).then([this, &content_stream] (std::unique_ptr<httpd::request> req) {
+            bool streaming = _server.get_content_streaming();
+            if (!streaming) {
+                // peek at the handler this request routes to: one that
+                // asked for the content stream gets it without the
+                // server-wide setting. The parameter match is redone by
+                // routes::handle later; if the lookup disagrees with it
+                // for some reason, we merely buffer the content as before.
+                parameters params;
+                sstring path = req->_url.substr(0, req->_url.find('?'));
+                handler_base* handler = _server._routes.get_handler(
+                        str2type(req->_method), _server._routes.normalize_url(path), params);
+                streaming = handler != nullptr && handler->needs_content_stream();
+            }
+            return do_with(make_content_stream(req.get(), _read_buf), sstring(req->_version), std::move(req), [this, streaming] (input_stream<char>& content_stream, sstring& version, std::unique_ptr<httpd::request>& req) {
+                return set_request_content(std::move(req), &content_stream, streaming).then([this, &content_stream] (std::unique_ptr<httpd::request> req) {
                     return _replies.not_full().then([this, req = std::move(req)] () mutable {
                         return generate_reply(std::move(req));
                     }).then([this, &content_stream](bool done) {
@@ -414,8 +473,40 @@ void connection::set_headers(reply& resp) {
     resp._headers["Date"] = _server._date;
 }
 
+future<> connection::upgrade_websocket(std::unique_ptr<httpd::request> req) {
+    // After the handshake the connection speaks the websocket protocol
+    // until it closes, like the http2 preface path above: the respond
+    // loop stays parked on the replies queue, so the handshake line and
+    // the frames go straight to the write buffer.
+    _done = true;
+    sstring key = req->get_header("Sec-WebSocket-Key");
+    sstring url = set_query_param(*req);
+    auto it = _server._websocket_handlers.find(url);
+    if (it == _server._websocket_handlers.end()) {
+        generate_error_reply_and_close(std::move(req), reply::status_type::not_found, "No websocket handler for url");
+        return make_ready_future<>();
+    }
+    if (key.empty() || req->get_header("Sec-WebSocket-Version") != "13") {
+        generate_error_reply_and_close(std::move(req), reply::status_type::bad_request, "Malformed websocket handshake");
+        return make_ready_future<>();
+    }
+    sstring handshake =
+            "HTTP/1.1 101 Switching Protocols\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            "Sec-WebSocket-Accept: " + websocket::handshake_accept(key) + "\r\n\r\n";
+    return _write_buf.write(handshake.data(), handshake.size()).then([this] {
+        return _write_buf.flush();
+    }).then([this, handler = it->second] {
+        return do_with(websocket::connection(_read_buf, _write_buf), std::move(handler),
+                [] (websocket::connection& conn, std::function<future<> (websocket::connection&)>& handler) {
+            return handler(conn);
+        });
+    });
+}
+
 future<bool> connection::generate_reply(std::unique_ptr<request> req) {
-    auto resp = std::make_unique<reply>();
+    auto resp = allocate_reply();
     bool conn_keep_alive = false;
     bool conn_close = false;
     auto it = req->_headers.find("Connection");
@@ -473,6 +564,10 @@ void http_server::set_content_streaming(bool b) {
     _content_streaming = b;
 }
 
+void http_server::set_websocket_handler(const sstring& url, std::function<future<> (websocket::connection&)> handler) {
+    _websocket_handlers[url] = std::move(handler);
+}
+
 future<> http_server::listen(socket_address addr, listen_options lo) {
     if (_credentials) {
         _listeners.push_back(seastar::tls::listen(_credentials, addr, lo));
@@ -543,12 +638,14 @@ uint64_t http_server::read_errors() const {
 uint64_t http_server::reply_errors() const {
     return _respond_errors;
 }
+uint64_t http_server::requests_shed() const {
+    return _requests_shed;
+}
 
-// Write the current date in the specific "preferred format" defined in
+// Write the given date in the specific "preferred format" defined in
 // RFC 7231, Section 7.1.1.1, a.k.a. IMF (Internet Message Format) fixdate.
 // For example: Sun, 06 Nov 1994 08:49:37 GMT
-sstring http_server::http_date() {
-    auto t = ::time(nullptr);
+sstring http_server::http_date(time_t t) {
     struct tm tm;
     gmtime_r(&t, &tm);
     // Using strftime() would have been easier, but unfortunately relies on
@@ -565,6 +662,10 @@ sstring http_server::http_date() {
         tm.tm_hour, tm.tm_min, tm.tm_sec);
 }
 
+sstring http_server::http_date() {
+    return http_date(::time(nullptr));
+}
+
 
 future<> http_server_control::start(const sstring& name) {
     return _server_dist->start(name);
@@ -0,0 +1,130 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB
+ */
+
+#include <seastar/http/internal/parser_scan.hh>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace seastar {
+
+namespace internal {
+
+static constexpr bool is_tchar(uint8_t c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+        || c == '-' || c == '!' || c == '#' || c == '$' || c == '%' || c == '&'
+        || c == '\'' || c == '*' || c == '+' || c == '.' || c == '^' || c == '_'
+        || c == '`' || c == '|' || c == '~';
+}
+
+// value chars are VCHAR / obs-text / SP / HT; the complement is the
+// CTLs other than HT, and DEL
+static constexpr bool is_value_char(uint8_t c) {
+    return c == '\t' || (c >= 0x20 && c != 0x7f);
+}
+
+size_t scan_token_chars(const char* p, size_t len) {
+    // field names are a handful of bytes; a table-free scalar scan is
+    // already cheaper than setting up a vector loop
+    size_t i = 0;
+    while (i < len && is_tchar(p[i])) {
+        i++;
+    }
+    return i;
+}
+
+static size_t scan_value_chars_scalar(const char* p, size_t len) {
+    size_t i = 0;
+    while (i < len && is_value_char(p[i])) {
+        i++;
+    }
+    return i;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+[[gnu::target("sse4.2")]]
+static size_t scan_value_chars_sse42(const char* p, size_t len) {
+    // the ranges of bytes that end a value run: CTLs other than HT, and
+    // DEL (zero-padded to a full vector; only the first 6 bytes are used)
+    static const char ranges[16] = "\x00\x08\x0a\x1f\x7f\x7f";
+    const __m128i needle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ranges));
+    size_t i = 0;
+    while (len - i >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        int r = _mm_cmpestri(needle, 6, chunk, 16,
+                _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+        i += r;
+        if (r != 16) {
+            return i;
+        }
+    }
+    return i + scan_value_chars_scalar(p + i, len - i);
+}
+
+[[gnu::target("avx2")]]
+static size_t scan_value_chars_avx2(const char* p, size_t len) {
+    const __m256i tab = _mm256_set1_epi8(0x09);
+    const __m256i del = _mm256_set1_epi8(0x7f);
+    const __m256i ctl_max = _mm256_set1_epi8(0x1f);
+    size_t i = 0;
+    while (len - i >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        // unsigned v <= 0x1f, computed as min(v, 0x1f) == v
+        __m256i is_ctl = _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctl_max), v);
+        __m256i is_tab = _mm256_cmpeq_epi8(v, tab);
+        __m256i is_del = _mm256_cmpeq_epi8(v, del);
+        __m256i bad = _mm256_or_si256(_mm256_andnot_si256(is_tab, is_ctl), is_del);
+        uint32_t mask = _mm256_movemask_epi8(bad);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+        i += 32;
+    }
+    return i + scan_value_chars_scalar(p + i, len - i);
+}
+
+static auto resolve_scan_value_chars() {
+    if (__builtin_cpu_supports("avx2")) {
+        return scan_value_chars_avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return scan_value_chars_sse42;
+    }
+    return scan_value_chars_scalar;
+}
+
+static const auto scan_value_chars_impl = resolve_scan_value_chars();
+
+#else
+
+static const auto scan_value_chars_impl = scan_value_chars_scalar;
+
+#endif
+
+size_t scan_value_chars(const char* p, size_t len) {
+    return scan_value_chars_impl(p, len);
+}
+
+}
+
+}
@@ -30,6 +30,7 @@
 //
 #include <seastar/http/reply.hh>
 #include <seastar/core/print.hh>
+#include <seastar/core/scattered_message.hh>
 #include <seastar/http/httpd.hh>
 #include <seastar/core/loop.hh>
 
@@ -120,10 +121,27 @@ sstring reply::response_line() {
 
 class http_chunked_data_sink_impl : public data_sink_impl {
     output_stream<char>& _out;
-
-    future<> write_size(size_t s) {
-        auto req = format("{:x}\r\n", s);
-        return _out.write(req);
+    // holds the current chunk's size line; puts are serialized, so the
+    // line only needs to live until its write resolves
+    char _size_line[18];
+
+    // Format "<hex size>\r\n" into buf from a digit table, returning the
+    // length; small enough that it never allocates.
+    static size_t format_size_line(char* buf, size_t n) {
+        static constexpr char digits[] = "0123456789abcdef";
+        char tmp[16];
+        size_t i = 0;
+        do {
+            tmp[i++] = digits[n & 0xf];
+            n >>= 4;
+        } while (n);
+        size_t o = 0;
+        while (i) {
+            buf[o++] = tmp[--i];
+        }
+        buf[o++] = '\r';
+        buf[o++] = '\n';
+        return o;
     }
 public:
     http_chunked_data_sink_impl(output_stream<char>& out) : _out(out) {
@@ -136,12 +154,16 @@ public:
             // may consider it an end of message
             return make_ready_future<>();
         }
-        auto size = buf.size();
-        return write_size(size).then([this, buf = std::move(buf)] () mutable {
-            return _out.write(buf.get(), buf.size());
-        }).then([this] () mutable {
-            return _out.write("\r\n", 2);
-        });
+        // The size line, the caller's buffer and the trailing CRLF go
+        // down as one scattered message, so the body bytes are never
+        // copied into an intermediate buffer.
+        scattered_message<char> msg;
+        msg.reserve(3);
+        msg.append_static(_size_line, format_size_line(_size_line, buf.size()));
+        msg.append_static(buf.get(), buf.size());
+        msg.append_static("\r\n");
+        msg.on_delete([buf = std::move(buf)] {});
+        return _out.write(std::move(msg));
     }
     virtual future<> close() override {
         return  make_ready_future<>();
@@ -159,24 +181,58 @@ static output_stream<char> make_http_chunked_output_stream(output_stream<char>&
     return output_stream<char>(http_chunked_data_sink(out), 32000, true);
 }
 
+// Forwards the body bytes to the connection's stream as they are, for
+// replies whose Content-Length is known up front. Closing it must not
+// close the underlying connection, which lives on to serve the next
+// request.
+class http_body_data_sink_impl : public data_sink_impl {
+    output_stream<char>& _out;
+public:
+    http_body_data_sink_impl(output_stream<char>& out) : _out(out) {
+    }
+    virtual future<> put(net::packet data)  override { abort(); }
+    using data_sink_impl::put;
+    virtual future<> put(temporary_buffer<char> buf) override {
+        return _out.write(std::move(buf));
+    }
+    virtual future<> close() override {
+        return  make_ready_future<>();
+    }
+};
+
+static output_stream<char> make_http_body_output_stream(output_stream<char>& out) {
+    return output_stream<char>(data_sink(std::make_unique<http_body_data_sink_impl>(out)), 32000, true);
+}
 
 void reply::write_body(const sstring& content_type, noncopyable_function<future<>(output_stream<char>&&)>&& body_writer) {
     set_content_type(content_type);
     _body_writer  = std::move(body_writer);
 }
 
+void reply::write_body(const sstring& content_type, size_t content_length, noncopyable_function<future<>(output_stream<char>&&)>&& body_writer) {
+    write_body(content_type, std::move(body_writer));
+    _body_writer_length = content_length;
+}
+
 void reply::write_body(const sstring& content_type, const sstring& content) {
     _content = content;
     done(content_type);
 }
 
 future<> reply::write_reply_to_connection(connection& con) {
-    add_header("Transfer-Encoding", "chunked");
+    if (_body_writer_length) {
+        add_header("Content-Length", to_sstring(*_body_writer_length));
+    } else {
+        add_header("Transfer-Encoding", "chunked");
+    }
     return con.out().write(response_line()).then([this, &con] () mutable {
         return write_reply_headers(con);
     }).then([&con] () mutable {
         return con.out().write("\r\n", 2);
     }).then([this, &con] () mutable {
+        if (_body_writer_length) {
+            return _body_writer(make_http_body_output_stream(con.out()));
+        }
         return _body_writer(make_http_chunked_output_stream(con.out()));
     });
 
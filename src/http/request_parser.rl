@@ -22,8 +22,10 @@
 #pragma once
 
 #include <seastar/core/ragel.hh>
+#include <cstring>
 #include <memory>
 #include <unordered_map>
+#include <seastar/http/internal/parser_scan.hh>
 #include <seastar/http/request.hh>
 
 namespace seastar {
@@ -144,11 +146,101 @@ public:
 public:
     void init() {
         init_base();
-        _req.reset(new httpd::request());
+        if (_req) {
+            // a request left over from a parse that never handed it out;
+            // clearing keeps the memory its maps already allocated
+            _req->clear();
+        } else {
+            _req.reset(new httpd::request());
+        }
         _state = state::eof;
         %% write init;
     }
+    // Hand-written parser for the common case: a well-formed request whose
+    // start line and headers are entirely within this buffer, with no
+    // obs-fold continuation lines. Header values are located with the
+    // vectorized scanners instead of the byte-at-a-time state machine, which
+    // matters when parsing is a sizable share of a request's CPU cost.
+    //
+    // Returns the position past the final CRLF on success, with _req fully
+    // populated. Returns nullptr if the request needs the full grammar or
+    // does not end in this buffer; _req may have been partially filled by
+    // then and must be reset before falling back to the state machine.
+    char* parse_fast(char* p, char* pe) {
+        char* q = p;
+        // start line
+        char* start = q;
+        while (q != pe && *q >= 'A' && *q <= 'Z') {
+            ++q;
+        }
+        if (q == start || q == pe || *q != ' ') {
+            return nullptr;
+        }
+        _req->_method = sstring(start, q - start);
+        start = ++q;
+        // the value character class is a superset of what may appear in a
+        // URI; the terminating SP is then found within the clean prefix
+        q += seastar::internal::scan_value_chars(q, pe - q);
+        char* uri_end = static_cast<char*>(memchr(start, ' ', q - start));
+        if (!uri_end || uri_end == start) {
+            return nullptr;
+        }
+        _req->_url = sstring(start, uri_end - start);
+        q = uri_end + 1;
+        if (pe - q < 10 || memcmp(q, "HTTP/", 5) != 0
+                || q[5] < '0' || q[5] > '9' || q[6] != '.' || q[7] < '0' || q[7] > '9'
+                || q[8] != '\r' || q[9] != '\n') {
+            return nullptr;
+        }
+        _req->_version = sstring(q + 5, 3);
+        q += 10;
+        // headers
+        while (true) {
+            if (pe - q >= 2 && q[0] == '\r' && q[1] == '\n') {
+                return q + 2;
+            }
+            auto name_len = seastar::internal::scan_token_chars(q, pe - q);
+            if (name_len == 0 || size_t(pe - q) == name_len || q[name_len] != ':') {
+                return nullptr;
+            }
+            sstring name(q, name_len);
+            q += name_len + 1;
+            while (q != pe && (*q == ' ' || *q == '\t')) {
+                ++q;
+            }
+            start = q;
+            q += seastar::internal::scan_value_chars(q, pe - q);
+            if (pe - q < 2 || q[0] != '\r' || q[1] != '\n') {
+                return nullptr;
+            }
+            char* value_end = q;
+            q += 2;
+            if (q != pe && (*q == ' ' || *q == '\t')) {
+                // obs-fold continuation lines take the slow path
+                return nullptr;
+            }
+            while (value_end != start && (value_end[-1] == ' ' || value_end[-1] == '\t')) {
+                --value_end;
+            }
+            sstring value(start, value_end - start);
+            if (_req->_headers.count(name)) {
+                // combined as in the assign_field action below
+                _req->_headers[name] += sstring(",") + std::move(value);
+            } else {
+                _req->_headers[name] = std::move(value);
+            }
+        }
+    }
     char* parse(char* p, char* pe, char* eof) {
+        if (_fsm_cs == start && p != pe) {
+            if (char* parsed = parse_fast(p, pe)) {
+                _state = state::done;
+                return parsed;
+            }
+            // the fast path may have partially filled the request before
+            // bailing out; the state machine rebuilds it from scratch
+            _req->clear();
+        }
         sstring_builder::guard g(_builder, p, pe);
         auto str = [this, &g, &p] { g.mark_end(p); return get_str(); };
         bool done = false;
@@ -20,6 +20,7 @@
  */
 
 #include <seastar/core/ragel.hh>
+#include <cstdlib>
 #include <memory>
 #include <unordered_map>
 
@@ -27,7 +28,10 @@ namespace seastar {
 
 struct http_response {
     sstring _version;
+    int _status_code = 0;
     std::unordered_map<sstring, sstring> _headers;
+    // not filled by the parser; holds the body when a client buffers it
+    sstring _content;
 };
 
 %% machine http_response;
@@ -44,6 +48,10 @@ action store_version {
     _rsp->_version = str();
 }
 
+action store_status {
+    _rsp->_status_code = std::atoi(str().c_str());
+}
+
 action store_field_name {
     _field_name = str();
 }
@@ -80,7 +88,7 @@ http_version = 'HTTP/' (digit '.' digit) >mark %store_version;
 
 field = tchar+ >mark %store_field_name;
 value = any* >mark %store_value;
-start_line = http_version space digit digit digit space (any - cr - lf)* crlf;
+start_line = http_version space (digit digit digit) >mark %store_status space (any - cr - lf)* crlf;
 header_1st = (field sp_ht* ':' value :> crlf) %assign_field;
 header_cont = (sp_ht+ value sp_ht* crlf) %extend_field;
 header = header_1st header_cont*;
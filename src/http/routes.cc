@@ -31,6 +31,214 @@ namespace httpd {
 
 using namespace std;
 
+/**
+ * The registered rules compiled into a radix trie over url segments, so
+ * that a lookup costs one descent instead of attempting every rule, with
+ * no allocations and parameter positions recorded into fixed slots until
+ * a rule is chosen.
+ *
+ * Each trie edge is one url segment including its leading slash (a
+ * str_matcher may span several edges); a node may also have a parameter
+ * edge consuming any one segment, a terminal for rules ending at the
+ * node and a terminal for rules ending in an entire-path parameter.
+ * Rules the trie cannot express -- custom matcher implementations,
+ * fixed strings not aligned to segment boundaries, an entire-path
+ * parameter in the middle of a rule -- keep the linear path.
+ *
+ * The linear scan tried rules in registration order, so among several
+ * matching rules the oldest must still win: terminals carry the rule's
+ * cookie, the descent tracks the lowest-cookie match, and the leftover
+ * linear rules are only attempted while they are older than it.
+ */
+struct routes::dispatch_trie {
+    // Rules have a handful of parameters; anything larger is left on the
+    // linear path.
+    static constexpr size_t max_params = 16;
+    using slot = std::pair<uint32_t, uint32_t>; // offset, length in the url
+    using slot_array = std::array<slot, max_params>;
+
+    struct terminal {
+        rule_cookie cookie;
+        handler_base* handler;
+        // parameter names in match order; values land in the same slots
+        std::vector<sstring> param_names;
+        // engaged when the rule ends in an entire-path parameter
+        std::optional<sstring> rest_name;
+    };
+
+    struct node {
+        // fixed-segment edges, sorted by segment for binary search
+        std::vector<std::pair<sstring, std::unique_ptr<node>>> children;
+        // parameter edge: consumes any one segment
+        std::unique_ptr<node> param_child;
+        std::optional<terminal> term;
+        std::optional<terminal> rest_term;
+    };
+
+    node _root;
+    // rules the trie cannot express, in registration order
+    std::vector<std::pair<rule_cookie, match_rule*>> _linear;
+
+    static node& child(node& n, std::string_view segment) {
+        auto i = std::lower_bound(n.children.begin(), n.children.end(), segment,
+                [] (const auto& c, std::string_view s) {
+            return std::string_view(c.first) < s;
+        });
+        if (i == n.children.end() || std::string_view(i->first) != segment) {
+            i = n.children.emplace(i, sstring(segment), std::make_unique<node>());
+        }
+        return *i->second;
+    }
+
+    static const node* find_child(const node& n, std::string_view segment) {
+        auto i = std::lower_bound(n.children.begin(), n.children.end(), segment,
+                [] (const auto& c, std::string_view s) {
+            return std::string_view(c.first) < s;
+        });
+        if (i == n.children.end() || std::string_view(i->first) != segment) {
+            return nullptr;
+        }
+        return i->second.get();
+    }
+
+    // Add one rule, or return false when it has to stay on the linear path
+    bool insert(rule_cookie cookie, match_rule& rule) {
+        node* n = &_root;
+        terminal term{cookie, rule.handler(), {}, std::nullopt};
+        const auto& matchers = rule.matchers();
+        if (matchers.empty()) {
+            // an empty rule matches any url; the linear path keeps that
+            return false;
+        }
+        for (size_t i = 0; i < matchers.size(); i++) {
+            if (auto* str = dynamic_cast<str_matcher*>(matchers[i])) {
+                const sstring& pattern = str->pattern();
+                // carve the pattern into /segment pieces; a pattern not
+                // starting a segment would glue onto the previous edge
+                if (pattern.empty() || pattern[0] != '/') {
+                    return false;
+                }
+                size_t pos = 0;
+                while (pos < pattern.size()) {
+                    auto end = pattern.find('/', pos + 1);
+                    if (end == sstring::npos) {
+                        end = pattern.size();
+                    }
+                    n = &child(*n, std::string_view(pattern.data() + pos, end - pos));
+                    pos = end;
+                }
+            } else if (auto* param = dynamic_cast<param_matcher*>(matchers[i])) {
+                if (param->entire_path()) {
+                    if (i + 1 != matchers.size()) {
+                        return false;
+                    }
+                    term.rest_name = param->name();
+                    break;
+                }
+                if (term.param_names.size() == max_params) {
+                    return false;
+                }
+                term.param_names.push_back(param->name());
+                if (!n->param_child) {
+                    n->param_child = std::make_unique<node>();
+                }
+                n = n->param_child.get();
+            } else {
+                // a custom matcher; only the rule itself knows its logic
+                return false;
+            }
+        }
+        auto& dest = term.rest_name ? n->rest_term : n->term;
+        if (!dest || dest->cookie > cookie) {
+            dest.emplace(std::move(term));
+        }
+        return true;
+    }
+
+    struct walk {
+        const sstring& url;
+        slot_array slots;
+        const terminal* best = nullptr;
+        slot_array best_slots;
+        slot best_rest;
+
+        void consider(const terminal& t, size_t nslots, std::optional<slot> rest) {
+            if (best && best->cookie <= t.cookie) {
+                return;
+            }
+            best = &t;
+            std::copy(slots.begin(), slots.begin() + nslots, best_slots.begin());
+            if (rest) {
+                best_rest = *rest;
+            }
+        }
+    };
+
+    void match(const node& n, size_t pos, size_t nslots, walk& w) const {
+        if (n.term && pos + 1 >= w.url.size()) {
+            // like the linear match, tolerate one leftover character --
+            // the trailing slash
+            w.consider(*n.term, nslots, std::nullopt);
+        }
+        if (n.rest_term) {
+            w.consider(*n.rest_term, nslots, slot(pos, w.url.size() - pos));
+        }
+        if (pos >= w.url.size()) {
+            return;
+        }
+        auto end = w.url.find('/', pos + 1);
+        if (end == sstring::npos) {
+            end = w.url.size();
+        }
+        auto segment = std::string_view(w.url.data() + pos, end - pos);
+        if (const node* c = find_child(n, segment)) {
+            match(*c, end, nslots, w);
+        }
+        if (n.param_child && nslots < max_params) {
+            w.slots[nslots] = slot(pos, end - pos);
+            match(*n.param_child, end, nslots + 1, w);
+        }
+    }
+
+    handler_base* get(const sstring& url, parameters& params) const {
+        walk w{url, {}, nullptr, {}, {}};
+        match(_root, 0, 0, w);
+        // an older linear rule still outranks the trie match
+        for (auto& [cookie, rule] : _linear) {
+            if (w.best && cookie > w.best->cookie) {
+                break;
+            }
+            if (handler_base* h = rule->get(url, params)) {
+                return h;
+            }
+            params.clear();
+        }
+        if (!w.best) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < w.best->param_names.size(); i++) {
+            params.set(w.best->param_names[i], url.substr(w.best_slots[i].first, w.best_slots[i].second));
+        }
+        if (w.best->rest_name) {
+            params.set(*w.best->rest_name, url.substr(w.best_rest.first, w.best_rest.second));
+        }
+        return w.best->handler;
+    }
+};
+
+void routes::compile_tries() {
+    for (int op = 0; op < NUM_OPERATION; op++) {
+        auto trie = std::make_unique<dispatch_trie>();
+        for (auto& [cookie, rule] : _rules[op]) {
+            if (!trie->insert(cookie, *rule)) {
+                trie->_linear.emplace_back(cookie, rule);
+            }
+        }
+        _trie[op] = std::move(trie);
+    }
+    _trie_dirty = false;
+}
+
 void verify_param(const request& req, const sstring& param) {
     if (req.get_query_param(param) == "") {
         throw missing_param_exception(param);
@@ -121,12 +329,12 @@ handler_base* routes::get_handler(operation_type type, const sstring& url,
         return handler;
     }
 
-    for (auto&& rule : _rules[type]) {
-        handler = rule.second->get(url, params);
-        if (handler != nullptr) {
-            return handler;
-        }
-        params.clear();
+    if (_trie_dirty) {
+        compile_tries();
+    }
+    handler = _trie[type]->get(url, params);
+    if (handler != nullptr) {
+        return handler;
     }
     return _default_handler;
 }
@@ -172,6 +380,7 @@ routes& routes::put(operation_type type, const sstring& url, handler_base* handl
 }
 
 match_rule* routes::del_cookie(rule_cookie cookie, operation_type type) {
+    _trie_dirty = true;
     return delete_rule_from(type, cookie, _rules);
 }
 
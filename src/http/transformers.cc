@@ -209,6 +209,17 @@ output_stream<char> content_replace::transform(std::unique_ptr<request> req,
 
 }
 
+std::optional<sstring> content_replace::cache_key(const request& req,
+        const sstring& extension) {
+    sstring host = req.get_header("Host");
+    if (host == "" || (this->extension != "" && extension != this->extension)) {
+        // the stream is returned untouched; no point caching a copy
+        return std::nullopt;
+    }
+    // the replaced values are exactly the protocol and the host
+    return req.get_protocol_name() + "\n" + host;
+}
+
 /*!
  * \brief find the open brace that surround a parameter
  * it is either two consecutive braces or a single brace, if it's the last char in the buffer
@@ -0,0 +1,250 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#include <seastar/http/websocket.hh>
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/do_with.hh>
+#include <seastar/core/loop.hh>
+
+#include <gnutls/crypto.h>
+#include <cstring>
+
+namespace seastar {
+
+namespace httpd {
+
+namespace websocket {
+
+// RFC 6455, Section 1.3
+static constexpr char handshake_guid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+static sstring base64_encode(const unsigned char* in, size_t len) {
+    static constexpr char alphabet[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    sstring out((len + 2) / 3 * 4, '=');
+    size_t o = 0;
+    size_t i = 0;
+    for (; i + 3 <= len; i += 3) {
+        uint32_t v = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+        out[o++] = alphabet[(v >> 18) & 0x3f];
+        out[o++] = alphabet[(v >> 12) & 0x3f];
+        out[o++] = alphabet[(v >> 6) & 0x3f];
+        out[o++] = alphabet[v & 0x3f];
+    }
+    if (i < len) {
+        uint32_t v = in[i] << 16;
+        if (i + 1 < len) {
+            v |= in[i + 1] << 8;
+        }
+        out[o++] = alphabet[(v >> 18) & 0x3f];
+        out[o++] = alphabet[(v >> 12) & 0x3f];
+        if (i + 1 < len) {
+            out[o++] = alphabet[(v >> 6) & 0x3f];
+        }
+    }
+    return out;
+}
+
+sstring handshake_accept(const sstring& key) {
+    sstring input = key + handshake_guid;
+    unsigned char digest[20];
+    gnutls_hash_fast(GNUTLS_DIG_SHA1, input.data(), input.size(), digest);
+    return base64_encode(digest, sizeof(digest));
+}
+
+// Unmask the payload in place, a word at a time: the four byte key is
+// replicated into a word and xored over eight byte chunks, which the
+// compiler vectorizes; only the tail is processed byte by byte.
+static void unmask(char* p, size_t len, const uint8_t key[4]) {
+    uint8_t rep[8] = { key[0], key[1], key[2], key[3],
+                       key[0], key[1], key[2], key[3] };
+    uint64_t k;
+    std::memcpy(&k, rep, sizeof(k));
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p + i, sizeof(w));
+        w ^= k;
+        std::memcpy(p + i, &w, sizeof(w));
+    }
+    for (; i < len; i++) {
+        p[i] ^= key[i & 3];
+    }
+}
+
+future<std::optional<connection::frame>> connection::read_frame() {
+    return _read_buf.read_exactly(2).then([this] (temporary_buffer<char> hdr) {
+        if (hdr.size() < 2) {
+            // eof
+            return make_ready_future<std::optional<frame>>(std::nullopt);
+        }
+        uint8_t b0 = hdr[0];
+        uint8_t b1 = hdr[1];
+        if (b0 & 0x70) {
+            throw protocol_error("websocket: reserved frame bits set");
+        }
+        bool fin = b0 & 0x80;
+        auto kind = opcode(b0 & 0x0f);
+        bool masked = b1 & 0x80;
+        uint64_t len = b1 & 0x7f;
+        size_t ext = (len == 126) ? 2 : (len == 127) ? 8 : 0;
+        return _read_buf.read_exactly(ext + (masked ? 4 : 0)).then(
+                [this, fin, kind, masked, len, ext] (temporary_buffer<char> rest) mutable {
+            if (rest.size() < ext + (masked ? 4 : 0)) {
+                return make_ready_future<std::optional<frame>>(std::nullopt);
+            }
+            if (ext == 2) {
+                len = read_be<uint16_t>(rest.get());
+            } else if (ext == 8) {
+                len = read_be<uint64_t>(rest.get());
+            }
+            if (len > max_frame_size) {
+                throw protocol_error("websocket: frame too large");
+            }
+            uint8_t key[4];
+            if (masked) {
+                std::memcpy(key, rest.get() + ext, 4);
+            }
+            return _read_buf.read_exactly(len).then(
+                    [fin, kind, masked, len, key] (temporary_buffer<char> payload) {
+                if (payload.size() < len) {
+                    return make_ready_future<std::optional<frame>>(std::nullopt);
+                }
+                if (masked) {
+                    unmask(payload.get_write(), payload.size(), key);
+                }
+                return make_ready_future<std::optional<frame>>(
+                        frame{fin, kind, std::move(payload)});
+            });
+        });
+    });
+}
+
+message connection::assemble() {
+    temporary_buffer<char> payload;
+    if (_fragments.size() == 1) {
+        // the common case: an unfragmented message is handed over as the
+        // buffer it arrived in
+        payload = std::move(_fragments.front());
+    } else {
+        payload = temporary_buffer<char>(_fragments_size);
+        size_t pos = 0;
+        for (auto& f : _fragments) {
+            std::memcpy(payload.get_write() + pos, f.get(), f.size());
+            pos += f.size();
+        }
+    }
+    message msg{_fragments_kind, std::move(payload)};
+    _fragments.clear();
+    _fragments_size = 0;
+    _fragments_kind = opcode::continuation;
+    return msg;
+}
+
+future<message> connection::read_message() {
+    if (_closed) {
+        return make_ready_future<message>(message{});
+    }
+    return do_with(message{}, [this] (message& out) {
+        return repeat([this, &out] {
+            return read_frame().then([this, &out] (std::optional<frame> f) {
+                if (!f || f->kind == opcode::close) {
+                    _closed = true;
+                    return make_ready_future<stop_iteration>(stop_iteration::yes);
+                }
+                if (f->kind == opcode::ping) {
+                    return send_message(opcode::pong, std::move(f->payload)).then([] {
+                        return stop_iteration::no;
+                    });
+                }
+                if (f->kind == opcode::pong) {
+                    return make_ready_future<stop_iteration>(stop_iteration::no);
+                }
+                if (f->kind == opcode::continuation) {
+                    if (_fragments.empty()) {
+                        throw protocol_error("websocket: continuation without a message");
+                    }
+                } else {
+                    if (!_fragments.empty()) {
+                        throw protocol_error("websocket: new message inside a fragmented one");
+                    }
+                    _fragments_kind = f->kind;
+                }
+                _fragments_size += f->payload.size();
+                if (_fragments_size > max_frame_size) {
+                    throw protocol_error("websocket: message too large");
+                }
+                _fragments.push_back(std::move(f->payload));
+                if (!f->fin) {
+                    return make_ready_future<stop_iteration>(stop_iteration::no);
+                }
+                out = assemble();
+                return make_ready_future<stop_iteration>(stop_iteration::yes);
+            });
+        }).then([&out] {
+            return std::move(out);
+        });
+    });
+}
+
+future<> connection::write_message(opcode kind, temporary_buffer<char> payload) {
+    // Server frames are not masked (RFC 6455, Section 5.1). The header
+    // goes through the output stream's buffer, where it coalesces with
+    // the payload and with any further frames written before a flush.
+    char hdr[10];
+    char* p = hdr + 2;
+    hdr[0] = 0x80 | uint8_t(kind);
+    size_t len = payload.size();
+    if (len < 126) {
+        hdr[1] = len;
+    } else if (len <= std::numeric_limits<uint16_t>::max()) {
+        hdr[1] = 126;
+        produce_be<uint16_t>(p, len);
+    } else {
+        hdr[1] = 127;
+        produce_be<uint64_t>(p, len);
+    }
+    return _write_buf.write(hdr, p - hdr).then([this, payload = std::move(payload)] () mutable {
+        return _write_buf.write(std::move(payload));
+    });
+}
+
+future<> connection::flush() {
+    return _write_buf.flush();
+}
+
+future<> connection::send_message(opcode kind, temporary_buffer<char> payload) {
+    return write_message(kind, std::move(payload)).then([this] {
+        return flush();
+    });
+}
+
+future<> connection::close(uint16_t status) {
+    temporary_buffer<char> payload(2);
+    write_be<uint16_t>(payload.get_write(), status);
+    return send_message(opcode::close, std::move(payload));
+}
+
+}
+
+}
+
+}
@@ -20,7 +20,9 @@
  */
 
 #include <seastar/json/formatter.hh>
+#include <seastar/json/generator.hh>
 #include <seastar/json/json_elements.hh>
+#include <charconv>
 #include <cmath>
 
 namespace seastar {
@@ -29,6 +31,13 @@ using namespace std;
 
 namespace json {
 
+template <typename T>
+static sstring number_str(T v) {
+    char buf[32];
+    auto r = std::to_chars(buf, buf + sizeof(buf), v);
+    return sstring(buf, r.ptr - buf);
+}
+
 sstring formatter::begin(state s) {
     switch (s) {
     case state::array: return "[";
@@ -47,26 +56,27 @@ sstring formatter::end(state s) {
 
 
 sstring formatter::to_json(const sstring& str) {
-    return to_json(str.c_str());
+    generator gen;
+    gen.append_string(str);
+    return gen.str();
 }
 
 sstring formatter::to_json(const char* str) {
-    sstring res = "\"";
-    res += str;
-    res += "\"";
-    return res;
+    generator gen;
+    gen.append_string(str);
+    return gen.str();
 }
 
 sstring formatter::to_json(int n) {
-    return to_string(n);
+    return number_str(n);
 }
 
 sstring formatter::to_json(unsigned n) {
-    return to_string(n);
+    return number_str(n);
 }
 
 sstring formatter::to_json(long n) {
-    return to_string(n);
+    return number_str(n);
 }
 
 sstring formatter::to_json(float f) {
@@ -75,7 +85,7 @@ sstring formatter::to_json(float f) {
     } else if (std::isnan(f)) {
         throw invalid_argument("Invalid float value");
     }
-    return to_sstring(f);
+    return number_str(f);
 }
 
 sstring formatter::to_json(double d) {
@@ -84,7 +94,7 @@ sstring formatter::to_json(double d) {
     } else if (std::isnan(d)) {
         throw invalid_argument("Invalid double value");
     }
-    return to_sstring(d);
+    return number_str(d);
 }
 
 sstring formatter::to_json(bool b) {
@@ -110,7 +120,7 @@ sstring formatter::to_json(const jsonable& obj) {
 }
 
 sstring formatter::to_json(unsigned long l) {
-    return to_string(l);
+    return number_str(l);
 }
 
 }
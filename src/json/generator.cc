@@ -0,0 +1,212 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright 2021 Cloudius Systems
+ */
+
+#include <seastar/json/generator.hh>
+#include <seastar/core/do_with.hh>
+#include <seastar/core/loop.hh>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace seastar {
+
+namespace json {
+
+char* generator::reserve(size_t n) {
+    if (_current.size() - _pos < n) {
+        if (_pos) {
+            _current.trim(_pos);
+            _size += _pos;
+            _full.push_back(std::move(_current));
+        }
+        _current = temporary_buffer<char>(std::max(chunk_size, n));
+        _pos = 0;
+    }
+    return _current.get_write() + _pos;
+}
+
+void generator::append_raw(const char* s, size_t n) {
+    memcpy(reserve(n), s, n);
+    commit(n);
+}
+
+static bool needs_escape(char c) {
+    return static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\';
+}
+
+// The length of the prefix of [s, s+n) that needs no escaping and can be
+// copied verbatim. Eight bytes are classified per iteration: a byte to
+// escape is either equal to '"' or '\' (detected with the usual SWAR
+// zero-byte test on the xor) or below 0x20; bytes with the high bit set
+// (utf-8 continuations and leads) pass through untouched.
+static size_t clean_prefix(const char* s, size_t n) {
+    constexpr uint64_t ones = 0x0101010101010101ull;
+    constexpr uint64_t highs = 0x8080808080808080ull;
+    auto zeros = [] (uint64_t v) {
+        return (v - ones) & ~v & highs;
+    };
+    size_t i = 0;
+    while (i + 8 <= n) {
+        uint64_t w;
+        memcpy(&w, s + i, 8);
+        uint64_t quote = zeros(w ^ (ones * '"'));
+        uint64_t backslash = zeros(w ^ (ones * '\\'));
+        uint64_t ctrl = ~(((w & ~highs) + (ones * 0x60)) | w) & highs;
+        uint64_t hits = quote | backslash | ctrl;
+        if (hits) {
+            return i + (__builtin_ctzll(hits) >> 3);
+        }
+        i += 8;
+    }
+    while (i < n && !needs_escape(s[i])) {
+        i++;
+    }
+    return i;
+}
+
+static void append_escaped(generator& gen, char c) {
+    switch (c) {
+    case '"': gen.append_raw("\\\"", 2); break;
+    case '\\': gen.append_raw("\\\\", 2); break;
+    case '\b': gen.append_raw("\\b", 2); break;
+    case '\f': gen.append_raw("\\f", 2); break;
+    case '\n': gen.append_raw("\\n", 2); break;
+    case '\r': gen.append_raw("\\r", 2); break;
+    case '\t': gen.append_raw("\\t", 2); break;
+    default: {
+        static constexpr char hex[] = "0123456789abcdef";
+        char buf[6] = { '\\', 'u', '0', '0', hex[(c >> 4) & 0xf], hex[c & 0xf] };
+        gen.append_raw(buf, 6);
+    }
+    }
+}
+
+void generator::append_string(std::string_view v) {
+    append('"');
+    const char* p = v.data();
+    size_t n = v.size();
+    while (n) {
+        size_t clean = clean_prefix(p, n);
+        append_raw(p, clean);
+        p += clean;
+        n -= clean;
+        if (n) {
+            append_escaped(*this, *p++);
+            n--;
+        }
+    }
+    append('"');
+}
+
+template <typename T>
+static void append_number(generator& gen, char* buf, size_t len, T v) {
+    auto r = std::to_chars(buf, buf + len, v);
+    gen.append_raw(buf, r.ptr - buf);
+}
+
+void generator::append(int n) {
+    char buf[16];
+    append_number(*this, buf, sizeof(buf), n);
+}
+
+void generator::append(unsigned n) {
+    char buf[16];
+    append_number(*this, buf, sizeof(buf), n);
+}
+
+void generator::append(long n) {
+    char buf[24];
+    append_number(*this, buf, sizeof(buf), n);
+}
+
+void generator::append(unsigned long n) {
+    char buf[24];
+    append_number(*this, buf, sizeof(buf), n);
+}
+
+void generator::append(float f) {
+    if (std::isinf(f)) {
+        throw std::out_of_range("Infinite float value is not supported");
+    } else if (std::isnan(f)) {
+        throw std::invalid_argument("Invalid float value");
+    }
+    char buf[32];
+    append_number(*this, buf, sizeof(buf), f);
+}
+
+void generator::append(double d) {
+    if (std::isinf(d)) {
+        throw std::out_of_range("Infinite double value is not supported");
+    } else if (std::isnan(d)) {
+        throw std::invalid_argument("Invalid double value");
+    }
+    char buf[32];
+    append_number(*this, buf, sizeof(buf), d);
+}
+
+void generator::append(const struct tm& d) {
+    // RFC3339 as mandated for swagger dates, assuming UTC
+    char buf[50];
+    auto len = strftime(buf, sizeof(buf), "%FT%TZ", &d);
+    append('"');
+    append_raw(buf, len);
+    append('"');
+}
+
+sstring generator::str() const {
+    sstring res = uninitialized_string(size());
+    char* p = res.data();
+    for (auto& chunk : _full) {
+        p = std::copy_n(chunk.get(), chunk.size(), p);
+    }
+    std::copy_n(_current.get(), _pos, p);
+    return res;
+}
+
+std::vector<temporary_buffer<char>> generator::take() {
+    if (_pos) {
+        _current.trim(_pos);
+        _full.push_back(std::move(_current));
+        _current = temporary_buffer<char>();
+        _pos = 0;
+    }
+    _size = 0;
+    return std::exchange(_full, {});
+}
+
+future<> generator::write(output_stream<char>& out) {
+    return do_with(take(), [&out] (std::vector<temporary_buffer<char>>& chunks) {
+        return do_for_each(chunks, [&out] (temporary_buffer<char>& chunk) {
+            return out.write(std::move(chunk));
+        });
+    });
+}
+
+void generator::clear() {
+    _full.clear();
+    _pos = 0;
+    _size = 0;
+}
+
+}
+
+}
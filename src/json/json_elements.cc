@@ -21,6 +21,7 @@
 
 #include <seastar/core/loop.hh>
 #include <seastar/core/print.hh>
+#include <seastar/json/generator.hh>
 #include <seastar/json/json_elements.hh>
 #include <string.h>
 #include <string>
@@ -44,7 +45,7 @@ class json_builder {
 public:
     json_builder()
             : first(true) {
-        result << OPEN;
+        result.append('{');
     }
 
     /**
@@ -56,9 +57,11 @@ public:
         if (first) {
             first = false;
         } else {
-            result << ", ";
+            result.append_raw(", ", 2);
         }
-        result << '"' << name << "\": " << str;
+        result.append_string(name);
+        result.append_raw(": ", 2);
+        result.append_raw(str.data(), str.size());
     }
 
     /**
@@ -81,7 +84,7 @@ public:
      * @return a string of accumulative object
      */
     string as_json() {
-        result << CLOSE;
+        result.append('}');
         return result.str();
     }
 
@@ -89,7 +92,7 @@ private:
     static const string OPEN;
     static const string CLOSE;
     friend class json_stream_builder;
-    stringstream result;
+    generator result;
     bool first;
 
 };
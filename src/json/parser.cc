@@ -0,0 +1,468 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#include <seastar/json/parser.hh>
+#include <seastar/json/json_elements.hh>
+#include <seastar/core/do_with.hh>
+#include <seastar/core/loop.hh>
+#include <cctype>
+
+namespace seastar {
+
+namespace json {
+
+static bool is_token_char(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '+' || c == '.';
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void sax_parser::after_value() {
+    if (_stack.empty()) {
+        _state = state::done;
+    } else if (_stack.back() == '{') {
+        _state = state::object_comma;
+    } else {
+        _state = state::array_comma;
+    }
+}
+
+void sax_parser::close_container(char kind) {
+    if (_stack.empty() || _stack.back() != kind) {
+        throw parse_error("mismatched json container close");
+    }
+    _stack.pop_back();
+    if (kind == '{') {
+        _handler.end_object();
+    } else {
+        _handler.end_array();
+    }
+    after_value();
+}
+
+void sax_parser::append_utf8(uint32_t code_point) {
+    if (code_point < 0x80) {
+        _scratch += char(code_point);
+    } else if (code_point < 0x800) {
+        _scratch += char(0xc0 | (code_point >> 6));
+        _scratch += char(0x80 | (code_point & 0x3f));
+    } else if (code_point < 0x10000) {
+        _scratch += char(0xe0 | (code_point >> 12));
+        _scratch += char(0x80 | ((code_point >> 6) & 0x3f));
+        _scratch += char(0x80 | (code_point & 0x3f));
+    } else {
+        _scratch += char(0xf0 | (code_point >> 18));
+        _scratch += char(0x80 | ((code_point >> 12) & 0x3f));
+        _scratch += char(0x80 | ((code_point >> 6) & 0x3f));
+        _scratch += char(0x80 | (code_point & 0x3f));
+    }
+}
+
+void sax_parser::end_string(std::string_view tail) {
+    if (_high_surrogate) {
+        // unpaired surrogate at the end of the string; kept as is
+        append_utf8(_high_surrogate);
+        _high_surrogate = 0;
+    }
+    std::string_view token;
+    if (_use_scratch) {
+        _scratch.append(tail.data(), tail.size());
+        token = _scratch;
+    } else {
+        token = tail;
+    }
+    if (_parsing_key) {
+        _handler.on_key(token);
+        _state = state::object_colon;
+    } else {
+        _handler.on_scalar(token, true);
+        after_value();
+    }
+    _scratch.clear();
+    _use_scratch = false;
+}
+
+void sax_parser::parse_chunk(std::string_view chunk) {
+    const char* p = chunk.data();
+    const char* end = p + chunk.size();
+    while (p != end) {
+        switch (_state) {
+        case state::string_body: {
+            const char* q = p;
+            while (q != end && *q != '"' && *q != '\\') {
+                q++;
+            }
+            if (q == end) {
+                // the string continues in the next chunk
+                _scratch.append(p, q - p);
+                _use_scratch = true;
+                return;
+            }
+            if (*q == '\\') {
+                _scratch.append(p, q - p);
+                _use_scratch = true;
+                p = q + 1;
+                _state = state::string_escape;
+                break;
+            }
+            end_string(std::string_view(p, q - p));
+            p = q + 1;
+            break;
+        }
+        case state::string_escape: {
+            char c = *p++;
+            _state = state::string_body;
+            switch (c) {
+            case '"': _scratch += '"'; break;
+            case '\\': _scratch += '\\'; break;
+            case '/': _scratch += '/'; break;
+            case 'b': _scratch += '\b'; break;
+            case 'f': _scratch += '\f'; break;
+            case 'n': _scratch += '\n'; break;
+            case 'r': _scratch += '\r'; break;
+            case 't': _scratch += '\t'; break;
+            case 'u':
+                _unicode = 0;
+                _unicode_left = 4;
+                _state = state::string_unicode;
+                break;
+            default:
+                throw parse_error("invalid escape in json string");
+            }
+            break;
+        }
+        case state::string_unicode: {
+            int d = hex_value(*p++);
+            if (d < 0) {
+                throw parse_error("invalid \\u escape in json string");
+            }
+            _unicode = (_unicode << 4) | d;
+            if (--_unicode_left == 0) {
+                uint32_t cp = _unicode;
+                if (_high_surrogate && cp >= 0xdc00 && cp < 0xe000) {
+                    append_utf8(0x10000 + ((uint32_t(_high_surrogate) - 0xd800) << 10) + (cp - 0xdc00));
+                    _high_surrogate = 0;
+                } else {
+                    if (_high_surrogate) {
+                        // unpaired surrogate; kept as is
+                        append_utf8(_high_surrogate);
+                        _high_surrogate = 0;
+                    }
+                    if (cp >= 0xd800 && cp < 0xdc00) {
+                        _high_surrogate = cp;
+                    } else {
+                        append_utf8(cp);
+                    }
+                }
+                _state = state::string_body;
+            }
+            break;
+        }
+        case state::bare_token: {
+            const char* q = p;
+            while (q != end && is_token_char(*q)) {
+                q++;
+            }
+            if (q == end) {
+                _scratch.append(p, q - p);
+                _use_scratch = true;
+                return;
+            }
+            std::string_view token;
+            if (_use_scratch) {
+                _scratch.append(p, q - p);
+                token = _scratch;
+            } else {
+                token = std::string_view(p, q - p);
+            }
+            _handler.on_scalar(token, false);
+            after_value();
+            _scratch.clear();
+            _use_scratch = false;
+            p = q; // the delimiter is handled by the next state
+            break;
+        }
+        default: {
+            char c = *p;
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                p++;
+                break;
+            }
+            switch (_state) {
+            case state::value:
+            case state::array_value:
+                if (c == ']' && _state == state::array_value) {
+                    p++;
+                    close_container('[');
+                } else if (c == '{') {
+                    p++;
+                    _handler.start_object();
+                    _stack.push_back('{');
+                    _state = state::object_key;
+                } else if (c == '[') {
+                    p++;
+                    _handler.start_array();
+                    _stack.push_back('[');
+                    _state = state::array_value;
+                } else if (c == '"') {
+                    p++;
+                    _parsing_key = false;
+                    _state = state::string_body;
+                } else if (is_token_char(c)) {
+                    _state = state::bare_token;
+                } else {
+                    throw parse_error("unexpected character in json document");
+                }
+                break;
+            case state::object_key:
+                if (c == '}') {
+                    p++;
+                    close_container('{');
+                } else if (c == '"') {
+                    p++;
+                    _parsing_key = true;
+                    _state = state::string_body;
+                } else {
+                    throw parse_error("expected a json object key");
+                }
+                break;
+            case state::object_colon:
+                if (c != ':') {
+                    throw parse_error("expected ':' in json object");
+                }
+                p++;
+                _state = state::value;
+                break;
+            case state::object_comma:
+                if (c == ',') {
+                    p++;
+                    _state = state::object_key;
+                } else if (c == '}') {
+                    p++;
+                    close_container('{');
+                } else {
+                    throw parse_error("expected ',' or '}' in json object");
+                }
+                break;
+            case state::array_comma:
+                if (c == ',') {
+                    p++;
+                    _state = state::value;
+                } else if (c == ']') {
+                    p++;
+                    close_container('[');
+                } else {
+                    throw parse_error("expected ',' or ']' in json array");
+                }
+                break;
+            case state::done:
+                throw parse_error("trailing characters after json document");
+            default:
+                abort();
+            }
+            break;
+        }
+        }
+    }
+}
+
+void sax_parser::finish() {
+    if (_state == state::bare_token) {
+        // a top level number or literal ends with the input
+        _handler.on_scalar(_scratch, false);
+        after_value();
+        _scratch.clear();
+        _use_scratch = false;
+    }
+    if (_state != state::done) {
+        throw parse_error("unexpected end of json input");
+    }
+}
+
+future<> parse(input_stream<char>& in, sax_handler& handler) {
+    return do_with(sax_parser(handler), [&in] (sax_parser& parser) {
+        return repeat([&in, &parser] {
+            return in.read().then([&parser] (temporary_buffer<char> buf) {
+                if (buf.empty()) {
+                    parser.finish();
+                    return stop_iteration::yes;
+                }
+                parser.parse_chunk(std::string_view(buf.get(), buf.size()));
+                return parser.done() ? stop_iteration::yes : stop_iteration::no;
+            });
+        });
+    });
+}
+
+namespace {
+
+// Binds the parser's events onto a json_base object through the
+// parsing hooks of json_base_element (see json_elements.hh).
+class object_reader final : public sax_handler {
+    struct frame {
+        enum class kind : uint8_t {
+            object, // filling a json_base
+            array,  // appending to a list element
+            skip,   // inside a subtree with no matching element
+        };
+        kind k;
+        json_base* obj = nullptr;
+        json_base_element* elem = nullptr;
+    };
+    json_base& _root;
+    bool _started = false;
+    std::vector<frame> _stack;
+    // the element named by the last key, awaiting its value; nullptr
+    // means the key is unknown and its value is skipped
+    json_base_element* _pending = nullptr;
+
+    bool skipping() const {
+        return !_stack.empty() && _stack.back().k == frame::kind::skip;
+    }
+
+    static json_base_element* find(json_base& obj, std::string_view name) {
+        for (auto element : obj._elements) {
+            if (element->_name == name) {
+                return element;
+            }
+        }
+        return nullptr;
+    }
+public:
+    explicit object_reader(json_base& root) : _root(root) {
+    }
+
+    virtual void start_object() override {
+        if (skipping()) {
+            _stack.push_back(frame{frame::kind::skip});
+            return;
+        }
+        if (!_started) {
+            _started = true;
+            _stack.push_back(frame{frame::kind::object, &_root});
+            return;
+        }
+        json_base* target;
+        if (_stack.back().k == frame::kind::array) {
+            target = _stack.back().elem->add_json_array_object();
+            if (!target) {
+                throw parse_error("json array items do not fit the element");
+            }
+        } else {
+            if (!_pending) {
+                _stack.push_back(frame{frame::kind::skip});
+                return;
+            }
+            target = std::exchange(_pending, nullptr)->json_object();
+            if (!target) {
+                throw parse_error("json object does not fit the element");
+            }
+        }
+        _stack.push_back(frame{frame::kind::object, target});
+    }
+
+    virtual void end_object() override {
+        _stack.pop_back();
+    }
+
+    virtual void start_array() override {
+        if (skipping()) {
+            _stack.push_back(frame{frame::kind::skip});
+            return;
+        }
+        if (!_started || _stack.back().k == frame::kind::array) {
+            throw parse_error("unexpected json array");
+        }
+        if (!_pending) {
+            _stack.push_back(frame{frame::kind::skip});
+            return;
+        }
+        auto elem = std::exchange(_pending, nullptr);
+        if (!elem->start_json_array()) {
+            throw parse_error("json array does not fit the element");
+        }
+        _stack.push_back(frame{frame::kind::array, nullptr, elem});
+    }
+
+    virtual void end_array() override {
+        _stack.pop_back();
+    }
+
+    virtual void on_key(std::string_view key) override {
+        if (skipping()) {
+            return;
+        }
+        _pending = find(*_stack.back().obj, key);
+    }
+
+    virtual void on_scalar(std::string_view text, bool is_string) override {
+        if (skipping()) {
+            return;
+        }
+        if (_stack.empty()) {
+            throw parse_error("expected a json object");
+        }
+        if (_stack.back().k == frame::kind::array) {
+            if (!_stack.back().elem->add_json_array_scalar(text, is_string)) {
+                throw parse_error("json array item does not fit the element");
+            }
+            return;
+        }
+        if (!_pending) {
+            return;
+        }
+        auto elem = std::exchange(_pending, nullptr);
+        if (!is_string && text == "null") {
+            // null leaves the element unset
+            return;
+        }
+        if (!elem->set_json_scalar(text, is_string)) {
+            throw parse_error("json value does not fit the element " + elem->_name);
+        }
+    }
+};
+
+}
+
+future<> parse(input_stream<char>& in, json_base& obj) {
+    return do_with(object_reader(obj), [&in, &obj] (object_reader& reader) {
+        return parse(in, reader).then([&obj] {
+            if (!obj.is_verify()) {
+                throw parse_error("mandatory json element missing");
+            }
+        });
+    });
+}
+
+}
+
+}
@@ -136,6 +136,8 @@ public:
     impl(network_stack& stack, const options& opts)
         : _stack(stack)
         , _timeout(opts.timeout ? *opts.timeout : std::chrono::milliseconds(5000) /* from ares private */)
+        , _cache_ttl(opts.cache_ttl ? *opts.cache_ttl : std::chrono::milliseconds(5000))
+        , _negative_cache_ttl(opts.negative_cache_ttl ? *opts.negative_cache_ttl : std::chrono::milliseconds(1000))
         , _timer(std::bind(&impl::poll_sockets, this))
     {
         static const ares_initializer a_init;
@@ -230,6 +232,38 @@ public:
     }
 
     future<hostent> get_host_by_name(sstring name, opt_family family)  {
+        if (!family) {
+            auto res = inet_address::parse_numerical(name);
+            if (res) {
+                return make_ready_future<hostent>(hostent{ {name}, {*res}});
+            }
+        }
+        if (_cache_ttl.count() == 0) {
+            return do_get_host_by_name(std::move(name), family);
+        }
+        cache_key key{std::move(name), family ? int(*family) : AF_UNSPEC};
+        auto now = cache_clock::now();
+        auto i = _cache.find(key);
+        if (i != _cache.end() && now < i->second.expires) {
+            auto& e = i->second;
+            if (now >= e.refresh_at && !e.refreshing && !_closed) {
+                // refresh hot entries before they expire, so steady-state
+                // lookups never wait for a resolution
+                e.refreshing = true;
+                (void)refresh(key);
+            }
+            if (e.error) {
+                return make_exception_future<hostent>(e.error);
+            }
+            return make_ready_future<hostent>(e.h);
+        }
+        auto f = do_get_host_by_name(key.name, family);
+        return f.then_wrapped([this, key = std::move(key)](future<hostent> f) mutable {
+            return cache_result(std::move(key), std::move(f));
+        });
+    }
+
+    future<hostent> do_get_host_by_name(sstring name, opt_family family)  {
         class promise_wrap : public promise<hostent> {
         public:
             promise_wrap(sstring s)
@@ -240,13 +274,6 @@ public:
 
         dns_log.debug("Query name {} ({})", name, family);
 
-        if (!family) {
-            auto res = inet_address::parse_numerical(name);
-            if (res) {
-                return make_ready_future<hostent>(hostent{ {name}, {*res}});
-            }
-        }
-
         auto p = new promise_wrap(std::move(name));
         auto f = p->get_future();
 
@@ -414,6 +441,80 @@ private:
             _timer.cancel();
         }
     }
+
+    using cache_clock = lowres_clock;
+
+    struct cache_key {
+        sstring name;
+        int family;
+        bool operator==(const cache_key& o) const {
+            return name == o.name && family == o.family;
+        }
+    };
+    struct cache_key_hash {
+        size_t operator()(const cache_key& k) const {
+            return std::hash<sstring>()(k.name) ^ size_t(k.family);
+        }
+    };
+    struct cache_entry {
+        hostent h;
+        std::exception_ptr error; // negative entry
+        cache_clock::time_point expires;
+        cache_clock::time_point refresh_at;
+        bool refreshing = false;
+    };
+
+    future<hostent> cache_result(cache_key key, future<hostent> f) {
+        cache_entry e;
+        auto now = cache_clock::now();
+        try {
+            e.h = f.get0();
+            e.expires = now + _cache_ttl;
+            e.refresh_at = now + _cache_ttl / 2;
+        } catch (...) {
+            e.error = std::current_exception();
+            e.expires = now + _negative_cache_ttl;
+            // failures are not refreshed ahead of time
+            e.refresh_at = e.expires;
+        }
+        if (_cache.size() >= max_cache_entries && !_cache.count(key)) {
+            auto i = std::find_if(_cache.begin(), _cache.end(), [&](auto& p) {
+                return now >= p.second.expires;
+            });
+            _cache.erase(i != _cache.end() ? i : _cache.begin());
+        }
+        auto& slot = _cache[std::move(key)];
+        slot = std::move(e);
+        if (slot.error) {
+            return make_exception_future<hostent>(slot.error);
+        }
+        return make_ready_future<hostent>(slot.h);
+    }
+
+    future<> refresh(cache_key key) {
+        return with_gate(_gate, [this, key]() mutable {
+            opt_family family;
+            if (key.family != AF_UNSPEC) {
+                family = inet_address::family(key.family);
+            }
+            return do_get_host_by_name(key.name, family).then_wrapped([this, key = std::move(key)](future<hostent> f) mutable {
+                return cache_result(std::move(key), std::move(f)).then_wrapped([](future<hostent> f) {
+                    f.ignore_ready_future();
+                });
+            });
+        });
+    }
+
+public:
+    void invalidate_cache() {
+        _cache.clear();
+    }
+    void invalidate_cache(const sstring& name) {
+        for (auto af : { AF_UNSPEC, AF_INET, AF_INET6 }) {
+            _cache.erase(cache_key{name, af});
+        }
+    }
+private:
     void poll_sockets() {
         fd_set readers, writers;
         int n = 0;
@@ -959,11 +1060,23 @@ private:
     ares_channel _channel = {};
     uint64_t _calls = 0;
     std::chrono::milliseconds _timeout;
+    std::chrono::milliseconds _cache_ttl;
+    std::chrono::milliseconds _negative_cache_ttl;
+    static constexpr size_t max_cache_entries = 1024;
+    std::unordered_map<cache_key, cache_entry, cache_key_hash> _cache;
     timer<> _timer;
     gate _gate;
     bool _closed = false;
 };
 
+void net::dns_resolver::invalidate_cache() {
+    _impl->invalidate_cache();
+}
+
+void net::dns_resolver::invalidate_cache(const sstring& name) {
+    _impl->invalidate_cache(name);
+}
+
 net::dns_resolver::dns_resolver()
     : dns_resolver(options())
 {}
@@ -56,6 +56,7 @@
 #include <rte_cycles.h>
 #include <rte_memzone.h>
 #include <rte_vfio.h>
+#include <rte_interrupts.h>
 
 #if RTE_VERSION <= RTE_VERSION_NUM(2,0,0,16)
 
@@ -346,6 +347,7 @@ class dpdk_device : public device {
     seastar::metrics::metric_groups _metrics;
     bool _is_i40e_device = false;
     bool _is_vmxnet3_device = false;
+    bool _rx_intr = false;
     dpdk_xstats _xstats;
 
 public:
@@ -500,6 +502,11 @@ public:
         return _redir_table[hash & (_redir_table.size() - 1)];
     }
     uint16_t port_idx() { return _port_idx; }
+    // The port was configured with per-queue rx interrupts, so queues may
+    // use the adaptive interrupt/poll mode (see rx_intr_pollfn).
+    bool rx_interrupts() const {
+        return _rx_intr;
+    }
     bool is_i40e_device() const {
         return _is_i40e_device;
     }
@@ -1238,7 +1245,8 @@ build_mbuf_cluster:
 
 public:
     explicit dpdk_qp(dpdk_device* dev, uint16_t qid,
-                     const std::string stats_plugin_name);
+                     const std::string stats_plugin_name,
+                     bool rx_zero_copy = false);
 
     virtual void rx_start() override;
     virtual future<> send(packet p) override {
@@ -1377,6 +1385,18 @@ private:
      */
     bool poll_rx_once();
 
+    /**
+     * Rx poller for the adaptive interrupt/poll mode: spin-polls while
+     * traffic flows; once bursts stay empty long enough it arms the
+     * queue's rx interrupt and lets the reactor sleep, to be woken by the
+     * interrupt through the epoll fd registered with the reactor.
+     */
+    class rx_intr_pollfn;
+
+    bool rx_try_enter_interrupt_mode();
+    void rx_exit_interrupt_mode();
+    void keep_rx_intr_fd_registered();
+
     /**
      * Translates an rte_mbuf's into net::packet and feeds them to _rx_stream.
      *
@@ -1403,9 +1423,25 @@ private:
      */
     std::optional<packet> from_mbuf_lro(rte_mbuf* m);
 
+    /**
+     * Wrap an rte_mbuf chain in a "packet" without copying: the packet's
+     * fragments point straight into the mbufs' data rooms and its deleter
+     * hands the whole chain back to the mempool. Used (on request) by the
+     * non-hugetlbfs backend, where the buffers are not seastar memory but
+     * are perfectly good packet fragments nevertheless.
+     *
+     * @param m HEAD of the mbufs' cluster to wrap
+     *
+     * @return a packet over the mbuf chain
+     */
+    std::optional<packet> from_mbuf_zero_copy(rte_mbuf* m);
+
 private:
     dpdk_device* _dev;
     uint16_t _qid;
+    // Non-hugetlbfs backend only: wrap received mbuf chains instead of
+    // copying them out (see from_mbuf_zero_copy()).
+    const bool _rx_zero_copy;
     rte_mempool *_pktmbuf_pool_rx;
     std::vector<rte_mbuf*> _rx_free_pkts;
     std::vector<rte_mbuf*> _rx_free_bufs;
@@ -1419,6 +1455,17 @@ private:
     reactor::poller _tx_gc_poller;
     std::vector<rte_mbuf*> _tx_burst;
     uint16_t _tx_burst_idx = 0;
+    // Adaptive interrupt/poll mode state (see rx_intr_pollfn). The epoll
+    // fd holds this queue's rx interrupt and is kept registered with the
+    // reactor, so the interrupt wakes the sleeping idle loop.
+    static constexpr unsigned rx_idle_polls_before_sleep = 256;
+    pollable_fd _rx_intr_fd;
+    unsigned _rx_idle_polls = 0;
+    bool _rx_intr_enabled = false;
+    bool _rx_intr_armed = false;
+    std::optional<steady_clock_type::time_point> _rx_woken;
+    uint64_t _rx_sleeps = 0;
+    metrics::log_histogram<1000000, 2> _rx_wakeup_latency;
     static constexpr phys_addr_t page_mask = ~(memory::page_size - 1);
 };
 
@@ -1622,10 +1669,23 @@ int dpdk_device::init_port_start()
     /*
      * Standard DPDK port initialisation - config port, then set up
      * rx and tx rings.
+     *
+     * Ask for per-queue rx interrupts first, so idle queues may sleep
+     * instead of spinning (see rx_intr_pollfn). Not every PMD supports
+     * them, so fall back to a plain polling configuration on failure.
       */
+    port_conf.intr_conf.rxq = 1;
     if ((retval = rte_eth_dev_configure(_port_idx, _num_queues, _num_queues,
-                                        &port_conf)) != 0) {
-        return retval;
+                                        &port_conf)) == 0) {
+        _rx_intr = true;
+        printf("Rx interrupts are supported\n");
+    } else {
+        port_conf.intr_conf.rxq = 0;
+        printf("Rx interrupts are not supported\n");
+        if ((retval = rte_eth_dev_configure(_port_idx, _num_queues, _num_queues,
+                                            &port_conf)) != 0) {
+            return retval;
+        }
     }
 
     //rte_eth_promiscuous_enable(port_num);
@@ -1922,8 +1982,10 @@ void dpdk_device::check_port_link_status()
 
 template <bool HugetlbfsMemBackend>
 dpdk_qp<HugetlbfsMemBackend>::dpdk_qp(dpdk_device* dev, uint16_t qid,
-                                      const std::string stats_plugin_name)
+                                      const std::string stats_plugin_name,
+                                      bool rx_zero_copy)
      : qp(true, stats_plugin_name, qid), _dev(dev), _qid(qid),
+       _rx_zero_copy(rx_zero_copy),
        _rx_gc_poller(reactor::poller::simple([&] { return rx_gc(); })),
        _tx_buf_factory(qid),
        _tx_gc_poller(reactor::poller::simple([&] { return _tx_buf_factory.gc(); }))
@@ -1970,14 +2032,106 @@ dpdk_qp<HugetlbfsMemBackend>::dpdk_qp(dpdk_device* dev, uint16_t qid,
         sm::make_derive(_queue_name + "_rx_no_memory_errors", _stats.rx.bad.no_mem,
                         sm::description("Counts a number of ingress packets received by this HW queue but dropped by the SW due to low memory. "
                                         "A non-zero value indicates that seastar doesn't have enough memory to handle the packet reception or the memory is too fragmented.")),
+
+        sm::make_derive(_queue_name + "_rx_interrupt_sleeps", _rx_sleeps,
+                        sm::description("Counts a number of times this queue armed its rx interrupt and let the reactor sleep instead of spin-polling. "
+                                        "A zero value under light load means the PMD doesn't support rx interrupts and the queue polls continuously.")),
+
+        sm::make_histogram(_queue_name + "_rx_wakeup_latency", [this] { return _rx_wakeup_latency.to_histogram(1e-6); },
+                        sm::description("Histogram of the delay, in seconds, between the rx interrupt waking the reactor and this queue polling again. "
+                                        "Bounds the latency cost of sleeping instead of spin-polling while the queue is idle.")),
     });
 }
 
 #pragma GCC diagnostic pop
 
+// A reactor::poller::simple() would never let the reactor sleep, pinning
+// the cpu at 100% even on an idle link. This poller spin-polls as long as
+// bursts bring packets; after rx_idle_polls_before_sleep consecutive empty
+// bursts it agrees to enter interrupt mode, arming the queue's rx
+// interrupt so an arriving packet wakes the idle loop.
+template <bool HugetlbfsMemBackend>
+class dpdk_qp<HugetlbfsMemBackend>::rx_intr_pollfn final : public pollfn {
+    dpdk_qp& _qp;
+public:
+    explicit rx_intr_pollfn(dpdk_qp& qp) : _qp(qp) {}
+    virtual bool poll() override {
+        return _qp.poll_rx_once();
+    }
+    virtual bool pure_poll() override {
+        return poll();
+    }
+    virtual bool try_enter_interrupt_mode() override {
+        return _qp.rx_try_enter_interrupt_mode();
+    }
+    virtual void exit_interrupt_mode() override {
+        _qp.rx_exit_interrupt_mode();
+    }
+};
+
 template <bool HugetlbfsMemBackend>
 void dpdk_qp<HugetlbfsMemBackend>::rx_start() {
-    _rx_poller = reactor::poller::simple([&] { return poll_rx_once(); });
+    if (_dev->rx_interrupts()) {
+        // Hang the queue's rx interrupt off a private epoll fd; the fd is
+        // then watched by the reactor, so the interrupt can wake it from
+        // the sleeping idle loop.
+        auto epfd = file_desc::epoll_create(EPOLL_CLOEXEC);
+        if (rte_eth_dev_rx_intr_ctl_q(_dev->port_idx(), _qid, epfd.get(),
+                                      RTE_INTR_EVENT_ADD, nullptr) == 0) {
+            _rx_intr_fd = pollable_fd(std::move(epfd));
+            _rx_intr_enabled = true;
+            keep_rx_intr_fd_registered();
+        } else {
+            printf("Port %d queue %d: no rx interrupt control, will poll continuously\n",
+                   _dev->port_idx(), _qid);
+        }
+    }
+    _rx_poller = reactor::poller(std::make_unique<rx_intr_pollfn>(*this));
+}
+
+template <bool HugetlbfsMemBackend>
+void dpdk_qp<HugetlbfsMemBackend>::keep_rx_intr_fd_registered() {
+    // The pending read keeps the epoll fd in the reactor's wait set; the
+    // continuation has nothing to do itself, since the wakeup runs through
+    // exit_interrupt_mode() and the regular rx poll.
+    // FIXME: future is discarded
+    (void)_rx_intr_fd.readable().then([this] {
+        keep_rx_intr_fd_registered();
+    });
+}
+
+template <bool HugetlbfsMemBackend>
+bool dpdk_qp<HugetlbfsMemBackend>::rx_try_enter_interrupt_mode() {
+    if (!_rx_intr_enabled || _rx_idle_polls < rx_idle_polls_before_sleep) {
+        return false;
+    }
+    if (rte_eth_dev_rx_intr_enable(_dev->port_idx(), _qid) != 0) {
+        return false;
+    }
+    // Close the race with packets that arrived after the last empty burst
+    // but before the interrupt was armed: they would never trigger it.
+    if (poll_rx_once()) {
+        rte_eth_dev_rx_intr_disable(_dev->port_idx(), _qid);
+        return false;
+    }
+    _rx_intr_armed = true;
+    _rx_sleeps++;
+    return true;
+}
+
+template <bool HugetlbfsMemBackend>
+void dpdk_qp<HugetlbfsMemBackend>::rx_exit_interrupt_mode() {
+    if (!_rx_intr_armed) {
+        return;
+    }
+    _rx_intr_armed = false;
+    rte_eth_dev_rx_intr_disable(_dev->port_idx(), _qid);
+    // Drain and acknowledge the interrupt if one fired, and stamp the
+    // wakeup so the next rx poll records how long the wake path took.
+    rte_epoll_event ev;
+    if (rte_epoll_wait(_rx_intr_fd.get_file_desc().get(), &ev, 1, 0) > 0) {
+        _rx_woken = steady_clock_type::now();
+    }
 }
 
 template<>
@@ -2014,10 +2168,32 @@ dpdk_qp<false>::from_mbuf_lro(rte_mbuf* m)
     return std::nullopt;
 }
 
+template <bool HugetlbfsMemBackend>
+inline std::optional<packet>
+dpdk_qp<HugetlbfsMemBackend>::from_mbuf_zero_copy(rte_mbuf* m)
+{
+    _frags.clear();
+
+    for (rte_mbuf* m1 = m; m1 != nullptr; m1 = m1->next) {
+        _frags.emplace_back(fragment{rte_pktmbuf_mtod(m1, char*),
+                                     rte_pktmbuf_data_len(m1)});
+    }
+
+    // The deleter owns the whole chain: one rte_pktmbuf_free() returns
+    // every segment to the mempool. Freeing is mempool-cache aware and
+    // safe from whichever shard the packet ends up dying on.
+    return packet(_frags.begin(), _frags.end(),
+                  make_deleter([m] { rte_pktmbuf_free(m); }));
+}
+
 template<>
 inline std::optional<packet>
 dpdk_qp<false>::from_mbuf(rte_mbuf* m)
 {
+    if (_rx_zero_copy) {
+        return from_mbuf_zero_copy(m);
+    }
+
     if (!_dev->hw_features_ref().rx_lro || rte_pktmbuf_is_contiguous(m)) {
         //
         // Try to allocate a buffer for packet's data. If we fail - give the
@@ -2190,7 +2366,7 @@ void dpdk_qp<HugetlbfsMemBackend>::process_packets(
     _stats.rx.good.update_pkts_bunch(count);
     _stats.rx.good.update_frags_stats(nr_frags, bytes);
 
-    if (!HugetlbfsMemBackend) {
+    if (!HugetlbfsMemBackend && !_rx_zero_copy) {
         _stats.rx.good.copy_frags = _stats.rx.good.nr_frags;
         _stats.rx.good.copy_bytes = _stats.rx.good.bytes;
     }
@@ -2205,9 +2381,19 @@ bool dpdk_qp<HugetlbfsMemBackend>::poll_rx_once()
     uint16_t rx_count = rte_eth_rx_burst(_dev->port_idx(), _qid,
                                          buf, packet_read_size);
 
+    if (_rx_woken) {
+        _rx_wakeup_latency.record(std::chrono::duration_cast<std::chrono::microseconds>(
+                steady_clock_type::now() - *_rx_woken).count());
+        _rx_woken = std::nullopt;
+    }
+
     /* Now process the NIC packets read */
     if (likely(rx_count > 0)) {
+        _rx_idle_polls = 0;
         process_packets(buf, rx_count);
+    } else if (_rx_idle_polls < rx_idle_polls_before_sleep) {
+        // saturating: one busy burst rearms the full spin period
+        _rx_idle_polls++;
     }
 
     return rx_count;
@@ -2246,11 +2432,16 @@ std::unique_ptr<qp> dpdk_device::init_local_queue(boost::program_options::variab
 
     std::unique_ptr<qp> qp;
     if (opts.count("hugepages")) {
+        // The hugetlbfs backend attaches seastar buffers to the mbufs and
+        // is zero-copy already.
         qp = std::make_unique<dpdk_qp<true>>(this, qid,
                                  _stats_plugin_name + "-" + _stats_plugin_inst);
     } else {
+        bool rx_zero_copy = opts.count("dpdk-rx-zero-copy") &&
+                            opts["dpdk-rx-zero-copy"].as<std::string>() == "on";
         qp = std::make_unique<dpdk_qp<false>>(this, qid,
-                                 _stats_plugin_name + "-" + _stats_plugin_inst);
+                                 _stats_plugin_name + "-" + _stats_plugin_inst,
+                                 rx_zero_copy);
     }
 
     // FIXME: future is discarded
@@ -2311,6 +2502,16 @@ get_dpdk_net_options_description()
         ("hw-fc",
                 boost::program_options::value<std::string>()->default_value("on"),
                 "Enable HW Flow Control (on / off)");
+
+    opts.add_options()
+        ("dpdk-rx-zero-copy",
+                boost::program_options::value<std::string>()->default_value("off"),
+                "Wrap received mbuf chains in packets directly instead of "
+                "copying the data out (on / off). Only affects the "
+                "non-hugetlbfs memory backend. Mbufs return to the Rx "
+                "mempool when the packets are destroyed, so the mempool "
+                "must be sized for how long the application holds on to "
+                "received data.");
 #if 0
     opts.add_options()
         ("csum-offload",
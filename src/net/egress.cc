@@ -0,0 +1,136 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <seastar/net/egress.hh>
+#include <seastar/net/packet.hh>
+
+namespace seastar {
+namespace net {
+
+// A queued transmit batch waiting for its ticket to be dispatched.
+// Allocated in get_ticket() and deleted by the dispatch callback.
+struct egress_scheduler::waiter : public fair_queue_entry {
+    promise<> pr;
+    explicit waiter(fair_queue_ticket t) noexcept : fair_queue_entry(t) {}
+    static waiter& from_fq_entry(fair_queue_entry& ent) noexcept {
+        return static_cast<waiter&>(ent);
+    }
+};
+
+class egress_scheduler::egress_sink final : public data_sink_impl {
+    egress_scheduler& _sched;
+    data_sink _out;
+public:
+    egress_sink(egress_scheduler& sched, data_sink out)
+        : _sched(sched), _out(std::move(out)) {}
+    using data_sink_impl::put;
+    virtual future<> put(net::packet data) override {
+        auto ticket = _sched.make_ticket(data.len());
+        return _sched.get_ticket(current_scheduling_group(), ticket).then([this, data = std::move(data)] () mutable {
+            return _out.put(std::move(data));
+        }).finally([this, ticket] {
+            _sched.put_ticket(ticket);
+        });
+    }
+    virtual future<> flush() override {
+        return _out.flush();
+    }
+    virtual future<> close() override {
+        return _out.close();
+    }
+};
+
+static fair_queue::config make_fair_queue_config() {
+    fair_queue::config cfg;
+    // Rough pace of a 10Gbit NIC: ~1us per batch dispatch, ~0.4us per
+    // 512-byte ticket unit. Only used to estimate how long a pending
+    // ticket will take to become available.
+    cfg.ticket_weight_pace = 1;
+    cfg.ticket_size_pace = 0.4;
+    return cfg;
+}
+
+egress_scheduler::egress_scheduler() : egress_scheduler(config()) {}
+
+egress_scheduler::egress_scheduler(config cfg)
+    : _group(fair_group::config(cfg.max_requests,
+            std::max<unsigned>(cfg.max_bytes >> ticket_size_shift, 1)))
+    , _fq(_group, make_fair_queue_config())
+    , _max_ticket_size(std::max<unsigned>(cfg.max_bytes >> ticket_size_shift, 1)) {
+}
+
+egress_scheduler::~egress_scheduler() {
+    for (auto& pc : _classes) {
+        if (pc) {
+            _fq.unregister_priority_class(pc);
+        }
+    }
+}
+
+priority_class_ptr egress_scheduler::pclass(scheduling_group sg) {
+    auto idx = internal::scheduling_group_index(sg);
+    if (!_classes[idx]) {
+        _classes[idx] = _fq.register_priority_class(default_shares);
+    }
+    return _classes[idx];
+}
+
+fair_queue_ticket egress_scheduler::make_ticket(size_t bytes) const noexcept {
+    // clamp oversized batches so they can always be dispatched
+    auto size = std::min<size_t>(std::max<size_t>(bytes >> ticket_size_shift, 1), _max_ticket_size);
+    return fair_queue_ticket(1, size);
+}
+
+future<> egress_scheduler::get_ticket(scheduling_group sg, fair_queue_ticket ticket) {
+    auto pc = pclass(sg);
+    if (_fq.try_direct_dispatch(pc, ticket)) {
+        return make_ready_future<>();
+    }
+    auto w = std::make_unique<waiter>(ticket);
+    auto fut = w->pr.get_future();
+    _fq.queue(pc, *w.release());
+    dispatch();
+    return fut;
+}
+
+void egress_scheduler::put_ticket(fair_queue_ticket ticket) noexcept {
+    _fq.notify_requests_finished(ticket);
+    dispatch();
+}
+
+void egress_scheduler::dispatch() {
+    _fq.dispatch_requests([] (fair_queue_entry& ent) {
+        auto& w = waiter::from_fq_entry(ent);
+        w.pr.set_value();
+        delete &w;
+    });
+}
+
+data_sink egress_scheduler::wrap(data_sink sink) {
+    return data_sink(std::make_unique<egress_sink>(*this, std::move(sink)));
+}
+
+void egress_scheduler::update_shares(scheduling_group sg, uint32_t shares) {
+    pclass(sg)->update_shares(shares);
+}
+
+}
+}
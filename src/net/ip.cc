@@ -67,14 +67,6 @@ ipv4::ipv4(interface* netif)
             return forward(out_hash_data, p, off);
         });
 
-    _metrics.add_group("ipv4", {
-        //
-        // Linearized events: DERIVE:0:u
-        //
-        sm::make_derive("linearizations", [] { return ipv4_packet_merger::linearizations(); },
-                        sm::description("Counts a number of times a buffer linearization was invoked during buffers merge process. "
-                                        "Divide it by a total IPv4 receive packet rate to get an average number of lineraizations per packet."))
-    });
     _frag_timer.set_callback([this] { frag_timeout(); });
 }
 
@@ -170,21 +162,28 @@ ipv4::handle_received_packet(packet p, ethernet_address from) {
     if (mf == true || offset != 0) {
         frag_limit_mem();
         auto frag_id = ipv4_frag_id{h.src_ip, h.dst_ip, h.id, h.ip_proto};
-        auto& frag = _frags[frag_id];
+        auto i = _frags.find(frag_id);
+        if (i == _frags.end()) {
+            if (_frags.size() >= _frag_max_flows) {
+                // Flow budget: a new flow evicts the oldest incomplete one,
+                // so a fragment-heavy peer cannot grow the table without
+                // bound even while staying under the byte budget.
+                frag_drop(_frags_age.front());
+            }
+            i = _frags.try_emplace(frag_id).first;
+            i->second.id = frag_id;
+            i->second.rx_time = clock_type::now();
+            _frags_age.push_back(i->second);
+        }
+        auto& frag = i->second;
         if (mf == false) {
             frag.last_frag_received = true;
         }
-        // This is a newly created frag_id
-        if (frag.mem_size == 0) {
-            _frags_age.push_back(frag_id);
-            frag.rx_time = clock_type::now();
-        }
         auto added_size = frag.merge(h, offset, std::move(p));
         _frag_mem += added_size;
         if (frag.is_complete()) {
             // All the fragments are received
-            auto dropped_size = frag.mem_size;
-            auto& ip_data = frag.data.map.begin()->second;
+            auto& ip_data = frag.segs.front().p;
             // Choose a cpu to forward this packet
             auto cpu_id = this_shard_id();
             auto l4 = _l4[h.ip_proto];
@@ -208,8 +207,7 @@ ipv4::handle_received_packet(packet p, ethernet_address from) {
             }
 
             // Delete this frag from _frags and _frags_age
-            frag_drop(frag_id, dropped_size);
-            _frags_age.remove(frag_id);
+            frag_drop(frag);
         } else {
             // Some of the fragments are missing
             if (!_frag_timer.armed()) {
@@ -366,14 +364,9 @@ void ipv4::frag_limit_mem() {
             return;
         }
         // Drop the oldest frag (first element) from _frags_age
-        auto frag_id = _frags_age.front();
-        _frags_age.pop_front();
-
-        // Drop from _frags as well
-        auto& frag = _frags[frag_id];
+        auto& frag = _frags_age.front();
         auto dropped_size = frag.mem_size;
-        frag_drop(frag_id, dropped_size);
-
+        frag_drop(frag);
         drop -= std::min(drop, dropped_size);
     }
 }
@@ -383,30 +376,32 @@ void ipv4::frag_timeout() {
         return;
     }
     auto now = clock_type::now();
-    for (auto it = _frags_age.begin(); it != _frags_age.end();) {
-        auto frag_id = *it;
-        auto& frag = _frags[frag_id];
-        if (now > frag.rx_time + _frag_timeout) {
-            auto dropped_size = frag.mem_size;
-            // Drop from _frags
-            frag_drop(frag_id, dropped_size);
-            // Drop from _frags_age
-            it = _frags_age.erase(it);
-        } else {
+    size_t dropped = 0;
+    while (!_frags_age.empty() && dropped < _frag_expiry_batch) {
+        auto& frag = _frags_age.front();
+        if (now <= frag.rx_time + _frag_timeout) {
             // The further items can only be younger
             break;
         }
+        frag_drop(frag);
+        ++dropped;
     }
-    if (_frags.size() != 0) {
-        frag_arm(now);
-    } else {
+    if (_frags.empty()) {
         _frag_mem = 0;
+    } else if (dropped == _frag_expiry_batch) {
+        // More expired flows may remain; yield to the reactor and continue
+        // in the next timer service rather than stalling the shard.
+        _frag_timer.arm(now);
+    } else {
+        // The next expiry is when the new front of the age list times out
+        _frag_timer.arm(_frags_age.front().rx_time + _frag_timeout);
     }
 }
 
-void ipv4::frag_drop(ipv4_frag_id frag_id, uint32_t dropped_size) {
-    _frags.erase(frag_id);
-    _frag_mem -= dropped_size;
+void ipv4::frag_drop(frag& frag) noexcept {
+    _frag_mem -= frag.mem_size;
+    _frags_age.erase(_frags_age.iterator_to(frag));
+    _frags.erase(frag.id);
 }
 
 int32_t ipv4::frag::merge(ip_hdr &h, uint16_t offset, packet p) {
@@ -418,27 +413,59 @@ int32_t ipv4::frag::merge(ip_hdr &h, uint16_t offset, packet p) {
     }
     // Sotre IP payload
     p.trim_front(ip_hdr_len);
-    data.merge(offset, std::move(p));
+    insert_data(offset, std::move(p));
     // Update mem size
     mem_size = header.memory();
-    for (const auto& x : data.map) {
-        mem_size += x.second.memory();
+    for (const auto& s : segs) {
+        mem_size += s.p.memory();
     }
     auto added_size = mem_size - old;
     return added_size;
 }
 
+void ipv4::frag::insert_data(uint32_t beg, packet p) {
+    auto end = beg + p.len();
+    // Find the first run whose end reaches the new fragment. In-order
+    // arrival lands on the last run and extends it by chaining buffers.
+    auto it = std::lower_bound(segs.begin(), segs.end(), beg, [] (const seg& s, uint32_t beg) {
+        return s.offset + s.p.len() < beg;
+    });
+    if (it != segs.end() && it->offset <= beg) {
+        auto seg_end = it->offset + it->p.len();
+        if (end <= seg_end) {
+            // We already have this data
+            return;
+        }
+        // Trim what the run already covers and grow it
+        p.trim_front(seg_end - beg);
+        it->p.append(std::move(p));
+    } else {
+        // Starts a new run in front of *it (or at the back)
+        it = segs.insert(it, seg{beg, std::move(p)});
+    }
+    // The grown (or inserted) run may now reach into subsequent runs:
+    // absorb them, preferring the data we already accepted for overlaps
+    auto next = std::next(it);
+    while (next != segs.end() && next->offset <= it->offset + it->p.len()) {
+        auto it_end = it->offset + it->p.len();
+        auto next_end = next->offset + next->p.len();
+        if (next_end > it_end) {
+            next->p.trim_front(it_end - next->offset);
+            it->p.append(std::move(next->p));
+        }
+        next = segs.erase(next);
+    }
+}
+
 bool ipv4::frag::is_complete() {
-    // If all the fragments are received, ipv4::frag::merge() should merge all
-    // the fragments into a single packet
-    auto offset = data.map.begin()->first;
-    auto nr_packet = data.map.size();
-    return last_frag_received && nr_packet == 1 && offset == 0;
+    // The datagram is complete when the last fragment was seen and all the
+    // runs have merged into a single one starting at offset zero
+    return last_frag_received && segs.size() == 1 && segs.front().offset == 0;
 }
 
 packet ipv4::frag::get_assembled_packet(ethernet_address from, ethernet_address to) {
     auto& ip_header = header;
-    auto& ip_data = data.map.begin()->second;
+    auto& ip_data = segs.front().p;
     // Append a ethernet header, needed for forwarding
     auto eh = ip_header.prepend_header<eth_hdr>();
     eh->src_mac = from;
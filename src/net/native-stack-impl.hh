@@ -103,6 +103,7 @@ public:
     keepalive_params get_keepalive_parameters() const override;
     int get_sockopt(int level, int optname, void* data, size_t len) const override;
     void set_sockopt(int level, int optname, const void* data, size_t len) override;
+    std::optional<tcp_connection_stats> get_tcp_stats() const override;
 };
 
 template <typename Protocol>
@@ -264,6 +265,11 @@ int native_connected_socket_impl<Protocol>::get_sockopt(int level, int optname,
     throw std::runtime_error("Getting custom socket options is not supported for native stack");
 }
 
+template<typename Protocol>
+std::optional<tcp_connection_stats> native_connected_socket_impl<Protocol>::get_tcp_stats() const {
+    return _conn->get_stats();
+}
+
 }
 
 }
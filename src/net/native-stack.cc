@@ -26,7 +26,9 @@
 #include <seastar/net/tcp-stack.hh>
 #include <seastar/net/tcp.hh>
 #include <seastar/net/udp.hh>
+#include <seastar/net/vhost-user.hh>
 #include <seastar/net/virtio.hh>
+#include <seastar/net/xdp.hh>
 #include <seastar/net/dpdk.hh>
 #include <seastar/net/proxy.hh>
 #include <seastar/net/dhcp.hh>
@@ -73,9 +75,15 @@ void create_native_net_device(boost::program_options::variables_map opts) {
              dev = create_dpdk_net_device(opts["dpdk-port-index"].as<unsigned>(), smp::count,
                 !(opts.count("lro") && opts["lro"].as<std::string>() == "off"),
                 !(opts.count("hw-fc") && opts["hw-fc"].as<std::string>() == "off"));   
-       } else 
-#endif  
-        dev = create_virtio_net_device(opts);
+       } else
+#endif
+        if (opts.count("xdp-device") && !opts["xdp-device"].empty()) {
+            dev = create_xdp_net_device(opts);
+        } else if (opts.count("vhost-user-socket") && !opts["vhost-user-socket"].empty()) {
+            dev = create_vhost_user_net_device(opts);
+        } else {
+            dev = create_virtio_net_device(opts);
+        }
     }
     else {
         auto device_configs = parse_config(net_config);
@@ -190,6 +198,8 @@ native_network_stack::make_udp_channel(const socket_address& addr) {
 void
 add_native_net_options_description(boost::program_options::options_description &opts) {
     opts.add(get_virtio_net_options_description());
+    opts.add(get_xdp_net_options_description());
+    opts.add(get_vhost_user_net_options_description());
 #ifdef SEASTAR_HAVE_DPDK
     opts.add(get_dpdk_net_options_description());
 #endif
@@ -199,6 +209,16 @@ native_network_stack::native_network_stack(boost::program_options::variables_map
     : _netif(std::move(dev))
     , _inet(&_netif) {
     _inet.get_udp().set_queue_size(opts["udpv4-queue-size"].as<int>());
+    auto cc = opts["tcp-congestion-control"].as<std::string>();
+    if (cc == "rate-based") {
+        _inet.get_tcp().set_congestion_algorithm(net::tcp_congestion_algorithm::rate_based);
+    } else if (cc != "reno") {
+        throw std::runtime_error(format("Unknown congestion control algorithm: {}", cc));
+    }
+    auto conns = opts["tcp-connection-table-size"].as<unsigned>();
+    if (conns) {
+        _inet.get_tcp().reserve_connections(conns);
+    }
     _dhcp = opts["host-ipv4-addr"].defaulted()
             && opts["gw-ipv4-addr"].defaulted()
             && opts["netmask-ipv4-addr"].defaulted() && opts["dhcp"].as<bool>();
@@ -324,6 +344,12 @@ boost::program_options::options_description nns_options() {
         ("udpv4-queue-size",
                 boost::program_options::value<int>()->default_value(ipv4_udp::default_queue_size),
                 "Default size of the UDPv4 per-channel packet queue")
+        ("tcp-congestion-control",
+                boost::program_options::value<std::string>()->default_value("reno"),
+                "TCP congestion control algorithm to use (reno | rate-based)")
+        ("tcp-connection-table-size",
+                boost::program_options::value<unsigned>()->default_value(0),
+                "Expected number of concurrent TCP connections per shard; pre-sizes the connection table (0 = default sizing)")
         ("dhcp",
                 boost::program_options::value<bool>()->default_value(true),
                         "Use DHCP discovery")
@@ -24,7 +24,10 @@
 #include <boost/algorithm/string.hpp>
 #include <seastar/net/net.hh>
 #include <utility>
+#include <seastar/net/ip.hh>
+#include <seastar/net/tcp.hh>
 #include <seastar/net/toeplitz.hh>
+#include <seastar/util/later.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/metrics.hh>
 #include <seastar/core/print.hh>
@@ -81,6 +84,49 @@ ipv4_addr::ipv4_addr(const ::in_addr& in, uint16_t p) noexcept
 
 namespace net {
 
+// Shard-wide rx latency histograms, fed by the sampled packet timestamps
+// taken in device::l2receive (see offload_info::rx_timestamp). Two points
+// are measured: entry into protocol processing, and delivery, i.e. the
+// moment the payload becomes readable by the application.
+class rx_latency_stats {
+    // recorded in microseconds; delays of a second and above saturate
+    // into the last bucket
+    using latency_histogram = metrics::log_histogram<1000000, 2>;
+    latency_histogram _protocol;
+    latency_histogram _delivery;
+    metrics::metric_groups _metrics;
+public:
+    rx_latency_stats() {
+        namespace sm = seastar::metrics;
+        _metrics.add_group("network", {
+            sm::make_histogram("rx_protocol_delay", [this] { return _protocol.to_histogram(1e-6); },
+                    sm::description("Histogram of the delay, in seconds, between a sampled packet leaving the device layer "
+                                    "and entering protocol processing; includes cross-shard forwarding and the rx stream queue")),
+            sm::make_histogram("rx_delivery_delay", [this] { return _delivery.to_histogram(1e-6); },
+                    sm::description("Histogram of the delay, in seconds, between a sampled packet leaving the device layer "
+                                    "and its payload becoming readable by the application")),
+        });
+    }
+    void record_protocol(std::chrono::steady_clock::duration d) {
+        _protocol.record(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+    }
+    void record_delivery(std::chrono::steady_clock::duration d) {
+        _delivery.record(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+    }
+};
+
+static rx_latency_stats& rx_latency() {
+    // Constructed lazily so metrics are registered on a running reactor.
+    static thread_local rx_latency_stats stats;
+    return stats;
+}
+
+void record_rx_delivery(const packet& p) {
+    if (auto ts = p.offload_info().rx_timestamp) {
+        rx_latency().record_delivery(std::chrono::steady_clock::now() - *ts);
+    }
+}
+
 inline
 bool qp::poll_tx() {
     if (_tx_packetq.size() < 16) {
@@ -325,6 +371,106 @@ void interface::forward(unsigned cpuid, packet p) {
     }
 }
 
+// Merges p into an aggregated flow, or starts a new one, when p is a plain
+// in-order TCP/IPv4 data segment. Returns true when p was consumed; held
+// flows are delivered at the end of the current poll batch by flush_gro().
+bool interface::gro_receive(packet& p, ethernet_address from, l3_rx_stream& l3) {
+    if (!_hw_features.rx_csum_offload) {
+        // Merging invalidates the headers' checksums, so aggregate only
+        // when the device already verified them.
+        return false;
+    }
+    auto iph = p.get_header<ip_hdr>(0);
+    if (!iph) {
+        return false;
+    }
+    auto ih = ntoh(*iph);
+    if (ih.ver != 4 || ih.ihl != 5 || ih.ip_proto != uint8_t(ip_protocol_num::tcp)
+            || ih.mf() || ih.offset() || ih.len != p.len()) {
+        return false;
+    }
+    auto ip_hdr_len = unsigned(ih.ihl) * 4;
+    auto th = p.get_header(ip_hdr_len, tcp_hdr::len);
+    if (!th) {
+        return false;
+    }
+    auto h = tcp_hdr::read(th);
+    auto src_ip = ih.src_ip.ip;
+    auto dst_ip = ih.dst_ip.ip;
+    auto flow_i = std::find_if(_gro_flows.begin(), _gro_flows.end(), [&] (const gro_flow& flow) {
+        return flow.src_ip == src_ip && flow.dst_ip == dst_ip
+                && flow.src_port == h.src_port && flow.dst_port == h.dst_port;
+    });
+    auto flush_and_drop_flow = [&] {
+        flush_gro_flow(*flow_i);
+        std::swap(*flow_i, _gro_flows.back());
+        _gro_flows.pop_back();
+    };
+    auto payload_len = uint32_t(ih.len) - ip_hdr_len - unsigned(h.data_offset) * 4;
+    // Aggregate only plain ACK data segments without options; anything
+    // carrying flags or options must be seen by TCP as it arrived, after
+    // whatever we already hold for its connection.
+    if (h.data_offset != 5 || !h.f_ack || h.f_syn || h.f_fin || h.f_rst || h.f_psh || h.f_urg || h.rsvd2
+            || !payload_len) {
+        if (flow_i != _gro_flows.end()) {
+            flush_and_drop_flow();
+        }
+        return false;
+    }
+    if (flow_i != _gro_flows.end()) {
+        auto& flow = *flow_i;
+        if (h.seq.raw == flow.next_seq && h.ack.raw == flow.ack && h.window == flow.window
+                && flow.total_len + payload_len <= ip_packet_len_max
+                && flow.segments < max_gro_segments) {
+            p.trim_front(ip_hdr_len + unsigned(h.data_offset) * 4);
+            flow.p.append(std::move(p));
+            flow.next_seq += payload_len;
+            flow.total_len += payload_len;
+            flow.segments++;
+            return true;
+        }
+        // Out of order, or the ack/window moved: deliver what we have
+        // first so TCP sees the segments in arrival order.
+        flush_and_drop_flow();
+        return false;
+    }
+    if (_gro_flows.size() == max_gro_flows) {
+        return false;
+    }
+    _gro_flows.push_back(gro_flow{std::move(p), from, &l3, src_ip, dst_ip,
+            h.src_port, h.dst_port, h.seq.raw + payload_len, h.ack.raw, h.window,
+            ih.len, 1});
+    if (!_gro_flush_scheduled) {
+        _gro_flush_scheduled = true;
+        // Runs after every packet of the current poll batch was dispatched
+        // FIXME: ignored future
+        (void)later().then([this] {
+            flush_gro();
+        });
+    }
+    return true;
+}
+
+void interface::flush_gro_flow(gro_flow& flow) {
+    if (flow.segments > 1) {
+        auto iph = flow.p.get_header<ip_hdr>(0);
+        iph->len = hton(uint16_t(flow.total_len));
+        flow.p.offload_info_ref().reassembled = true;
+    }
+    auto& l3 = *flow.l3;
+    if (l3.ready.available()) {
+        l3.ready = l3.packet_stream.produce(std::move(flow.p), flow.from);
+    }
+}
+
+void interface::flush_gro() {
+    _gro_flush_scheduled = false;
+    for (auto& flow : _gro_flows) {
+        flush_gro_flow(flow);
+    }
+    _gro_flows.clear();
+}
+
 future<> interface::dispatch_packet(packet p) {
     auto eh = p.get_header<eth_hdr>();
     if (eh) {
@@ -338,7 +484,9 @@ future<> interface::dispatch_packet(packet p) {
                 } else {
                     forward_hash data;
                     if (l3.forward(data, p, sizeof(eth_hdr))) {
-                        return toeplitz_hash(rss_key(), data);
+                        // Remember the hash in the packet so the target
+                        // cpu of a software-RSS forward does not rehash
+                        return p.set_rss_hash(toeplitz_hash(rss_key(), data)).value();
                     }
                     return 0u;
                 }
@@ -349,6 +497,12 @@ future<> interface::dispatch_packet(packet p) {
                 auto h = ntoh(*eh);
                 auto from = h.src_mac;
                 p.trim_front(sizeof(*eh));
+                if (auto ts = p.offload_info().rx_timestamp) {
+                    rx_latency().record_protocol(std::chrono::steady_clock::now() - *ts);
+                }
+                if (h.eth_proto == uint16_t(eth_protocol_num::ipv4) && gro_receive(p, from, l3)) {
+                    return make_ready_future<>();
+                }
                 // avoid chaining, since queue lenth is unlimited
                 // drop instead.
                 if (l3.ready.available()) {
@@ -22,12 +22,14 @@
 #include <random>
 
 #include <sys/socket.h>
+#include <sys/mman.h>
 #include <linux/if.h>
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include <net/route.h>
 
 #include <seastar/core/loop.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/net/posix-stack.hh>
 #include <seastar/net/net.hh>
@@ -35,8 +37,13 @@
 #include <seastar/net/api.hh>
 #include <seastar/net/inet_address.hh>
 #include <seastar/util/std-compat.hh>
+#include <seastar/core/align.hh>
 #include <netinet/tcp.h>
 #include <netinet/sctp.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 
 namespace std {
 
@@ -89,11 +96,62 @@ public:
     virtual int get_sockopt(file_desc& _fd, int level, int optname, void* data, size_t len) const {
         return _fd.getsockopt(level, optname, reinterpret_cast<char*>(data), socklen_t(len));
     }
+    virtual std::optional<tcp_connection_stats> get_tcp_stats(file_desc& _fd) const {
+        return std::nullopt;
+    }
 };
 
 thread_local posix_ap_server_socket_impl::sockets_map_t posix_ap_server_socket_impl::sockets{};
 thread_local posix_ap_server_socket_impl::conn_map_t posix_ap_server_socket_impl::conn_q{};
 
+// The kernel's TCP_INFO reply has long outgrown glibc's struct tcp_info,
+// and some of the fields we report (pacing rate, unsent bytes) only exist
+// in the tail glibc does not declare. Mirror the kernel layout up to the
+// last field we consume; the kernel copies out min(kernel size, optlen)
+// bytes, so on older kernels the tail simply stays zeroed.
+struct linux_tcp_info {
+    uint8_t state;
+    uint8_t ca_state;
+    uint8_t retransmits;
+    uint8_t probes;
+    uint8_t backoff;
+    uint8_t options;
+    uint8_t wscale;         // snd_wscale : 4, rcv_wscale : 4
+    uint8_t app_limited;    // delivery_rate_app_limited : 1, fastopen_client_fail : 2
+    uint32_t rto;
+    uint32_t ato;
+    uint32_t snd_mss;
+    uint32_t rcv_mss;
+    uint32_t unacked;
+    uint32_t sacked;
+    uint32_t lost;
+    uint32_t retrans;
+    uint32_t fackets;
+    uint32_t last_data_sent;
+    uint32_t last_ack_sent;
+    uint32_t last_data_recv;
+    uint32_t last_ack_recv;
+    uint32_t pmtu;
+    uint32_t rcv_ssthresh;
+    uint32_t rtt;
+    uint32_t rttvar;
+    uint32_t snd_ssthresh;
+    uint32_t snd_cwnd;
+    uint32_t advmss;
+    uint32_t reordering;
+    uint32_t rcv_rtt;
+    uint32_t rcv_space;
+    uint32_t total_retrans;
+    uint64_t pacing_rate;
+    uint64_t max_pacing_rate;
+    uint64_t bytes_acked;
+    uint64_t bytes_received;
+    uint32_t segs_out;
+    uint32_t segs_in;
+    uint32_t notsent_bytes;
+    uint32_t min_rtt;
+};
+
 class posix_tcp_connected_socket_operations : public posix_connected_socket_operations {
 public:
     virtual void set_nodelay(file_desc& _fd, bool nodelay) const override {
@@ -121,6 +179,21 @@ public:
             _fd.getsockopt<unsigned>(IPPROTO_TCP, TCP_KEEPCNT)
         };
     }
+    virtual std::optional<tcp_connection_stats> get_tcp_stats(file_desc& _fd) const override {
+        linux_tcp_info info = {};
+        _fd.getsockopt(IPPROTO_TCP, TCP_INFO, reinterpret_cast<char*>(&info), socklen_t(sizeof(info)));
+        tcp_connection_stats stats;
+        stats.rtt = std::chrono::microseconds(info.rtt);
+        stats.rtt_variance = std::chrono::microseconds(info.rttvar);
+        stats.mss = info.snd_mss;
+        // the kernel counts the congestion window and unacked data in segments
+        stats.congestion_window = uint64_t(info.snd_cwnd) * info.snd_mss;
+        stats.unacked_bytes = uint64_t(info.unacked) * info.snd_mss;
+        stats.send_queue_bytes = info.notsent_bytes;
+        stats.retransmits = info.total_retrans;
+        stats.pacing_rate = info.pacing_rate;
+        return stats;
+    }
 };
 
 class posix_sctp_connected_socket_operations : public posix_connected_socket_operations {
@@ -202,21 +275,95 @@ class posix_connected_socket_impl final : public connected_socket_impl {
     const posix_connected_socket_operations* _ops;
     conntrack::handle _handle;
     std::pmr::polymorphic_allocator<char>* _allocator;
+    size_t _zerocopy_threshold = 0;
+    size_t _zerocopy_rcv_threshold = 0;
+    size_t _notsent_lowat = 0;
 private:
     explicit posix_connected_socket_impl(sa_family_t family, int protocol, pollable_fd fd, std::pmr::polymorphic_allocator<char>* allocator=memory::malloc_allocator) :
         _fd(std::move(fd)), _ops(get_posix_connected_socket_ops(family, protocol)), _allocator(allocator) {}
     explicit posix_connected_socket_impl(sa_family_t family, int protocol, pollable_fd fd, conntrack::handle&& handle,
         std::pmr::polymorphic_allocator<char>* allocator=memory::malloc_allocator) : _fd(std::move(fd))
                 , _ops(get_posix_connected_socket_ops(family, protocol)), _handle(std::move(handle)), _allocator(allocator) {}
+    explicit posix_connected_socket_impl(const posix_connected_socket_operations* ops, pollable_fd fd, conntrack::handle&& handle,
+        std::pmr::polymorphic_allocator<char>* allocator) : _fd(std::move(fd))
+                , _ops(ops), _handle(std::move(handle)), _allocator(allocator) {}
+    // Everything a migrating socket needs on the target shard: the bare
+    // fd (a pollable_fd is registered with the target reactor when the
+    // impl is rebuilt), the socket-family ops singleton, the connection
+    // tracking handle and the zero-copy thresholds.
+    class migrated final : public migration_state {
+        const posix_connected_socket_operations* _ops;
+        file_desc _fd;
+        conntrack::handle _handle;
+        std::pmr::polymorphic_allocator<char>* _allocator;
+        size_t _zerocopy_threshold;
+        size_t _zerocopy_rcv_threshold;
+        size_t _notsent_lowat;
+    public:
+        explicit migrated(posix_connected_socket_impl& impl)
+                : _ops(impl._ops)
+                // detach() withdraws the source shard's backend
+                // registration before surrendering the descriptor; just
+                // stealing the file_desc would leave the epoll interest
+                // set pointing at the state forget() is about to free
+                , _fd(impl._fd.detach())
+                , _handle(std::move(impl._handle))
+                , _allocator(impl._allocator)
+                , _zerocopy_threshold(impl._zerocopy_threshold)
+                , _zerocopy_rcv_threshold(impl._zerocopy_rcv_threshold)
+                , _notsent_lowat(impl._notsent_lowat) {
+        }
+        virtual std::unique_ptr<connected_socket_impl> attach() override {
+            _handle.move_to(this_shard_id());
+            auto csi = std::unique_ptr<posix_connected_socket_impl>(new posix_connected_socket_impl(
+                    _ops, pollable_fd(std::move(_fd)), std::move(_handle), _allocator));
+            csi->_zerocopy_threshold = _zerocopy_threshold;
+            csi->_zerocopy_rcv_threshold = _zerocopy_rcv_threshold;
+            csi->_notsent_lowat = _notsent_lowat;
+            return csi;
+        }
+    };
 public:
     virtual data_source source() override {
         return source(connected_socket_input_stream_config());
     }
     virtual data_source source(connected_socket_input_stream_config csisc) override {
-        return data_source(std::make_unique<posix_data_source_impl>(_fd, csisc, _allocator));
+        return data_source(std::make_unique<posix_data_source_impl>(_fd, csisc, _allocator, _zerocopy_rcv_threshold));
     }
     virtual data_sink sink() override {
-        return data_sink(std::make_unique< posix_data_sink_impl>(_fd));
+        return data_sink(std::make_unique< posix_data_sink_impl>(_fd, _zerocopy_threshold, _notsent_lowat != 0));
+    }
+    virtual void set_zerocopy_send(size_t threshold) override {
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+        if (threshold && !_zerocopy_threshold) {
+            int enable = 1;
+            try {
+                _fd.get_file_desc().setsockopt(SOL_SOCKET, SO_ZEROCOPY, enable);
+            } catch (...) {
+                // Old kernel, or a socket family without zero-copy support
+                // (e.g. AF_UNIX); keep copying.
+                return;
+            }
+        }
+        _zerocopy_threshold = threshold;
+#endif
+    }
+    virtual void set_zerocopy_receive(size_t threshold) override {
+#ifdef TCP_ZEROCOPY_RECEIVE
+        _zerocopy_rcv_threshold = threshold;
+#endif
+    }
+    virtual void set_notsent_lowat(size_t bytes) override {
+#ifdef TCP_NOTSENT_LOWAT
+        try {
+            _fd.get_file_desc().setsockopt(IPPROTO_TCP, TCP_NOTSENT_LOWAT,
+                    bytes ? int(std::min<size_t>(bytes, std::numeric_limits<int>::max())) : -1);
+        } catch (...) {
+            // Not a TCP socket; keep buffering freely.
+            return;
+        }
+        _notsent_lowat = bytes;
+#endif
     }
     virtual void shutdown_input() override {
         _fd.shutdown(SHUT_RD);
@@ -248,6 +395,15 @@ public:
     int get_sockopt(int level, int optname, void* data, size_t len) const override {
         return _ops->get_sockopt(_fd.get_file_desc(), level, optname, data, len);
     }
+    std::optional<tcp_connection_stats> get_tcp_stats() const override {
+        return _ops->get_tcp_stats(_fd.get_file_desc());
+    }
+    virtual bool can_migrate() const noexcept override {
+        return true;
+    }
+    virtual std::unique_ptr<migration_state> detach_for_migration() override {
+        return std::make_unique<migrated>(*this);
+    }
     friend class posix_server_socket_impl;
     friend class posix_ap_server_socket_impl;
     friend class posix_reuseport_server_socket_impl;
@@ -368,6 +524,7 @@ class posix_socket_impl final : public socket_impl {
     pollable_fd _fd;
     std::pmr::polymorphic_allocator<char>* _allocator;
     bool _reuseaddr = false;
+    bool _fastopen = false;
 
     future<> find_port_and_connect(socket_address sa, socket_address local, transport proto = transport::TCP) {
         static thread_local std::default_random_engine random_engine{std::random_device{}()};
@@ -380,6 +537,20 @@ class posix_socket_impl final : public socket_impl {
         return repeat([this, sa, local, proto, attempts = 0, requested_port = ntoh(local.as_posix_sockaddr_in().sin_port)] () mutable {
             _fd = engine().make_pollable_fd(sa, int(proto));
             _fd.get_file_desc().setsockopt(SOL_SOCKET, SO_REUSEADDR, int(_reuseaddr));
+#ifdef TCP_FASTOPEN_CONNECT
+            if (_fastopen && proto == transport::TCP) {
+                try {
+                    // connect() then completes without waiting for the
+                    // handshake; the first write carries the SYN payload.
+                    _fd.get_file_desc().setsockopt(IPPROTO_TCP, TCP_FASTOPEN_CONNECT, 1);
+                } catch (std::system_error& err) {
+                    // Kernel predates TFO; fall back to a regular connect.
+                    if (err.code() != std::error_code(ENOPROTOOPT, std::system_category())) {
+                        throw;
+                    }
+                }
+            }
+#endif
             uint16_t port = attempts++ < 5 && requested_port == 0 && proto == transport::TCP ? u(random_engine) * smp::count + this_shard_id() : requested_port;
             local.as_posix_sockaddr_in().sin_port = hton(port);
             return futurize_invoke([this, sa, local] { return engine().posix_connect(_fd, sa, local); }).then_wrapped([port, requested_port] (future<> f) {
@@ -435,6 +606,10 @@ public:
         }
     }
 
+    void set_fastopen_connect(bool enabled) override {
+        _fastopen = enabled;
+    }
+
     bool get_reuseaddr() const override {
         if(_fd) {
             return _fd.get_file_desc().getsockopt<int>(SOL_SOCKET, SO_REUSEADDR);
@@ -456,12 +631,55 @@ public:
     }
 };
 
+// Shard-wide counters of whether accepted TCP connections end up owned by
+// the shard on the cpu the kernel delivers their packets to. A mismatch
+// costs a core-to-core hop on every packet; the counters make it visible,
+// and listeners can avoid it with incoming_cpu load balancing.
+class tcp_steering_stats {
+    uint64_t _matched = 0;
+    uint64_t _crossed = 0;
+    metrics::metric_groups _metrics;
+public:
+    tcp_steering_stats() {
+        namespace sm = seastar::metrics;
+        _metrics.add_group("network", {
+            sm::make_derive("tcp_accepts_on_delivery_cpu", _matched,
+                    sm::description("Accepted TCP connections owned by the shard on the cpu where the kernel delivers their packets")),
+            sm::make_derive("tcp_accepts_cross_cpu", _crossed,
+                    sm::description("Accepted TCP connections owned by a shard on a different cpu than the one delivering their packets")),
+        });
+    }
+    void record(bool matched) {
+        matched ? _matched++ : _crossed++;
+    }
+};
+
+static tcp_steering_stats& tcp_steering() {
+    // Constructed lazily so metrics are registered on a running reactor.
+    static thread_local tcp_steering_stats stats;
+    return stats;
+}
+
+// The shard pinned to the cpu the kernel delivers this connection's
+// packets to, if any.
+static std::optional<shard_id> incoming_cpu_shard(const pollable_fd& fd) noexcept {
+#ifdef SO_INCOMING_CPU
+    try {
+        return smp::shard_of_cpu(fd.get_file_desc().getsockopt<int>(SOL_SOCKET, SO_INCOMING_CPU));
+    } catch (std::system_error&) {
+        // Old kernel, or not a TCP socket.
+    }
+#endif
+    return std::nullopt;
+}
+
 future<accept_result>
 posix_server_socket_impl::accept() {
     return _lfd.accept().then([this] (std::tuple<pollable_fd, socket_address> fd_sa) {
         auto& fd = std::get<0>(fd_sa);
         auto& sa = std::get<1>(fd_sa);
-        auto cth = [this, &sa] {
+        auto delivery_shard = incoming_cpu_shard(fd);
+        auto cth = [this, &sa, delivery_shard] {
             switch(_lba) {
             case server_socket::load_balancing_algorithm::connection_distribution:
                 return _conntrack.get_handle();
@@ -469,10 +687,15 @@ posix_server_socket_impl::accept() {
                 return _conntrack.get_handle(ntoh(sa.as_posix_sockaddr_in().sin_port) % smp::count);
             case server_socket::load_balancing_algorithm::fixed:
                 return _conntrack.get_handle(_fixed_cpu);
+            case server_socket::load_balancing_algorithm::incoming_cpu:
+                return delivery_shard ? _conntrack.get_handle(*delivery_shard) : _conntrack.get_handle();
             default: abort();
             }
         } ();
         auto cpu = cth.cpu();
+        if (delivery_shard) {
+            tcp_steering().record(*delivery_shard == cpu);
+        }
         if (cpu == this_shard_id()) {
             std::unique_ptr<connected_socket_impl> csi(
                     new posix_connected_socket_impl(sa.family(), _protocol, std::move(fd), std::move(cth), _allocator));
@@ -537,6 +760,9 @@ posix_reuseport_server_socket_impl::accept() {
     return _lfd.accept().then([allocator = _allocator, protocol = _protocol] (std::tuple<pollable_fd, socket_address> fd_sa) {
         auto& fd = std::get<0>(fd_sa);
         auto& sa = std::get<1>(fd_sa);
+        if (auto delivery_shard = incoming_cpu_shard(fd)) {
+            tcp_steering().record(*delivery_shard == this_shard_id());
+        }
         std::unique_ptr<connected_socket_impl> csi(
                 new posix_connected_socket_impl(sa.family(), protocol, std::move(fd), allocator));
         return make_ready_future<accept_result>(
@@ -572,21 +798,86 @@ posix_ap_server_socket_impl::move_connected_socket(int protocol, socket_address
 
 future<temporary_buffer<char>>
 posix_data_source_impl::get() {
+#ifdef TCP_ZEROCOPY_RECEIVE
+    if (_zerocopy_threshold && _config.buffer_size >= _zerocopy_threshold) {
+        return _fd.readable().then([this] {
+            auto b = try_zerocopy_receive();
+            if (!b.empty()) {
+                adjust_buffer_size(b.size());
+                return make_ready_future<temporary_buffer<char>>(std::move(b));
+            }
+            // Nothing mappable (small or unaligned residue, EOF, or no
+            // kernel support); serve this read by copying.
+            return do_get();
+        });
+    }
+#endif
+    return do_get();
+}
+
+future<temporary_buffer<char>>
+posix_data_source_impl::do_get() {
     return _fd.read_some(static_cast<internal::buffer_allocator*>(this)).then([this] (temporary_buffer<char> b) {
-        if (b.size() >= _config.buffer_size) {
-            _config.buffer_size *= 2;
-            _config.buffer_size = std::min(_config.buffer_size, _config.max_buffer_size);
-        } else if (b.size() <= _config.buffer_size / 4) {
-            _config.buffer_size /= 2;
-            _config.buffer_size = std::max(_config.buffer_size, _config.min_buffer_size);
-        }
+        adjust_buffer_size(b.size());
         return b;
     });
 }
 
+void
+posix_data_source_impl::adjust_buffer_size(size_t last_read) {
+    if (last_read >= _config.buffer_size) {
+        _config.buffer_size *= 2;
+        _config.buffer_size = std::min(_config.buffer_size, _config.max_buffer_size);
+    } else if (last_read <= _config.buffer_size / 4) {
+        _config.buffer_size /= 2;
+        _config.buffer_size = std::max(_config.buffer_size, _config.min_buffer_size);
+    }
+}
+
+temporary_buffer<char>
+posix_data_source_impl::try_zerocopy_receive() {
+#ifdef TCP_ZEROCOPY_RECEIVE
+    static const size_t page_size = getpagesize();
+    auto fd = _fd.get_file_desc().get();
+    // The kernel only maps whole pages; read() picks up the rest.
+    auto len = align_down<size_t>(_config.buffer_size, page_size);
+    if (!len) {
+        return {};
+    }
+    auto addr = ::mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        // Not a TCP socket, or the kernel predates receive zero-copy.
+        _zerocopy_threshold = 0;
+        return {};
+    }
+    tcp_zerocopy_receive zc = {};
+    zc.address = reinterpret_cast<uintptr_t>(addr);
+    zc.length = len;
+    socklen_t zc_len = sizeof(zc);
+    auto r = ::getsockopt(fd, IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc, &zc_len);
+    if (r < 0 || !zc.length) {
+        // On success with length == 0 the pending data is shorter than a
+        // page or starts mid-page (zc.recv_skip_hint bytes); both cases
+        // are cheaper to copy than to map.
+        ::munmap(addr, len);
+        if (r < 0 && errno != EAGAIN) {
+            _zerocopy_threshold = 0;
+        }
+        return {};
+    }
+    if (zc.length < len) {
+        ::munmap(static_cast<char*>(addr) + zc.length, len - zc.length);
+    }
+    return temporary_buffer<char>(static_cast<char*>(addr), zc.length,
+            make_deleter([addr, len = size_t(zc.length)] { ::munmap(addr, len); }));
+#else
+    return {};
+#endif
+}
+
 temporary_buffer<char>
 posix_data_source_impl::allocate_buffer() {
-    return make_temporary_buffer<char>(_buffer_allocator, _config.buffer_size);
+    return make_recycled_temporary_buffer(_buffer_allocator, _config.buffer_size);
 }
 
 future<> posix_data_source_impl::close() {
@@ -614,19 +905,168 @@ std::vector<iovec> to_iovec(std::vector<temporary_buffer<char>>& buf_vec) {
 
 future<>
 posix_data_sink_impl::put(temporary_buffer<char> buf) {
-    return _fd.write_all(buf.get(), buf.size()).then([d = buf.release()] {});
+    auto f = _fd.write_all(buf.get(), buf.size()).then([d = buf.release()] {});
+    if (_notsent_lowat) {
+        f = f.then([this] { return wait_unsent_below_lowat(); });
+    }
+    return f;
 }
 
 future<>
 posix_data_sink_impl::put(packet p) {
+    auto f = [&] {
+        if (_zerocopy_threshold && p.len() >= _zerocopy_threshold) {
+            return zerocopy_put(std::move(p));
+        }
+        _p = std::move(p);
+        return _fd.write_all(_p).then([this] { _p.reset(); });
+    } ();
+    if (_notsent_lowat) {
+        f = f.then([this] { return wait_unsent_below_lowat(); });
+    }
+    return f;
+}
+
+future<>
+posix_data_sink_impl::wait_unsent_below_lowat() {
+    // With TCP_NOTSENT_LOWAT set, the socket polls writeable only when the
+    // backlog the kernel has accepted but not yet transmitted is below the
+    // watermark. The kernel would otherwise take a full send buffer before
+    // pushing back, giving a slow consumer megabytes of queued latency.
+    return _fd.writeable();
+}
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+
+future<>
+posix_data_sink_impl::zerocopy_put(packet p) {
+    reap_zerocopy_acks();
+    _p = std::move(p);
+    return do_with(size_t(0), true, _zc_seq, [this] (size_t& offset, bool& zerocopy, uint32_t& first_seq) {
+        return do_until([this, &offset] { return offset == _p.len(); }, [this, &offset, &zerocopy] {
+            return _fd.writeable().then([this, &offset, &zerocopy] {
+                auto iov = to_iovec(_p);
+                // Skip the part already accepted by previous partial sends. We
+                // cannot trim_front() the packet itself: the kernel may still
+                // reference the sent fragments.
+                auto it = iov.begin();
+                auto skip = offset;
+                while (skip >= it->iov_len) {
+                    skip -= it->iov_len;
+                    ++it;
+                }
+                auto base = *it;
+                it->iov_base = reinterpret_cast<char*>(it->iov_base) + skip;
+                it->iov_len -= skip;
+                msghdr mh = {};
+                mh.msg_iov = &*it;
+                mh.msg_iovlen = iov.end() - it;
+                std::optional<size_t> r;
+                try {
+                    r = _fd.get_file_desc().sendmsg(&mh, (zerocopy ? MSG_ZEROCOPY : 0) | MSG_NOSIGNAL);
+                } catch (const std::system_error& e) {
+                    if (zerocopy && e.code().value() == ENOBUFS) {
+                        // Hit the optmem_max limit on pinned pages; finish
+                        // this write with plain copies.
+                        zerocopy = false;
+                        return make_ready_future<>();
+                    }
+                    throw;
+                }
+                *it = base;
+                if (r) {
+                    // Every zero-copy sendmsg() that accepted data consumed
+                    // one sequence number on the socket.
+                    if (zerocopy && *r) {
+                        ++_zc_seq;
+                    }
+                    offset += *r;
+                }
+                return make_ready_future<>();
+            });
+        }).then([this, &first_seq] {
+            if (_zc_seq != first_seq) {
+                // The kernel still references the fragments; park the packet
+                // until the error queue acknowledges the last send.
+                _zc_inflight.emplace_back(_zc_seq - 1, std::move(_p));
+            }
+            _p.reset();
+        });
+    });
+}
+
+void
+posix_data_sink_impl::reap_zerocopy_acks() {
+    while (!_zc_inflight.empty()) {
+        char control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+        msghdr mh = {};
+        mh.msg_control = control;
+        mh.msg_controllen = sizeof(control);
+        std::optional<size_t> r;
+        try {
+            r = _fd.get_file_desc().recvmsg(&mh, MSG_ERRQUEUE);
+        } catch (...) {
+            // A real socket error will surface through the data path.
+            return;
+        }
+        if (!r) {
+            return; // nothing queued
+        }
+        for (auto* cmsg = CMSG_FIRSTHDR(&mh); cmsg; cmsg = CMSG_NXTHDR(&mh, cmsg)) {
+            if (cmsg->cmsg_level != SOL_IP && cmsg->cmsg_level != SOL_IPV6) {
+                continue;
+            }
+            auto* serr = reinterpret_cast<const struct sock_extended_err*>(CMSG_DATA(cmsg));
+            if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                continue;
+            }
+            // [ee_info, ee_data] is the acknowledged (wrapping) range of
+            // sequence numbers; release every packet whose last send falls
+            // inside it.
+            auto hi = serr->ee_data;
+            while (!_zc_inflight.empty() && int32_t(hi - _zc_inflight.front().first) >= 0) {
+                _zc_inflight.pop_front();
+            }
+        }
+    }
+}
+
+future<>
+posix_data_sink_impl::drain_zerocopy_acks() {
+    return do_until([this] { return _zc_inflight.empty(); }, [this] {
+        // Pending error-queue notifications show up as poll errors, waking
+        // both readers and writers.
+        return _fd.readable_or_writeable().then([this] {
+            reap_zerocopy_acks();
+        });
+    });
+}
+
+#else
+
+future<>
+posix_data_sink_impl::zerocopy_put(packet p) {
     _p = std::move(p);
     return _fd.write_all(_p).then([this] { _p.reset(); });
 }
 
+void
+posix_data_sink_impl::reap_zerocopy_acks() {
+}
+
+future<>
+posix_data_sink_impl::drain_zerocopy_acks() {
+    return make_ready_future<>();
+}
+
+#endif
+
 future<>
 posix_data_sink_impl::close() {
     _fd.shutdown(SHUT_WR);
-    return make_ready_future<>();
+    // Zero-copy sends must be acknowledged before the buffers backing them
+    // can be dropped.
+    return drain_zerocopy_acks();
 }
 
 posix_network_stack::posix_network_stack(boost::program_options::variables_map opts, std::pmr::polymorphic_allocator<char>* allocator)
@@ -683,31 +1123,87 @@ struct cmsg_with_pktinfo {
     };
 };
 
+// Shard-wide batch-size statistics for the sendmmsg()/recvmmsg() calls
+// issued by UDP channels, exported as histograms with power-of-two buckets.
+class udp_mmsg_stats {
+    // batches are at most 16 datagrams, so 16 lands in the last bucket
+    using batch_histogram = metrics::log_histogram<17, 1>;
+    batch_histogram _send_batches;
+    batch_histogram _recv_batches;
+    metrics::metric_groups _metrics;
+public:
+    udp_mmsg_stats() {
+        namespace sm = seastar::metrics;
+        _metrics.add_group("network", {
+            sm::make_histogram("udp_send_batch_size", [this] { return _send_batches.to_histogram(); },
+                    sm::description("Histogram of datagrams transmitted per sendmmsg() call")),
+            sm::make_histogram("udp_recv_batch_size", [this] { return _recv_batches.to_histogram(); },
+                    sm::description("Histogram of datagrams received per recvmmsg() call")),
+        });
+    }
+    void record_send(unsigned n) { _send_batches.record(n); }
+    void record_recv(unsigned n) { _recv_batches.record(n); }
+};
+
+static udp_mmsg_stats& udp_stats() {
+    // Constructed lazily so metrics are registered on a running reactor.
+    static thread_local udp_mmsg_stats stats;
+    return stats;
+}
+
 class posix_udp_channel : public udp_channel_impl {
 private:
     static constexpr int MAX_DATAGRAM_SIZE = 65507;
-    struct recv_ctx {
-        struct msghdr _hdr;
-        struct iovec _iov;
-        socket_address _src_addr;
-        char* _buffer;
-        cmsg_with_pktinfo _cmsg;
+    static constexpr unsigned max_mmsg_batch = 16;
+    struct recv_batch {
+        struct slot {
+            struct iovec _iov;
+            socket_address _src_addr;
+            char* _buffer = nullptr;
+            // Room for the pktinfo control message, the UDP_GRO segment
+            // size and the rx timestamp
+            alignas(struct cmsghdr) char _cmsg[CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+#ifdef SO_TIMESTAMPING
+                    + CMSG_SPACE(sizeof(struct scm_timestamping))
+#endif
+                    ];
+        };
+        std::array<struct mmsghdr, max_mmsg_batch> _hdrs;
+        std::array<slot, max_mmsg_batch> _slots;
+
+        recv_batch() {
+            memset(_hdrs.data(), 0, sizeof(_hdrs));
+            for (unsigned i = 0; i < max_mmsg_batch; i++) {
+                auto& hdr = _hdrs[i].msg_hdr;
+                auto& slot = _slots[i];
+                hdr.msg_iov = &slot._iov;
+                hdr.msg_iovlen = 1;
+                hdr.msg_name = &slot._src_addr.u.sa;
+                memset(&slot._cmsg, 0, sizeof(slot._cmsg));
+                hdr.msg_control = &slot._cmsg;
+            }
+        }
 
-        recv_ctx() {
-            memset(&_hdr, 0, sizeof(_hdr));
-            _hdr.msg_iov = &_iov;
-            _hdr.msg_iovlen = 1;
-            _hdr.msg_name = &_src_addr.u.sa;
-            _hdr.msg_namelen = sizeof(_src_addr.u.sas);
-            memset(&_cmsg, 0, sizeof(_cmsg));
-            _hdr.msg_control = &_cmsg;
-            _hdr.msg_controllen = sizeof(_cmsg);
+        ~recv_batch() {
+            for (auto& slot : _slots) {
+                delete[] slot._buffer;
+            }
         }
 
-        void prepare() {
-            _buffer = new char[MAX_DATAGRAM_SIZE];
-            _iov.iov_base = _buffer;
-            _iov.iov_len = MAX_DATAGRAM_SIZE;
+        void prepare(unsigned n) {
+            for (unsigned i = 0; i < n; i++) {
+                auto& slot = _slots[i];
+                if (!slot._buffer) {
+                    slot._buffer = new char[MAX_DATAGRAM_SIZE];
+                }
+                slot._iov.iov_base = slot._buffer;
+                slot._iov.iov_len = MAX_DATAGRAM_SIZE;
+                // The kernel overwrites these per message
+                auto& hdr = _hdrs[i].msg_hdr;
+                hdr.msg_namelen = sizeof(slot._src_addr.u.sas);
+                hdr.msg_controllen = sizeof(slot._cmsg);
+                hdr.msg_flags = 0;
+            }
         }
     };
     struct send_ctx {
@@ -715,6 +1211,7 @@ private:
         std::vector<struct iovec> _iovecs;
         socket_address _dst;
         packet _p;
+        promise<size_t> _done;
 
         send_ctx() {
             memset(&_hdr, 0, sizeof(_hdr));
@@ -731,11 +1228,35 @@ private:
             _hdr.msg_iovlen = _iovecs.size();
             resolve_outgoing_address(_dst);
         }
+
+#ifdef UDP_SEGMENT
+        alignas(struct cmsghdr) char _cmsg[CMSG_SPACE(sizeof(uint16_t))];
+
+        // Asks the kernel to segment this send into segment_size-byte
+        // datagrams (GSO)
+        void set_segment_size(uint16_t segment_size) {
+            _hdr.msg_control = _cmsg;
+            _hdr.msg_controllen = sizeof(_cmsg);
+            auto* cmsg = CMSG_FIRSTHDR(&_hdr);
+            cmsg->cmsg_level = IPPROTO_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+        }
+#endif
     };
     pollable_fd _fd;
     socket_address _address;
-    recv_ctx _recv;
-    send_ctx _send;
+    recv_batch _recv;
+    std::deque<udp_datagram> _received;
+    unsigned _recv_batch_size = 1;
+    // Sends issued while a sendmmsg() is in flight accumulate here (the
+    // deque keeps the msghdrs at stable addresses) and go out together in
+    // the next batch.
+    std::deque<send_ctx> _pending_sends;
+    std::array<struct mmsghdr, max_mmsg_batch> _send_hdrs;
+    bool _send_in_progress = false;
+    bool _gso_supported = false;
     bool _closed;
 public:
     posix_udp_channel(const socket_address& bind_address)
@@ -743,17 +1264,46 @@ public:
         auto sa = bind_address.is_unspecified() ? socket_address(inet_address(inet_address::family::INET)) : bind_address;
         file_desc fd = file_desc::socket(sa.u.sa.sa_family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
         fd.setsockopt(SOL_IP, IP_PKTINFO, true);
+#ifdef SO_TIMESTAMPING
+        // Ask the kernel for rx timestamps, taken in the driver as early
+        // as possible. Raw hardware stamps run on the NIC clock and cannot
+        // be placed on the host timeline without PTP, so only software
+        // stamps are requested.
+        try {
+            fd.setsockopt(SOL_SOCKET, SO_TIMESTAMPING,
+                    int(SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE));
+        } catch (...) {
+            // Datagrams simply carry no timestamp
+        }
+#endif
         if (engine().posix_reuseport_available()) {
             fd.setsockopt(SOL_SOCKET, SO_REUSEPORT, 1);
         }
         fd.bind(sa.u.sa, sizeof(sa.u.sas));
         _address = fd.get_address();
+#ifdef UDP_SEGMENT
+        // Probe for segmentation offload; the actual segment size is passed
+        // per send via a cmsg
+        try {
+            fd.setsockopt(IPPROTO_UDP, UDP_SEGMENT, int(0));
+            _gso_supported = true;
+        } catch (...) {
+        }
+#endif
+#ifdef UDP_GRO
+        try {
+            fd.setsockopt(IPPROTO_UDP, UDP_GRO, int(1));
+        } catch (...) {
+            // Old kernel; peers simply see unmerged datagrams
+        }
+#endif
         _fd = std::move(fd);
     }
     virtual ~posix_udp_channel() { if (!_closed) close(); };
     virtual future<udp_datagram> receive() override;
     virtual future<> send(const socket_address& dst, const char *msg) override;
     virtual future<> send(const socket_address& dst, packet p) override;
+    virtual future<> send(const socket_address& dst, packet p, uint16_t segment_size) override;
     virtual void shutdown_input() override {
         _fd.abort_reader();
     }
@@ -769,6 +1319,9 @@ public:
         assert(_address.u.sas.ss_family != AF_INET6 || (_address.addr_length > 20));
         return _address;
     }
+private:
+    void flush_sends();
+    udp_datagram make_datagram(unsigned i);
 };
 
 future<> posix_udp_channel::send(const socket_address& dst, const char *message) {
@@ -781,9 +1334,63 @@ future<> posix_udp_channel::send(const socket_address& dst, const char *message)
 
 future<> posix_udp_channel::send(const socket_address& dst, packet p) {
     auto len = p.len();
-    _send.prepare(dst, std::move(p));
-    return _fd.sendmsg(&_send._hdr)
-            .then([len] (size_t size) { assert(size == len); });
+    _pending_sends.emplace_back();
+    auto& ctx = _pending_sends.back();
+    ctx.prepare(dst, std::move(p));
+    auto f = ctx._done.get_future();
+    if (!_send_in_progress) {
+        flush_sends();
+    }
+    return f.then([len] (size_t size) { assert(size == len); });
+}
+
+future<> posix_udp_channel::send(const socket_address& dst, packet p, uint16_t segment_size) {
+#ifdef UDP_SEGMENT
+    if (_gso_supported && p.len() > segment_size) {
+        auto len = p.len();
+        _pending_sends.emplace_back();
+        auto& ctx = _pending_sends.back();
+        ctx.prepare(dst, std::move(p));
+        ctx.set_segment_size(segment_size);
+        auto f = ctx._done.get_future();
+        if (!_send_in_progress) {
+            flush_sends();
+        }
+        return f.then([len] (size_t size) { assert(size == len); });
+    }
+#endif
+    // No kernel segmentation offload: the software fallback carves the
+    // packet into datagrams, which coalesce into sendmmsg() batches here
+    return udp_channel_impl::send(dst, std::move(p), segment_size);
+}
+
+void posix_udp_channel::flush_sends() {
+    _send_in_progress = true;
+    // The loop completes the promise of every datagram it manages to hand to
+    // the kernel, so callers never outwait their own send.
+    (void)do_until([this] { return _pending_sends.empty(); }, [this] {
+        unsigned n = std::min<size_t>(_pending_sends.size(), max_mmsg_batch);
+        for (unsigned i = 0; i < n; i++) {
+            memset(&_send_hdrs[i], 0, sizeof(_send_hdrs[i]));
+            _send_hdrs[i].msg_hdr = _pending_sends[i]._hdr;
+        }
+        return _fd.sendmmsg(_send_hdrs.data(), n).then([this] (unsigned sent) {
+            udp_stats().record_send(sent);
+            for (unsigned i = 0; i < sent; i++) {
+                _pending_sends.front()._done.set_value(_send_hdrs[i].msg_len);
+                _pending_sends.pop_front();
+            }
+        });
+    }).then_wrapped([this] (future<> f) {
+        _send_in_progress = false;
+        if (f.failed()) {
+            auto ep = f.get_exception();
+            while (!_pending_sends.empty()) {
+                _pending_sends.front()._done.set_exception(ep);
+                _pending_sends.pop_front();
+            }
+        }
+    });
 }
 
 udp_channel
@@ -810,33 +1417,87 @@ private:
     socket_address _src;
     socket_address _dst;
     packet _p;
+    uint16_t _gro_segment_size;
 public:
-    posix_datagram(const socket_address& src, const socket_address& dst, packet p) : _src(src), _dst(dst), _p(std::move(p)) {}
+    posix_datagram(const socket_address& src, const socket_address& dst, packet p, uint16_t gro_segment_size = 0)
+            : _src(src), _dst(dst), _p(std::move(p)), _gro_segment_size(gro_segment_size) {}
     virtual socket_address get_src() override { return _src; }
     virtual socket_address get_dst() override { return _dst; }
     virtual uint16_t get_dst_port() override { return _dst.port(); }
     virtual packet& get_data() override { return _p; }
+    virtual uint16_t gro_segment_size() override { return _gro_segment_size; }
+    virtual std::optional<std::chrono::steady_clock::time_point> rx_timestamp() override {
+        return _p.offload_info().rx_timestamp;
+    }
 };
 
+udp_datagram
+posix_udp_channel::make_datagram(unsigned i) {
+    auto& hdr = _recv._hdrs[i].msg_hdr;
+    auto& slot = _recv._slots[i];
+    socket_address dst;
+    uint16_t gro_segment_size = 0;
+    std::optional<std::chrono::steady_clock::time_point> rx_timestamp;
+    for (auto* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+        if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+            dst = ipv4_addr(copy_reinterpret_cast<in_pktinfo>(CMSG_DATA(cmsg)).ipi_addr, _address.port());
+        } else if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO) {
+            dst = ipv6_addr(copy_reinterpret_cast<in6_pktinfo>(CMSG_DATA(cmsg)).ipi6_addr, _address.port());
+#ifdef UDP_GRO
+        } else if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+            auto segment_size = copy_reinterpret_cast<int>(CMSG_DATA(cmsg));
+            if (segment_size > 0 && segment_size < int(_recv._hdrs[i].msg_len)) {
+                gro_segment_size = segment_size;
+            }
+#endif
+#ifdef SO_TIMESTAMPING
+        } else if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            auto tss = copy_reinterpret_cast<scm_timestamping>(CMSG_DATA(cmsg));
+            auto& ts = tss.ts[0];
+            if (ts.tv_sec || ts.tv_nsec) {
+                // The kernel stamps on the realtime clock; rebase onto the
+                // steady clock the latency accounting uses
+                auto stamped = std::chrono::system_clock::time_point(
+                        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec)));
+                rx_timestamp = std::chrono::steady_clock::now() - (std::chrono::system_clock::now() - stamped);
+            }
+#endif
+        }
+    }
+    auto* buf = std::exchange(slot._buffer, nullptr);
+    auto p = packet(fragment{buf, _recv._hdrs[i].msg_len}, make_deleter([buf] { delete[] buf; }));
+    if (rx_timestamp) {
+        p.offload_info_ref().rx_timestamp = rx_timestamp;
+        record_rx_delivery(p);
+    }
+    return udp_datagram(std::make_unique<posix_datagram>(slot._src_addr, dst, std::move(p),
+            gro_segment_size));
+}
+
 future<udp_datagram>
 posix_udp_channel::receive() {
-    _recv.prepare();
-    return _fd.recvmsg(&_recv._hdr).then([this] (size_t size) {
-        socket_address dst;
-        for (auto* cmsg = CMSG_FIRSTHDR(&_recv._hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&_recv._hdr, cmsg)) {
-            if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
-                dst = ipv4_addr(copy_reinterpret_cast<in_pktinfo>(CMSG_DATA(cmsg)).ipi_addr, _address.port());
-                break;
-            } else if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO) {
-                dst = ipv6_addr(copy_reinterpret_cast<in6_pktinfo>(CMSG_DATA(cmsg)).ipi6_addr, _address.port());
-                break;
-            }
+    if (!_received.empty()) {
+        auto d = std::move(_received.front());
+        _received.pop_front();
+        return make_ready_future<udp_datagram>(std::move(d));
+    }
+    auto n = _recv_batch_size;
+    _recv.prepare(n);
+    return _fd.recvmmsg(_recv._hdrs.data(), n).then([this, n] (unsigned got) {
+        udp_stats().record_recv(got);
+        // Adapt the batch to the arrival rate: grow when the batch fills up,
+        // shrink when it stays mostly empty, so request-response traffic
+        // keeps allocating a single buffer per call.
+        if (got == n) {
+            _recv_batch_size = std::min(_recv_batch_size * 2, max_mmsg_batch);
+        } else if (got <= n / 4) {
+            _recv_batch_size = std::max(_recv_batch_size / 2, 1u);
+        }
+        for (unsigned i = 1; i < got; i++) {
+            _received.push_back(make_datagram(i));
         }
-        return make_ready_future<udp_datagram>(udp_datagram(std::make_unique<posix_datagram>(
-            _recv._src_addr, dst, packet(fragment{_recv._buffer, size}, make_deleter([buf = _recv._buffer] { delete[] buf; })))));
-    }).handle_exception([p = _recv._buffer](auto ep) {
-        delete[] p;
-        return make_exception_future<udp_datagram>(std::move(ep));
+        return make_ready_future<udp_datagram>(make_datagram(0));
     });
 }
 
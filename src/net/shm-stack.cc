@@ -0,0 +1,505 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <atomic>
+#include <deque>
+
+#include <sys/socket.h>
+#include <sys/mman.h>
+
+#include <seastar/core/reactor.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/do_with.hh>
+#include <seastar/net/shm-stack.hh>
+#include <seastar/net/stack.hh>
+#include <seastar/net/api.hh>
+
+namespace seastar {
+
+namespace net {
+
+// Wire layout of the shared region, mapped by both processes. Two
+// single-producer single-consumer byte rings, one per direction;
+// ring[0] carries client-to-server data, ring[1] the reverse. Offsets
+// are free-running 64-bit counters (never wrapped), so `tail - head`
+// is the number of unconsumed bytes and emptiness needs no reserved
+// slot. Each side sleeps on its own eventfds and rings the peer's
+// after producing data or freeing space, so an idle connection costs
+// nothing and syscalls happen only across empty/full transitions.
+struct shm_ring_header {
+    alignas(64) std::atomic<uint64_t> tail;     // written by the producer
+    alignas(64) std::atomic<uint64_t> head;     // written by the consumer
+    alignas(64) std::atomic<uint32_t> closed;   // producer finished (EOF)
+    std::atomic<uint32_t> abandoned;            // consumer will not read further
+};
+
+struct shm_region_header {
+    static constexpr uint64_t magic_value = 0x73686d2d72696e67; // "shm-ring"
+    static constexpr uint32_t current_version = 1;
+    uint64_t magic;
+    uint32_t version;
+    uint32_t ring_size;
+    shm_ring_header rings[2];
+};
+
+// The data area starts page-aligned after the header; each direction
+// gets ring_size contiguous bytes.
+static constexpr size_t shm_data_offset = 4096;
+static constexpr uint32_t shm_default_ring_size = 256 * 1024;
+static constexpr uint32_t shm_max_ring_size = 16 * 1024 * 1024;
+
+static_assert(sizeof(shm_region_header) <= shm_data_offset, "region header must fit before the data area");
+
+// The per-connection shared state: the mapping, this side's view of the
+// rings, and the doorbells. Shared between the source, the sink and the
+// connected_socket impl, and kept alive by buffers handed out to the
+// application, since those point straight into the mapping.
+class shm_connection : public enable_lw_shared_from_this<shm_connection> {
+    mmap_area _map;
+    shm_region_header* _hdr;
+    shm_ring_header* _tx;
+    shm_ring_header* _rx;
+    char* _tx_data;
+    char* _rx_data;
+    uint32_t _ring_size;
+    // We sleep on these...
+    pollable_fd _rx_doorbell;       // peer produced data or closed
+    pollable_fd _tx_doorbell;       // peer freed space or stopped reading
+    // ...and ring these.
+    file_desc _peer_rx_doorbell;
+    file_desc _peer_tx_doorbell;
+    // Keeps the handshake socket (and so the unix address) open for the
+    // connection lifetime; never polled after the handshake.
+    pollable_fd _handshake_fd;
+    uint64_t _doorbell_value = 0;
+
+    // Receive spans handed to the application and not yet dropped. The
+    // ring head may only advance over a released prefix -- buffers can
+    // be dropped out of order, but the bytes of a still-held buffer must
+    // not be handed to the producer for reuse.
+    struct rx_span {
+        uint64_t end;
+        bool released;
+    };
+    std::deque<rx_span> _rx_spans;
+    uint64_t _rx_seen = 0;      // bytes handed out so far
+
+public:
+    shm_connection(mmap_area map, bool server, pollable_fd rx_doorbell, pollable_fd tx_doorbell,
+            file_desc peer_rx_doorbell, file_desc peer_tx_doorbell, pollable_fd handshake_fd)
+            : _map(std::move(map))
+            , _hdr(reinterpret_cast<shm_region_header*>(_map.get()))
+            , _tx(&_hdr->rings[server ? 1 : 0])
+            , _rx(&_hdr->rings[server ? 0 : 1])
+            , _ring_size(_hdr->ring_size)
+            , _rx_doorbell(std::move(rx_doorbell))
+            , _tx_doorbell(std::move(tx_doorbell))
+            , _peer_rx_doorbell(std::move(peer_rx_doorbell))
+            , _peer_tx_doorbell(std::move(peer_tx_doorbell))
+            , _handshake_fd(std::move(handshake_fd)) {
+        auto data = _map.get() + shm_data_offset;
+        _tx_data = server ? data + _ring_size : data;
+        _rx_data = server ? data : data + _ring_size;
+    }
+
+    ~shm_connection() {
+        // Wake the peer up so it observes whatever close flags were set;
+        // a connection dropped without shutdown still produces EOF (or
+        // a broken pipe) on the other side rather than a hang.
+        close_tx();
+        abandon_rx();
+    }
+
+    future<> wait_rx_doorbell() {
+        return _rx_doorbell.read_some(reinterpret_cast<char*>(&_doorbell_value), sizeof(_doorbell_value)).discard_result();
+    }
+
+    future<> wait_tx_doorbell() {
+        return _tx_doorbell.read_some(reinterpret_cast<char*>(&_doorbell_value), sizeof(_doorbell_value)).discard_result();
+    }
+
+    // Copies up to len bytes into the transmit ring, returning how many
+    // fit. Publishes the new tail and rings the peer's receive doorbell
+    // if anything was written.
+    size_t push(const char* p, size_t len) noexcept {
+        auto tail = _tx->tail.load(std::memory_order_relaxed);
+        auto room = size_t(_ring_size - (tail - _tx->head.load(std::memory_order_acquire)));
+        len = std::min(len, room);
+        size_t done = 0;
+        while (done < len) {
+            auto off = size_t((tail + done) % _ring_size);
+            auto chunk = std::min(len - done, size_t(_ring_size) - off);
+            std::copy_n(p + done, chunk, _tx_data + off);
+            done += chunk;
+        }
+        if (len != 0) {
+            _tx->tail.store(tail + len, std::memory_order_release);
+            ring(_peer_rx_doorbell);
+        }
+        return len;
+    }
+
+    bool tx_abandoned() const noexcept {
+        return _tx->abandoned.load(std::memory_order_relaxed);
+    }
+
+    size_t rx_available() const noexcept {
+        return _rx->tail.load(std::memory_order_acquire) - _rx_seen;
+    }
+
+    bool rx_closed() const noexcept {
+        return _rx->closed.load(std::memory_order_acquire);
+    }
+
+    // Hands out the contiguous readable span as a zero-copy view into
+    // the mapped ring. The span is accounted for in _rx_spans and the
+    // producer only regains the bytes once the buffer is dropped.
+    temporary_buffer<char> pop() {
+        auto tail = _rx->tail.load(std::memory_order_acquire);
+        auto off = size_t(_rx_seen % _ring_size);
+        auto len = std::min(size_t(tail - _rx_seen), size_t(_ring_size) - off);
+        _rx_seen += len;
+        _rx_spans.push_back(rx_span{_rx_seen, false});
+        auto d = make_deleter([self = shared_from_this(), end = _rx_seen] () mutable {
+            self->release_rx(end);
+        });
+        return temporary_buffer<char>(_rx_data + off, len, std::move(d));
+    }
+
+    void close_tx() noexcept {
+        if (!_tx->closed.load(std::memory_order_relaxed)) {
+            _tx->closed.store(1, std::memory_order_release);
+            ring(_peer_rx_doorbell);
+        }
+    }
+
+    void abandon_rx() noexcept {
+        if (!_rx->abandoned.load(std::memory_order_relaxed)) {
+            _rx->abandoned.store(1, std::memory_order_release);
+            ring(_peer_tx_doorbell);
+        }
+    }
+
+private:
+    void ring(file_desc& doorbell) noexcept {
+        uint64_t one = 1;
+        try {
+            doorbell.write(&one, sizeof(one));
+        } catch (...) {
+            // An eventfd write fails only if the counter would overflow,
+            // which still leaves the peer signalled.
+        }
+    }
+
+    void release_rx(uint64_t end) noexcept {
+        for (auto& s : _rx_spans) {
+            if (s.end == end) {
+                s.released = true;
+                break;
+            }
+        }
+        auto head = _rx->head.load(std::memory_order_relaxed);
+        bool advanced = false;
+        while (!_rx_spans.empty() && _rx_spans.front().released) {
+            head = _rx_spans.front().end;
+            _rx_spans.pop_front();
+            advanced = true;
+        }
+        if (advanced) {
+            _rx->head.store(head, std::memory_order_release);
+            ring(_peer_tx_doorbell);
+        }
+    }
+};
+
+class shm_data_source_impl final : public data_source_impl {
+    lw_shared_ptr<shm_connection> _conn;
+public:
+    explicit shm_data_source_impl(lw_shared_ptr<shm_connection> conn) : _conn(std::move(conn)) {}
+    virtual future<temporary_buffer<char>> get() override {
+        if (_conn->rx_available() != 0) {
+            return make_ready_future<temporary_buffer<char>>(_conn->pop());
+        }
+        if (_conn->rx_closed() && _conn->rx_available() == 0) {
+            return make_ready_future<temporary_buffer<char>>();
+        }
+        return _conn->wait_rx_doorbell().then([this] {
+            return get();
+        });
+    }
+    virtual future<> close() override {
+        _conn->abandon_rx();
+        return make_ready_future<>();
+    }
+};
+
+class shm_data_sink_impl final : public data_sink_impl {
+    lw_shared_ptr<shm_connection> _conn;
+public:
+    explicit shm_data_sink_impl(lw_shared_ptr<shm_connection> conn) : _conn(std::move(conn)) {}
+    using data_sink_impl::put;
+    virtual future<> put(packet p) override {
+        return do_with(std::move(p), unsigned(0), size_t(0), [this] (packet& p, unsigned& frag, size_t& off) {
+            return repeat([this, &p, &frag, &off] {
+                if (frag == p.nr_frags()) {
+                    return make_ready_future<stop_iteration>(stop_iteration::yes);
+                }
+                if (_conn->tx_abandoned()) {
+                    return make_exception_future<stop_iteration>(
+                            std::system_error(EPIPE, std::system_category(), "shm connection"));
+                }
+                auto& f = p.fragments()[frag];
+                off += _conn->push(f.base + off, f.size - off);
+                if (off == f.size) {
+                    ++frag;
+                    off = 0;
+                    return make_ready_future<stop_iteration>(stop_iteration::no);
+                }
+                // Ring full; sleep until the peer frees space.
+                return _conn->wait_tx_doorbell().then([] {
+                    return stop_iteration::no;
+                });
+            });
+        });
+    }
+    virtual future<> flush() override {
+        return make_ready_future<>();
+    }
+    virtual future<> close() override {
+        _conn->close_tx();
+        return make_ready_future<>();
+    }
+};
+
+class shm_connected_socket_impl final : public connected_socket_impl {
+    lw_shared_ptr<shm_connection> _conn;
+public:
+    explicit shm_connected_socket_impl(lw_shared_ptr<shm_connection> conn) : _conn(std::move(conn)) {}
+    virtual data_source source() override {
+        return data_source(std::make_unique<shm_data_source_impl>(_conn));
+    }
+    virtual data_sink sink() override {
+        return data_sink(std::make_unique<shm_data_sink_impl>(_conn));
+    }
+    virtual void shutdown_input() override {
+        _conn->abandon_rx();
+    }
+    virtual void shutdown_output() override {
+        _conn->close_tx();
+    }
+    // As for posix unix-domain sockets: no coalescing to disable, no
+    // keepalive to configure.
+    virtual void set_nodelay(bool nodelay) override {}
+    virtual bool get_nodelay() const override {
+        return true;
+    }
+    virtual void set_keepalive(bool keepalive) override {}
+    virtual bool get_keepalive() const override {
+        return false;
+    }
+    virtual void set_keepalive_parameters(const keepalive_params&) override {}
+    virtual keepalive_params get_keepalive_parameters() const override {
+        return keepalive_params{};
+    }
+    virtual void set_sockopt(int level, int optname, const void* data, size_t len) override {
+        throw std::system_error(ENOPROTOOPT, std::system_category(), "shm connection");
+    }
+    virtual int get_sockopt(int level, int optname, void* data, size_t len) const override {
+        throw std::system_error(ENOPROTOOPT, std::system_category(), "shm connection");
+    }
+};
+
+// The handshake over the unix socket: one version byte, with the memfd
+// and the four doorbell eventfds attached via SCM_RIGHTS. The connecting
+// side creates and initializes everything; the accepting side only
+// validates and maps.
+static constexpr size_t shm_handshake_nr_fds = 5;
+
+static void shm_send_handshake_fds(file_desc& fd, const int (&fds)[shm_handshake_nr_fds]) {
+    char payload = shm_region_header::current_version;
+    iovec iov = { &payload, sizeof(payload) };
+    char cmsg_buf[CMSG_SPACE(sizeof(fds))] = {};
+    msghdr mh = {};
+    mh.msg_iov = &iov;
+    mh.msg_iovlen = 1;
+    mh.msg_control = cmsg_buf;
+    mh.msg_controllen = sizeof(cmsg_buf);
+    auto cmsg = CMSG_FIRSTHDR(&mh);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+    auto r = fd.sendmsg(&mh, 0);
+    if (!r || *r != sizeof(payload)) {
+        throw std::system_error(ECONNABORTED, std::system_category(), "shm handshake send");
+    }
+}
+
+static std::array<file_desc, shm_handshake_nr_fds> shm_recv_handshake_fds(file_desc& fd) {
+    char payload = 0;
+    iovec iov = { &payload, sizeof(payload) };
+    char cmsg_buf[CMSG_SPACE(sizeof(int) * shm_handshake_nr_fds)] = {};
+    msghdr mh = {};
+    mh.msg_iov = &iov;
+    mh.msg_iovlen = 1;
+    mh.msg_control = cmsg_buf;
+    mh.msg_controllen = sizeof(cmsg_buf);
+    auto r = fd.recvmsg(&mh, MSG_CMSG_CLOEXEC);
+    if (!r || *r != sizeof(payload) || payload != shm_region_header::current_version) {
+        throw std::system_error(ECONNABORTED, std::system_category(), "shm handshake recv");
+    }
+    auto cmsg = CMSG_FIRSTHDR(&mh);
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS
+            || cmsg->cmsg_len != CMSG_LEN(sizeof(int) * shm_handshake_nr_fds)) {
+        throw std::system_error(ECONNABORTED, std::system_category(), "shm handshake recv");
+    }
+    int fds[shm_handshake_nr_fds];
+    std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+    return { file_desc::from_fd(fds[0]), file_desc::from_fd(fds[1]), file_desc::from_fd(fds[2]),
+             file_desc::from_fd(fds[3]), file_desc::from_fd(fds[4]) };
+}
+
+static size_t shm_region_size(uint32_t ring_size) {
+    return shm_data_offset + 2 * size_t(ring_size);
+}
+
+class shm_server_socket_impl final : public server_socket_impl {
+    socket_address _sa;
+    pollable_fd _lfd;
+public:
+    shm_server_socket_impl(socket_address sa, pollable_fd lfd) : _sa(sa), _lfd(std::move(lfd)) {}
+    virtual future<accept_result> accept() override {
+        return _lfd.accept().then([this] (std::tuple<pollable_fd, socket_address> fd_sa) {
+            auto& fd = std::get<0>(fd_sa);
+            auto& sa = std::get<1>(fd_sa);
+            return fd.readable().then([this, fd, sa] () mutable {
+                auto fds = shm_recv_handshake_fds(fd.get_file_desc());
+                shm_region_header hdr;
+                fds[0].pread(&hdr, sizeof(hdr), 0);
+                if (hdr.magic != shm_region_header::magic_value || hdr.version != shm_region_header::current_version
+                        || hdr.ring_size == 0 || hdr.ring_size > shm_max_ring_size) {
+                    throw std::system_error(ECONNABORTED, std::system_category(), "shm handshake region");
+                }
+                auto map = fds[0].map_shared_rw(shm_region_size(hdr.ring_size), 0);
+                // fds[1..2] are the client's doorbells, fds[3..4] ours.
+                auto conn = make_lw_shared<shm_connection>(std::move(map), true,
+                        pollable_fd(std::move(fds[3])), pollable_fd(std::move(fds[4])),
+                        std::move(fds[1]), std::move(fds[2]), std::move(fd));
+                std::unique_ptr<connected_socket_impl> csi(new shm_connected_socket_impl(std::move(conn)));
+                return make_ready_future<accept_result>(accept_result{connected_socket(std::move(csi)), sa});
+            });
+        });
+    }
+    virtual void abort_accept() override {
+        _lfd.abort_reader();
+    }
+    virtual socket_address local_address() const override {
+        return _sa;
+    }
+};
+
+class shm_socket_impl final : public socket_impl {
+    ::seastar::socket _posix;   // non-unix addresses are delegated
+    pollable_fd _fd;
+public:
+    explicit shm_socket_impl(::seastar::socket posix) : _posix(std::move(posix)) {}
+    virtual future<connected_socket> connect(socket_address sa, socket_address local, transport proto = transport::TCP) override {
+        if (!sa.is_af_unix()) {
+            return _posix.connect(sa, local, proto);
+        }
+        if (local.is_unspecified()) {
+            local = socket_address{unix_domain_addr{std::string{}}};
+        }
+        _fd = engine().make_pollable_fd(sa, 0);
+        return engine().posix_connect(_fd, sa, local).then([fd = _fd] () mutable {
+            auto memfd = file_desc::from_fd([] {
+                int r = ::memfd_create("seastar-shm-conn", MFD_CLOEXEC);
+                throw_system_error_on(r == -1, "memfd_create");
+                return r;
+            }());
+            auto ring_size = shm_default_ring_size;
+            memfd.truncate(shm_region_size(ring_size));
+            auto map = memfd.map_shared_rw(shm_region_size(ring_size), 0);
+            auto hdr = new (map.get()) shm_region_header{};
+            hdr->magic = shm_region_header::magic_value;
+            hdr->version = shm_region_header::current_version;
+            hdr->ring_size = ring_size;
+            auto rx_doorbell = file_desc::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            auto tx_doorbell = file_desc::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            auto peer_rx_doorbell = file_desc::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            auto peer_tx_doorbell = file_desc::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            int fds[shm_handshake_nr_fds] = { memfd.get(), rx_doorbell.get(), tx_doorbell.get(),
+                    peer_rx_doorbell.get(), peer_tx_doorbell.get() };
+            shm_send_handshake_fds(fd.get_file_desc(), fds);
+            auto conn = make_lw_shared<shm_connection>(std::move(map), false,
+                    pollable_fd(std::move(rx_doorbell)), pollable_fd(std::move(tx_doorbell)),
+                    std::move(peer_rx_doorbell), std::move(peer_tx_doorbell), std::move(fd));
+            std::unique_ptr<connected_socket_impl> csi(new shm_connected_socket_impl(std::move(conn)));
+            return make_ready_future<connected_socket>(connected_socket(std::move(csi)));
+        });
+    }
+    virtual void set_reuseaddr(bool reuseaddr) override {
+        _posix.set_reuseaddr(reuseaddr);
+    }
+    virtual bool get_reuseaddr() const override {
+        return _posix.get_reuseaddr();
+    }
+    virtual void shutdown() override {
+        if (_fd) {
+            try {
+                _fd.shutdown(SHUT_RDWR);
+            } catch (std::system_error& e) {
+                if (e.code().value() != ENOTCONN) {
+                    throw;
+                }
+            }
+        } else {
+            _posix.shutdown();
+        }
+    }
+};
+
+shm_network_stack::shm_network_stack(boost::program_options::variables_map opts, std::pmr::polymorphic_allocator<char>* allocator)
+        : posix_network_stack(std::move(opts), allocator) {
+}
+
+server_socket
+shm_network_stack::listen(socket_address sa, listen_options opt) {
+    if (!sa.is_af_unix()) {
+        return posix_network_stack::listen(sa, std::move(opt));
+    }
+    return server_socket(std::make_unique<shm_server_socket_impl>(sa, engine().posix_listen(sa, opt)));
+}
+
+::seastar::socket shm_network_stack::socket() {
+    return ::seastar::socket(std::make_unique<shm_socket_impl>(posix_network_stack::socket()));
+}
+
+void register_shm_stack() {
+    register_network_stack("shm", boost::program_options::options_description(),
+        [](boost::program_options::variables_map ops) {
+            return shm_network_stack::create(std::move(ops));
+        });
+}
+
+}
+
+}
@@ -19,8 +19,11 @@
  * Copyright 2015 Cloudius Systems
  */
 
+#include <seastar/core/loop.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/net/stack.hh>
 #include <seastar/net/inet_address.hh>
+#include <seastar/net/packet.hh>
 
 namespace seastar {
 
@@ -53,6 +56,10 @@ future<net::udp_datagram> net::udp_channel::receive() {
     return _impl->receive();
 }
 
+future<std::vector<net::udp_datagram>> net::udp_channel::receive_batch(size_t max) {
+    return _impl->receive_batch(max);
+}
+
 future<> net::udp_channel::send(const socket_address& dst, const char* msg) {
     return _impl->send(dst, msg);
 }
@@ -61,6 +68,39 @@ future<> net::udp_channel::send(const socket_address& dst, packet p) {
     return _impl->send(dst, std::move(p));
 }
 
+future<> net::udp_channel::send(const socket_address& dst, packet p, uint16_t segment_size) {
+    return _impl->send(dst, std::move(p), segment_size);
+}
+
+future<> net::udp_channel_impl::send(const socket_address& dst, packet p, uint16_t segment_size) {
+    // Software fallback: carve the buffer into datagrams and send them
+    // individually. Stacks that batch sends still coalesce the syscalls.
+    return do_with(std::move(p), size_t(0), [this, dst, segment_size] (packet& p, size_t& offset) {
+        return do_until([&p, &offset] { return offset == p.len(); }, [this, dst, segment_size, &p, &offset] {
+            auto len = std::min<size_t>(segment_size, p.len() - offset);
+            auto segment = p.share(offset, len);
+            offset += len;
+            return send(dst, std::move(segment));
+        });
+    });
+}
+
+future<std::vector<net::udp_datagram>> net::udp_channel_impl::receive_batch(size_t) {
+    // Single-datagram fallback for stacks without a receive queue to drain.
+    return receive().then([] (udp_datagram d) {
+        std::vector<udp_datagram> batch;
+        batch.push_back(std::move(d));
+        return batch;
+    });
+}
+
+void net::udp_channel_impl::set_rx_redistribution(bool) {
+}
+
+void net::udp_channel::set_rx_redistribution(bool enable) {
+    _impl->set_rx_redistribution(enable);
+}
+
 bool net::udp_channel::is_closed() const {
     return _impl->is_closed();
 }
@@ -78,6 +118,15 @@ void net::udp_channel::close() {
     return _impl->close();
 }
 
+bool net::connected_socket_impl::can_migrate() const noexcept {
+    return false;
+}
+
+std::unique_ptr<net::connected_socket_impl::migration_state>
+net::connected_socket_impl::detach_for_migration() {
+    throw std::runtime_error("connection migration not supported by this stack");
+}
+
 connected_socket::connected_socket() noexcept
 {}
 
@@ -126,6 +175,73 @@ void connected_socket::set_sockopt(int level, int optname, const void* data, siz
 int connected_socket::get_sockopt(int level, int optname, void* data, size_t len) const {
     return _csi->get_sockopt(level, optname, data, len);
 }
+void connected_socket::set_zerocopy_send(size_t threshold) {
+    _csi->set_zerocopy_send(threshold);
+}
+
+void connected_socket::set_zerocopy_receive(size_t threshold) {
+    _csi->set_zerocopy_receive(threshold);
+}
+
+void connected_socket::set_notsent_lowat(size_t bytes) {
+    _csi->set_notsent_lowat(bytes);
+}
+
+std::optional<net::tcp_connection_stats> connected_socket::get_tcp_stats() const {
+    return _csi->get_tcp_stats();
+}
+
+metrics::metric_groups connected_socket::register_stats_metrics(const sstring& group_name, std::vector<metrics::label_instance> labels) {
+    namespace sm = metrics;
+    // each gauge re-fetches the stats; they are cheap to collect, and the
+    // metric layer polls at a low rate anyway
+    auto impl = _csi.get();
+    metrics::metric_groups mg;
+    mg.add_group(group_name, {
+        sm::make_gauge("rtt_us", [impl] {
+            auto stats = impl->get_tcp_stats();
+            return stats ? stats->rtt.count() : 0;
+        }, sm::description("Smoothed round-trip time, in microseconds"), labels),
+        sm::make_gauge("send_queue_bytes", [impl] {
+            auto stats = impl->get_tcp_stats();
+            return stats ? stats->send_queue_bytes : 0;
+        }, sm::description("Bytes accepted from the application but not yet put on the wire"), labels),
+        sm::make_gauge("unacked_bytes", [impl] {
+            auto stats = impl->get_tcp_stats();
+            return stats ? stats->unacked_bytes : 0;
+        }, sm::description("Bytes on the wire not yet acknowledged by the peer"), labels),
+        sm::make_gauge("congestion_window_bytes", [impl] {
+            auto stats = impl->get_tcp_stats();
+            return stats ? stats->congestion_window : 0;
+        }, sm::description("Congestion window, in bytes"), labels),
+        sm::make_gauge("pacing_rate_bytes", [impl] {
+            auto stats = impl->get_tcp_stats();
+            return stats ? stats->pacing_rate : 0;
+        }, sm::description("Rate at which outgoing data is paced, in bytes per second"), labels),
+        sm::make_counter("retransmits", [impl] {
+            auto stats = impl->get_tcp_stats();
+            return stats ? stats->retransmits : 0;
+        }, sm::description("Segments retransmitted over the lifetime of the connection"), labels),
+    });
+    return mg;
+}
+
+bool connected_socket::can_migrate() const noexcept {
+    return _csi && _csi->can_migrate();
+}
+
+future<> connected_socket::migrate(shard_id shard, noncopyable_function<void (connected_socket)> consumer) {
+    try {
+        auto state = _csi->detach_for_migration();
+        // The emptied impl is destroyed here, on the shard that created it
+        _csi.reset();
+        return smp::submit_to(shard, [state = std::move(state), consumer = std::move(consumer)] () mutable {
+            consumer(connected_socket(state->attach()));
+        });
+    } catch (...) {
+        return current_exception_as_future();
+    }
+}
 
 void connected_socket::shutdown_output() {
     _csi->shutdown_output();
@@ -141,6 +257,27 @@ net::connected_socket_impl::source(connected_socket_input_stream_config csisc) {
     return source();
 }
 
+void
+net::connected_socket_impl::set_zerocopy_send(size_t threshold) {
+    // Default implementation ignores the hint and keeps copying
+}
+
+void
+net::connected_socket_impl::set_zerocopy_receive(size_t threshold) {
+    // Default implementation ignores the hint and keeps copying
+}
+
+void
+net::connected_socket_impl::set_notsent_lowat(size_t bytes) {
+    // Default implementation ignores the hint and keeps buffering freely
+}
+
+std::optional<net::tcp_connection_stats>
+net::connected_socket_impl::get_tcp_stats() const {
+    // Stats are an optional facility; stacks that track them override this
+    return std::nullopt;
+}
+
 socket::~socket()
 {}
 
@@ -164,6 +301,14 @@ bool socket::get_reuseaddr() const {
     return _si->get_reuseaddr();
 }
 
+void socket::set_fastopen_connect(bool enabled) {
+    _si->set_fastopen_connect(enabled);
+}
+
+void net::socket_impl::set_fastopen_connect(bool enabled) {
+    // Default implementation keeps the ordinary three-way handshake
+}
+
 void socket::shutdown() {
     _si->shutdown();
 }
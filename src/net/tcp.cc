@@ -59,6 +59,21 @@ void tcp_option::parse(uint8_t* beg1, uint8_t* end1) {
             _sack_received = true;
             beg += option_len::sack;
             break;
+        case option_kind::sack_block: {
+            // Variable length: 2 bytes of kind/len plus 8 bytes per block
+            uint8_t len = uint8_t(beg[1]);
+            if (len < 2) {
+                return;
+            }
+            _sack_blocks_received.clear();
+            for (uint8_t off = 2; off + 8 <= len; off += 8) {
+                auto start = read_be<uint32_t>(beg + off);
+                auto end = read_be<uint32_t>(beg + off + 4);
+                _sack_blocks_received.emplace_back(start, end);
+            }
+            beg += len;
+            break;
+        }
         case option_kind::nop:
             beg += option_len::nop;
             break;
@@ -99,6 +114,25 @@ uint8_t tcp_option::fill(void* h, const tcp_hdr* th, uint8_t options_size) {
             off += win_scale.len;
             size += win_scale.len;
         }
+        if (_sack_received || !ack_on) {
+            auto sack = tcp_option::sack();
+            sack.write(off);
+            off += sack.len;
+            size += sack.len;
+        }
+    } else if (_sack_received && !_sack_blocks_to_send.empty()) {
+        auto nr = std::min<size_t>(_sack_blocks_to_send.size(), max_sack_blocks);
+        uint8_t len = 2 + 8 * nr;
+        off[0] = char(option_kind::sack_block);
+        off[1] = char(len);
+        auto blk = off + 2;
+        for (size_t i = 0; i < nr; i++) {
+            write_be<uint32_t>(blk, _sack_blocks_to_send[i].first);
+            write_be<uint32_t>(blk + 4, _sack_blocks_to_send[i].second);
+            blk += 8;
+        }
+        off += len;
+        size += len;
     }
     if (size > 0) {
         // Insert NOP option
@@ -127,6 +161,11 @@ uint8_t tcp_option::get_size(bool syn_on, bool ack_on) {
         if (_win_scale_received || !ack_on) {
             size += option_len::win_scale;
         }
+        if (_sack_received || !ack_on) {
+            size += option_len::sack;
+        }
+    } else if (_sack_received && !_sack_blocks_to_send.empty()) {
+        size += 2 + 8 * std::min<size_t>(_sack_blocks_to_send.size(), max_sack_blocks);
     }
     if (size > 0) {
         size += option_len::eol;
@@ -136,6 +175,210 @@ uint8_t tcp_option::get_size(bool syn_on, bool ack_on) {
     return size;
 }
 
+void tcp_reno_controller::on_established(tcp_congestion_state s, uint32_t peer_window) {
+    // Initial congestion window per RFC5681
+    if (2190 < s.smss) {
+        s.cwnd = 2 * s.smss;
+    } else if (1095 < s.smss && s.smss <= 2190) {
+        s.cwnd = 3 * s.smss;
+    } else {
+        s.cwnd = 4 * s.smss;
+    }
+    s.ssthresh = peer_window;
+}
+
+void tcp_reno_controller::on_ack(tcp_congestion_state s, uint32_t acked_bytes) {
+    uint32_t smss = s.smss;
+    if (s.cwnd < s.ssthresh) {
+        // In slow start phase
+        s.cwnd += std::min(acked_bytes, smss);
+    } else {
+        // In congestion avoidance phase
+        uint32_t round_up = 1;
+        s.cwnd += std::max(round_up, smss * smss / s.cwnd);
+    }
+}
+
+void tcp_reno_controller::on_fast_retransmit(tcp_congestion_state s, uint32_t limited_transfer, bool entered) {
+    uint32_t smss = s.smss;
+    if (entered) {
+        // RFC5681 Step 3.2
+        s.ssthresh = std::max((s.flight_size - limited_transfer) / 2, 2 * smss);
+    }
+    // RFC5681 Step 3.3
+    s.cwnd = s.ssthresh + 3 * smss;
+}
+
+void tcp_reno_controller::on_dup_ack(tcp_congestion_state s) {
+    // RFC5681 Step 3.4
+    s.cwnd += s.smss;
+}
+
+void tcp_reno_controller::on_partial_ack(tcp_congestion_state s, uint32_t acked_bytes) {
+    s.cwnd -= acked_bytes;
+    // If the partial ACK acknowledges at least one SMSS of new data,
+    // then add back SMSS bytes to the congestion window
+    if (acked_bytes >= s.smss) {
+        s.cwnd += s.smss;
+    }
+}
+
+void tcp_reno_controller::on_full_ack(tcp_congestion_state s) {
+    uint32_t smss = s.smss;
+    s.cwnd = std::min(s.ssthresh, std::max(s.flight_size, smss) + smss);
+}
+
+void tcp_reno_controller::on_retransmit_timeout(tcp_congestion_state s, bool first_retransmit) {
+    uint32_t smss = s.smss;
+    // Update ssthresh only for the first retransmit
+    if (first_retransmit) {
+        s.ssthresh = std::max(s.flight_size / 2, 2 * smss);
+    }
+    // Start the slow start process
+    s.cwnd = smss;
+}
+
+uint64_t tcp_rate_based_controller::max_bw() const {
+    return *std::max_element(_bw.begin(), _bw.end());
+}
+
+void tcp_rate_based_controller::advance_phase(tcp_congestion_state s) {
+    switch (_phase) {
+    case phase::startup:
+        // Leave startup once the bandwidth estimate stops growing by at
+        // least 25% per sampling round for three consecutive rounds
+        if (max_bw() >= _full_bw + _full_bw / 4) {
+            _full_bw = max_bw();
+            _full_bw_count = 0;
+        } else if (++_full_bw_count >= 3) {
+            _phase = phase::drain;
+        }
+        break;
+    case phase::drain:
+        // The startup overshoot has been drained once the data in flight
+        // fits the estimated bandwidth-delay product
+        if (s.flight_size <= max_bw() * _min_rtt.count() / 1000) {
+            _phase = phase::probe;
+            _probe_slot = 0;
+        }
+        break;
+    case phase::probe:
+        _probe_slot = (_probe_slot + 1) % 8;
+        break;
+    }
+}
+
+void tcp_rate_based_controller::on_established(tcp_congestion_state s, uint32_t peer_window) {
+    s.cwnd = 4 * s.smss;
+    // ssthresh is unused by this controller; park it out of the way so
+    // nothing mistakes the connection for being in congestion avoidance
+    s.ssthresh = std::numeric_limits<uint32_t>::max();
+    _sample_start = lowres_clock::now();
+    _min_rtt_stamp = _sample_start;
+}
+
+void tcp_rate_based_controller::on_rtt_sample(tcp_congestion_state s, std::chrono::milliseconds rtt) {
+    auto now = lowres_clock::now();
+    // Windowed min filter; the estimate expires so a route change or
+    // persistent queue does not freeze an understated value forever
+    if (_min_rtt.count() == 0 || rtt < _min_rtt || now - _min_rtt_stamp > std::chrono::seconds(10)) {
+        _min_rtt = std::max(rtt, std::chrono::milliseconds(1));
+        _min_rtt_stamp = now;
+    }
+}
+
+void tcp_rate_based_controller::on_ack(tcp_congestion_state s, uint32_t acked_bytes) {
+    auto now = lowres_clock::now();
+    _delivered += acked_bytes;
+
+    if (_min_rtt.count() == 0) {
+        // No RTT measurement yet; grow like slow start, unpaced
+        s.cwnd += std::min<uint32_t>(acked_bytes, s.smss);
+        return;
+    }
+
+    // Close a delivery rate sample once a full min_rtt (but at least one
+    // lowres tick) has passed
+    auto interval = std::chrono::duration_cast<std::chrono::microseconds>(now - _sample_start);
+    if (interval >= std::max<std::chrono::microseconds>(_min_rtt, std::chrono::milliseconds(10))) {
+        _bw_slot = (_bw_slot + 1) % nr_bw_samples;
+        _bw[_bw_slot] = _delivered * 1000000 / interval.count();
+        _delivered = 0;
+        _sample_start = now;
+        advance_phase(s);
+    }
+
+    auto bw = max_bw();
+    if (bw == 0) {
+        s.cwnd += std::min<uint32_t>(acked_bytes, s.smss);
+        return;
+    }
+
+    // Pacing gain: probe hard in startup, drain the resulting queue,
+    // then cycle around 1.0 to track bandwidth changes
+    uint64_t num = 1, den = 1;
+    switch (_phase) {
+    case phase::startup:
+        num = 2885; den = 1000;
+        break;
+    case phase::drain:
+        num = 1000; den = 2885;
+        break;
+    case phase::probe:
+        if (_probe_slot == 0) {
+            num = 5; den = 4;
+        } else if (_probe_slot == 1) {
+            num = 3; den = 4;
+        }
+        break;
+    }
+    _pacing = bw * num / den;
+
+    // Cap the window at twice the estimated BDP; the pacing rate, not
+    // the window, is the primary control
+    uint64_t bdp = bw * _min_rtt.count() / 1000;
+    s.cwnd = std::max<uint64_t>(2 * bdp, 4 * s.smss);
+}
+
+void tcp_rate_based_controller::on_fast_retransmit(tcp_congestion_state s, uint32_t limited_transfer, bool entered) {
+    // Losses do not modulate the sending rate; the model does
+}
+
+void tcp_rate_based_controller::on_dup_ack(tcp_congestion_state s) {
+}
+
+void tcp_rate_based_controller::on_partial_ack(tcp_congestion_state s, uint32_t acked_bytes) {
+}
+
+void tcp_rate_based_controller::on_full_ack(tcp_congestion_state s) {
+}
+
+void tcp_rate_based_controller::on_retransmit_timeout(tcp_congestion_state s, bool first_retransmit) {
+    // An RTO means the model badly overestimated the path; restart it
+    _bw = {};
+    _delivered = 0;
+    _full_bw = 0;
+    _full_bw_count = 0;
+    _phase = phase::startup;
+    _pacing = 0;
+    _sample_start = lowres_clock::now();
+    s.cwnd = 4 * s.smss;
+}
+
+std::optional<uint64_t> tcp_rate_based_controller::pacing_rate() const {
+    return _pacing ? std::optional<uint64_t>(_pacing) : std::nullopt;
+}
+
+std::unique_ptr<tcp_congestion_controller> make_tcp_congestion_controller(tcp_congestion_algorithm algo) {
+    switch (algo) {
+    case tcp_congestion_algorithm::rate_based:
+        return std::make_unique<tcp_rate_based_controller>();
+    case tcp_congestion_algorithm::reno:
+    default:
+        return std::make_unique<tcp_reno_controller>();
+    }
+}
+
 ipv4_tcp::ipv4_tcp(ipv4& inet)
 	: _inet_l4(inet), _tcp(std::make_unique<tcp<ipv4_traits>>(_inet_l4)) {
 }
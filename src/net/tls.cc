@@ -23,6 +23,20 @@
 #include <gnutls/x509.h>
 #include <system_error>
 
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+// not exported by the uapi headers
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#define SEASTAR_HAVE_KTLS 1
+#endif
+
 #include <seastar/core/loop.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/seastar.hh>
@@ -32,6 +46,7 @@
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/timer.hh>
 #include <seastar/core/print.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/core/with_timeout.hh>
 #include <seastar/net/tls.hh>
 #include <seastar/net/stack.hh>
@@ -393,6 +408,20 @@ public:
     void set_dn_verification_callback(dn_callback cb) {
         _dn_callback = std::move(cb);
     }
+
+    void enable_kernel_tls() {
+        _kernel_tls = true;
+    }
+    bool get_kernel_tls() const {
+        return _kernel_tls;
+    }
+
+    void set_session_ticket_key(const blob& key) {
+        _session_ticket_key = sstring(key);
+    }
+    const sstring& get_session_ticket_key() const {
+        return _session_ticket_key;
+    }
 private:
     friend class credentials_builder;
     friend class session;
@@ -414,6 +443,8 @@ private:
     std::unique_ptr<std::remove_pointer_t<gnutls_priority_t>, void(*)(gnutls_priority_t)> _priority;
     client_auth _client_auth = client_auth::NONE;
     bool _load_system_trust = false;
+    bool _kernel_tls = false;
+    sstring _session_ticket_key;
     semaphore _system_trust_sem {1};
     dn_callback _dn_callback;
 };
@@ -450,6 +481,10 @@ void tls::certificate_credentials::set_simple_pkcs12(const blob& b,
     _impl->set_simple_pkcs12(b, fmt, password);
 }
 
+void tls::certificate_credentials::enable_kernel_tls() {
+    _impl->enable_kernel_tls();
+}
+
 future<> tls::abstract_credentials::set_x509_trust_file(
         const sstring& cafile, x509_crt_format fmt) {
     return read_fully(cafile, "trust file").then([this, fmt](temporary_buffer<char> buf) {
@@ -521,6 +556,7 @@ static const sstring x509_crl_key = "x509_crl";
 static const sstring x509_key_key = "x509_key";
 static const sstring pkcs12_key = "pkcs12";
 static const sstring system_trust = "system_trust";
+static const sstring session_ticket_key = "session_ticket_key";
 
 using buffer_type = std::basic_string<tls::blob::value_type, tls::blob::traits_type, std::allocator<tls::blob::value_type>>;
 
@@ -617,6 +653,15 @@ void tls::credentials_builder::set_priority_string(const sstring& prio) {
     _priority = prio;
 }
 
+void tls::credentials_builder::enable_session_tickets() {
+    gnutls_datum_t key;
+    gtls_chk(gnutls_session_ticket_key_generate(&key));
+    _blobs.erase(session_ticket_key);
+    _blobs.emplace(session_ticket_key, buffer_type(reinterpret_cast<char*>(key.data), key.size));
+    gnutls_memset(key.data, 0, key.size);
+    gnutls_free(key.data);
+}
+
 template<typename Blobs, typename Visitor>
 static void visit_blobs(Blobs& blobs, Visitor&& visitor) {
     auto visit = [&](const sstring& key, auto* vt) {
@@ -663,6 +708,10 @@ void tls::credentials_builder::apply_to(certificate_credentials& creds) const {
         creds.set_priority_string(_priority);
     }
 
+    if (auto i = _blobs.find(session_ticket_key); i != _blobs.end()) {
+        creds._impl->set_session_ticket_key(*boost::any_cast<buffer_type>(&i->second));
+    }
+
     creds._impl->set_client_auth(_client_auth);
 }
 
@@ -964,6 +1013,34 @@ namespace tls {
  * of these, since we handle handshake etc.
  *
  */
+// Per-shard handshake counters. Registered on first TLS activity on the
+// shard, so idle shards do not pollute the metrics.
+struct session_stats {
+    uint64_t handshakes = 0;
+    uint64_t resumptions = 0;
+    metrics::log_histogram<17 << 10, 2> record_size;
+    metrics::metric_groups _metrics;
+    session_stats() {
+        namespace sm = metrics;
+        _metrics.add_group("tls", {
+            sm::make_derive("handshakes", handshakes,
+                    sm::description("Total number of completed TLS handshakes")),
+            sm::make_derive("session_resumptions", resumptions,
+                    sm::description("Number of handshakes completed through session resumption "
+                                    "instead of a full key exchange")),
+            sm::make_histogram("record_size_bytes", [this] { return record_size.to_histogram(); },
+                    sm::description("Distribution of plaintext bytes per outgoing TLS record. "
+                                    "Each record costs ~30 bytes of framing plus an AEAD pass, "
+                                    "so a mass of small records indicates writes that defeat "
+                                    "record coalescing.")),
+        });
+    }
+    static session_stats& local() {
+        static thread_local session_stats stats;
+        return stats;
+    }
+};
+
 class session : public enable_lw_shared_from_this<session> {
 public:
     enum class type
@@ -1000,6 +1077,15 @@ public:
             }
         }
 
+        if (_type == type::SERVER && !_creds->get_session_ticket_key().empty()) {
+            // Stateless session resumption (RFC 5077). The ticket key comes
+            // from the credentials, so every shard built from the same
+            // builder can decrypt tickets issued by any other shard.
+            auto& k = _creds->get_session_ticket_key();
+            gnutls_datum_t key{reinterpret_cast<unsigned char*>(const_cast<char*>(k.data())), unsigned(k.size())};
+            gtls_chk(gnutls_session_ticket_enable_server(*this, &key));
+        }
+
         auto prio = _creds->get_priority();
         if (prio) {
             gtls_chk(gnutls_priority_set(*this, prio));
@@ -1009,6 +1095,15 @@ public:
         gnutls_transport_set_vec_push_function(*this, &vec_push_wrapper);
         gnutls_transport_set_pull_function(*this, &pull_wrapper);
 
+        _unput_timer.set_callback([this] {
+            // The latency bound on queued plaintext expired; frame it in
+            // the background. A failure is recorded in _error by the
+            // framing path and resurfaces on the next put() or flush().
+            (void)with_semaphore(_out_sem, 1,
+                    std::bind(&session::do_flush_unput, this)).handle_exception(
+                    [](std::exception_ptr) {}).finally([me = shared_from_this()] {});
+        });
+
         // This would be nice, because we preferably want verification to
         // abort hand shake so peer immediately knows we bailed...
 #if GNUTLS_VERSION_NUMBER >= 0x030406
@@ -1045,8 +1140,7 @@ public:
         if (_type == type::CLIENT && !_hostname.empty()) {
             gnutls_server_name_set(*this, GNUTLS_NAME_DNS, _hostname.data(), _hostname.size());
         }
-        try {
-            auto res = gnutls_handshake(*this);
+        return handshake_step().then([this](int res) {
             if (res < 0) {
                 switch (res) {
                 case GNUTLS_E_AGAIN:
@@ -1079,11 +1173,48 @@ public:
                 verify();
             }
             _connected = true;
+            auto& stats = session_stats::local();
+            ++stats.handshakes;
+            if (gnutls_session_is_resumed(*this)) {
+                ++stats.resumptions;
+            }
+            maybe_offload_tx();
             // make sure we reset output_pending
             return wait_for_output();
-        } catch (...) {
-            return make_exception_future<>(std::current_exception());
+        });
+    }
+    // A single gnutls_handshake() call. Server steps carry the expensive
+    // private-key operations, so they run on the syscall thread instead of
+    // stalling the shard for milliseconds; while a step is off-reactor our
+    // transport callbacks only touch plain session memory (pull() reads
+    // _input, vec_push() stages into _staged_output), which is safe since a
+    // handshaking session is exclusively owned (both semaphores held).
+    // Client steps stay on the reactor: the verification callback may run
+    // user code from inside the handshake.
+    future<int> handshake_step() {
+        if (_type != type::SERVER) {
+            try {
+                return make_ready_future<int>(gnutls_handshake(*this));
+            } catch (...) {
+                return make_exception_future<int>(std::current_exception());
+            }
         }
+        _off_reactor = true;
+        return engine().run_blocking([this] {
+            return gnutls_handshake(*this);
+        }).then_wrapped([this](future<int> f) {
+            _off_reactor = false;
+            if (!_staged_output.empty()) {
+                auto prev = std::exchange(_output_pending, make_ready_future<>());
+                _output_pending = prev.then([this, out = std::move(_staged_output)] {
+                    scattered_message<char> msg;
+                    msg.append(std::string_view(out.data(), out.size()));
+                    return _out.put(std::move(msg).release());
+                });
+                _staged_output = {};
+            }
+            return f;
+        });
     }
     future<> handshake() {
         // maybe load system certificates before handshake, in case we
@@ -1126,6 +1257,88 @@ public:
         });
     }
 
+#ifdef SEASTAR_HAVE_KTLS
+    template <typename CryptoInfo>
+    bool try_offload_tx(uint16_t version, uint16_t cipher_type,
+            const gnutls_datum_t& cipher_key, const gnutls_datum_t& iv, const unsigned char* seq) {
+        CryptoInfo info = {};
+        if (cipher_key.size != sizeof(info.key)) {
+            return false;
+        }
+        info.info.version = version;
+        info.info.cipher_type = cipher_type;
+        std::copy_n(cipher_key.data, sizeof(info.key), info.key);
+        std::copy_n(seq, sizeof(info.rec_seq), info.rec_seq);
+        if (version == TLS_1_2_VERSION) {
+            // TLS1.2 AES-GCM: gnutls exposes the 4-byte implicit salt;
+            // the explicit nonce is the record sequence number
+            if (iv.size != sizeof(info.salt)) {
+                return false;
+            }
+            std::copy_n(iv.data, sizeof(info.salt), info.salt);
+            std::copy_n(seq, sizeof(info.iv), info.iv);
+        } else {
+            // TLS1.3: the full 12-byte static IV; the kernel xors in
+            // the sequence number itself
+            if (iv.size != sizeof(info.salt) + sizeof(info.iv)) {
+                return false;
+            }
+            std::copy_n(iv.data, sizeof(info.salt), info.salt);
+            std::copy_n(iv.data + sizeof(info.salt), sizeof(info.iv), info.iv);
+        }
+        try {
+            _sock->set_sockopt(IPPROTO_TCP, TCP_ULP, "tls", 3);
+            _sock->set_sockopt(SOL_TLS, TLS_TX, &info, sizeof(info));
+        } catch (...) {
+            // no kernel support, or not a kernel socket at all
+            return false;
+        }
+        return true;
+    }
+#endif
+
+    // Push the established transmit state into the kernel, turning
+    // writes into plain (zero-copy capable) socket writes of plaintext.
+    // Best effort: on any failure the userspace record layer stays in
+    // charge.
+    void maybe_offload_tx() noexcept {
+#ifdef SEASTAR_HAVE_KTLS
+        if (_ktls_tx || !_creds->get_kernel_tls()) {
+            return;
+        }
+        uint16_t version;
+        switch (gnutls_protocol_get_version(*this)) {
+        case GNUTLS_TLS1_2:
+            version = TLS_1_2_VERSION;
+            break;
+#if defined(TLS_1_3_VERSION) && GNUTLS_VERSION_NUMBER >= 0x030600
+        case GNUTLS_TLS1_3:
+            version = TLS_1_3_VERSION;
+            break;
+#endif
+        default:
+            return;
+        }
+        gnutls_datum_t mac_key, iv, cipher_key;
+        unsigned char seq[8];
+        if (gnutls_record_get_state(*this, 0 /* write */, &mac_key, &iv, &cipher_key, seq) < 0) {
+            return;
+        }
+        switch (gnutls_cipher_get(*this)) {
+        case GNUTLS_CIPHER_AES_128_GCM:
+            _ktls_tx = try_offload_tx<tls12_crypto_info_aes_gcm_128>(version, TLS_CIPHER_AES_GCM_128, cipher_key, iv, seq);
+            break;
+#ifdef TLS_CIPHER_AES_GCM_256
+        case GNUTLS_CIPHER_AES_256_GCM:
+            _ktls_tx = try_offload_tx<tls12_crypto_info_aes_gcm_256>(version, TLS_CIPHER_AES_GCM_256, cipher_key, iv, seq);
+            break;
+#endif
+        default:
+            break;
+        }
+#endif
+    }
+
     static session * from_transport_ptr(gnutls_transport_ptr_t ptr) {
         return static_cast<session *>(ptr);
     }
@@ -1243,6 +1456,12 @@ public:
                     // Our input buffer should be empty now, so just go again
                     return do_get();
                 case GNUTLS_E_REHANDSHAKE:
+                    if (_ktls_tx) {
+                        // once the transmit state lives in the kernel we can no
+                        // longer emit handshake records; surface an error instead
+                        _error = std::make_exception_ptr(std::system_error(n, glts_errorc));
+                        return make_exception_future<temporary_buffer<char>>(_error);
+                    }
                     // server requests new HS. must release semaphore, so set new state
                     // and return nada.
                     _connected = false;
@@ -1282,6 +1501,8 @@ public:
                 auto res = gnutls_record_send(*this, ptr + off, size - off);
                 if (res > 0) { // don't really need to check, but...
                     off += res;
+                    // each successful send frames one record of res bytes
+                    session_stats::local().record_size.record(res);
                 }
                 // what will we wait for? error or results...
                 auto f = res < 0 ? handle_output_error(res) : wait_for_output();
@@ -1291,6 +1512,25 @@ public:
             });
         });
     }
+    // Frames all plaintext queued by put() into TLS records. Must be
+    // called with _out_sem held. Packets made of many small fragments are
+    // linearized first, so consecutive small writes share records instead
+    // of producing one undersized record each; large fragments are fed to
+    // gnutls as they are.
+    future<> do_flush_unput() {
+        _unput_timer.cancel();
+        if (!_unput.len()) {
+            return make_ready_future<>();
+        }
+        auto p = std::move(_unput);
+        _unput = net::packet();
+        if (p.nr_frags() > 1 && p.len() / p.nr_frags() < max_record_size / 4) {
+            p.linearize();
+        }
+        auto i = p.fragments().begin();
+        auto e = p.fragments().end();
+        return do_put(i, e).finally([p = std::move(p)] {});
+    }
     future<> put(net::packet p) {
         if (_error) {
             return make_exception_future<>(_error);
@@ -1303,9 +1543,31 @@ public:
                return put(std::move(p));
             });
         }
-        auto i = p.fragments().begin();
-        auto e = p.fragments().end();
-        return with_semaphore(_out_sem, 1, std::bind(&session::do_put, this, i, e)).finally([p = std::move(p)] {});
+        if (_ktls_tx) {
+            // the kernel frames and encrypts; hand the plaintext fragments
+            // straight to the socket, where they may go out zero-copy
+            return with_semaphore(_out_sem, 1, [this, p = std::move(p)]() mutable {
+                return wait_for_output().then([this, p = std::move(p)]() mutable {
+                    return _out.put(std::move(p)).handle_exception([this](auto ep) {
+                        _error = ep;
+                        return make_exception_future(ep);
+                    });
+                });
+            });
+        }
+        // Queue the plaintext rather than framing it here: back-to-back
+        // small puts then share records, paying the ~30 byte framing and
+        // the AEAD pass once per record instead of once per put. A full
+        // record's worth is framed immediately; anything less waits for
+        // the caller's flush() or, failing that, the latency-bound timer.
+        _unput.append(std::move(p));
+        if (_unput.len() < max_record_size) {
+            if (!_unput_timer.armed()) {
+                _unput_timer.arm(record_coalesce_latency);
+            }
+            return make_ready_future<>();
+        }
+        return with_semaphore(_out_sem, 1, std::bind(&session::do_flush_unput, this));
     }
 
     ssize_t pull(void* dst, size_t len) {
@@ -1324,6 +1586,22 @@ public:
         return n;
     }
     ssize_t vec_push(const giovec_t * iov, int iovcnt) {
+        if (_off_reactor) {
+            // handshake step running on the syscall thread: stage the
+            // records; the reactor flushes them when the step completes
+            try {
+                size_t n = 0;
+                for (int i = 0; i < iovcnt; ++i) {
+                    auto p = reinterpret_cast<const char *>(iov[i].iov_base);
+                    _staged_output.insert(_staged_output.end(), p, p + iov[i].iov_len);
+                    n += iov[i].iov_len;
+                }
+                return n;
+            } catch (...) {
+                gnutls_transport_set_errno(*this, EIO);
+                return -1;
+            }
+        }
         if (!_output_pending.available()) {
             gnutls_transport_set_errno(*this, EAGAIN);
             return -1;
@@ -1373,6 +1651,18 @@ public:
         if (_error || !_connected) {
             return make_ready_future();
         }
+        if (_unput.len()) {
+            // frame whatever put() queued before the close_notify alert
+            return do_flush_unput().then([this] {
+                return do_shutdown();
+            });
+        }
+        if (_ktls_tx) {
+            // gnutls would push the close_notify alert through the offloaded
+            // socket, where the kernel would frame it as application data.
+            // Let the TCP stream termination end the session instead.
+            return wait_for_output();
+        }
         auto res = gnutls_bye(*this, GNUTLS_SHUT_WR);
         if (res < 0) {
             switch (res) {
@@ -1452,7 +1742,9 @@ public:
     // helper for sink
     future<> flush() noexcept {
         return with_semaphore(_out_sem, 1, [this] {
-            return _out.flush();
+            return do_flush_unput().then([this] {
+                return _out.flush();
+            });
         });
     }
 
@@ -1475,6 +1767,20 @@ private:
     bool _eof = false;
     bool _shutdown = false;
     bool _connected = false;
+    bool _ktls_tx = false;
+    bool _off_reactor = false;
+    std::vector<char> _staged_output;
+    // A TLS record carries at most this much plaintext (RFC 5246 6.2.1);
+    // queued plaintext is framed eagerly once a record can be filled.
+    static constexpr size_t max_record_size = 16 * 1024;
+    // Upper bound on how long plaintext queued by put() may wait for
+    // company, if the caller does not flush.
+    static constexpr std::chrono::milliseconds record_coalesce_latency{1};
+    // Plaintext queued by put() awaiting coalescing into records; framed
+    // by flush(), by put() itself once a full record accumulates, or by
+    // the latency-bound timer.
+    net::packet _unput;
+    timer<> _unput_timer;
     std::exception_ptr _error;
 
     future<> _output_pending;
@@ -66,6 +66,10 @@ public:
     virtual packet& get_data() override {
         return _p;
     }
+
+    virtual std::optional<std::chrono::steady_clock::time_point> rx_timestamp() override {
+        return _p.offload_info().rx_timestamp;
+    }
 };
 
 class native_channel : public udp_channel_impl {
@@ -98,6 +102,24 @@ public:
         return _state->_queue.pop_eventually();
     }
 
+    virtual future<std::vector<udp_datagram>> receive_batch(size_t max) override {
+        return _state->_queue.pop_eventually().then([this, max] (udp_datagram d) {
+            // Everything queued by the current device poll is delivered in
+            // this one wakeup instead of one consumer task per datagram
+            std::vector<udp_datagram> batch;
+            batch.reserve(std::min(max, _state->_queue.size() + 1));
+            batch.push_back(std::move(d));
+            while (batch.size() < max && !_state->_queue.empty()) {
+                batch.push_back(_state->_queue.pop());
+            }
+            return batch;
+        });
+    }
+
+    virtual void set_rx_redistribution(bool enable) override {
+        _state->_rx_redistribute = enable;
+    }
+
     virtual future<> send(const socket_address& dst, const char* msg) override {
         return send(dst, packet::from_static_data(msg, strlen(msg)));
     }
@@ -152,6 +174,15 @@ bool ipv4_udp::forward(forward_hash& out_hash_data, packet& p, size_t off)
     auto uh = p.get_header<udp_hdr>(off);
 
     if (uh) {
+        auto chan_it = _channels.find(ntoh(uh->dst_port));
+        if (chan_it != _channels.end() && chan_it->second->_rx_redistribute) {
+            // Software re-distribution for a hot single-port channel:
+            // hash a rotating counter instead of the flow, so consecutive
+            // datagrams spread over all shards. The resulting hash is
+            // stored in the packet, so the receiving shard keeps it.
+            out_hash_data.push_back(_spray_counter++);
+            return true;
+        }
         out_hash_data.push_back(uh->src_port);
         out_hash_data.push_back(uh->dst_port);
     }
@@ -165,6 +196,7 @@ void ipv4_udp::received(packet p, ipv4_address from, ipv4_address to)
     auto chan_it = _channels.find(dgram.get_dst_port());
     if (chan_it != _channels.end()) {
         auto chan = chan_it->second;
+        record_rx_delivery(dgram.get_data());
         chan->_queue.push(std::move(dgram));
     }
 }
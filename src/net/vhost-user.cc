@@ -0,0 +1,530 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#include <seastar/net/vhost-user.hh>
+#include <seastar/net/net.hh>
+#include <seastar/net/virtio-interface.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/posix.hh>
+#include <seastar/core/align.hh>
+
+#include <linux/vhost.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <cstring>
+
+namespace seastar {
+
+namespace net {
+
+namespace vhost_user {
+
+// A frame carries a virtio-net header plus one whole packet; 2048 keeps
+// two frames per page, like the other userspace backends.
+static constexpr size_t frame_size = 2048;
+
+// vhost-user protocol constants. The protocol is not exported by any
+// kernel header; these follow the specification in the QEMU tree
+// (docs/interop/vhost-user).
+enum class vhost_user_request : uint32_t {
+    get_features = 1,
+    set_features = 2,
+    set_owner = 3,
+    set_mem_table = 5,
+    set_vring_num = 8,
+    set_vring_addr = 9,
+    set_vring_base = 10,
+    set_vring_kick = 12,
+    set_vring_call = 13,
+    get_protocol_features = 15,
+    set_protocol_features = 16,
+    set_vring_enable = 18,
+};
+
+static constexpr uint32_t vhost_user_version = 0x1;
+static constexpr uint32_t vhost_user_flag_reply = 0x4;
+
+// The backend will not process rings before SET_VRING_ENABLE when this
+// feature is negotiated (and OVS-DPDK/VPP always offer it).
+static constexpr uint64_t vhost_user_f_protocol_features = 1ULL << 30;
+
+struct vhost_user_msg_hdr {
+    uint32_t request;
+    uint32_t flags;
+    uint32_t size;
+};
+
+struct vhost_user_mem_region {
+    uint64_t guest_phys_addr;
+    uint64_t memory_size;
+    uint64_t userspace_addr;
+    uint64_t mmap_offset;
+};
+
+struct vhost_user_memory {
+    uint32_t nregions;
+    uint32_t padding;
+    vhost_user_mem_region regions[8];
+};
+
+// The classic split virtqueue layout, shared with the backend. Producer
+// and consumer indices are accessed with the same acquire/release
+// discipline the in-kernel vhost path uses.
+struct vring_desc_t {
+    uint64_t addr;
+    uint32_t len;
+    uint16_t flags;
+    uint16_t next;
+};
+
+struct vring_avail_t {
+    uint16_t flags;
+    uint16_t idx;
+    uint16_t ring[];
+};
+
+struct vring_used_elem_t {
+    uint32_t id;
+    uint32_t len;
+};
+
+struct vring_used_t {
+    uint16_t flags;
+    uint16_t idx;
+    vring_used_elem_t ring[];
+};
+
+// The driver side of one split virtqueue carved out of the shared
+// region. Descriptors carry whole frames, one per packet, so chains are
+// not needed and a used element always returns exactly one frame.
+class shared_vring {
+    unsigned _size;
+    vring_desc_t* _descs;
+    vring_avail_t* _avail;
+    vring_used_t* _used;
+    uint16_t _avail_idx = 0;
+    uint16_t _used_tail = 0;
+public:
+    shared_vring(char* mem, unsigned size)
+        : _size(size)
+        , _descs(reinterpret_cast<vring_desc_t*>(mem))
+        , _avail(reinterpret_cast<vring_avail_t*>(mem + desc_bytes(size)))
+        , _used(reinterpret_cast<vring_used_t*>(mem + desc_bytes(size) + align_up(avail_bytes(size), size_t(4096)))) {
+    }
+    static size_t desc_bytes(unsigned size) { return sizeof(vring_desc_t) * size; }
+    static size_t avail_bytes(unsigned size) { return sizeof(vring_avail_t) + sizeof(uint16_t) * size; }
+    static size_t used_bytes(unsigned size) { return sizeof(vring_used_t) + sizeof(vring_used_elem_t) * size; }
+    // Total shared memory needed for one ring of this many descriptors
+    static size_t storage_bytes(unsigned size) {
+        return desc_bytes(size) + align_up(avail_bytes(size), size_t(4096)) + align_up(used_bytes(size), size_t(4096));
+    }
+    unsigned size() const { return _size; }
+    char* descs() const { return reinterpret_cast<char*>(_descs); }
+    char* avail() const { return reinterpret_cast<char*>(_avail); }
+    char* used() const { return reinterpret_cast<char*>(_used); }
+    // Posts descriptor slot idx (desc index == ring slot; every frame
+    // owns the descriptor with its own index)
+    void post(uint16_t desc_idx, uint64_t addr, uint32_t len, bool writeable) {
+        auto& d = _descs[desc_idx];
+        d.addr = addr;
+        d.len = len;
+        d.flags = writeable ? VRING_DESC_F_WRITE : 0;
+        d.next = 0;
+        _avail->ring[_avail_idx & (_size - 1)] = desc_idx;
+        _avail_idx++;
+    }
+    void publish() {
+        __atomic_store_n(&_avail->idx, _avail_idx, __ATOMIC_RELEASE);
+    }
+    // Consumes one used element, if any
+    std::optional<vring_used_elem_t> get_used() {
+        auto used_idx = __atomic_load_n(&_used->idx, __ATOMIC_ACQUIRE);
+        if (_used_tail == used_idx) {
+            return std::nullopt;
+        }
+        return _used->ring[_used_tail++ & (_size - 1)];
+    }
+    bool kick_suppressed() const {
+        return (__atomic_load_n(&_used->flags, __ATOMIC_RELAXED) & VRING_USED_F_NO_NOTIFY) != 0;
+    }
+};
+
+// Synchronous vhost-user control channel. All traffic happens during
+// queue construction, before the reactor starts handling packets, so
+// blocking send/recv on the unix socket is fine here.
+class control_channel {
+    file_desc _fd;
+public:
+    explicit control_channel(const std::string& path)
+        : _fd(file_desc::socket(AF_UNIX, SOCK_STREAM, 0)) {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            throw std::invalid_argument("vhost-user socket path too long");
+        }
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        auto r = ::connect(_fd.get(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        throw_system_error_on(r == -1, "connect(vhost-user)");
+    }
+    void send(vhost_user_request request, const void* payload, uint32_t size, int fd_to_pass = -1) {
+        vhost_user_msg_hdr hdr = { uint32_t(request), vhost_user_version, size };
+        iovec iov[2] = {
+            { &hdr, sizeof(hdr) },
+            { const_cast<void*>(payload), size },
+        };
+        msghdr msg = {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = size ? 2 : 1;
+        char cmsg_buf[CMSG_SPACE(sizeof(int))] = {};
+        if (fd_to_pass >= 0) {
+            msg.msg_control = cmsg_buf;
+            msg.msg_controllen = sizeof(cmsg_buf);
+            auto cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_RIGHTS;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+            std::memcpy(CMSG_DATA(cmsg), &fd_to_pass, sizeof(int));
+        }
+        auto r = ::sendmsg(_fd.get(), &msg, 0);
+        throw_system_error_on(r == -1, "sendmsg(vhost-user)");
+    }
+    uint64_t request_u64(vhost_user_request request) {
+        send(request, nullptr, 0);
+        vhost_user_msg_hdr hdr;
+        uint64_t value;
+        iovec iov[2] = {
+            { &hdr, sizeof(hdr) },
+            { &value, sizeof(value) },
+        };
+        msghdr msg = {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = 2;
+        auto r = ::recvmsg(_fd.get(), &msg, MSG_WAITALL);
+        throw_system_error_on(r == -1, "recvmsg(vhost-user)");
+        if (size_t(r) < sizeof(hdr) + sizeof(value) || !(hdr.flags & vhost_user_flag_reply)) {
+            throw std::runtime_error("short or malformed vhost-user reply");
+        }
+        return value;
+    }
+    void send_u64(vhost_user_request request, uint64_t value) {
+        send(request, &value, sizeof(value));
+    }
+    void send_state(vhost_user_request request, uint32_t index, uint32_t num) {
+        uint32_t payload[2] = { index, num };
+        send(request, payload, sizeof(payload));
+    }
+};
+
+class vhost_user_device;
+
+class vhost_user_qp : public net::qp {
+    vhost_user_device* _dev;
+    control_channel _chan;
+    size_t _header_len;
+    size_t _mem_size;
+    char* _mem = nullptr;
+    file_desc _mem_fd;
+    std::unique_ptr<shared_vring> _rxq;
+    std::unique_ptr<shared_vring> _txq;
+    char* _rx_frames;
+    char* _tx_frames;
+    // Free frame indices; a frame's index doubles as its descriptor
+    // index in the respective ring
+    std::vector<uint16_t> _free_rx_frames;
+    std::vector<uint16_t> _free_tx_frames;
+    writeable_eventfd _rx_kick;
+    writeable_eventfd _tx_kick;
+    std::optional<reactor::poller> _rx_poller;
+    reactor::poller _tx_gc_poller;
+private:
+    uint64_t negotiate_features();
+    void register_memory();
+    void setup_vring(shared_vring& ring, uint32_t index, writeable_eventfd& kick, bool enable);
+    void refill_rx_ring();
+    bool poll_rx_once();
+    bool reap_tx_completions();
+public:
+    vhost_user_qp(vhost_user_device* dev, const std::string& path, unsigned ring_size);
+    ~vhost_user_qp();
+    virtual future<> send(packet p) override {
+        abort();
+    }
+    virtual uint32_t send(circular_buffer<packet>& pq) override;
+    virtual void rx_start() override;
+};
+
+class vhost_user_device : public net::device {
+    std::string _path;
+    unsigned _ring_size;
+    ethernet_address _hw_address;
+    net::hw_features _hw_features;
+public:
+    explicit vhost_user_device(boost::program_options::variables_map opts)
+        : _path(opts["vhost-user-socket"].as<std::string>())
+        , _ring_size(opts["vhost-user-ring-size"].as<unsigned>()) {
+        // The backend bridges us into a switch; use a locally
+        // administered address derived from the socket path so several
+        // instances on one host don't collide
+        size_t h = std::hash<std::string>()(_path);
+        _hw_address = { 0x02, 0x56, uint8_t(h >> 24), uint8_t(h >> 16), uint8_t(h >> 8), uint8_t(h) };
+        // No offloads: frames cross the rings exactly as on the wire
+        _hw_features.mtu = 1500;
+        _hw_features.max_packet_len = frame_size - sizeof(uint64_t) * 2;
+    }
+    virtual ethernet_address hw_address() override {
+        return _hw_address;
+    }
+    virtual net::hw_features hw_features() override {
+        return _hw_features;
+    }
+    virtual std::unique_ptr<net::qp> init_local_queue(boost::program_options::variables_map opts, uint16_t qid) override {
+        assert(!qid);
+        return std::make_unique<vhost_user_qp>(this, _path, _ring_size);
+    }
+};
+
+static file_desc
+make_memfd(size_t size) {
+    int fd = ::memfd_create("vhost-user", MFD_CLOEXEC);
+    throw_system_error_on(fd == -1, "memfd_create");
+    auto desc = file_desc::from_fd(fd);
+    desc.truncate(size);
+    return desc;
+}
+
+vhost_user_qp::vhost_user_qp(vhost_user_device* dev, const std::string& path, unsigned ring_size)
+    : qp(true, "vhost-user", 0)
+    , _dev(dev)
+    , _chan(path)
+    // One shared region holds both rings and all frames. Rings first,
+    // then the rx and tx frame pools.
+    , _mem_size(2 * shared_vring::storage_bytes(ring_size) + 2 * ring_size * frame_size)
+    , _mem_fd(make_memfd(_mem_size))
+    , _tx_gc_poller(reactor::poller::simple([this] { return reap_tx_completions(); })) {
+    auto features = negotiate_features();
+    // With VIRTIO_F_VERSION_1 the virtio-net header is the 12-byte
+    // (mergeable) layout even though we do not negotiate MRG_RXBUF
+    _header_len = (features & VIRTIO_F_VERSION_1) ? 12 : 10;
+
+    auto ring_bytes = shared_vring::storage_bytes(ring_size);
+    auto m = ::mmap(nullptr, _mem_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _mem_fd.get(), 0);
+    throw_system_error_on(m == MAP_FAILED, "mmap(memfd)");
+    _mem = reinterpret_cast<char*>(m);
+    std::memset(_mem, 0, _mem_size);
+    _rxq = std::make_unique<shared_vring>(_mem, ring_size);
+    _txq = std::make_unique<shared_vring>(_mem + ring_bytes, ring_size);
+    _rx_frames = _mem + 2 * ring_bytes;
+    _tx_frames = _rx_frames + ring_size * frame_size;
+    for (unsigned i = 0; i < ring_size; i++) {
+        _free_rx_frames.push_back(ring_size - 1 - i);
+        _free_tx_frames.push_back(ring_size - 1 - i);
+    }
+
+    register_memory();
+    bool enable = features & vhost_user_f_protocol_features;
+    setup_vring(*_rxq, 0, _rx_kick, enable);
+    setup_vring(*_txq, 1, _tx_kick, enable);
+    refill_rx_ring();
+}
+
+vhost_user_qp::~vhost_user_qp() {
+    if (_mem) {
+        ::munmap(_mem, _mem_size);
+    }
+}
+
+uint64_t
+vhost_user_qp::negotiate_features() {
+    auto offered = _chan.request_u64(vhost_user_request::get_features);
+    // We only need the base split-ring behavior; take the protocol
+    // feature gate (required to enable rings on DPDK/VPP backends) and
+    // the v1 framing when present
+    auto wanted = offered & (vhost_user_f_protocol_features | VIRTIO_F_VERSION_1);
+    if (wanted & vhost_user_f_protocol_features) {
+        _chan.request_u64(vhost_user_request::get_protocol_features);
+        _chan.send_u64(vhost_user_request::set_protocol_features, 0);
+    }
+    _chan.send_u64(vhost_user_request::set_features, wanted);
+    _chan.send(vhost_user_request::set_owner, nullptr, 0);
+    return wanted;
+}
+
+void
+vhost_user_qp::register_memory() {
+    // A single region covering rings and frames; we use our own virtual
+    // addresses as the "guest physical" address space, so descriptor
+    // addresses need no translation on our side
+    vhost_user_memory mem = {};
+    mem.nregions = 1;
+    mem.regions[0].guest_phys_addr = reinterpret_cast<uintptr_t>(_mem);
+    mem.regions[0].memory_size = _mem_size;
+    mem.regions[0].userspace_addr = reinterpret_cast<uintptr_t>(_mem);
+    mem.regions[0].mmap_offset = 0;
+    auto size = sizeof(vhost_user_memory) - sizeof(mem.regions) + sizeof(vhost_user_mem_region);
+    _chan.send(vhost_user_request::set_mem_table, &mem, size, _mem_fd.get());
+}
+
+void
+vhost_user_qp::setup_vring(shared_vring& ring, uint32_t index, writeable_eventfd& kick, bool enable) {
+    _chan.send_state(vhost_user_request::set_vring_num, index, ring.size());
+    _chan.send_state(vhost_user_request::set_vring_base, index, 0);
+    vhost_vring_addr addr = {};
+    addr.index = index;
+    addr.desc_user_addr = reinterpret_cast<uintptr_t>(ring.descs());
+    addr.avail_user_addr = reinterpret_cast<uintptr_t>(ring.avail());
+    addr.used_user_addr = reinterpret_cast<uintptr_t>(ring.used());
+    _chan.send(vhost_user_request::set_vring_addr, &addr, sizeof(addr));
+    // We poll the used rings, so the call eventfd is never read; it
+    // still has to be valid for the backend's sake
+    readable_eventfd call;
+    uint64_t kick_idx = index;
+    _chan.send(vhost_user_request::set_vring_kick, &kick_idx, sizeof(kick_idx), kick.get_read_fd());
+    uint64_t call_idx = index;
+    _chan.send(vhost_user_request::set_vring_call, &call_idx, sizeof(call_idx), call.get_write_fd());
+    if (enable) {
+        _chan.send_state(vhost_user_request::set_vring_enable, index, 1);
+    }
+}
+
+void
+vhost_user_qp::refill_rx_ring() {
+    if (_free_rx_frames.empty()) {
+        return;
+    }
+    while (!_free_rx_frames.empty()) {
+        auto idx = _free_rx_frames.back();
+        _free_rx_frames.pop_back();
+        _rxq->post(idx, reinterpret_cast<uintptr_t>(_rx_frames + idx * frame_size), frame_size, true);
+    }
+    _rxq->publish();
+    if (!_rxq->kick_suppressed()) {
+        _rx_kick.signal(1);
+    }
+}
+
+bool
+vhost_user_qp::poll_rx_once() {
+    uint64_t count = 0, bytes = 0;
+    while (auto ue = _rxq->get_used()) {
+        auto idx = uint16_t(ue->id);
+        auto frame = _rx_frames + idx * frame_size;
+        auto len = ue->len;
+        if (len <= _header_len) {
+            _free_rx_frames.push_back(idx);
+            continue;
+        }
+        len -= _header_len;
+        // The frame is handed to the stack in place; the deleter
+        // recycles it into the rx pool once the data is consumed, so
+        // receive never copies
+        fragment f{frame + _header_len, len};
+        packet p(f, make_deleter([this, idx] { _free_rx_frames.push_back(idx); }));
+        count++;
+        bytes += len;
+        _dev->l2receive(std::move(p));
+    }
+    if (count) {
+        _stats.rx.good.update_pkts_bunch(count);
+        _stats.rx.good.update_frags_stats(count, bytes);
+    }
+    refill_rx_ring();
+    return count;
+}
+
+bool
+vhost_user_qp::reap_tx_completions() {
+    uint64_t count = 0;
+    while (auto ue = _txq->get_used()) {
+        _free_tx_frames.push_back(uint16_t(ue->id));
+        count++;
+    }
+    return count;
+}
+
+uint32_t
+vhost_user_qp::send(circular_buffer<packet>& pq) {
+    reap_tx_completions();
+    uint32_t sent = 0;
+    uint64_t nr_frags = 0, bytes = 0;
+    while (!pq.empty() && !_free_tx_frames.empty()) {
+        packet& p = pq.front();
+        if (p.len() + _header_len > frame_size) {
+            // Cannot happen with hw_features().max_packet_len in effect
+            pq.pop_front();
+            continue;
+        }
+        auto idx = _free_tx_frames.back();
+        _free_tx_frames.pop_back();
+        // The frame pool is the memory the backend sees, so transmission
+        // is a single gathering copy of the fragments into the frame
+        auto frame = _tx_frames + idx * frame_size;
+        std::memset(frame, 0, _header_len); // no offloads requested
+        auto dst = frame + _header_len;
+        for (auto& f : p.fragments()) {
+            dst = std::copy_n(f.base, f.size, dst);
+        }
+        _txq->post(idx, reinterpret_cast<uintptr_t>(frame), _header_len + p.len(), false);
+        nr_frags += p.nr_frags();
+        bytes += p.len();
+        pq.pop_front();
+        sent++;
+    }
+    if (sent) {
+        _txq->publish();
+        if (!_txq->kick_suppressed()) {
+            _tx_kick.signal(1);
+        }
+        _stats.tx.good.update_pkts_bunch(sent);
+        _stats.tx.good.update_frags_stats(nr_frags, bytes);
+    }
+    return sent;
+}
+
+void
+vhost_user_qp::rx_start() {
+    _rx_poller = reactor::poller::simple([this] { return poll_rx_once(); });
+}
+
+}
+
+}
+
+boost::program_options::options_description
+get_vhost_user_net_options_description() {
+    boost::program_options::options_description opts(
+            "vhost-user net options");
+    opts.add_options()
+        ("vhost-user-socket",
+                boost::program_options::value<std::string>(),
+                "Connect to the vhost-user backend listening on this unix socket")
+        ("vhost-user-ring-size",
+                boost::program_options::value<unsigned>()->default_value(256),
+                "vhost-user ring size (must be power-of-two)")
+        ;
+    return opts;
+}
+
+std::unique_ptr<net::device> create_vhost_user_net_device(boost::program_options::variables_map opts) {
+    return std::make_unique<net::vhost_user::vhost_user_device>(opts);
+}
+
+}
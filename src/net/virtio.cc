@@ -75,11 +75,15 @@ private:
 
 private:
     uint64_t setup_features() {
-        int64_t seastar_supported_features = VIRTIO_RING_F_INDIRECT_DESC | VIRTIO_NET_F_MRG_RXBUF;
+        uint64_t seastar_supported_features = VIRTIO_RING_F_INDIRECT_DESC | VIRTIO_NET_F_MRG_RXBUF;
 
         if (!(_opts.count("event-index") && _opts["event-index"].as<std::string>() == "off")) {
             seastar_supported_features |= VIRTIO_RING_F_EVENT_IDX;
         }
+        if (_opts.count("packed-ring") && _opts["packed-ring"].as<std::string>() == "on") {
+            // Packed rings require the non-legacy framing.
+            seastar_supported_features |= VIRTIO_F_VERSION_1 | VIRTIO_F_RING_PACKED;
+        }
         if (!(_opts.count("csum-offload") && _opts["csum-offload"].as<std::string>() == "off")) {
             seastar_supported_features |= VIRTIO_NET_F_CSUM | VIRTIO_NET_F_GUEST_CSUM;
             _hw_features.tx_csum_l4_offload = true;
@@ -183,12 +187,15 @@ public:
 
 struct ring_config {
     char* descs;
+    // With a packed ring, the driver and device event suppression areas,
+    // respectively.
     char* avail;
     char* used;
     unsigned size;
     bool event_index;
     bool indirect;
     bool mergable_buffers;
+    bool packed;
 };
 
 struct buffer {
@@ -277,6 +284,23 @@ private:
         //std::atomic<uint16_t> avail_event;
     };
 
+    // Packed-ring (VIRTIO_F_RING_PACKED) layout: a single ring of these,
+    // written in place by both sides. Ownership is flagged by the AVAIL and
+    // USED bits against the respective side's wrap counter, so processing a
+    // descriptor touches one cache line instead of three rings.
+    struct packed_desc {
+        phys _paddr;
+        uint32_t _len;
+        uint16_t _id;
+        std::atomic<uint16_t> _flags;
+    };
+
+    // Packed-ring event suppression area, one per direction.
+    struct packed_event {
+        std::atomic<uint16_t> _off_wrap;
+        std::atomic<uint16_t> _flags;
+    };
+
     struct avail {
         explicit avail(ring_config conf);
         avail_layout* _shared;
@@ -301,6 +325,18 @@ private:
     semaphore _available_descriptors = { 0 };
     int _free_head = -1;
     int _free_last = -1;
+    // Packed-ring state. Descriptors are written at consecutive ring
+    // positions; a chain is named by a buffer id (the _buffer_chains slot),
+    // which the device hands back in its used descriptor.
+    packed_desc* _packed_descs;
+    packed_event* _driver_event;
+    packed_event* _device_event;
+    uint16_t _packed_avail_idx = 0;
+    bool _avail_wrap = true;
+    uint16_t _packed_used_idx = 0;
+    bool _used_wrap = true;
+    std::vector<uint16_t> _free_ids;
+    std::unique_ptr<uint16_t[]> _chain_nr_descs;
     reactor::poller _poller;
 public:
 
@@ -352,6 +388,13 @@ private:
     }
 
     bool do_complete();
+    bool do_complete_split();
+    bool do_complete_packed();
+    template <typename Iterator>
+    void post_split(Iterator begin, Iterator end);
+    template <typename Iterator>
+    void post_packed(Iterator begin, Iterator end);
+    void kick_packed();
     size_t mask() { return size() - 1; }
     size_t masked(size_t idx) { return idx & mask(); }
     size_t available();
@@ -393,6 +436,9 @@ vring<BufferChain, Completion>::vring(ring_config conf, Completion complete)
     , _used(conf)
     , _avail_event(reinterpret_cast<std::atomic<uint16_t>*>(&_used._shared->_used_elements[conf.size]))
     , _used_event(reinterpret_cast<std::atomic<uint16_t>*>(&_avail._shared->_ring[conf.size]))
+    , _packed_descs(reinterpret_cast<packed_desc*>(conf.descs))
+    , _driver_event(reinterpret_cast<packed_event*>(conf.avail))
+    , _device_event(reinterpret_cast<packed_event*>(conf.used))
     , _poller(reactor::poller::simple([this] {
         return do_complete();
     }))
@@ -402,6 +448,16 @@ vring<BufferChain, Completion>::vring(ring_config conf, Completion complete)
 
 template <typename BufferChain, typename Completion>
 void vring<BufferChain, Completion>::setup() {
+    if (_config.packed) {
+        _free_ids.reserve(_config.size);
+        for (unsigned i = 0; i < _config.size; ++i) {
+            _free_ids.push_back(_config.size - 1 - i);
+        }
+        _chain_nr_descs = std::make_unique<uint16_t[]>(_config.size);
+        _driver_event->_flags.store(VRING_PACKED_EVENT_FLAG_ENABLE, std::memory_order_relaxed);
+        _available_descriptors.signal(_config.size);
+        return;
+    }
     for (unsigned i = 0; i < _config.size; ++i) {
         _descs[i]._next = i + 1;
     }
@@ -414,6 +470,15 @@ void vring<BufferChain, Completion>::setup() {
 template <typename BufferChain, typename Completion>
 template <typename Iterator>
 void vring<BufferChain, Completion>::post(Iterator begin, Iterator end) {
+    if (_config.packed) {
+        return post_packed(std::move(begin), std::move(end));
+    }
+    return post_split(std::move(begin), std::move(end));
+}
+
+template <typename BufferChain, typename Completion>
+template <typename Iterator>
+void vring<BufferChain, Completion>::post_split(Iterator begin, Iterator end) {
     for (auto bci = begin; bci!= end; ++bci) {
         auto&& bc = *bci;
         desc pseudo_head = {};
@@ -439,8 +504,113 @@ void vring<BufferChain, Completion>::post(Iterator begin, Iterator end) {
     kick();
 }
 
+template <typename BufferChain, typename Completion>
+template <typename Iterator>
+void vring<BufferChain, Completion>::post_packed(Iterator begin, Iterator end) {
+    for (auto bci = begin; bci != end; ++bci) {
+        auto&& bc = *bci;
+        auto id = _free_ids.back();
+        _free_ids.pop_back();
+        // The descriptor at the chain head hands the whole chain to the
+        // device, so its flags are written last, after everything else is
+        // visible.
+        auto first = &_packed_descs[_packed_avail_idx];
+        uint16_t first_flags = 0;
+        packed_desc* prev = nullptr;
+        uint16_t prev_flags = 0;
+        uint16_t nr = 0;
+        for (auto i = bc.begin(); i != bc.end(); ++i, ++nr) {
+            auto&& b = *i;
+            auto& d = _packed_descs[_packed_avail_idx];
+            bool wrap = _avail_wrap;
+            if (++_packed_avail_idx == _config.size) {
+                _packed_avail_idx = 0;
+                _avail_wrap = !_avail_wrap;
+            }
+            if (prev) {
+                prev_flags |= VRING_DESC_F_NEXT;
+                if (prev == first) {
+                    first_flags = prev_flags;
+                } else {
+                    prev->_flags.store(prev_flags, std::memory_order_relaxed);
+                }
+            }
+            d._paddr = b.addr;
+            d._len = b.len;
+            d._id = id;
+            prev_flags = (b.writeable ? VRING_DESC_F_WRITE : 0)
+                    | (wrap ? VRING_PACKED_DESC_F_AVAIL : VRING_PACKED_DESC_F_USED);
+            prev = &d;
+        }
+        if (prev == first) {
+            first_flags = prev_flags;
+        } else {
+            prev->_flags.store(prev_flags, std::memory_order_relaxed);
+        }
+        _buffer_chains[id] = std::move(bc);
+        _chain_nr_descs[id] = nr;
+        first->_flags.store(first_flags, std::memory_order_release);
+        _avail._avail_added_since_kick++;
+    }
+    kick_packed();
+}
+
 template <typename BufferChain, typename Completion>
 bool vring<BufferChain, Completion>::do_complete() {
+    if (_config.packed) {
+        return do_complete_packed();
+    }
+    return do_complete_split();
+}
+
+template <typename BufferChain, typename Completion>
+bool vring<BufferChain, Completion>::do_complete_packed() {
+    uint64_t count = 0;
+    while (true) {
+        auto& d = _packed_descs[_packed_used_idx];
+        auto flags = d._flags.load(std::memory_order_acquire);
+        bool avail = flags & VRING_PACKED_DESC_F_AVAIL;
+        bool used = flags & VRING_PACKED_DESC_F_USED;
+        // The device marks a chain used by setting both bits to its wrap
+        // counter, which tracks ours.
+        if (avail != _used_wrap || used != _used_wrap) {
+            break;
+        }
+        auto id = d._id;
+        auto len = d._len;
+        // One used descriptor stands for the whole chain; the device's
+        // ring position still advances over all of its slots.
+        _packed_used_idx += _chain_nr_descs[id];
+        if (_packed_used_idx >= _config.size) {
+            _packed_used_idx -= _config.size;
+            _used_wrap = !_used_wrap;
+        }
+        _free_ids.push_back(id);
+        _complete(std::move(_buffer_chains[id]), len);
+        ++count;
+    }
+    _complete.bunch(count);
+    return count;
+}
+
+template <typename BufferChain, typename Completion>
+void vring<BufferChain, Completion>::kick_packed() {
+    // Make sure the device sees the new descriptors before we read its
+    // event suppression area.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto flags = _device_event->_flags.load(std::memory_order_relaxed);
+    // We never arm the descriptor-based mode ourselves, so treat
+    // VRING_PACKED_EVENT_FLAG_DESC like ENABLE and kick; only an explicit
+    // DISABLE suppresses the notification.
+    bool need_kick = flags != VRING_PACKED_EVENT_FLAG_DISABLE;
+    if (need_kick || (_avail._avail_added_since_kick >= (uint16_t)(~0) / 2)) {
+        _notifier->notify();
+        _avail._avail_added_since_kick = 0;
+    }
+}
+
+template <typename BufferChain, typename Completion>
+bool vring<BufferChain, Completion>::do_complete_split() {
     auto used_head = _used._shared->_idx.load(std::memory_order_acquire);
     auto count = _used._tail - used_head;
     _complete.bunch(count);
@@ -768,10 +938,13 @@ size_t qp::vring_storage_size(size_t ring_size) {
 }
 
 void qp::common_config(ring_config& r) {
+    // Packed descriptors are also 16 bytes, so the split layout leaves
+    // ample room for the two 4-byte event suppression areas.
     r.avail = r.descs + 16 * r.size;
     r.used = align_up(r.avail + 2 * r.size + 6, 4096);
     r.event_index = (_dev->features() & VIRTIO_RING_F_EVENT_IDX) != 0;
     r.indirect = false;
+    r.packed = (_dev->features() & VIRTIO_F_RING_PACKED) != 0;
 }
 
 ring_config qp::txq_config(size_t tx_ring_size) {
@@ -827,6 +1000,11 @@ qp_vhost::qp_vhost(device *dev, boost::program_options::variables_map opts)
     int64_t vhost_supported_features;
     _vhost_fd.ioctl(VHOST_GET_FEATURES, vhost_supported_features);
     vhost_supported_features &= _dev->features();
+    if ((_dev->features() & VIRTIO_F_RING_PACKED) && !(vhost_supported_features & VIRTIO_F_RING_PACKED)) {
+        // The ring layout was fixed when the queues were created, so we
+        // cannot fall back to split rings at this point.
+        throw std::runtime_error("--packed-ring requested, but the vhost backend does not support VIRTIO_F_RING_PACKED");
+    }
     _vhost_fd.ioctl(VHOST_SET_FEATURES, vhost_supported_features);
     if (vhost_supported_features & VIRTIO_NET_F_MRG_RXBUF) {
         _header_len = sizeof(net_hdr_mrg);
@@ -1010,6 +1188,9 @@ get_virtio_net_options_description()
         ("ufo",
                 boost::program_options::value<std::string>()->default_value("on"),
                 "Enable UDP fragmentation offload feature (on / off)")
+        ("packed-ring",
+                boost::program_options::value<std::string>()->default_value("off"),
+                "Use the packed virtqueue layout (VIRTIO_F_RING_PACKED); requires backend support (on / off)")
         ("virtio-ring-size",
                 boost::program_options::value<unsigned>()->default_value(256),
                 "Virtio ring size (must be power-of-two)")
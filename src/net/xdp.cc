@@ -0,0 +1,416 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#include <seastar/net/xdp.hh>
+#include <seastar/net/net.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/posix.hh>
+#include <seastar/util/defer.hh>
+
+#include <linux/if_xdp.h>
+#include <linux/bpf.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <cstring>
+
+namespace seastar {
+
+namespace net {
+
+namespace xdp {
+
+// Every UMEM frame holds one packet; 2048 allows two frames per page so
+// the kernel can run the rx path in zero-copy mode.
+static constexpr size_t frame_size = 2048;
+// Entries in each of the fill/rx/tx/completion rings
+static constexpr uint32_t ring_entries = 2048;
+
+static long bpf_call(int cmd, union bpf_attr* attr) {
+    return ::syscall(__NR_bpf, cmd, attr, sizeof(*attr));
+}
+
+// Register an XDP socket in the XSKMAP the redirect program looks up by
+// rx queue index, so packets from our queue land in our socket.
+static void xskmap_insert(const std::string& pin_path, uint32_t queue_id, int xsk_fd) {
+    union bpf_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.pathname = reinterpret_cast<uintptr_t>(pin_path.c_str());
+    int map_fd = bpf_call(BPF_OBJ_GET, &attr);
+    throw_system_error_on(map_fd < 0, "BPF_OBJ_GET");
+    auto close_map = defer([map_fd] { ::close(map_fd); });
+
+    std::memset(&attr, 0, sizeof(attr));
+    attr.map_fd = map_fd;
+    attr.key = reinterpret_cast<uintptr_t>(&queue_id);
+    attr.value = reinterpret_cast<uintptr_t>(&xsk_fd);
+    attr.flags = BPF_ANY;
+    auto r = bpf_call(BPF_MAP_UPDATE_ELEM, &attr);
+    throw_system_error_on(r < 0, "BPF_MAP_UPDATE_ELEM");
+}
+
+// One mmap()ed single-producer/single-consumer ring shared with the
+// kernel. The fill and completion rings carry UMEM frame addresses, the
+// rx and tx rings carry xdp_desc entries.
+template <typename Entry>
+struct xsk_ring {
+    uint32_t* producer = nullptr;
+    uint32_t* consumer = nullptr;
+    uint32_t* flags = nullptr;
+    Entry* ring = nullptr;
+    void* map = MAP_FAILED;
+    size_t map_size = 0;
+    uint32_t cached_prod = 0;
+    uint32_t cached_cons = 0;
+
+    void init(int fd, off_t pgoff, const xdp_ring_offset& off) {
+        map_size = off.desc + ring_entries * sizeof(Entry);
+        map = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, pgoff);
+        throw_system_error_on(map == MAP_FAILED, "mmap");
+        auto base = reinterpret_cast<char*>(map);
+        producer = reinterpret_cast<uint32_t*>(base + off.producer);
+        consumer = reinterpret_cast<uint32_t*>(base + off.consumer);
+        ring = reinterpret_cast<Entry*>(base + off.desc);
+#ifdef XDP_USE_NEED_WAKEUP
+        flags = reinterpret_cast<uint32_t*>(base + off.flags);
+#endif
+        cached_prod = *producer;
+        cached_cons = *consumer;
+    }
+    ~xsk_ring() {
+        if (map != MAP_FAILED) {
+            ::munmap(map, map_size);
+        }
+    }
+    Entry& slot(uint32_t idx) {
+        return ring[idx & (ring_entries - 1)];
+    }
+    // Producer side: number of free slots
+    uint32_t nr_free() {
+        cached_cons = __atomic_load_n(consumer, __ATOMIC_ACQUIRE);
+        return ring_entries - (cached_prod - cached_cons);
+    }
+    void publish() {
+        __atomic_store_n(producer, cached_prod, __ATOMIC_RELEASE);
+    }
+    // Consumer side: number of filled slots
+    uint32_t nr_avail() {
+        cached_prod = __atomic_load_n(producer, __ATOMIC_ACQUIRE);
+        return cached_prod - cached_cons;
+    }
+    void release() {
+        __atomic_store_n(consumer, cached_cons, __ATOMIC_RELEASE);
+    }
+    bool needs_wakeup() const {
+#ifdef XDP_USE_NEED_WAKEUP
+        return flags && (*flags & XDP_RING_NEED_WAKEUP);
+#else
+        return true;
+#endif
+    }
+};
+
+class xdp_device;
+
+class xdp_qp : public net::qp {
+    xdp_device* _dev;
+    uint32_t _qid;
+    file_desc _fd;
+    size_t _nr_frames;
+    size_t _umem_size;
+    char* _umem = nullptr;
+    xsk_ring<uint64_t> _fill;
+    xsk_ring<uint64_t> _comp;
+    xsk_ring<xdp_desc> _rx;
+    xsk_ring<xdp_desc> _tx;
+    // Frames currently owned by neither the kernel nor a live packet.
+    // The first half of the UMEM feeds the fill ring, the second half
+    // carries transmissions until the completion ring returns them.
+    std::vector<uint64_t> _free_frames;
+    std::vector<uint64_t> _free_tx_frames;
+    std::optional<reactor::poller> _rx_poller;
+    reactor::poller _tx_gc_poller;
+private:
+    void setup_rings(const std::string& xskmap_path);
+    void refill_fill_ring();
+    bool poll_rx_once();
+    bool reap_tx_completions();
+    void kick_tx();
+public:
+    xdp_qp(xdp_device* dev, uint32_t qid, const std::string& ifname,
+           const std::string& xskmap_path, size_t nr_frames);
+    ~xdp_qp();
+    virtual future<> send(packet p) override {
+        abort();
+    }
+    virtual uint32_t send(circular_buffer<packet>& pq) override;
+    virtual void rx_start() override;
+};
+
+class xdp_device : public net::device {
+    std::string _ifname;
+    std::string _xskmap_path;
+    size_t _umem_frames;
+    ethernet_address _hw_address;
+    net::hw_features _hw_features;
+public:
+    explicit xdp_device(boost::program_options::variables_map opts)
+        : _ifname(opts["xdp-device"].as<std::string>())
+        , _xskmap_path(opts["xdp-xskmap-path"].as<std::string>())
+        , _umem_frames(opts["xdp-umem-frames"].as<unsigned>()) {
+        auto fd = file_desc::socket(AF_INET, SOCK_DGRAM, 0);
+        ifreq ifr = {};
+        std::strncpy(ifr.ifr_name, _ifname.c_str(), IFNAMSIZ - 1);
+        auto r = ::ioctl(fd.get(), SIOCGIFHWADDR, &ifr);
+        throw_system_error_on(r == -1, "SIOCGIFHWADDR");
+        std::memcpy(_hw_address.mac.data(), ifr.ifr_hwaddr.sa_data, 6);
+        r = ::ioctl(fd.get(), SIOCGIFMTU, &ifr);
+        throw_system_error_on(r == -1, "SIOCGIFMTU");
+        // No checksum or segmentation offloads on the XDP path; frames
+        // arrive and leave exactly as on the wire
+        _hw_features.mtu = ifr.ifr_mtu;
+        _hw_features.max_packet_len = frame_size - XDP_PACKET_HEADROOM;
+    }
+    virtual ethernet_address hw_address() override {
+        return _hw_address;
+    }
+    virtual net::hw_features hw_features() override {
+        return _hw_features;
+    }
+    virtual uint16_t hw_queues_count() override {
+        // One XSK per shard; the NIC must be configured (ethtool -L)
+        // with at least this many rx queues and its RSS indirection
+        // spread over them
+        return smp::count;
+    }
+    virtual std::unique_ptr<net::qp> init_local_queue(boost::program_options::variables_map opts, uint16_t qid) override {
+        return std::make_unique<xdp_qp>(this, qid, _ifname, _xskmap_path, _umem_frames);
+    }
+    const std::string& ifname() const {
+        return _ifname;
+    }
+};
+
+xdp_qp::xdp_qp(xdp_device* dev, uint32_t qid, const std::string& ifname,
+               const std::string& xskmap_path, size_t nr_frames)
+    : qp(true, "xdp-net", qid)
+    , _dev(dev)
+    , _qid(qid)
+    , _fd(file_desc::socket(AF_XDP, SOCK_RAW, 0))
+    , _nr_frames(nr_frames)
+    , _umem_size(nr_frames * frame_size)
+    , _tx_gc_poller(reactor::poller::simple([this] { return reap_tx_completions(); })) {
+    auto m = ::mmap(nullptr, _umem_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    throw_system_error_on(m == MAP_FAILED, "mmap");
+    _umem = reinterpret_cast<char*>(m);
+
+    xdp_umem_reg umem = {};
+    umem.addr = reinterpret_cast<uintptr_t>(_umem);
+    umem.len = _umem_size;
+    umem.chunk_size = frame_size;
+    umem.headroom = 0;
+    _fd.setsockopt(SOL_XDP, XDP_UMEM_REG, umem);
+
+    setup_rings(xskmap_path);
+
+    // Split the frame pool between the receive and transmit directions
+    for (uint64_t addr = 0; addr < _umem_size / 2; addr += frame_size) {
+        _free_frames.push_back(addr);
+    }
+    for (uint64_t addr = _umem_size / 2; addr < _umem_size; addr += frame_size) {
+        _free_tx_frames.push_back(addr);
+    }
+    refill_fill_ring();
+
+    // Bind to the rx queue matching our shard. Try zero-copy first and
+    // fall back to the kernel's copy mode for drivers without support.
+    sockaddr_xdp sxdp = {};
+    sxdp.sxdp_family = AF_XDP;
+    sxdp.sxdp_ifindex = ::if_nametoindex(ifname.c_str());
+    throw_system_error_on(sxdp.sxdp_ifindex == 0, "if_nametoindex");
+    sxdp.sxdp_queue_id = qid;
+#ifdef XDP_USE_NEED_WAKEUP
+    sxdp.sxdp_flags = XDP_USE_NEED_WAKEUP;
+#endif
+    sxdp.sxdp_flags |= XDP_ZEROCOPY;
+    auto r = ::bind(_fd.get(), reinterpret_cast<sockaddr*>(&sxdp), sizeof(sxdp));
+    if (r == -1) {
+        sxdp.sxdp_flags &= ~XDP_ZEROCOPY;
+        sxdp.sxdp_flags |= XDP_COPY;
+        r = ::bind(_fd.get(), reinterpret_cast<sockaddr*>(&sxdp), sizeof(sxdp));
+    }
+    throw_system_error_on(r == -1, "bind(AF_XDP)");
+
+    xskmap_insert(xskmap_path, qid, _fd.get());
+}
+
+xdp_qp::~xdp_qp() {
+    if (_umem) {
+        ::munmap(_umem, _umem_size);
+    }
+}
+
+void xdp_qp::setup_rings(const std::string& xskmap_path) {
+    _fd.setsockopt(SOL_XDP, XDP_UMEM_FILL_RING, ring_entries);
+    _fd.setsockopt(SOL_XDP, XDP_UMEM_COMPLETION_RING, ring_entries);
+    _fd.setsockopt(SOL_XDP, XDP_RX_RING, ring_entries);
+    _fd.setsockopt(SOL_XDP, XDP_TX_RING, ring_entries);
+
+    xdp_mmap_offsets off;
+    socklen_t optlen = sizeof(off);
+    auto r = ::getsockopt(_fd.get(), SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen);
+    throw_system_error_on(r == -1, "XDP_MMAP_OFFSETS");
+
+    _fill.init(_fd.get(), XDP_UMEM_PGOFF_FILL_RING, off.fr);
+    _comp.init(_fd.get(), XDP_UMEM_PGOFF_COMPLETION_RING, off.cr);
+    _rx.init(_fd.get(), XDP_PGOFF_RX_RING, off.rx);
+    _tx.init(_fd.get(), XDP_PGOFF_TX_RING, off.tx);
+}
+
+void xdp_qp::refill_fill_ring() {
+    auto n = std::min<uint32_t>(_fill.nr_free(), _free_frames.size());
+    for (uint32_t i = 0; i < n; i++) {
+        _fill.slot(_fill.cached_prod++) = _free_frames.back();
+        _free_frames.pop_back();
+    }
+    if (n) {
+        _fill.publish();
+        if (_fill.needs_wakeup()) {
+            // The rx path needs a kick when the fill ring ran dry
+            ::recvfrom(_fd.get(), nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+        }
+    }
+}
+
+bool xdp_qp::poll_rx_once() {
+    auto count = _rx.nr_avail();
+    if (!count) {
+        refill_fill_ring();
+        return false;
+    }
+    uint64_t nr_frags = 0, bytes = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        auto& desc = _rx.slot(_rx.cached_cons++);
+        auto frame = desc.addr & ~uint64_t(frame_size - 1);
+        // Hand the UMEM frame to the packet; the deleter recycles it
+        // into the fill ring pool once the stack is done with the data,
+        // so the receive path never copies
+        fragment f{_umem + desc.addr, desc.len};
+        packet p(f, make_deleter([this, frame] { _free_frames.push_back(frame); }));
+        nr_frags++;
+        bytes += desc.len;
+        _dev->l2receive(std::move(p));
+    }
+    _rx.release();
+    _stats.rx.good.update_pkts_bunch(count);
+    _stats.rx.good.update_frags_stats(nr_frags, bytes);
+    refill_fill_ring();
+    return true;
+}
+
+bool xdp_qp::reap_tx_completions() {
+    auto count = _comp.nr_avail();
+    for (uint32_t i = 0; i < count; i++) {
+        _free_tx_frames.push_back(_comp.slot(_comp.cached_cons++));
+    }
+    if (count) {
+        _comp.release();
+    }
+    return count;
+}
+
+void xdp_qp::kick_tx() {
+    if (_tx.needs_wakeup()) {
+        ::sendto(_fd.get(), nullptr, 0, MSG_DONTWAIT, nullptr, 0);
+    }
+}
+
+uint32_t xdp_qp::send(circular_buffer<packet>& pq) {
+    reap_tx_completions();
+    uint32_t sent = 0;
+    uint64_t nr_frags = 0, bytes = 0;
+    while (!pq.empty() && !_free_tx_frames.empty() && _tx.nr_free()) {
+        packet& p = pq.front();
+        if (p.len() > frame_size) {
+            // Cannot happen with hw_features().max_packet_len in effect
+            pq.pop_front();
+            continue;
+        }
+        auto frame = _free_tx_frames.back();
+        _free_tx_frames.pop_back();
+        // The UMEM is the device's buffer space, so transmission is a
+        // single gathering copy of the fragments into the frame
+        auto dst = _umem + frame;
+        for (auto& f : p.fragments()) {
+            dst = std::copy_n(f.base, f.size, dst);
+        }
+        auto& desc = _tx.slot(_tx.cached_prod++);
+        desc.addr = frame;
+        desc.len = p.len();
+        desc.options = 0;
+        nr_frags += p.nr_frags();
+        bytes += p.len();
+        pq.pop_front();
+        sent++;
+    }
+    if (sent) {
+        _tx.publish();
+        kick_tx();
+        _stats.tx.good.update_pkts_bunch(sent);
+        _stats.tx.good.update_frags_stats(nr_frags, bytes);
+    }
+    return sent;
+}
+
+void xdp_qp::rx_start() {
+    _rx_poller = reactor::poller::simple([this] { return poll_rx_once(); });
+}
+
+}
+
+}
+
+boost::program_options::options_description
+get_xdp_net_options_description() {
+    boost::program_options::options_description opts(
+            "AF_XDP net options");
+    opts.add_options()
+        ("xdp-device",
+                boost::program_options::value<std::string>(),
+                "Attach to this network interface with AF_XDP sockets")
+        ("xdp-xskmap-path",
+                boost::program_options::value<std::string>()->default_value("/sys/fs/bpf/xsks_map"),
+                "Pinned XSKMAP of the XDP redirect program attached to the interface")
+        ("xdp-umem-frames",
+                boost::program_options::value<unsigned>()->default_value(4096),
+                "UMEM frames per queue (power of two)")
+        ;
+    return opts;
+}
+
+std::unique_ptr<net::device> create_xdp_net_device(boost::program_options::variables_map opts) {
+    return std::make_unique<net::xdp::xdp_device>(opts);
+}
+
+}
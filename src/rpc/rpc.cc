@@ -1,8 +1,11 @@
 #include <seastar/rpc/rpc.hh>
 #include <seastar/core/align.hh>
 #include <seastar/core/seastar.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/core/print.hh>
 #include <seastar/core/future-util.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/util/defer.hh>
 #include <boost/range/adaptor/map.hpp>
 
@@ -93,13 +96,65 @@ namespace rpc {
   template snd_buf make_shard_local_buffer_copy(foreign_ptr<std::unique_ptr<snd_buf>>);
   template rcv_buf make_shard_local_buffer_copy(foreign_ptr<std::unique_ptr<rcv_buf>>);
 
-  snd_buf connection::compress(snd_buf buf) {
-      if (_compressor) {
+  // Frames smaller than this never shrink enough to pay for the
+  // compression cpu, so they are sent as-is when the peer understands
+  // the bypass flag.
+  static constexpr size_t compress_bypass_min_size = 128;
+  // After a frame of some verb fails to shrink, the verb is sent
+  // uncompressed for this many frames before being probed again.
+  static constexpr unsigned compress_bypass_probe_interval = 32;
+  // Set in the compressed frame length header when the frame was sent
+  // uncompressed (only with COMPRESS_BYPASS negotiated).
+  static constexpr uint32_t uncompressed_frame_flag = 1U << 31;
+
+  static snd_buf prepend_compression_header(uint32_t header_value, snd_buf buf) {
+      auto header = temporary_buffer<char>(4);
+      write_le<uint32_t>(header.get_write(), header_value);
+      std::vector<temporary_buffer<char>> bufs;
+      if (auto* one = std::get_if<temporary_buffer<char>>(&buf.bufs)) {
+          bufs.reserve(2);
+          bufs.push_back(std::move(header));
+          bufs.push_back(std::move(*one));
+      } else {
+          auto& frags = std::get<std::vector<temporary_buffer<char>>>(buf.bufs);
+          bufs.reserve(frags.size() + 1);
+          bufs.push_back(std::move(header));
+          std::move(frags.begin(), frags.end(), std::back_inserter(bufs));
+      }
+      return snd_buf(std::move(bufs), buf.size + 4);
+  }
+
+  snd_buf connection::compress(snd_buf buf, uint64_t verb) {
+      if (!_compressor) {
+          return buf;
+      }
+      if (_compress_bypass_negotiated) {
+          auto& skip = _compress_skip[verb];
+          if (buf.size < compress_bypass_min_size || skip) {
+              if (skip && buf.size >= compress_bypass_min_size) {
+                  --skip;
+              }
+              return prepend_compression_header(buf.size | uncompressed_frame_flag, std::move(buf));
+          }
+          auto size = buf.size;
           buf = _compressor->compress(4, std::move(buf));
+          _stats.compression_input_bytes += size;
+          _stats.compression_output_bytes += buf.size - 4;
+          if (buf.size - 4 >= size) {
+              // the verb's payloads do not shrink; stop wasting cpu on them
+              // for a while
+              skip = compress_bypass_probe_interval;
+          }
           static_assert(snd_buf::chunk_size >= 4, "send buffer chunk size is too small");
           write_le<uint32_t>(buf.front().get_write(), buf.size - 4);
           return buf;
       }
+      auto size = buf.size;
+      buf = _compressor->compress(4, std::move(buf));
+      _stats.compression_input_bytes += size;
+      _stats.compression_output_bytes += buf.size - 4;
+      static_assert(snd_buf::chunk_size >= 4, "send buffer chunk size is too small");
+      write_le<uint32_t>(buf.front().get_write(), buf.size - 4);
       return buf;
   }
 
@@ -117,6 +172,24 @@ namespace rpc {
       }
   }
 
+  future<> connection::flush_send_buffer() {
+      if (_batch_flush_delay != std::chrono::microseconds(0)) {
+          auto now = rpc_clock_type::now();
+          if (!_unflushed_since) {
+              _unflushed_since = now;
+          }
+          if (!_outgoing_queue.empty() && now - *_unflushed_since < _batch_flush_delay) {
+              // more frames are already queued and the coalescing deadline has
+              // not passed yet, so let them share the flush; the send loop
+              // always flushes the last queued frame, so nothing is left
+              // behind once the queue drains
+              return make_ready_future();
+          }
+          _unflushed_since = std::nullopt;
+      }
+      return _write_buf.flush();
+  }
+
   template<connection::outgoing_queue_type QueueType>
   void connection::send_loop() {
       _send_loop_stopped = do_until([this] { return _error; }, [this] {
@@ -133,24 +206,37 @@ namespace rpc {
               if (d.pcancel) {
                   d.pcancel->cancel_send = std::function<void()>(); // request is no longer cancellable
               }
+              uint64_t verb = 0;
               if (QueueType == outgoing_queue_type::request) {
-                  static_assert(snd_buf::chunk_size >= 8, "send buffer chunk size is too small");
+                  static_assert(snd_buf::chunk_size >= 29, "send buffer chunk size is too small");
+                  verb = read_le<uint64_t>(d.buf.front().get() + 9);
+                  if (!_qos_negotiated) {
+                      d.buf.front().trim_front(1);
+                      d.buf.size -= 1;
+                  }
                   if (_timeout_negotiated) {
                       auto expire = d.t.get_timeout();
                       uint64_t left = 0;
                       if (expire != typename timer<rpc_clock_type>::time_point()) {
                           left = std::chrono::duration_cast<std::chrono::milliseconds>(expire - timer<rpc_clock_type>::clock::now()).count();
                       }
-                      write_le<uint64_t>(d.buf.front().get_write(), left);
+                      write_le<uint64_t>(d.buf.front().get_write() + !!_qos_negotiated, left);
                   } else {
+                      if (_qos_negotiated) {
+                          // keep the tag: slide it over the last byte of the
+                          // timeout field we are about to drop
+                          auto p = d.buf.front().get_write();
+                          p[8] = p[0];
+                      }
                       d.buf.front().trim_front(8);
                       d.buf.size -= 8;
                   }
               }
-              d.buf = compress(std::move(d.buf));
+              d.buf = compress(std::move(d.buf), verb);
+              _stats.bytes_sent += d.buf.size;
               auto f = send_buffer(std::move(d.buf)).then([this] {
                   _stats.sent_messages++;
-                  return _write_buf.flush();
+                  return flush_send_buffer();
               });
               return f.finally([d = std::move(d)] {});
           });
@@ -378,6 +464,11 @@ namespace rpc {
               }
               auto ptr = compress_header.get();
               auto size = read_le<uint32_t>(ptr);
+              if (size & uncompressed_frame_flag) {
+                  // the sender found compressing this frame not worth it; the
+                  // inner frame is self describing, so read it as usual
+                  return read_frame<FrameType>(info, in);
+              }
               return read_rcv_buf(in, size).then([this, size, &compressor, info] (rcv_buf compressed_data) {
                   if (compressed_data.size != size) {
                       _logger(info, format("unexpected eof on a {} while reading compressed data: expected {:d} got {:d}", FrameType::role(), size, compressed_data.size));
@@ -535,9 +626,15 @@ namespace rpc {
                   throw std::runtime_error(format("RPC server responded with compression {} - unsupported", e.second));
               }
               break;
+          case protocol_features::COMPRESS_BYPASS:
+              _compress_bypass_negotiated = true;
+              break;
           case protocol_features::TIMEOUT:
               _timeout_negotiated = true;
               break;
+          case protocol_features::QOS:
+              _qos_negotiated = true;
+              break;
           case protocol_features::CONNECTION_ID: {
               _id = deserialize_connection_id(e.second);
               break;
@@ -603,12 +700,17 @@ namespace rpc {
 
   void client::wait_for_reply(id_type id, std::unique_ptr<reply_handler_base>&& h, std::optional<rpc_clock_type::time_point> timeout, cancellable* cancel) {
       if (timeout) {
-          h->t.set_callback(std::bind(std::mem_fn(&client::wait_timed_out), this, id));
-          h->t.arm(timeout.value());
+          auto it = _expiring.emplace(timeout.value(), id);
+          h->expiry = it;
+          if (it == _expiring.begin()) {
+              _expiry_timer.rearm(timeout.value());
+          }
       }
       if (cancel) {
           cancel->cancel_wait = [this, id] {
-              _outstanding[id]->cancel();
+              auto& h = _outstanding[id];
+              detach_expiry(*h);
+              h->cancel();
               _outstanding.erase(id);
           };
           h->pcancel = cancel;
@@ -616,10 +718,31 @@ namespace rpc {
       }
       _outstanding.emplace(id, std::move(h));
   }
-  void client::wait_timed_out(id_type id) {
-      _stats.timeout++;
-      _outstanding[id]->timeout();
-      _outstanding.erase(id);
+
+  void client::detach_expiry(reply_handler_base& h) {
+      if (h.expiry) {
+          // _expiry_timer may now fire early and find nothing expired, which
+          // expire_waiters() handles; not worth rearming here
+          _expiring.erase(*h.expiry);
+          h.expiry = std::nullopt;
+      }
+  }
+
+  void client::expire_waiters() {
+      auto now = rpc_clock_type::now();
+      while (!_expiring.empty() && _expiring.begin()->first <= now) {
+          auto it = _expiring.begin();
+          auto id = it->second;
+          _expiring.erase(it);
+          _stats.timeout++;
+          auto oit = _outstanding.find(id);
+          oit->second->expiry = std::nullopt;
+          oit->second->timeout();
+          _outstanding.erase(oit);
+      }
+      if (!_expiring.empty()) {
+          _expiry_timer.arm(_expiring.begin()->first);
+      }
   }
 
   future<> client::stop() {
@@ -649,6 +772,8 @@ namespace rpc {
 
   client::client(const logger& l, void* s, client_options ops, socket socket, const socket_address& addr, const socket_address& local)
   : rpc::connection(l, s), _socket(std::move(socket)), _server_addr(addr), _local_addr(local), _options(ops) {
+      _batch_flush_delay = ops.batch_flush_delay;
+      _expiry_timer.set_callback([this] { expire_waiters(); });
        _socket.set_reuseaddr(ops.reuseaddr);
       // Run client in the background.
       // Communicate result via _stopped.
@@ -664,10 +789,14 @@ namespace rpc {
           feature_map features;
           if (_options.compressor_factory) {
               features[protocol_features::COMPRESS] = _options.compressor_factory->supported();
+              features[protocol_features::COMPRESS_BYPASS] = "";
           }
           if (_options.send_timeout_data) {
               features[protocol_features::TIMEOUT] = "";
           }
+          if (_options.qos_tag_source) {
+              features[protocol_features::QOS] = "";
+          }
           if (_options.stream_parent) {
               features[protocol_features::STREAM_PARENT] = serialize_connection_id(_options.stream_parent);
           }
@@ -688,12 +817,16 @@ namespace rpc {
                   return read_response_frame_compressed(_read_buf).then([this] (std::tuple<int64_t, std::optional<rcv_buf>> msg_id_and_data) {
                       auto& msg_id = std::get<0>(msg_id_and_data);
                       auto& data = std::get<1>(msg_id_and_data);
+                      if (data) {
+                          _stats.bytes_received += data->size;
+                      }
                       auto it = _outstanding.find(std::abs(msg_id));
                       if (!data) {
                           _error = true;
                       } else if (it != _outstanding.end()) {
                           auto handler = std::move(it->second);
                           _outstanding.erase(it);
+                          detach_expiry(*handler);
                           (*handler)(*this, msg_id, std::move(data.value()));
                       } else if (msg_id < 0) {
                           try {
@@ -728,6 +861,10 @@ namespace rpc {
           _stream_queue.abort(std::make_exception_ptr(stream_closed()));
           return stop_send_loop().then_wrapped([this] (future<> f) {
               f.ignore_ready_future();
+              // all waiters go away in one sweep, with no per-call timers
+              // to dismantle
+              _expiry_timer.cancel();
+              _expiring.clear();
               _outstanding.clear();
               if (is_stream()) {
                   deregister_this_stream();
@@ -773,10 +910,25 @@ namespace rpc {
               }
           }
           break;
+          case protocol_features::COMPRESS_BYPASS:
+              // requested features are processed in enum order, so by now we
+              // know whether a compressor was negotiated
+              if (_compressor) {
+                  _compress_bypass_negotiated = true;
+                  ret[protocol_features::COMPRESS_BYPASS] = "";
+              }
+              break;
           case protocol_features::TIMEOUT:
               _timeout_negotiated = true;
               ret[protocol_features::TIMEOUT] = "";
               break;
+          case protocol_features::QOS:
+              // only accept tags if the server can map them to something
+              if (_server._limits.isolate_call) {
+                  _qos_negotiated = true;
+                  ret[protocol_features::QOS] = "";
+              }
+              break;
           case protocol_features::STREAM_PARENT: {
               if (!_server._options.streaming_domain) {
                   f = make_exception_future<>(std::runtime_error("streaming is not configured for the server"));
@@ -804,6 +956,7 @@ namespace rpc {
           case protocol_features::ISOLATION: {
               auto&& isolation_cookie = e.second;
               _isolation_config = _server._limits.isolate_connection(isolation_cookie);
+              _server.remember_isolation(*_isolation_config);
               ret.emplace(e);
               break;
           }
@@ -831,9 +984,9 @@ namespace rpc {
 
   struct request_frame {
       using opt_buf_type = std::optional<rcv_buf>;
-      using header_and_buffer_type = std::tuple<std::optional<uint64_t>, uint64_t, int64_t, opt_buf_type>;
+      using header_and_buffer_type = std::tuple<std::optional<uint64_t>, std::optional<uint8_t>, uint64_t, int64_t, opt_buf_type>;
       using return_type = future<header_and_buffer_type>;
-      using header_type = std::tuple<std::optional<uint64_t>, uint64_t, int64_t, uint32_t>;
+      using header_type = std::tuple<std::optional<uint64_t>, std::optional<uint8_t>, uint64_t, int64_t, uint32_t>;
       static size_t header_size() {
           return 20;
       }
@@ -841,19 +994,19 @@ namespace rpc {
           return "server";
       }
       static auto empty_value() {
-          return make_ready_future<header_and_buffer_type>(header_and_buffer_type(std::nullopt, uint64_t(0), 0, std::nullopt));
+          return make_ready_future<header_and_buffer_type>(header_and_buffer_type(std::nullopt, std::nullopt, uint64_t(0), 0, std::nullopt));
       }
       static header_type decode_header(const char* ptr) {
           auto type = read_le<uint64_t>(ptr);
           auto msgid = read_le<int64_t>(ptr + 8);
           auto size = read_le<uint32_t>(ptr + 16);
-          return std::make_tuple(std::nullopt, type, msgid, size);
+          return std::make_tuple(std::nullopt, std::nullopt, type, msgid, size);
       }
       static uint32_t get_size(const header_type& t) {
-          return std::get<3>(t);
+          return std::get<4>(t);
       }
       static auto make_value(const header_type& t, rcv_buf data) {
-          return make_ready_future<header_and_buffer_type>(header_and_buffer_type(std::get<0>(t), std::get<1>(t), std::get<2>(t), std::move(data)));
+          return make_ready_future<header_and_buffer_type>(header_and_buffer_type(std::get<0>(t), std::get<1>(t), std::get<2>(t), std::get<3>(t), std::move(data)));
       }
   };
 
@@ -869,9 +1022,40 @@ namespace rpc {
       }
   };
 
+  // a QoS tag, when negotiated, precedes the rest of the header
+  struct request_frame_with_qos : request_frame {
+      using super = request_frame;
+      static size_t header_size() {
+          return 21;
+      }
+      static typename super::header_type decode_header(const char* ptr) {
+          auto h = super::decode_header(ptr + 1);
+          std::get<1>(h) = uint8_t(*ptr);
+          return h;
+      }
+  };
+
+  struct request_frame_with_qos_and_timeout : request_frame_with_timeout {
+      using super = request_frame_with_timeout;
+      static size_t header_size() {
+          return 29;
+      }
+      static typename super::header_type decode_header(const char* ptr) {
+          auto h = super::decode_header(ptr + 1);
+          std::get<1>(h) = uint8_t(*ptr);
+          return h;
+      }
+  };
+
   future<request_frame::header_and_buffer_type>
   server::connection::read_request_frame_compressed(input_stream<char>& in) {
-      if (_timeout_negotiated) {
+      if (_qos_negotiated) {
+          if (_timeout_negotiated) {
+              return read_frame_compressed<request_frame_with_qos_and_timeout>(_info.addr, _compressor, in);
+          } else {
+              return read_frame_compressed<request_frame_with_qos>(_info.addr, _compressor, in);
+          }
+      } else if (_timeout_negotiated) {
           return read_frame_compressed<request_frame_with_timeout>(_info.addr, _compressor, in);
       } else {
           return read_frame_compressed<request_frame>(_info.addr, _compressor, in);
@@ -917,11 +1101,19 @@ future<> server::connection::send_unknown_verb_reply(std::optional<rpc_clock_typ
               if (is_stream()) {
                   return handle_stream_frame();
               }
+              if (engine().overloaded()) {
+                  // Defer instead of reading the next request: the socket
+                  // fills up and TCP backpressure propagates to the client,
+                  // shedding load before it joins the run-queue backlog.
+                  _stats.deferred_on_overload++;
+                  return sleep(std::chrono::milliseconds(1));
+              }
               return read_request_frame_compressed(_read_buf).then([this] (request_frame::header_and_buffer_type header_and_buffer) {
                   auto& expire = std::get<0>(header_and_buffer);
-                  auto& type = std::get<1>(header_and_buffer);
-                  auto& msg_id = std::get<2>(header_and_buffer);
-                  auto& data = std::get<3>(header_and_buffer);
+                  auto& qos_tag = std::get<1>(header_and_buffer);
+                  auto& type = std::get<2>(header_and_buffer);
+                  auto& msg_id = std::get<3>(header_and_buffer);
+                  auto& data = std::get<4>(header_and_buffer);
                   if (!data) {
                       _error = true;
                       return make_ready_future<>();
@@ -934,12 +1126,31 @@ future<> server::connection::send_unknown_verb_reply(std::optional<rpc_clock_typ
                       if (!h) {
                           return send_unknown_verb_reply(timeout, msg_id, type);
                       }
-
-                      // If the new method of per-connection scheduling group was used, honor it.
-                      // Otherwise, use the old per-handler scheduling group.
-                      auto sg = _isolation_config ? _isolation_config->sched_group : h->sg;
+                      _stats.bytes_received += data->size;
+                      h->stats.count++;
+                      h->stats.bytes_in += data->size;
+
+                      // A per-call QoS tag overrides per-connection isolation,
+                      // which in turn overrides the per-handler scheduling group.
+                      std::optional<isolation_config> call_isolation;
+                      if (qos_tag) {
+                          call_isolation = _server.qos_isolation(*qos_tag);
+                      }
+                      auto sg = call_isolation ? call_isolation->sched_group
+                              : _isolation_config ? _isolation_config->sched_group : h->sg;
                       return with_scheduling_group(sg, [this, timeout, msg_id, h, data = std::move(data.value())] () mutable {
-                          return h->func(shared_from_this(), timeout, msg_id, std::move(data)).finally([this, h] {
+                          future<> f = make_ready_future<>();
+                          if (h->stage) {
+                              // batched dispatch: the stage function accounts the
+                              // handler time itself, excluding the queueing delay
+                              f = (*h->stage)(shared_from_this(), timeout, msg_id, std::move(data));
+                          } else {
+                              auto start = std::chrono::steady_clock::now();
+                              f = h->func(shared_from_this(), timeout, msg_id, std::move(data)).finally([h, start] {
+                                  h->stats.handler_time += std::chrono::steady_clock::now() - start;
+                              });
+                          }
+                          return f.finally([this, h] {
                               // If anything between get_handler() and here throws, we leak put_handler
                               _server._proto->put_handler(h);
                           });
@@ -1050,6 +1261,57 @@ future<> server::connection::send_unknown_verb_reply(std::optional<rpc_clock_typ
       });
   }
 
+  void server::register_metrics(const sstring& domain) {
+      namespace sm = seastar::metrics;
+      std::vector<sm::label_instance> labels = { sm::label("domain")(domain) };
+      // the counters below are summed over open connections only; counts of
+      // closed connections are dropped with them
+      auto sum_over_conns = [this] (stats::counter_type stats::*member) {
+          return [this, member] {
+              stats::counter_type n = 0;
+              for (auto&& c : _conns) {
+                  n += c.second->get_stats().*member;
+              }
+              return n;
+          };
+      };
+      _metric_group.add_group("rpc_server", {
+          sm::make_queue_length("queue_length", sum_over_conns(&stats::pending),
+                  sm::description("Number of frames queued for sending over the server's connections"), labels),
+          sm::make_total_bytes("sent_bytes", sum_over_conns(&stats::bytes_sent),
+                  sm::description("Wire bytes sent over the server's open connections, after compression"), labels),
+          sm::make_total_bytes("received_bytes", sum_over_conns(&stats::bytes_received),
+                  sm::description("Payload bytes received over the server's open connections"), labels),
+          sm::make_total_bytes("compression_input_bytes", sum_over_conns(&stats::compression_input_bytes),
+                  sm::description("Bytes fed to the compressor on the server's open connections"), labels),
+          sm::make_total_bytes("compression_output_bytes", sum_over_conns(&stats::compression_output_bytes),
+                  sm::description("Bytes the compressor produced on the server's open connections"), labels),
+          sm::make_derive("deferred_on_overload", sum_over_conns(&stats::deferred_on_overload),
+                  sm::description("Times the server paused reading requests because the shard was overloaded (see --overload-threshold-ms)"), labels),
+      });
+  }
+
+  isolation_config server::qos_isolation(uint8_t qos_tag) {
+      auto it = _qos_configs.find(qos_tag);
+      if (it == _qos_configs.end()) {
+          it = _qos_configs.emplace(qos_tag, _limits.isolate_call(qos_tag)).first;
+          remember_isolation(it->second);
+      }
+      return it->second;
+  }
+
+  void server::remember_isolation(const isolation_config& cfg) {
+      _isolation_by_sg.insert_or_assign(internal::scheduling_group_index(cfg.sched_group), cfg);
+  }
+
+  std::optional<isolation_config> server::isolation_config_for(scheduling_group sg) const {
+      auto it = _isolation_by_sg.find(internal::scheduling_group_index(sg));
+      if (it == _isolation_by_sg.end()) {
+          return std::nullopt;
+      }
+      return it->second;
+  }
+
   future<> server::stop() {
       _ss.abort_accept();
       _resources_available.broken();
@@ -0,0 +1,249 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#include <seastar/rpc/zstd_compressor.hh>
+#include <seastar/core/print.hh>
+#include <boost/algorithm/string.hpp>
+
+namespace seastar {
+
+namespace rpc {
+
+// The compressed message is a single zstd frame (which is
+// self-delimiting, so no extra metadata is needed), preceded only by the
+// head_space the rpc layer asked for.
+
+void zstd_compressor::cdict_deleter::operator()(ZSTD_CDict* dict) const noexcept {
+    ZSTD_freeCDict(dict);
+}
+
+void zstd_compressor::ddict_deleter::operator()(ZSTD_DDict* dict) const noexcept {
+    ZSTD_freeDDict(dict);
+}
+
+zstd_compressor::zstd_compressor(int level)
+    : _name(factory(level).supported())
+    , _level(level) {
+}
+
+zstd_compressor::zstd_compressor(sstring name, int level, const sstring& dict)
+    : _name(std::move(name))
+    , _level(level) {
+    if (!dict.empty()) {
+        _cdict.reset(ZSTD_createCDict(dict.data(), dict.size(), level));
+        _ddict.reset(ZSTD_createDDict(dict.data(), dict.size()));
+        if (!_cdict || !_ddict) {
+            throw std::runtime_error("failed to digest ZSTD dictionary");
+        }
+    }
+}
+
+sstring zstd_compressor::name() const {
+    return _name;
+}
+
+zstd_compressor::factory::factory(int level)
+    : _level(level)
+    , _feature(format("ZSTD:{:d}", level)) {
+}
+
+zstd_compressor::factory::factory(int level, sstring dict_name, sstring dict)
+    : _level(level)
+    , _dict_name(std::move(dict_name))
+    , _dict(std::move(dict))
+    , _feature(format("ZSTD:{:d}:{}", level, _dict_name)) {
+}
+
+const sstring& zstd_compressor::factory::supported() const {
+    return _feature;
+}
+
+std::unique_ptr<rpc::compressor> zstd_compressor::factory::negotiate(sstring feature, bool is_server) const {
+    std::vector<sstring> fields;
+    boost::split(fields, feature, boost::is_any_of(":"));
+    if (fields[0] != "ZSTD") {
+        return nullptr;
+    }
+    auto peer_level = _level;
+    if (fields.size() > 1) {
+        char* end;
+        peer_level = std::strtol(fields[1].c_str(), &end, 10);
+        if (*end) {
+            return nullptr;
+        }
+    }
+    auto peer_dict_name = fields.size() > 2 ? fields[2] : sstring();
+    if (peer_dict_name != _dict_name) {
+        // we would not be able to decompress the peer's frames
+        return nullptr;
+    }
+    // compress at the weaker side's preference; both sides compute the
+    // same minimum, so the choice is symmetric
+    return std::make_unique<zstd_compressor>(supported(), std::min(_level, peer_level), _dict);
+}
+
+namespace {
+
+struct cctx_deleter {
+    void operator()(ZSTD_CCtx* ctx) const noexcept {
+        ZSTD_freeCCtx(ctx);
+    }
+};
+
+struct dctx_deleter {
+    void operator()(ZSTD_DCtx* ctx) const noexcept {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+}
+
+static void check_zstd(size_t ret, const char* what) {
+    if (ZSTD_isError(ret)) {
+        throw std::runtime_error(format("RPC frame ZSTD {} failure: {}", what, ZSTD_getErrorName(ret)));
+    }
+}
+
+snd_buf zstd_compressor::compress(size_t head_space, snd_buf data) {
+    static thread_local auto cctx = std::unique_ptr<ZSTD_CCtx, cctx_deleter>(ZSTD_createCCtx());
+
+    check_zstd(ZSTD_CCtx_reset(cctx.get(), ZSTD_reset_session_and_parameters), "compression context reset");
+    if (_cdict) {
+        check_zstd(ZSTD_CCtx_refCDict(cctx.get(), _cdict.get()), "dictionary selection");
+    } else {
+        check_zstd(ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_compressionLevel, _level), "level selection");
+    }
+    // have the frame header carry the content size, so decompress() can
+    // size its output buffer exactly
+    check_zstd(ZSTD_CCtx_setPledgedSrcSize(cctx.get(), data.size), "content size pledge");
+
+    auto src = std::get_if<temporary_buffer<char>>(&data.bufs);
+    if (!src) {
+        src = std::get<std::vector<temporary_buffer<char>>>(data.bufs).data();
+    }
+
+    std::vector<temporary_buffer<char>> dst_buffers;
+    auto bound = head_space + ZSTD_compressBound(data.size);
+    size_t total_size = 0;
+    dst_buffers.emplace_back(std::min(bound, snd_buf::chunk_size));
+    ZSTD_outBuffer out = { dst_buffers.back().get_write(), dst_buffers.back().size(), head_space };
+
+    auto src_left = data.size;
+    do {
+        auto this_size = std::min<size_t>(src->size(), src_left);
+        ZSTD_inBuffer in = { src->get(), this_size, 0 };
+        src_left -= this_size;
+        ++src;
+        auto mode = src_left ? ZSTD_e_continue : ZSTD_e_end;
+        while (true) {
+            if (out.pos == out.size) {
+                dst_buffers.back().trim(out.pos);
+                total_size += out.pos;
+                bound -= out.pos;
+                dst_buffers.emplace_back(std::min(bound, snd_buf::chunk_size));
+                out = { dst_buffers.back().get_write(), dst_buffers.back().size(), 0 };
+            }
+            auto ret = ZSTD_compressStream2(cctx.get(), &out, &in, mode);
+            check_zstd(ret, "compression");
+            if (mode == ZSTD_e_end ? ret == 0 : in.pos == in.size) {
+                break;
+            }
+        }
+    } while (src_left);
+
+    dst_buffers.back().trim(out.pos);
+    total_size += out.pos;
+
+    if (dst_buffers.size() == 1) {
+        return snd_buf(std::move(dst_buffers.front()));
+    }
+    return snd_buf(std::move(dst_buffers), total_size);
+}
+
+rcv_buf zstd_compressor::decompress(rcv_buf data) {
+    if (!data.size) {
+        return rcv_buf();
+    }
+
+    static thread_local auto dctx = std::unique_ptr<ZSTD_DCtx, dctx_deleter>(ZSTD_createDCtx());
+
+    check_zstd(ZSTD_DCtx_reset(dctx.get(), ZSTD_reset_session_and_parameters), "decompression context reset");
+    if (_ddict) {
+        check_zstd(ZSTD_DCtx_refDDict(dctx.get(), _ddict.get()), "dictionary selection");
+    }
+
+    auto src = std::get_if<temporary_buffer<char>>(&data.bufs);
+    if (!src) {
+        src = std::get<std::vector<temporary_buffer<char>>>(data.bufs).data();
+    }
+
+    // compress() pledges the content size, so a well-formed frame header
+    // tells us how much output to expect; be prepared for it to be absent
+    // anyway and grow chunk-wise then
+    static constexpr size_t output_chunk_size = 32 * 1024;
+    auto content_size = ZSTD_getFrameContentSize(src->get(), src->size());
+    auto first_chunk = (content_size == ZSTD_CONTENTSIZE_UNKNOWN || content_size == ZSTD_CONTENTSIZE_ERROR)
+            ? output_chunk_size : size_t(content_size);
+
+    std::vector<temporary_buffer<char>> dst_buffers;
+    size_t total_size = 0;
+    dst_buffers.emplace_back(first_chunk);
+    ZSTD_outBuffer out = { dst_buffers.back().get_write(), dst_buffers.back().size(), 0 };
+
+    auto src_left = data.size;
+    size_t ret = 0;
+    do {
+        auto this_size = std::min<size_t>(src->size(), src_left);
+        ZSTD_inBuffer in = { src->get(), this_size, 0 };
+        src_left -= this_size;
+        ++src;
+        while (true) {
+            if (out.pos == out.size) {
+                dst_buffers.back().trim(out.pos);
+                total_size += out.pos;
+                dst_buffers.emplace_back(output_chunk_size);
+                out = { dst_buffers.back().get_write(), dst_buffers.back().size(), 0 };
+            }
+            ret = ZSTD_decompressStream(dctx.get(), &out, &in);
+            check_zstd(ret, "decompression");
+            // done with this fragment once it is consumed and no flushable
+            // output is stuck behind a full output buffer
+            if (in.pos == in.size && (ret == 0 || out.pos < out.size)) {
+                break;
+            }
+        }
+    } while (src_left);
+    if (ret) {
+        throw std::runtime_error("RPC frame ZSTD decompression failure: truncated frame");
+    }
+
+    dst_buffers.back().trim(out.pos);
+    total_size += out.pos;
+
+    if (dst_buffers.size() == 1) {
+        return rcv_buf(std::move(dst_buffers.front()));
+    }
+    return rcv_buf(std::move(dst_buffers), total_size);
+}
+
+}
+
+}
@@ -31,6 +31,7 @@
 #include <seastar/util/log-cli.hh>
 
 #include <seastar/core/array_map.hh>
+#include <seastar/core/make_task.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/print.hh>
@@ -215,12 +216,16 @@ std::istream& operator>>(std::istream& in, log_level& level) {
 std::ostream* logger::_out = &std::cerr;
 std::atomic<bool> logger::_ostream = { true };
 std::atomic<bool> logger::_syslog = { false };
+std::atomic<bool> logger::_async = { false };
 
 logger::logger(sstring name) : _name(std::move(name)) {
     global_logger_registry().register_logger(this);
 }
 
-logger::logger(logger&& x) : _name(std::move(x._name)), _level(x._level.load(std::memory_order_relaxed)) {
+logger::logger(logger&& x) : _name(std::move(x._name)), _level(x._level.load(std::memory_order_relaxed))
+        , _rate_limit_interval_ms(x._rate_limit_interval_ms.load(std::memory_order_relaxed))
+        , _rate_limit_next_ms(x._rate_limit_next_ms.load(std::memory_order_relaxed))
+        , _rate_limited_messages(x._rate_limited_messages.load(std::memory_order_relaxed)) {
     global_logger_registry().moved(&x, this);
 }
 
@@ -230,6 +235,65 @@ logger::~logger() {
 
 static thread_local std::array<char, 8192> static_log_buf;
 
+// Per-shard ring of formatted log records awaiting the drain task.
+// Producer and consumer are the same thread and the drain does not
+// yield, so plain fields suffice.
+class async_log_ring {
+    static constexpr size_t ring_size = 1 << 20;
+    std::unique_ptr<char[]> _buf;
+    size_t _begin = 0; // first pending byte
+    size_t _size = 0;  // pending bytes
+    bool _drain_scheduled = false;
+    uint64_t _dropped = 0;
+    uint64_t _dropped_reported = 0;
+    std::ostream* _out = nullptr;
+    scheduling_group _drain_sg;
+private:
+    void drain() {
+        auto& out = *_out;
+        while (_size) {
+            auto chunk = std::min(_size, ring_size - _begin);
+            out.write(_buf.get() + _begin, chunk);
+            _begin = (_begin + chunk) % ring_size;
+            _size -= chunk;
+        }
+        if (_dropped != _dropped_reported) {
+            out << "dropped " << (_dropped - _dropped_reported) << " log messages: asynchronous log ring overflow\n";
+            _dropped_reported = _dropped;
+        }
+        out.flush();
+        _drain_scheduled = false;
+    }
+public:
+    void push(std::string_view record, std::ostream* out) {
+        if (!_buf) {
+            _buf = std::make_unique<char[]>(ring_size);
+        }
+        _out = out;
+        if (record.size() > ring_size - _size) {
+            ++_dropped;
+        } else {
+            auto pos = (_begin + _size) % ring_size;
+            auto first = std::min(record.size(), ring_size - pos);
+            std::copy_n(record.data(), first, _buf.get() + pos);
+            std::copy_n(record.data() + first, record.size() - first, _buf.get());
+            _size += record.size();
+        }
+        if (!_drain_scheduled) {
+            _drain_scheduled = true;
+            schedule(make_task(_drain_sg, [this] { drain(); }));
+        }
+    }
+    void set_drain_scheduling_group(scheduling_group sg) {
+        _drain_sg = sg;
+    }
+    uint64_t dropped() const {
+        return _dropped;
+    }
+};
+
+static thread_local async_log_ring this_shard_log_ring;
+
 bool logger::rate_limit::check() {
     const auto now = clock::now();
     if (now < _next) {
@@ -251,6 +315,9 @@ logger::do_log(log_level level, log_writer& writer) {
     if(!is_ostream_enabled && !is_syslog_enabled) {
       return;
     }
+    if (!check_instance_rate_limit()) {
+      return;
+    }
     static array_map<sstring, 20> level_map = {
             { int(log_level::debug), "DEBUG" },
             { int(log_level::info),  "INFO "  },
@@ -273,8 +340,12 @@ logger::do_log(log_level level, log_writer& writer) {
         it = print_timestamp(it);
         it = print_once(it);
         *it++ = '\n';
-        *_out << buf.view();
-        _out->flush();
+        if (_async.load(std::memory_order_relaxed) && local_engine) {
+            this_shard_log_ring.push(buf.view(), _out);
+        } else {
+            *_out << buf.view();
+            _out->flush();
+        }
     }
     if (is_syslog_enabled) {
         internal::log_buf buf(static_log_buf.data(), static_log_buf.size());
@@ -329,6 +400,41 @@ logger::set_stdout_enabled(bool enabled) noexcept {
     _ostream.store(enabled, std::memory_order_relaxed);
 }
 
+void
+logger::set_async_enabled(bool enabled) noexcept {
+    _async.store(enabled, std::memory_order_relaxed);
+}
+
+void
+logger::set_async_drain_scheduling_group(scheduling_group sg) noexcept {
+    this_shard_log_ring.set_drain_scheduling_group(sg);
+}
+
+uint64_t
+logger::dropped_async_messages() noexcept {
+    return this_shard_log_ring.dropped();
+}
+
+void
+logger::set_rate_limit(std::chrono::milliseconds interval) noexcept {
+    _rate_limit_interval_ms.store(interval.count(), std::memory_order_relaxed);
+}
+
+bool
+logger::check_instance_rate_limit() noexcept {
+    auto interval = _rate_limit_interval_ms.load(std::memory_order_relaxed);
+    if (interval <= 0) {
+        return true;
+    }
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(rate_limit::clock::now().time_since_epoch()).count();
+    if (now < _rate_limit_next_ms.load(std::memory_order_relaxed)) {
+        _rate_limited_messages.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    _rate_limit_next_ms.store(now + interval, std::memory_order_relaxed);
+    return true;
+}
+
 void
 logger::set_syslog_enabled(bool enabled) noexcept {
     _syslog.store(enabled, std::memory_order_relaxed);
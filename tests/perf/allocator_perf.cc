@@ -0,0 +1,127 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <random>
+#include <vector>
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/testing/random.hh>
+#include <seastar/core/smp.hh>
+
+// Microbenchmarks for src/core/memory.cc: the small pools, the
+// cross-shard free path and large span allocation.
+
+PERF_TEST(allocator, alloc_free_16)
+{
+    auto ptr = operator new(16);
+    perf_tests::do_not_optimize(ptr);
+    operator delete(ptr, 16);
+}
+
+PERF_TEST(allocator, alloc_free_256)
+{
+    auto ptr = operator new(256);
+    perf_tests::do_not_optimize(ptr);
+    operator delete(ptr, 256);
+}
+
+PERF_TEST(allocator, alloc_free_4k)
+{
+    auto ptr = operator new(4096);
+    perf_tests::do_not_optimize(ptr);
+    operator delete(ptr, 4096);
+}
+
+// Objects allocated here but freed on the next shard exercise the
+// cross_cpu_freelist path on both sides. With a single shard this
+// degenerates into a plain (but batched) local free.
+PERF_TEST(allocator, cross_shard_free)
+{
+    constexpr size_t object_size = 64;
+    constexpr size_t batch_size = 1024;
+    std::vector<void*> ptrs;
+    ptrs.reserve(batch_size);
+    for (size_t i = 0; i < batch_size; i++) {
+        ptrs.emplace_back(operator new(object_size));
+    }
+    auto target = (this_shard_id() + 1) % smp::count;
+    return smp::submit_to(target, [ptrs = std::move(ptrs)] {
+        for (auto ptr : ptrs) {
+            operator delete(ptr, object_size);
+        }
+    }).then([] {
+        return size_t(batch_size);
+    });
+}
+
+// A heap with a spread of object sizes; each iteration replaces a
+// random object with a new one of a random size, keeping the heap
+// fragmented the way long-running mixed workloads do.
+class fragmented_heap {
+    static constexpr size_t nr_objects = 16 * 1024;
+protected:
+    std::vector<std::pair<void*, size_t>> _objects;
+private:
+    static size_t random_size() {
+        // log-uniform between 16 bytes and 16K, covering all the small
+        // pools and spilling into small spans
+        auto exp = std::uniform_int_distribution<unsigned>(4, 14)(testing::local_random_engine);
+        return std::uniform_int_distribution<size_t>(size_t(1) << exp, (size_t(2) << exp) - 1)(testing::local_random_engine);
+    }
+protected:
+    size_t replace_random_object() {
+        auto i = std::uniform_int_distribution<size_t>(0, _objects.size() - 1)(testing::local_random_engine);
+        auto& [ptr, size] = _objects[i];
+        operator delete(ptr, size);
+        size = random_size();
+        ptr = operator new(size);
+        return size;
+    }
+public:
+    fragmented_heap() {
+        _objects.reserve(nr_objects);
+        for (size_t i = 0; i < nr_objects; i++) {
+            auto size = random_size();
+            _objects.emplace_back(operator new(size), size);
+        }
+    }
+
+    ~fragmented_heap() {
+        for (auto& [ptr, size] : _objects) {
+            operator delete(ptr, size);
+        }
+    }
+};
+
+PERF_TEST_F(fragmented_heap, mixed_size_alloc_free)
+{
+    perf_tests::do_not_optimize(replace_random_object());
+}
+
+PERF_TEST(allocator, huge_alloc_free)
+{
+    // large enough to need a fresh span and take the large allocation
+    // path rather than a small pool
+    constexpr size_t size = 16 << 20;
+    auto ptr = operator new(size);
+    perf_tests::do_not_optimize(ptr);
+    operator delete(ptr, size);
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#include <seastar/net/ip_checksum.hh>
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/testing/random.hh>
+
+struct checksum {
+    static constexpr size_t header_size = 40;
+    static constexpr size_t mtu_size = 1500;
+    static constexpr size_t jumbo_size = 64 * 1024;
+
+protected:
+    seastar::temporary_buffer<char> _header_buffer;
+    seastar::temporary_buffer<char> _mtu_buffer;
+    seastar::temporary_buffer<char> _jumbo_buffer;
+
+    static seastar::temporary_buffer<char> make_random_buffer(size_t size) {
+        auto buf = seastar::temporary_buffer<char>(size);
+        std::uniform_int_distribution<int> dist('a', 'z');
+        std::generate_n(buf.get_write(), size, [&] { return dist(seastar::testing::local_random_engine); });
+        return buf;
+    }
+
+public:
+    checksum()
+        : _header_buffer(make_random_buffer(header_size))
+        , _mtu_buffer(make_random_buffer(mtu_size))
+        , _jumbo_buffer(make_random_buffer(jumbo_size))
+    { }
+
+protected:
+    uint16_t checksum_buffer(const seastar::temporary_buffer<char>& buf) {
+        return seastar::net::ip_checksum(buf.get(), buf.size());
+    }
+
+    uint16_t checksum_buffer_unaligned(const seastar::temporary_buffer<char>& buf) {
+        // Odd start offset exercises the realignment path in front of
+        // the vectorized bulk loop
+        seastar::net::checksummer csum;
+        csum.sum(uint8_t(0));
+        csum.sum(buf.get(), buf.size() - 1);
+        return csum.get();
+    }
+};
+
+PERF_TEST_F(checksum, header)
+{
+    perf_tests::do_not_optimize(checksum_buffer(_header_buffer));
+}
+
+PERF_TEST_F(checksum, mtu_frame)
+{
+    perf_tests::do_not_optimize(checksum_buffer(_mtu_buffer));
+}
+
+PERF_TEST_F(checksum, jumbo_frame)
+{
+    perf_tests::do_not_optimize(checksum_buffer(_jumbo_buffer));
+}
+
+PERF_TEST_F(checksum, mtu_frame_unaligned)
+{
+    perf_tests::do_not_optimize(checksum_buffer_unaligned(_mtu_buffer));
+}
+
+PERF_TEST_F(checksum, jumbo_frame_unaligned)
+{
+    perf_tests::do_not_optimize(checksum_buffer_unaligned(_jumbo_buffer));
+}
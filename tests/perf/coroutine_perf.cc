@@ -0,0 +1,79 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#include <seastar/testing/perf_tests.hh>
+
+#ifdef SEASTAR_COROUTINES_ENABLED
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/util/later.hh>
+
+using namespace seastar;
+
+// Marked noinline so that the compiler cannot elide the frame
+// allocation (HALO); these measure the cost of allocating, running and
+// freeing one coroutine frame.
+
+[[gnu::noinline]]
+static future<int> immediate_coroutine(int v)
+{
+    co_return co_await make_ready_future<int>(v);
+}
+
+PERF_TEST(coroutine, allocate_and_run_frame)
+{
+    return immediate_coroutine(42).then([] (int v) {
+        perf_tests::do_not_optimize(v);
+    });
+}
+
+[[gnu::noinline]]
+static future<int> chained_coroutine(int v)
+{
+    auto a = co_await immediate_coroutine(v);
+    auto b = co_await immediate_coroutine(a);
+    auto c = co_await immediate_coroutine(b);
+    co_return c;
+}
+
+PERF_TEST(coroutine, chained_frames)
+{
+    return chained_coroutine(42).then([] (int v) {
+        perf_tests::do_not_optimize(v);
+    });
+}
+
+[[gnu::noinline]]
+static future<int> suspending_coroutine(int v)
+{
+    co_await later();
+    co_return v;
+}
+
+PERF_TEST(coroutine, frame_with_suspension)
+{
+    return suspending_coroutine(42).then([] (int v) {
+        perf_tests::do_not_optimize(v);
+    });
+}
+
+#endif // SEASTAR_COROUTINES_ENABLED
@@ -0,0 +1,123 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2026 ScyllaDB Ltd.
+ */
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/core/flat_btree.hh>
+
+#include <map>
+#include <random>
+#include <vector>
+
+// Lookups and scans over a population large enough that neither index
+// fits in the L2 cache, which is where the flat nodes are supposed to
+// pay off against std::map's per-element allocations.
+struct btree_fixture {
+    static constexpr size_t population = 1'000'000;
+    seastar::flat_btree_map<uint64_t, uint64_t> tree;
+    std::map<uint64_t, uint64_t> stdmap;
+    std::vector<uint64_t> probe_keys;
+    size_t probe_idx = 0;
+    uint64_t insert_key = 0;
+
+    btree_fixture() {
+        std::mt19937_64 rnd(7);
+        std::vector<std::pair<uint64_t, uint64_t>> sorted;
+        sorted.reserve(population);
+        for (size_t i = 0; i < population; ++i) {
+            // even keys present, odd keys absent
+            sorted.emplace_back(i * 2, i);
+        }
+        tree.bulk_load(sorted.begin(), sorted.end());
+        stdmap.insert(sorted.begin(), sorted.end());
+        probe_keys.reserve(population);
+        for (size_t i = 0; i < population; ++i) {
+            probe_keys.push_back(rnd() % (population * 2));
+        }
+    }
+
+    uint64_t next_probe() {
+        auto k = probe_keys[probe_idx];
+        probe_idx = (probe_idx + 1) % probe_keys.size();
+        return k;
+    }
+};
+
+PERF_TEST_F(btree_fixture, flat_btree_lookup)
+{
+    auto it = tree.find(next_probe());
+    perf_tests::do_not_optimize(it);
+}
+
+PERF_TEST_F(btree_fixture, std_map_lookup)
+{
+    auto it = stdmap.find(next_probe());
+    perf_tests::do_not_optimize(it);
+}
+
+PERF_TEST_F(btree_fixture, flat_btree_lower_bound)
+{
+    auto it = tree.lower_bound(next_probe());
+    perf_tests::do_not_optimize(it);
+}
+
+PERF_TEST_F(btree_fixture, std_map_lower_bound)
+{
+    auto it = stdmap.lower_bound(next_probe());
+    perf_tests::do_not_optimize(it);
+}
+
+PERF_TEST_F(btree_fixture, flat_btree_insert_erase)
+{
+    // odd keys are absent from the prepopulated tree, so each round
+    // really inserts and removes
+    auto k = (insert_key++ % btree_fixture::population) * 2 + 1;
+    tree.insert(k, k);
+    tree.erase(k);
+    perf_tests::do_not_optimize(k);
+}
+
+PERF_TEST_F(btree_fixture, std_map_insert_erase)
+{
+    auto k = (insert_key++ % btree_fixture::population) * 2 + 1;
+    stdmap.emplace(k, k);
+    stdmap.erase(k);
+    perf_tests::do_not_optimize(k);
+}
+
+PERF_TEST_F(btree_fixture, flat_btree_scan_100)
+{
+    auto it = tree.lower_bound(next_probe());
+    uint64_t sum = 0;
+    for (unsigned i = 0; i < 100 && it != tree.end(); ++i, ++it) {
+        sum += it.mapped();
+    }
+    perf_tests::do_not_optimize(sum);
+}
+
+PERF_TEST_F(btree_fixture, std_map_scan_100)
+{
+    auto it = stdmap.lower_bound(next_probe());
+    uint64_t sum = 0;
+    for (unsigned i = 0; i < 100 && it != stdmap.end(); ++i, ++it) {
+        sum += it->second;
+    }
+    perf_tests::do_not_optimize(sum);
+}
@@ -75,3 +75,46 @@ PERF_TEST_F(parallel_for_each, suspend)
         perf_tests::do_not_optimize(value);
     });
 }
+
+struct max_concurrent_for_each {
+    std::vector<int> range;
+    int value;
+    size_t alive = 0;
+    // how many func invocations were in flight at once; with a window of
+    // n this stays at n, while parallel_for_each over the same range
+    // peaks at the full range size
+    size_t high_watermark = 0;
+
+    max_concurrent_for_each()
+        : range(boost::copy_range<std::vector<int>>(boost::irange(1, 10000)))
+    { }
+
+    future<> track(int v) {
+        alive++;
+        high_watermark = std::max(high_watermark, alive);
+        value += v;
+        return later().then([this] {
+            alive--;
+        });
+    }
+};
+
+PERF_TEST_F(max_concurrent_for_each, window_100)
+{
+    return seastar::max_concurrent_for_each(range, 100, [this] (int v) {
+        return track(v);
+    }).then([this] {
+        perf_tests::do_not_optimize(value);
+        perf_tests::do_not_optimize(high_watermark);
+    });
+}
+
+PERF_TEST_F(max_concurrent_for_each, unbounded)
+{
+    return seastar::parallel_for_each(range, [this] (int v) {
+        return track(v);
+    }).then([this] {
+        perf_tests::do_not_optimize(value);
+        perf_tests::do_not_optimize(high_watermark);
+    });
+}
@@ -21,6 +21,7 @@
 
 #include <seastar/testing/perf_tests.hh>
 
+#include <cmath>
 #include <fstream>
 #include <regex>
 
@@ -37,7 +38,11 @@
 #include <seastar/util/later.hh>
 #include <seastar/testing/random.hh>
 
+#include <linux/perf_event.h>
 #include <signal.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 namespace perf_tests {
 namespace internal {
@@ -106,6 +111,96 @@ private:
 
 }
 
+// Hardware event counters sampled around each run. Events that the
+// kernel or the (virtualised) PMU refuses to open are reported as
+// unavailable rather than failing the benchmark.
+class perf_event_counters {
+public:
+    struct event_info {
+        uint32_t type;
+        uint64_t config;
+        const char* name;
+    };
+
+    static constexpr event_info events[] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles" },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions" },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL
+                | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), "llc-misses" },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch-misses" },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB
+                | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), "dtlb-misses" },
+    };
+    static constexpr size_t nr_counters = std::size(events);
+
+    // counts for one run; NaN when the event is unavailable
+    using sample = std::array<double, nr_counters>;
+private:
+    std::array<int, nr_counters> _fds;
+private:
+    static int perf_event_open(perf_event_attr* attr) {
+        return syscall(SYS_perf_event_open, attr, 0, -1, -1, 0);
+    }
+public:
+    perf_event_counters() {
+        for (size_t i = 0; i < nr_counters; i++) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = events[i].type;
+            attr.config = events[i].config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            // scale for the time the event was actually on the PMU
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            _fds[i] = perf_event_open(&attr);
+        }
+    }
+
+    ~perf_event_counters() {
+        for (auto fd : _fds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    perf_event_counters(const perf_event_counters&) = delete;
+    perf_event_counters& operator=(const perf_event_counters&) = delete;
+
+    void reset_and_enable() {
+        for (auto fd : _fds) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    sample disable_and_read() {
+        sample s;
+        for (size_t i = 0; i < nr_counters; i++) {
+            s[i] = std::numeric_limits<double>::quiet_NaN();
+            if (_fds[i] < 0) {
+                continue;
+            }
+            ::ioctl(_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            struct {
+                uint64_t value;
+                uint64_t time_enabled;
+                uint64_t time_running;
+            } data;
+            if (::read(_fds[i], &data, sizeof(data)) != sizeof(data) || !data.time_running) {
+                continue;
+            }
+            s[i] = double(data.value) * double(data.time_enabled) / double(data.time_running);
+        }
+        return s;
+    }
+};
+
 time_measurement measure_time;
 
 struct config;
@@ -136,6 +231,9 @@ struct result {
     double mad;
     double min;
     double max;
+
+    // median per-operation hardware event counts, NaN when unavailable
+    perf_event_counters::sample counters;
 };
 
 namespace {
@@ -161,9 +259,24 @@ static inline std::ostream& operator<<(std::ostream& os, duration d)
     return os;
 }
 
+// a per-operation event count, possibly unavailable
+struct counter {
+    double value;
+};
+
+static inline std::ostream& operator<<(std::ostream& os, counter c)
+{
+    if (std::isnan(c.value)) {
+        os << "n/a";
+    } else {
+        os << fmt::format("{:.1f}", c.value);
+    }
+    return os;
 }
 
-static constexpr auto format_string = "{:<40} {:>11} {:>11} {:>11} {:>11} {:>11}\n";
+}
+
+static constexpr auto format_string = "{:<40} {:>11} {:>11} {:>11} {:>11} {:>11} {:>11} {:>12} {:>10} {:>9} {:>10}\n";
 
 struct stdout_printer final : result_printer {
   virtual void print_configuration(const config& c) override {
@@ -173,12 +286,15 @@ struct stdout_printer final : result_printer {
                "number of runs:", c.number_of_runs,
                "number of cores:", smp::count,
                "random seed:", c.random_seed);
-    fmt::print(format_string, "test", "iterations", "median", "mad", "min", "max");
+    fmt::print(format_string, "test", "iterations", "median", "mad", "min", "max",
+               "cycles", "instructions", "llc miss", "br miss", "dtlb miss");
   }
 
   virtual void print_result(const result& r) override {
     fmt::print(format_string, r.test_name, r.total_iterations / r.runs, duration { r.median },
-               duration { r.mad }, duration { r.min }, duration { r.max });
+               duration { r.mad }, duration { r.min }, duration { r.max },
+               counter { r.counters[0] }, counter { r.counters[1] }, counter { r.counters[2] },
+               counter { r.counters[3] }, counter { r.counters[4] });
   }
 };
 
@@ -205,6 +321,11 @@ public:
         result["mad"] = r.mad;
         result["min"] = r.min;
         result["max"] = r.max;
+        for (size_t i = 0; i < perf_event_counters::nr_counters; i++) {
+            if (!std::isnan(r.counters[i])) {
+                result[perf_event_counters::events[i].name] = r.counters[i];
+            }
+        }
     }
 };
 
@@ -232,15 +353,27 @@ void performance_test::do_run(const config& conf)
     }
 
     auto results = std::vector<double>(conf.number_of_runs);
+    // per-op counter values of the runs where the event was counted
+    auto counter_results = std::array<std::vector<double>, perf_event_counters::nr_counters>();
+    perf_event_counters counters;
     uint64_t total_iterations = 0;
     for (auto i = 0u; i < conf.number_of_runs; i++) {
         // switch out of seastar thread
         later().then([&] {
             _single_run_iterations = 0;
+            counters.reset_and_enable();
             return do_single_run().then([&] (clock_type::duration dt) {
+                // sampled around the whole run, so the loop framework is
+                // included, amortised over the iterations like the time is
+                auto sample = counters.disable_and_read();
                 double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count();
                 results[i] = ns / _single_run_iterations;
 
+                for (size_t c = 0; c < perf_event_counters::nr_counters; c++) {
+                    if (!std::isnan(sample[c])) {
+                        counter_results[c].push_back(sample[c] / _single_run_iterations);
+                    }
+                }
                 total_iterations += _single_run_iterations;
             });
         }).get();
@@ -265,6 +398,16 @@ void performance_test::do_run(const config& conf)
     r.min = results[0];
     r.max = results[results.size() - 1];
 
+    for (size_t c = 0; c < perf_event_counters::nr_counters; c++) {
+        auto& values = counter_results[c];
+        if (values.empty()) {
+            r.counters[c] = std::numeric_limits<double>::quiet_NaN();
+        } else {
+            boost::range::sort(values);
+            r.counters[c] = values[values.size() / 2];
+        }
+    }
+
     for (auto& rp : conf.printers) {
         rp->print_result(r);
     }
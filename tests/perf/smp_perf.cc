@@ -0,0 +1,138 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2026 ScyllaDB Ltd.
+ */
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/smp.hh>
+#include <boost/range/irange.hpp>
+
+// Exercises the cross-shard messaging paths: smp::submit_to round-trips,
+// smp_message_queue batching under pipelining, invoke_on_all and foreign_ptr
+// destruction. Shard distance matters here — with the usual cpuset layout the
+// next shard shares a core or at least a socket with us, while the shard
+// half-way around is the most distant one (the other socket on a two-node
+// machine) — so the interesting tests come in a "near" and a "far" flavour.
+// Run with all cpus (no -c/--smp override) for meaningful far numbers.
+struct perf_smp {
+    static constexpr unsigned pipeline_depth = 128;
+
+private:
+    smp_service_group _throttled_ssg = default_smp_service_group();
+
+protected:
+    static shard_id near_shard() {
+        return (this_shard_id() + 1) % smp::count;
+    }
+
+    static shard_id far_shard() {
+        return (this_shard_id() + smp::count / 2) % smp::count;
+    }
+
+    future<> round_trip(shard_id target) {
+        return smp::submit_to(target, [] {});
+    }
+
+    future<size_t> pipeline(shard_id target, unsigned depth, smp_service_group ssg) {
+        return parallel_for_each(boost::irange(0u, depth), [target, ssg] (unsigned) {
+            return smp::submit_to(target, smp_submit_to_options(ssg), [] {});
+        }).then([depth] {
+            return size_t(depth);
+        });
+    }
+
+    smp_service_group throttled_ssg() const noexcept { return _throttled_ssg; }
+
+public:
+    perf_smp() {
+        smp_service_group_config ssgc;
+        ssgc.max_nonlocal_requests = 8;
+        _throttled_ssg = create_smp_service_group(ssgc).get0();
+    }
+
+    ~perf_smp() {
+        destroy_smp_service_group(_throttled_ssg).get();
+    }
+};
+
+// Same-shard submit_to bypasses the message queue entirely; this is the
+// baseline the cross-shard numbers should be compared against.
+PERF_TEST_F(perf_smp, submit_to_local)
+{
+    return round_trip(this_shard_id());
+}
+
+PERF_TEST_F(perf_smp, submit_to_near)
+{
+    return round_trip(near_shard());
+}
+
+PERF_TEST_F(perf_smp, submit_to_far)
+{
+    return round_trip(far_shard());
+}
+
+// Pipelined submits amortise the wakeup and let smp_message_queue batch
+// completions; comparing depths shows how quickly the amortisation kicks in.
+PERF_TEST_F(perf_smp, pipeline_near_depth_16)
+{
+    return pipeline(near_shard(), 16, default_smp_service_group());
+}
+
+PERF_TEST_F(perf_smp, pipeline_near_depth_128)
+{
+    return pipeline(near_shard(), pipeline_depth, default_smp_service_group());
+}
+
+PERF_TEST_F(perf_smp, pipeline_far_depth_16)
+{
+    return pipeline(far_shard(), 16, default_smp_service_group());
+}
+
+PERF_TEST_F(perf_smp, pipeline_far_depth_128)
+{
+    return pipeline(far_shard(), pipeline_depth, default_smp_service_group());
+}
+
+// The throttled group caps in-flight nonlocal requests well below the
+// pipeline depth, so this measures the cost of taking and releasing the
+// smp_service_group semaphore under contention.
+PERF_TEST_F(perf_smp, pipeline_far_depth_128_throttled)
+{
+    return pipeline(far_shard(), pipeline_depth, throttled_ssg());
+}
+
+PERF_TEST_F(perf_smp, invoke_on_all)
+{
+    return smp::invoke_on_all([] {});
+}
+
+// Obtains a foreign_ptr from the far shard and drops it here; the drop
+// submits the deleter back to the owner, so one iteration is two messages
+// plus the allocation.
+PERF_TEST_F(perf_smp, foreign_ptr_round_trip)
+{
+    return smp::submit_to(far_shard(), [] {
+        return make_foreign(std::make_unique<unsigned>(0));
+    }).then([] (foreign_ptr<std::unique_ptr<unsigned>> p) {
+        perf_tests::do_not_optimize(*p);
+    });
+}
@@ -20,6 +20,8 @@
  * Copyright (C) 2018 Red Hat
  */
 
+#include <atomic>
+#include <functional>
 #include <future>
 #include <numeric>
 #include <iostream>
@@ -64,6 +66,19 @@ int main(int argc, char** argv)
                 return seastar::make_ready_future<int>(i);
             }));
         }
+        // send a batch of messages with a single wakeup.
+        std::atomic<int> batch_count{0};
+        std::promise<void> batch_done;
+        std::vector<std::function<void()>> batch;
+        for (int i = 0; i < 16; i++) {
+            batch.emplace_back([&batch_count] { ++batch_count; });
+        }
+        batch.emplace_back([&batch_done] { batch_done.set_value(); });
+        alien::run_batch_on(0, batch.begin(), batch.end());
+        batch_done.get_future().wait();
+        if (batch_count != 16) {
+            return -EINVAL;
+        }
         // std::future<void>
         alien::submit_to(0, [] {
             return seastar::make_ready_future<>();
@@ -53,6 +53,32 @@ SEASTAR_TEST_CASE(alloc_almost_all_and_realloc_it_with_a_smaller_size) {
     return make_ready_future<>();
 }
 
+SEASTAR_TEST_CASE(try_extend_large_allocation) {
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    // Whether in-place extension succeeds depends on the heap layout,
+    // so check the invariants rather than the outcome.
+    size_t sz = 128 * 1024;
+    auto obj = static_cast<char*>(malloc(sz));
+    BOOST_REQUIRE(obj != nullptr);
+    std::memset(obj, 0x5a, sz);
+    if (memory::try_extend(obj, sz * 2)) {
+        // The extended area must be usable, and the contents must not
+        // have moved
+        std::memset(obj + sz, 0x5a, sz);
+        sz *= 2;
+    }
+    for (size_t i = 0; i < sz; i++) {
+        BOOST_REQUIRE_EQUAL(obj[i], 0x5a);
+    }
+    free(obj);
+    // A small-pool object never extends in place
+    auto small = malloc(64);
+    BOOST_REQUIRE(!memory::try_extend(small, 128 * 1024));
+    free(small);
+#endif
+    return make_ready_future<>();
+}
+
 SEASTAR_TEST_CASE(malloc_0_and_free_it) {
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
     auto obj = malloc(0);
@@ -115,6 +141,29 @@ SEASTAR_TEST_CASE(test_memory_diagnostics) {
     return make_ready_future<>();
 }
 
+SEASTAR_TEST_CASE(test_layout_diagnostics) {
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    auto old_rate = memory::sampled_memory_profiling_rate();
+    memory::set_sampled_memory_profiling_rate(4096);
+    memory::set_layout_diagnostics_enabled(true);
+    BOOST_REQUIRE(memory::layout_diagnostics_enabled());
+    std::vector<std::unique_ptr<char[]>> allocs;
+    for (int i = 0; i < 1000; ++i) {
+        allocs.push_back(std::make_unique<char[]>(512));
+    }
+    allocs.clear();
+    // the report is unstructured text; check that the diagnostics
+    // sections are rendered while the mode is on
+    auto report = memory::generate_memory_diagnostics_report();
+    BOOST_REQUIRE(report.find("Sampled remote-free sites") != sstring::npos);
+    BOOST_REQUIRE(report.find("shared across scheduling groups") != sstring::npos);
+    memory::set_layout_diagnostics_enabled(false);
+    memory::set_sampled_memory_profiling_rate(old_rate);
+    BOOST_REQUIRE(!memory::layout_diagnostics_enabled());
+#endif
+    return make_ready_future<>();
+}
+
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
 
 struct thread_alloc_info {
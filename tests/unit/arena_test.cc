@@ -0,0 +1,96 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#define BOOST_TEST_MODULE util
+
+#include <boost/test/included/unit_test.hpp>
+#include <seastar/util/arena.hh>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace seastar;
+
+BOOST_AUTO_TEST_CASE(test_alignment_is_honored) {
+    arena a;
+    for (size_t alignment : { 1, 2, 8, 16, 64, 4096 }) {
+        auto p = a.alloc(3, alignment);
+        BOOST_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(p) % alignment, 0u);
+        std::memset(p, 0xab, 3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_reset_reuses_chunks) {
+    arena a;
+    auto p1 = a.alloc(100);
+    std::memset(p1, 0xab, 100);
+    a.reset();
+    auto p2 = a.alloc(100);
+    BOOST_REQUIRE_EQUAL(p1, p2);
+}
+
+BOOST_AUTO_TEST_CASE(test_allocations_do_not_overlap) {
+    arena a(1024); // small chunks to exercise the chunk chain
+    std::vector<std::pair<char*, size_t>> allocations;
+    for (size_t i = 1; i < 500; ++i) {
+        auto size = i % 97 + 1;
+        auto p = static_cast<char*>(a.alloc(size, 8));
+        std::memset(p, i & 0xff, size);
+        allocations.emplace_back(p, size);
+    }
+    for (size_t i = 0; i < allocations.size(); ++i) {
+        auto [p, size] = allocations[i];
+        for (size_t j = 0; j < size; ++j) {
+            BOOST_REQUIRE_EQUAL(uint8_t(p[j]), uint8_t((i + 1) & 0xff));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_oversized_allocation) {
+    arena a(1024);
+    auto p = static_cast<char*>(a.alloc(1024 * 1024));
+    std::memset(p, 0xcd, 1024 * 1024);
+    // the arena keeps working past an oversized chunk
+    auto q = a.alloc(16);
+    BOOST_REQUIRE(q != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_make_constructs_in_arena) {
+    struct point {
+        int x, y;
+    };
+    arena a;
+    auto p = a.make<point>(2, 3);
+    BOOST_REQUIRE_EQUAL(p->x, 2);
+    BOOST_REQUIRE_EQUAL(p->y, 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_stl_adaptor) {
+    arena a;
+    std::vector<int, arena_allocator<int>> v{arena_allocator<int>(a)};
+    for (int i = 0; i < 10000; ++i) {
+        v.push_back(i);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        BOOST_REQUIRE_EQUAL(v[i], i);
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2026 ScyllaDB Ltd.
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/included/unit_test.hpp>
+#include <seastar/core/chunked_vector.hh>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace seastar;
+
+template <typename CV, typename Ref>
+static void require_same(const CV& cv, const Ref& ref) {
+    BOOST_REQUIRE_EQUAL(cv.size(), ref.size());
+    BOOST_REQUIRE_EQUAL(cv.empty(), ref.empty());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(cv[i], ref[i]);
+    }
+    BOOST_REQUIRE(std::equal(cv.begin(), cv.end(), ref.begin(), ref.end()));
+}
+
+BOOST_AUTO_TEST_CASE(chunked_vector_small) {
+    chunked_vector<int> v;
+    BOOST_REQUIRE_EQUAL(v.size(), 0u);
+    BOOST_REQUIRE(v.empty());
+    v.push_back(3);
+    BOOST_REQUIRE_EQUAL(v.size(), 1u);
+    BOOST_REQUIRE_EQUAL(v.front(), 3);
+    BOOST_REQUIRE_EQUAL(v.back(), 3);
+    v.push_back(17);
+    BOOST_REQUIRE_EQUAL(v[0], 3);
+    BOOST_REQUIRE_EQUAL(v[1], 17);
+    BOOST_REQUIRE_EQUAL(v.back(), 17);
+    v[0] = 4;
+    BOOST_REQUIRE_EQUAL(v.front(), 4);
+    v.pop_back();
+    BOOST_REQUIRE_EQUAL(v.size(), 1u);
+    BOOST_REQUIRE_EQUAL(v.back(), 4);
+    v.clear();
+    BOOST_REQUIRE(v.empty());
+    v.push_back(8);
+    BOOST_REQUIRE_EQUAL(v[0], 8);
+}
+
+BOOST_AUTO_TEST_CASE(chunked_vector_random_ops_match_std_vector) {
+    // Small chunks, so that the test crosses many chunk boundaries.
+    chunked_vector<int, 64> v;
+    std::vector<int> ref;
+    std::mt19937 rnd(1);
+    for (int round = 0; round < 50000; ++round) {
+        int op = rnd() % 10;
+        if (op < 6) {
+            v.push_back(round);
+            ref.push_back(round);
+        } else if (op < 8 && !ref.empty()) {
+            v.pop_back();
+            ref.pop_back();
+        } else if (op == 8) {
+            size_t n = rnd() % 200;
+            v.resize(n);
+            ref.resize(n);
+        } else {
+            v.reserve(rnd() % 500);
+        }
+        BOOST_REQUIRE(v.capacity() >= v.size());
+        if (round % 5000 == 0) {
+            require_same(v, ref);
+        }
+    }
+    require_same(v, ref);
+}
+
+BOOST_AUTO_TEST_CASE(chunked_vector_random_access_iterator) {
+    chunked_vector<int, 64> v;
+    std::vector<int> ref;
+    std::mt19937 rnd(2);
+    for (int i = 0; i < 10000; ++i) {
+        int x = rnd();
+        v.push_back(x);
+        ref.push_back(x);
+    }
+    // std::sort requires a genuine random-access iterator
+    std::sort(v.begin(), v.end());
+    std::sort(ref.begin(), ref.end());
+    require_same(v, ref);
+    auto it = std::lower_bound(v.begin(), v.end(), ref[5000]);
+    BOOST_REQUIRE_EQUAL(it - v.begin(), std::lower_bound(ref.begin(), ref.end(), ref[5000]) - ref.begin());
+    BOOST_REQUIRE_EQUAL(*(v.begin() + 42), ref[42]);
+    chunked_vector<int, 64>::const_iterator ci = v.begin();
+    BOOST_REQUIRE_EQUAL(*ci, ref[0]);
+}
+
+BOOST_AUTO_TEST_CASE(chunked_vector_full_chunks_do_not_move) {
+    // 64 ints per chunk; once a chunk fills up, its elements stay put
+    // no matter how much the vector grows.
+    chunked_vector<int, 256> v;
+    for (int i = 0; i < 64; ++i) {
+        v.push_back(i);
+    }
+    auto p0 = &v[0];
+    auto p63 = &v[63];
+    for (int i = 64; i < 100000; ++i) {
+        v.push_back(i);
+    }
+    BOOST_REQUIRE_EQUAL(p0, &v[0]);
+    BOOST_REQUIRE_EQUAL(p63, &v[63]);
+    BOOST_REQUIRE_EQUAL(v[99999], 99999);
+    // with reserve() up front, nothing moves at all
+    chunked_vector<int, 256> r;
+    r.reserve(1000);
+    r.push_back(0);
+    auto q = &r[0];
+    for (int i = 1; i < 1000; ++i) {
+        r.push_back(i);
+    }
+    BOOST_REQUIRE_EQUAL(q, &r[0]);
+}
+
+BOOST_AUTO_TEST_CASE(chunked_vector_nontrivial_and_copies) {
+    chunked_vector<std::string, 512> v;
+    std::vector<std::string> ref;
+    for (int i = 0; i < 3000; ++i) {
+        auto s = std::to_string(i) + std::string(i % 40, 's');
+        v.emplace_back(s);
+        ref.push_back(s);
+    }
+    require_same(v, ref);
+    auto copy = v;
+    require_same(copy, ref);
+    auto moved = std::move(v);
+    require_same(moved, ref);
+    BOOST_REQUIRE(v.empty());
+    v = copy;
+    require_same(v, ref);
+    copy = std::move(moved);
+    require_same(copy, ref);
+    chunked_vector<std::string, 512> sized(100);
+    BOOST_REQUIRE_EQUAL(sized.size(), 100u);
+    BOOST_REQUIRE(sized[50].empty());
+}
@@ -107,3 +107,36 @@ BOOST_AUTO_TEST_CASE(test_erasing_in_the_middle) {
     BOOST_REQUIRE_EQUAL(*i++, 9);
     BOOST_REQUIRE(i == buf.end());
 }
+
+BOOST_AUTO_TEST_CASE(test_reserve_partial) {
+    circular_buffer<int> buf;
+
+    // Wrap the live range around the end of the storage, so growth has
+    // to relocate it
+    for (int i = 0; i < 16; ++i) {
+        buf.push_back(0);
+    }
+    for (int i = 0; i < 12; ++i) {
+        buf.pop_front();
+    }
+    for (int i = 0; i < 8; ++i) {
+        buf.push_back(i + 4);
+    }
+    for (int i = 0; i < 4; ++i) {
+        buf[i] = i;
+    }
+
+    // Grow to the target in bounded steps
+    unsigned steps = 0;
+    while (!buf.reserve_partial(4096)) {
+        BOOST_REQUIRE(++steps < 100);
+    }
+    BOOST_REQUIRE(buf.capacity() >= 4096);
+    BOOST_REQUIRE_EQUAL(buf.size(), 12u);
+    for (int i = 0; i < 12; ++i) {
+        BOOST_REQUIRE_EQUAL(buf[i], i);
+    }
+
+    // An already-satisfied reservation completes immediately
+    BOOST_REQUIRE(buf.reserve_partial(16));
+}
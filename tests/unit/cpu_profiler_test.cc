@@ -0,0 +1,48 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/cpu_profiler.hh>
+#include <chrono>
+
+using namespace seastar;
+using namespace std::chrono_literals;
+
+SEASTAR_THREAD_TEST_CASE(test_cpu_profiler_collects_samples) {
+    enable_cpu_profiler(1ms);
+    // burn enough cpu time for a few sampling periods to elapse
+    auto deadline = std::chrono::steady_clock::now() + 500ms;
+    volatile uint64_t sink = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        sink = sink + 1;
+    }
+    disable_cpu_profiler();
+
+    auto profile = dump_cpu_profile();
+    BOOST_REQUIRE(!profile.empty());
+    // every line is "frame;frame;... count"
+    auto space = profile.find(' ');
+    auto newline = profile.find('\n');
+    BOOST_REQUIRE(space != sstring::npos);
+    BOOST_REQUIRE(newline != sstring::npos);
+    BOOST_REQUIRE_LT(space, newline);
+    BOOST_REQUIRE_EQUAL(profile.back(), '\n');
+}
@@ -77,3 +77,43 @@ BOOST_AUTO_TEST_CASE(test_deleter_append_same_shared_object_twice) {
     }
     BOOST_REQUIRE(TestObject::deletions_called == 1);
 }
+
+BOOST_AUTO_TEST_CASE(test_inline_deleter_runs_action_once) {
+    int calls = 0;
+    auto action = [&calls] { ++calls; };
+    static_assert(deleter::can_be_inlined<decltype(action)>,
+            "small lambda should be stored inline");
+    {
+        deleter del1 = make_deleter(action);
+        deleter del2 = std::move(del1);
+        BOOST_REQUIRE(!del1);
+        BOOST_REQUIRE(calls == 0);
+    }
+    BOOST_REQUIRE(calls == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_inline_deleter_share_defers_action) {
+    int calls = 0;
+    {
+        deleter shared;
+        {
+            deleter del = make_deleter([&calls] { ++calls; });
+            shared = del.share();
+        }
+        BOOST_REQUIRE(calls == 0);
+    }
+    BOOST_REQUIRE(calls == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_inline_deleter_append) {
+    int calls = 0;
+    auto increment = [&calls] { ++calls; };
+    {
+        deleter tested = make_deleter(increment);
+        tested.append(make_deleter(increment));
+        tested.append(make_free_deleter(malloc(16)));
+        tested.append(make_deleter(increment));
+        BOOST_REQUIRE(calls == 0);
+    }
+    BOOST_REQUIRE(calls == 3);
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/with_scheduling_group.hh>
+#include <seastar/net/egress.hh>
+#include <seastar/net/packet.hh>
+#include <seastar/util/defer.hh>
+#include <boost/range/irange.hpp>
+
+using namespace seastar;
+
+namespace {
+
+// Sink that counts the bytes it receives.
+class counting_sink_impl final : public data_sink_impl {
+    size_t& _bytes;
+public:
+    explicit counting_sink_impl(size_t& bytes) : _bytes(bytes) {}
+    virtual future<> put(net::packet data) override {
+        _bytes += data.len();
+        return make_ready_future<>();
+    }
+    virtual future<> close() override {
+        return make_ready_future<>();
+    }
+};
+
+net::packet make_packet(size_t len) {
+    temporary_buffer<char> buf(len);
+    std::fill_n(buf.get_write(), len, 'x');
+    return net::packet(net::fragment{buf.get_write(), buf.size()}, buf.release());
+}
+
+}
+
+SEASTAR_THREAD_TEST_CASE(test_egress_scheduler_passes_all_bytes) {
+    net::egress_scheduler sched;
+    size_t bytes = 0;
+    auto sink = sched.wrap(data_sink(std::make_unique<counting_sink_impl>(bytes)));
+    constexpr int nr_packets = 64;
+    constexpr size_t packet_size = 4096;
+    parallel_for_each(boost::irange(0, nr_packets), [&] (int) {
+        return sink.put(make_packet(packet_size));
+    }).get();
+    sink.close().get();
+    BOOST_REQUIRE_EQUAL(bytes, nr_packets * packet_size);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_egress_scheduler_two_groups) {
+    // Saturate the scheduler's in-flight byte budget from two groups
+    // with different shares; all writes must still drain.
+    net::egress_scheduler::config cfg;
+    cfg.max_requests = 4;
+    cfg.max_bytes = 64 * 1024;
+    net::egress_scheduler sched(cfg);
+
+    auto bulk = create_scheduling_group("bulk", 100).get0();
+    auto rpc = create_scheduling_group("rpc", 100).get0();
+    auto cleanup = defer([&] {
+        destroy_scheduling_group(bulk).get();
+        destroy_scheduling_group(rpc).get();
+    });
+    sched.update_shares(bulk, 10);
+    sched.update_shares(rpc, 1000);
+
+    size_t bytes = 0;
+    auto sink = sched.wrap(data_sink(std::make_unique<counting_sink_impl>(bytes)));
+    auto writer = [&sink] (size_t packet_size, int nr) {
+        return parallel_for_each(boost::irange(0, nr), [&sink, packet_size] (int) {
+            return sink.put(make_packet(packet_size));
+        });
+    };
+    auto bulk_done = with_scheduling_group(bulk, [&] { return writer(128 * 1024, 16); });
+    auto rpc_done = with_scheduling_group(rpc, [&] { return writer(128, 256); });
+    bulk_done.get();
+    rpc_done.get();
+    sink.close().get();
+    BOOST_REQUIRE_EQUAL(bytes, 16 * 128 * 1024 + 256 * 128);
+}
@@ -332,3 +332,28 @@ SEASTAR_THREAD_TEST_CASE(test_inheriting_concrete_execution_stage_reference_para
     a_struct obj;
     es(seastar::ref(obj), &obj).get();
 }
+
+SEASTAR_TEST_CASE(test_batch_duration_limit) {
+    return seastar::async([] {
+        auto stage = seastar::make_execution_stage("test", [] { });
+        stage.set_max_batch_duration(1ns);
+
+        auto run_wave = [&] {
+            auto fs = std::vector<future<>>();
+            for (auto i = 0u; i < 100u; i++) {
+                fs.emplace_back(stage());
+            }
+            for (auto&& f : fs) {
+                f.get();
+            }
+        };
+        // The first wave may execute entirely in one batch (the limit only
+        // kicks in once a cost estimate exists); by the second wave the
+        // 1ns budget must be cutting batches short.
+        run_wave();
+        run_wave();
+
+        BOOST_REQUIRE_EQUAL(stage.get_stats().function_calls_executed, 200u);
+        BOOST_REQUIRE_GE(stage.get_stats().batch_limit_reached, 1u);
+    });
+}
@@ -188,3 +188,35 @@ SEASTAR_TEST_CASE(test_expiry_operations) {
         BOOST_REQUIRE_EQUAL(fifo.size(), 0u);
     });
 }
+
+SEASTAR_TEST_CASE(test_popping_armed_entries_before_expiry) {
+    return seastar::async([] {
+        std::vector<int> expired;
+        expiring_fifo<int, std::function<void (int&)>, manual_clock> fifo([&expired] (int& v) {
+            expired.push_back(v);
+        });
+
+        // Pop entries that are still awaiting expiry; the pending timer
+        // may then fire with nothing overdue, which must be harmless.
+        fifo.push_back(1, manual_clock::now() + 1s);
+        fifo.push_back(2, manual_clock::now() + 2s);
+        fifo.pop_front();
+        fifo.pop_front();
+        BOOST_REQUIRE(fifo.empty());
+
+        manual_clock::advance(3s);
+        later().get();
+
+        BOOST_REQUIRE(expired.empty());
+        BOOST_REQUIRE(fifo.empty());
+
+        // The container keeps working afterwards
+        fifo.push_back(3, manual_clock::now() + 1s);
+        manual_clock::advance(1s);
+        later().get();
+
+        BOOST_REQUIRE_EQUAL(expired.size(), 1u);
+        BOOST_REQUIRE_EQUAL(expired[0], 3);
+        BOOST_REQUIRE(fifo.empty());
+    });
+}
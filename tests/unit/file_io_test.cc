@@ -28,10 +28,12 @@
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/file.hh>
 #include <seastar/core/layered_file.hh>
+#include <seastar/core/cached_file.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/core/stall_sampler.hh>
 #include <seastar/core/aligned_buffer.hh>
 #include <seastar/core/io_intent.hh>
+#include <seastar/core/when_all.hh>
 #include <seastar/util/tmp_file.hh>
 #include <seastar/util/alloc_failure_injector.hh>
 #include <seastar/util/closeable.hh>
@@ -207,6 +209,118 @@ SEASTAR_TEST_CASE(parallel_write_fsync) {
     });
 }
 
+SEASTAR_TEST_CASE(concurrent_flush_group_commit) {
+    return tmp_dir::do_with_thread([] (tmp_dir& t) {
+        // Issue many overlapping flushes; they are coalesced into a few
+        // fdatasyncs and must all complete successfully.
+        auto fname = (t.get_path() / "testfile.tmp").native();
+        file f = open_file_dma(fname, open_flags::rw | open_flags::create | open_flags::truncate).get0();
+        auto close_f = deferred_close(f);
+
+        auto buf = temporary_buffer<char>::aligned(f.memory_dma_alignment(), 4096);
+        memset(buf.get_write(), 'x', buf.size());
+
+        for (auto round = 0; round < 4; round++) {
+            f.dma_write(round * buf.size(), buf.get(), buf.size()).get();
+            std::vector<future<>> flushes;
+            for (auto i = 0; i < 16; i++) {
+                flushes.push_back(f.flush());
+            }
+            when_all_succeed(flushes.begin(), flushes.end()).get();
+        }
+
+        close_f.close_now();
+        remove_file(fname).get();
+    });
+}
+
+SEASTAR_TEST_CASE(test_cached_file) {
+    return tmp_dir::do_with_thread([] (tmp_dir& t) {
+        auto fname = (t.get_path() / "testfile.tmp").native();
+        file uf = open_file_dma(fname, open_flags::rw | open_flags::create | open_flags::truncate).get0();
+
+        constexpr size_t file_size = 32768;
+        constexpr size_t block = 4096;
+        auto wbuf = temporary_buffer<unsigned char>::aligned(uf.memory_dma_alignment(), file_size);
+        for (size_t i = 0; i < file_size; i++) {
+            wbuf.get_write()[i] = i / block;
+        }
+        uf.dma_write(0, wbuf.get(), file_size).get();
+        uf.flush().get();
+
+        auto stats = make_lw_shared<cached_file_stats>();
+        cached_file_options opts;
+        opts.cache_size = 4 * block;
+        opts.block_size = block;
+        opts.stats = stats;
+        file cf = make_cached_file(uf, opts);
+        auto close_cf = deferred_close(cf);
+
+        // The first read populates the cache, the second is served from it
+        auto b1 = cf.dma_read_bulk<unsigned char>(0, block).get0();
+        BOOST_REQUIRE_EQUAL(stats->misses, 1u);
+        auto b2 = cf.dma_read_bulk<unsigned char>(0, block).get0();
+        BOOST_REQUIRE_EQUAL(stats->hits, 1u);
+        BOOST_REQUIRE(!memcmp(b1.get(), wbuf.get(), block));
+        BOOST_REQUIRE(!memcmp(b2.get(), wbuf.get(), block));
+
+        // Writing through the wrapper invalidates the overlapping block
+        cf.dma_write(0, wbuf.get() + block, block).get();
+        BOOST_REQUIRE_EQUAL(stats->invalidations, 1u);
+        auto b3 = cf.dma_read_bulk<unsigned char>(0, block).get0();
+        BOOST_REQUIRE_EQUAL(stats->misses, 2u);
+        BOOST_REQUIRE(!memcmp(b3.get(), wbuf.get() + block, block));
+
+        // The size bound holds no matter how much is read
+        for (uint64_t off = 0; off < file_size; off += block) {
+            cf.dma_read_bulk<unsigned char>(off, block).get0();
+        }
+        BOOST_REQUIRE(stats->cached_bytes <= opts.cache_size);
+        BOOST_REQUIRE(stats->evictions > 0);
+
+        close_cf.close_now();
+        remove_file(fname).get();
+    });
+}
+
+SEASTAR_TEST_CASE(test_dma_read_bulk_vectored) {
+    return tmp_dir::do_with_thread([] (tmp_dir& t) {
+        auto fname = (t.get_path() / "testfile.tmp").native();
+        file f = open_file_dma(fname, open_flags::rw | open_flags::create | open_flags::truncate).get0();
+        auto close_f = deferred_close(f);
+
+        constexpr size_t file_size = 65536;
+        auto wbuf = temporary_buffer<unsigned char>::aligned(f.memory_dma_alignment(), file_size);
+        for (size_t i = 0; i < file_size; i++) {
+            wbuf.get_write()[i] = i & 0xff;
+        }
+        f.dma_write(0, wbuf.get(), file_size).get();
+        f.flush().get();
+
+        // Unsorted, unaligned and partially overlapping extents, plus one
+        // crossing the end of the file and one fully past it
+        std::vector<file::extent> extents = {
+            { 40000, 100 },
+            { 3, 17 },
+            { 10, 200 },
+            { 4096, 4096 },
+            { file_size - 50, 200 },
+            { file_size + 1000, 10 },
+        };
+        auto bufs = f.dma_read_bulk_vectored<unsigned char>(extents).get0();
+        BOOST_REQUIRE_EQUAL(bufs.size(), extents.size());
+        for (size_t i = 0; i < extents.size(); i++) {
+            auto& e = extents[i];
+            size_t expected = e.offset >= file_size ? 0 : std::min<size_t>(e.length, file_size - e.offset);
+            BOOST_REQUIRE_EQUAL(bufs[i].size(), expected);
+            BOOST_REQUIRE(!memcmp(bufs[i].get(), wbuf.get() + e.offset, expected));
+        }
+
+        close_f.close_now();
+        remove_file(fname).get();
+    });
+}
+
 SEASTAR_TEST_CASE(test_iov_max) {
   return tmp_dir::do_with_thread([] (tmp_dir& t) {
     static constexpr size_t buffer_size = 4096;
@@ -699,6 +813,38 @@ SEASTAR_TEST_CASE(test_destruct_just_constructed_append_challenged_file_with_slo
     });
 }
 
+SEASTAR_TEST_CASE(test_append_challenged_file_with_preallocation) {
+    return tmp_dir::do_with_thread([] (tmp_dir& t) {
+        sstring filename = (t.get_path() / "testfile.tmp").native();
+        file_open_options opt;
+        opt.append_preallocation_size = 128 << 10;
+        auto f = open_file_dma(filename, open_flags::rw | open_flags::create, opt).get0();
+
+        // Append well past the first preallocation chunk; the space ahead
+        // of the frontier must stay invisible to size() and reads.
+        constexpr size_t buffer_size = 4096;
+        constexpr unsigned buffer_count = 48;
+        auto wbuf = allocate_aligned_buffer<unsigned char>(buffer_size, buffer_size);
+        for (auto i = 0u; i < buffer_count; i++) {
+            std::fill_n(wbuf.get(), buffer_size, (unsigned char)i);
+            BOOST_REQUIRE_EQUAL(f.dma_write(i * buffer_size, wbuf.get(), buffer_size).get0(), buffer_size);
+            BOOST_REQUIRE_EQUAL(f.size().get0(), (i + 1) * buffer_size);
+        }
+        f.flush().get();
+        f.close().get();
+
+        // The unused preallocated tail is returned at close
+        f = open_file_dma(filename, open_flags::rw).get0();
+        BOOST_REQUIRE_EQUAL(f.size().get0(), buffer_count * buffer_size);
+        auto rbuf = allocate_aligned_buffer<unsigned char>(buffer_size, buffer_size);
+        for (auto i = 0u; i < buffer_count; i++) {
+            BOOST_REQUIRE_EQUAL(f.dma_read(i * buffer_size, rbuf.get(), buffer_size).get0(), buffer_size);
+            BOOST_REQUIRE_EQUAL(rbuf.get()[0], (unsigned char)i);
+        }
+        f.close().get();
+    });
+}
+
 SEASTAR_TEST_CASE(test_destruct_append_challenged_file_after_write) {
     return tmp_dir::do_with_thread([] (tmp_dir& t) {
         sstring filename = (t.get_path() / "testfile.tmp").native();
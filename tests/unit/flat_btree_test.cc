@@ -0,0 +1,186 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2026 ScyllaDB Ltd.
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/included/unit_test.hpp>
+#include <seastar/core/flat_btree.hh>
+#include <map>
+#include <random>
+#include <string>
+
+using namespace seastar;
+
+// Verifies that the tree holds exactly the same elements, in the same
+// order, as the reference std::map.
+template <typename K, typename V>
+static void require_same(const flat_btree_map<K, V>& tree, const std::map<K, V>& ref) {
+    BOOST_REQUIRE_EQUAL(tree.size(), ref.size());
+    BOOST_REQUIRE_EQUAL(tree.empty(), ref.empty());
+    auto it = tree.begin();
+    for (auto& [k, v] : ref) {
+        BOOST_REQUIRE(it != tree.end());
+        BOOST_REQUIRE_EQUAL(it.key(), k);
+        BOOST_REQUIRE_EQUAL(it.mapped(), v);
+        ++it;
+    }
+    BOOST_REQUIRE(it == tree.end());
+}
+
+BOOST_AUTO_TEST_CASE(flat_btree_small) {
+    // A few elements, everything in the root leaf.
+    flat_btree_map<int, int> tree;
+    BOOST_REQUIRE_EQUAL(tree.size(), 0u);
+    BOOST_REQUIRE(tree.empty());
+    BOOST_REQUIRE(tree.find(1) == tree.end());
+    BOOST_REQUIRE(tree.insert(3, 30).second);
+    BOOST_REQUIRE(tree.insert(1, 10).second);
+    BOOST_REQUIRE(tree.insert(2, 20).second);
+    // duplicate insertion leaves the old value in place
+    auto [it, inserted] = tree.insert(2, 99);
+    BOOST_REQUIRE(!inserted);
+    BOOST_REQUIRE_EQUAL(it.mapped(), 20);
+    BOOST_REQUIRE_EQUAL(tree.size(), 3u);
+    BOOST_REQUIRE_EQUAL(tree.find(1).mapped(), 10);
+    BOOST_REQUIRE_EQUAL(tree.find(3).mapped(), 30);
+    // elements come out in key order regardless of insertion order
+    int expected = 1;
+    for (auto it2 = tree.begin(); it2 != tree.end(); ++it2) {
+        BOOST_REQUIRE_EQUAL(it2.key(), expected);
+        BOOST_REQUIRE_EQUAL(it2.mapped(), expected * 10);
+        ++expected;
+    }
+    BOOST_REQUIRE_EQUAL(tree.erase(2), 1u);
+    BOOST_REQUIRE_EQUAL(tree.erase(2), 0u);
+    BOOST_REQUIRE(tree.find(2) == tree.end());
+    BOOST_REQUIRE_EQUAL(tree.size(), 2u);
+    tree.clear();
+    BOOST_REQUIRE(tree.empty());
+    BOOST_REQUIRE(tree.begin() == tree.end());
+}
+
+BOOST_AUTO_TEST_CASE(flat_btree_lower_bound) {
+    flat_btree_map<int, int> tree;
+    BOOST_REQUIRE(tree.lower_bound(0) == tree.end());
+    for (int i = 0; i < 1000; i += 2) {
+        tree.insert(i, i);
+    }
+    BOOST_REQUIRE_EQUAL(tree.lower_bound(0).key(), 0);
+    BOOST_REQUIRE_EQUAL(tree.lower_bound(41).key(), 42);
+    BOOST_REQUIRE_EQUAL(tree.lower_bound(42).key(), 42);
+    BOOST_REQUIRE_EQUAL(tree.lower_bound(-5).key(), 0);
+    BOOST_REQUIRE(tree.lower_bound(999) == tree.end());
+    // a range scan from a lower bound walks the leaf chain in order
+    int expected = 500;
+    for (auto it = tree.lower_bound(499); it != tree.end(); ++it) {
+        BOOST_REQUIRE_EQUAL(it.key(), expected);
+        expected += 2;
+    }
+    BOOST_REQUIRE_EQUAL(expected, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(flat_btree_random_ops_match_std_map) {
+    // Drive the tree through enough insertions and removals to split and
+    // empty nodes at every level, checking against std::map throughout.
+    flat_btree_map<int, int> tree;
+    std::map<int, int> ref;
+    std::mt19937 rnd(1);
+    for (int round = 0; round < 100000; ++round) {
+        int k = rnd() % 3000;
+        if (rnd() % 2) {
+            auto [it, inserted] = tree.insert(k, round);
+            auto [rit, rinserted] = ref.emplace(k, round);
+            BOOST_REQUIRE_EQUAL(inserted, rinserted);
+            BOOST_REQUIRE_EQUAL(it.mapped(), rit->second);
+        } else {
+            BOOST_REQUIRE_EQUAL(tree.erase(k), ref.erase(k));
+        }
+        if (round % 10000 == 0) {
+            require_same(tree, ref);
+        }
+    }
+    require_same(tree, ref);
+    // drain through erase(iterator)
+    while (!tree.empty()) {
+        auto it = tree.begin();
+        ref.erase(it.key());
+        auto next = tree.erase(it);
+        BOOST_REQUIRE((next == tree.end()) == ref.empty());
+        if (!ref.empty()) {
+            BOOST_REQUIRE_EQUAL(next.key(), ref.begin()->first);
+        }
+    }
+    require_same(tree, ref);
+}
+
+BOOST_AUTO_TEST_CASE(flat_btree_bulk_load) {
+    for (size_t n : {size_t(0), size_t(1), size_t(17), size_t(1000), size_t(54321)}) {
+        std::map<int, long> ref;
+        for (size_t i = 0; i < n; ++i) {
+            ref.emplace(int(i * 3), long(i));
+        }
+        flat_btree_map<int, long> tree;
+        tree.bulk_load(ref.begin(), ref.end());
+        require_same(tree, ref);
+        // a bulk-loaded tree accepts further mutation
+        for (size_t i = 0; i < n; i += 5) {
+            BOOST_REQUIRE_EQUAL(tree.erase(int(i * 3)), ref.erase(int(i * 3)));
+            tree.insert(int(i * 3 + 1), -long(i));
+            ref.emplace(int(i * 3 + 1), -long(i));
+        }
+        require_same(tree, ref);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(flat_btree_nontrivial_types) {
+    flat_btree_map<std::string, std::string> tree;
+    std::map<std::string, std::string> ref;
+    std::mt19937 rnd(2);
+    for (int round = 0; round < 10000; ++round) {
+        auto k = std::to_string(rnd() % 500) + std::string(rnd() % 30, 'k');
+        if (rnd() % 3) {
+            tree.insert(k, k + "-value");
+            ref.emplace(k, k + "-value");
+        } else {
+            BOOST_REQUIRE_EQUAL(tree.erase(k), ref.erase(k));
+        }
+    }
+    require_same(tree, ref);
+}
+
+BOOST_AUTO_TEST_CASE(flat_btree_move) {
+    flat_btree_map<int, int> a;
+    for (int i = 0; i < 1000; ++i) {
+        a.insert(i, i);
+    }
+    flat_btree_map<int, int> b(std::move(a));
+    BOOST_REQUIRE_EQUAL(b.size(), 1000u);
+    BOOST_REQUIRE(a.empty());
+    flat_btree_map<int, int> c;
+    c.insert(-1, -1);
+    c = std::move(b);
+    BOOST_REQUIRE_EQUAL(c.size(), 1000u);
+    BOOST_REQUIRE(c.find(-1) == c.end());
+    BOOST_REQUIRE_EQUAL(c.find(500).mapped(), 500);
+    // iterator converts to const_iterator
+    flat_btree_map<int, int>::const_iterator ci = c.begin();
+    BOOST_REQUIRE_EQUAL(ci.key(), 0);
+}
@@ -110,6 +110,53 @@ SEASTAR_TEST_CASE(foreign_ptr_cpu_test) {
     });
 }
 
+SEASTAR_TEST_CASE(foreign_ptr_release_batch_test) {
+    if (smp::count == 1) {
+        std::cerr << "Skipping multi-cpu foreign_ptr tests. Run with --smp=2 to test batched destruction.";
+        return make_ready_future<>();
+    }
+
+    using namespace std::chrono_literals;
+
+    return seastar::async([] {
+        std::vector<foreign_ptr<std::unique_ptr<dummy>>> ptrs;
+        for (auto i = 0; i < 10; i++) {
+            ptrs.push_back(smp::submit_to(1, [] {
+                return make_foreign(std::make_unique<dummy>());
+            }).get0());
+        }
+        // One of ours, destroyed synchronously by the batch
+        ptrs.push_back(make_foreign(std::make_unique<dummy>()));
+        foreign_ptr<std::unique_ptr<dummy>>::release_batch(std::move(ptrs));
+    }).then([] {
+        // Let the batched destruction take its course. RIP dummies.
+        return seastar::sleep(100ms);
+    });
+}
+
+SEASTAR_TEST_CASE(foreign_destruction_batch_test) {
+    if (smp::count == 1) {
+        std::cerr << "Skipping multi-cpu foreign_ptr tests. Run with --smp=2 to test batched destruction.";
+        return make_ready_future<>();
+    }
+
+    using namespace std::chrono_literals;
+
+    return seastar::async([] {
+        foreign_destruction_batch batch;
+        for (auto i = 0; i < 10; i++) {
+            batch.add(smp::submit_to(1, [] {
+                return make_foreign(std::make_unique<dummy>());
+            }).get0());
+        }
+        batch.flush();
+        // A second flush must be a no-op
+        batch.flush();
+    }).then([] {
+        return seastar::sleep(100ms);
+    });
+}
+
 SEASTAR_TEST_CASE(foreign_ptr_move_assignment_test) {
     if (smp::count == 1) {
         std::cerr << "Skipping multi-cpu foreign_ptr tests. Run with --smp=2 to test multi-cpu delete and reset.";
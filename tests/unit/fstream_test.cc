@@ -28,6 +28,7 @@
 #include <seastar/core/app-template.hh>
 #include <seastar/core/do_with.hh>
 #include <seastar/core/seastar.hh>
+#include <seastar/core/reactor.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/testing/test_case.hh>
 #include <seastar/testing/test_runner.hh>
@@ -112,6 +113,37 @@ SEASTAR_TEST_CASE(test_fstream) {
     });
 }
 
+SEASTAR_TEST_CASE(test_fstream_adaptive_write_behind) {
+    return tmp_dir::do_with_thread([] (tmp_dir& t) {
+        auto filename = (t.get_path() / "testfile.tmp").native();
+        auto f = open_file_dma(filename,
+                open_flags::rw | open_flags::create | open_flags::truncate).get0();
+        file_output_stream_options opt;
+        opt.buffer_size = 4096;
+        opt.write_behind = 16;
+        opt.adaptive_write_behind = true;
+        auto out = api_v3::and_newer::make_file_output_stream(f, opt).get0();
+        constexpr unsigned nr_bufs = 64;
+        auto buf = temporary_buffer<char>::aligned(4096, 4096);
+        for (unsigned i = 0; i < nr_bufs; i++) {
+            memset(buf.get_write(), 'a' + i % 26, buf.size());
+            out.write(buf.get(), buf.size()).get();
+        }
+        out.close().get();
+        // whatever depth the stream settled on, the data must land intact
+        // and in order
+        auto in = make_file_input_stream(open_file_dma(filename, open_flags::ro).get0());
+        for (unsigned i = 0; i < nr_bufs; i++) {
+            auto rbuf = in.read_exactly(4096).get0();
+            BOOST_REQUIRE_EQUAL(rbuf.size(), 4096u);
+            BOOST_REQUIRE_EQUAL(rbuf[0], char('a' + i % 26));
+            BOOST_REQUIRE_EQUAL(rbuf[4095], char('a' + i % 26));
+        }
+        in.close().get();
+        BOOST_REQUIRE_GE(engine().get_io_stats().fstream_writes, uint64_t(nr_bufs));
+    });
+}
+
 SEASTAR_TEST_CASE(test_consume_skip_bytes) {
     return tmp_dir::do_with_thread([] (tmp_dir& t) {
         auto filename = (t.get_path() / "testfile.tmp").native();
@@ -537,3 +569,46 @@ SEASTAR_TEST_CASE(test_fstream_slow_start) {
         read_while_file_at_full_speed(make_fstream());
     });
 }
+
+SEASTAR_TEST_CASE(test_fstream_per_stream_stats) {
+    return seastar::async([] {
+        static constexpr size_t file_size = 8 * 1024 * 1024;
+        static constexpr size_t buffer_size = 64 * 1024;
+
+        auto mock_file = make_shared<mock_read_only_file>(file_size);
+        mock_file->set_allowed_read_requests(std::numeric_limits<size_t>::max());
+
+        auto stats = make_lw_shared<file_input_stream_stats>();
+
+        file_input_stream_options options{};
+        options.buffer_size = buffer_size;
+        options.read_ahead = 2;
+        options.per_stream_stats = stats;
+
+        auto fstr = make_file_input_stream(file(mock_file), 0, file_size, options);
+        uint64_t consumed = 0;
+        // Read the first half, then skip a couple of buffers to force some
+        // of the read-ahead to be discarded.
+        while (consumed < file_size / 2) {
+            consumed += fstr.read().get0().size();
+        }
+        fstr.skip(buffer_size * 2).get();
+        while (true) {
+            auto buf = fstr.read().get0();
+            if (!buf.size()) {
+                break;
+            }
+            consumed += buf.size();
+        }
+        fstr.close().get();
+
+        BOOST_CHECK_EQUAL(stats->bytes_consumed, consumed);
+        BOOST_CHECK_GT(stats->reads_issued, 0u);
+        BOOST_CHECK_GT(stats->reads_discarded, 0u);
+        BOOST_CHECK_GT(stats->bytes_discarded, 0u);
+        // The mock file completes reads immediately, so the consumer never
+        // waited and the read-ahead window had no reason to grow.
+        BOOST_CHECK_EQUAL(stats->reads_blocked, 0u);
+        BOOST_CHECK_EQUAL(stats->read_ahead_grown, 0u);
+    });
+}
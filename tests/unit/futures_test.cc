@@ -1172,6 +1172,48 @@ SEASTAR_TEST_CASE(test_custom_exception_factory_in_with_timeout) {
     });
 }
 
+SEASTAR_TEST_CASE(test_with_timeout_expected) {
+    return seastar::async([] {
+        // Timing out resolves the future with an error value, not an
+        // exception.
+        {
+            promise<int> pr;
+            auto f = with_timeout_expected(manual_clock::now() + 1s, pr.get_future());
+
+            manual_clock::advance(1s);
+            later().get();
+
+            auto r = f.get0();
+            BOOST_REQUIRE(!r.has_value());
+            pr.set_value(42);
+        }
+
+        // The value passes through when the future wins the race, and
+        // expected_then() chains without unwrapping by hand.
+        {
+            promise<int> pr;
+            auto f = expected_then(with_timeout_expected(manual_clock::now() + 1s, pr.get_future()),
+                    [] (int v) {
+                return expected<int, timed_out_error>(v * 2);
+            });
+
+            pr.set_value(21);
+
+            auto r = f.get0();
+            BOOST_REQUIRE(r.has_value());
+            BOOST_REQUIRE_EQUAL(r.value(), 42);
+        }
+
+        // A failure of the wrapped future still propagates as an exception.
+        {
+            promise<> pr;
+            auto f = with_timeout_expected(manual_clock::now() + 1s, pr.get_future());
+            pr.set_exception(std::runtime_error("injected"));
+            check_failed_with<std::runtime_error>(std::move(f));
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(test_with_timeout_when_it_does_not_time_out) {
     return seastar::async([] {
         {
@@ -1322,6 +1364,35 @@ SEASTAR_TEST_CASE(test_when_all_succeed_vector) {
     });
 }
 
+SEASTAR_TEST_CASE(test_when_all_succeed_with_output_iterator) {
+    auto vecs = std::make_unique<std::vector<future<int>>>();
+    vecs->emplace_back(make_ready_future<int>(1));
+    vecs->emplace_back(later().then([] { return 2; }));
+    vecs->emplace_back(make_ready_future<int>(3));
+    auto vals = std::make_unique<std::vector<int>>(3);
+    auto f = seastar::when_all_succeed(vecs->begin(), vecs->end(), vals->begin());
+    return f.then([vecs = std::move(vecs), vals = std::move(vals)] {
+        BOOST_REQUIRE_EQUAL((*vals)[0], 1);
+        BOOST_REQUIRE_EQUAL((*vals)[1], 2);
+        BOOST_REQUIRE_EQUAL((*vals)[2], 3);
+    }).then([] {
+        auto vecs = std::make_unique<std::vector<future<int>>>();
+        vecs->emplace_back(make_ready_future<int>(1));
+        vecs->emplace_back(later().then([] () -> int { throw 42; }));
+        auto vals = std::make_unique<std::vector<int>>(2);
+        auto f = seastar::when_all_succeed(vecs->begin(), vecs->end(), vals->begin());
+        return f.then_wrapped([vecs = std::move(vecs), vals = std::move(vals)] (future<> f) {
+            BOOST_REQUIRE(f.failed());
+            try {
+                f.get();
+                BOOST_FAIL("shouldn't reach");
+            } catch (int v) {
+                BOOST_REQUIRE_EQUAL(v, 42);
+            }
+        });
+    });
+}
+
 SEASTAR_TEST_CASE(test_futurize_mutable) {
     int count = 0;
     return seastar::repeat([count]() mutable {
@@ -1548,6 +1619,33 @@ SEASTAR_THREAD_TEST_CASE(test_with_gate) {
     BOOST_REQUIRE(!other_errors);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_gate_holder) {
+    gate g;
+    auto h = g.hold();
+    BOOST_REQUIRE_EQUAL(g.get_count(), 1u);
+    {
+        // a nested scope takes a copy without a closed-gate check
+        auto h2 = h;
+        BOOST_REQUIRE_EQUAL(g.get_count(), 2u);
+        auto h3 = std::move(h2);
+        BOOST_REQUIRE_EQUAL(g.get_count(), 2u);
+        BOOST_REQUIRE(!h2);
+        BOOST_REQUIRE(h3);
+    }
+    BOOST_REQUIRE_EQUAL(g.get_count(), 1u);
+
+    auto closed = g.close();
+    BOOST_REQUIRE(!closed.available());
+    // copying is still allowed while the gate is closing...
+    auto h4 = h;
+    // ...but entering through the checked path is not
+    BOOST_CHECK_THROW(g.hold(), gate_closed_exception);
+    h.release();
+    BOOST_REQUIRE(!closed.available());
+    h4.release();
+    closed.get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_max_concurrent_for_each) {
     BOOST_TEST_MESSAGE("empty range");
     max_concurrent_for_each(std::vector<int>(), 3, [] (int) {
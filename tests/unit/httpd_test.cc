@@ -20,6 +20,7 @@
 #include <seastar/core/thread.hh>
 #include <seastar/util/noncopyable_function.hh>
 #include <seastar/http/json_path.hh>
+#include <seastar/http/websocket.hh>
 #include <sstream>
 
 using namespace seastar;
@@ -95,6 +96,44 @@ SEASTAR_TEST_CASE(test_match_rule_order)
     return make_ready_future<>();
 }
 
+SEASTAR_TEST_CASE(test_match_rule_dispatch)
+{
+    parameters param;
+    routes route;
+
+    handl* h1 = new handl();
+    auto mr1 = new match_rule(h1);
+    mr1->add_str("/hello").add_param("name");
+    route.add(mr1, operation_type::GET);
+
+    handl* h2 = new handl();
+    auto mr2 = new match_rule(h2);
+    mr2->add_str("/hello").add_str("/world");
+    route.add(mr2, operation_type::GET);
+
+    handl* h3 = new handl();
+    auto mr3 = new match_rule(h3);
+    mr3->add_str("/files").add_param("path", true);
+    route.add(mr3, operation_type::GET);
+
+    // h1 was registered before h2, so it wins even though h2 is more specific
+    auto rh = route.get_handler(GET, "/hello/world", param);
+    BOOST_REQUIRE_EQUAL(rh, h1);
+    BOOST_REQUIRE_EQUAL(param["name"], "world");
+    param.clear();
+
+    rh = route.get_handler(GET, "/files/a/b/c", param);
+    BOOST_REQUIRE_EQUAL(rh, h3);
+    BOOST_REQUIRE_EQUAL(param["path"], "a/b/c");
+    param.clear();
+
+    rh = route.get_handler(GET, "/hello", param);
+    httpd::handler_base* nl = nullptr;
+    BOOST_REQUIRE_EQUAL(rh, nl);
+
+    return make_ready_future<>();
+}
+
 SEASTAR_TEST_CASE(test_put_drop_rule)
 {
     routes rts;
@@ -158,6 +197,14 @@ SEASTAR_TEST_CASE(test_add_del_cookie)
     return make_ready_future<>();
 }
 
+SEASTAR_TEST_CASE(test_websocket_handshake_accept)
+{
+    // the sample handshake from RFC 6455, Section 1.3
+    BOOST_REQUIRE_EQUAL(websocket::handshake_accept("dGhlIHNhbXBsZSBub25jZQ=="),
+            "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+    return make_ready_future<>();
+}
+
 SEASTAR_TEST_CASE(test_formatter)
 {
     BOOST_REQUIRE_EQUAL(json::formatter::to_json(true), "true");
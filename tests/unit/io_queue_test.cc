@@ -27,6 +27,7 @@
 #include <seastar/core/reactor.hh>
 #include <seastar/core/smp.hh>
 #include <seastar/core/when_all.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/core/file.hh>
 #include <seastar/core/io_queue.hh>
 #include <seastar/core/io_intent.hh>
@@ -47,6 +48,16 @@ struct fake_file {
         data[rq.pos()] = *(reinterpret_cast<int*>(rq.address()));
         desc->complete_with(rq.size());
     }
+
+    void execute_writev_req(internal::io_request& rq, io_completion* desc) {
+        size_t res = 0;
+        auto iov = rq.iov();
+        for (size_t i = 0; i < rq.iov_len(); i++) {
+            data[rq.pos() + i] = *(reinterpret_cast<int*>(iov[i].iov_base));
+            res += iov[i].iov_len;
+        }
+        desc->complete_with(res);
+    }
 };
 
 struct io_queue_for_tests {
@@ -80,6 +91,188 @@ SEASTAR_THREAD_TEST_CASE(test_basic_flow) {
     f.get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_uncontended_bypass) {
+    io_group_ptr group = std::make_shared<io_group>(io_group::config{});
+    internal::io_sink sink;
+    io_queue::config cfg{0};
+    cfg.uncontended_bypass = true;
+    io_queue queue(group, sink, std::move(cfg));
+    fake_file<1> file;
+
+    auto val = std::make_unique<int>(42);
+    auto f = queue.queue_request(default_priority_class(), 0, file.make_write_req(0, val.get()), nullptr)
+    .then([&file] (size_t len) {
+        BOOST_REQUIRE(file.data[0] == 42);
+    });
+
+    // The request must show up in the sink without poll_io_queue()
+    sink.drain([&file] (internal::io_request& rq, io_completion* desc) -> bool {
+        file.execute_write_req(rq, desc);
+        return true;
+    });
+
+    f.get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_adjacent_requests_merge) {
+    io_group_ptr group = std::make_shared<io_group>(io_group::config{});
+    internal::io_sink sink;
+    io_queue::config cfg{0};
+    cfg.merge_adjacent_requests = true;
+    io_queue queue(group, sink, std::move(cfg));
+    fake_file<8> file;
+
+    std::vector<std::unique_ptr<int>> bufs;
+    std::vector<future<size_t>> futures;
+    for (int i = 0; i < 3; i++) {
+        bufs.push_back(std::make_unique<int>(50 + i));
+        futures.push_back(queue.queue_request(default_priority_class(), 0, file.make_write_req(i, bufs.back().get()), nullptr));
+    }
+    // ...and one that is not adjacent to the others
+    bufs.push_back(std::make_unique<int>(90));
+    futures.push_back(queue.queue_request(default_priority_class(), 0, file.make_write_req(5, bufs.back().get()), nullptr));
+
+    queue.poll_io_queue();
+    unsigned writev_ops = 0;
+    unsigned write_ops = 0;
+    sink.drain([&] (internal::io_request& rq, io_completion* desc) -> bool {
+        if (rq.opcode() == internal::io_request::operation::writev) {
+            writev_ops++;
+            file.execute_writev_req(rq, desc);
+        } else {
+            write_ops++;
+            file.execute_write_req(rq, desc);
+        }
+        return true;
+    });
+
+    // The three adjacent writes reach the disk as a single writev, the
+    // distant one on its own
+    BOOST_REQUIRE_EQUAL(writev_ops, 1u);
+    BOOST_REQUIRE_EQUAL(write_ops, 1u);
+    for (auto&& f : futures) {
+        BOOST_REQUIRE_EQUAL(f.get0(), 1u);
+    }
+    BOOST_REQUIRE(file.data[0] == 50);
+    BOOST_REQUIRE(file.data[1] == 51);
+    BOOST_REQUIRE(file.data[2] == 52);
+    BOOST_REQUIRE(file.data[5] == 90);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_merged_request_splits_short_completion) {
+    io_group_ptr group = std::make_shared<io_group>(io_group::config{});
+    internal::io_sink sink;
+    io_queue::config cfg{0};
+    cfg.merge_adjacent_requests = true;
+    io_queue queue(group, sink, std::move(cfg));
+    fake_file<2> file;
+
+    std::vector<std::unique_ptr<int>> bufs;
+    std::vector<future<size_t>> futures;
+    for (int i = 0; i < 2; i++) {
+        bufs.push_back(std::make_unique<int>(60 + i));
+        futures.push_back(queue.queue_request(default_priority_class(), 0, file.make_write_req(i, bufs.back().get()), nullptr));
+    }
+
+    queue.poll_io_queue();
+    unsigned ops = 0;
+    sink.drain([&] (internal::io_request& rq, io_completion* desc) -> bool {
+        BOOST_REQUIRE(rq.opcode() == internal::io_request::operation::writev);
+        ops++;
+        // the disk only got through the first part
+        desc->complete_with(1);
+        return true;
+    });
+
+    BOOST_REQUIRE_EQUAL(ops, 1u);
+    BOOST_REQUIRE_EQUAL(futures[0].get0(), 1u);
+    BOOST_REQUIRE_EQUAL(futures[1].get0(), 0u);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_cross_group_capacity_lending) {
+    io_group::config gcfg = {};
+    gcfg.max_req_count = 2 * io_queue::read_request_base_count;  // two requests in flight
+    gcfg.max_bytes_count = 1 << 20;
+    auto ga = std::make_shared<io_group>(gcfg);
+    auto gb = std::make_shared<io_group>(gcfg);
+    ga->add_sibling(gb);
+    gb->add_sibling(ga);
+
+    internal::io_sink sink;
+    io_queue queue(ga, sink, io_queue::config{0});
+    fake_file<4> file;
+
+    std::vector<future<size_t>> futures;
+    std::vector<std::unique_ptr<int>> bufs;
+    for (int i = 0; i < 3; i++) {
+        bufs.push_back(std::make_unique<int>(40 + i));
+        futures.push_back(queue.queue_request(default_priority_class(), 0, file.make_write_req(i, bufs.back().get()), nullptr));
+    }
+
+    // Group A fits two requests, so the third stalls and borrows the missing
+    // capacity from the idle sibling group B, letting the next poll dispatch
+    // it with the first two still in flight.
+    queue.poll_io_queue();
+    queue.poll_io_queue();
+
+    unsigned executed = 0;
+    sink.drain([&] (internal::io_request& rq, io_completion* desc) -> bool {
+        file.execute_write_req(rq, desc);
+        executed++;
+        return true;
+    });
+    BOOST_REQUIRE(executed == 3);
+    for (auto&& f : futures) {
+        f.get();
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_group_capacity_update_at_runtime) {
+    io_group::config gcfg = {};
+    gcfg.max_req_count = io_queue::read_request_base_count;  // one request in flight
+    gcfg.max_bytes_count = 1 << 20;
+    auto grp = std::make_shared<io_group>(gcfg);
+    internal::io_sink sink;
+    io_queue queue(grp, sink, io_queue::config{0});
+    fake_file<2> file;
+
+    std::vector<future<size_t>> futures;
+    std::vector<std::unique_ptr<int>> bufs;
+    for (int i = 0; i < 2; i++) {
+        bufs.push_back(std::make_unique<int>(40 + i));
+        futures.push_back(queue.queue_request(default_priority_class(), 0, file.make_write_req(i, bufs.back().get()), nullptr));
+    }
+
+    // The group fits one request, so while the first one is in flight
+    // the second stalls...
+    std::vector<io_completion*> inflight;
+    auto submit = [&] (internal::io_request& rq, io_completion* desc) -> bool {
+        file.data[rq.pos()] = *(reinterpret_cast<int*>(rq.address()));
+        inflight.push_back(desc);
+        return true;
+    };
+    queue.poll_io_queue();
+    sink.drain(submit);
+    BOOST_REQUIRE(inflight.size() == 1);
+    queue.poll_io_queue();
+    sink.drain(submit);
+    BOOST_REQUIRE(inflight.size() == 1);
+
+    // ...until the capacity is doubled at runtime
+    gcfg.max_req_count *= 2;
+    grp->update_config(gcfg);
+    queue.poll_io_queue();
+    sink.drain(submit);
+    BOOST_REQUIRE(inflight.size() == 2);
+
+    for (auto&& d : inflight) {
+        d->complete_with(1);
+    }
+    for (auto&& f : futures) {
+        f.get();
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(test_intent_safe_ref) {
     auto get_cancelled = [] (internal::intent_reference& iref) -> bool {
         try {
@@ -218,3 +411,38 @@ SEASTAR_THREAD_TEST_CASE(test_io_cancellation) {
 
     when_all_succeed(finished.begin(), finished.end()).get();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_member_device_latency_scaling) {
+    io_group_ptr group = std::make_shared<io_group>(io_group::config{});
+    internal::io_sink sink;
+    io_queue::config cfg{0};
+    cfg.nr_member_devices = 2;
+    cfg.member_stripe_size = 1;  // pos 0 -> member 0, pos 1 -> member 1
+    io_queue queue(group, sink, std::move(cfg));
+    fake_file<2> file;
+
+    auto run_one = [&] (size_t pos, std::chrono::milliseconds service_time) {
+        auto val = std::make_unique<int>(42);
+        auto f = queue.queue_request(default_priority_class(), 0, file.make_write_req(pos, val.get()), nullptr);
+        queue.poll_io_queue();
+        // the request is "on the disk" now; its completion latency is
+        // however long we sit on the sink before draining it
+        seastar::sleep(service_time).get();
+        sink.drain([&file] (internal::io_request& rq, io_completion* desc) -> bool {
+            file.execute_write_req(rq, desc);
+            return true;
+        });
+        f.get();
+    };
+
+    run_one(0, std::chrono::milliseconds(0));   // member 0 is fast
+    run_one(1, std::chrono::milliseconds(20));  // member 1 is slow
+
+    BOOST_REQUIRE(queue.member_latency(1) > queue.member_latency(0));
+
+    // requests routed to the slow member must now be charged more
+    int buf;
+    auto fast = internal::io_request::make_write(0, 0, &buf, 512, false);
+    auto slow = internal::io_request::make_write(0, 1, &buf, 512, false);
+    BOOST_REQUIRE(!(queue.request_fq_ticket(fast, 4096) == queue.request_fq_ticket(slow, 4096)));
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#include <seastar/core/sstring.hh>
+#include <seastar/json/json_elements.hh>
+#include <seastar/json/parser.hh>
+#include <seastar/testing/test_case.hh>
+
+using namespace seastar;
+using namespace json;
+
+namespace {
+
+// collects the parser's events into a flat trace for comparison
+class recording_handler : public sax_handler {
+public:
+    std::vector<sstring> events;
+    virtual void start_object() override {
+        events.push_back("{");
+    }
+    virtual void end_object() override {
+        events.push_back("}");
+    }
+    virtual void start_array() override {
+        events.push_back("[");
+    }
+    virtual void end_array() override {
+        events.push_back("]");
+    }
+    virtual void on_key(std::string_view key) override {
+        events.push_back("k:" + sstring(key));
+    }
+    virtual void on_scalar(std::string_view text, bool is_string) override {
+        events.push_back((is_string ? "s:" : "v:") + sstring(text));
+    }
+};
+
+// feed the document to the parser in chunks of the given size
+std::vector<sstring> events_of(const sstring& doc, size_t chunk) {
+    recording_handler handler;
+    sax_parser parser(handler);
+    for (size_t i = 0; i < doc.size(); i += chunk) {
+        parser.parse_chunk(std::string_view(doc).substr(i, chunk));
+    }
+    parser.finish();
+    return std::move(handler.events);
+}
+
+// an input stream delivering the document in small pieces
+class chunked_source : public data_source_impl {
+    sstring _doc;
+    size_t _pos = 0;
+public:
+    explicit chunked_source(sstring doc) : _doc(std::move(doc)) {
+    }
+    virtual future<temporary_buffer<char>> get() override {
+        auto n = std::min<size_t>(5, _doc.size() - _pos);
+        temporary_buffer<char> buf(_doc.data() + _pos, n);
+        _pos += n;
+        return make_ready_future<temporary_buffer<char>>(std::move(buf));
+    }
+};
+
+input_stream<char> make_chunked_stream(sstring doc) {
+    return input_stream<char>(data_source(std::make_unique<chunked_source>(std::move(doc))));
+}
+
+struct config : public json_base {
+    json_element<sstring> name;
+    json_element<long> count;
+    json_element<bool> enabled;
+    json_list<sstring> tags;
+    config() {
+        add(&name, "name", true);
+        add(&count, "count");
+        add(&enabled, "enabled");
+        add(&tags, "tags");
+    }
+};
+
+}
+
+SEASTAR_TEST_CASE(test_sax_events) {
+    auto expected = std::vector<sstring>{
+        "{", "k:a", "v:1", "k:b", "[", "v:2", "s:x", "]", "k:c", "{", "k:d", "v:true", "}", "}"
+    };
+    sstring doc = R"({"a": 1, "b": [2, "x"], "c": {"d": true}})";
+    // the events must not depend on how the document is chunked
+    for (auto chunk : {size_t(1), size_t(3), size_t(7), doc.size()}) {
+        auto events = events_of(doc, chunk);
+        BOOST_REQUIRE_EQUAL_COLLECTIONS(events.begin(), events.end(),
+                expected.begin(), expected.end());
+    }
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_sax_string_escapes) {
+    auto events = events_of(R"("a\"b\ncé")", 2);
+    BOOST_REQUIRE_EQUAL(events.size(), 1u);
+    BOOST_REQUIRE_EQUAL(events[0], sstring("s:a\"b\nc\xc3\xa9"));
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_sax_errors) {
+    BOOST_REQUIRE_THROW(events_of(R"({"a" 1})", 100), parse_error);
+    BOOST_REQUIRE_THROW(events_of(R"({"a": 1)", 100), parse_error);
+    BOOST_REQUIRE_THROW(events_of(R"([1, 2}])", 100), parse_error);
+    BOOST_REQUIRE_THROW(events_of(R"({} extra)", 100), parse_error);
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_parse_onto_object) {
+    sstring doc = R"({"name": "cfg", "count": 42, "enabled": true,)"
+                  R"( "tags": ["a", "b"], "unknown": {"deep": [1, 2]}})";
+    // json_base objects hold pointers into themselves, so keep it on the heap
+    return do_with(std::make_unique<config>(), make_chunked_stream(doc),
+            [] (std::unique_ptr<config>& cfg, input_stream<char>& in) {
+        return parse(in, *cfg).then([&cfg] {
+            BOOST_REQUIRE_EQUAL(cfg->name(), "cfg");
+            BOOST_REQUIRE_EQUAL(cfg->count(), 42);
+            BOOST_REQUIRE_EQUAL(cfg->enabled(), true);
+            BOOST_REQUIRE_EQUAL(cfg->tags._elements.size(), 2u);
+            BOOST_REQUIRE_EQUAL(cfg->tags._elements[0], "a");
+            BOOST_REQUIRE_EQUAL(cfg->tags._elements[1], "b");
+        });
+    });
+}
+
+SEASTAR_TEST_CASE(test_parse_mandatory_missing) {
+    return do_with(std::make_unique<config>(), make_chunked_stream(R"({"count": 1})"),
+            [] (std::unique_ptr<config>& cfg, input_stream<char>& in) {
+        return parse(in, *cfg).then_wrapped([] (future<> f) {
+            BOOST_REQUIRE_THROW(f.get(), parse_error);
+        });
+    });
+}
@@ -111,6 +111,61 @@ SEASTAR_THREAD_TEST_CASE(test_rwlock_failed_func) {
     l.for_write().unlock();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_read_mostly_rwlock) {
+    read_mostly_rwlock l;
+
+    l.for_write().lock().get();
+    BOOST_REQUIRE(!l.try_write_lock());
+    BOOST_REQUIRE(!l.try_read_lock());
+    l.for_write().unlock();
+
+    l.for_read().lock().get();
+    BOOST_REQUIRE(!l.try_write_lock());
+    BOOST_REQUIRE(l.try_read_lock());
+    l.for_read().lock().get();
+    l.for_read().unlock();
+    l.for_read().unlock();
+    l.for_read().unlock();
+
+    BOOST_REQUIRE(l.try_write_lock());
+    l.for_write().unlock();
+    BOOST_REQUIRE(!l.locked());
+}
+
+SEASTAR_TEST_CASE(test_read_mostly_rwlock_exclusive) {
+    return do_with(read_mostly_rwlock(), unsigned(0), [] (read_mostly_rwlock& l, unsigned& counter) {
+        return parallel_for_each(boost::irange(0, 10), [&l, &counter] (int idx) {
+            return with_lock(l.for_write(), [&counter] {
+                BOOST_REQUIRE_EQUAL(counter, 0u);
+                ++counter;
+                return sleep(1ms).then([&counter] {
+                    --counter;
+                    BOOST_REQUIRE_EQUAL(counter, 0u);
+                });
+            });
+        });
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_read_mostly_rwlock_writers_batched) {
+    read_mostly_rwlock l;
+    std::vector<int> order;
+
+    // A reader holds the lock; writers and a late reader queue behind it.
+    l.read_lock().get();
+    auto w1 = l.write_lock().then([&] { order.push_back(1); l.write_unlock(); });
+    auto w2 = l.write_lock().then([&] { order.push_back(2); l.write_unlock(); });
+    auto r = l.read_lock().then([&] { order.push_back(3); l.read_unlock(); });
+    BOOST_REQUIRE(order.empty());
+    l.read_unlock();
+    w1.get();
+    w2.get();
+    r.get();
+    // Both writers run consecutively before the queued reader.
+    BOOST_REQUIRE((order == std::vector<int>{1, 2, 3}));
+    BOOST_REQUIRE(!l.locked());
+}
+
 SEASTAR_THREAD_TEST_CASE(test_failed_with_lock) {
     struct test_lock {
         future<> lock() noexcept {
@@ -0,0 +1,72 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/log.hh>
+#include <seastar/util/defer.hh>
+
+#include <chrono>
+#include <sstream>
+
+using namespace seastar;
+using namespace std::chrono_literals;
+
+SEASTAR_THREAD_TEST_CASE(test_async_log_drains_to_ostream) {
+    std::ostringstream out;
+    logger::set_ostream(out);
+    logger::set_async_enabled(true);
+    auto restore = defer([] () noexcept {
+        logger::set_async_enabled(false);
+        logger::set_ostream(std::cerr);
+    });
+
+    logger l("async_log_test");
+    auto dropped_before = logger::dropped_async_messages();
+    l.info("first async message");
+    l.info("second async message");
+    // records sit in the ring until the drain task runs
+    thread::yield();
+
+    auto text = out.str();
+    BOOST_REQUIRE(text.find("first async message") != std::string::npos);
+    BOOST_REQUIRE(text.find("second async message") != std::string::npos);
+    BOOST_REQUIRE_EQUAL(logger::dropped_async_messages(), dropped_before);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_per_instance_rate_limit) {
+    std::ostringstream out;
+    logger::set_ostream(out);
+    auto restore = defer([] () noexcept {
+        logger::set_ostream(std::cerr);
+    });
+
+    logger l("rate_limit_test");
+    l.set_rate_limit(1h);
+    l.info("admitted message");
+    l.info("suppressed message");
+    l.info("suppressed message");
+
+    auto text = out.str();
+    BOOST_REQUIRE(text.find("admitted message") != std::string::npos);
+    BOOST_REQUIRE(text.find("suppressed message") == std::string::npos);
+    BOOST_REQUIRE_EQUAL(l.rate_limited_messages(), 2u);
+}
@@ -33,6 +33,7 @@
 #include <seastar/testing/test_case.hh>
 #include <seastar/testing/thread_test_case.hh>
 #include <seastar/testing/test_runner.hh>
+#include <seastar/util/defer.hh>
 #include <boost/range/irange.hpp>
 
 SEASTAR_TEST_CASE(test_add_group) {
@@ -168,3 +169,115 @@ SEASTAR_THREAD_TEST_CASE(test_renaming_io_priority_classes) {
     bool name2_found = label_vals.find(sstring(name2)) != label_vals.end();
     BOOST_REQUIRE((name1_found && !name2_found) || (name2_found && !name1_found));
 }
+
+static bool metric_family_exists(const seastar::sstring& name) {
+    namespace smi = seastar::metrics::impl;
+    auto all_metrics = smi::get_values();
+    const auto& all_metadata = *all_metrics->metadata;
+    return find_if(cbegin(all_metadata), cend(all_metadata),
+        [&name] (const auto& x) { return x.mf.name == name; }) != cend(all_metadata);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_relabel_configs) {
+    using namespace seastar;
+    namespace sm = metrics;
+
+    sm::relabel_config drop;
+    drop.source_labels = {"__name__"};
+    drop.expr = "test_relabel_dropped_total";
+    drop.action = sm::relabel_config::relabel_action::drop;
+
+    sm::relabel_config rewrite;
+    rewrite.source_labels = {"lev"};
+    rewrite.expr = "(.*)";
+    rewrite.target_label = "relabeled";
+    rewrite.replacement = "x_$1";
+
+    sm::set_relabel_configs({drop, rewrite}).get();
+
+    sm::metric_groups mg;
+    mg.add_group("test_relabel", {
+        sm::make_counter("dropped_total", [] { return 1; }, sm::description("dropped"), {sm::label_instance("lev", "1")}),
+        sm::make_counter("kept_total", [] { return 1; }, sm::description("kept"), {sm::label_instance("lev", "2")}),
+    });
+
+    // the drop rule keeps the first metric from ever registering
+    BOOST_REQUIRE(!metric_family_exists("test_relabel_dropped_total"));
+    BOOST_REQUIRE(metric_family_exists("test_relabel_kept_total"));
+    // the replace rule added a label derived from an existing one
+    std::set<sstring> label_vals = get_label_values("test_relabel_kept_total", "relabeled");
+    BOOST_REQUIRE(label_vals == std::set<sstring>({"x_2"}));
+
+    // filtering is re-evaluated for already-registered series
+    sm::relabel_config drop_kept;
+    drop_kept.source_labels = {"__name__"};
+    drop_kept.expr = "test_relabel_kept_total";
+    drop_kept.action = sm::relabel_config::relabel_action::drop;
+    sm::set_relabel_configs({drop_kept}).get();
+    BOOST_REQUIRE(!metric_family_exists("test_relabel_kept_total"));
+
+    // and relaxing the rules brings the series back
+    sm::set_relabel_configs({}).get();
+    BOOST_REQUIRE(metric_family_exists("test_relabel_kept_total"));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_log_histogram) {
+    namespace sm = seastar::metrics;
+
+    sm::log_histogram<1024, 2> h;
+    for (uint64_t v : {0ull, 1ull, 5ull, 6ull, 100ull, 5000ull}) {
+        h.record(v);
+    }
+    auto snap = h.to_histogram();
+    BOOST_REQUIRE_EQUAL(snap.sample_count, 6);
+    BOOST_REQUIRE_EQUAL(snap.sample_sum, 5112);
+    // bounds are increasing and counts cumulative
+    for (size_t i = 1; i < snap.buckets.size(); i++) {
+        BOOST_REQUIRE_LT(snap.buckets[i - 1].upper_bound, snap.buckets[i].upper_bound);
+        BOOST_REQUIRE_LE(snap.buckets[i - 1].count, snap.buckets[i].count);
+    }
+    // count at a bound covers exactly the values less than or equal to it
+    auto count_le = [&snap] (double bound) -> uint64_t {
+        uint64_t c = 0;
+        for (auto& b : snap.buckets) {
+            if (b.upper_bound <= bound) {
+                c = b.count;
+            }
+        }
+        return c;
+    };
+    BOOST_REQUIRE_EQUAL(count_le(0), 1);
+    BOOST_REQUIRE_EQUAL(count_le(1), 2);
+    BOOST_REQUIRE_EQUAL(count_le(5), 3);
+    BOOST_REQUIRE_EQUAL(count_le(7), 4);
+    BOOST_REQUIRE_EQUAL(count_le(127), 5);
+    // values at and above Max saturate into the last bucket
+    BOOST_REQUIRE_EQUAL(snap.buckets.back().count, 6);
+    // scaling applies to both the bounds and the sum
+    auto scaled = h.to_histogram(0.5);
+    BOOST_REQUIRE_EQUAL(scaled.sample_sum, 2556);
+    BOOST_REQUIRE_EQUAL(scaled.buckets[1].upper_bound, 0.5);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_sample_caching_period) {
+    namespace sm = seastar::metrics;
+    namespace mi = seastar::metrics::impl;
+    sm::set_sample_caching_period(std::chrono::hours(1)).get();
+    auto restore = seastar::defer([] () noexcept {
+        sm::set_sample_caching_period(std::chrono::milliseconds(0)).get();
+    });
+
+    auto first = mi::get_values();
+    auto second = mi::get_values();
+    // scrapes within the caching period share the same snapshot
+    BOOST_REQUIRE_EQUAL(first.get(), second.get());
+
+    // a registration change invalidates the cache and bumps the epoch
+    sm::metric_groups app_metrics;
+    app_metrics.add_group("test_caching", {
+        sm::make_counter("bumps_epoch", [] { return 1; }, sm::description("a counter")),
+    });
+    auto third = mi::get_values();
+    BOOST_REQUIRE_NE(second.get(), third.get());
+    BOOST_REQUIRE_LT(second->epoch, third->epoch);
+}
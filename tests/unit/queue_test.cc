@@ -68,3 +68,38 @@ SEASTAR_TEST_CASE(test_queue_push_abort) {
         done.get();
     });
 }
+
+SEASTAR_TEST_CASE(test_queue_batch_operations) {
+    return async([] {
+        queue<int> q(4);
+
+        // A batch larger than the capacity is pushed only partially
+        std::vector<int> items = {1, 2, 3, 4, 5, 6};
+        BOOST_REQUIRE_EQUAL(q.push_batch(items.begin(), items.end()), 4u);
+        BOOST_REQUIRE(q.full());
+
+        // A blocked producer is woken once by the batched pop
+        bool pushed = false;
+        auto f = q.not_full().then([&] {
+            pushed = q.push(5);
+        });
+
+        std::vector<int> out;
+        BOOST_REQUIRE_EQUAL(q.pop_batch(std::back_inserter(out), 3), 3u);
+        BOOST_REQUIRE_EQUAL(out.size(), 3u);
+        BOOST_REQUIRE_EQUAL(out[0], 1);
+        BOOST_REQUIRE_EQUAL(out[2], 3);
+
+        f.get();
+        BOOST_REQUIRE(pushed);
+        BOOST_REQUIRE_EQUAL(q.size(), 2u);
+
+        // Popping more than available drains the queue
+        out.clear();
+        BOOST_REQUIRE_EQUAL(q.pop_batch(std::back_inserter(out), 10), 2u);
+        BOOST_REQUIRE_EQUAL(out[0], 4);
+        BOOST_REQUIRE_EQUAL(out[1], 5);
+        BOOST_REQUIRE(q.empty());
+        BOOST_REQUIRE_EQUAL(q.pop_batch(std::back_inserter(out), 10), 0u);
+    });
+}
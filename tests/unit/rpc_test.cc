@@ -24,7 +24,9 @@
 #include <seastar/rpc/rpc_types.hh>
 #include <seastar/rpc/lz4_compressor.hh>
 #include <seastar/rpc/lz4_fragmented_compressor.hh>
+#include <seastar/rpc/zstd_compressor.hh>
 #include <seastar/rpc/multi_algo_compressor_factory.hh>
+#include <seastar/rpc/client_pool.hh>
 #include <seastar/testing/test_case.hh>
 #include <seastar/testing/thread_test_case.hh>
 #include <seastar/testing/test_runner.hh>
@@ -40,6 +42,9 @@
 using namespace seastar;
 
 struct serializer {
+    // the arithmetic encodings below are exactly the in-memory
+    // representation, so the marshalling fast path may bypass them
+    static constexpr bool rpc_flat_serialization = true;
 };
 
 template <typename T, typename Output>
@@ -358,6 +363,139 @@ SEASTAR_TEST_CASE(test_rpc_connect_multi_compression_algo) {
     });
 }
 
+SEASTAR_TEST_CASE(test_rpc_batch_flush_delay) {
+    rpc::client_options co;
+    co.batch_flush_delay = std::chrono::microseconds(500);
+    return rpc_test_env<>::do_with_thread(rpc_test_config(), co, [] (rpc_test_env<>& env, test_rpc_proto::client& c1) {
+        env.register_handler(1, [](int a, int b) {
+            return make_ready_future<int>(a+b);
+        }).get();
+        auto sum = env.proto().make_client<int (int, int)>(1);
+        // many concurrent small calls, so that several of them share a flush
+        std::vector<future<>> replies;
+        for (int i = 0; i < 100; i++) {
+            replies.push_back(sum(c1, i, i).then([i] (int result) {
+                BOOST_REQUIRE_EQUAL(result, i + i);
+            }));
+        }
+        when_all_succeed(replies.begin(), replies.end()).get();
+    });
+}
+
+SEASTAR_TEST_CASE(test_rpc_compression_bypass) {
+    struct counting_factory : rpc::compressor::factory {
+        mutable int compressed_frames = 0;
+        class counting_lz4 : public rpc::lz4_compressor {
+            int& _count;
+        public:
+            explicit counting_lz4(int& count) : _count(count) {}
+            rpc::snd_buf compress(size_t head_space, rpc::snd_buf data) override {
+                _count++;
+                return rpc::lz4_compressor::compress(head_space, std::move(data));
+            }
+        };
+        const sstring& supported() const override {
+            static const sstring name = "LZ4";
+            return name;
+        }
+        std::unique_ptr<rpc::compressor> negotiate(sstring feature, bool is_server) const override {
+            return feature == supported() ? std::make_unique<counting_lz4>(compressed_frames) : nullptr;
+        }
+    };
+    auto factory = std::make_unique<counting_factory>();
+    rpc::server_options so;
+    rpc::client_options co;
+    so.compressor_factory = factory.get();
+    co.compressor_factory = factory.get();
+    rpc_test_config cfg;
+    cfg.server_options = so;
+    return rpc_test_env<>::do_with_thread(cfg, co, [&f = *factory] (rpc_test_env<>& env, test_rpc_proto::client& c1) {
+        env.register_handler(1, [](int a, int b) {
+            return make_ready_future<int>(a+b);
+        }).get();
+        env.register_handler(2, [](sstring data) {
+            return make_ready_future<sstring>(std::move(data));
+        }).get();
+        auto sum = env.proto().make_client<int (int, int)>(1);
+        BOOST_REQUIRE_EQUAL(sum(c1, 2, 3).get0(), 2 + 3);
+        // both the tiny request and the tiny response are sent uncompressed
+        BOOST_REQUIRE_EQUAL(f.compressed_frames, 0);
+        auto echo = env.proto().make_client<sstring (sstring)>(2);
+        sstring data = uninitialized_string(16 * 1024);
+        for (size_t i = 0; i < data.size(); i++) {
+            data[i] = 'a' + i % 16;
+        }
+        BOOST_REQUIRE(echo(c1, data).get0() == data);
+        // large compressible frames still go through the compressor
+        BOOST_REQUIRE(f.compressed_frames >= 2);
+    }).finally([factory = std::move(factory)] {});
+}
+
+SEASTAR_TEST_CASE(test_rpc_client_pool) {
+    rpc_test_config cfg;
+    cfg.connect = true;
+    return rpc_test_env<>::do_with_thread(cfg, [] (rpc_test_env<>& env) {
+        env.register_handler(1, [](int a, int b) {
+            return make_ready_future<int>(a+b);
+        }).get();
+        rpc::client_pool<serializer> pool(env.proto(), {}, ipv4_addr(), 2, 10, [&env] { return env.make_socket(); });
+        auto sum = env.proto().make_client<int (int, int)>(1);
+        // the same routing key always selects the same connection
+        BOOST_REQUIRE_EQUAL(&pool.get_client(7), &pool.get_client(7));
+        BOOST_REQUIRE_EQUAL(&pool.get_client(0), &pool.get_client(2));
+        std::vector<future<>> replies;
+        for (int i = 0; i < 20; i++) {
+            replies.push_back(pool.with_client([&sum, i] (rpc::client_pool<serializer>::client_type& c) {
+                return sum(c, i, 1).then([i] (int result) {
+                    BOOST_REQUIRE_EQUAL(result, i + 1);
+                });
+            }));
+        }
+        when_all_succeed(replies.begin(), replies.end()).get();
+        pool.stop().get();
+    });
+}
+
+SEASTAR_TEST_CASE(test_rpc_metrics) {
+    return rpc_test_env<>::do_with_thread(rpc_test_config(), [] (rpc_test_env<>& env, test_rpc_proto::client& c1) {
+        env.register_handler(1, [](int a, int b) {
+            return make_ready_future<int>(a+b);
+        }).get();
+        // covers verbs registered both before and after enabling
+        env.proto().enable_per_verb_metrics("test");
+        env.server().register_metrics("test");
+        env.register_handler(2, [](int a) {
+            return make_ready_future<int>(-a);
+        }).get();
+        auto sum = env.proto().make_client<int (int, int)>(1);
+        auto neg = env.proto().make_client<int (int)>(2);
+        BOOST_REQUIRE_EQUAL(sum(c1, 2, 3).get0(), 2 + 3);
+        BOOST_REQUIRE_EQUAL(neg(c1, 7).get0(), -7);
+        BOOST_REQUIRE(c1.get_stats().bytes_sent > 0);
+        BOOST_REQUIRE(c1.get_stats().bytes_received > 0);
+    });
+}
+
+SEASTAR_TEST_CASE(test_rpc_batched_dispatch) {
+    return rpc_test_env<>::do_with_thread(rpc_test_config(), [] (rpc_test_env<>& env, test_rpc_proto::client& c1) {
+        env.register_handler(1, [](int a, int b) {
+            return make_ready_future<int>(a+b);
+        }).get();
+        BOOST_REQUIRE_THROW(env.proto().enable_batched_dispatch(2), std::runtime_error);
+        env.proto().enable_batched_dispatch(1);
+        // enabling twice is a no-op
+        env.proto().enable_batched_dispatch(1);
+        auto sum = env.proto().make_client<int (int, int)>(1);
+        // a burst of same-verb calls goes through the stage and is still
+        // answered correctly
+        parallel_for_each(boost::irange(0, 100), [&] (int i) {
+            return sum(c1, i, i).then([i] (int r) {
+                BOOST_REQUIRE_EQUAL(r, 2 * i);
+            });
+        }).get();
+    });
+}
+
 SEASTAR_TEST_CASE(test_rpc_connect_abort) {
     rpc_test_config cfg;
     cfg.connect = false;
@@ -427,6 +565,63 @@ SEASTAR_TEST_CASE(test_message_to_big) {
     });
 }
 
+SEASTAR_TEST_CASE(test_rcv_buf_argument) {
+    // A verb taking rpc::rcv_buf receives the payload as views of the
+    // connection's receive buffer, without the serializer copying it out
+    return rpc_test_env<>::do_with_thread(rpc_test_config(), [] (rpc_test_env<>& env, test_rpc_proto::client& c) {
+        env.register_handler(1, [] (rpc::rcv_buf data) {
+            uint64_t sum = 0;
+            size_t size = 0;
+            auto add = [&] (const temporary_buffer<char>& b) {
+                for (auto c : std::string_view(b.get(), b.size())) {
+                    sum += uint8_t(c);
+                }
+                size += b.size();
+            };
+            if (auto* b = std::get_if<temporary_buffer<char>>(&data.bufs)) {
+                add(*b);
+            } else {
+                for (auto& b : std::get<std::vector<temporary_buffer<char>>>(data.bufs)) {
+                    add(b);
+                }
+            }
+            BOOST_REQUIRE_EQUAL(size, data.size);
+            return make_ready_future<uint64_t>(sum);
+        }).get();
+        auto checksum = env.proto().make_client<uint64_t (rpc::rcv_buf)>(1);
+        auto payload = temporary_buffer<char>(32 * 1024);
+        uint64_t expected = 0;
+        for (size_t i = 0; i < payload.size(); i++) {
+            payload.get_write()[i] = char(i);
+            expected += uint8_t(char(i));
+        }
+        auto buf = rpc::rcv_buf(std::move(payload));
+        BOOST_REQUIRE_EQUAL(checksum(c, buf).get0(), expected);
+    });
+}
+
+// no write()/read() overloads exist for this type, so calls passing it can
+// only be marshalled by the flat fast path
+struct point {
+    int32_t x;
+    int32_t y;
+};
+
+static_assert(rpc::is_flat_serializable_v<serializer, point, uint64_t>);
+static_assert(rpc::is_flat_serializable_v<serializer, int32_t, int32_t>);
+static_assert(!rpc::is_flat_serializable_v<serializer, sstring>);
+static_assert(!rpc::is_flat_serializable_v<serializer, point, rpc::optional<int32_t>>);
+
+SEASTAR_TEST_CASE(test_flat_serialization) {
+    return rpc_test_env<>::do_with_thread(rpc_test_config(), [] (rpc_test_env<>& env, test_rpc_proto::client& c) {
+        env.register_handler(1, [] (point p, uint64_t mult) {
+            return make_ready_future<uint64_t>(p.x * mult + p.y);
+        }).get();
+        auto eval = env.proto().make_client<uint64_t (point, uint64_t)>(1);
+        BOOST_REQUIRE_EQUAL(eval(c, point{3, 4}, 10).get0(), 34u);
+    });
+}
+
 struct stream_test_result {
     bool client_source_closed = false;
     bool server_source_closed = false;
@@ -687,6 +882,52 @@ SEASTAR_THREAD_TEST_CASE(test_rpc_scheduling_connection_based_compatibility) {
     }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_rpc_scheduling_call_based) {
+    auto sg1 = create_scheduling_group("sg1", 100).get0();
+    auto sg1_kill = defer([&] { destroy_scheduling_group(sg1).get(); });
+    auto sg2 = create_scheduling_group("sg2", 100).get0();
+    auto sg2_kill = defer([&] { destroy_scheduling_group(sg2).get(); });
+    rpc::resource_limits limits;
+    limits.isolate_call = [sg1, sg2] (uint8_t qos_tag) {
+        auto sg = current_scheduling_group();
+        if (qos_tag == 1) {
+            sg = sg1;
+        } else if (qos_tag == 2) {
+            sg = sg2;
+        }
+        rpc::isolation_config cfg;
+        cfg.sched_group = sg;
+        return cfg;
+    };
+    rpc_test_config cfg;
+    cfg.resource_limits = limits;
+    rpc_test_env<>::do_with_thread(cfg, [sg1, sg2] (rpc_test_env<>& env) {
+        // calls on a single connection are tagged individually
+        uint8_t tag = 0;
+        rpc::client_options co;
+        co.qos_tag_source = [&tag] { return tag; };
+        test_rpc_proto::client c1(env.proto(), co, env.make_socket(), ipv4_addr());
+        // an old client that does not send tags
+        rpc::client_options co2;
+        test_rpc_proto::client c2(env.proto(), co2, env.make_socket(), ipv4_addr());
+        env.register_handler(1, [] {
+            return make_ready_future<unsigned>(internal::scheduling_group_index(current_scheduling_group()));
+        }).get();
+        auto call_sg_id = env.proto().make_client<unsigned ()>(1);
+        tag = 1;
+        BOOST_REQUIRE(call_sg_id(c1).get0() == internal::scheduling_group_index(sg1));
+        tag = 2;
+        BOOST_REQUIRE(call_sg_id(c1).get0() == internal::scheduling_group_index(sg2));
+        BOOST_REQUIRE(call_sg_id(c2).get0() != internal::scheduling_group_index(sg2));
+        // the handler can recover the isolation of the group it runs under
+        auto iso = env.server().isolation_config_for(sg2);
+        BOOST_REQUIRE(iso && internal::scheduling_group_index(iso->sched_group) == internal::scheduling_group_index(sg2));
+        BOOST_REQUIRE(!env.server().isolation_config_for(current_scheduling_group()));
+        c1.stop().get();
+        c2.stop().get();
+    }).get();
+}
+
 void test_compressor(std::function<std::unique_ptr<seastar::rpc::compressor>()> compressor_factory) {
     using namespace seastar::rpc;
 
@@ -947,6 +1188,34 @@ SEASTAR_THREAD_TEST_CASE(test_lz4_fragmented_compressor) {
     test_compressor([] { return std::make_unique<rpc::lz4_fragmented_compressor>(); });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_zstd_compressor) {
+    test_compressor([] { return std::make_unique<rpc::zstd_compressor>(); });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_zstd_compressor_with_dictionary) {
+    // zstd accepts arbitrary bytes as raw dictionary content, so no
+    // trained dictionary is needed to exercise the dictionary path
+    auto dict = uninitialized_string(8 * 1024);
+    auto rand = std::bind(std::uniform_int_distribution<char>(), std::default_random_engine());
+    std::generate_n(dict.data(), dict.size(), rand);
+    rpc::zstd_compressor::factory f(3, "test-dict", dict);
+    test_compressor([&f] { return f.negotiate(f.supported(), true); });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_zstd_compressor_negotiation) {
+    rpc::zstd_compressor::factory plain3(3);
+    rpc::zstd_compressor::factory plain9(9);
+    rpc::zstd_compressor::factory with_dict(3, "test-dict", "0123456789");
+    // levels do not have to match, dictionaries do
+    BOOST_REQUIRE(plain3.negotiate(plain9.supported(), true));
+    BOOST_REQUIRE(!plain3.negotiate(with_dict.supported(), true));
+    BOOST_REQUIRE(!with_dict.negotiate(plain9.supported(), false));
+    BOOST_REQUIRE(with_dict.negotiate(with_dict.supported(), false));
+    BOOST_REQUIRE(!plain3.negotiate("LZ4", true));
+    // both directions converge on the lower level
+    BOOST_REQUIRE_EQUAL(plain3.negotiate(plain9.supported(), true)->name(), plain3.supported());
+}
+
 // Test reproducing issue #671: If timeout is time_point::max(), translating
 // it to relative timeout in the sender and then back in the receiver, when
 // these calculations happen across a millisecond boundary, overflowed the
@@ -1022,6 +1291,28 @@ SEASTAR_TEST_CASE(test_max_relative_timeout) {
     });
 }
 
+// All of these calls expire at the same time, so a single expiry sweep
+// has to time out the whole batch.
+SEASTAR_TEST_CASE(test_rpc_expire_batch) {
+    using namespace std::chrono_literals;
+    return rpc_test_env<>::do_with_thread(rpc_test_config(), [] (rpc_test_env<>& env, test_rpc_proto::client& c1) {
+        env.register_handler(1, [] (int v) {
+            return sleep(100ms).then([v] {
+                return make_ready_future<int>(v);
+            });
+        }).get();
+        auto slow = env.proto().make_client<int (int)>(1);
+        auto timeout = rpc::rpc_clock_type::now() + 10ms;
+        std::vector<future<int>> replies;
+        for (int i = 0; i < 10; i++) {
+            replies.push_back(slow(c1, timeout, i));
+        }
+        for (auto& r : replies) {
+            BOOST_REQUIRE_THROW(r.get0(), rpc::timeout_error);
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(test_rpc_tuple) {
     return rpc_test_env<>::do_with_thread(rpc_test_config(), [] (rpc_test_env<>& env, test_rpc_proto::client& c1) {
         env.register_handler(1, [] () {
@@ -0,0 +1,90 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/included/unit_test.hpp>
+#include <seastar/core/polymorphic_temporary_buffer.hh>
+
+using namespace seastar;
+
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+
+BOOST_AUTO_TEST_CASE(test_poolable_sizes) {
+    using pool = internal::rx_buffer_pool;
+    BOOST_REQUIRE(pool::poolable(pool::min_buffer_size));
+    BOOST_REQUIRE(pool::poolable(pool::max_buffer_size));
+    BOOST_REQUIRE(pool::poolable(8192));
+    BOOST_REQUIRE(!pool::poolable(pool::min_buffer_size / 2));
+    BOOST_REQUIRE(!pool::poolable(pool::max_buffer_size * 2));
+    BOOST_REQUIRE(!pool::poolable(8192 + 1));
+}
+
+BOOST_AUTO_TEST_CASE(test_buffer_is_recycled) {
+    internal::rx_buffer_pool pool;
+    const char* first;
+    {
+        auto buf = pool.allocate(8192);
+        first = buf.get();
+        BOOST_REQUIRE_EQUAL(pool.stats().misses, 1u);
+    }
+    BOOST_REQUIRE_EQUAL(pool.stats().returns, 1u);
+    auto buf = pool.allocate(8192);
+    BOOST_REQUIRE_EQUAL(buf.get(), first);
+    BOOST_REQUIRE_EQUAL(pool.stats().hits, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_size_classes_are_independent) {
+    internal::rx_buffer_pool pool;
+    const char* small;
+    {
+        auto buf = pool.allocate(4096);
+        small = buf.get();
+    }
+    {
+        // must not be served from the 4096 class
+        auto buf = pool.allocate(8192);
+        BOOST_REQUIRE(buf.get() != small);
+        BOOST_REQUIRE_EQUAL(pool.stats().hits, 0u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_full_class_drops_buffers) {
+    internal::rx_buffer_pool pool;
+    std::vector<temporary_buffer<char>> bufs;
+    for (int i = 0; i < 20; ++i) {
+        bufs.push_back(pool.allocate(4096));
+    }
+    bufs.clear();
+    BOOST_REQUIRE_EQUAL(pool.stats().returns + pool.stats().drops, 20u);
+    BOOST_REQUIRE_GE(pool.stats().drops, 1u);
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE(test_no_pool_with_default_allocator) {
+    // The pool is compiled out; make_recycled_temporary_buffer() still works.
+    auto buf = make_recycled_temporary_buffer(memory::malloc_allocator, 8192);
+    BOOST_REQUIRE_EQUAL(buf.size(), 8192u);
+}
+
+#endif
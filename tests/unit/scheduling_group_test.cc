@@ -249,3 +249,25 @@ SEASTAR_THREAD_TEST_CASE(later_preserves_sg) {
         });
     }).get();
 }
+
+SEASTAR_THREAD_TEST_CASE(sg_latency_goal) {
+    scheduling_group sg = create_scheduling_group("latency", 100).get0();
+    auto cleanup = defer([&] { destroy_scheduling_group(sg).get(); });
+    sg.set_latency_goal(500us);
+    // a cpu hog in the main group, so the deadline dispatch path is
+    // actually exercised while the goal is set
+    auto hog = later().then([] {
+        auto deadline = std::chrono::steady_clock::now() + 10ms;
+        while (std::chrono::steady_clock::now() < deadline) {
+        }
+    });
+    with_scheduling_group(sg, [&] {
+        return later().then([&] {
+            BOOST_REQUIRE_EQUAL(
+                    internal::scheduling_group_index(current_scheduling_group()),
+                    internal::scheduling_group_index(sg));
+        });
+    }).get();
+    sg.set_latency_goal(0us);
+    hog.get();
+}
@@ -29,8 +29,12 @@
 #include <seastar/core/do_with.hh>
 #include <seastar/core/loop.hh>
 #include <seastar/core/map_reduce.hh>
+#include <seastar/core/when_all.hh>
 #include <seastar/core/sleep.hh>
 #include <seastar/core/shared_mutex.hh>
+#include <seastar/core/condition-variable.hh>
+#include <seastar/core/with_scheduling_group.hh>
+#include <seastar/util/defer.hh>
 #include <boost/range/irange.hpp>
 
 using namespace seastar;
@@ -51,6 +55,26 @@ SEASTAR_TEST_CASE(test_semaphore_consume) {
     return make_ready_future<>();
 }
 
+SEASTAR_TEST_CASE(test_semaphore_max_waiters) {
+    semaphore sem(0);
+    BOOST_REQUIRE_EQUAL(sem.max_waiters(), 0u);
+    auto f1 = sem.wait();
+    auto f2 = sem.wait();
+    BOOST_REQUIRE_EQUAL(sem.max_waiters(), 2u);
+    sem.signal(2);
+    BOOST_REQUIRE_EQUAL(sem.waiters(), 0u);
+    // the watermark survives the queue draining...
+    BOOST_REQUIRE_EQUAL(sem.max_waiters(), 2u);
+    sem.reset_max_waiters();
+    BOOST_REQUIRE_EQUAL(sem.max_waiters(), 0u);
+    // ...and resumes tracking after a reset
+    sem.consume(1);
+    auto f3 = sem.wait();
+    BOOST_REQUIRE_EQUAL(sem.max_waiters(), 1u);
+    sem.signal(2);
+    return when_all_succeed(std::move(f1), std::move(f2), std::move(f3)).discard_result();
+}
+
 SEASTAR_TEST_CASE(test_semaphore_1) {
     return do_with(std::make_pair(semaphore(0), 0), [] (std::pair<semaphore, int>& x) {
         (void)x.first.wait().then([&x] {
@@ -107,6 +131,30 @@ SEASTAR_THREAD_TEST_CASE(test_semaphore_timeout_2) {
     BOOST_REQUIRE_EQUAL(x, 0);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_semaphore_wait_expected) {
+    auto sem = semaphore(1);
+
+    // Fast path: units available, the expected resolves successfully.
+    auto r1 = sem.wait_expected(1ms).get0();
+    BOOST_REQUIRE(r1.has_value());
+    sem.signal();
+
+    // Timeout is reported as an error value, not an exception.
+    sem.consume(1);
+    auto r2 = sem.wait_expected(3ms).get0();
+    BOOST_REQUIRE(!r2.has_value());
+    sem.signal();
+
+    // to_future() converts the error into an exceptional future at the
+    // boundary to exception-based code.
+    sem.consume(1);
+    auto fut = sem.wait_expected(3ms).then([] (expected<void, semaphore::timeout_error> r) {
+        return to_future(std::move(r));
+    });
+    BOOST_CHECK_THROW(fut.get(), semaphore_timed_out);
+    sem.signal();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_semaphore_mix_1) {
     auto sem = semaphore(0);
     int x = 0;
@@ -275,6 +323,59 @@ SEASTAR_THREAD_TEST_CASE(test_semaphore_units_return) {
     BOOST_REQUIRE_EQUAL(sm.available_units(), 3);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_semaphore_priority_inheritance) {
+    auto low = create_scheduling_group("pi_low", 100).get0();
+    auto mid = create_scheduling_group("pi_mid", 300).get0();
+    auto high = create_scheduling_group("pi_high", 800).get0();
+    auto cleanup = defer([&] {
+        destroy_scheduling_group(low).get();
+        destroy_scheduling_group(mid).get();
+        destroy_scheduling_group(high).get();
+    });
+
+    semaphore sem(1);
+    sem.set_priority_inheritance(true);
+
+    // the "lock" is taken by a low-shares group
+    auto units = with_scheduling_group(low, [&] {
+        return get_units(sem, 1);
+    }).get0();
+    BOOST_REQUIRE_EQUAL(low.get_shares(), 100);
+
+    // waiters boost the holder's group to the highest waiting shares
+    auto mid_waiter = with_scheduling_group(mid, [&] {
+        return sem.wait(1);
+    });
+    while (sem.waiters() < 1) {
+        thread::yield();
+    }
+    BOOST_REQUIRE_EQUAL(low.get_shares(), 300);
+    auto high_waiter = with_scheduling_group(high, [&] {
+        return sem.wait(1);
+    });
+    while (sem.waiters() < 2) {
+        thread::yield();
+    }
+    BOOST_REQUIRE_EQUAL(low.get_shares(), 800);
+    BOOST_REQUIRE_EQUAL(high.get_shares(), 800);
+
+    // release: ownership moves to the mid waiter, which inherits the
+    // remaining high waiter's shares; the low group is restored
+    units.return_all();
+    BOOST_REQUIRE_EQUAL(low.get_shares(), 100);
+    BOOST_REQUIRE_EQUAL(mid.get_shares(), 800);
+    mid_waiter.get();
+
+    // last release: queue drains and the boost is dropped
+    sem.signal(1);
+    BOOST_REQUIRE_EQUAL(mid.get_shares(), 300);
+    high_waiter.get();
+    sem.signal(1);
+    BOOST_REQUIRE_EQUAL(low.get_shares(), 100);
+    BOOST_REQUIRE_EQUAL(mid.get_shares(), 300);
+    BOOST_REQUIRE_EQUAL(high.get_shares(), 800);
+}
+
 SEASTAR_THREAD_TEST_CASE(test_named_semaphore_error) {
     auto sem = make_lw_shared<named_semaphore>(0, named_semaphore_exception_factory{"name_of_the_semaphore"});
     auto check_result = [sem] (future<> f) {
@@ -308,3 +409,52 @@ SEASTAR_THREAD_TEST_CASE(test_named_semaphore_timeout) {
         BOOST_FAIL("Expected an instance of named_semaphore_timed_out with proper semaphore name");
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(test_condition_variable_signal) {
+    condition_variable cv;
+    int signalled = 0;
+    auto f1 = cv.wait().then([&] { ++signalled; });
+    auto f2 = cv.wait().then([&] { ++signalled; });
+    cv.signal();
+    f1.get();
+    BOOST_REQUIRE_EQUAL(signalled, 1);
+    cv.signal();
+    f2.get();
+    BOOST_REQUIRE_EQUAL(signalled, 2);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_condition_variable_broadcast_many_waiters) {
+    // Enough waiters to force broadcast() through its drain task.
+    constexpr int waiters = 1000;
+    condition_variable cv;
+    int woken = 0;
+    std::vector<future<>> waits;
+    waits.reserve(waiters);
+    for (int i = 0; i < waiters; ++i) {
+        waits.push_back(cv.wait().then([&] { ++woken; }));
+    }
+    cv.broadcast();
+    when_all_succeed(waits.begin(), waits.end()).get();
+    BOOST_REQUIRE_EQUAL(woken, waiters);
+    // A waiter queued after the broadcast must not be woken by it.
+    auto late = cv.wait(semaphore::clock::now() + 1ms);
+    BOOST_REQUIRE_THROW(late.get(), condition_variable_timed_out);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_condition_variable_timeout) {
+    condition_variable cv;
+    auto f = cv.wait(semaphore::clock::now() + 10ms);
+    BOOST_REQUIRE_THROW(f.get(), condition_variable_timed_out);
+    // A timed-out waiter must not absorb a later signal.
+    auto f2 = cv.wait();
+    cv.signal();
+    f2.get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_condition_variable_broken) {
+    condition_variable cv;
+    auto f = cv.wait();
+    cv.broken();
+    BOOST_REQUIRE_THROW(f.get(), broken_condition_variable);
+    BOOST_REQUIRE_THROW(cv.wait().get(), broken_condition_variable);
+}
@@ -99,6 +99,60 @@ SEASTAR_THREAD_TEST_CASE(invoke_map_returns_future_value_from_thread) {
     s.stop().get();
 }
 
+SEASTAR_THREAD_TEST_CASE(invoke_on_all_reaches_every_shard) {
+    seastar::sharded<mydata> s;
+    s.start().get();
+    s.invoke_on_all([] (mydata& m) {
+        m.x = 2;
+    }).get();
+    s.map([] (mydata& m) {
+        return m.x;
+    }).then([] (std::vector<int> results) {
+        assert(results.size() == smp::count);
+        for (auto& x : results) {
+            assert(x == 2);
+        }
+    }).get();
+    s.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(invoke_on_all_batch_applies_in_order) {
+    seastar::sharded<mydata> s;
+    s.start().get();
+    std::vector<std::function<future<> (mydata&)>> funcs;
+    funcs.push_back([] (mydata& m) {
+        m.x += 1;
+        return make_ready_future<>();
+    });
+    funcs.push_back([] (mydata& m) {
+        m.x *= 10;
+        return make_ready_future<>();
+    });
+    s.invoke_on_all_batch(std::move(funcs)).get();
+    s.map([] (mydata& m) {
+        return m.x;
+    }).then([] (std::vector<int> results) {
+        for (auto& x : results) {
+            assert(x == 20);
+        }
+    }).get();
+    s.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(invoke_on_all_batch_propagates_exception) {
+    seastar::sharded<mydata> s;
+    s.start().get();
+    std::vector<std::function<future<> (mydata&)>> funcs;
+    funcs.push_back([] (mydata&) {
+        if (this_shard_id() == smp::count - 1) {
+            return make_exception_future<>(std::runtime_error("expected"));
+        }
+        return make_ready_future<>();
+    });
+    BOOST_REQUIRE_THROW(s.invoke_on_all_batch(std::move(funcs)).get(), std::runtime_error);
+    s.stop().get();
+}
+
 SEASTAR_THREAD_TEST_CASE(failed_sharded_start_doesnt_hang) {
     class fail_to_start {
     public:
@@ -108,3 +162,47 @@ SEASTAR_THREAD_TEST_CASE(failed_sharded_start_doesnt_hang) {
     seastar::sharded<fail_to_start> s;
     s.start().then_wrapped([] (auto&& fut) { fut.ignore_ready_future(); }).get();
 }
+
+SEASTAR_THREAD_TEST_CASE(singleton_policy_shares_one_instance) {
+    seastar::sharded<mydata> s;
+    s.start(instantiation_policy::singleton).get();
+    // the only instance is owned by shard 0 and visible from every shard
+    smp::invoke_on_all([&s] {
+        assert(s.owner_shard() == 0);
+        assert(s.local_is_initialized());
+        assert(s.local().x == 1);
+    }).get();
+    // invoke_on_all runs once per instance, not once per shard
+    s.invoke_on_all([] (mydata& m) {
+        m.x++;
+    }).get();
+    assert(s.local().x == 2);
+    // a write routed to the owner is seen through every shard's view
+    smp::submit_to(smp::count - 1, [&s] {
+        return s.invoke_on_owner([] (mydata& m) {
+            m.x = 7;
+        });
+    }).get();
+    smp::invoke_on_all([&s] {
+        assert(s.local().x == 7);
+    }).get();
+    s.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(per_numa_policy_shares_node_instance) {
+    seastar::sharded<mydata> s;
+    s.start(instantiation_policy::per_numa).get();
+    smp::invoke_on_all([&s] {
+        auto owner = s.owner_shard();
+        assert(owner <= this_shard_id());
+        assert(smp::numa_node_of_shard(owner) == smp::numa_node_of_shard(this_shard_id()));
+        assert(s.local().x == 1);
+    }).get();
+    s.invoke_on_all([] (mydata& m) {
+        m.x = 3;
+    }).get();
+    smp::invoke_on_all([&s] {
+        assert(s.local().x == 3);
+    }).get();
+    s.stop().get();
+}
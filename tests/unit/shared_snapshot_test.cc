@@ -0,0 +1,76 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 Cloudius Systems, Ltd.
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <seastar/core/shared_snapshot.hh>
+#include <vector>
+
+using namespace seastar;
+
+SEASTAR_THREAD_TEST_CASE(shared_snapshot_visible_on_all_shards) {
+    shared_snapshot<std::vector<int>> snap;
+    assert(!snap.read());
+    snap.publish(std::vector<int>{1, 2, 3}).get();
+    smp::invoke_on_all([&snap] {
+        auto h = snap.read();
+        assert(h);
+        assert(h->size() == 3);
+        assert((*h)[0] == 1);
+    }).get();
+    snap.publish(std::vector<int>{4, 5}).get();
+    smp::invoke_on_all([&snap] {
+        assert(snap.read()->size() == 2);
+    }).get();
+    snap.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(shared_snapshot_handle_pins_old_version) {
+    shared_snapshot<int> snap;
+    snap.publish(1).get();
+    auto held = snap.read();
+    snap.publish(2).get();
+    // the held handle keeps the retired version readable
+    assert(*held == 1);
+    // while new readers see the new value
+    assert(*snap.read() == 2);
+    held = snap.read();
+    assert(*held == 2);
+    held = {};
+    snap.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(shared_snapshot_remote_handle_pins_version) {
+    shared_snapshot<int> snap;
+    snap.publish(1).get();
+    // a handle held on another shard while the value is republished
+    smp::submit_to(smp::count - 1, [&snap] {
+        return do_with(snap.read(), [&snap] (shared_snapshot<int>::handle& held) {
+            return smp::submit_to(0, [&snap] {
+                return snap.publish(2);
+            }).then([&held] {
+                assert(*held == 1);
+            });
+        });
+    }).get();
+    assert(*snap.read() == 2);
+    snap.stop().get();
+}
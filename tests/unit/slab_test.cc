@@ -97,6 +97,44 @@ static void test_allocation_2(const double growth_factor, const unsigned slab_li
     std::cout << __FUNCTION__ << " done!\n";
 }
 
+static void test_page_rebalancing(const double growth_factor, const unsigned slab_limit_size) {
+    slab_allocator<item> slab(growth_factor, slab_limit_size, max_object_size);
+
+    std::vector<item *> small_items;
+    std::vector<item *> big_items;
+    size_t small_size = 1024;
+    size_t big_size = 4096;
+
+    // exhaust the page budget from the small class.
+    for (;;) {
+        auto item = slab.create(small_size);
+        if (!item) {
+            break;
+        }
+        small_items.push_back(item);
+    }
+    // the big class owns no pages yet, so its first page is still granted;
+    // drain it completely.
+    for (;;) {
+        auto item = slab.create(big_size);
+        if (!item) {
+            break;
+        }
+        big_items.push_back(item);
+    }
+    assert(big_items.size() == max_object_size / slab.class_size(big_size));
+
+    // free the small items; their pages become completely free and are fair
+    // game for rebalancing into the big class.
+    free_vector<item>(slab, small_items);
+    auto rebalanced = slab.create(big_size);
+    assert(rebalanced != nullptr);
+    big_items.push_back(rebalanced);
+
+    free_vector<item>(slab, big_items);
+    std::cout << __FUNCTION__ << " done!\n";
+}
+
 static void test_allocation_with_lru(const double growth_factor, const unsigned slab_limit_size) {
     bi::list<item, bi::member_hook<item, bi::list_member_hook<>, &item::_cache_link>> _cache;
     unsigned evictions = 0;
@@ -121,6 +159,7 @@ static void test_allocation_with_lru(const double growth_factor, const unsigned
 int main(int ac, char** av) {
     test_allocation_1(1.25, 5*1024*1024);
     test_allocation_2(1.07, 5*1024*1024); // 1.07 is the growth factor used by facebook.
+    test_page_rebalancing(1.25, 2*1024*1024);
     test_allocation_with_lru(1.25, 5*1024*1024);
 
     return 0;
@@ -0,0 +1,94 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2020 ScyllaDB
+ */
+
+#include <seastar/testing/test_case.hh>
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/spsc_channel.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/core/thread.hh>
+
+using namespace seastar;
+
+SEASTAR_THREAD_TEST_CASE(test_spsc_channel_try_push_and_drain) {
+    spsc_channel<int> ch(4);
+    for (int i = 1; i <= 4; i++) {
+        BOOST_REQUIRE(ch.writer.try_push(std::move(i)));
+    }
+    int full = 5;
+    BOOST_REQUIRE(!ch.writer.try_push(std::move(full)));
+    int sum = 0;
+    auto n = ch.reader.drain([&sum] (int v) { sum += v; });
+    BOOST_REQUIRE_EQUAL(n, 4u);
+    BOOST_REQUIRE_EQUAL(sum, 10);
+    BOOST_REQUIRE(!ch.reader.try_pop());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_spsc_channel_eof_after_drain) {
+    spsc_channel<int> ch(4);
+    BOOST_REQUIRE(ch.writer.try_push(1));
+    BOOST_REQUIRE(ch.writer.try_push(2));
+    ch.writer = spsc_channel_writer<int>(); // close the write side
+    BOOST_REQUIRE_EQUAL(*ch.reader.pop().get0(), 1);
+    BOOST_REQUIRE_EQUAL(*ch.reader.pop().get0(), 2);
+    BOOST_REQUIRE(!ch.reader.pop().get0());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_spsc_channel_push_fails_after_reader_closes) {
+    spsc_channel<int> ch(4);
+    ch.reader = spsc_channel_reader<int>(); // close the read side
+    BOOST_REQUIRE_THROW(ch.writer.push(1).get(), broken_channel_exception);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_spsc_channel_backpressure) {
+    // A tiny channel, so the writer repeatedly blocks on a full ring.
+    spsc_channel<int> ch(2);
+    auto consumer = seastar::async([&ch] {
+        long sum = 0;
+        while (auto v = ch.reader.pop().get0()) {
+            sum += *v;
+        }
+        return sum;
+    });
+    for (int i = 1; i <= 1000; i++) {
+        ch.writer.push(std::move(i)).get();
+    }
+    ch.writer = spsc_channel_writer<int>();
+    BOOST_REQUIRE_EQUAL(consumer.get0(), 1000L * 1001 / 2);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_spsc_channel_cross_shard) {
+    auto shard = smp::count - 1;
+    spsc_channel<std::unique_ptr<int>> ch(8);
+    auto consumer = smp::submit_to(shard, [r = std::move(ch.reader)] () mutable {
+        return seastar::async([r = std::move(r)] () mutable {
+            long sum = 0;
+            while (auto v = r.pop().get0()) {
+                sum += **v;
+            }
+            return sum;
+        });
+    });
+    for (int i = 1; i <= 1000; i++) {
+        ch.writer.push(std::make_unique<int>(i)).get();
+    }
+    ch.writer = spsc_channel_writer<std::unique_ptr<int>>();
+    BOOST_REQUIRE_EQUAL(consumer.get0(), 1000L * 1001 / 2);
+}
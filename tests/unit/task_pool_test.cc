@@ -0,0 +1,68 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/included/unit_test.hpp>
+#include <seastar/core/task.hh>
+#include <cstdint>
+
+using namespace seastar;
+
+namespace {
+
+struct test_task final : task {
+    char payload[100];
+    virtual void run_and_dispose() noexcept override { delete this; }
+    virtual task* waiting_task() noexcept override { return nullptr; }
+};
+
+}
+
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+
+BOOST_AUTO_TEST_CASE(test_tasks_are_cache_line_aligned) {
+    auto t = new test_task;
+    BOOST_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(t) % cache_line_size, 0u);
+    delete t;
+}
+
+BOOST_AUTO_TEST_CASE(test_hot_task_sizes_are_recycled) {
+    auto t1 = new test_task;
+    auto p1 = reinterpret_cast<uintptr_t>(t1);
+    delete t1;
+    // the pool hands out the most recently freed chunk of the same size
+    // class, so an immediate re-allocation must reuse the storage
+    auto t2 = new test_task;
+    BOOST_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(t2), p1);
+    delete t2;
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE(test_task_pool_disabled_with_default_allocator) {
+    // task allocations go straight to the default allocator; nothing to
+    // verify beyond allocation round-tripping
+    delete new test_task;
+}
+
+#endif
@@ -29,6 +29,7 @@
 #include <seastar/core/do_with.hh>
 #include <seastar/core/loop.hh>
 #include <seastar/core/sleep.hh>
+#include <boost/range/irange.hpp>
 #include <sys/mman.h>
 #include <sys/signal.h>
 
@@ -166,6 +167,24 @@ SEASTAR_TEST_CASE(test_thread_custom_stack_size) {
     });
 }
 
+SEASTAR_TEST_CASE(test_thread_stack_recycling) {
+    return async([] {
+        // Churn threads well past the stack cache watermark, with two
+        // different stack sizes, to exercise both the recycling and the
+        // excess-release paths.
+        for (int i = 0; i < 64; i++) {
+            thread_attributes attr;
+            attr.stack_size = (i % 2) ? 128 * 1024 : 256 * 1024;
+            auto r = async(attr, [i] { return i; }).get0();
+            BOOST_REQUIRE_EQUAL(r, i);
+        }
+        // a concurrent batch, so destruction returns many stacks at once
+        parallel_for_each(boost::irange(0, 48), [] (int) {
+            return async([] { sleep(1ms).get(); });
+        }).get();
+    });
+}
+
 // The test case uses x86_64 specific signal handler info. The test
 // fails with detect_stack_use_after_return=1. We could put it behind
 // a command line option and fork/exec to run it after removing
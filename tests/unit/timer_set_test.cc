@@ -0,0 +1,177 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/included/unit_test.hpp>
+#include <seastar/core/timer-set.hh>
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace seastar;
+
+namespace {
+
+// A fake clock so the set can be driven deterministically.
+struct fake_clock {
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<fake_clock, duration>;
+    static time_point _now;
+    static time_point now() noexcept {
+        return _now;
+    }
+};
+
+fake_clock::time_point fake_clock::_now;
+
+struct fake_timer {
+    using clock = fake_clock;
+    using time_point = fake_clock::time_point;
+    using duration = fake_clock::duration;
+    time_point _expiry;
+    duration _slack = {};
+    bool _cancelled = false;
+    boost::intrusive::list_member_hook<> _link;
+
+    time_point get_timeout() const noexcept {
+        return _expiry;
+    }
+    duration get_slack() const noexcept {
+        return _slack;
+    }
+    void cancel() {
+        // the real timer<> unlinks itself via reactor::del_timer(); the
+        // tests below always drain the set, so nothing to do here
+        _cancelled = true;
+    }
+};
+
+using set_t = timer_set<fake_timer, &fake_timer::_link>;
+
+fake_clock::time_point ts(int64_t v) {
+    return fake_clock::time_point(fake_clock::duration(v));
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(timer_set_slack_defers_wakeup) {
+    set_t set;
+
+    fake_timer t1, t2;
+    t1._expiry = ts(100);
+    t1._slack = fake_clock::duration(50);
+    t2._expiry = ts(200);
+
+    BOOST_REQUIRE(set.insert(t1));
+    // the wakeup is deferred to the latest allowed firing point
+    BOOST_REQUIRE_EQUAL(set.get_next_timeout().time_since_epoch().count(), 150);
+    // a later exact timer does not pull the wakeup in
+    BOOST_REQUIRE(!set.insert(t2));
+    BOOST_REQUIRE_EQUAL(set.get_next_timeout().time_since_epoch().count(), 150);
+
+    auto exp = set.expire(ts(150));
+    BOOST_REQUIRE_EQUAL(exp.size(), 1u);
+    BOOST_REQUIRE_EQUAL(&*exp.begin(), &t1);
+    exp.clear();
+    BOOST_REQUIRE_EQUAL(set.get_next_timeout().time_since_epoch().count(), 200);
+
+    exp = set.expire(ts(200));
+    BOOST_REQUIRE_EQUAL(exp.size(), 1u);
+    exp.clear();
+    BOOST_REQUIRE(set.empty());
+}
+
+BOOST_AUTO_TEST_CASE(timer_set_slack_coalesces_with_exact_timer) {
+    set_t set;
+
+    fake_timer exact, sloppy;
+    exact._expiry = ts(100);
+    sloppy._expiry = ts(90);
+    sloppy._slack = fake_clock::duration(50);
+
+    set.insert(sloppy);
+    set.insert(exact);
+    // the exact timer needs a wakeup at 100; the sloppy one, already due
+    // at 90, rides along instead of forcing its own
+    BOOST_REQUIRE_EQUAL(set.get_next_timeout().time_since_epoch().count(), 100);
+
+    auto exp = set.expire(ts(100));
+    BOOST_REQUIRE_EQUAL(exp.size(), 2u);
+    exp.clear();
+    BOOST_REQUIRE(set.empty());
+}
+
+BOOST_AUTO_TEST_CASE(timer_set_slack_random_within_window) {
+    // Drive expiry exclusively at get_next_timeout() and verify that every
+    // timer fires within [expiry, expiry + slack], with cancelled timers
+    // never firing, across two insertion waves.
+    std::default_random_engine rnd(42);
+    std::uniform_int_distribution<int64_t> expiry_dist(1, 1 << 20);
+    std::uniform_int_distribution<int64_t> slack_dist(0, 1 << 14);
+    std::bernoulli_distribution cancel_dist(0.3);
+    std::bernoulli_distribution slacky_dist(0.5);
+
+    constexpr int n_timers = 2000;
+    std::vector<fake_timer> timers(n_timers);
+    set_t set;
+    int64_t now = 0;
+    size_t fired = 0;
+    size_t cancelled = 0;
+
+    auto insert_wave = [&] (int begin, int end) {
+        for (int i = begin; i != end; i++) {
+            timers[i]._expiry = ts(now + expiry_dist(rnd));
+            timers[i]._slack = fake_clock::duration(slacky_dist(rnd) ? slack_dist(rnd) : 0);
+            set.insert(timers[i]);
+        }
+        for (int i = begin; i != end; i++) {
+            if (cancel_dist(rnd)) {
+                set.remove(timers[i]);
+                timers[i]._cancelled = true;
+                cancelled++;
+            }
+        }
+    };
+
+    auto drain_until = [&] (int64_t stop) {
+        while (!set.empty() && set.get_next_timeout().time_since_epoch().count() <= stop) {
+            now = std::max(now, set.get_next_timeout().time_since_epoch().count());
+            auto exp = set.expire(ts(now));
+            while (!exp.empty()) {
+                auto& t = *exp.begin();
+                exp.pop_front();
+                BOOST_REQUIRE(!t._cancelled);
+                auto expiry = t._expiry.time_since_epoch().count();
+                BOOST_REQUIRE(expiry <= now);
+                BOOST_REQUIRE(now <= expiry + t._slack.count());
+                fired++;
+            }
+        }
+    };
+
+    insert_wave(0, n_timers / 2);
+    drain_until(1 << 19); // leave some timers pending for the second wave
+    insert_wave(n_timers / 2, n_timers);
+    drain_until(std::numeric_limits<int64_t>::max());
+
+    BOOST_REQUIRE(set.empty());
+    BOOST_REQUIRE_EQUAL(fired + cancelled, timers.size());
+}
@@ -0,0 +1,223 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/included/unit_test.hpp>
+#include <seastar/core/timer-wheel.hh>
+#include <chrono>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace seastar;
+
+namespace {
+
+// A fake clock so the wheel can be driven deterministically.
+struct fake_clock {
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<fake_clock, duration>;
+    static time_point _now;
+    static time_point now() noexcept {
+        return _now;
+    }
+};
+
+fake_clock::time_point fake_clock::_now;
+
+struct fake_timer {
+    using clock = fake_clock;
+    using time_point = fake_clock::time_point;
+    using duration = fake_clock::duration;
+    time_point _expiry;
+    bool _cancelled = false;
+    boost::intrusive::list_member_hook<> _link;
+
+    time_point get_timeout() const noexcept {
+        return _expiry;
+    }
+    void cancel() {
+        // the real timer<> unlinks itself via reactor::del_timer(); the
+        // tests below always drain the wheel, so nothing to do here
+        _cancelled = true;
+    }
+};
+
+using wheel_t = timer_wheel<fake_timer, &fake_timer::_link>;
+
+fake_clock::time_point ts(int64_t v) {
+    return fake_clock::time_point(fake_clock::duration(v));
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel_basic_expiry) {
+    wheel_t wheel;
+    BOOST_REQUIRE(wheel.empty());
+
+    fake_timer t1, t2, t3;
+    t1._expiry = ts(10);
+    t2._expiry = ts(20);
+    t3._expiry = ts(1000000);
+
+    BOOST_REQUIRE(wheel.insert(t1));   // earliest so far
+    BOOST_REQUIRE(!wheel.insert(t2));  // later than t1
+    BOOST_REQUIRE(!wheel.insert(t3));
+    BOOST_REQUIRE_EQUAL(wheel.size(), 3u);
+    BOOST_REQUIRE(wheel.get_next_timeout() == ts(10));
+
+    auto exp = wheel.expire(ts(15));
+    BOOST_REQUIRE_EQUAL(exp.size(), 1u);
+    BOOST_REQUIRE(&*exp.begin() == &t1);
+    exp.clear();
+    BOOST_REQUIRE(wheel.get_next_timeout() == ts(20));
+
+    exp = wheel.expire(ts(2000000));
+    BOOST_REQUIRE_EQUAL(exp.size(), 2u);
+    exp.clear();
+    BOOST_REQUIRE(wheel.empty());
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel_past_insert) {
+    wheel_t wheel;
+    wheel.expire(ts(100)).clear();
+
+    // A timer armed in the past must fire on the next expire() call.
+    fake_timer t;
+    t._expiry = ts(50);
+    wheel.insert(t);
+    BOOST_REQUIRE(wheel.get_next_timeout() == ts(100));
+    auto exp = wheel.expire(ts(100));
+    BOOST_REQUIRE_EQUAL(exp.size(), 1u);
+    exp.clear();
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel_remove) {
+    wheel_t wheel;
+    fake_timer t1, t2;
+    t1._expiry = ts(1000);
+    t2._expiry = ts(1 << 20);
+    wheel.insert(t1);
+    wheel.insert(t2);
+    wheel.remove(t1);
+    BOOST_REQUIRE_EQUAL(wheel.size(), 1u);
+    auto exp = wheel.expire(ts(1 << 21));
+    BOOST_REQUIRE_EQUAL(exp.size(), 1u);
+    BOOST_REQUIRE(&*exp.begin() == &t2);
+    exp.clear();
+}
+
+// Drive the wheel over randomized insert/expire cycles and verify that
+// timers fire exactly when they should, across level cascades.
+BOOST_AUTO_TEST_CASE(timer_wheel_randomized) {
+    wheel_t wheel;
+    std::default_random_engine rng(42);
+    std::uniform_int_distribution<int64_t> spread(1, int64_t(1) << 40);
+
+    constexpr int nr_timers = 2000;
+    std::vector<fake_timer> timers(nr_timers);
+    std::multiset<int64_t> pending;
+
+    int64_t now = 0;
+    for (auto& t : timers) {
+        t._expiry = ts(now + spread(rng));
+        pending.insert(t._expiry.time_since_epoch().count());
+        wheel.insert(t);
+    }
+
+    std::uniform_int_distribution<int64_t> step(1, int64_t(1) << 35);
+    while (!wheel.empty()) {
+        auto next = wheel.get_next_timeout().time_since_epoch().count();
+        // the wheel must never promise a wakeup later than the earliest timer
+        BOOST_REQUIRE_LE(next, *pending.begin());
+        now += step(rng);
+        auto exp = wheel.expire(ts(now));
+        size_t nr_expired = 0;
+        while (!exp.empty()) {
+            auto& t = *exp.begin();
+            exp.pop_front();
+            auto v = t.get_timeout().time_since_epoch().count();
+            BOOST_REQUIRE_LE(v, now);
+            auto it = pending.find(v);
+            BOOST_REQUIRE(it != pending.end());
+            pending.erase(it);
+            ++nr_expired;
+        }
+        // everything at or before `now` must have fired
+        BOOST_REQUIRE(pending.empty() || *pending.begin() > now);
+    }
+    BOOST_REQUIRE(pending.empty());
+}
+
+namespace {
+
+// A timer advertising a firing slack; the wheel hashes it on the latest
+// allowed firing point.
+struct sloppy_timer {
+    using clock = fake_clock;
+    using time_point = fake_clock::time_point;
+    using duration = fake_clock::duration;
+    time_point _expiry;
+    duration _slack = {};
+    boost::intrusive::list_member_hook<> _link;
+
+    time_point get_timeout() const noexcept {
+        return _expiry;
+    }
+    duration get_slack() const noexcept {
+        return _slack;
+    }
+    void cancel() {
+    }
+};
+
+using sloppy_wheel_t = timer_wheel<sloppy_timer, &sloppy_timer::_link>;
+
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel_slack_defers_firing) {
+    sloppy_wheel_t wheel;
+
+    sloppy_timer t1, t2;
+    t1._expiry = ts(100);
+    t1._slack = fake_clock::duration(60);
+    t2._expiry = ts(500);
+
+    wheel.insert(t1);
+    wheel.insert(t2);
+    // the promised wakeup honors the slack window instead of the expiry
+    BOOST_REQUIRE_EQUAL(wheel.get_next_timeout().time_since_epoch().count(), 160);
+
+    // before the window closes, nothing fires
+    auto exp = wheel.expire(ts(120));
+    BOOST_REQUIRE(exp.empty());
+
+    // by the end of the window, the timer has fired
+    exp = wheel.expire(ts(160));
+    BOOST_REQUIRE_EQUAL(exp.size(), 1u);
+    BOOST_REQUIRE_EQUAL(&*exp.begin(), &t1);
+    exp.clear();
+
+    exp = wheel.expire(ts(500));
+    BOOST_REQUIRE_EQUAL(exp.size(), 1u);
+    exp.clear();
+    BOOST_REQUIRE(wheel.empty());
+}
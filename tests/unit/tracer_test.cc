@@ -0,0 +1,48 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/internal/tracer.hh>
+#include <seastar/core/thread.hh>
+
+using namespace seastar;
+
+SEASTAR_THREAD_TEST_CASE(test_task_tracing_collects_spans) {
+    // trace every task so a short run is guaranteed to sample something
+    internal::enable_task_tracing(1, 1024);
+    for (int i = 0; i < 1000; i++) {
+        thread::yield();
+    }
+    internal::disable_task_tracing();
+
+    auto trace = internal::dump_task_trace();
+    BOOST_REQUIRE(trace.find("{\"traceEvents\":[") == 0);
+    BOOST_REQUIRE(trace.find("\"cat\":\"task\"") != sstring::npos);
+    BOOST_REQUIRE(trace.find("\"queue_us\"") != sstring::npos);
+    BOOST_REQUIRE_EQUAL(trace.back(), '}');
+}
+
+SEASTAR_THREAD_TEST_CASE(test_task_tracing_empty_dump) {
+    // an enabled-then-disabled tracer with no samples dumps valid, empty json
+    internal::enable_task_tracing(1, 16);
+    internal::disable_task_tracing();
+    BOOST_REQUIRE_EQUAL(internal::dump_task_trace(), "{\"traceEvents\":[]}");
+}
@@ -0,0 +1,46 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/internal/tsc_clock.hh>
+#include <seastar/core/sleep.hh>
+
+using namespace seastar;
+using namespace std::chrono_literals;
+
+// Whether now() is served from the TSC depends on the host, so the test
+// checks the properties that must hold either way: monotonicity and
+// agreement with the real clock.
+SEASTAR_THREAD_TEST_CASE(test_tsc_clock_tracks_steady_clock) {
+    // let a couple of lowres ticks pass so that a calibration can be
+    // established when the TSC is usable
+    sleep(50ms).get();
+
+    auto last = internal::tsc_clock::now();
+    for (int i = 0; i < 1000; i++) {
+        auto t = internal::tsc_clock::now();
+        BOOST_REQUIRE(t >= last);
+        last = t;
+        auto real = std::chrono::steady_clock::now();
+        auto skew = t > real ? t - real : real - t;
+        BOOST_REQUIRE(skew < 100ms);
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * This file is open source software, licensed to you under the terms
+ * of the Apache License, Version 2.0 (the "License").  See the NOTICE file
+ * distributed with this work for additional information regarding copyright
+ * ownership.  You may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Copyright (C) 2020 ScyllaDB.
+ */
+
+#include <vector>
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/work_stealing.hh>
+#include <seastar/core/smp.hh>
+
+using namespace seastar;
+
+SEASTAR_THREAD_TEST_CASE(test_submitted_tasks_resolve_on_origin) {
+    work_stealing_pool pool;
+    pool.start().get();
+    auto origin = this_shard_id();
+    std::vector<future<int>> futs;
+    for (int i = 0; i < 100; ++i) {
+        futs.push_back(pool.submit([i] {
+            return i * 2;
+        }).then([origin] (int v) {
+            BOOST_REQUIRE_EQUAL(this_shard_id(), origin);
+            return v;
+        }));
+    }
+    int sum = 0;
+    for (auto& f : futs) {
+        sum += f.get0();
+    }
+    BOOST_REQUIRE_EQUAL(sum, 9900);
+    pool.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_pinned_tasks_run_on_submitting_shard) {
+    work_stealing_pool pool;
+    pool.start().get();
+    auto origin = this_shard_id();
+    std::vector<future<>> futs;
+    for (int i = 0; i < 32; ++i) {
+        futs.push_back(pool.submit_pinned([origin] {
+            BOOST_REQUIRE_EQUAL(this_shard_id(), origin);
+        }));
+    }
+    for (auto& f : futs) {
+        f.get();
+    }
+    pool.stop().get();
+}
+
+struct expected_exception {};
+
+SEASTAR_THREAD_TEST_CASE(test_exceptions_propagate_to_submitter) {
+    work_stealing_pool pool;
+    pool.start().get();
+    auto f = pool.submit([] () -> int {
+        throw expected_exception();
+    });
+    BOOST_REQUIRE_THROW(f.get0(), expected_exception);
+    pool.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_stop_drains_queued_tasks) {
+    work_stealing_pool pool;
+    pool.start().get();
+    std::vector<future<>> futs;
+    for (int i = 0; i < 64; ++i) {
+        futs.push_back(pool.submit([] {}));
+    }
+    pool.stop().get();
+    for (auto& f : futs) {
+        f.get();
+    }
+}